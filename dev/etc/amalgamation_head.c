@@ -39,6 +39,22 @@ limitations under the License.
 #endif
 #endif
 
+#ifdef OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif
+
 
 #ifdef OCTASPIRE_PLAN9_IMPLEMENTATION
 
@@ -0,0 +1,140 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_BYTES_H
+#define OCTASPIRE_DERN_BYTES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+// Formats for packing integers into octets and unpacking them back.
+typedef enum octaspire_dern_bytes_integer_format_t
+{
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U8,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I8,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16BE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16BE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32BE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64BE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64LE,
+    OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64BE
+}
+octaspire_dern_bytes_integer_format_t;
+
+// Growable buffer of octets stored contiguously, used by bytes values
+// for binary data.
+typedef struct octaspire_dern_bytes_t octaspire_dern_bytes_t;
+
+octaspire_dern_bytes_t *octaspire_dern_bytes_new(
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_bytes_t *octaspire_dern_bytes_new_from_buffer(
+    void const * const buffer,
+    size_t const length,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_bytes_release(octaspire_dern_bytes_t *self);
+
+size_t octaspire_dern_bytes_get_length(
+    octaspire_dern_bytes_t const * const self);
+
+// Returns the octets of 'self'. The pointer is valid until 'self' is
+// modified.
+uint8_t const *octaspire_dern_bytes_get_octets(
+    octaspire_dern_bytes_t const * const self);
+
+uint8_t octaspire_dern_bytes_get_octet_at(
+    octaspire_dern_bytes_t const * const self,
+    size_t const index);
+
+void octaspire_dern_bytes_set_octet_at(
+    octaspire_dern_bytes_t * const self,
+    size_t const index,
+    uint8_t const octet);
+
+bool octaspire_dern_bytes_push_back_octet(
+    octaspire_dern_bytes_t * const self,
+    uint8_t const octet);
+
+bool octaspire_dern_bytes_push_back_buffer(
+    octaspire_dern_bytes_t * const self,
+    void const * const buffer,
+    size_t const length);
+
+void octaspire_dern_bytes_clear(
+    octaspire_dern_bytes_t * const self);
+
+// Returns the index of the first occurrence of 'needle' at or after
+// index 'start', or -1 if there is none.
+ptrdiff_t octaspire_dern_bytes_find(
+    octaspire_dern_bytes_t const * const self,
+    void const * const needle,
+    size_t const needleLength,
+    size_t const start);
+
+bool octaspire_dern_bytes_integer_format_from_name(
+    char const * const name,
+    octaspire_dern_bytes_integer_format_t * const result);
+
+size_t octaspire_dern_bytes_integer_format_get_length(
+    octaspire_dern_bytes_integer_format_t const format);
+
+// Appends 'value' to the end of 'self' in the given format. Bits of
+// 'value' that do not fit into the format are dropped.
+bool octaspire_dern_bytes_pack_integer(
+    octaspire_dern_bytes_t * const self,
+    octaspire_dern_bytes_integer_format_t const format,
+    int64_t const value);
+
+// Reads an integer in the given format starting from 'index'. Returns
+// false if 'self' has not enough octets after 'index'. Values of 'u64
+// formats above INT64_MAX are given as their two's complement.
+bool octaspire_dern_bytes_unpack_integer(
+    octaspire_dern_bytes_t const * const self,
+    size_t const index,
+    octaspire_dern_bytes_integer_format_t const format,
+    int64_t * const result);
+
+int octaspire_dern_bytes_compare(
+    octaspire_dern_bytes_t const * const self,
+    octaspire_dern_bytes_t const * const other);
+
+uint32_t octaspire_dern_bytes_get_hash(
+    octaspire_dern_bytes_t const * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -0,0 +1,108 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_DEQUE_H
+#define OCTASPIRE_DERN_DEQUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_value_t;
+
+// Double-ended sequence of Dern values, used by list and queue values.
+// Elements are stored in fixed size chunks that are reached through a
+// table of chunk pointers, so pushing and popping at either end and
+// accessing an element by index take constant time, and elements inside
+// a chunk are contiguous in memory. A deque can have a maximum length;
+// pushing to the back of a full deque drops the element at the front.
+typedef struct octaspire_dern_deque_t octaspire_dern_deque_t;
+
+octaspire_dern_deque_t *octaspire_dern_deque_new(
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_deque_t *octaspire_dern_deque_new_with_max_length(
+    size_t const maxLength,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_deque_release(octaspire_dern_deque_t *self);
+
+size_t octaspire_dern_deque_get_length(
+    octaspire_dern_deque_t const * const self);
+
+bool octaspire_dern_deque_is_empty(
+    octaspire_dern_deque_t const * const self);
+
+bool octaspire_dern_deque_has_max_length(
+    octaspire_dern_deque_t const * const self);
+
+size_t octaspire_dern_deque_get_max_length(
+    octaspire_dern_deque_t const * const self);
+
+bool octaspire_dern_deque_push_back(
+    octaspire_dern_deque_t * const self,
+    struct octaspire_dern_value_t * const element);
+
+bool octaspire_dern_deque_push_front(
+    octaspire_dern_deque_t * const self,
+    struct octaspire_dern_value_t * const element);
+
+bool octaspire_dern_deque_pop_back(
+    octaspire_dern_deque_t * const self);
+
+bool octaspire_dern_deque_pop_front(
+    octaspire_dern_deque_t * const self);
+
+void octaspire_dern_deque_clear(
+    octaspire_dern_deque_t * const self);
+
+struct octaspire_dern_value_t *octaspire_dern_deque_get_at(
+    octaspire_dern_deque_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+// Iterates the elements from front to back a chunk at a time.
+typedef struct octaspire_dern_deque_iterator_t
+{
+    octaspire_dern_deque_t const   *deque;
+    struct octaspire_dern_value_t **chunkElement;
+    struct octaspire_dern_value_t  *element;
+    size_t                          index;
+    size_t                          chunkRemaining;
+}
+octaspire_dern_deque_iterator_t;
+
+octaspire_dern_deque_iterator_t octaspire_dern_deque_iterator_init(
+    octaspire_dern_deque_t const * const self);
+
+bool octaspire_dern_deque_iterator_next(
+    octaspire_dern_deque_iterator_t * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -33,10 +33,14 @@ struct octaspire_dern_vm_t;
 
 typedef struct octaspire_dern_environment_t
 {
-    octaspire_map_t      *bindings;
+    octaspire_dern_map_t      *bindings;
     struct octaspire_dern_value_t       *enclosing;
     struct octaspire_dern_vm_t          *vm;
     octaspire_allocator_t        *allocator;
+
+    // Number of environments sharing 'bindings' after a copy, or zero if
+    // the bindings are not shared. Shared bindings are duplicated on set.
+    size_t               *bindingsShareCount;
 }
 octaspire_dern_environment_t;
 
@@ -78,7 +82,7 @@ bool octaspire_dern_environment_print(
 size_t octaspire_dern_environment_get_length(
     octaspire_dern_environment_t const * const self);
 
-octaspire_map_element_t *octaspire_dern_environment_get_at_index(
+octaspire_dern_map_element_t *octaspire_dern_environment_get_at_index(
     octaspire_dern_environment_t * const self,
     ptrdiff_t const index);
 
@@ -0,0 +1,102 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_FASL_H
+#define OCTASPIRE_DERN_FASL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+    #include <octaspire/core/octaspire_stdio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_vm_t;
+struct octaspire_dern_value_t;
+
+// Cache of the parsed forms of one source file (a "fasl" file, for fast
+// load). Forms are kept in a compact binary form, so that they can be
+// loaded again without lexing and parsing the source. The cache file
+// records a hash and the length of the source and the version of Dern;
+// it is used only when all of them match.
+typedef struct octaspire_dern_fasl_t octaspire_dern_fasl_t;
+
+// Hashes the source at 'sourcePath'. Returns null if the source cannot
+// be read. Without 'cacheDirectory' the cache file is 'sourcePath' with
+// suffix '.fasl'; in 'cacheDirectory' it is named after the hash of the
+// source and the version of Dern.
+octaspire_dern_fasl_t *octaspire_dern_fasl_new(
+    char const * const sourcePath,
+    char const * const cacheDirectory,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_fasl_release(octaspire_dern_fasl_t *self);
+
+char const *octaspire_dern_fasl_get_path(
+    octaspire_dern_fasl_t const * const self);
+
+// Loads the cache file. Returns false if there is none, or if it was
+// written for another source or version or is damaged.
+bool octaspire_dern_fasl_load(octaspire_dern_fasl_t * const self);
+
+// Creates the next loaded form in 'vm'. Returns null after the last form,
+// or an error value if the form cannot be created. 'lineNumber' is set to
+// the line of the source where reading the form ended.
+struct octaspire_dern_value_t *octaspire_dern_fasl_read_next_form(
+    octaspire_dern_fasl_t * const self,
+    struct octaspire_dern_vm_t * const vm,
+    size_t * const lineNumber);
+
+// Adds a parsed form to be saved. Returns false, and nothing is saved
+// later, if the form has values that the parser does not create.
+bool octaspire_dern_fasl_push_back_form(
+    octaspire_dern_fasl_t * const self,
+    struct octaspire_dern_value_t const * const form,
+    size_t const lineNumber);
+
+// Lexes the text of a top-level form and adds the values that the parser
+// would create from it. This does not need a VM, so that forms can be
+// read on any thread. Returns false, and nothing is saved later, if the
+// parser would report an error or more input would be needed.
+bool octaspire_dern_fasl_push_back_source_form(
+    octaspire_dern_fasl_t * const self,
+    char const * const octets,
+    size_t const lengthInOctets,
+    size_t const firstLineNumber);
+
+// Makes the added forms readable with 'octaspire_dern_fasl_read_next_form'
+// without saving and loading them.
+void octaspire_dern_fasl_load_added_forms(octaspire_dern_fasl_t * const self);
+
+// Writes the added forms into the cache file. The file is written under
+// another name and renamed, so that a partly written file is never used.
+bool octaspire_dern_fasl_save(octaspire_dern_fasl_t * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
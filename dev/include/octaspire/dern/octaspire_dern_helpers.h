@@ -31,13 +31,82 @@ extern "C"       {
 #endif
 
 int octaspire_dern_helpers_compare_value_hash_maps(
-    octaspire_map_t const * const firstValueHashMap,
-    octaspire_map_t const * const otherValueHashMap);
+    octaspire_dern_map_t const * const firstValueHashMap,
+    octaspire_dern_map_t const * const otherValueHashMap);
+
+uint32_t octaspire_dern_helpers_calculate_hash_for_octets(
+    void const * const octets,
+    size_t const numOctets);
 
 double octaspire_dern_helpers_atof(
     char const * const str,
     octaspire_allocator_t * const allocator);
 
+// Like 'octaspire_string_new_copy', but also for strings whose octets
+// are empty: empty strings and strings whose octets are not encoded yet.
+// Copying those would pass a null buffer to memcpy.
+octaspire_string_t *octaspire_dern_helpers_copy_string(
+    octaspire_string_t const * const str,
+    octaspire_allocator_t * const allocator);
+
+// Returns a negative number when the element at index 'first' must come
+// before the element at index 'second'.
+typedef int (*octaspire_dern_helpers_index_compare_t)(
+    size_t const first,
+    size_t const second,
+    void * const context);
+
+// Sorts 'indices' stably with 'compare'. Short runs are insertion sorted
+// and then merged, skipping the merges of runs that are already in order.
+// Returns false if memory for merging could not be allocated.
+bool octaspire_dern_helpers_sort_indices(
+    size_t * const indices,
+    size_t const length,
+    octaspire_dern_helpers_index_compare_t const compare,
+    void * const context,
+    octaspire_allocator_t * const allocator);
+
+// Finds the first occurrence of 'needle' in 'haystack' starting at or
+// after octet index 'start'. Short needles are found by scanning for
+// their first octet with memchr and comparing the rest with memcmp;
+// longer needles use the two-way string matching algorithm, that looks
+// at every octet of the haystack at most twice. Returns false if there
+// is no occurrence or if 'needle' is empty.
+bool octaspire_dern_helpers_find_octets(
+    void const * const haystack,
+    size_t const haystackLength,
+    void const * const needle,
+    size_t const needleLength,
+    size_t const start,
+    size_t * const foundIndex);
+
+// Finds all, also overlapping, occurrences of 'str' in 'self' by
+// searching their UTF-8 octets. Returns a vector of the UCS character
+// indices (size_t) of the occurrences, or null if memory could not be
+// allocated. An empty 'str' is not found.
+octaspire_vector_t *octaspire_dern_helpers_find_string(
+    octaspire_string_t const * const self,
+    octaspire_string_t const * const str,
+    octaspire_allocator_t * const allocator);
+
+// Like 'octaspire_dern_helpers_find_string' for a range of UTF-8 octets.
+// 'isAscii' tells that every character of the haystack is one octet.
+octaspire_vector_t *octaspire_dern_helpers_find_all_octets(
+    void const * const haystackOctets,
+    size_t const haystackLength,
+    bool const isAscii,
+    void const * const needle,
+    size_t const needleLength,
+    octaspire_allocator_t * const allocator);
+
+// Returns the index of the first octet of the UCS character at
+// 'ucsIndex' in the UTF-8 octets, or 'numOctets' if there are not that
+// many characters.
+size_t octaspire_dern_helpers_get_octet_index_of_ucs_index(
+    char const * const octets,
+    size_t const numOctets,
+    size_t const ucsIndex);
+
 #ifdef __cplusplus
 /* extern "C" */ }
 #endif
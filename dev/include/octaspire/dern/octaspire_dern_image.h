@@ -0,0 +1,61 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_IMAGE_H
+#define OCTASPIRE_DERN_IMAGE_H
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_vm_t;
+struct octaspire_dern_value_t;
+
+// An image is a snapshot of the global environment of a VM and of the
+// libraries loaded into it. Restoring an image into a new VM makes
+// the definitions of the libraries and programs available without
+// reading and evaluating them again.
+//
+// Every value reachable from the global environment is written once,
+// so that shared and cyclic values stay shared after restoring. Builtins
+// and specials are written by name and found again from the new VM;
+// binary libraries are required again. Ports, C data, errors and other
+// values bound to resources of the running process cannot be written.
+// Neither can persistent vectors, persistent hash maps, sorted maps,
+// string slices and weak references yet; saving an environment that
+// reaches one of them fails with an error naming its type.
+
+// Returns true, or an error value if the image cannot be written. The
+// file is written under another name and renamed, so that a partly
+// written image is never used.
+struct octaspire_dern_value_t *octaspire_dern_image_save(
+    struct octaspire_dern_vm_t * const vm,
+    char const * const path);
+
+// Restores the image into 'vm', which should be new. Returns true, or an
+// error value. The whole file is checked before anything is restored,
+// but if a library or builtin of the image cannot be found, the VM can
+// be left partly restored.
+struct octaspire_dern_value_t *octaspire_dern_image_load(
+    struct octaspire_dern_vm_t * const vm,
+    char const * const path);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -146,6 +146,24 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_pop_next_token(
     octaspire_input_t *input,
     octaspire_allocator_t *allocator);
 
+// Functions below are for readers that build values straight from the
+// input without creating tokens.
+
+// Pops white space and comments that start with ';'. Multiline comments
+// are left in the input.
+void octaspire_dern_lexer_pop_whitespace_and_line_comments(
+    octaspire_input_t *input);
+
+// Tells whether the next token would be a symbol, 'true', 'false' or 'nil'.
+bool octaspire_dern_lexer_is_symbol_next(
+    octaspire_input_t *input);
+
+// Pops the text of the next symbol, 'true', 'false' or 'nil' into a new
+// string. Returns null if allocation fails.
+octaspire_string_t *octaspire_dern_lexer_pop_symbol_text(
+    octaspire_input_t *input,
+    octaspire_allocator_t *allocator);
+
 #ifdef __cplusplus
 /* extern "C" */ }
 #endif
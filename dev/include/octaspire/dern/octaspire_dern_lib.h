@@ -43,6 +43,7 @@ octaspire_dern_lib_tag_t;
 typedef struct octaspire_dern_lib_t octaspire_dern_lib_t;
 struct octaspire_dern_vm_t;
 struct octaspire_dern_c_data_t;
+struct octaspire_dern_reader_t;
 
 octaspire_dern_lib_t *octaspire_dern_lib_new_source(
     char const * const name,
@@ -50,6 +51,19 @@ octaspire_dern_lib_t *octaspire_dern_lib_new_source(
     struct octaspire_dern_vm_t *vm,
     octaspire_allocator_t *allocator);
 
+octaspire_dern_lib_t *octaspire_dern_lib_new_source_from_reader(
+    char const * const name,
+    struct octaspire_dern_reader_t * const reader,
+    struct octaspire_dern_vm_t *vm,
+    octaspire_allocator_t *allocator);
+
+// Library whose definitions are restored from an image; nothing is
+// evaluated.
+octaspire_dern_lib_t *octaspire_dern_lib_new_source_from_image(
+    char const * const name,
+    struct octaspire_dern_vm_t *vm,
+    octaspire_allocator_t *allocator);
+
 octaspire_dern_lib_t *octaspire_dern_lib_new_binary(
     char const * const name,
     char const * const fileName,
@@ -71,6 +85,10 @@ void octaspire_dern_lib_release(octaspire_dern_lib_t *self);
 
 bool octaspire_dern_lib_is_good(octaspire_dern_lib_t const * const self);
 
+bool octaspire_dern_lib_is_binary(octaspire_dern_lib_t const * const self);
+
+char const *octaspire_dern_lib_get_name(octaspire_dern_lib_t const * const self);
+
 char const *octaspire_dern_lib_get_error_message(octaspire_dern_lib_t const * const self);
 
 bool octaspire_dern_lib_mark_all(octaspire_dern_lib_t * const self);
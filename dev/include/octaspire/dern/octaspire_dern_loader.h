@@ -0,0 +1,82 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_LOADER_H
+#define OCTASPIRE_DERN_LOADER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+    #include <octaspire/core/octaspire_stdio.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_fasl.h"
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+// Reads the forms of many source files at the same time. Files are split
+// into forms and lexed without a VM, into the form trees of
+// 'octaspire_dern_fasl_t', so that a VM can create values from them in
+// the order of the files. When built with OCTASPIRE_DERN_CONFIG_THREADS
+// files are read on worker threads while the caller waits for the files
+// in order; otherwise every file is read when it is waited for.
+typedef struct octaspire_dern_loader_t octaspire_dern_loader_t;
+
+// Paths are copied. 'allocator' is used only from the calling thread;
+// files are read with an allocator and stdio that the loader creates
+// for the worker threads, so the forms given out are allocated with
+// those. With 'faslCacheOn' fresh forms are loaded from the cache
+// instead of the source.
+octaspire_dern_loader_t *octaspire_dern_loader_new(
+    char const * const * const paths,
+    size_t const numPaths,
+    bool const faslCacheOn,
+    char const * const faslCacheDirectory,
+    octaspire_allocator_t * const allocator);
+
+// Files not waited for yet are not read to the end.
+void octaspire_dern_loader_release(octaspire_dern_loader_t *self);
+
+size_t octaspire_dern_loader_get_number_of_paths(
+    octaspire_dern_loader_t const * const self);
+
+char const *octaspire_dern_loader_get_path_at(
+    octaspire_dern_loader_t const * const self,
+    size_t const index);
+
+// Waits until the file at 'index' is read and gives its forms. Returns
+// null if the file cannot be read, or if the parser would report an
+// error in it; such a file should be read with a reader, so that the
+// error is reported as usual. 'isLoadedFromCache' tells whether the
+// forms came from the cache and do not need to be saved.
+octaspire_dern_fasl_t *octaspire_dern_loader_wait_for_forms(
+    octaspire_dern_loader_t * const self,
+    size_t const index,
+    bool * const isLoadedFromCache);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -0,0 +1,173 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_MAP_H
+#define OCTASPIRE_DERN_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_value_t;
+
+// Hash table from Dern values to Dern values, used by hash map values and
+// environments. Elements are kept in a dense array in insertion order and
+// found through a separate open addressing index; small maps live inside
+// the map itself and are searched linearly. Iteration and positional access
+// follow insertion order. Pointers to elements are invalidated by put,
+// remove and get_at_index.
+typedef struct octaspire_dern_map_t octaspire_dern_map_t;
+
+typedef struct octaspire_dern_map_element_t
+{
+    struct octaspire_dern_value_t *key;
+    struct octaspire_dern_value_t *value;
+    uint32_t                       hash;
+    char                           padding[4];
+}
+octaspire_dern_map_element_t;
+
+octaspire_dern_map_t *octaspire_dern_map_new(
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_map_t *octaspire_dern_map_new_copy(
+    octaspire_dern_map_t const * const other,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_map_release(octaspire_dern_map_t *self);
+
+bool octaspire_dern_map_put(
+    octaspire_dern_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t * const key,
+    struct octaspire_dern_value_t * const value);
+
+// Like 'octaspire_dern_map_put', but an existing element gets also the
+// new key. Element keeps its place in the insertion order.
+bool octaspire_dern_map_put_replacing_key(
+    octaspire_dern_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t * const key,
+    struct octaspire_dern_value_t * const value);
+
+bool octaspire_dern_map_remove(
+    octaspire_dern_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t const * const key);
+
+bool octaspire_dern_map_clear(
+    octaspire_dern_map_t * const self);
+
+// Makes keys that are vectors, hash maps, queues, lists or sets hashed by
+// their identity instead of the hash given to put, get and remove. Weak
+// hash maps use this, because their keys are identities. Map must be empty.
+void octaspire_dern_map_set_hashes_collection_keys_by_identity(
+    octaspire_dern_map_t * const self,
+    bool const hashesCollectionKeysByIdentity);
+
+// Makes room for 'numElements' elements, so that putting that many
+// elements does not grow the map again.
+bool octaspire_dern_map_reserve(
+    octaspire_dern_map_t * const self,
+    size_t const numElements);
+
+bool octaspire_dern_map_add_map(
+    octaspire_dern_map_t * const self,
+    octaspire_dern_map_t const * const other);
+
+octaspire_dern_map_element_t *octaspire_dern_map_get(
+    octaspire_dern_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t const * const key);
+
+octaspire_dern_map_element_t const *octaspire_dern_map_get_const(
+    octaspire_dern_map_t const * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t const * const key);
+
+bool octaspire_dern_map_is_empty(
+    octaspire_dern_map_t const * const self);
+
+size_t octaspire_dern_map_get_number_of_elements(
+    octaspire_dern_map_t const * const self);
+
+octaspire_dern_map_element_t *octaspire_dern_map_get_at_index(
+    octaspire_dern_map_t * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+octaspire_dern_map_element_t const *octaspire_dern_map_get_at_index_const(
+    octaspire_dern_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+struct octaspire_dern_value_t *octaspire_dern_map_element_get_key(
+    octaspire_dern_map_element_t const * const self);
+
+struct octaspire_dern_value_t *octaspire_dern_map_element_get_value(
+    octaspire_dern_map_element_t const * const self);
+
+struct octaspire_dern_value_t const *octaspire_dern_map_element_get_key_const(
+    octaspire_dern_map_element_t const * const self);
+
+struct octaspire_dern_value_t const *octaspire_dern_map_element_get_value_const(
+    octaspire_dern_map_element_t const * const self);
+
+uint32_t octaspire_dern_map_element_get_hash(
+    octaspire_dern_map_element_t const * const self);
+
+typedef struct octaspire_dern_map_element_iterator_t
+{
+    octaspire_dern_map_t         *hashMap;
+    octaspire_dern_map_element_t *element;
+    size_t                        index;
+}
+octaspire_dern_map_element_iterator_t;
+
+octaspire_dern_map_element_iterator_t octaspire_dern_map_element_iterator_init(
+    octaspire_dern_map_t * const self);
+
+bool octaspire_dern_map_element_iterator_next(
+    octaspire_dern_map_element_iterator_t * const self);
+
+typedef struct octaspire_dern_map_element_const_iterator_t
+{
+    octaspire_dern_map_t const         *hashMap;
+    octaspire_dern_map_element_t const *element;
+    size_t                              index;
+}
+octaspire_dern_map_element_const_iterator_t;
+
+octaspire_dern_map_element_const_iterator_t octaspire_dern_map_element_const_iterator_init(
+    octaspire_dern_map_t const * const self);
+
+bool octaspire_dern_map_element_const_iterator_next(
+    octaspire_dern_map_element_const_iterator_t * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
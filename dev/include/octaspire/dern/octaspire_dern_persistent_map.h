@@ -0,0 +1,89 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_PERSISTENT_MAP_H
+#define OCTASPIRE_DERN_PERSISTENT_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_value_t;
+
+// Hash array mapped trie from Dern values to Dern values. Each level
+// uses five bits of the hash; keys with equal hashes end up in a
+// collision node. Nodes are reference counted and shared between copies
+// like in octaspire_dern_persistent_vector_t: copying is constant time
+// and modifying copies only the shared nodes on the path to the key.
+typedef struct octaspire_dern_persistent_map_t octaspire_dern_persistent_map_t;
+
+octaspire_dern_persistent_map_t *octaspire_dern_persistent_map_new(
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_persistent_map_t *octaspire_dern_persistent_map_new_copy(
+    octaspire_dern_persistent_map_t const * const other,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_persistent_map_release(
+    octaspire_dern_persistent_map_t *self);
+
+size_t octaspire_dern_persistent_map_get_number_of_elements(
+    octaspire_dern_persistent_map_t const * const self);
+
+bool octaspire_dern_persistent_map_put(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t * const key,
+    struct octaspire_dern_value_t * const value);
+
+bool octaspire_dern_persistent_map_remove(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t const * const key);
+
+struct octaspire_dern_value_t *octaspire_dern_persistent_map_get(
+    octaspire_dern_persistent_map_t const * const self,
+    uint32_t const hash,
+    struct octaspire_dern_value_t const * const key);
+
+// Elements are in the order of their hashes. Finding an element by
+// position takes time proportional to the depth of the trie.
+bool octaspire_dern_persistent_map_get_at_index(
+    octaspire_dern_persistent_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    struct octaspire_dern_value_t ** const key,
+    struct octaspire_dern_value_t ** const value);
+
+bool octaspire_dern_persistent_map_mark(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const markEpoch);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
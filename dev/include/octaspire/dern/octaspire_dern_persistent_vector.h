@@ -0,0 +1,84 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_PERSISTENT_VECTOR_H
+#define OCTASPIRE_DERN_PERSISTENT_VECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_value_t;
+
+// Vector of Dern values stored as a 32-way trie with a separate tail
+// node. Nodes are reference counted and shared between copies: a copy
+// is made in constant time, and modifying a vector copies only the nodes
+// on the path to the element that are shared with another vector. Nodes
+// that are owned by one vector alone are modified in place.
+typedef struct octaspire_dern_persistent_vector_t octaspire_dern_persistent_vector_t;
+
+octaspire_dern_persistent_vector_t *octaspire_dern_persistent_vector_new(
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_persistent_vector_t *octaspire_dern_persistent_vector_new_copy(
+    octaspire_dern_persistent_vector_t const * const other,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_persistent_vector_release(
+    octaspire_dern_persistent_vector_t *self);
+
+size_t octaspire_dern_persistent_vector_get_length(
+    octaspire_dern_persistent_vector_t const * const self);
+
+bool octaspire_dern_persistent_vector_is_index_valid(
+    octaspire_dern_persistent_vector_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+struct octaspire_dern_value_t *octaspire_dern_persistent_vector_get_element_at(
+    octaspire_dern_persistent_vector_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+bool octaspire_dern_persistent_vector_set_element_at(
+    octaspire_dern_persistent_vector_t * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    struct octaspire_dern_value_t * const value);
+
+bool octaspire_dern_persistent_vector_push_back_element(
+    octaspire_dern_persistent_vector_t * const self,
+    struct octaspire_dern_value_t * const value);
+
+// Marks all elements for the GC. Nodes shared by many vectors are
+// visited only once for each different 'markEpoch'.
+bool octaspire_dern_persistent_vector_mark(
+    octaspire_dern_persistent_vector_t * const self,
+    uint32_t const markEpoch);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -0,0 +1,113 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_READER_H
+#define OCTASPIRE_DERN_READER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+    #include <octaspire/core/octaspire_stdio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+// Reads source text in chunks of fixed size and splits it into complete
+// top-level forms. Only the octets of the current form are kept, so that
+// a source of any length is read in memory bounded by its largest form.
+// Comments and white space between top-level forms are skipped.
+typedef struct octaspire_dern_reader_t octaspire_dern_reader_t;
+
+// Reads at most 'size' octets into 'buffer'. Returns the number of octets
+// read, zero at the end of input or a negative number on error. For
+// example a file descriptor can be read with a callback calling 'read'.
+typedef ptrdiff_t (*octaspire_dern_reader_read_callback_t)(
+    void * const context,
+    void * const buffer,
+    size_t const size);
+
+// Returns null if the file cannot be opened. When built with
+// OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES a regular file is mapped into
+// memory and its forms are read from the mapped pages without copying;
+// other files, like pipes, are read in chunks.
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_path(
+    char const * const path,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator);
+
+// The reader does not close 'file'.
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_file(
+    FILE * const file,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator);
+
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_callback(
+    octaspire_dern_reader_read_callback_t const callback,
+    void * const context,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_reader_release(octaspire_dern_reader_t *self);
+
+// Reads the next top-level form. Returns false at the end of input or if
+// reading failed. Incomplete text at the end of input is returned as the
+// last form, so that the lexer can report it.
+bool octaspire_dern_reader_read_next_form(octaspire_dern_reader_t * const self);
+
+// UTF-8 octets of the form read last. They are not null terminated and
+// stay valid until the next form is read.
+char const *octaspire_dern_reader_get_form_octets(
+    octaspire_dern_reader_t const * const self);
+
+size_t octaspire_dern_reader_get_form_length_in_octets(
+    octaspire_dern_reader_t const * const self);
+
+// Line number, starting from one, where the form read last begins.
+size_t octaspire_dern_reader_get_form_line_number(
+    octaspire_dern_reader_t const * const self);
+
+// Column number, starting from one, where the form read last begins.
+size_t octaspire_dern_reader_get_form_column_number(
+    octaspire_dern_reader_t const * const self);
+
+// Index of the character, starting from zero, where the form read last
+// begins.
+size_t octaspire_dern_reader_get_form_ucs_index(
+    octaspire_dern_reader_t const * const self);
+
+size_t octaspire_dern_reader_get_number_of_octets_read(
+    octaspire_dern_reader_t const * const self);
+
+bool octaspire_dern_reader_has_error(
+    octaspire_dern_reader_t const * const self);
+
+// Path of the file, or null if the reader was not created from a path.
+char const *octaspire_dern_reader_get_path(
+    octaspire_dern_reader_t const * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
@@ -0,0 +1,125 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_SORTED_MAP_H
+#define OCTASPIRE_DERN_SORTED_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+struct octaspire_dern_value_t;
+
+// Map that keeps its keys in the order of 'octaspire_dern_value_compare'.
+// Elements are stored in the leaves of a B+ tree; a node holds many keys
+// in one array, so that finding a key touches only a few nodes. Leaves
+// are linked in key order for iterating ranges.
+typedef struct octaspire_dern_sorted_map_t octaspire_dern_sorted_map_t;
+
+typedef struct octaspire_dern_sorted_map_private_leaf_t octaspire_dern_sorted_map_private_leaf_t;
+
+// Iterator is at the end when 'key' is null. Put and remove invalidate
+// iterators of the map.
+typedef struct octaspire_dern_sorted_map_iterator_t
+{
+    octaspire_dern_sorted_map_private_leaf_t const *leaf;
+    struct octaspire_dern_value_t                  *key;
+    struct octaspire_dern_value_t                  *value;
+    size_t                                          index;
+}
+octaspire_dern_sorted_map_iterator_t;
+
+octaspire_dern_sorted_map_t *octaspire_dern_sorted_map_new(
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_sorted_map_release(octaspire_dern_sorted_map_t *self);
+
+size_t octaspire_dern_sorted_map_get_number_of_elements(
+    octaspire_dern_sorted_map_t const * const self);
+
+// Replaces the value if an equal key is in the map already.
+// Putting keys in ascending order fills the nodes completely, so that
+// sorted input is bulk loaded into as few nodes as possible.
+bool octaspire_dern_sorted_map_put(
+    octaspire_dern_sorted_map_t * const self,
+    struct octaspire_dern_value_t * const key,
+    struct octaspire_dern_value_t * const value);
+
+bool octaspire_dern_sorted_map_remove(
+    octaspire_dern_sorted_map_t * const self,
+    struct octaspire_dern_value_t const * const key);
+
+void octaspire_dern_sorted_map_clear(
+    octaspire_dern_sorted_map_t * const self);
+
+// Finds the element with key equal to 'key'. Returns false if there is
+// none. 'foundKey' or 'foundValue' can be null.
+bool octaspire_dern_sorted_map_get(
+    octaspire_dern_sorted_map_t const * const self,
+    struct octaspire_dern_value_t const * const key,
+    struct octaspire_dern_value_t ** const foundKey,
+    struct octaspire_dern_value_t ** const foundValue);
+
+// Finds the element with the greatest key less than or equal to 'key'.
+bool octaspire_dern_sorted_map_get_floor(
+    octaspire_dern_sorted_map_t const * const self,
+    struct octaspire_dern_value_t const * const key,
+    struct octaspire_dern_value_t ** const foundKey,
+    struct octaspire_dern_value_t ** const foundValue);
+
+// Finds the element with the smallest key greater than or equal to 'key'.
+bool octaspire_dern_sorted_map_get_ceiling(
+    octaspire_dern_sorted_map_t const * const self,
+    struct octaspire_dern_value_t const * const key,
+    struct octaspire_dern_value_t ** const foundKey,
+    struct octaspire_dern_value_t ** const foundValue);
+
+// Finds the element at position 'possiblyNegativeIndex' in key order.
+// Takes time proportional to the depth of the tree.
+bool octaspire_dern_sorted_map_get_at_index(
+    octaspire_dern_sorted_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    struct octaspire_dern_value_t ** const foundKey,
+    struct octaspire_dern_value_t ** const foundValue);
+
+octaspire_dern_sorted_map_iterator_t octaspire_dern_sorted_map_iterator_init(
+    octaspire_dern_sorted_map_t const * const self);
+
+// Starts from the element with the smallest key greater than or equal
+// to 'key'.
+octaspire_dern_sorted_map_iterator_t octaspire_dern_sorted_map_iterator_init_at_ceiling(
+    octaspire_dern_sorted_map_t const * const self,
+    struct octaspire_dern_value_t const * const key);
+
+bool octaspire_dern_sorted_map_iterator_next(
+    octaspire_dern_sorted_map_iterator_t * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
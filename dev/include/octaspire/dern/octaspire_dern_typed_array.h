@@ -0,0 +1,173 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#ifndef OCTASPIRE_DERN_TYPED_ARRAY_H
+#define OCTASPIRE_DERN_TYPED_ARRAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_memory.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"       {
+#endif
+
+typedef enum octaspire_dern_typed_array_element_type_t
+{
+    OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64,
+    OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32,
+    OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64,
+    OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32,
+    OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8
+}
+octaspire_dern_typed_array_element_type_t;
+
+typedef enum octaspire_dern_typed_array_operation_t
+{
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_ADD,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SUBTRACT,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MULTIPLY,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MIN,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MAX,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_POW,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT,
+    OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN
+}
+octaspire_dern_typed_array_operation_t;
+
+// Array of numbers of one element type stored contiguously. Integer
+// elements wrap around on overflow. Operations work on whole arrays in
+// plain loops over the elements that the compiler can vectorize.
+typedef struct octaspire_dern_typed_array_t octaspire_dern_typed_array_t;
+
+octaspire_dern_typed_array_t *octaspire_dern_typed_array_new(
+    octaspire_dern_typed_array_element_type_t const elementType,
+    size_t const length,
+    octaspire_allocator_t * const allocator);
+
+// Copies the elements of 'other' converting them into 'elementType'.
+octaspire_dern_typed_array_t *octaspire_dern_typed_array_new_copy(
+    octaspire_dern_typed_array_t const * const other,
+    octaspire_dern_typed_array_element_type_t const elementType,
+    octaspire_allocator_t * const allocator);
+
+void octaspire_dern_typed_array_release(octaspire_dern_typed_array_t *self);
+
+octaspire_dern_typed_array_element_type_t octaspire_dern_typed_array_get_element_type(
+    octaspire_dern_typed_array_t const * const self);
+
+size_t octaspire_dern_typed_array_get_length(
+    octaspire_dern_typed_array_t const * const self);
+
+bool octaspire_dern_typed_array_element_type_is_integer(
+    octaspire_dern_typed_array_element_type_t const elementType);
+
+char const *octaspire_dern_typed_array_element_type_get_name(
+    octaspire_dern_typed_array_element_type_t const elementType);
+
+bool octaspire_dern_typed_array_element_type_from_name(
+    char const * const name,
+    octaspire_dern_typed_array_element_type_t * const result);
+
+bool octaspire_dern_typed_array_push_back_real(
+    octaspire_dern_typed_array_t * const self,
+    double const value);
+
+bool octaspire_dern_typed_array_push_back_integer(
+    octaspire_dern_typed_array_t * const self,
+    int64_t const value);
+
+// Real values are converted into integer elements with saturation and
+// integer values with wrap around.
+void octaspire_dern_typed_array_set_real_at(
+    octaspire_dern_typed_array_t * const self,
+    size_t const index,
+    double const value);
+
+void octaspire_dern_typed_array_set_integer_at(
+    octaspire_dern_typed_array_t * const self,
+    size_t const index,
+    int64_t const value);
+
+double octaspire_dern_typed_array_get_real_at(
+    octaspire_dern_typed_array_t const * const self,
+    size_t const index);
+
+int64_t octaspire_dern_typed_array_get_integer_at(
+    octaspire_dern_typed_array_t const * const self,
+    size_t const index);
+
+void octaspire_dern_typed_array_fill_real(
+    octaspire_dern_typed_array_t * const self,
+    double const value);
+
+// Sets every element to 'self[i] operation other[i]'. Both arrays must
+// have the same element type and length.
+void octaspire_dern_typed_array_apply_array(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation,
+    octaspire_dern_typed_array_t const * const other);
+
+// Sets every element to 'self[i] operation scalar'.
+void octaspire_dern_typed_array_apply_scalar(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation,
+    double const scalar);
+
+// Sets every element to 'operation(self[i])' for the one argument
+// operations sqrt and sin.
+void octaspire_dern_typed_array_apply_unary(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation);
+
+double octaspire_dern_typed_array_get_sum(
+    octaspire_dern_typed_array_t const * const self);
+
+// Both arrays must have the same length.
+double octaspire_dern_typed_array_get_dot_product(
+    octaspire_dern_typed_array_t const * const self,
+    octaspire_dern_typed_array_t const * const other);
+
+// Sorts the elements into ascending order. NaN elements are placed last.
+void octaspire_dern_typed_array_sort(
+    octaspire_dern_typed_array_t * const self);
+
+// Reorders the elements so that element at index 'i' is the element that
+// was at index 'order[i]'. 'order' must be a permutation of the indices.
+bool octaspire_dern_typed_array_reorder(
+    octaspire_dern_typed_array_t * const self,
+    size_t const * const order);
+
+int octaspire_dern_typed_array_compare(
+    octaspire_dern_typed_array_t const * const self,
+    octaspire_dern_typed_array_t const * const other);
+
+uint32_t octaspire_dern_typed_array_get_hash(
+    octaspire_dern_typed_array_t const * const self);
+
+#ifdef __cplusplus
+/* extern "C" */ }
+#endif
+
+#endif
+
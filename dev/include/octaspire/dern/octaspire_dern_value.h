@@ -25,14 +25,19 @@ limitations under the License.
 #else
     #include <octaspire/core/octaspire_vector.h>
     #include <octaspire/core/octaspire_map.h>
-    #include <octaspire/core/octaspire_queue.h>
-    #include <octaspire/core/octaspire_list.h>
     #include <octaspire/core/octaspire_string.h>
     #include <octaspire/core/octaspire_semver.h>
 #endif
 
 #include "octaspire/dern/octaspire_dern_port.h"
 #include "octaspire/dern/octaspire_dern_c_data.h"
+#include "octaspire/dern/octaspire_dern_map.h"
+#include "octaspire/dern/octaspire_dern_deque.h"
+#include "octaspire/dern/octaspire_dern_persistent_vector.h"
+#include "octaspire/dern/octaspire_dern_persistent_map.h"
+#include "octaspire/dern/octaspire_dern_typed_array.h"
+#include "octaspire/dern/octaspire_dern_bytes.h"
+#include "octaspire/dern/octaspire_dern_sorted_map.h"
 
 #ifdef __cplusplus
 extern "C"       {
@@ -61,6 +66,15 @@ typedef enum
     OCTASPIRE_DERN_VALUE_TAG_PORT,
     OCTASPIRE_DERN_VALUE_TAG_C_DATA,
     OCTASPIRE_DERN_VALUE_TAG_SEMVER,
+    OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE,
+    OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR,
+    OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP,
+    OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY,
+    OCTASPIRE_DERN_VALUE_TAG_BYTES,
+    OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER,
+    OCTASPIRE_DERN_VALUE_TAG_SET,
+    OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP,
+    OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE,
 }
 octaspire_dern_value_tag_t;
 
@@ -226,6 +240,20 @@ int octaspire_dern_error_message_compare(
     octaspire_dern_error_message_t const * const self,
     octaspire_dern_error_message_t const * const other);
 
+// Part of the UTF-8 octets of a string. An attached slice reads the
+// octets of the string in 'copyOnWrite.source', which it keeps alive,
+// and 'octets' is null. A slice is detached into its own copy of the
+// octets when that string is mutated, or by the GC when a short slice
+// would be the only thing keeping a long string alive.
+typedef struct octaspire_dern_string_slice_t
+{
+    char   *octets;
+    size_t  octetIndex;
+    size_t  numOctets;
+    size_t  numUcsCharacters;
+}
+octaspire_dern_string_slice_t;
+
 
 struct octaspire_dern_value_t
 {
@@ -245,9 +273,9 @@ struct octaspire_dern_value_t
         octaspire_string_t                  *symbol;
         octaspire_dern_error_message_t      *error;
         octaspire_vector_t                  *vector;
-        octaspire_map_t                     *hashMap;
-        octaspire_queue_t                   *queue;
-        octaspire_list_t                    *list;
+        octaspire_dern_map_t                *hashMap;
+        octaspire_dern_deque_t              *queue;
+        octaspire_dern_deque_t              *list;
         struct octaspire_dern_environment_t *environment;
         octaspire_dern_function_t           *function;
         octaspire_dern_special_t            *special;
@@ -255,13 +283,51 @@ struct octaspire_dern_value_t
         octaspire_dern_port_t               *port;
         octaspire_dern_c_data_t             *cData;
         octaspire_semver_t                  *semver;
+        struct octaspire_dern_value_t       *weakReference;
+        octaspire_dern_persistent_vector_t  *persistentVector;
+        octaspire_dern_persistent_map_t     *persistentHashMap;
+        octaspire_dern_typed_array_t        *typedArray;
+        octaspire_dern_bytes_t              *bytes;
+        octaspire_dern_bytes_t              *stringBuilder;
+        octaspire_dern_map_t                *set;
+        octaspire_dern_sorted_map_t         *sortedMap;
+        octaspire_dern_string_slice_t       *stringSlice;
     }
     value;
 
+    // Copy-on-write: a pending copy of a string, vector or hash map
+    // shares the storage of 'source' until either one is mutated. A
+    // value with 'isCopyOnWriteSource' set lists its pending copies in
+    // 'copies' instead; a source is never itself a pending copy.
+    // Values reachable from a shared source count the pending copies
+    // in 'copyOnWritePins'; mutating a pinned value materializes only
+    // the copies that share it. A value with UINT16_MAX pins is copied
+    // eagerly instead of being shared any further.
+    union
+    {
+        octaspire_dern_value_t  *source;
+        octaspire_vector_t      *copies;
+    }
+    copyOnWrite;
+
     octaspire_dern_value_tag_t   typeTag;
     bool                         mark;
     bool                         howtoAllowed;
-    char                         padding[2];
+    uint16_t                     copyOnWritePins;
+
+    // Keys of a weak hash map do not keep their entries alive;
+    // entries with otherwise unreachable keys are removed by the GC.
+    bool                         hashMapHasWeakKeys;
+
+    // Hash of a string, character, symbol or semver is computed once
+    // and kept until the value is mutated or cleared.
+    bool                         hashIsCached;
+
+    // Transient persistent vectors and hash maps are modified in place
+    // by the builtins ending in '!'; others are never modified.
+    bool                         isTransient;
+    bool                         isCopyOnWriteSource;
+    uint32_t                     cachedHash;
 };
 
 octaspire_dern_value_tag_t octaspire_dern_value_get_type(
@@ -398,6 +464,90 @@ octaspire_dern_c_data_t *octaspire_dern_value_as_c_data_get_value(
 octaspire_dern_c_data_t const *octaspire_dern_value_as_c_data_get_value_const(
     octaspire_dern_value_t const * const self);
 
+bool octaspire_dern_value_is_weak_reference(
+    octaspire_dern_value_t const * const self);
+
+octaspire_dern_value_t *octaspire_dern_value_as_weak_reference_get_value(
+    octaspire_dern_value_t * const self);
+
+bool octaspire_dern_value_as_hash_map_has_weak_keys(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_persistent_vector(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_persistent_hash_map(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_typed_array(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_bytes(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_string_builder(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_set(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_sorted_map(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_string_slice(
+    octaspire_dern_value_t const * const self);
+
+bool octaspire_dern_value_is_transient(
+    octaspire_dern_value_t const * const self);
+
+void octaspire_dern_value_set_transient(
+    octaspire_dern_value_t * const self,
+    bool const transient);
+
+octaspire_dern_value_t *octaspire_dern_value_as_persistent_vector_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+bool octaspire_dern_value_as_persistent_vector_set_element_at(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t * const value);
+
+bool octaspire_dern_value_as_persistent_vector_push_back_element(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const value);
+
+octaspire_dern_value_t *octaspire_dern_value_as_persistent_hash_map_get(
+    octaspire_dern_value_t const * const self,
+    octaspire_dern_value_t const * const key);
+
+bool octaspire_dern_value_as_persistent_hash_map_get_at_index(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t ** const key,
+    octaspire_dern_value_t ** const value);
+
+bool octaspire_dern_value_as_persistent_hash_map_put(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value);
+
+bool octaspire_dern_value_as_persistent_hash_map_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key);
+
+// Returns a new integer or real value holding the element at the index,
+// or null if the index is not valid.
+octaspire_dern_value_t *octaspire_dern_value_as_typed_array_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+// Returns a new integer value holding the octet at the index, or null if
+// the index is not valid.
+octaspire_dern_value_t *octaspire_dern_value_as_bytes_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
 void octaspire_dern_value_print(
     octaspire_dern_value_t const * const self,
     octaspire_allocator_t *allocator);
@@ -448,6 +598,31 @@ bool octaspire_dern_value_as_hash_map_remove(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const keyValue);
 
+// Atoms are copied when added, so that mutating the added value later
+// does not change the element of the set.
+bool octaspire_dern_value_as_set_add(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const element);
+
+bool octaspire_dern_value_as_set_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const element);
+
+bool octaspire_dern_value_as_set_contains(
+    octaspire_dern_value_t const * const self,
+    octaspire_dern_value_t const * const element);
+
+// Atoms are copied when put, and collections used as keys are copied,
+// so that mutating them later cannot break the order of the keys.
+bool octaspire_dern_value_as_sorted_map_put(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value);
+
+bool octaspire_dern_value_as_sorted_map_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key);
+
 bool octaspire_dern_value_as_queue_push(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const toBeAdded);
@@ -516,6 +691,22 @@ bool octaspire_dern_value_as_symbol_push_back(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const value);
 
+// Appends the text of 'value' to the string builder. Numbers are
+// formatted straight into the buffer of the builder.
+bool octaspire_dern_value_as_string_builder_push_back(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const value);
+
+// Octets of a slice are not null terminated.
+char const *octaspire_dern_value_as_string_slice_get_octets(
+    octaspire_dern_value_t const * const self);
+
+size_t octaspire_dern_value_as_string_slice_get_length_in_octets(
+    octaspire_dern_value_t const * const self);
+
+size_t octaspire_dern_value_as_string_slice_get_length_in_ucs_characters(
+    octaspire_dern_value_t const * const self);
+
 bool octaspire_dern_value_as_symbol_pop_back(
     octaspire_dern_value_t * const self);
 
@@ -900,10 +1091,16 @@ octaspire_dern_value_tag_t octaspire_dern_value_as_vector_get_element_type_at_co
     octaspire_dern_value_t const * const self,
     ptrdiff_t const possiblyNegativeIndex);
 
+// Returns the element at the index, or null if the index is not valid.
 octaspire_dern_value_t *octaspire_dern_value_as_list_get_element_at(
     octaspire_dern_value_t * const self,
     ptrdiff_t const possiblyNegativeIndex);
 
+// Returns the element at the index, or null if the index is not valid.
+octaspire_dern_value_t *octaspire_dern_value_as_queue_get_element_at(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
 // TODO how about as_vector, should it have void* replaced with octaspire_dern_value_t*?
 bool octaspire_dern_value_as_hash_map_put(
     octaspire_dern_value_t *self,
@@ -914,20 +1111,36 @@ bool octaspire_dern_value_as_hash_map_put(
 size_t octaspire_dern_value_as_hash_map_get_number_of_elements(
     octaspire_dern_value_t const * const self);
 
-octaspire_map_element_t *octaspire_dern_value_as_hash_map_get_at_index(
+octaspire_dern_map_element_t *octaspire_dern_value_as_hash_map_get_at_index(
     octaspire_dern_value_t * const self,
     ptrdiff_t const possiblyNegativeIndex);
 
-octaspire_map_element_t *octaspire_dern_value_as_hash_map_get(
+octaspire_dern_map_element_t *octaspire_dern_value_as_hash_map_get(
     octaspire_dern_value_t * const self,
     uint32_t const hash,
     octaspire_dern_value_t const * const key);
 
-octaspire_map_element_t const *octaspire_dern_value_as_hash_map_get_const(
+octaspire_dern_map_element_t const *octaspire_dern_value_as_hash_map_get_const(
     octaspire_dern_value_t const * const self,
     uint32_t const hash,
     octaspire_dern_value_t const * const key);
 
+// Keys and values of hash maps can be read through these without using
+// the elements of the table behind hash maps, which is internal and can
+// change between releases. Negative indexes count from the end, and
+// null is returned for a missing index or key.
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_key_at_index(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_at_index(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex);
+
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key);
+
 octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_for_symbol_key_using_c_string(
     octaspire_dern_value_t * const self,
     char const * const keySymbolsContentAsCString);
@@ -942,6 +1155,36 @@ size_t octaspire_dern_value_get_length(
 
 bool octaspire_dern_value_mark(octaspire_dern_value_t *self);
 
+bool octaspire_dern_value_is_copy_on_write_pending(
+    octaspire_dern_value_t const * const self);
+
+// Source whose storage a pending copy or attached slice shares, or null.
+octaspire_dern_value_t *octaspire_dern_value_get_copy_on_write_source(
+    octaspire_dern_value_t const * const self);
+
+// Must be called before a value is changed in place. Mutating a value
+// that is shared with pending copies materializes those copies.
+void octaspire_dern_value_prepare_for_mutation(
+    octaspire_dern_value_t * const self);
+
+// Pending copies are materialized when their elements are handed out,
+// for example by 'ln@', 'find', 'for' and function calls.
+void octaspire_dern_value_prepare_for_element_access(
+    octaspire_dern_value_t * const self);
+
+// Only strings, vectors and hash maps can be shared by copies.
+bool octaspire_dern_value_is_copy_on_write_shareable(
+    octaspire_dern_value_t const * const self);
+
+// Pinning walks every element once, so a copy saves allocations but is
+// still linear in the size of the value. Returns false, and pins nothing,
+// if some element cannot be shared or is pinned UINT16_MAX times already.
+bool octaspire_dern_value_pin_for_copy_on_write(
+    octaspire_dern_value_t * const self);
+
+void octaspire_dern_value_unpin_for_copy_on_write(
+    octaspire_dern_value_t * const self);
+
 int octaspire_dern_value_compare(
     octaspire_dern_value_t const * const self,
     octaspire_dern_value_t const * const other);
@@ -33,6 +33,7 @@ limitations under the License.
 #include "octaspire/dern/octaspire_dern_lexer.h"
 #include "octaspire/dern/octaspire_dern_lib.h"
 #include "octaspire/dern/octaspire_dern_c_data.h"
+#include "octaspire/dern/octaspire_dern_reader.h"
 
 #ifdef __cplusplus
 extern "C"       {
@@ -49,6 +50,12 @@ typedef struct octaspire_dern_vm_config_t
     bool debugModeOn;
     bool noDlClose;
     octaspire_vector_t * includeDirectories;
+
+    // Parsed forms of source files read from a path are cached, so that
+    // they are not lexed and parsed again while the source is unchanged.
+    // Without a directory the cache is written next to the source.
+    bool faslCacheOn;
+    char const * faslCacheDirectory;
 }
 octaspire_dern_vm_config_t;
 
@@ -72,6 +79,19 @@ struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
     octaspire_dern_vm_t *self,
     octaspire_dern_value_t *valueToBeCopied);
 
+void octaspire_dern_vm_materialize_copy_on_write_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value);
+
+// Materializes the pending copies that share 'value', either directly
+// or as an element of a shared vector or hash map, and no others.
+void octaspire_dern_vm_materialize_copies_sharing_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value);
+
+void octaspire_dern_vm_materialize_all_copy_on_write_values(
+    octaspire_dern_vm_t * const self);
+
 struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_input_file(
     octaspire_dern_vm_t *self,
     char const * const path);
@@ -175,7 +195,59 @@ struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_list(octaspire
 
 octaspire_dern_value_t *octaspire_dern_vm_create_new_value_hash_map_from_hash_map(
     octaspire_dern_vm_t *self,
-    octaspire_map_t * const value);
+    octaspire_dern_map_t * const value);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_weak_hash_map(
+    octaspire_dern_vm_t *self);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_weak_reference(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_value_t * const target);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_persistent_vector(
+    octaspire_dern_vm_t *self);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_persistent_hash_map(
+    octaspire_dern_vm_t *self);
+
+// Elements of the new typed array are zero.
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_typed_array(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_typed_array_element_type_t const elementType,
+    size_t const length);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_typed_array_copy(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_typed_array_t const * const other,
+    octaspire_dern_typed_array_element_type_t const elementType);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_bytes(
+    octaspire_dern_vm_t *self);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_bytes_from_buffer(
+    octaspire_dern_vm_t *self,
+    void const * const buffer,
+    size_t const length);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_string_builder(
+    octaspire_dern_vm_t *self);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_set(
+    octaspire_dern_vm_t *self);
+
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_sorted_map(
+    octaspire_dern_vm_t *self);
+
+// Creates a slice of 'numOctets' octets starting at 'octetIndex' of a
+// string or string slice 'value'. The range must be within 'value' and
+// start and end at character boundaries. The new slice shares the octets
+// of the string, unless the string already has as many sharing values
+// as can be counted.
+struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_string_slice(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_value_t * const value,
+    size_t const octetIndex,
+    size_t const numOctets);
 
 struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_environment(
     octaspire_dern_vm_t *self,
@@ -238,6 +310,10 @@ struct octaspire_dern_value_t *octaspire_dern_vm_peek_value(octaspire_dern_vm_t
 
 bool octaspire_dern_vm_gc(octaspire_dern_vm_t *self);
 
+void octaspire_dern_vm_add_weak_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value);
+
 octaspire_dern_value_t *octaspire_dern_vm_parse(
     octaspire_dern_vm_t *self,
     octaspire_input_t *input);
@@ -270,10 +346,36 @@ octaspire_dern_value_t *octaspire_dern_vm_read_from_buffer_and_eval_in_global_en
     char const * const buffer,
     size_t const lengthInOctets);
 
+// Reads the file in chunks and evaluates every top-level form as soon as
+// it is complete, so that only the form being evaluated is in memory.
 octaspire_dern_value_t *octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
     octaspire_dern_vm_t *self,
     char const * const path);
 
+// Evaluates the forms of the file until its end, or until evaluation
+// results in an error. For example standard input can be given.
+octaspire_dern_value_t *octaspire_dern_vm_read_from_file_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    FILE * const file);
+
+// File descriptors and other sources can be read with a reader created
+// by 'octaspire_dern_reader_new_from_callback'. When 'faslCacheOn' is set
+// in the config, forms of a reader created from a path are loaded from
+// the cache if it is fresh, and otherwise saved into it after all of
+// them were evaluated without errors.
+octaspire_dern_value_t *octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_reader_t * const reader);
+
+// Evaluates the files in order, until the first error. The files are
+// read and lexed on worker threads, so that the next files are ready
+// when the earlier are evaluated; see 'octaspire_dern_loader_t' for what
+// that requires from the allocator of the VM.
+octaspire_dern_value_t *octaspire_dern_vm_read_from_paths_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    char const * const * const paths,
+    size_t const numPaths);
+
 octaspire_dern_value_t *octaspire_dern_vm_get_value_nil(
     octaspire_dern_vm_t *self);
 
@@ -368,6 +470,10 @@ void octaspire_dern_vm_set_function_return(
 
 void octaspire_dern_vm_set_prevent_gc(octaspire_dern_vm_t * const self, bool const prevent);
 
+bool octaspire_dern_vm_get_prevent_gc(octaspire_dern_vm_t const * const self);
+
+uint32_t octaspire_dern_vm_get_mark_epoch(octaspire_dern_vm_t const * const self);
+
 void octaspire_dern_vm_set_gc_trigger_limit(
     octaspire_dern_vm_t * const self,
     size_t const numAllocs);
@@ -393,6 +499,13 @@ octaspire_dern_lib_t const * octaspire_dern_vm_get_library_const(
     octaspire_dern_vm_t const * const self,
     char const * const name);
 
+size_t octaspire_dern_vm_get_number_of_libraries(
+    octaspire_dern_vm_t const * const self);
+
+octaspire_dern_lib_t *octaspire_dern_vm_get_library_at(
+    octaspire_dern_vm_t * const self,
+    ptrdiff_t const index);
+
 bool octaspire_dern_vm_add_command_line_argument(
     octaspire_dern_vm_t * const self,
     char const * const argument);
@@ -0,0 +1,416 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_bytes.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_helpers.h"
+
+struct octaspire_dern_bytes_t
+{
+    uint8_t               *octets;
+    octaspire_allocator_t *allocator;
+    size_t                 length;
+    size_t                 capacity;
+};
+
+static bool octaspire_dern_bytes_private_reserve(
+    octaspire_dern_bytes_t * const self,
+    size_t const extraLength)
+{
+    if (self->capacity - self->length >= extraLength)
+    {
+        return true;
+    }
+
+    size_t newCapacity = (self->capacity < 16) ? 16 : self->capacity;
+
+    while (newCapacity - self->length < extraLength)
+    {
+        newCapacity *= 2;
+    }
+
+    uint8_t * const newOctets =
+        octaspire_allocator_realloc(self->allocator, self->octets, newCapacity);
+
+    if (!newOctets)
+    {
+        return false;
+    }
+
+    self->octets   = newOctets;
+    self->capacity = newCapacity;
+    return true;
+}
+
+octaspire_dern_bytes_t *octaspire_dern_bytes_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_bytes_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_bytes_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_bytes_t));
+    self->allocator = allocator;
+    return self;
+}
+
+octaspire_dern_bytes_t *octaspire_dern_bytes_new_from_buffer(
+    void const * const buffer,
+    size_t const length,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_bytes_t * const self = octaspire_dern_bytes_new(allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    if (!octaspire_dern_bytes_push_back_buffer(self, buffer, length))
+    {
+        octaspire_dern_bytes_release(self);
+        return 0;
+    }
+
+    return self;
+}
+
+void octaspire_dern_bytes_release(octaspire_dern_bytes_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_allocator_free(self->allocator, self->octets);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_bytes_get_length(
+    octaspire_dern_bytes_t const * const self)
+{
+    return self->length;
+}
+
+uint8_t const *octaspire_dern_bytes_get_octets(
+    octaspire_dern_bytes_t const * const self)
+{
+    return self->octets;
+}
+
+uint8_t octaspire_dern_bytes_get_octet_at(
+    octaspire_dern_bytes_t const * const self,
+    size_t const index)
+{
+    octaspire_helpers_verify_true(index < self->length);
+    return self->octets[index];
+}
+
+void octaspire_dern_bytes_set_octet_at(
+    octaspire_dern_bytes_t * const self,
+    size_t const index,
+    uint8_t const octet)
+{
+    octaspire_helpers_verify_true(index < self->length);
+    self->octets[index] = octet;
+}
+
+bool octaspire_dern_bytes_push_back_octet(
+    octaspire_dern_bytes_t * const self,
+    uint8_t const octet)
+{
+    if (!octaspire_dern_bytes_private_reserve(self, 1))
+    {
+        return false;
+    }
+
+    self->octets[self->length] = octet;
+    ++(self->length);
+    return true;
+}
+
+bool octaspire_dern_bytes_push_back_buffer(
+    octaspire_dern_bytes_t * const self,
+    void const * const buffer,
+    size_t const length)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+
+    if (!octaspire_dern_bytes_private_reserve(self, length))
+    {
+        return false;
+    }
+
+    memcpy(self->octets + self->length, buffer, length);
+    self->length += length;
+    return true;
+}
+
+void octaspire_dern_bytes_clear(
+    octaspire_dern_bytes_t * const self)
+{
+    self->length = 0;
+}
+
+ptrdiff_t octaspire_dern_bytes_find(
+    octaspire_dern_bytes_t const * const self,
+    void const * const needle,
+    size_t const needleLength,
+    size_t const start)
+{
+    if (start > self->length || needleLength > self->length - start)
+    {
+        return -1;
+    }
+
+    if (needleLength == 0)
+    {
+        return (ptrdiff_t)start;
+    }
+
+    uint8_t const * const first = (uint8_t const*)needle;
+    uint8_t const *       pos   = self->octets + start;
+    uint8_t const * const last  = self->octets + (self->length - needleLength);
+
+    // memchr finds the candidates for the first octet, so that only those
+    // are compared with the whole needle.
+    while (pos <= last)
+    {
+        pos = memchr(pos, first[0], (size_t)(last - pos) + 1);
+
+        if (!pos)
+        {
+            return -1;
+        }
+
+        if (memcmp(pos, needle, needleLength) == 0)
+        {
+            return pos - self->octets;
+        }
+
+        ++pos;
+    }
+
+    return -1;
+}
+
+static char const * const octaspire_dern_bytes_private_integer_format_names[] =
+{
+    "u8",
+    "i8",
+    "u16le",
+    "u16be",
+    "i16le",
+    "i16be",
+    "u32le",
+    "u32be",
+    "i32le",
+    "i32be",
+    "u64le",
+    "u64be",
+    "i64le",
+    "i64be"
+};
+
+bool octaspire_dern_bytes_integer_format_from_name(
+    char const * const name,
+    octaspire_dern_bytes_integer_format_t * const result)
+{
+    size_t const numFormats =
+        sizeof(octaspire_dern_bytes_private_integer_format_names) /
+        sizeof(octaspire_dern_bytes_private_integer_format_names[0]);
+
+    for (size_t i = 0; i < numFormats; ++i)
+    {
+        if (strcmp(name, octaspire_dern_bytes_private_integer_format_names[i]) == 0)
+        {
+            *result = (octaspire_dern_bytes_integer_format_t)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t octaspire_dern_bytes_integer_format_get_length(
+    octaspire_dern_bytes_integer_format_t const format)
+{
+    switch (format)
+    {
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U8:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I8:
+            return 1;
+
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16BE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16BE:
+            return 2;
+
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32BE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE:
+            return 4;
+
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64BE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64LE:
+        case OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64BE:
+            return 8;
+    }
+
+    abort();
+    return 0;
+}
+
+static bool octaspire_dern_bytes_private_integer_format_is_big_endian(
+    octaspire_dern_bytes_integer_format_t const format)
+{
+    return format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64BE;
+}
+
+static bool octaspire_dern_bytes_private_integer_format_is_signed(
+    octaspire_dern_bytes_integer_format_t const format)
+{
+    return format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I8    ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16LE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I16BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32LE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64LE ||
+           format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I64BE;
+}
+
+bool octaspire_dern_bytes_pack_integer(
+    octaspire_dern_bytes_t * const self,
+    octaspire_dern_bytes_integer_format_t const format,
+    int64_t const value)
+{
+    size_t const length = octaspire_dern_bytes_integer_format_get_length(format);
+    bool   const bigEndian =
+        octaspire_dern_bytes_private_integer_format_is_big_endian(format);
+
+    if (!octaspire_dern_bytes_private_reserve(self, length))
+    {
+        return false;
+    }
+
+    uint64_t const bits = (uint64_t)value;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        size_t const shift = 8 * (bigEndian ? (length - 1 - i) : i);
+        self->octets[self->length + i] = (uint8_t)(bits >> shift);
+    }
+
+    self->length += length;
+    return true;
+}
+
+bool octaspire_dern_bytes_unpack_integer(
+    octaspire_dern_bytes_t const * const self,
+    size_t const index,
+    octaspire_dern_bytes_integer_format_t const format,
+    int64_t * const result)
+{
+    size_t const length = octaspire_dern_bytes_integer_format_get_length(format);
+    bool   const bigEndian =
+        octaspire_dern_bytes_private_integer_format_is_big_endian(format);
+
+    if (index > self->length || length > self->length - index)
+    {
+        return false;
+    }
+
+    uint64_t bits = 0;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        size_t const shift = 8 * (bigEndian ? (length - 1 - i) : i);
+        bits |= (uint64_t)self->octets[index + i] << shift;
+    }
+
+    size_t const numBits = 8 * length;
+
+    if (numBits < 64 &&
+        octaspire_dern_bytes_private_integer_format_is_signed(format) &&
+        (bits & ((uint64_t)1 << (numBits - 1))))
+    {
+        // Sign extend.
+        *result = (int64_t)bits - ((int64_t)1 << numBits);
+    }
+    else
+    {
+        // Sign bit of a 64-bit format is already in place.
+        *result = (int64_t)bits;
+    }
+
+    return true;
+}
+
+int octaspire_dern_bytes_compare(
+    octaspire_dern_bytes_t const * const self,
+    octaspire_dern_bytes_t const * const other)
+{
+    size_t const length =
+        (self->length < other->length) ? self->length : other->length;
+
+    if (length > 0)
+    {
+        int const result = memcmp(self->octets, other->octets, length);
+
+        if (result != 0)
+        {
+            return (result < 0) ? -1 : 1;
+        }
+    }
+
+    if (self->length != other->length)
+    {
+        return (self->length < other->length) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+uint32_t octaspire_dern_bytes_get_hash(
+    octaspire_dern_bytes_t const * const self)
+{
+    return octaspire_dern_helpers_calculate_hash_for_octets(
+        self->octets,
+        self->length);
+}
@@ -0,0 +1,446 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_deque.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_value.h"
+
+#define OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH 64
+
+struct octaspire_dern_deque_t
+{
+    // Table of chunk pointers. Chunks in use are the 'numChunks' entries
+    // starting from 'firstChunk'; all other entries are null.
+    octaspire_dern_value_t ***chunks;
+    octaspire_allocator_t    *allocator;
+    size_t                    chunksLength;
+    size_t                    firstChunk;
+    size_t                    numChunks;
+
+    // Index of the first element inside the first chunk.
+    size_t                    head;
+    size_t                    length;
+    size_t                    maxLength;
+    bool                      hasMaxLength;
+    char                      padding[7];
+};
+
+static bool octaspire_dern_deque_private_reserve_chunk_slot(
+    octaspire_dern_deque_t * const self,
+    bool const atFront)
+{
+    if (atFront ? (self->firstChunk > 0) :
+        (self->firstChunk + self->numChunks < self->chunksLength))
+    {
+        return true;
+    }
+
+    // Move the chunks in use to the middle of the table, making the table
+    // larger if it is more than about half full.
+    size_t const newChunksLength =
+        (self->chunksLength >= (2 * self->numChunks) + 4) ?
+            self->chunksLength :
+            (2 * self->numChunks) + 8;
+
+    size_t const newFirstChunk = (newChunksLength - self->numChunks) / 2;
+
+    if (newChunksLength == self->chunksLength)
+    {
+        memmove(
+            &(self->chunks[newFirstChunk]),
+            &(self->chunks[self->firstChunk]),
+            self->numChunks * sizeof(octaspire_dern_value_t**));
+
+        for (size_t i = 0; i < newFirstChunk; ++i)
+        {
+            self->chunks[i] = 0;
+        }
+
+        for (size_t i = newFirstChunk + self->numChunks; i < newChunksLength; ++i)
+        {
+            self->chunks[i] = 0;
+        }
+    }
+    else
+    {
+        octaspire_dern_value_t *** const newChunks = octaspire_allocator_malloc(
+            self->allocator,
+            newChunksLength * sizeof(octaspire_dern_value_t**));
+
+        if (!newChunks)
+        {
+            return false;
+        }
+
+        memset(newChunks, 0, newChunksLength * sizeof(octaspire_dern_value_t**));
+
+        if (self->numChunks > 0)
+        {
+            memcpy(
+                &(newChunks[newFirstChunk]),
+                &(self->chunks[self->firstChunk]),
+                self->numChunks * sizeof(octaspire_dern_value_t**));
+        }
+
+        octaspire_allocator_free(self->allocator, self->chunks);
+        self->chunks       = newChunks;
+        self->chunksLength = newChunksLength;
+    }
+
+    self->firstChunk = newFirstChunk;
+    return true;
+}
+
+static octaspire_dern_value_t **octaspire_dern_deque_private_new_chunk(
+    octaspire_dern_deque_t * const self)
+{
+    return octaspire_allocator_malloc(
+        self->allocator,
+        OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH * sizeof(octaspire_dern_value_t*));
+}
+
+static void octaspire_dern_deque_private_reset_empty(
+    octaspire_dern_deque_t * const self)
+{
+    assert(self->length == 0);
+
+    // Start from the middle of the chunk, so that alternating pushes and
+    // pops at either end of an empty deque do not allocate new chunks.
+    self->head = OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH / 2;
+}
+
+octaspire_dern_deque_t *octaspire_dern_deque_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_deque_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_deque_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_deque_t));
+    self->allocator = allocator;
+    octaspire_dern_deque_private_reset_empty(self);
+    return self;
+}
+
+octaspire_dern_deque_t *octaspire_dern_deque_new_with_max_length(
+    size_t const maxLength,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_deque_t * const self = octaspire_dern_deque_new(allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->maxLength    = maxLength;
+    self->hasMaxLength = true;
+    return self;
+}
+
+void octaspire_dern_deque_release(octaspire_dern_deque_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < self->numChunks; ++i)
+    {
+        octaspire_allocator_free(
+            self->allocator,
+            self->chunks[self->firstChunk + i]);
+    }
+
+    octaspire_allocator_free(self->allocator, self->chunks);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_deque_get_length(
+    octaspire_dern_deque_t const * const self)
+{
+    return self->length;
+}
+
+bool octaspire_dern_deque_is_empty(
+    octaspire_dern_deque_t const * const self)
+{
+    return self->length == 0;
+}
+
+bool octaspire_dern_deque_has_max_length(
+    octaspire_dern_deque_t const * const self)
+{
+    return self->hasMaxLength;
+}
+
+size_t octaspire_dern_deque_get_max_length(
+    octaspire_dern_deque_t const * const self)
+{
+    return self->maxLength;
+}
+
+bool octaspire_dern_deque_push_back(
+    octaspire_dern_deque_t * const self,
+    octaspire_dern_value_t * const element)
+{
+    size_t const position = self->head + self->length;
+    size_t const chunk    = position / OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH;
+
+    if (chunk >= self->numChunks)
+    {
+        if (!octaspire_dern_deque_private_reserve_chunk_slot(self, false))
+        {
+            return false;
+        }
+
+        octaspire_dern_value_t ** const newChunk =
+            octaspire_dern_deque_private_new_chunk(self);
+
+        if (!newChunk)
+        {
+            return false;
+        }
+
+        self->chunks[self->firstChunk + self->numChunks] = newChunk;
+        ++(self->numChunks);
+    }
+
+    self->chunks[self->firstChunk + chunk]
+        [position % OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH] = element;
+
+    ++(self->length);
+
+    if (self->hasMaxLength)
+    {
+        while (self->length > self->maxLength)
+        {
+            if (!octaspire_dern_deque_pop_front(self))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool octaspire_dern_deque_push_front(
+    octaspire_dern_deque_t * const self,
+    octaspire_dern_value_t * const element)
+{
+    if (self->hasMaxLength && self->length >= self->maxLength)
+    {
+        return false;
+    }
+
+    if (self->head == 0 || self->numChunks == 0)
+    {
+        if (!octaspire_dern_deque_private_reserve_chunk_slot(self, true))
+        {
+            return false;
+        }
+
+        octaspire_dern_value_t ** const newChunk =
+            octaspire_dern_deque_private_new_chunk(self);
+
+        if (!newChunk)
+        {
+            return false;
+        }
+
+        --(self->firstChunk);
+        self->chunks[self->firstChunk] = newChunk;
+        ++(self->numChunks);
+        self->head = OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH;
+    }
+
+    --(self->head);
+    self->chunks[self->firstChunk][self->head] = element;
+    ++(self->length);
+    return true;
+}
+
+bool octaspire_dern_deque_pop_back(
+    octaspire_dern_deque_t * const self)
+{
+    if (self->length == 0)
+    {
+        return false;
+    }
+
+    --(self->length);
+
+    if (self->length == 0)
+    {
+        octaspire_dern_deque_private_reset_empty(self);
+    }
+
+    // One chunk is kept even when the deque is empty.
+    size_t const neededChunks = (self->length == 0) ? 1 :
+        ((self->head + self->length - 1) / OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH) + 1;
+
+    while (self->numChunks > neededChunks)
+    {
+        --(self->numChunks);
+
+        octaspire_allocator_free(
+            self->allocator,
+            self->chunks[self->firstChunk + self->numChunks]);
+
+        self->chunks[self->firstChunk + self->numChunks] = 0;
+    }
+
+    return true;
+}
+
+bool octaspire_dern_deque_pop_front(
+    octaspire_dern_deque_t * const self)
+{
+    if (self->length == 0)
+    {
+        return false;
+    }
+
+    ++(self->head);
+    --(self->length);
+
+    if (self->head == OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH && self->numChunks > 1)
+    {
+        octaspire_allocator_free(self->allocator, self->chunks[self->firstChunk]);
+        self->chunks[self->firstChunk] = 0;
+        ++(self->firstChunk);
+        --(self->numChunks);
+        self->head = 0;
+    }
+
+    if (self->length == 0)
+    {
+        octaspire_dern_deque_private_reset_empty(self);
+    }
+
+    return true;
+}
+
+void octaspire_dern_deque_clear(
+    octaspire_dern_deque_t * const self)
+{
+    while (self->numChunks > 1)
+    {
+        --(self->numChunks);
+
+        octaspire_allocator_free(
+            self->allocator,
+            self->chunks[self->firstChunk + self->numChunks]);
+
+        self->chunks[self->firstChunk + self->numChunks] = 0;
+    }
+
+    self->length = 0;
+    octaspire_dern_deque_private_reset_empty(self);
+}
+
+octaspire_dern_value_t *octaspire_dern_deque_get_at(
+    octaspire_dern_deque_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    ptrdiff_t const index = (possiblyNegativeIndex < 0) ?
+        ((ptrdiff_t)self->length + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (index < 0 || (size_t)index >= self->length)
+    {
+        return 0;
+    }
+
+    size_t const position = self->head + (size_t)index;
+
+    return self->chunks[self->firstChunk + (position / OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH)]
+        [position % OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH];
+}
+
+octaspire_dern_deque_iterator_t octaspire_dern_deque_iterator_init(
+    octaspire_dern_deque_t const * const self)
+{
+    octaspire_dern_deque_iterator_t iter;
+
+    iter.deque          = self;
+    iter.chunkElement   = 0;
+    iter.element        = 0;
+    iter.index          = 0;
+    iter.chunkRemaining = 0;
+
+    if (self->length > 0)
+    {
+        size_t const chunkRemaining = OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH - self->head;
+
+        iter.chunkElement   = &(self->chunks[self->firstChunk][self->head]);
+        iter.element        = *(iter.chunkElement);
+        iter.chunkRemaining =
+            (chunkRemaining < self->length) ? chunkRemaining : self->length;
+    }
+
+    return iter;
+}
+
+bool octaspire_dern_deque_iterator_next(
+    octaspire_dern_deque_iterator_t * const self)
+{
+    octaspire_dern_deque_t const * const deque = self->deque;
+
+    ++(self->index);
+
+    if (self->index >= deque->length)
+    {
+        self->chunkElement   = 0;
+        self->element        = 0;
+        self->chunkRemaining = 0;
+        return false;
+    }
+
+    --(self->chunkRemaining);
+
+    if (self->chunkRemaining > 0)
+    {
+        ++(self->chunkElement);
+    }
+    else
+    {
+        size_t const position  = deque->head + self->index;
+        size_t const remaining = deque->length - self->index;
+
+        self->chunkElement = deque->chunks[
+            deque->firstChunk + (position / OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH)];
+
+        self->chunkRemaining = (remaining < OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH) ?
+            remaining : OCTASPIRE_DERN_DEQUE_CHUNK_LENGTH;
+    }
+
+    self->element = *(self->chunkElement);
+    return true;
+}
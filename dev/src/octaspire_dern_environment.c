@@ -50,20 +50,12 @@ octaspire_dern_environment_t *octaspire_dern_environment_new(
         return 0;
     }
 
-    self->allocator = allocator;
-    self->vm        = vm;
-    self->enclosing = enclosing;
+    self->allocator          = allocator;
+    self->vm                 = vm;
+    self->enclosing          = enclosing;
+    self->bindingsShareCount = 0;
 
-    self->bindings  = octaspire_map_new(
-        sizeof(octaspire_dern_value_t*),
-        true,
-        sizeof(octaspire_dern_value_t*),
-        true,
-        (octaspire_map_key_compare_function_t)octaspire_dern_value_is_equal,
-        (octaspire_map_key_hash_function_t)octaspire_dern_value_get_hash,
-        0,
-        0,
-        allocator);
+    self->bindings  = octaspire_dern_map_new(allocator);
 
     return self;
 }
@@ -73,80 +65,71 @@ octaspire_dern_environment_t *octaspire_dern_environment_new_copy(
     struct octaspire_dern_vm_t * const vm,
     octaspire_allocator_t * const allocator)
 {
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
-
     octaspire_dern_environment_t *self =
         octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_environment_t));
 
     if (!self)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
         return 0;
     }
 
-    self->allocator = allocator;
-    self->vm        = vm;
-
-    self->enclosing = octaspire_dern_vm_create_new_value_copy(vm, other->enclosing);
-
-
-    self->bindings  = octaspire_map_new(
-        sizeof(octaspire_dern_value_t*),
-        true,
-        sizeof(octaspire_dern_value_t*),
-        true,
-        (octaspire_map_key_compare_function_t)octaspire_dern_value_is_equal,
-        (octaspire_map_key_hash_function_t)octaspire_dern_value_get_hash,
-        0,
-        0,
-        allocator);
-
-    octaspire_map_element_iterator_t iter =
-        octaspire_map_element_iterator_init(other->bindings);
-
-    do
+    if (!other->bindingsShareCount)
     {
-        if (iter.element)
+        other->bindingsShareCount =
+            octaspire_allocator_malloc(other->allocator, sizeof(size_t));
+
+        if (!other->bindingsShareCount)
         {
-            octaspire_dern_value_t * const keyVal =
-                octaspire_map_element_get_key(iter.element);
+            octaspire_allocator_free(allocator, self);
+            return 0;
+        }
 
-            octaspire_dern_value_t * const copyOfKeyVal =
-                octaspire_dern_vm_create_new_value_copy(vm, keyVal);
+        *(other->bindingsShareCount) = 1;
+    }
 
-            octaspire_dern_vm_push_value(vm, copyOfKeyVal);
+    // Copy shares the bindings (and the enclosing environment) of the
+    // other environment until either one of them is modified.
+    ++(*(other->bindingsShareCount));
 
-            octaspire_dern_value_t * const valVal =
-                octaspire_map_element_get_value(iter.element);
+    self->allocator          = allocator;
+    self->vm                 = vm;
+    self->enclosing          = other->enclosing;
+    self->bindings           = other->bindings;
+    self->bindingsShareCount = other->bindingsShareCount;
 
-            octaspire_dern_value_t * const copyOfValVal =
-                octaspire_dern_vm_create_new_value_copy(vm, valVal);
+    return self;
+}
 
-            octaspire_dern_vm_push_value(vm, copyOfValVal);
+static bool octaspire_dern_environment_private_make_bindings_unique(
+    octaspire_dern_environment_t * const self)
+{
+    if (!self->bindingsShareCount)
+    {
+        return true;
+    }
 
-            octaspire_dern_vm_pop_value(vm, copyOfValVal);
-            octaspire_dern_vm_pop_value(vm, copyOfKeyVal);
+    if (*(self->bindingsShareCount) == 1)
+    {
+        // Others sharing the bindings are already released or unshared.
+        octaspire_allocator_free(self->allocator, self->bindingsShareCount);
+        self->bindingsShareCount = 0;
+        return true;
+    }
 
-            if (octaspire_map_put(
-                    self->bindings,
-                    octaspire_dern_value_get_hash(copyOfKeyVal),
-                    &copyOfKeyVal,
-                    &copyOfValVal))
-            {
-                abort();
-            }
+    octaspire_dern_map_t * const bindings =
+        octaspire_dern_map_new_copy(self->bindings, self->allocator);
 
-        }
+    if (!bindings)
+    {
+        return false;
     }
-    while (octaspire_map_element_iterator_next(&iter));
 
+    --(*(self->bindingsShareCount));
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    self->bindings           = bindings;
+    self->bindingsShareCount = 0;
 
-    return self;
+    return true;
 }
 
 void octaspire_dern_environment_release(octaspire_dern_environment_t *self)
@@ -156,7 +139,21 @@ void octaspire_dern_environment_release(octaspire_dern_environment_t *self)
         return;
     }
 
-    octaspire_map_release(self->bindings);
+    if (self->bindingsShareCount)
+    {
+        --(*(self->bindingsShareCount));
+
+        if (*(self->bindingsShareCount) > 0)
+        {
+            octaspire_allocator_free(self->allocator, self);
+            return;
+        }
+
+        octaspire_allocator_free(self->allocator, self->bindingsShareCount);
+        self->bindingsShareCount = 0;
+    }
+
+    octaspire_dern_map_release(self->bindings);
     //octaspire_dern_environment_release(self->enclosing);
     octaspire_allocator_free(self->allocator, self);
 }
@@ -354,10 +351,10 @@ octaspire_dern_value_t *octaspire_dern_environment_get(
     octaspire_dern_environment_t *self,
     octaspire_dern_value_t const * const key)
 {
-    octaspire_map_element_t *element = octaspire_map_get(
+    octaspire_dern_map_element_t const * const element = octaspire_dern_map_get_const(
         self->bindings,
         octaspire_dern_value_get_hash(key),
-        &key);
+        key);
 
     if (!element)
     {
@@ -370,7 +367,7 @@ octaspire_dern_value_t *octaspire_dern_environment_get(
         return 0;
     }
 
-    return octaspire_map_element_get_value(element);
+    return octaspire_dern_map_element_get_value(element);
 }
 
 bool octaspire_dern_environment_set(
@@ -378,34 +375,33 @@ bool octaspire_dern_environment_set(
     octaspire_dern_value_t const * const key,
     octaspire_dern_value_t *value)
 {
-    uint32_t const hash = octaspire_dern_value_get_hash(key);
-
-    // TODO XXX should this be made more efficient? Now the element is searched
-    // twice. There could be a method octaspire_map_put_overwriting etc.
-    octaspire_map_remove(self->bindings, hash, &key);
+    if (!octaspire_dern_environment_private_make_bindings_unique(self))
+    {
+        return false;
+    }
 
-    return octaspire_map_put(
+    return octaspire_dern_map_put(
         self->bindings,
         octaspire_dern_value_get_hash(key),
-        &key,
-        &value);
+        (octaspire_dern_value_t*)key,
+        value);
 }
 
 static int octaspire_dern_environment_helper_compare_function(
     void const * const a,
     void const * const b)
 {
-    octaspire_map_element_t const * const elemA =
-        *(octaspire_map_element_t const * const *)a;
+    octaspire_dern_map_element_t const * const elemA =
+        *(octaspire_dern_map_element_t const * const *)a;
 
-    octaspire_map_element_t const * const elemB =
-        *(octaspire_map_element_t const * const *)b;
+    octaspire_dern_map_element_t const * const elemB =
+        *(octaspire_dern_map_element_t const * const *)b;
 
     octaspire_dern_value_t const * const keyA =
-       (octaspire_dern_value_t*)octaspire_map_element_get_key(elemA);
+       (octaspire_dern_value_t*)octaspire_dern_map_element_get_key(elemA);
 
     octaspire_dern_value_t const * const keyB =
-       (octaspire_dern_value_t*)octaspire_map_element_get_key(elemB);
+       (octaspire_dern_value_t*)octaspire_dern_map_element_get_key(elemB);
 
     return octaspire_dern_value_compare(keyA, keyB);
 }
@@ -443,16 +439,16 @@ static octaspire_string_t *octaspire_dern_environment_private_to_string(
     }
 
     octaspire_vector_t *sortVec = octaspire_vector_new(
-        sizeof(octaspire_map_element_t*),
+        sizeof(octaspire_dern_map_element_t*),
         true,
         0,
         self->allocator);
 
     size_t numCharsInLongestKey = 0;
-    for (size_t i = 0; i < octaspire_map_get_number_of_elements(self->bindings); ++i)
+    for (size_t i = 0; i < octaspire_dern_map_get_number_of_elements(self->bindings); ++i)
     {
-        octaspire_map_element_t const * const element =
-            octaspire_map_get_at_index(
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_at_index(
                 self->bindings,
                 (ptrdiff_t)i);
 
@@ -460,7 +456,7 @@ static octaspire_string_t *octaspire_dern_environment_private_to_string(
 
         numCharsInLongestKey = octaspire_helpers_max_size_t(
             numCharsInLongestKey,
-            octaspire_dern_value_get_length(octaspire_map_element_get_key(element)));
+            octaspire_dern_value_get_length(octaspire_dern_map_element_get_key(element)));
 
         if (!octaspire_vector_push_back_element(sortVec, &element))
         {
@@ -475,16 +471,16 @@ static octaspire_string_t *octaspire_dern_environment_private_to_string(
 
     for (size_t i = 0; i < octaspire_vector_get_length(sortVec); ++i)
     {
-        octaspire_map_element_t const * const element =
+        octaspire_dern_map_element_t const * const element =
             octaspire_vector_get_element_at(
                 sortVec,
                 (ptrdiff_t)i);
 
         octaspire_dern_value_t const * const key =
-            octaspire_map_element_get_key(element);
+            octaspire_dern_map_element_get_key(element);
 
         octaspire_dern_value_t const * const value =
-            octaspire_map_element_get_value(element);
+            octaspire_dern_map_element_get_value(element);
 
         octaspire_string_t *keyAsStr =
             octaspire_dern_value_to_string(key, self->allocator);
@@ -549,14 +545,14 @@ bool octaspire_dern_environment_print(
 size_t octaspire_dern_environment_get_length(
     octaspire_dern_environment_t const * const self)
 {
-    return octaspire_map_get_number_of_elements(self->bindings);
+    return octaspire_dern_map_get_number_of_elements(self->bindings);
 }
 
-octaspire_map_element_t *octaspire_dern_environment_get_at_index(
+octaspire_dern_map_element_t *octaspire_dern_environment_get_at_index(
     octaspire_dern_environment_t * const self,
     ptrdiff_t const index)
 {
-    return octaspire_map_get_at_index(self->bindings, index);
+    return octaspire_dern_map_get_at_index(self->bindings, index);
 }
 
 bool octaspire_dern_environment_mark(octaspire_dern_environment_t *self)
@@ -569,21 +565,21 @@ bool octaspire_dern_environment_mark(octaspire_dern_environment_t *self)
     bool statusKey = true;
     bool statusVal = true;
 
-    octaspire_map_element_iterator_t iter =
-        octaspire_map_element_iterator_init(self->bindings);
+    octaspire_dern_map_element_iterator_t iter =
+        octaspire_dern_map_element_iterator_init(self->bindings);
 
     while (iter.element)
     {
         octaspire_dern_value_t * const key =
-            octaspire_map_element_get_key(iter.element);
+            octaspire_dern_map_element_get_key(iter.element);
 
         octaspire_dern_value_t * const val =
-            octaspire_map_element_get_value(iter.element);
+            octaspire_dern_map_element_get_value(iter.element);
 
         statusKey = octaspire_dern_value_mark(key);
         statusVal = octaspire_dern_value_mark(val);
 
-        octaspire_map_element_iterator_next(&iter);
+        octaspire_dern_map_element_iterator_next(&iter);
     }
 
     if (self->enclosing && self->enclosing->value.environment != self)
@@ -624,17 +620,17 @@ bool octaspire_dern_environment_get_all_names_to_vector(
         }
     }
 
-    for (size_t i = 0; i < octaspire_map_get_number_of_elements(self->bindings); ++i)
+    for (size_t i = 0; i < octaspire_dern_map_get_number_of_elements(self->bindings); ++i)
     {
-        octaspire_map_element_t const * const element =
-            octaspire_map_get_at_index(
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_at_index(
                 self->bindings,
                 (ptrdiff_t)i);
 
         assert(element);
 
         octaspire_dern_value_t const * const key =
-            octaspire_map_element_get_key(element);
+            octaspire_dern_map_element_get_key(element);
 
         octaspire_string_t * const keyAsStr =
             octaspire_dern_value_to_string(key, self->allocator);
@@ -648,6 +644,18 @@ bool octaspire_dern_environment_get_all_names_to_vector(
     return true;
 }
 
+static int octaspire_dern_environment_private_compare_names(
+    void const * const a,
+    void const * const b)
+{
+    octaspire_string_t const * const * const first  = a;
+    octaspire_string_t const * const * const second = b;
+
+    return strcmp(
+        octaspire_string_get_c_string(*first),
+        octaspire_string_get_c_string(*second));
+}
+
 octaspire_vector_t * octaspire_dern_environment_get_all_names(
     octaspire_dern_environment_t const * const self)
 {
@@ -667,6 +675,9 @@ octaspire_vector_t * octaspire_dern_environment_get_all_names(
         return 0;
     }
 
+    // Names are sorted so that the order does not depend on hashing.
+    octaspire_vector_sort(result, octaspire_dern_environment_private_compare_names);
+
     return result;
 }
 
@@ -0,0 +1,1245 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_fasl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+    #include <octaspire/core/octaspire_semver.h>
+    #include <octaspire/core/octaspire_string.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_bytes.h"
+#include "octaspire/dern/octaspire_dern_lexer.h"
+#include "octaspire/dern/octaspire_dern_value.h"
+#include "octaspire/dern/octaspire_dern_vm.h"
+#include "octaspire/dern/octaspire_dern_config.h"
+
+#define OCTASPIRE_DERN_FASL_PRIVATE_FORMAT_VERSION 2
+#define OCTASPIRE_DERN_FASL_PRIVATE_CHUNK_LENGTH   16384
+#define OCTASPIRE_DERN_FASL_PRIVATE_HASH_SEED      UINT64_C(14695981039346656037)
+
+static char const octaspire_dern_fasl_private_magic[8] =
+{
+    'D', 'E', 'R', 'N', 'F', 'A', 'S', 'L'
+};
+
+static char const * const octaspire_dern_fasl_private_version =
+    OCTASPIRE_DERN_CONFIG_VERSION_MAJOR "."
+    OCTASPIRE_DERN_CONFIG_VERSION_MINOR "."
+    OCTASPIRE_DERN_CONFIG_VERSION_PATCH;
+
+// Only values that the parser creates are written. Elements of a vector
+// are followed by an end tag, so that a vector can be written before
+// the number of its elements is known.
+typedef enum octaspire_dern_fasl_private_tag_t
+{
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_NIL,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_TRUE,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_FALSE,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_INTEGER,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_REAL,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_STRING,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_CHARACTER,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SYMBOL,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_VECTOR,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SEMVER,
+    OCTASPIRE_DERN_FASL_PRIVATE_TAG_END
+}
+octaspire_dern_fasl_private_tag_t;
+
+struct octaspire_dern_fasl_t
+{
+    octaspire_allocator_t  *allocator;
+    octaspire_stdio_t      *stdio;
+    octaspire_string_t     *path;
+    octaspire_dern_bytes_t *forms;
+    char                   *buffer;
+    char const             *loaded;
+    size_t                  loadedLength;
+    size_t                  index;
+    uint64_t                sourceHash;
+    uint64_t                sourceLength;
+    bool                    good;
+    char                    padding[7];
+};
+
+// 64 bit FNV-1a.
+static uint64_t octaspire_dern_fasl_private_hash(
+    uint64_t hash,
+    void const * const octets,
+    size_t const length)
+{
+    uint8_t const * const ptr = octets;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= ptr[i];
+        hash *= UINT64_C(1099511628211);
+    }
+
+    return hash;
+}
+
+static bool octaspire_dern_fasl_private_hash_source(
+    octaspire_dern_fasl_t * const self,
+    char const * const sourcePath)
+{
+#ifdef _MSC_VER
+    FILE *file = 0;
+
+    if (fopen_s(&file, sourcePath, "rb"))
+    {
+        return false;
+    }
+#else
+    FILE * const file = fopen(sourcePath, "rb");
+#endif
+
+    if (!file)
+    {
+        return false;
+    }
+
+    char chunk[OCTASPIRE_DERN_FASL_PRIVATE_CHUNK_LENGTH];
+
+    self->sourceHash   = OCTASPIRE_DERN_FASL_PRIVATE_HASH_SEED;
+    self->sourceLength = 0;
+
+    while (true)
+    {
+        size_t const numRead = octaspire_stdio_fread(
+            self->stdio,
+            chunk,
+            sizeof(char),
+            OCTASPIRE_DERN_FASL_PRIVATE_CHUNK_LENGTH,
+            file);
+
+        self->sourceHash    = octaspire_dern_fasl_private_hash(self->sourceHash, chunk, numRead);
+        self->sourceLength += numRead;
+
+        if (numRead < OCTASPIRE_DERN_FASL_PRIVATE_CHUNK_LENGTH)
+        {
+            break;
+        }
+    }
+
+    bool const result = (ferror(file) == 0);
+    fclose(file);
+    return result;
+}
+
+octaspire_dern_fasl_t *octaspire_dern_fasl_new(
+    char const * const sourcePath,
+    char const * const cacheDirectory,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_fasl_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_fasl_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_fasl_t));
+
+    self->allocator = allocator;
+    self->stdio     = stdio;
+    self->good      = true;
+    self->forms     = octaspire_dern_bytes_new(allocator);
+
+    if (!self->forms || !octaspire_dern_fasl_private_hash_source(self, sourcePath))
+    {
+        octaspire_dern_fasl_release(self);
+        return 0;
+    }
+
+    if (cacheDirectory)
+    {
+#ifdef _WIN32
+        char const * const pathSeparator = "\\";
+#else
+        char const * const pathSeparator = "/";
+#endif
+
+        self->path = octaspire_string_new_format(
+            allocator,
+            "%s%s%016" PRIx64 "-%s.fasl",
+            cacheDirectory,
+            pathSeparator,
+            self->sourceHash,
+            octaspire_dern_fasl_private_version);
+    }
+    else
+    {
+        self->path = octaspire_string_new_format(allocator, "%s.fasl", sourcePath);
+    }
+
+    if (!self->path)
+    {
+        octaspire_dern_fasl_release(self);
+        return 0;
+    }
+
+    return self;
+}
+
+void octaspire_dern_fasl_release(octaspire_dern_fasl_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    if (self->buffer)
+    {
+        octaspire_allocator_free(self->allocator, self->buffer);
+    }
+
+    octaspire_dern_bytes_release(self->forms);
+    octaspire_string_release(self->path);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+char const *octaspire_dern_fasl_get_path(
+    octaspire_dern_fasl_t const * const self)
+{
+    return octaspire_string_get_c_string(self->path);
+}
+
+// Unsigned numbers are written seven bits in an octet, least significant
+// bits first; the high bit tells that more octets follow.
+static bool octaspire_dern_fasl_private_push_back_number(
+    octaspire_dern_bytes_t * const bytes,
+    uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        if (!octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)(value | 0x80)))
+        {
+            return false;
+        }
+
+        value >>= 7;
+    }
+
+    return octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)value);
+}
+
+static bool octaspire_dern_fasl_private_push_back_fixed(
+    octaspire_dern_bytes_t * const bytes,
+    uint64_t const value)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        if (!octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)(value >> (8 * i))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool octaspire_dern_fasl_private_push_back_text(
+    octaspire_dern_bytes_t * const bytes,
+    char const * const text,
+    size_t const length)
+{
+    return octaspire_dern_fasl_private_push_back_number(bytes, length) &&
+        octaspire_dern_bytes_push_back_buffer(bytes, text, length);
+}
+
+static bool octaspire_dern_fasl_private_push_back_string(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_string_t const * const str)
+{
+    return octaspire_dern_fasl_private_push_back_text(
+        bytes,
+        octaspire_string_get_c_string(str),
+        octaspire_string_get_length_in_octets(str));
+}
+
+static bool octaspire_dern_fasl_private_push_back_semver(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_semver_t const * const semver)
+{
+    if (!octaspire_dern_fasl_private_push_back_number(bytes, octaspire_semver_get_major(semver)) ||
+        !octaspire_dern_fasl_private_push_back_number(bytes, octaspire_semver_get_minor(semver)) ||
+        !octaspire_dern_fasl_private_push_back_number(bytes, octaspire_semver_get_patch(semver)))
+    {
+        return false;
+    }
+
+    size_t const numPreRelease =
+        octaspire_semver_get_num_pre_release_identifiers(semver);
+
+    if (!octaspire_dern_fasl_private_push_back_number(bytes, numPreRelease))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numPreRelease; ++i)
+    {
+        size_t      numerical = 0;
+        char const *lexical   = 0;
+
+        if (octaspire_semver_get_prerelease_at(semver, i, &numerical, &lexical) ==
+            OCTASPIRE_SEMVER_PRE_RELEASE_ELEM_TYPE_NUMERICAL)
+        {
+            if (!octaspire_dern_bytes_push_back_octet(bytes, 0) ||
+                !octaspire_dern_fasl_private_push_back_number(bytes, numerical))
+            {
+                return false;
+            }
+        }
+        else if (!octaspire_dern_bytes_push_back_octet(bytes, 1) ||
+                 !octaspire_dern_fasl_private_push_back_text(bytes, lexical, strlen(lexical)))
+        {
+            return false;
+        }
+    }
+
+    size_t const numBuildMetadata =
+        octaspire_semver_get_num_build_metadata_identifiers(semver);
+
+    if (!octaspire_dern_fasl_private_push_back_number(bytes, numBuildMetadata))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numBuildMetadata; ++i)
+    {
+        char const * const metadata = octaspire_semver_get_build_metadata_at(semver, i);
+
+        if (!octaspire_dern_fasl_private_push_back_text(bytes, metadata, strlen(metadata)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool octaspire_dern_fasl_private_push_back_value(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_dern_value_t const * const value)
+{
+    switch (value->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_FASL_PRIVATE_TAG_NIL);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                value->value.boolean ?
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_TRUE :
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_FALSE);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_INTEGER) &&
+                octaspire_dern_fasl_private_push_back_number(
+                    bytes,
+                    (uint32_t)value->value.integer);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        {
+            uint64_t bits = 0;
+            memcpy(&bits, &(value->value.real), sizeof(bits));
+
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_REAL) &&
+                octaspire_dern_fasl_private_push_back_fixed(bytes, bits);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_STRING) &&
+                octaspire_dern_fasl_private_push_back_text(
+                    bytes,
+                    octaspire_dern_value_as_string_get_c_string(value),
+                    octaspire_dern_value_as_string_get_length_in_octets(value));
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_CHARACTER) &&
+                octaspire_dern_fasl_private_push_back_string(
+                    bytes,
+                    value->value.character);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SYMBOL) &&
+                octaspire_dern_fasl_private_push_back_string(
+                    bytes,
+                    value->value.symbol);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SEMVER) &&
+                octaspire_dern_fasl_private_push_back_semver(
+                    bytes,
+                    value->value.semver);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            size_t const length = octaspire_dern_value_as_vector_get_length(value);
+
+            if (!octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_VECTOR))
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                if (!octaspire_dern_fasl_private_push_back_value(
+                        bytes,
+                        octaspire_dern_value_as_vector_get_element_at_const(
+                            value,
+                            (ptrdiff_t)i)))
+                {
+                    return false;
+                }
+            }
+
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_FASL_PRIVATE_TAG_END);
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool octaspire_dern_fasl_push_back_form(
+    octaspire_dern_fasl_t * const self,
+    octaspire_dern_value_t const * const form,
+    size_t const lineNumber)
+{
+    if (self->good)
+    {
+        self->good =
+            octaspire_dern_fasl_private_push_back_value(self->forms, form) &&
+            octaspire_dern_fasl_private_push_back_number(self->forms, lineNumber);
+    }
+
+    return self->good;
+}
+
+static bool octaspire_dern_fasl_private_push_back_token_datum(
+    octaspire_dern_fasl_t * const self,
+    octaspire_input_t * const input,
+    octaspire_dern_lexer_token_t const * const token,
+    bool const isSpliced);
+
+// Pops the next token and writes the datum that it starts. With
+// 'spliceVectors' the elements of a vector are written without the
+// vector, like a template adds its symbol in front of them.
+static bool octaspire_dern_fasl_private_push_back_next_datum(
+    octaspire_dern_fasl_t * const self,
+    octaspire_input_t * const input,
+    bool const spliceVectors)
+{
+    octaspire_dern_lexer_token_t *token =
+        octaspire_dern_lexer_pop_next_token(input, self->allocator);
+
+    if (!token)
+    {
+        return false;
+    }
+
+    octaspire_dern_lexer_token_tag_t const tag =
+        octaspire_dern_lexer_token_get_type_tag(token);
+
+    bool const result = octaspire_dern_fasl_private_push_back_token_datum(
+        self,
+        input,
+        token,
+        spliceVectors &&
+            (tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_LPAREN ||
+             tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_QUOTE  ||
+             tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_BACK_QUOTE));
+
+    octaspire_dern_lexer_token_release(token);
+    token = 0;
+
+    return result;
+}
+
+// Writes the same values that 'octaspire_dern_vm_parse_token' creates.
+// Tokens that the parser reports as errors are not written.
+static bool octaspire_dern_fasl_private_push_back_token_datum(
+    octaspire_dern_fasl_t * const self,
+    octaspire_input_t * const input,
+    octaspire_dern_lexer_token_t const * const token,
+    bool const isSpliced)
+{
+    octaspire_dern_bytes_t * const bytes = self->forms;
+
+    switch (octaspire_dern_lexer_token_get_type_tag(token))
+    {
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_LPAREN:
+        {
+            if (!isSpliced &&
+                !octaspire_dern_bytes_push_back_octet(bytes, OCTASPIRE_DERN_FASL_PRIVATE_TAG_VECTOR))
+            {
+                return false;
+            }
+
+            while (true)
+            {
+                octaspire_dern_lexer_token_t *element =
+                    octaspire_dern_lexer_pop_next_token(input, self->allocator);
+
+                if (!element)
+                {
+                    return false;
+                }
+
+                if (octaspire_dern_lexer_token_get_type_tag(element) ==
+                    OCTASPIRE_DERN_LEXER_TOKEN_TAG_RPAREN)
+                {
+                    octaspire_dern_lexer_token_release(element);
+                    element = 0;
+                    break;
+                }
+
+                bool const isGood = octaspire_dern_fasl_private_push_back_token_datum(
+                    self,
+                    input,
+                    element,
+                    false);
+
+                octaspire_dern_lexer_token_release(element);
+                element = 0;
+
+                if (!isGood)
+                {
+                    return false;
+                }
+            }
+
+            return isSpliced ||
+                octaspire_dern_bytes_push_back_octet(bytes, OCTASPIRE_DERN_FASL_PRIVATE_TAG_END);
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_QUOTE:
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_BACK_QUOTE:
+        {
+            bool const isQuote = (octaspire_dern_lexer_token_get_type_tag(token) ==
+                OCTASPIRE_DERN_LEXER_TOKEN_TAG_QUOTE);
+
+            char const * const symbol = isQuote ? "quote" : "template";
+
+            return
+                (isSpliced ||
+                 octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_VECTOR)) &&
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SYMBOL) &&
+                octaspire_dern_fasl_private_push_back_text(bytes, symbol, strlen(symbol)) &&
+                octaspire_dern_fasl_private_push_back_next_datum(self, input, !isQuote) &&
+                (isSpliced ||
+                 octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_END));
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_TRUE:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_FASL_PRIVATE_TAG_TRUE);
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_FALSE:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_FASL_PRIVATE_TAG_FALSE);
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_NIL:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_FASL_PRIVATE_TAG_NIL);
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_INTEGER:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_INTEGER) &&
+                octaspire_dern_fasl_private_push_back_number(
+                    bytes,
+                    (uint32_t)octaspire_dern_lexer_token_get_integer_value(token));
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_REAL:
+        {
+            double const value = octaspire_dern_lexer_token_get_real_value(token);
+
+            uint64_t bits = 0;
+            memcpy(&bits, &value, sizeof(bits));
+
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_REAL) &&
+                octaspire_dern_fasl_private_push_back_fixed(bytes, bits);
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING:
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_CHARACTER:
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_SYMBOL:
+        {
+            octaspire_dern_lexer_token_tag_t const tag =
+                octaspire_dern_lexer_token_get_type_tag(token);
+
+            char const * const text =
+                (tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING) ?
+                    octaspire_dern_lexer_token_get_string_value_as_c_string(token) :
+                (tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_CHARACTER) ?
+                    octaspire_dern_lexer_token_get_character_value_as_c_string(token) :
+                    octaspire_dern_lexer_token_get_symbol_value_as_c_string(token);
+
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    (tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING) ?
+                        OCTASPIRE_DERN_FASL_PRIVATE_TAG_STRING :
+                    (tag == OCTASPIRE_DERN_LEXER_TOKEN_TAG_CHARACTER) ?
+                        OCTASPIRE_DERN_FASL_PRIVATE_TAG_CHARACTER :
+                        OCTASPIRE_DERN_FASL_PRIVATE_TAG_SYMBOL) &&
+                octaspire_dern_fasl_private_push_back_text(bytes, text, strlen(text));
+        }
+
+        case OCTASPIRE_DERN_LEXER_TOKEN_TAG_SEMVER:
+        {
+            return octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_FASL_PRIVATE_TAG_SEMVER) &&
+                octaspire_dern_fasl_private_push_back_semver(
+                    bytes,
+                    octaspire_dern_lexer_token_get_semver_value(token));
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool octaspire_dern_fasl_push_back_source_form(
+    octaspire_dern_fasl_t * const self,
+    char const * const octets,
+    size_t const lengthInOctets,
+    size_t const firstLineNumber)
+{
+    if (!self->good)
+    {
+        return false;
+    }
+
+    octaspire_input_t *input =
+        octaspire_input_new_from_buffer(octets, lengthInOctets, self->allocator);
+
+    self->good = (input != 0);
+
+    while (self->good && octaspire_input_is_good(input))
+    {
+        octaspire_dern_lexer_token_t *token =
+            octaspire_dern_lexer_pop_next_token(input, self->allocator);
+
+        if (!token)
+        {
+            break;
+        }
+
+        self->good =
+            octaspire_dern_fasl_private_push_back_token_datum(self, input, token, false) &&
+            octaspire_dern_fasl_private_push_back_number(
+                self->forms,
+                firstLineNumber + octaspire_input_get_line_number(input) - 1);
+
+        octaspire_dern_lexer_token_release(token);
+        token = 0;
+    }
+
+    octaspire_input_release(input);
+    input = 0;
+
+    return self->good;
+}
+
+bool octaspire_dern_fasl_save(octaspire_dern_fasl_t * const self)
+{
+    if (!self->good)
+    {
+        return false;
+    }
+
+    octaspire_dern_bytes_t *header = octaspire_dern_bytes_new(self->allocator);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    bool const headerIsGood =
+        octaspire_dern_bytes_push_back_buffer(
+            header,
+            octaspire_dern_fasl_private_magic,
+            sizeof(octaspire_dern_fasl_private_magic)) &&
+        octaspire_dern_fasl_private_push_back_number(
+            header,
+            OCTASPIRE_DERN_FASL_PRIVATE_FORMAT_VERSION) &&
+        octaspire_dern_fasl_private_push_back_text(
+            header,
+            octaspire_dern_fasl_private_version,
+            strlen(octaspire_dern_fasl_private_version)) &&
+        octaspire_dern_fasl_private_push_back_number(header, self->sourceLength) &&
+        octaspire_dern_fasl_private_push_back_fixed(header, self->sourceHash) &&
+        octaspire_dern_fasl_private_push_back_fixed(
+            header,
+            octaspire_dern_fasl_private_hash(
+                OCTASPIRE_DERN_FASL_PRIVATE_HASH_SEED,
+                octaspire_dern_bytes_get_octets(self->forms),
+                octaspire_dern_bytes_get_length(self->forms)));
+
+    octaspire_string_t *tmpPath = octaspire_string_new_format(
+        self->allocator,
+        "%s.tmp",
+        octaspire_string_get_c_string(self->path));
+
+    if (!headerIsGood || !tmpPath)
+    {
+        octaspire_string_release(tmpPath);
+        tmpPath = 0;
+
+        octaspire_dern_bytes_release(header);
+        header = 0;
+        return false;
+    }
+
+#ifdef _MSC_VER
+    FILE *file = 0;
+
+    if (fopen_s(&file, octaspire_string_get_c_string(tmpPath), "wb"))
+    {
+        file = 0;
+    }
+#else
+    FILE *file = fopen(octaspire_string_get_c_string(tmpPath), "wb");
+#endif
+
+    bool result = false;
+
+    if (file)
+    {
+        size_t const headerLength = octaspire_dern_bytes_get_length(header);
+        size_t const formsLength  = octaspire_dern_bytes_get_length(self->forms);
+
+        result =
+            fwrite(octaspire_dern_bytes_get_octets(header), 1, headerLength, file) ==
+                headerLength &&
+            fwrite(octaspire_dern_bytes_get_octets(self->forms), 1, formsLength, file) ==
+                formsLength;
+
+        result = (fclose(file) == 0) && result;
+        file = 0;
+
+#ifdef _WIN32
+        // Rename does not replace an existing file on Windows.
+        remove(octaspire_string_get_c_string(self->path));
+#endif
+
+        result = result &&
+            rename(
+                octaspire_string_get_c_string(tmpPath),
+                octaspire_string_get_c_string(self->path)) == 0;
+
+        if (!result)
+        {
+            remove(octaspire_string_get_c_string(tmpPath));
+        }
+    }
+
+    octaspire_string_release(tmpPath);
+    tmpPath = 0;
+
+    octaspire_dern_bytes_release(header);
+    header = 0;
+
+    return result;
+}
+
+static bool octaspire_dern_fasl_private_pop_front_number(
+    octaspire_dern_fasl_t * const self,
+    uint64_t * const value)
+{
+    *value = 0;
+
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        if (self->index >= self->loadedLength)
+        {
+            return false;
+        }
+
+        uint8_t const octet = (uint8_t)self->loaded[self->index];
+        ++(self->index);
+
+        *value |= (uint64_t)(octet & 0x7F) << shift;
+
+        if (!(octet & 0x80))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool octaspire_dern_fasl_private_pop_front_fixed(
+    octaspire_dern_fasl_t * const self,
+    uint64_t * const value)
+{
+    if (self->loadedLength - self->index < 8)
+    {
+        return false;
+    }
+
+    *value = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        *value |= (uint64_t)(uint8_t)self->loaded[self->index + i] << (8 * i);
+    }
+
+    self->index += 8;
+    return true;
+}
+
+// Text is left in the loaded octets; 'text' points into them.
+static bool octaspire_dern_fasl_private_pop_front_text(
+    octaspire_dern_fasl_t * const self,
+    char const ** const text,
+    size_t * const length)
+{
+    uint64_t value = 0;
+
+    if (!octaspire_dern_fasl_private_pop_front_number(self, &value) ||
+        value > self->loadedLength - self->index)
+    {
+        return false;
+    }
+
+    *text   = self->loaded + self->index;
+    *length = (size_t)value;
+
+    self->index += (size_t)value;
+    return true;
+}
+
+bool octaspire_dern_fasl_load(octaspire_dern_fasl_t * const self)
+{
+    if (self->buffer)
+    {
+        octaspire_allocator_free(self->allocator, self->buffer);
+    }
+
+    self->index  = 0;
+    self->buffer = octaspire_helpers_path_to_buffer(
+        octaspire_string_get_c_string(self->path),
+        &(self->loadedLength),
+        self->allocator,
+        self->stdio);
+
+    self->loaded = self->buffer;
+
+    if (!self->loaded)
+    {
+        return false;
+    }
+
+    uint64_t    formatVersion = 0;
+    char const *version       = 0;
+    size_t      versionLength = 0;
+    uint64_t    sourceLength  = 0;
+    uint64_t    sourceHash    = 0;
+    uint64_t    formsHash     = 0;
+
+    if (self->loadedLength < sizeof(octaspire_dern_fasl_private_magic) ||
+        memcmp(
+            self->loaded,
+            octaspire_dern_fasl_private_magic,
+            sizeof(octaspire_dern_fasl_private_magic)) != 0)
+    {
+        return false;
+    }
+
+    self->index = sizeof(octaspire_dern_fasl_private_magic);
+
+    if (!octaspire_dern_fasl_private_pop_front_number(self, &formatVersion) ||
+        formatVersion != OCTASPIRE_DERN_FASL_PRIVATE_FORMAT_VERSION ||
+        !octaspire_dern_fasl_private_pop_front_text(self, &version, &versionLength) ||
+        versionLength != strlen(octaspire_dern_fasl_private_version) ||
+        memcmp(version, octaspire_dern_fasl_private_version, versionLength) != 0 ||
+        !octaspire_dern_fasl_private_pop_front_number(self, &sourceLength) ||
+        sourceLength != self->sourceLength ||
+        !octaspire_dern_fasl_private_pop_front_fixed(self, &sourceHash) ||
+        sourceHash != self->sourceHash ||
+        !octaspire_dern_fasl_private_pop_front_fixed(self, &formsHash))
+    {
+        return false;
+    }
+
+    // Forms are checked as a whole, so that a damaged file is noticed
+    // before any of its forms is evaluated.
+    return formsHash == octaspire_dern_fasl_private_hash(
+        OCTASPIRE_DERN_FASL_PRIVATE_HASH_SEED,
+        self->loaded + self->index,
+        self->loadedLength - self->index);
+}
+
+void octaspire_dern_fasl_load_added_forms(octaspire_dern_fasl_t * const self)
+{
+    self->loaded       = (char const*)octaspire_dern_bytes_get_octets(self->forms);
+    self->loadedLength = octaspire_dern_bytes_get_length(self->forms);
+    self->index        = 0;
+}
+
+// The semver is allocated with 'allocator', that is the allocator of the
+// VM that gets it.
+static octaspire_semver_t *octaspire_dern_fasl_private_pop_front_semver(
+    octaspire_dern_fasl_t * const self,
+    octaspire_allocator_t * const allocator)
+{
+    uint64_t major = 0;
+    uint64_t minor = 0;
+    uint64_t patch = 0;
+    uint64_t count = 0;
+
+    if (!octaspire_dern_fasl_private_pop_front_number(self, &major) ||
+        !octaspire_dern_fasl_private_pop_front_number(self, &minor) ||
+        !octaspire_dern_fasl_private_pop_front_number(self, &patch) ||
+        !octaspire_dern_fasl_private_pop_front_number(self, &count))
+    {
+        return 0;
+    }
+
+    octaspire_semver_t *result = octaspire_semver_new(
+        (size_t)major,
+        (size_t)minor,
+        (size_t)patch,
+        0,
+        0,
+        allocator);
+
+    if (!result)
+    {
+        return result;
+    }
+
+    bool good = true;
+
+    for (uint64_t i = 0; good && i < count; ++i)
+    {
+        if (self->index >= self->loadedLength)
+        {
+            good = false;
+        }
+        else if (self->loaded[self->index++] == 0)
+        {
+            uint64_t numerical = 0;
+
+            good = octaspire_dern_fasl_private_pop_front_number(self, &numerical) &&
+                octaspire_semver_add_prerelease_numerical(result, (size_t)numerical);
+        }
+        else
+        {
+            char const *text   = 0;
+            size_t      length = 0;
+
+            good = octaspire_dern_fasl_private_pop_front_text(self, &text, &length);
+
+            if (good)
+            {
+                octaspire_string_t *str =
+                    octaspire_string_new_from_buffer(text, length, allocator);
+
+                good = str &&
+                    octaspire_semver_add_prerelease(result, octaspire_string_get_c_string(str));
+
+                octaspire_string_release(str);
+                str = 0;
+            }
+        }
+    }
+
+    good = good && octaspire_dern_fasl_private_pop_front_number(self, &count);
+
+    for (uint64_t i = 0; good && i < count; ++i)
+    {
+        char const *text   = 0;
+        size_t      length = 0;
+
+        good = octaspire_dern_fasl_private_pop_front_text(self, &text, &length);
+
+        if (good)
+        {
+            octaspire_string_t *str =
+                octaspire_string_new_from_buffer(text, length, allocator);
+
+            good = str &&
+                octaspire_semver_add_buildmetadata(result, octaspire_string_get_c_string(str));
+
+            octaspire_string_release(str);
+            str = 0;
+        }
+    }
+
+    if (!good)
+    {
+        octaspire_semver_release(result);
+        result = 0;
+    }
+
+    return result;
+}
+
+static octaspire_dern_value_t *octaspire_dern_fasl_private_pop_front_value(
+    octaspire_dern_fasl_t * const self,
+    octaspire_dern_vm_t * const vm)
+{
+    if (self->index >= self->loadedLength)
+    {
+        return 0;
+    }
+
+    octaspire_dern_fasl_private_tag_t const tag =
+        (octaspire_dern_fasl_private_tag_t)(uint8_t)self->loaded[self->index];
+
+    ++(self->index);
+
+    switch (tag)
+    {
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_NIL:
+        {
+            return octaspire_dern_vm_get_value_nil(vm);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_TRUE:
+        {
+            return octaspire_dern_vm_get_value_true(vm);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_FALSE:
+        {
+            return octaspire_dern_vm_get_value_false(vm);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_INTEGER:
+        {
+            uint64_t value = 0;
+
+            if (!octaspire_dern_fasl_private_pop_front_number(self, &value))
+            {
+                return 0;
+            }
+
+            return octaspire_dern_vm_create_new_value_integer(
+                vm,
+                (int32_t)(uint32_t)value);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_REAL:
+        {
+            uint64_t bits  = 0;
+            double   value = 0;
+
+            if (!octaspire_dern_fasl_private_pop_front_fixed(self, &bits))
+            {
+                return 0;
+            }
+
+            memcpy(&value, &bits, sizeof(value));
+            return octaspire_dern_vm_create_new_value_real(vm, value);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_STRING:
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_SYMBOL:
+        {
+            char const *text   = 0;
+            size_t      length = 0;
+
+            if (!octaspire_dern_fasl_private_pop_front_text(self, &text, &length))
+            {
+                return 0;
+            }
+
+            octaspire_string_t * const str =
+                octaspire_string_new_from_buffer(text, length, octaspire_dern_vm_get_allocator(vm));
+
+            if (!str)
+            {
+                return 0;
+            }
+
+            if (tag == OCTASPIRE_DERN_FASL_PRIVATE_TAG_STRING)
+            {
+                return octaspire_dern_vm_create_new_value_string(vm, str);
+            }
+
+            if (tag == OCTASPIRE_DERN_FASL_PRIVATE_TAG_CHARACTER)
+            {
+                return octaspire_dern_vm_create_new_value_character(vm, str);
+            }
+
+            return octaspire_dern_vm_create_new_value_symbol(vm, str);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_SEMVER:
+        {
+            octaspire_semver_t * const semver =
+                octaspire_dern_fasl_private_pop_front_semver(
+                    self,
+                    octaspire_dern_vm_get_allocator(vm));
+
+            if (!semver)
+            {
+                return 0;
+            }
+
+            return octaspire_dern_vm_create_new_value_semver(vm, semver);
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_VECTOR:
+        {
+            octaspire_dern_value_t * const result =
+                octaspire_dern_vm_create_new_value_vector(vm);
+
+            // Protect the elements read so far from the garbage collector.
+            octaspire_dern_vm_push_value(vm, result);
+
+            while (true)
+            {
+                if (self->index < self->loadedLength &&
+                    (uint8_t)self->loaded[self->index] == OCTASPIRE_DERN_FASL_PRIVATE_TAG_END)
+                {
+                    ++(self->index);
+                    break;
+                }
+
+                octaspire_dern_value_t *element =
+                    octaspire_dern_fasl_private_pop_front_value(self, vm);
+
+                if (!element)
+                {
+                    octaspire_dern_vm_pop_value(vm, result);
+                    return 0;
+                }
+
+                if (!octaspire_dern_value_as_vector_push_back_element(result, &element))
+                {
+                    abort();
+                }
+            }
+
+            octaspire_dern_vm_pop_value(vm, result);
+            return result;
+        }
+
+        case OCTASPIRE_DERN_FASL_PRIVATE_TAG_END:
+        {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+octaspire_dern_value_t *octaspire_dern_fasl_read_next_form(
+    octaspire_dern_fasl_t * const self,
+    octaspire_dern_vm_t * const vm,
+    size_t * const lineNumber)
+{
+    if (!self->loaded || self->index >= self->loadedLength)
+    {
+        return 0;
+    }
+
+    uint64_t line = 0;
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_fasl_private_pop_front_value(self, vm);
+
+    if (!result || !octaspire_dern_fasl_private_pop_front_number(self, &line))
+    {
+        // Rest of the file cannot be trusted either.
+        self->index = self->loadedLength;
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Compiled forms in '%s' are damaged",
+            octaspire_string_get_c_string(self->path));
+    }
+
+    *lineNumber = (size_t)line;
+    return result;
+}
+
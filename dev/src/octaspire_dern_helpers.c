@@ -16,6 +16,7 @@ limitations under the License.
 ******************************************************************************/
 #include "octaspire/dern/octaspire_dern_helpers.h"
 #include "octaspire/dern/octaspire_dern_lexer.h"
+#include <string.h>
 
 #ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
     #include "octaspire-core-amalgamated.c"
@@ -25,32 +26,32 @@ limitations under the License.
 #endif
 
 int octaspire_dern_helpers_compare_value_hash_maps(
-    octaspire_map_t const * const firstValueHashMap,
-    octaspire_map_t const * const otherValueHashMap)
+    octaspire_dern_map_t const * const firstValueHashMap,
+    octaspire_dern_map_t const * const otherValueHashMap)
 {
-    if (octaspire_map_get_number_of_elements(firstValueHashMap) !=
-        octaspire_map_get_number_of_elements(otherValueHashMap))
+    if (octaspire_dern_map_get_number_of_elements(firstValueHashMap) !=
+        octaspire_dern_map_get_number_of_elements(otherValueHashMap))
     {
-        return octaspire_map_get_number_of_elements(firstValueHashMap) -
-            octaspire_map_get_number_of_elements(otherValueHashMap);
+        return octaspire_dern_map_get_number_of_elements(firstValueHashMap) -
+            octaspire_dern_map_get_number_of_elements(otherValueHashMap);
     }
 
-    octaspire_map_element_const_iterator_t iter =
-        octaspire_map_element_const_iterator_init(firstValueHashMap);
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(firstValueHashMap);
 
     while (iter.element)
     {
         octaspire_dern_value_t const * const myKey =
-            octaspire_map_element_get_key_const(iter.element);
+            octaspire_dern_map_element_get_key_const(iter.element);
 
         octaspire_dern_value_t const * const myVal =
-            octaspire_map_element_get_value_const(iter.element);
+            octaspire_dern_map_element_get_value_const(iter.element);
 
-        octaspire_map_element_t const * const otherElem =
-            octaspire_map_get_const(
+        octaspire_dern_map_element_t const * const otherElem =
+            octaspire_dern_map_get_const(
                 otherValueHashMap,
                 octaspire_dern_value_get_hash(myKey),
-                &myKey);
+                myKey);
 
         if (!otherElem)
         {
@@ -58,7 +59,7 @@ int octaspire_dern_helpers_compare_value_hash_maps(
         }
 
         octaspire_dern_value_t const * const otherVal =
-            octaspire_map_element_get_value(otherElem);
+            octaspire_dern_map_element_get_value(otherElem);
 
         int const cmp = octaspire_dern_value_compare(myVal, otherVal);
 
@@ -67,12 +68,77 @@ int octaspire_dern_helpers_compare_value_hash_maps(
             return cmp;
         }
 
-        octaspire_map_element_const_iterator_next(&iter);
+        octaspire_dern_map_element_const_iterator_next(&iter);
     }
 
     return 0;
 }
 
+static uint64_t octaspire_dern_helpers_private_rotate_left(
+    uint64_t const value,
+    unsigned int const count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+uint32_t octaspire_dern_helpers_calculate_hash_for_octets(
+    void const * const octets,
+    size_t const numOctets)
+{
+    // Consumes eight octets per round instead of mixing one octet at
+    // a time; the final avalanche is the MurmurHash3 64-bit finalizer.
+    uint8_t const * ptr       = (uint8_t const*)octets;
+    size_t          remaining = numOctets;
+    uint64_t        hash      = 0x9E3779B97F4A7C15ULL ^ (uint64_t)numOctets;
+
+    while (remaining >= sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, ptr, sizeof(uint64_t));
+
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash  = octaspire_dern_helpers_private_rotate_left(hash, 31);
+        hash *= 0x4CF5AD432745937FULL;
+
+        ptr       += sizeof(uint64_t);
+        remaining -= sizeof(uint64_t);
+    }
+
+    if (remaining)
+    {
+        uint64_t word = 0;
+        memcpy(&word, ptr, remaining);
+
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash  = octaspire_dern_helpers_private_rotate_left(hash, 31);
+        hash *= 0x4CF5AD432745937FULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+octaspire_string_t *octaspire_dern_helpers_copy_string(
+    octaspire_string_t const * const str,
+    octaspire_allocator_t * const allocator)
+{
+    if (octaspire_string_is_empty(str))
+    {
+        return octaspire_string_new("", allocator);
+    }
+
+    // Octets of a string are encoded lazily; this encodes them, so that
+    // the copy does not see an empty vector.
+    octaspire_string_get_length_in_octets(str);
+
+    return octaspire_string_new_copy(str, allocator);
+}
+
 double octaspire_dern_helpers_atof(
     char const * const str,
     octaspire_allocator_t * const allocator)
@@ -96,3 +162,460 @@ double octaspire_dern_helpers_atof(
     }
 }
 
+bool octaspire_dern_helpers_sort_indices(
+    size_t * const indices,
+    size_t const length,
+    octaspire_dern_helpers_index_compare_t const compare,
+    void * const context,
+    octaspire_allocator_t * const allocator)
+{
+    size_t const runLength = 32;
+
+    for (size_t start = 0; start < length; start += runLength)
+    {
+        size_t const end = (start + runLength < length) ? (start + runLength) : length;
+
+        for (size_t i = start + 1; i < end; ++i)
+        {
+            size_t const index = indices[i];
+            size_t       j     = i;
+
+            while (j > start && compare(index, indices[j - 1], context) < 0)
+            {
+                indices[j] = indices[j - 1];
+                --j;
+            }
+
+            indices[j] = index;
+        }
+    }
+
+    if (length <= runLength)
+    {
+        return true;
+    }
+
+    size_t * const buffer =
+        octaspire_allocator_malloc(allocator, length * sizeof(size_t));
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    size_t *from = indices;
+    size_t *to   = buffer;
+
+    for (size_t width = runLength; width < length; width *= 2)
+    {
+        for (size_t left = 0; left < length; left += 2 * width)
+        {
+            size_t const middle = (left + width     < length) ? (left + width)     : length;
+            size_t const right  = (left + 2 * width < length) ? (left + 2 * width) : length;
+
+            if (middle == right ||
+                compare(from[middle], from[middle - 1], context) >= 0)
+            {
+                memcpy(to + left, from + left, (right - left) * sizeof(size_t));
+                continue;
+            }
+
+            size_t i = left;
+            size_t j = middle;
+            size_t k = left;
+
+            while (i < middle && j < right)
+            {
+                // Taking from the left run on ties keeps the sort stable.
+                if (compare(from[j], from[i], context) < 0)
+                {
+                    to[k++] = from[j++];
+                }
+                else
+                {
+                    to[k++] = from[i++];
+                }
+            }
+
+            while (i < middle)
+            {
+                to[k++] = from[i++];
+            }
+
+            while (j < right)
+            {
+                to[k++] = from[j++];
+            }
+        }
+
+        size_t * const tmp = from;
+        from = to;
+        to   = tmp;
+    }
+
+    if (from != indices)
+    {
+        memcpy(indices, from, length * sizeof(size_t));
+    }
+
+    octaspire_allocator_free(allocator, buffer);
+    return true;
+}
+
+// Needles up to this many octets are searched with memchr and memcmp.
+#define OCTASPIRE_DERN_HELPERS_PRIVATE_SHORT_NEEDLE_LENGTH 16
+
+typedef struct octaspire_dern_helpers_private_searcher_t
+{
+    uint8_t const *needle;
+    size_t         needleLength;
+    size_t         suffix;
+    size_t         period;
+    bool           isPeriodic;
+    char           padding[7];
+}
+octaspire_dern_helpers_private_searcher_t;
+
+static size_t octaspire_dern_helpers_private_maximal_suffix(
+    uint8_t const * const needle,
+    size_t const needleLength,
+    bool const reversed,
+    size_t * const period)
+{
+    // Index one before the start of the suffix; SIZE_MAX stands for -1
+    // and wraps to zero when the suffix is indexed.
+    size_t maxSuffix = SIZE_MAX;
+    size_t j         = 0;
+    size_t k         = 1;
+    size_t p         = 1;
+
+    while (j + k < needleLength)
+    {
+        uint8_t const a = needle[j + k];
+        uint8_t const b = needle[maxSuffix + k];
+
+        if (a == b)
+        {
+            if (k != p)
+            {
+                ++k;
+            }
+            else
+            {
+                j += p;
+                k  = 1;
+            }
+        }
+        else if ((a < b) != reversed)
+        {
+            j += k;
+            k  = 1;
+            p  = j - maxSuffix;
+        }
+        else
+        {
+            maxSuffix = j++;
+            k = p = 1;
+        }
+    }
+
+    *period = p;
+    return maxSuffix;
+}
+
+static void octaspire_dern_helpers_private_searcher_init(
+    octaspire_dern_helpers_private_searcher_t * const self,
+    uint8_t const * const needle,
+    size_t const needleLength)
+{
+    self->needle       = needle;
+    self->needleLength = needleLength;
+    self->suffix       = 0;
+    self->period       = 0;
+    self->isPeriodic   = false;
+
+    if (needleLength <= OCTASPIRE_DERN_HELPERS_PRIVATE_SHORT_NEEDLE_LENGTH)
+    {
+        return;
+    }
+
+    // Critical factorization: the later of the maximal suffixes for the
+    // two opposite orderings of the octets.
+    size_t period        = 0;
+    size_t reversePeriod = 0;
+
+    size_t const maxSuffix = octaspire_dern_helpers_private_maximal_suffix(
+        needle,
+        needleLength,
+        false,
+        &period);
+
+    size_t const reverseMaxSuffix = octaspire_dern_helpers_private_maximal_suffix(
+        needle,
+        needleLength,
+        true,
+        &reversePeriod);
+
+    if (reverseMaxSuffix + 1 < maxSuffix + 1)
+    {
+        self->suffix = maxSuffix + 1;
+        self->period = period;
+    }
+    else
+    {
+        self->suffix = reverseMaxSuffix + 1;
+        self->period = reversePeriod;
+    }
+
+    self->isPeriodic =
+        (memcmp(needle, needle + self->period, self->suffix) == 0);
+
+    if (!self->isPeriodic)
+    {
+        // The halves differ, so a mismatch allows a shift past the
+        // longer half.
+        size_t const rightLength = needleLength - self->suffix;
+
+        self->period =
+            ((self->suffix > rightLength) ? self->suffix : rightLength) + 1;
+    }
+}
+
+static bool octaspire_dern_helpers_private_searcher_find(
+    octaspire_dern_helpers_private_searcher_t const * const self,
+    uint8_t const * const haystack,
+    size_t const haystackLength,
+    size_t const start,
+    size_t * const foundIndex)
+{
+    uint8_t const * const needle       = self->needle;
+    size_t const          needleLength = self->needleLength;
+
+    if (!needleLength ||
+        start > haystackLength ||
+        haystackLength - start < needleLength)
+    {
+        return false;
+    }
+
+    size_t const last = haystackLength - needleLength;
+
+    if (needleLength <= OCTASPIRE_DERN_HELPERS_PRIVATE_SHORT_NEEDLE_LENGTH)
+    {
+        size_t j = start;
+
+        while (j <= last)
+        {
+            uint8_t const * const candidate =
+                memchr(haystack + j, needle[0], last - j + 1);
+
+            if (!candidate)
+            {
+                return false;
+            }
+
+            j = (size_t)(candidate - haystack);
+
+            if (memcmp(candidate + 1, needle + 1, needleLength - 1) == 0)
+            {
+                *foundIndex = j;
+                return true;
+            }
+
+            ++j;
+        }
+
+        return false;
+    }
+
+    size_t const suffix = self->suffix;
+    size_t const period = self->period;
+    size_t       memory = 0;
+    size_t       j      = start;
+
+    while (j <= last)
+    {
+        // Match the right half first. In a periodic needle the octets
+        // before 'memory' are known to match from the previous shift.
+        size_t i = (self->isPeriodic && memory > suffix) ? memory : suffix;
+
+        while (i < needleLength && needle[i] == haystack[i + j])
+        {
+            ++i;
+        }
+
+        if (i < needleLength)
+        {
+            j      += i - suffix + 1;
+            memory  = 0;
+            continue;
+        }
+
+        // Then the left half from right to left.
+        size_t const limit = self->isPeriodic ? memory : 0;
+
+        i = suffix;
+
+        while (i > limit && needle[i - 1] == haystack[i - 1 + j])
+        {
+            --i;
+        }
+
+        if (i <= limit)
+        {
+            *foundIndex = j;
+            return true;
+        }
+
+        j += period;
+
+        if (self->isPeriodic)
+        {
+            memory = needleLength - period;
+        }
+    }
+
+    return false;
+}
+
+bool octaspire_dern_helpers_find_octets(
+    void const * const haystack,
+    size_t const haystackLength,
+    void const * const needle,
+    size_t const needleLength,
+    size_t const start,
+    size_t * const foundIndex)
+{
+    octaspire_dern_helpers_private_searcher_t searcher;
+
+    octaspire_dern_helpers_private_searcher_init(
+        &searcher,
+        (uint8_t const*)needle,
+        needleLength);
+
+    return octaspire_dern_helpers_private_searcher_find(
+        &searcher,
+        (uint8_t const*)haystack,
+        haystackLength,
+        start,
+        foundIndex);
+}
+
+octaspire_vector_t *octaspire_dern_helpers_find_string(
+    octaspire_string_t const * const self,
+    octaspire_string_t const * const str,
+    octaspire_allocator_t * const allocator)
+{
+    size_t const haystackLength = octaspire_string_get_length_in_octets(self);
+
+    return octaspire_dern_helpers_find_all_octets(
+        octaspire_string_get_c_string(self),
+        haystackLength,
+        haystackLength == octaspire_string_get_length_in_ucs_characters(self),
+        octaspire_string_get_c_string(str),
+        octaspire_string_get_length_in_octets(str),
+        allocator);
+}
+
+octaspire_vector_t *octaspire_dern_helpers_find_all_octets(
+    void const * const haystackOctets,
+    size_t const haystackLength,
+    bool const isAscii,
+    void const * const needle,
+    size_t const needleLength,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_vector_t * const result = octaspire_vector_new(
+        sizeof(size_t),
+        false,
+        0,
+        allocator);
+
+    if (!result)
+    {
+        return 0;
+    }
+
+    uint8_t const * const haystack = (uint8_t const*)haystackOctets;
+
+    octaspire_dern_helpers_private_searcher_t searcher;
+
+    octaspire_dern_helpers_private_searcher_init(
+        &searcher,
+        (uint8_t const*)needle,
+        needleLength);
+
+    // Octet indices are UCS indices when every character is one octet.
+    // Otherwise characters are counted by their leading octets between
+    // consecutive occurrences.
+    size_t octetIndex = 0;
+    size_t ucsIndex   = 0;
+    size_t found      = 0;
+
+    while (octaspire_dern_helpers_private_searcher_find(
+               &searcher,
+               haystack,
+               haystackLength,
+               octetIndex,
+               &found))
+    {
+        if (isAscii)
+        {
+            ucsIndex = found;
+        }
+        else
+        {
+            for (size_t i = octetIndex; i < found; ++i)
+            {
+                if ((haystack[i] & 0xC0) != 0x80)
+                {
+                    ++ucsIndex;
+                }
+            }
+        }
+
+        if (!octaspire_vector_push_back_element(result, &ucsIndex))
+        {
+            octaspire_vector_release(result);
+            return 0;
+        }
+
+        // Continue from the next octet to find overlapping occurrences.
+        // Matches start only at leading octets, because the needle
+        // starts with one.
+        octetIndex = found;
+
+        if (!isAscii)
+        {
+            ++ucsIndex;
+        }
+
+        ++octetIndex;
+    }
+
+    return result;
+}
+
+size_t octaspire_dern_helpers_get_octet_index_of_ucs_index(
+    char const * const octets,
+    size_t const numOctets,
+    size_t const ucsIndex)
+{
+    size_t numLeadingOctets = 0;
+
+    for (size_t i = 0; i < numOctets; ++i)
+    {
+        if ((octets[i] & 0xC0) != 0x80)
+        {
+            if (numLeadingOctets == ucsIndex)
+            {
+                return i;
+            }
+
+            ++numLeadingOctets;
+        }
+    }
+
+    return numOctets;
+}
+
@@ -0,0 +1,1973 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+    #include <octaspire/core/octaspire_map.h>
+    #include <octaspire/core/octaspire_semver.h>
+    #include <octaspire/core/octaspire_string.h>
+    #include <octaspire/core/octaspire_vector.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_bytes.h"
+#include "octaspire/dern/octaspire_dern_deque.h"
+#include "octaspire/dern/octaspire_dern_environment.h"
+#include "octaspire/dern/octaspire_dern_lib.h"
+#include "octaspire/dern/octaspire_dern_map.h"
+#include "octaspire/dern/octaspire_dern_stdlib.h"
+#include "octaspire/dern/octaspire_dern_typed_array.h"
+#include "octaspire/dern/octaspire_dern_value.h"
+#include "octaspire/dern/octaspire_dern_vm.h"
+#include "octaspire/dern/octaspire_dern_config.h"
+
+#define OCTASPIRE_DERN_IMAGE_PRIVATE_FORMAT_VERSION 1
+#define OCTASPIRE_DERN_IMAGE_PRIVATE_HASH_SEED      UINT64_C(14695981039346656037)
+
+static char const octaspire_dern_image_private_magic[8] =
+{
+    'D', 'E', 'R', 'N', 'I', 'M', 'A', 'G'
+};
+
+static char const * const octaspire_dern_image_private_version =
+    OCTASPIRE_DERN_CONFIG_VERSION_MAJOR "."
+    OCTASPIRE_DERN_CONFIG_VERSION_MINOR "."
+    OCTASPIRE_DERN_CONFIG_VERSION_PATCH;
+
+// After the header come the libraries and then one record for every
+// value, the global environment first. A record refers to other values
+// by their index plus one; zero refers to no value. Records of values
+// other than builtins and specials end with the documentation of the value.
+typedef enum octaspire_dern_image_private_tag_t
+{
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_NIL,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BOOLEAN,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_INTEGER,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_REAL,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_CHARACTER,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SYMBOL,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SEMVER,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_VECTOR,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_HASH_MAP,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_QUEUE,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_LIST,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SET,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_MACRO,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BUILTIN,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SPECIAL,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BYTES,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING_BUILDER,
+    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_TYPED_ARRAY
+}
+octaspire_dern_image_private_tag_t;
+
+typedef struct octaspire_dern_image_private_writer_t
+{
+    octaspire_dern_vm_t    *vm;
+    octaspire_dern_bytes_t *bytes;
+    octaspire_vector_t     *values;
+    octaspire_map_t        *indices;
+}
+octaspire_dern_image_private_writer_t;
+
+typedef struct octaspire_dern_image_private_record_t
+{
+    size_t  firstRef;
+    size_t  numRefs;
+    size_t  docstr;
+    size_t  docvec;
+    uint8_t tag;
+    bool    howtoAllowed;
+    bool    hasDocumentation;
+    char    padding[5];
+}
+octaspire_dern_image_private_record_t;
+
+typedef struct octaspire_dern_image_private_reader_t
+{
+    octaspire_dern_vm_t                   *vm;
+    char const                            *octets;
+    size_t                                 length;
+    size_t                                 index;
+    octaspire_dern_value_t               **values;
+    octaspire_dern_image_private_record_t *records;
+    size_t                                 numValues;
+    octaspire_vector_t                    *refs;
+}
+octaspire_dern_image_private_reader_t;
+
+// 64 bit FNV-1a.
+static uint64_t octaspire_dern_image_private_hash(
+    void const * const octets,
+    size_t const length)
+{
+    uint8_t const * const ptr  = octets;
+    uint64_t              hash = OCTASPIRE_DERN_IMAGE_PRIVATE_HASH_SEED;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= ptr[i];
+        hash *= UINT64_C(1099511628211);
+    }
+
+    return hash;
+}
+
+// Unsigned numbers are written seven bits in an octet, least significant
+// bits first; the high bit tells that more octets follow.
+static bool octaspire_dern_image_private_push_back_number(
+    octaspire_dern_bytes_t * const bytes,
+    uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        if (!octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)(value | 0x80)))
+        {
+            return false;
+        }
+
+        value >>= 7;
+    }
+
+    return octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)value);
+}
+
+static bool octaspire_dern_image_private_push_back_fixed(
+    octaspire_dern_bytes_t * const bytes,
+    uint64_t const value)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        if (!octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)(value >> (8 * i))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool octaspire_dern_image_private_push_back_text(
+    octaspire_dern_bytes_t * const bytes,
+    char const * const text,
+    size_t const length)
+{
+    return octaspire_dern_image_private_push_back_number(bytes, length) &&
+        octaspire_dern_bytes_push_back_buffer(bytes, text, length);
+}
+
+static bool octaspire_dern_image_private_push_back_string(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_string_t const * const str)
+{
+    return octaspire_dern_image_private_push_back_text(
+        bytes,
+        octaspire_string_get_c_string(str),
+        octaspire_string_get_length_in_octets(str));
+}
+
+static bool octaspire_dern_image_private_push_back_semver(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_semver_t const * const semver)
+{
+    size_t const numPreRelease =
+        octaspire_semver_get_num_pre_release_identifiers(semver);
+
+    if (!octaspire_dern_image_private_push_back_number(bytes, octaspire_semver_get_major(semver)) ||
+        !octaspire_dern_image_private_push_back_number(bytes, octaspire_semver_get_minor(semver)) ||
+        !octaspire_dern_image_private_push_back_number(bytes, octaspire_semver_get_patch(semver)) ||
+        !octaspire_dern_image_private_push_back_number(bytes, numPreRelease))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numPreRelease; ++i)
+    {
+        size_t      numerical = 0;
+        char const *lexical   = 0;
+
+        if (octaspire_semver_get_prerelease_at(semver, i, &numerical, &lexical) ==
+            OCTASPIRE_SEMVER_PRE_RELEASE_ELEM_TYPE_NUMERICAL)
+        {
+            if (!octaspire_dern_bytes_push_back_octet(bytes, 0) ||
+                !octaspire_dern_image_private_push_back_number(bytes, numerical))
+            {
+                return false;
+            }
+        }
+        else if (!octaspire_dern_bytes_push_back_octet(bytes, 1) ||
+                 !octaspire_dern_image_private_push_back_text(bytes, lexical, strlen(lexical)))
+        {
+            return false;
+        }
+    }
+
+    size_t const numBuildMetadata =
+        octaspire_semver_get_num_build_metadata_identifiers(semver);
+
+    if (!octaspire_dern_image_private_push_back_number(bytes, numBuildMetadata))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numBuildMetadata; ++i)
+    {
+        char const * const metadata = octaspire_semver_get_build_metadata_at(semver, i);
+
+        if (!octaspire_dern_image_private_push_back_text(bytes, metadata, strlen(metadata)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Values are numbered in the order they are first referred to. A value
+// that has no number yet is numbered and queued to be written.
+static bool octaspire_dern_image_private_push_back_ref(
+    octaspire_dern_image_private_writer_t * const self,
+    octaspire_dern_value_t const * const value)
+{
+    if (!value)
+    {
+        return octaspire_dern_image_private_push_back_number(self->bytes, 0);
+    }
+
+    size_t const   key  = (size_t)value->uniqueId;
+    uint32_t const hash = octaspire_map_helper_size_t_get_hash(key);
+
+    octaspire_map_element_t * const element = octaspire_map_get(self->indices, hash, &key);
+
+    if (element)
+    {
+        size_t const index = *(size_t const*)octaspire_map_element_get_value(element);
+        return octaspire_dern_image_private_push_back_number(self->bytes, index + 1);
+    }
+
+    size_t const index = octaspire_vector_get_length(self->values);
+
+    return octaspire_vector_push_back_element(self->values, &value) &&
+        octaspire_map_put(self->indices, hash, &key, &index) &&
+        octaspire_dern_image_private_push_back_number(self->bytes, index + 1);
+}
+
+static bool octaspire_dern_image_private_push_back_bindings(
+    octaspire_dern_image_private_writer_t * const self,
+    octaspire_dern_map_t const * const map)
+{
+    if (!octaspire_dern_image_private_push_back_number(
+            self->bytes,
+            octaspire_dern_map_get_number_of_elements(map)))
+    {
+        return false;
+    }
+
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(map);
+
+    while (iter.element)
+    {
+        if (!octaspire_dern_image_private_push_back_ref(
+                self,
+                octaspire_dern_map_element_get_key_const(iter.element)) ||
+            !octaspire_dern_image_private_push_back_ref(
+                self,
+                octaspire_dern_map_element_get_value_const(iter.element)))
+        {
+            return false;
+        }
+
+        octaspire_dern_map_element_const_iterator_next(&iter);
+    }
+
+    return true;
+}
+
+static bool octaspire_dern_image_private_push_back_deque(
+    octaspire_dern_image_private_writer_t * const self,
+    octaspire_dern_deque_t const * const deque)
+{
+    if (!octaspire_dern_image_private_push_back_number(
+            self->bytes,
+            octaspire_dern_deque_get_length(deque)))
+    {
+        return false;
+    }
+
+    octaspire_dern_deque_iterator_t iter = octaspire_dern_deque_iterator_init(deque);
+
+    while (iter.element)
+    {
+        if (!octaspire_dern_image_private_push_back_ref(self, iter.element))
+        {
+            return false;
+        }
+
+        octaspire_dern_deque_iterator_next(&iter);
+    }
+
+    return true;
+}
+
+// Returns false if 'value' has a type that cannot be written; 'isGood'
+// is set to false if writing failed otherwise.
+static bool octaspire_dern_image_private_push_back_record(
+    octaspire_dern_image_private_writer_t * const self,
+    octaspire_dern_value_t const * const value,
+    bool * const isGood)
+{
+    octaspire_dern_bytes_t * const bytes = self->bytes;
+
+    bool good = true;
+
+    switch (value->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        {
+            good = octaspire_dern_bytes_push_back_octet(
+                bytes,
+                OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_NIL);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BOOLEAN) &&
+                octaspire_dern_bytes_push_back_octet(bytes, value->value.boolean ? 1 : 0);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_INTEGER) &&
+                octaspire_dern_image_private_push_back_number(
+                    bytes,
+                    (uint32_t)value->value.integer);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        {
+            uint64_t bits = 0;
+            memcpy(&bits, &(value->value.real), sizeof(bits));
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_REAL) &&
+                octaspire_dern_image_private_push_back_fixed(bytes, bits);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING) &&
+                octaspire_dern_image_private_push_back_string(bytes, value->value.string);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_CHARACTER) &&
+                octaspire_dern_image_private_push_back_string(bytes, value->value.character);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SYMBOL) &&
+                octaspire_dern_image_private_push_back_string(bytes, value->value.symbol);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SEMVER) &&
+                octaspire_dern_image_private_push_back_semver(bytes, value->value.semver);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            size_t const length = octaspire_vector_get_length(value->value.vector);
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_VECTOR) &&
+                octaspire_dern_image_private_push_back_number(bytes, length);
+
+            for (size_t i = 0; good && i < length; ++i)
+            {
+                good = octaspire_dern_image_private_push_back_ref(
+                    self,
+                    octaspire_vector_get_element_at_const(value->value.vector, (ptrdiff_t)i));
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_HASH_MAP) &&
+                octaspire_dern_bytes_push_back_octet(bytes, value->hashMapHasWeakKeys ? 1 : 0) &&
+                octaspire_dern_image_private_push_back_bindings(self, value->value.hashMap);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        {
+            bool const hasMaxLength = octaspire_dern_deque_has_max_length(value->value.queue);
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_QUEUE) &&
+                octaspire_dern_bytes_push_back_octet(bytes, hasMaxLength ? 1 : 0) &&
+                (!hasMaxLength ||
+                 octaspire_dern_image_private_push_back_number(
+                     bytes,
+                     octaspire_dern_deque_get_max_length(value->value.queue))) &&
+                octaspire_dern_image_private_push_back_deque(self, value->value.queue);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_LIST) &&
+                octaspire_dern_image_private_push_back_deque(self, value->value.list);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SET) &&
+                octaspire_dern_image_private_push_back_number(
+                    bytes,
+                    octaspire_dern_map_get_number_of_elements(value->value.set));
+
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(value->value.set);
+
+            while (good && iter.element)
+            {
+                good = octaspire_dern_image_private_push_back_ref(
+                    self,
+                    octaspire_dern_map_element_get_key_const(iter.element));
+
+                octaspire_dern_map_element_const_iterator_next(&iter);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        {
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT) &&
+                octaspire_dern_image_private_push_back_ref(
+                    self,
+                    value->value.environment->enclosing) &&
+                octaspire_dern_image_private_push_back_bindings(
+                    self,
+                    value->value.environment->bindings);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        {
+            octaspire_dern_function_t const * const function = value->value.function;
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_FUNCTION) ?
+                        OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION :
+                        OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_MACRO) &&
+                octaspire_dern_image_private_push_back_string(bytes, function->name) &&
+                octaspire_dern_image_private_push_back_string(bytes, function->docstr) &&
+                octaspire_dern_bytes_push_back_octet(bytes, function->howtoAllowed ? 1 : 0) &&
+                octaspire_dern_image_private_push_back_ref(self, function->formals) &&
+                octaspire_dern_image_private_push_back_ref(self, function->body) &&
+                octaspire_dern_image_private_push_back_ref(self, function->definitionEnvironment);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            octaspire_dern_bytes_t const * const octets =
+                (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES) ?
+                    value->value.bytes :
+                    value->value.stringBuilder;
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES) ?
+                        OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BYTES :
+                        OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING_BUILDER) &&
+                octaspire_dern_image_private_push_back_text(
+                    bytes,
+                    (char const*)octaspire_dern_bytes_get_octets(octets),
+                    octaspire_dern_bytes_get_length(octets));
+        }
+        break;
+
+        // Elements are written as 64 bit integers or as bits of reals,
+        // so that every element type is written without loss.
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            octaspire_dern_typed_array_t const * const array = value->value.typedArray;
+
+            octaspire_dern_typed_array_element_type_t const elementType =
+                octaspire_dern_typed_array_get_element_type(array);
+
+            bool const   isInteger = octaspire_dern_typed_array_element_type_is_integer(elementType);
+            size_t const length    = octaspire_dern_typed_array_get_length(array);
+
+            good =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_TYPED_ARRAY) &&
+                octaspire_dern_bytes_push_back_octet(bytes, (uint8_t)elementType) &&
+                octaspire_dern_image_private_push_back_number(bytes, length);
+
+            for (size_t i = 0; good && i < length; ++i)
+            {
+                uint64_t bits = 0;
+
+                if (isInteger)
+                {
+                    bits = (uint64_t)octaspire_dern_typed_array_get_integer_at(array, i);
+                }
+                else
+                {
+                    double const real = octaspire_dern_typed_array_get_real_at(array, i);
+                    memcpy(&bits, &real, sizeof(bits));
+                }
+
+                good = octaspire_dern_image_private_push_back_fixed(bytes, bits);
+            }
+        }
+        break;
+
+        // Builtins and specials are created by the new VM and are found
+        // there by name.
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        {
+            *isGood =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BUILTIN) &&
+                octaspire_dern_image_private_push_back_string(bytes, value->value.builtin->name);
+
+            return true;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        {
+            *isGood =
+                octaspire_dern_bytes_push_back_octet(
+                    bytes,
+                    OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SPECIAL) &&
+                octaspire_dern_image_private_push_back_string(bytes, value->value.special->name);
+
+            return true;
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+
+    *isGood = good &&
+        octaspire_dern_image_private_push_back_ref(self, value->docstr) &&
+        octaspire_dern_image_private_push_back_ref(self, value->docvec) &&
+        octaspire_dern_bytes_push_back_octet(bytes, value->howtoAllowed ? 1 : 0);
+
+    return true;
+}
+
+static bool octaspire_dern_image_private_push_back_libraries(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_bytes_t * const bytes)
+{
+    size_t const numLibraries = octaspire_dern_vm_get_number_of_libraries(vm);
+
+    if (!octaspire_dern_image_private_push_back_number(bytes, numLibraries))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < numLibraries; ++i)
+    {
+        octaspire_dern_lib_t const * const lib =
+            octaspire_dern_vm_get_library_at(vm, (ptrdiff_t)i);
+
+        char const * const name = octaspire_dern_lib_get_name(lib);
+
+        if (!octaspire_dern_image_private_push_back_text(bytes, name, strlen(name)) ||
+            !octaspire_dern_bytes_push_back_octet(
+                bytes,
+                octaspire_dern_lib_is_binary(lib) ? 1 : 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool octaspire_dern_image_private_write_file(
+    char const * const path,
+    octaspire_dern_bytes_t const * const header,
+    octaspire_dern_bytes_t const * const body,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_string_t *tmpPath = octaspire_string_new_format(allocator, "%s.tmp", path);
+
+    if (!tmpPath)
+    {
+        return false;
+    }
+
+#ifdef _MSC_VER
+    FILE *file = 0;
+
+    if (fopen_s(&file, octaspire_string_get_c_string(tmpPath), "wb"))
+    {
+        file = 0;
+    }
+#else
+    FILE *file = fopen(octaspire_string_get_c_string(tmpPath), "wb");
+#endif
+
+    bool result = false;
+
+    if (file)
+    {
+        size_t const headerLength = octaspire_dern_bytes_get_length(header);
+        size_t const bodyLength   = octaspire_dern_bytes_get_length(body);
+
+        result =
+            fwrite(octaspire_dern_bytes_get_octets(header), 1, headerLength, file) ==
+                headerLength &&
+            fwrite(octaspire_dern_bytes_get_octets(body), 1, bodyLength, file) ==
+                bodyLength;
+
+        result = (fclose(file) == 0) && result;
+        file = 0;
+
+#ifdef _WIN32
+        // Rename does not replace an existing file on Windows.
+        remove(path);
+#endif
+
+        result = result && rename(octaspire_string_get_c_string(tmpPath), path) == 0;
+
+        if (!result)
+        {
+            remove(octaspire_string_get_c_string(tmpPath));
+        }
+    }
+
+    octaspire_string_release(tmpPath);
+    tmpPath = 0;
+
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_image_save(
+    octaspire_dern_vm_t * const vm,
+    char const * const path)
+{
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
+
+    // Records are written from the storage of the values themselves.
+    octaspire_dern_vm_materialize_all_copy_on_write_values(vm);
+
+    octaspire_dern_image_private_writer_t writer;
+
+    writer.vm      = vm;
+    writer.bytes   = octaspire_dern_bytes_new(allocator);
+    writer.values  = octaspire_vector_new(sizeof(octaspire_dern_value_t*), true, 0, allocator);
+    writer.indices = octaspire_map_new_with_size_t_keys(sizeof(size_t), false, 0, allocator);
+
+    octaspire_dern_bytes_t *body   = octaspire_dern_bytes_new(allocator);
+    octaspire_dern_bytes_t *header = octaspire_dern_bytes_new(allocator);
+
+    octaspire_dern_value_t *result = 0;
+    bool                    isGood =
+        writer.bytes && writer.values && writer.indices && body && header &&
+        octaspire_dern_image_private_push_back_libraries(vm, body);
+
+    // Writing the reference to the global environment numbers it first.
+    isGood = isGood &&
+        octaspire_dern_image_private_push_back_ref(
+            &writer,
+            octaspire_dern_vm_get_global_environment(vm));
+
+    octaspire_dern_bytes_clear(writer.bytes);
+
+    // Records refer to values that are not numbered yet, so the records
+    // are written as the values are numbered.
+    for (size_t i = 0; isGood && i < octaspire_vector_get_length(writer.values); ++i)
+    {
+        octaspire_dern_value_t const * const value =
+            octaspire_vector_get_element_at_const(writer.values, (ptrdiff_t)i);
+
+        if (!octaspire_dern_image_private_push_back_record(&writer, value, &isGood))
+        {
+            result = octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Image '%s' cannot be saved: values of type '%s' cannot be saved.",
+                path,
+                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+
+            isGood = false;
+        }
+    }
+
+    isGood = isGood &&
+        octaspire_dern_image_private_push_back_number(
+            body,
+            octaspire_vector_get_length(writer.values)) &&
+        octaspire_dern_bytes_push_back_buffer(
+            body,
+            octaspire_dern_bytes_get_octets(writer.bytes),
+            octaspire_dern_bytes_get_length(writer.bytes));
+
+    isGood = isGood &&
+        octaspire_dern_bytes_push_back_buffer(
+            header,
+            octaspire_dern_image_private_magic,
+            sizeof(octaspire_dern_image_private_magic)) &&
+        octaspire_dern_image_private_push_back_number(
+            header,
+            OCTASPIRE_DERN_IMAGE_PRIVATE_FORMAT_VERSION) &&
+        octaspire_dern_image_private_push_back_text(
+            header,
+            octaspire_dern_image_private_version,
+            strlen(octaspire_dern_image_private_version)) &&
+        octaspire_dern_image_private_push_back_fixed(
+            header,
+            octaspire_dern_image_private_hash(
+                octaspire_dern_bytes_get_octets(body),
+                octaspire_dern_bytes_get_length(body)));
+
+    isGood = isGood && octaspire_dern_image_private_write_file(path, header, body, allocator);
+
+    if (!result)
+    {
+        result = isGood ?
+            octaspire_dern_vm_create_new_value_boolean(vm, true) :
+            octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Image '%s' cannot be saved.",
+                path);
+    }
+
+    octaspire_dern_bytes_release(header);
+    header = 0;
+
+    octaspire_dern_bytes_release(body);
+    body = 0;
+
+    octaspire_map_release(writer.indices);
+    writer.indices = 0;
+
+    octaspire_vector_release(writer.values);
+    writer.values = 0;
+
+    octaspire_dern_bytes_release(writer.bytes);
+    writer.bytes = 0;
+
+    return result;
+}
+
+static bool octaspire_dern_image_private_pop_front_octet(
+    octaspire_dern_image_private_reader_t * const self,
+    uint8_t * const value)
+{
+    if (self->index >= self->length)
+    {
+        return false;
+    }
+
+    *value = (uint8_t)self->octets[self->index];
+    ++(self->index);
+    return true;
+}
+
+static bool octaspire_dern_image_private_pop_front_number(
+    octaspire_dern_image_private_reader_t * const self,
+    uint64_t * const value)
+{
+    *value = 0;
+
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t octet = 0;
+
+        if (!octaspire_dern_image_private_pop_front_octet(self, &octet))
+        {
+            return false;
+        }
+
+        *value |= (uint64_t)(octet & 0x7F) << shift;
+
+        if (!(octet & 0x80))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool octaspire_dern_image_private_pop_front_fixed(
+    octaspire_dern_image_private_reader_t * const self,
+    uint64_t * const value)
+{
+    if (self->length - self->index < 8)
+    {
+        return false;
+    }
+
+    *value = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        *value |= (uint64_t)(uint8_t)self->octets[self->index + i] << (8 * i);
+    }
+
+    self->index += 8;
+    return true;
+}
+
+// Text is left in the loaded octets; 'text' points into them.
+static bool octaspire_dern_image_private_pop_front_text(
+    octaspire_dern_image_private_reader_t * const self,
+    char const ** const text,
+    size_t * const length)
+{
+    uint64_t value = 0;
+
+    if (!octaspire_dern_image_private_pop_front_number(self, &value) ||
+        value > self->length - self->index)
+    {
+        return false;
+    }
+
+    *text   = self->octets + self->index;
+    *length = (size_t)value;
+
+    self->index += (size_t)value;
+    return true;
+}
+
+static octaspire_string_t *octaspire_dern_image_private_pop_front_string(
+    octaspire_dern_image_private_reader_t * const self)
+{
+    char const *text   = 0;
+    size_t      length = 0;
+
+    if (!octaspire_dern_image_private_pop_front_text(self, &text, &length))
+    {
+        return 0;
+    }
+
+    return octaspire_string_new_from_buffer(
+        text,
+        length,
+        octaspire_dern_vm_get_allocator(self->vm));
+}
+
+// Counts are checked against the octets left, so that a damaged count
+// cannot make the reader loop or allocate for long.
+static bool octaspire_dern_image_private_pop_front_count(
+    octaspire_dern_image_private_reader_t * const self,
+    size_t * const count)
+{
+    uint64_t value = 0;
+
+    if (!octaspire_dern_image_private_pop_front_number(self, &value) ||
+        value > self->length - self->index)
+    {
+        return false;
+    }
+
+    *count = (size_t)value;
+    return true;
+}
+
+static bool octaspire_dern_image_private_pop_front_ref(
+    octaspire_dern_image_private_reader_t * const self,
+    size_t * const ref)
+{
+    uint64_t value = 0;
+
+    if (!octaspire_dern_image_private_pop_front_number(self, &value) ||
+        value > self->numValues)
+    {
+        return false;
+    }
+
+    *ref = (size_t)value;
+    return true;
+}
+
+static bool octaspire_dern_image_private_pop_front_refs(
+    octaspire_dern_image_private_reader_t * const self,
+    octaspire_dern_image_private_record_t * const record,
+    size_t const numRefs)
+{
+    for (size_t i = 0; i < numRefs; ++i)
+    {
+        size_t ref = 0;
+
+        if (!octaspire_dern_image_private_pop_front_ref(self, &ref) ||
+            !octaspire_vector_push_back_element(self->refs, &ref))
+        {
+            return false;
+        }
+    }
+
+    record->numRefs += numRefs;
+    return true;
+}
+
+static octaspire_semver_t *octaspire_dern_image_private_pop_front_semver(
+    octaspire_dern_image_private_reader_t * const self)
+{
+    uint64_t major = 0;
+    uint64_t minor = 0;
+    uint64_t patch = 0;
+    size_t   count = 0;
+
+    if (!octaspire_dern_image_private_pop_front_number(self, &major) ||
+        !octaspire_dern_image_private_pop_front_number(self, &minor) ||
+        !octaspire_dern_image_private_pop_front_number(self, &patch) ||
+        !octaspire_dern_image_private_pop_front_count(self, &count))
+    {
+        return 0;
+    }
+
+    octaspire_semver_t *result = octaspire_semver_new(
+        (size_t)major,
+        (size_t)minor,
+        (size_t)patch,
+        0,
+        0,
+        octaspire_dern_vm_get_allocator(self->vm));
+
+    if (!result)
+    {
+        return result;
+    }
+
+    bool good = true;
+
+    for (size_t i = 0; good && i < count; ++i)
+    {
+        uint8_t isLexical = 0;
+
+        good = octaspire_dern_image_private_pop_front_octet(self, &isLexical);
+
+        if (good && !isLexical)
+        {
+            uint64_t numerical = 0;
+
+            good = octaspire_dern_image_private_pop_front_number(self, &numerical) &&
+                octaspire_semver_add_prerelease_numerical(result, (size_t)numerical);
+        }
+        else if (good)
+        {
+            octaspire_string_t *str = octaspire_dern_image_private_pop_front_string(self);
+
+            good = str &&
+                octaspire_semver_add_prerelease(result, octaspire_string_get_c_string(str));
+
+            octaspire_string_release(str);
+            str = 0;
+        }
+    }
+
+    good = good && octaspire_dern_image_private_pop_front_count(self, &count);
+
+    for (size_t i = 0; good && i < count; ++i)
+    {
+        octaspire_string_t *str = octaspire_dern_image_private_pop_front_string(self);
+
+        good = str &&
+            octaspire_semver_add_buildmetadata(result, octaspire_string_get_c_string(str));
+
+        octaspire_string_release(str);
+        str = 0;
+    }
+
+    if (!good)
+    {
+        octaspire_semver_release(result);
+        result = 0;
+    }
+
+    return result;
+}
+
+static octaspire_dern_value_t *octaspire_dern_image_private_get_ref(
+    octaspire_dern_image_private_reader_t const * const self,
+    size_t const ref)
+{
+    return ref ? self->values[ref - 1] : 0;
+}
+
+static octaspire_dern_value_t *octaspire_dern_image_private_get_ref_at(
+    octaspire_dern_image_private_reader_t const * const self,
+    octaspire_dern_image_private_record_t const * const record,
+    size_t const index)
+{
+    return octaspire_dern_image_private_get_ref(
+        self,
+        *(size_t const*)octaspire_vector_get_element_at_const(
+            self->refs,
+            (ptrdiff_t)(record->firstRef + index)));
+}
+
+// Finds a builtin or special of the new VM from its global environment.
+static octaspire_dern_value_t *octaspire_dern_image_private_find_by_name(
+    octaspire_dern_image_private_reader_t * const self,
+    octaspire_dern_value_tag_t const typeTag)
+{
+    octaspire_string_t *name = octaspire_dern_image_private_pop_front_string(self);
+
+    if (!name)
+    {
+        return 0;
+    }
+
+    octaspire_dern_value_t * const globalEnvironment =
+        octaspire_dern_vm_get_global_environment(self->vm);
+
+    octaspire_dern_value_t * const symbol =
+        octaspire_dern_vm_create_new_value_symbol_from_c_string(
+            self->vm,
+            octaspire_string_get_c_string(name));
+
+    octaspire_dern_value_t *result =
+        octaspire_dern_environment_get(globalEnvironment->value.environment, symbol);
+
+    octaspire_string_t const * const foundName =
+        !result                     ? 0 :
+        result->typeTag != typeTag  ? 0 :
+        (typeTag == OCTASPIRE_DERN_VALUE_TAG_BUILTIN) ?
+            result->value.builtin->name :
+            result->value.special->name;
+
+    if (!foundName || !octaspire_string_is_equal(foundName, name))
+    {
+        result = octaspire_dern_vm_create_new_value_error_format(
+            self->vm,
+            "%s '%s' cannot be found.",
+            (typeTag == OCTASPIRE_DERN_VALUE_TAG_BUILTIN) ? "Builtin" : "Special",
+            octaspire_string_get_c_string(name));
+    }
+
+    octaspire_string_release(name);
+    name = 0;
+
+    return result;
+}
+
+// Creates the value of the next record. Containers are left empty and
+// functions without formals, body and environment, because they can
+// refer to values that are not created yet. Returns null if the record
+// is damaged, or an error value.
+static octaspire_dern_value_t *octaspire_dern_image_private_create_value(
+    octaspire_dern_image_private_reader_t * const self,
+    size_t const index)
+{
+    octaspire_dern_vm_t * const vm = self->vm;
+
+    octaspire_dern_image_private_record_t * const record = &(self->records[index]);
+
+    record->firstRef         = octaspire_vector_get_length(self->refs);
+    record->numRefs          = 0;
+    record->docstr           = 0;
+    record->docvec           = 0;
+    record->howtoAllowed     = false;
+    record->hasDocumentation = true;
+
+    if (!octaspire_dern_image_private_pop_front_octet(self, &(record->tag)))
+    {
+        return 0;
+    }
+
+    // Only the global environment can be the first record.
+    if (index == 0 && record->tag != OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT)
+    {
+        return 0;
+    }
+
+    octaspire_dern_value_t *result = 0;
+    size_t                  count  = 0;
+
+    switch ((octaspire_dern_image_private_tag_t)record->tag)
+    {
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_NIL:
+        {
+            result = octaspire_dern_vm_create_new_value_nil(vm);
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BOOLEAN:
+        {
+            uint8_t value = 0;
+
+            if (octaspire_dern_image_private_pop_front_octet(self, &value))
+            {
+                result = octaspire_dern_vm_create_new_value_boolean(vm, value != 0);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_INTEGER:
+        {
+            uint64_t value = 0;
+
+            if (octaspire_dern_image_private_pop_front_number(self, &value))
+            {
+                result = octaspire_dern_vm_create_new_value_integer(
+                    vm,
+                    (int32_t)(uint32_t)value);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_REAL:
+        {
+            uint64_t bits  = 0;
+            double   value = 0;
+
+            if (octaspire_dern_image_private_pop_front_fixed(self, &bits))
+            {
+                memcpy(&value, &bits, sizeof(value));
+                result = octaspire_dern_vm_create_new_value_real(vm, value);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SYMBOL:
+        {
+            octaspire_string_t * const str = octaspire_dern_image_private_pop_front_string(self);
+
+            if (!str)
+            {
+                break;
+            }
+
+            if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING)
+            {
+                result = octaspire_dern_vm_create_new_value_string(vm, str);
+            }
+            else if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_CHARACTER)
+            {
+                result = octaspire_dern_vm_create_new_value_character(vm, str);
+            }
+            else
+            {
+                result = octaspire_dern_vm_create_new_value_symbol(vm, str);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SEMVER:
+        {
+            octaspire_semver_t * const semver =
+                octaspire_dern_image_private_pop_front_semver(self);
+
+            if (semver)
+            {
+                result = octaspire_dern_vm_create_new_value_semver(vm, semver);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_VECTOR:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_LIST:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SET:
+        {
+            if (!octaspire_dern_image_private_pop_front_count(self, &count) ||
+                !octaspire_dern_image_private_pop_front_refs(self, record, count))
+            {
+                break;
+            }
+
+            if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_VECTOR)
+            {
+                result = octaspire_dern_vm_create_new_value_vector(vm);
+            }
+            else if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_LIST)
+            {
+                result = octaspire_dern_vm_create_new_value_list(vm);
+            }
+            else
+            {
+                result = octaspire_dern_vm_create_new_value_set(vm);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_HASH_MAP:
+        {
+            uint8_t hasWeakKeys = 0;
+
+            if (!octaspire_dern_image_private_pop_front_octet(self, &hasWeakKeys) ||
+                !octaspire_dern_image_private_pop_front_count(self, &count) ||
+                !octaspire_dern_image_private_pop_front_refs(self, record, 2 * count))
+            {
+                break;
+            }
+
+            result = hasWeakKeys ?
+                octaspire_dern_vm_create_new_value_weak_hash_map(vm) :
+                octaspire_dern_vm_create_new_value_hash_map(vm);
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_QUEUE:
+        {
+            uint8_t  hasMaxLength = 0;
+            uint64_t maxLength    = 0;
+
+            if (!octaspire_dern_image_private_pop_front_octet(self, &hasMaxLength) ||
+                (hasMaxLength &&
+                 !octaspire_dern_image_private_pop_front_number(self, &maxLength)) ||
+                !octaspire_dern_image_private_pop_front_count(self, &count) ||
+                !octaspire_dern_image_private_pop_front_refs(self, record, count))
+            {
+                break;
+            }
+
+            result = hasMaxLength ?
+                octaspire_dern_vm_create_new_value_queue_with_max_length(
+                    vm,
+                    (size_t)maxLength) :
+                octaspire_dern_vm_create_new_value_queue(vm);
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT:
+        {
+            // The enclosing environment is the first reference.
+            if (!octaspire_dern_image_private_pop_front_refs(self, record, 1) ||
+                !octaspire_dern_image_private_pop_front_count(self, &count) ||
+                !octaspire_dern_image_private_pop_front_refs(self, record, 2 * count))
+            {
+                break;
+            }
+
+            result = (index == 0) ?
+                octaspire_dern_vm_get_global_environment(vm) :
+                octaspire_dern_vm_create_new_value_environment(vm, 0);
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_MACRO:
+        {
+            octaspire_string_t *name   = octaspire_dern_image_private_pop_front_string(self);
+            octaspire_string_t *docstr = octaspire_dern_image_private_pop_front_string(self);
+            uint8_t             howto  = 0;
+
+            octaspire_dern_function_t *function = 0;
+
+            // Formals, body and definition environment are the references.
+            if (name && docstr &&
+                octaspire_dern_image_private_pop_front_octet(self, &howto) &&
+                octaspire_dern_image_private_pop_front_refs(self, record, 3))
+            {
+                function = octaspire_dern_function_new(
+                    0,
+                    0,
+                    0,
+                    octaspire_dern_vm_get_allocator(vm));
+            }
+
+            if (function &&
+                !octaspire_dern_function_set_howto_data(
+                    function,
+                    octaspire_string_get_c_string(name),
+                    octaspire_string_get_c_string(docstr),
+                    howto != 0))
+            {
+                octaspire_dern_function_release(function);
+                function = 0;
+            }
+
+            octaspire_string_release(docstr);
+            docstr = 0;
+
+            octaspire_string_release(name);
+            name = 0;
+
+            if (!function)
+            {
+                break;
+            }
+
+            result = (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION) ?
+                octaspire_dern_vm_create_new_value_function(vm, function, "", 0) :
+                octaspire_dern_vm_create_new_value_macro(vm, function, "", 0);
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BYTES:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_STRING_BUILDER:
+        {
+            char const *text   = 0;
+            size_t      length = 0;
+
+            if (!octaspire_dern_image_private_pop_front_text(self, &text, &length))
+            {
+                break;
+            }
+
+            if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BYTES)
+            {
+                result = octaspire_dern_vm_create_new_value_bytes_from_buffer(vm, text, length);
+            }
+            else
+            {
+                result = octaspire_dern_vm_create_new_value_string_builder(vm);
+
+                if (result &&
+                    !octaspire_dern_bytes_push_back_buffer(
+                        result->value.stringBuilder,
+                        text,
+                        length))
+                {
+                    result = 0;
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_TYPED_ARRAY:
+        {
+            uint8_t elementType = 0;
+
+            // Every element takes eight octets.
+            if (!octaspire_dern_image_private_pop_front_octet(self, &elementType) ||
+                elementType > OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8 ||
+                !octaspire_dern_image_private_pop_front_count(self, &count) ||
+                count > (self->length - self->index) / 8)
+            {
+                break;
+            }
+
+            result = octaspire_dern_vm_create_new_value_typed_array(
+                vm,
+                (octaspire_dern_typed_array_element_type_t)elementType,
+                count);
+
+            bool const isInteger = octaspire_dern_typed_array_element_type_is_integer(
+                (octaspire_dern_typed_array_element_type_t)elementType);
+
+            for (size_t i = 0; result && i < count; ++i)
+            {
+                uint64_t bits = 0;
+                double   real = 0;
+
+                if (!octaspire_dern_image_private_pop_front_fixed(self, &bits))
+                {
+                    result = 0;
+                    break;
+                }
+
+                if (isInteger)
+                {
+                    octaspire_dern_typed_array_set_integer_at(
+                        result->value.typedArray,
+                        i,
+                        (int64_t)bits);
+                }
+                else
+                {
+                    memcpy(&real, &bits, sizeof(real));
+                    octaspire_dern_typed_array_set_real_at(result->value.typedArray, i, real);
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SPECIAL:
+        {
+            record->hasDocumentation = false;
+
+            return octaspire_dern_image_private_find_by_name(
+                self,
+                (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BUILTIN) ?
+                    OCTASPIRE_DERN_VALUE_TAG_BUILTIN :
+                    OCTASPIRE_DERN_VALUE_TAG_SPECIAL);
+        }
+    }
+
+    uint8_t howtoAllowed = 0;
+
+    if (!result ||
+        !octaspire_dern_image_private_pop_front_ref(self, &(record->docstr)) ||
+        !octaspire_dern_image_private_pop_front_ref(self, &(record->docvec)) ||
+        !octaspire_dern_image_private_pop_front_octet(self, &howtoAllowed))
+    {
+        return 0;
+    }
+
+    record->howtoAllowed = (howtoAllowed != 0);
+    return result;
+}
+
+static bool octaspire_dern_image_private_is_ref_of_type(
+    octaspire_dern_value_t const * const value,
+    octaspire_dern_value_tag_t const typeTag)
+{
+    return !value || value->typeTag == typeTag;
+}
+
+// Checks the references that the VM expects to be of some type, before
+// anything is restored into the global environment.
+static bool octaspire_dern_image_private_check_refs(
+    octaspire_dern_image_private_reader_t const * const self)
+{
+    for (size_t i = 0; i < self->numValues; ++i)
+    {
+        octaspire_dern_image_private_record_t const * const record = &(self->records[i]);
+
+        if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT &&
+            !octaspire_dern_image_private_is_ref_of_type(
+                octaspire_dern_image_private_get_ref_at(self, record, 0),
+                OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT))
+        {
+            return false;
+        }
+
+        if ((record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION ||
+             record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_MACRO) &&
+            (!octaspire_dern_image_private_is_ref_of_type(
+                octaspire_dern_image_private_get_ref_at(self, record, 0),
+                OCTASPIRE_DERN_VALUE_TAG_VECTOR) ||
+             !octaspire_dern_image_private_is_ref_of_type(
+                octaspire_dern_image_private_get_ref_at(self, record, 2),
+                OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT)))
+        {
+            return false;
+        }
+
+        if (!octaspire_dern_image_private_is_ref_of_type(
+                octaspire_dern_image_private_get_ref(self, record->docstr),
+                OCTASPIRE_DERN_VALUE_TAG_STRING) ||
+            !octaspire_dern_image_private_is_ref_of_type(
+                octaspire_dern_image_private_get_ref(self, record->docvec),
+                OCTASPIRE_DERN_VALUE_TAG_VECTOR))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Fills containers that do not hash their elements and links functions
+// and environments.
+static bool octaspire_dern_image_private_fill_value(
+    octaspire_dern_image_private_reader_t const * const self,
+    size_t const index)
+{
+    octaspire_dern_image_private_record_t const * const record = &(self->records[index]);
+
+    octaspire_dern_value_t * const value = self->values[index];
+
+    switch ((octaspire_dern_image_private_tag_t)record->tag)
+    {
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_VECTOR:
+        {
+            for (size_t i = 0; i < record->numRefs; ++i)
+            {
+                octaspire_dern_value_t *element =
+                    octaspire_dern_image_private_get_ref_at(self, record, i);
+
+                if (!element || !octaspire_vector_push_back_element(value->value.vector, &element))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_QUEUE:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_LIST:
+        {
+            octaspire_dern_deque_t * const deque =
+                (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_QUEUE) ?
+                    value->value.queue :
+                    value->value.list;
+
+            for (size_t i = 0; i < record->numRefs; ++i)
+            {
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_image_private_get_ref_at(self, record, i);
+
+                if (!element || !octaspire_dern_deque_push_back(deque, element))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_ENVIRONMENT:
+        {
+            if (index > 0)
+            {
+                value->value.environment->enclosing =
+                    octaspire_dern_image_private_get_ref_at(self, record, 0);
+            }
+
+            for (size_t i = 1; i < record->numRefs; i += 2)
+            {
+                octaspire_dern_value_t const * const key =
+                    octaspire_dern_image_private_get_ref_at(self, record, i);
+
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_image_private_get_ref_at(self, record, i + 1);
+
+                if (!key || !element ||
+                    !octaspire_dern_environment_set(value->value.environment, key, element))
+                {
+                    return false;
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_MACRO:
+        {
+            value->value.function->formals =
+                octaspire_dern_image_private_get_ref_at(self, record, 0);
+
+            value->value.function->body =
+                octaspire_dern_image_private_get_ref_at(self, record, 1);
+
+            value->value.function->definitionEnvironment =
+                octaspire_dern_image_private_get_ref_at(self, record, 2);
+        }
+        break;
+
+        default:
+        {
+        }
+        break;
+    }
+
+    return true;
+}
+
+// Hash maps and sets hash their keys, so the keys must be complete
+// before they are put. Keys that are collections are copies owned by
+// the map, written after the map; filling the maps from the last one
+// completes such keys first.
+static bool octaspire_dern_image_private_fill_hashed_value(
+    octaspire_dern_image_private_reader_t const * const self,
+    size_t const index)
+{
+    octaspire_dern_image_private_record_t const * const record = &(self->records[index]);
+
+    octaspire_dern_value_t * const value = self->values[index];
+
+    if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_HASH_MAP)
+    {
+        if (!octaspire_dern_map_reserve(value->value.hashMap, record->numRefs / 2))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < record->numRefs; i += 2)
+        {
+            octaspire_dern_value_t * const key =
+                octaspire_dern_image_private_get_ref_at(self, record, i);
+
+            octaspire_dern_value_t * const element =
+                octaspire_dern_image_private_get_ref_at(self, record, i + 1);
+
+            if (!key || !element ||
+                !octaspire_dern_map_put(
+                    value->value.hashMap,
+                    octaspire_dern_value_get_hash(key),
+                    key,
+                    element))
+            {
+                return false;
+            }
+        }
+    }
+    else if (record->tag == OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SET)
+    {
+        for (size_t i = 0; i < record->numRefs; ++i)
+        {
+            octaspire_dern_value_t * const element =
+                octaspire_dern_image_private_get_ref_at(self, record, i);
+
+            // Elements of sets have no values.
+            if (!element ||
+                !octaspire_dern_map_put(
+                    value->value.set,
+                    octaspire_dern_value_get_hash(element),
+                    element,
+                    0))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static octaspire_dern_value_t *octaspire_dern_image_private_load_libraries(
+    octaspire_dern_image_private_reader_t * const self)
+{
+    octaspire_dern_vm_t * const vm = self->vm;
+
+    size_t numLibraries = 0;
+
+    if (!octaspire_dern_image_private_pop_front_count(self, &numLibraries))
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < numLibraries; ++i)
+    {
+        octaspire_string_t *name     = octaspire_dern_image_private_pop_front_string(self);
+        uint8_t             isBinary = 0;
+
+        if (!name || !octaspire_dern_image_private_pop_front_octet(self, &isBinary))
+        {
+            octaspire_string_release(name);
+            name = 0;
+            return 0;
+        }
+
+        octaspire_dern_value_t *result = octaspire_dern_vm_get_value_true(vm);
+
+        if (octaspire_dern_vm_has_library(vm, octaspire_string_get_c_string(name)))
+        {
+            // NOP
+        }
+        else if (isBinary)
+        {
+            // Binary libraries are opened again; they register their
+            // builtins before the builtins of the image are looked up.
+            octaspire_dern_value_t * const arguments =
+                octaspire_dern_vm_create_new_value_vector(vm);
+
+            octaspire_dern_value_t *symbol = octaspire_dern_vm_create_new_value_symbol(
+                vm,
+                octaspire_string_new_copy(name, octaspire_dern_vm_get_allocator(vm)));
+
+            octaspire_dern_value_as_vector_push_back_element(arguments, &symbol);
+
+            result = octaspire_dern_vm_builtin_require(
+                vm,
+                arguments,
+                octaspire_dern_vm_get_global_environment(vm));
+        }
+        else
+        {
+            // Definitions of source libraries are in the image.
+            octaspire_dern_lib_t * const lib = octaspire_dern_lib_new_source_from_image(
+                octaspire_string_get_c_string(name),
+                vm,
+                octaspire_dern_vm_get_allocator(vm));
+
+            if (!lib || !octaspire_dern_vm_add_library(vm, octaspire_string_get_c_string(name), lib))
+            {
+                octaspire_dern_lib_release(lib);
+
+                result = octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Library '%s' cannot be added.",
+                    octaspire_string_get_c_string(name));
+            }
+        }
+
+        octaspire_string_release(name);
+        name = 0;
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            return result;
+        }
+    }
+
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+static octaspire_dern_value_t *octaspire_dern_image_private_load(
+    octaspire_dern_image_private_reader_t * const self,
+    char const * const path)
+{
+    octaspire_dern_vm_t * const vm = self->vm;
+
+    uint64_t    formatVersion = 0;
+    char const *version       = 0;
+    size_t      versionLength = 0;
+    uint64_t    bodyHash      = 0;
+
+    if (self->length < sizeof(octaspire_dern_image_private_magic) ||
+        memcmp(
+            self->octets,
+            octaspire_dern_image_private_magic,
+            sizeof(octaspire_dern_image_private_magic)) != 0)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "File '%s' is not an image.",
+            path);
+    }
+
+    self->index = sizeof(octaspire_dern_image_private_magic);
+
+    // Builtins and the values they expect can change between versions.
+    if (!octaspire_dern_image_private_pop_front_number(self, &formatVersion) ||
+        formatVersion != OCTASPIRE_DERN_IMAGE_PRIVATE_FORMAT_VERSION ||
+        !octaspire_dern_image_private_pop_front_text(self, &version, &versionLength) ||
+        versionLength != strlen(octaspire_dern_image_private_version) ||
+        memcmp(version, octaspire_dern_image_private_version, versionLength) != 0)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Image '%s' was saved by another version of Dern.",
+            path);
+    }
+
+    // Image is checked as a whole, so that a damaged image is noticed
+    // before anything is restored.
+    if (!octaspire_dern_image_private_pop_front_fixed(self, &bodyHash) ||
+        bodyHash != octaspire_dern_image_private_hash(
+            self->octets + self->index,
+            self->length - self->index))
+    {
+        return 0;
+    }
+
+    octaspire_dern_value_t *result = octaspire_dern_image_private_load_libraries(self);
+
+    if (!result || result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+    {
+        return result;
+    }
+
+    if (!octaspire_dern_image_private_pop_front_count(self, &(self->numValues)) ||
+        self->numValues == 0)
+    {
+        return 0;
+    }
+
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
+
+    self->values = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_value_t*) * self->numValues);
+
+    self->records = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_image_private_record_t) * self->numValues);
+
+    if (!self->values || !self->records)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < self->numValues; ++i)
+    {
+        self->values[i] = octaspire_dern_image_private_create_value(self, i);
+
+        if (!self->values[i] ||
+            (self->values[i]->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR &&
+             self->records[i].tag != OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_BUILTIN &&
+             self->records[i].tag != OCTASPIRE_DERN_IMAGE_PRIVATE_TAG_SPECIAL))
+        {
+            return 0;
+        }
+
+        if (self->values[i]->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            return self->values[i];
+        }
+    }
+
+    if (self->index != self->length || !octaspire_dern_image_private_check_refs(self))
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < self->numValues; ++i)
+    {
+        if (!octaspire_dern_image_private_fill_value(self, i))
+        {
+            return 0;
+        }
+    }
+
+    for (size_t i = self->numValues; i > 0; --i)
+    {
+        if (!octaspire_dern_image_private_fill_hashed_value(self, i - 1))
+        {
+            return 0;
+        }
+    }
+
+    for (size_t i = 0; i < self->numValues; ++i)
+    {
+        octaspire_dern_image_private_record_t const * const record = &(self->records[i]);
+
+        if (record->hasDocumentation)
+        {
+            self->values[i]->docstr = octaspire_dern_image_private_get_ref(self, record->docstr);
+            self->values[i]->docvec = octaspire_dern_image_private_get_ref(self, record->docvec);
+            self->values[i]->howtoAllowed = record->howtoAllowed;
+        }
+    }
+
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_image_load(
+    octaspire_dern_vm_t * const vm,
+    char const * const path)
+{
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
+
+    size_t length = 0;
+
+    char *buffer = octaspire_helpers_path_to_buffer(
+        path,
+        &length,
+        allocator,
+        octaspire_dern_vm_get_stdio(vm));
+
+    if (!buffer)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Image '%s' cannot be read.",
+            path);
+    }
+
+    octaspire_dern_image_private_reader_t reader;
+
+    reader.vm        = vm;
+    reader.octets    = buffer;
+    reader.length    = length;
+    reader.index     = 0;
+    reader.values    = 0;
+    reader.records   = 0;
+    reader.numValues = 0;
+    reader.refs      = octaspire_vector_new(sizeof(size_t), false, 0, allocator);
+
+    // Values are not reachable from the global environment before the
+    // containers referring to them are filled.
+    bool const preventedGc = octaspire_dern_vm_get_prevent_gc(vm);
+    octaspire_dern_vm_set_prevent_gc(vm, true);
+
+    octaspire_dern_value_t *result =
+        reader.refs ? octaspire_dern_image_private_load(&reader, path) : 0;
+
+    if (!result)
+    {
+        result = octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Image '%s' is damaged.",
+            path);
+    }
+
+    octaspire_dern_vm_set_prevent_gc(vm, preventedGc);
+
+    if (reader.records)
+    {
+        octaspire_allocator_free(allocator, reader.records);
+        reader.records = 0;
+    }
+
+    if (reader.values)
+    {
+        octaspire_allocator_free(allocator, reader.values);
+        reader.values = 0;
+    }
+
+    octaspire_vector_release(reader.refs);
+    reader.refs = 0;
+
+    octaspire_allocator_free(allocator, buffer);
+    buffer = 0;
+
+    return result;
+}
+
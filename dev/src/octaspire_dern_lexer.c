@@ -952,6 +952,105 @@ void octaspire_dern_lexer_token_print(
     str = 0;
 }
 
+// Classes of ASCII characters are looked up from a table, so that the
+// common case is a single load instead of calls to 'isspace' and a chain
+// of comparisons. Characters outside of ASCII are never white space or
+// delimiters.
+#define OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE     0x01
+#define OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER 0x02
+
+static uint8_t const octaspire_dern_lexer_private_ascii_classes[128] =
+{
+    ['\t'] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['\n'] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['\v'] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['\f'] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['\r'] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    [' ']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE | OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['|']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['[']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    [']']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['(']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    [')']  = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER,
+    ['\''] = OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER
+};
+
+static bool octaspire_dern_lexer_private_is_space(uint32_t const c)
+{
+    return c < 128 &&
+        (octaspire_dern_lexer_private_ascii_classes[c] & OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_SPACE);
+}
+
+// Text of a string or symbol token. ASCII text is collected as octets
+// into the fixed buffer, without allocating or decoding anything. The
+// text is moved into a string only when it has other characters or
+// does not fit into the buffer.
+#define OCTASPIRE_DERN_LEXER_PRIVATE_TEXT_BUFFER_LENGTH 64
+
+typedef struct octaspire_dern_lexer_private_text_t
+{
+    octaspire_allocator_t *allocator;
+    octaspire_string_t    *string;
+    size_t                 numOctets;
+    char                   octets[OCTASPIRE_DERN_LEXER_PRIVATE_TEXT_BUFFER_LENGTH];
+}
+octaspire_dern_lexer_private_text_t;
+
+static void octaspire_dern_lexer_private_text_init(
+    octaspire_dern_lexer_private_text_t * const self,
+    octaspire_allocator_t * const allocator)
+{
+    self->allocator = allocator;
+    self->string    = 0;
+    self->numOctets = 0;
+    self->octets[0] = '\0';
+}
+
+static void octaspire_dern_lexer_private_text_release(
+    octaspire_dern_lexer_private_text_t * const self)
+{
+    octaspire_string_release(self->string);
+    self->string = 0;
+}
+
+static bool octaspire_dern_lexer_private_text_push_back_ucs_character(
+    octaspire_dern_lexer_private_text_t * const self,
+    uint32_t const c)
+{
+    if (!self->string)
+    {
+        if (c > 0 && c < 128 &&
+            self->numOctets < (OCTASPIRE_DERN_LEXER_PRIVATE_TEXT_BUFFER_LENGTH - 1))
+        {
+            self->octets[self->numOctets] = (char)c;
+            ++(self->numOctets);
+            self->octets[self->numOctets] = '\0';
+            return true;
+        }
+
+        self->string = octaspire_string_new(self->octets, self->allocator);
+
+        if (!self->string)
+        {
+            return false;
+        }
+    }
+
+    return octaspire_string_push_back_ucs_character(self->string, c);
+}
+
+static bool octaspire_dern_lexer_private_text_is_empty(
+    octaspire_dern_lexer_private_text_t const * const self)
+{
+    return self->string ? octaspire_string_is_empty(self->string) : (self->numOctets == 0);
+}
+
+static char const *octaspire_dern_lexer_private_text_get_c_string(
+    octaspire_dern_lexer_private_text_t const * const self)
+{
+    return self->string ? octaspire_string_get_c_string(self->string) : self->octets;
+}
+
 void octaspire_dern_lexer_private_pop_whitespace(
     octaspire_input_t *input)
 {
@@ -959,7 +1058,7 @@ void octaspire_dern_lexer_private_pop_whitespace(
     {
         uint32_t const c = octaspire_input_peek_next_ucs_character(input);
 
-        if (!isspace((int const)c))
+        if (!octaspire_dern_lexer_private_is_space(c))
         {
             break;
         }
@@ -1129,16 +1228,8 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_multiline_comment
 
 bool octaspire_dern_lexer_private_is_delimeter(uint32_t const c)
 {
-    return (
-        isspace(c) ||
-        c == '|'   ||
-        c == '['   ||
-        c == ']'   ||
-        c == '('   ||
-        c == ')'   ||
-        c == '\''  ||
-        c == '\n'
-    );
+    return c < 128 &&
+        (octaspire_dern_lexer_private_ascii_classes[c] & OCTASPIRE_DERN_LEXER_PRIVATE_CLASS_DELIMITER);
 }
 
 octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_left_parenthesis(
@@ -2109,23 +2200,8 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
 
     size_t   endIndexInInput = startIndexInInput;
 
-    octaspire_string_t *tmpStr =
-        octaspire_string_new("", allocator);
-
-    if (!tmpStr)
-    {
-        return octaspire_dern_lexer_token_new(
-            OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
-            "Memory allocation failed",
-            octaspire_dern_lexer_token_position_init(
-                startLine,
-                octaspire_input_get_line_number(input)),
-            octaspire_dern_lexer_token_position_init(
-                startColumn,
-                octaspire_input_get_column_number(input)),
-            octaspire_dern_lexer_token_position_init(startIndexInInput, endIndexInInput),
-            allocator);
-    }
+    octaspire_dern_lexer_private_text_t text;
+    octaspire_dern_lexer_private_text_init(&text, allocator);
 
     while (octaspire_input_is_good(input))
     {
@@ -2142,8 +2218,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
             }
             else
             {
-                octaspire_string_release(tmpStr);
-                tmpStr = 0;
+                octaspire_dern_lexer_private_text_release(&text);
 
                 return octaspire_dern_lexer_token_new(
                     OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2166,8 +2241,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
             }
             else
             {
-                octaspire_string_release(tmpStr);
-                tmpStr = 0;
+                octaspire_dern_lexer_private_text_release(&text);
 
                 return octaspire_dern_lexer_token_new(
                     OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2200,8 +2274,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
 
                 if (!charToken)
                 {
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+                    octaspire_dern_lexer_private_text_release(&text);
 
                     return octaspire_dern_lexer_token_new(
                         OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2220,8 +2293,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
                 if (octaspire_dern_lexer_token_get_type_tag(charToken) ==
                     OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR)
                 {
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+                    octaspire_dern_lexer_private_text_release(&text);
 
                     octaspire_dern_lexer_token_t *result = octaspire_dern_lexer_token_new_format(
                         OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2249,10 +2321,9 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
                     charToken->value.character,
                     0);
 
-                if (!octaspire_string_push_back_ucs_character(tmpStr, c))
+                if (!octaspire_dern_lexer_private_text_push_back_ucs_character(&text, c))
                 {
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+                    octaspire_dern_lexer_private_text_release(&text);
 
                     octaspire_dern_lexer_token_release(charToken);
                     charToken = 0;
@@ -2280,10 +2351,9 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_string(
             }
             else
             {
-                if (!octaspire_string_push_back_ucs_character(tmpStr, c))
+                if (!octaspire_dern_lexer_private_text_push_back_ucs_character(&text, c))
                 {
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+                    octaspire_dern_lexer_private_text_release(&text);
 
                     return octaspire_dern_lexer_token_new(
                         OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2313,8 +2383,7 @@ loopEnd:
 
     if (!lastDelimiterRead)
     {
-        octaspire_string_release(tmpStr);
-        tmpStr = 0;
+        octaspire_dern_lexer_private_text_release(&text);
 
         if (!octaspire_input_is_good(input))
         {
@@ -2336,7 +2405,7 @@ loopEnd:
 
     octaspire_dern_lexer_token_t *result = octaspire_dern_lexer_token_new(
         OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING,
-        octaspire_string_get_c_string(tmpStr),
+        octaspire_dern_lexer_private_text_get_c_string(&text),
         octaspire_dern_lexer_token_position_init(
             startLine,
             octaspire_input_get_line_number(input)),
@@ -2348,8 +2417,7 @@ loopEnd:
             endIndexInInput),
         allocator);
 
-    octaspire_string_release(tmpStr);
-    tmpStr = 0;
+    octaspire_dern_lexer_private_text_release(&text);
 
     return result;
 }
@@ -2731,23 +2799,8 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
 
     size_t   endIndexInInput = startIndexInInput;
 
-    octaspire_string_t *tmpStr =
-        octaspire_string_new("", allocator);
-
-    if (!tmpStr)
-    {
-        return octaspire_dern_lexer_token_new(
-            OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
-            "Memory allocation failed",
-            octaspire_dern_lexer_token_position_init(
-                startLine,
-                octaspire_input_get_line_number(input)),
-            octaspire_dern_lexer_token_position_init(
-                startColumn,
-                octaspire_input_get_column_number(input)),
-            octaspire_dern_lexer_token_position_init(startIndexInInput, endIndexInInput),
-            allocator);
-    }
+    octaspire_dern_lexer_private_text_t text;
+    octaspire_dern_lexer_private_text_init(&text, allocator);
 
     while (octaspire_input_is_good(input))
     {
@@ -2761,10 +2814,9 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
             break;
         }
 
-        if (!octaspire_string_push_back_ucs_character(tmpStr, c))
+        if (!octaspire_dern_lexer_private_text_push_back_ucs_character(&text, c))
         {
-            octaspire_string_release(tmpStr);
-            tmpStr = 0;
+            octaspire_dern_lexer_private_text_release(&text);
 
             return octaspire_dern_lexer_token_new(
                 OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2787,10 +2839,9 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
         ++charsRead;
     }
 
-    if (octaspire_string_is_empty(tmpStr))
+    if (octaspire_dern_lexer_private_text_is_empty(&text))
     {
-            octaspire_string_release(tmpStr);
-            tmpStr = 0;
+            octaspire_dern_lexer_private_text_release(&text);
 
             return octaspire_dern_lexer_token_new(
                 OCTASPIRE_DERN_LEXER_TOKEN_TAG_ERROR,
@@ -2807,7 +2858,9 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
 
     octaspire_dern_lexer_token_t *result = 0;
 
-    if (octaspire_string_is_equal_to_c_string(tmpStr, "true"))
+    char const * const value = octaspire_dern_lexer_private_text_get_c_string(&text);
+
+    if (strcmp(value, "true") == 0)
     {
         result = octaspire_dern_lexer_token_new(
             OCTASPIRE_DERN_LEXER_TOKEN_TAG_TRUE,
@@ -2823,7 +2876,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
                 endIndexInInput),
             allocator);
     }
-    else if (octaspire_string_is_equal_to_c_string(tmpStr, "false"))
+    else if (strcmp(value, "false") == 0)
     {
         result = octaspire_dern_lexer_token_new(
             OCTASPIRE_DERN_LEXER_TOKEN_TAG_FALSE,
@@ -2839,7 +2892,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
                 endIndexInInput),
             allocator);
     }
-    else if (octaspire_string_is_equal_to_c_string(tmpStr, "nil"))
+    else if (strcmp(value, "nil") == 0)
     {
         result = octaspire_dern_lexer_token_new(
             OCTASPIRE_DERN_LEXER_TOKEN_TAG_NIL,
@@ -2859,7 +2912,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
     {
         result = octaspire_dern_lexer_token_new(
             OCTASPIRE_DERN_LEXER_TOKEN_TAG_SYMBOL,
-            octaspire_string_get_c_string(tmpStr),
+            value,
             octaspire_dern_lexer_token_position_init(
                 startLine,
                 octaspire_input_get_line_number(input)),
@@ -2872,8 +2925,7 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_private_pop_true_or_false_or_
             allocator);
     }
 
-    octaspire_string_release(tmpStr);
-    tmpStr = 0;
+    octaspire_dern_lexer_private_text_release(&text);
 
     return result;
 }
@@ -3069,3 +3121,98 @@ octaspire_dern_lexer_token_t *octaspire_dern_lexer_pop_next_token(
     return 0;
 }
 
+void octaspire_dern_lexer_pop_whitespace_and_line_comments(
+    octaspire_input_t *input)
+{
+    while (octaspire_input_is_good(input))
+    {
+        octaspire_dern_lexer_private_pop_whitespace(input);
+
+        if (octaspire_input_peek_next_ucs_character(input) != ';')
+        {
+            return;
+        }
+
+        octaspire_dern_lexer_private_pop_rest_of_line(input);
+    }
+}
+
+bool octaspire_dern_lexer_is_symbol_next(
+    octaspire_input_t *input)
+{
+    if (!octaspire_input_is_good(input))
+    {
+        return false;
+    }
+
+    uint32_t const c = octaspire_input_peek_next_ucs_character(input);
+
+    switch (c)
+    {
+        case ';':
+        case '`':
+        case '{':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+        {
+            return false;
+        }
+
+        case '#':
+        {
+            return octaspire_input_peek_next_next_ucs_character(input) != '!';
+        }
+
+        default:
+        {
+            // Symbol cannot start with a delimiter; the lexer reports it
+            // as an error.
+            return c != 0 && !octaspire_dern_lexer_private_is_delimeter(c);
+        }
+    }
+}
+
+octaspire_string_t *octaspire_dern_lexer_pop_symbol_text(
+    octaspire_input_t *input,
+    octaspire_allocator_t *allocator)
+{
+    octaspire_dern_lexer_private_text_t text;
+    octaspire_dern_lexer_private_text_init(&text, allocator);
+
+    while (octaspire_input_is_good(input))
+    {
+        uint32_t const c = octaspire_input_peek_next_ucs_character(input);
+
+        if (octaspire_dern_lexer_private_is_delimeter(c))
+        {
+            break;
+        }
+
+        if (!octaspire_dern_lexer_private_text_push_back_ucs_character(&text, c))
+        {
+            octaspire_dern_lexer_private_text_release(&text);
+            return 0;
+        }
+
+        if (!octaspire_input_pop_next_ucs_character(input))
+        {
+            abort();
+        }
+    }
+
+    if (text.string)
+    {
+        return text.string;
+    }
+
+    return octaspire_string_new(text.octets, allocator);
+}
+
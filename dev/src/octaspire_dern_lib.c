@@ -23,6 +23,7 @@ limitations under the License.
     #include <octaspire/core/octaspire_helpers.h>
 #endif
 
+#include "octaspire/dern/octaspire_dern_helpers.h"
 #include "octaspire/dern/octaspire_dern_vm.h"
 #include "octaspire/dern/octaspire_dern_config.h"
 
@@ -52,9 +53,8 @@ struct octaspire_dern_lib_t
     char                     padding[4];
 };
 
-octaspire_dern_lib_t *octaspire_dern_lib_new_source(
+static octaspire_dern_lib_t *octaspire_dern_lib_private_new_source(
     char const * const name,
-    octaspire_input_t * const input,
     octaspire_dern_vm_t *vm,
     octaspire_allocator_t *allocator)
 {
@@ -80,23 +80,74 @@ octaspire_dern_lib_t *octaspire_dern_lib_new_source(
     self->libMarkFunc = 0;
 #endif
 
-    octaspire_dern_value_t *value =
-        octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(vm, input);
-
-    octaspire_helpers_verify_not_null(value);
+    return self;
+}
 
-    if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+static void octaspire_dern_lib_private_set_source_result(
+    octaspire_dern_lib_t * const self,
+    octaspire_dern_value_t const * const value)
+{
+    // Source without any forms results in null.
+    if (value && value->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
     {
         self->errorMessage =
-            octaspire_string_new_copy(value->value.error->message,
+            octaspire_dern_helpers_copy_string(value->value.error->message,
                                       self->allocator);
 
         octaspire_helpers_verify_not_null(self->errorMessage);
     }
+}
+
+octaspire_dern_lib_t *octaspire_dern_lib_new_source(
+    char const * const name,
+    octaspire_input_t * const input,
+    octaspire_dern_vm_t *vm,
+    octaspire_allocator_t *allocator)
+{
+    octaspire_dern_lib_t *self =
+        octaspire_dern_lib_private_new_source(name, vm, allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    octaspire_dern_lib_private_set_source_result(
+        self,
+        octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(vm, input));
 
     return self;
 }
 
+octaspire_dern_lib_t *octaspire_dern_lib_new_source_from_reader(
+    char const * const name,
+    octaspire_dern_reader_t * const reader,
+    octaspire_dern_vm_t *vm,
+    octaspire_allocator_t *allocator)
+{
+    octaspire_dern_lib_t *self =
+        octaspire_dern_lib_private_new_source(name, vm, allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    octaspire_dern_lib_private_set_source_result(
+        self,
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader));
+
+    return self;
+}
+
+octaspire_dern_lib_t *octaspire_dern_lib_new_source_from_image(
+    char const * const name,
+    octaspire_dern_vm_t *vm,
+    octaspire_allocator_t *allocator)
+{
+    return octaspire_dern_lib_private_new_source(name, vm, allocator);
+}
+
 #ifdef _WIN32
 static char const *octaspire_dern_lib_private_format_win32_error_message(void)
 {
@@ -681,6 +732,16 @@ bool octaspire_dern_lib_is_good(octaspire_dern_lib_t const * const self)
     return (self->errorMessage == 0);
 }
 
+bool octaspire_dern_lib_is_binary(octaspire_dern_lib_t const * const self)
+{
+    return (self->typeTag == OCTASPIRE_DERN_LIB_TAG_BINARY);
+}
+
+char const *octaspire_dern_lib_get_name(octaspire_dern_lib_t const * const self)
+{
+    return octaspire_string_get_c_string(self->name);
+}
+
 char const *octaspire_dern_lib_get_error_message(octaspire_dern_lib_t const * const self)
 {
     if (!self->errorMessage)
@@ -0,0 +1,433 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_loader.h"
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+    #include <octaspire/core/octaspire_string.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_reader.h"
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif
+
+typedef struct octaspire_dern_loader_private_job_t
+{
+    octaspire_string_t    *path;
+    octaspire_dern_fasl_t *fasl;
+    bool                   isLoadedFromCache;
+    bool                   isClaimed;
+    bool                   isDone;
+    char                   padding[5];
+}
+octaspire_dern_loader_private_job_t;
+
+struct octaspire_dern_loader_t
+{
+    octaspire_allocator_t               *allocator;
+    octaspire_allocator_t               *readAllocator;
+    octaspire_stdio_t                   *readStdio;
+    octaspire_string_t                  *faslCacheDirectory;
+    octaspire_dern_loader_private_job_t *jobs;
+    size_t                               numJobs;
+    size_t                               nextJob;
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+    pthread_mutex_t                      mutex;
+    pthread_cond_t                       jobIsDone;
+    pthread_t                           *workers;
+    size_t                               numWorkers;
+#endif
+#endif
+    bool                                 faslCacheOn;
+    bool                                 isCancelled;
+    char                                 padding[6];
+};
+
+// Does not touch the loader itself, so that jobs can be read without
+// holding the lock.
+static void octaspire_dern_loader_private_read(
+    octaspire_dern_loader_t const * const self,
+    octaspire_dern_loader_private_job_t * const job)
+{
+    char const * const path = octaspire_string_get_c_string(job->path);
+
+    octaspire_dern_fasl_t *fasl = octaspire_dern_fasl_new(
+        path,
+        self->faslCacheDirectory ?
+            octaspire_string_get_c_string(self->faslCacheDirectory) :
+            0,
+        self->readStdio,
+        self->readAllocator);
+
+    if (!fasl)
+    {
+        return;
+    }
+
+    if (self->faslCacheOn && octaspire_dern_fasl_load(fasl))
+    {
+        job->fasl              = fasl;
+        job->isLoadedFromCache = true;
+        return;
+    }
+
+    octaspire_dern_reader_t *reader =
+        octaspire_dern_reader_new_from_path(path, self->readStdio, self->readAllocator);
+
+    bool isGood = (reader != 0);
+
+    while (isGood && octaspire_dern_reader_read_next_form(reader))
+    {
+        isGood = octaspire_dern_fasl_push_back_source_form(
+            fasl,
+            octaspire_dern_reader_get_form_octets(reader),
+            octaspire_dern_reader_get_form_length_in_octets(reader),
+            octaspire_dern_reader_get_form_line_number(reader));
+    }
+
+    isGood = isGood &&
+        !octaspire_dern_reader_has_error(reader) &&
+        octaspire_dern_reader_get_number_of_octets_read(reader) > 0;
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    if (!isGood)
+    {
+        octaspire_dern_fasl_release(fasl);
+        fasl = 0;
+        return;
+    }
+
+    octaspire_dern_fasl_load_added_forms(fasl);
+    job->fasl = fasl;
+}
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+// Returns the first job that no one has claimed, or null if there are
+// none left. Called with the lock held.
+static octaspire_dern_loader_private_job_t *octaspire_dern_loader_private_claim_next_job(
+    octaspire_dern_loader_t * const self)
+{
+    // The waiting thread can claim a job ahead of the others.
+    while (self->nextJob < self->numJobs && self->jobs[self->nextJob].isClaimed)
+    {
+        ++(self->nextJob);
+    }
+
+    if (self->isCancelled || self->nextJob >= self->numJobs)
+    {
+        return 0;
+    }
+
+    octaspire_dern_loader_private_job_t * const job = &(self->jobs[self->nextJob]);
+    job->isClaimed = true;
+    ++(self->nextJob);
+    return job;
+}
+
+// Called with the lock held; the lock is released while reading.
+static void octaspire_dern_loader_private_read_claimed_job(
+    octaspire_dern_loader_t * const self,
+    octaspire_dern_loader_private_job_t * const job)
+{
+    pthread_mutex_unlock(&(self->mutex));
+    octaspire_dern_loader_private_read(self, job);
+    pthread_mutex_lock(&(self->mutex));
+
+    job->isDone = true;
+    pthread_cond_broadcast(&(self->jobIsDone));
+}
+
+static void *octaspire_dern_loader_private_work(void *arg)
+{
+    octaspire_dern_loader_t * const self = arg;
+
+    pthread_mutex_lock(&(self->mutex));
+
+    octaspire_dern_loader_private_job_t *job = 0;
+
+    while ((job = octaspire_dern_loader_private_claim_next_job(self)))
+    {
+        octaspire_dern_loader_private_read_claimed_job(self, job);
+    }
+
+    pthread_mutex_unlock(&(self->mutex));
+    return 0;
+}
+#endif
+#endif
+
+octaspire_dern_loader_t *octaspire_dern_loader_new(
+    char const * const * const paths,
+    size_t const numPaths,
+    bool const faslCacheOn,
+    char const * const faslCacheDirectory,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_loader_t *self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_loader_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->allocator          = allocator;
+    self->readAllocator      = 0;
+    self->readStdio          = 0;
+    self->faslCacheDirectory = 0;
+    self->jobs               = 0;
+    self->numJobs            = 0;
+    self->nextJob            = 0;
+    self->faslCacheOn        = faslCacheOn;
+    self->isCancelled        = false;
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+    self->workers            = 0;
+    self->numWorkers         = 0;
+
+    pthread_mutex_init(&(self->mutex), 0);
+    pthread_cond_init(&(self->jobIsDone), 0);
+#endif
+#endif
+
+    // Files are read on the worker threads with an allocator and stdio
+    // of their own. Those are never rigged, so they have no state that
+    // changes, and their allocations go to the thread safe malloc of C.
+    // Strings used by the workers are allocated with them too.
+    self->readAllocator = octaspire_allocator_new(0);
+
+    if (!self->readAllocator)
+    {
+        octaspire_dern_loader_release(self);
+        return 0;
+    }
+
+    self->readStdio = octaspire_stdio_new(self->readAllocator);
+
+    if (!self->readStdio)
+    {
+        octaspire_dern_loader_release(self);
+        return 0;
+    }
+
+    if (faslCacheDirectory)
+    {
+        self->faslCacheDirectory =
+            octaspire_string_new(faslCacheDirectory, self->readAllocator);
+
+        if (!self->faslCacheDirectory)
+        {
+            octaspire_dern_loader_release(self);
+            return 0;
+        }
+
+        // Octets of strings are encoded when they are first asked for,
+        // so they are encoded here before many threads ask for them.
+        octaspire_string_get_c_string(self->faslCacheDirectory);
+    }
+
+    if (numPaths > 0)
+    {
+        self->jobs = octaspire_allocator_malloc(
+            allocator,
+            sizeof(octaspire_dern_loader_private_job_t) * numPaths);
+
+        if (!self->jobs)
+        {
+            octaspire_dern_loader_release(self);
+            return 0;
+        }
+    }
+
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        octaspire_dern_loader_private_job_t * const job = &(self->jobs[i]);
+
+        job->path              = octaspire_string_new(paths[i], self->readAllocator);
+        job->fasl              = 0;
+        job->isLoadedFromCache = false;
+        job->isClaimed         = false;
+        job->isDone            = false;
+
+        if (!job->path)
+        {
+            octaspire_dern_loader_release(self);
+            return 0;
+        }
+
+        octaspire_string_get_c_string(job->path);
+        ++(self->numJobs);
+    }
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+    // The thread waiting for the forms reads files too.
+    long const numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    size_t numWorkers = (numProcessors > 1) ? (size_t)(numProcessors - 1) : 0;
+
+    if (numWorkers > numPaths)
+    {
+        numWorkers = numPaths;
+    }
+
+    if (numWorkers > 0)
+    {
+        self->workers = octaspire_allocator_malloc(allocator, sizeof(pthread_t) * numWorkers);
+    }
+
+    for (size_t i = 0; self->workers && i < numWorkers; ++i)
+    {
+        if (pthread_create(
+                &(self->workers[i]),
+                0,
+                octaspire_dern_loader_private_work,
+                self) != 0)
+        {
+            break;
+        }
+
+        ++(self->numWorkers);
+    }
+#endif
+#endif
+
+    return self;
+}
+
+void octaspire_dern_loader_release(octaspire_dern_loader_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+    pthread_mutex_lock(&(self->mutex));
+    self->isCancelled = true;
+    pthread_mutex_unlock(&(self->mutex));
+
+    for (size_t i = 0; i < self->numWorkers; ++i)
+    {
+        pthread_join(self->workers[i], 0);
+    }
+
+    if (self->workers)
+    {
+        octaspire_allocator_free(self->allocator, self->workers);
+        self->workers = 0;
+    }
+
+    pthread_cond_destroy(&(self->jobIsDone));
+    pthread_mutex_destroy(&(self->mutex));
+#endif
+#endif
+
+    for (size_t i = 0; i < self->numJobs; ++i)
+    {
+        octaspire_string_release(self->jobs[i].path);
+        octaspire_dern_fasl_release(self->jobs[i].fasl);
+    }
+
+    if (self->jobs)
+    {
+        octaspire_allocator_free(self->allocator, self->jobs);
+    }
+
+    octaspire_string_release(self->faslCacheDirectory);
+
+    // Paths and forms were allocated with the allocator of the loader.
+    octaspire_stdio_release(self->readStdio);
+    octaspire_allocator_release(self->readAllocator);
+
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_loader_get_number_of_paths(
+    octaspire_dern_loader_t const * const self)
+{
+    return self->numJobs;
+}
+
+char const *octaspire_dern_loader_get_path_at(
+    octaspire_dern_loader_t const * const self,
+    size_t const index)
+{
+    octaspire_helpers_verify_true(index < self->numJobs);
+    return octaspire_string_get_c_string(self->jobs[index].path);
+}
+
+octaspire_dern_fasl_t *octaspire_dern_loader_wait_for_forms(
+    octaspire_dern_loader_t * const self,
+    size_t const index,
+    bool * const isLoadedFromCache)
+{
+    octaspire_helpers_verify_true(index < self->numJobs);
+
+    octaspire_dern_loader_private_job_t * const job = &(self->jobs[index]);
+
+#ifdef OCTASPIRE_DERN_CONFIG_THREADS
+#ifndef _WIN32
+    pthread_mutex_lock(&(self->mutex));
+
+    // A file that no worker has claimed yet is read here, instead of
+    // waiting for a worker to get to it.
+    if (!job->isClaimed)
+    {
+        job->isClaimed = true;
+        octaspire_dern_loader_private_read_claimed_job(self, job);
+    }
+
+    while (!job->isDone)
+    {
+        pthread_cond_wait(&(self->jobIsDone), &(self->mutex));
+    }
+
+    pthread_mutex_unlock(&(self->mutex));
+#else
+    if (!job->isDone)
+    {
+        octaspire_dern_loader_private_read(self, job);
+        job->isDone = true;
+    }
+#endif
+#else
+    if (!job->isDone)
+    {
+        octaspire_dern_loader_private_read(self, job);
+        job->isDone = true;
+    }
+#endif
+
+    *isLoadedFromCache = job->isLoadedFromCache;
+    return job->fasl;
+}
+
@@ -0,0 +1,848 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_map.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_value.h"
+
+// Maps of at most this many elements store them inside the map and
+// find keys by a linear search, without an index table.
+#define OCTASPIRE_DERN_MAP_SMALL_CAPACITY 8
+
+typedef struct octaspire_dern_map_private_slot_t
+{
+    // Index of the element in 'elements' plus one, or zero for empty slot.
+    uint32_t elementIndex;
+    uint32_t hash;
+}
+octaspire_dern_map_private_slot_t;
+
+struct octaspire_dern_map_t
+{
+    // Elements in insertion order. Removed elements have null key and
+    // stay as holes until the array is compacted.
+    octaspire_dern_map_element_t      *elements;
+
+    // Open addressing index into 'elements' kept in Robin Hood order,
+    // or null while the map is small.
+    octaspire_dern_map_private_slot_t *slots;
+
+    octaspire_allocator_t             *allocator;
+    size_t                             numElements;
+    size_t                             numUsedElements;
+    size_t                             elementCapacity;
+    size_t                             slotCapacity;
+    uint32_t                           shift;
+
+    // Keys that are mutable collections are hashed by their identity.
+    bool                               hashesCollectionKeysByIdentity;
+    char                               padding[3];
+    octaspire_dern_map_element_t       smallElements[OCTASPIRE_DERN_MAP_SMALL_CAPACITY];
+};
+
+static bool octaspire_dern_map_private_is_small(
+    octaspire_dern_map_t const * const self)
+{
+    return self->elements == self->smallElements;
+}
+
+static size_t octaspire_dern_map_private_get_preferred_slot(
+    octaspire_dern_map_t const * const self,
+    uint32_t const hash)
+{
+    // Fibonacci hashing spreads also hashes that differ only in high bits.
+    return (size_t)((uint32_t)(hash * UINT32_C(2654435769)) >> self->shift);
+}
+
+static size_t octaspire_dern_map_private_get_probe_length(
+    octaspire_dern_map_t const * const self,
+    size_t const slotIndex)
+{
+    return (slotIndex - octaspire_dern_map_private_get_preferred_slot(
+        self,
+        self->slots[slotIndex].hash)) & (self->slotCapacity - 1);
+}
+
+static uint32_t octaspire_dern_map_private_get_hash_for_key(
+    octaspire_dern_map_t const * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key)
+{
+    if (!self->hashesCollectionKeysByIdentity)
+    {
+        return hash;
+    }
+
+    switch (key->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+            return octaspire_helpers_calculate_hash_for_void_pointer_argument(key);
+
+        default:
+            return hash;
+    }
+}
+
+static void octaspire_dern_map_private_reset_to_small(
+    octaspire_dern_map_t * const self)
+{
+    memset(self->smallElements, 0, sizeof(self->smallElements));
+
+    self->elements        = self->smallElements;
+    self->slots           = 0;
+    self->numElements     = 0;
+    self->numUsedElements = 0;
+    self->elementCapacity = OCTASPIRE_DERN_MAP_SMALL_CAPACITY;
+    self->slotCapacity    = 0;
+    self->shift           = 0;
+}
+
+static ptrdiff_t octaspire_dern_map_private_find(
+    octaspire_dern_map_t const * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key,
+    size_t * const slotIndexOrNull)
+{
+    if (!self->slots)
+    {
+        for (size_t i = 0; i < self->numUsedElements; ++i)
+        {
+            octaspire_dern_map_element_t const * const element = &(self->elements[i]);
+
+            if (element->key &&
+                element->hash == hash &&
+                octaspire_dern_value_is_equal(element->key, key))
+            {
+                return (ptrdiff_t)i;
+            }
+        }
+
+        return -1;
+    }
+
+    size_t const mask        = self->slotCapacity - 1;
+    size_t       slotIndex   = octaspire_dern_map_private_get_preferred_slot(self, hash);
+    size_t       probeLength = 0;
+
+    while (true)
+    {
+        octaspire_dern_map_private_slot_t const * const slot = &(self->slots[slotIndex]);
+
+        // Empty slot, or an element closer to its preferred slot than
+        // the key would be: the key is not in the map.
+        if (!slot->elementIndex ||
+            octaspire_dern_map_private_get_probe_length(self, slotIndex) < probeLength)
+        {
+            return -1;
+        }
+
+        if (slot->hash == hash &&
+            octaspire_dern_value_is_equal(
+                self->elements[slot->elementIndex - 1].key,
+                key))
+        {
+            if (slotIndexOrNull)
+            {
+                *slotIndexOrNull = slotIndex;
+            }
+
+            return (ptrdiff_t)(slot->elementIndex - 1);
+        }
+
+        slotIndex = (slotIndex + 1) & mask;
+        ++probeLength;
+    }
+}
+
+static void octaspire_dern_map_private_insert_slot(
+    octaspire_dern_map_t * const self,
+    octaspire_dern_map_private_slot_t slot)
+{
+    size_t const mask        = self->slotCapacity - 1;
+    size_t       slotIndex   = octaspire_dern_map_private_get_preferred_slot(self, slot.hash);
+    size_t       probeLength = 0;
+
+    while (true)
+    {
+        if (!self->slots[slotIndex].elementIndex)
+        {
+            self->slots[slotIndex] = slot;
+            return;
+        }
+
+        size_t const otherProbeLength =
+            octaspire_dern_map_private_get_probe_length(self, slotIndex);
+
+        if (otherProbeLength < probeLength)
+        {
+            // Take the slot from the element that is closer to home.
+            octaspire_dern_map_private_slot_t const tmp = self->slots[slotIndex];
+            self->slots[slotIndex] = slot;
+            slot                   = tmp;
+            probeLength            = otherProbeLength;
+        }
+
+        slotIndex = (slotIndex + 1) & mask;
+        ++probeLength;
+    }
+}
+
+static void octaspire_dern_map_private_remove_slot(
+    octaspire_dern_map_t * const self,
+    size_t slotIndex)
+{
+    // Shift the following slots of the probe sequence one step back,
+    // so that lookups never need tombstones.
+    size_t const mask = self->slotCapacity - 1;
+
+    while (true)
+    {
+        size_t const nextIndex = (slotIndex + 1) & mask;
+
+        if (!self->slots[nextIndex].elementIndex ||
+            octaspire_dern_map_private_get_probe_length(self, nextIndex) == 0)
+        {
+            break;
+        }
+
+        self->slots[slotIndex] = self->slots[nextIndex];
+        slotIndex = nextIndex;
+    }
+
+    self->slots[slotIndex].elementIndex = 0;
+    self->slots[slotIndex].hash         = 0;
+}
+
+static bool octaspire_dern_map_private_rebuild_slots(
+    octaspire_dern_map_t * const self,
+    size_t const slotCapacity)
+{
+    octaspire_dern_map_private_slot_t * const slots = octaspire_allocator_malloc(
+        self->allocator,
+        sizeof(octaspire_dern_map_private_slot_t) * slotCapacity);
+
+    if (!slots)
+    {
+        return false;
+    }
+
+    memset(slots, 0, sizeof(octaspire_dern_map_private_slot_t) * slotCapacity);
+
+    if (self->slots)
+    {
+        octaspire_allocator_free(self->allocator, self->slots);
+    }
+
+    uint32_t shift = 32;
+
+    for (size_t i = 1; i < slotCapacity; i *= 2)
+    {
+        --shift;
+    }
+
+    self->slots        = slots;
+    self->slotCapacity = slotCapacity;
+    self->shift        = shift;
+
+    for (size_t i = 0; i < self->numUsedElements; ++i)
+    {
+        if (self->elements[i].key)
+        {
+            octaspire_dern_map_private_slot_t slot;
+            slot.elementIndex = (uint32_t)(i + 1);
+            slot.hash         = self->elements[i].hash;
+
+            octaspire_dern_map_private_insert_slot(self, slot);
+        }
+    }
+
+    return true;
+}
+
+static void octaspire_dern_map_private_compact(
+    octaspire_dern_map_t * const self)
+{
+    if (self->numUsedElements == self->numElements)
+    {
+        return;
+    }
+
+    size_t target = 0;
+
+    for (size_t i = 0; i < self->numUsedElements; ++i)
+    {
+        if (self->elements[i].key)
+        {
+            self->elements[target] = self->elements[i];
+            ++target;
+        }
+    }
+
+    assert(target == self->numElements);
+
+    memset(
+        &(self->elements[target]),
+        0,
+        sizeof(octaspire_dern_map_element_t) * (self->numUsedElements - target));
+
+    self->numUsedElements = target;
+
+    if (self->slots)
+    {
+        // Element indices changed; the index is rebuilt in place.
+        memset(
+            self->slots,
+            0,
+            sizeof(octaspire_dern_map_private_slot_t) * self->slotCapacity);
+
+        for (size_t i = 0; i < self->numUsedElements; ++i)
+        {
+            octaspire_dern_map_private_slot_t slot;
+            slot.elementIndex = (uint32_t)(i + 1);
+            slot.hash         = self->elements[i].hash;
+
+            octaspire_dern_map_private_insert_slot(self, slot);
+        }
+    }
+}
+
+static bool octaspire_dern_map_private_grow(
+    octaspire_dern_map_t * const self,
+    size_t const newCapacity)
+{
+    octaspire_dern_map_element_t * const newElements = octaspire_allocator_malloc(
+        self->allocator,
+        sizeof(octaspire_dern_map_element_t) * newCapacity);
+
+    if (!newElements)
+    {
+        return false;
+    }
+
+    memset(newElements, 0, sizeof(octaspire_dern_map_element_t) * newCapacity);
+
+    memcpy(
+        newElements,
+        self->elements,
+        sizeof(octaspire_dern_map_element_t) * self->numUsedElements);
+
+    if (!octaspire_dern_map_private_is_small(self))
+    {
+        octaspire_allocator_free(self->allocator, self->elements);
+    }
+
+    self->elements        = newElements;
+    self->elementCapacity = newCapacity;
+
+    // Load factor of the index stays at or below one half.
+    return octaspire_dern_map_private_rebuild_slots(self, newCapacity * 2);
+}
+
+octaspire_dern_map_t *octaspire_dern_map_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_map_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_map_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->allocator                      = allocator;
+    self->hashesCollectionKeysByIdentity = false;
+    octaspire_dern_map_private_reset_to_small(self);
+
+    return self;
+}
+
+octaspire_dern_map_t *octaspire_dern_map_new_copy(
+    octaspire_dern_map_t const * const other,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_map_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_map_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    *self = *other;
+    self->allocator = allocator;
+
+    if (octaspire_dern_map_private_is_small(other))
+    {
+        self->elements = self->smallElements;
+        return self;
+    }
+
+    self->elements = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_map_element_t) * other->elementCapacity);
+
+    self->slots = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_map_private_slot_t) * other->slotCapacity);
+
+    if (!self->elements || !self->slots)
+    {
+        if (self->elements)
+        {
+            octaspire_allocator_free(allocator, self->elements);
+        }
+
+        if (self->slots)
+        {
+            octaspire_allocator_free(allocator, self->slots);
+        }
+
+        octaspire_allocator_free(allocator, self);
+        return 0;
+    }
+
+    memcpy(
+        self->elements,
+        other->elements,
+        sizeof(octaspire_dern_map_element_t) * other->elementCapacity);
+
+    memcpy(
+        self->slots,
+        other->slots,
+        sizeof(octaspire_dern_map_private_slot_t) * other->slotCapacity);
+
+    return self;
+}
+
+void octaspire_dern_map_release(octaspire_dern_map_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    if (!octaspire_dern_map_private_is_small(self))
+    {
+        octaspire_allocator_free(self->allocator, self->elements);
+    }
+
+    if (self->slots)
+    {
+        octaspire_allocator_free(self->allocator, self->slots);
+    }
+
+    octaspire_allocator_free(self->allocator, self);
+}
+
+static bool octaspire_dern_map_private_put(
+    octaspire_dern_map_t * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value,
+    bool const replaceKey)
+{
+    uint32_t const hash =
+        octaspire_dern_map_private_get_hash_for_key(self, keyHash, key);
+
+    ptrdiff_t const index = octaspire_dern_map_private_find(self, hash, key, 0);
+
+    if (index >= 0)
+    {
+        if (replaceKey)
+        {
+            self->elements[index].key = key;
+        }
+
+        self->elements[index].value = value;
+        return true;
+    }
+
+    if (self->numUsedElements == self->elementCapacity)
+    {
+        // Reuse the holes left by removed elements when there are many
+        // of them; otherwise make room for more elements.
+        if (self->numElements < self->elementCapacity / 2)
+        {
+            octaspire_dern_map_private_compact(self);
+        }
+        else if (!octaspire_dern_map_private_grow(self, self->elementCapacity * 2))
+        {
+            return false;
+        }
+    }
+
+    size_t const newIndex = self->numUsedElements;
+
+    octaspire_dern_map_element_t * const element = &(self->elements[newIndex]);
+    element->key   = key;
+    element->value = value;
+    element->hash  = hash;
+
+    ++(self->numUsedElements);
+    ++(self->numElements);
+
+    if (self->slots)
+    {
+        octaspire_dern_map_private_slot_t slot;
+        slot.elementIndex = (uint32_t)(newIndex + 1);
+        slot.hash         = hash;
+
+        octaspire_dern_map_private_insert_slot(self, slot);
+    }
+
+    return true;
+}
+
+bool octaspire_dern_map_put(
+    octaspire_dern_map_t * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
+{
+    return octaspire_dern_map_private_put(self, keyHash, key, value, false);
+}
+
+bool octaspire_dern_map_put_replacing_key(
+    octaspire_dern_map_t * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
+{
+    return octaspire_dern_map_private_put(self, keyHash, key, value, true);
+}
+
+bool octaspire_dern_map_remove(
+    octaspire_dern_map_t * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t const * const key)
+{
+    uint32_t const hash =
+        octaspire_dern_map_private_get_hash_for_key(self, keyHash, key);
+
+    size_t          slotIndex = 0;
+    ptrdiff_t const index     =
+        octaspire_dern_map_private_find(self, hash, key, &slotIndex);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    if (self->slots)
+    {
+        octaspire_dern_map_private_remove_slot(self, slotIndex);
+    }
+
+    memset(&(self->elements[index]), 0, sizeof(octaspire_dern_map_element_t));
+    --(self->numElements);
+
+    // Holes at the end are not needed to keep the order.
+    while (self->numUsedElements &&
+           !self->elements[self->numUsedElements - 1].key)
+    {
+        --(self->numUsedElements);
+    }
+
+    if ((self->numUsedElements - self->numElements) > self->numElements)
+    {
+        octaspire_dern_map_private_compact(self);
+    }
+
+    return true;
+}
+
+bool octaspire_dern_map_clear(
+    octaspire_dern_map_t * const self)
+{
+    if (!octaspire_dern_map_private_is_small(self))
+    {
+        octaspire_allocator_free(self->allocator, self->elements);
+    }
+
+    if (self->slots)
+    {
+        octaspire_allocator_free(self->allocator, self->slots);
+    }
+
+    octaspire_dern_map_private_reset_to_small(self);
+    return true;
+}
+
+void octaspire_dern_map_set_hashes_collection_keys_by_identity(
+    octaspire_dern_map_t * const self,
+    bool const hashesCollectionKeysByIdentity)
+{
+    octaspire_helpers_verify_true(octaspire_dern_map_is_empty(self));
+    self->hashesCollectionKeysByIdentity = hashesCollectionKeysByIdentity;
+}
+
+bool octaspire_dern_map_reserve(
+    octaspire_dern_map_t * const self,
+    size_t const numElements)
+{
+    if (numElements <= self->elementCapacity)
+    {
+        return true;
+    }
+
+    size_t newCapacity = self->elementCapacity;
+
+    while (newCapacity < numElements)
+    {
+        newCapacity *= 2;
+    }
+
+    octaspire_dern_map_private_compact(self);
+    return octaspire_dern_map_private_grow(self, newCapacity);
+}
+
+bool octaspire_dern_map_add_map(
+    octaspire_dern_map_t * const self,
+    octaspire_dern_map_t const * const other)
+{
+    bool result = true;
+
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(other);
+
+    while (iter.element)
+    {
+        if (!octaspire_dern_map_put(
+                self,
+                iter.element->hash,
+                iter.element->key,
+                iter.element->value))
+        {
+            result = false;
+        }
+
+        octaspire_dern_map_element_const_iterator_next(&iter);
+    }
+
+    return result;
+}
+
+octaspire_dern_map_element_t *octaspire_dern_map_get(
+    octaspire_dern_map_t * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t const * const key)
+{
+    ptrdiff_t const index = octaspire_dern_map_private_find(
+        self,
+        octaspire_dern_map_private_get_hash_for_key(self, keyHash, key),
+        key,
+        0);
+
+    return (index < 0) ? 0 : &(self->elements[index]);
+}
+
+octaspire_dern_map_element_t const *octaspire_dern_map_get_const(
+    octaspire_dern_map_t const * const self,
+    uint32_t const keyHash,
+    octaspire_dern_value_t const * const key)
+{
+    ptrdiff_t const index = octaspire_dern_map_private_find(
+        self,
+        octaspire_dern_map_private_get_hash_for_key(self, keyHash, key),
+        key,
+        0);
+
+    return (index < 0) ? 0 : &(self->elements[index]);
+}
+
+bool octaspire_dern_map_is_empty(
+    octaspire_dern_map_t const * const self)
+{
+    return self->numElements == 0;
+}
+
+size_t octaspire_dern_map_get_number_of_elements(
+    octaspire_dern_map_t const * const self)
+{
+    return self->numElements;
+}
+
+octaspire_dern_map_element_t *octaspire_dern_map_get_at_index(
+    octaspire_dern_map_t * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    // Without holes the position of an element is its array index.
+    octaspire_dern_map_private_compact(self);
+
+    return (octaspire_dern_map_element_t*)octaspire_dern_map_get_at_index_const(
+        self,
+        possiblyNegativeIndex);
+}
+
+octaspire_dern_map_element_t const *octaspire_dern_map_get_at_index_const(
+    octaspire_dern_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    ptrdiff_t const index = (possiblyNegativeIndex < 0) ?
+        ((ptrdiff_t)self->numElements + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (index < 0 || (size_t)index >= self->numElements)
+    {
+        return 0;
+    }
+
+    if (self->numUsedElements == self->numElements)
+    {
+        return &(self->elements[index]);
+    }
+
+    size_t counter = 0;
+
+    for (size_t i = 0; i < self->numUsedElements; ++i)
+    {
+        if (self->elements[i].key)
+        {
+            if (counter == (size_t)index)
+            {
+                return &(self->elements[i]);
+            }
+
+            ++counter;
+        }
+    }
+
+    return 0;
+}
+
+octaspire_dern_value_t *octaspire_dern_map_element_get_key(
+    octaspire_dern_map_element_t const * const self)
+{
+    assert(self);
+    return self->key;
+}
+
+octaspire_dern_value_t *octaspire_dern_map_element_get_value(
+    octaspire_dern_map_element_t const * const self)
+{
+    assert(self);
+    return self->value;
+}
+
+octaspire_dern_value_t const *octaspire_dern_map_element_get_key_const(
+    octaspire_dern_map_element_t const * const self)
+{
+    assert(self);
+    return self->key;
+}
+
+octaspire_dern_value_t const *octaspire_dern_map_element_get_value_const(
+    octaspire_dern_map_element_t const * const self)
+{
+    assert(self);
+    return self->value;
+}
+
+uint32_t octaspire_dern_map_element_get_hash(
+    octaspire_dern_map_element_t const * const self)
+{
+    assert(self);
+    return self->hash;
+}
+
+octaspire_dern_map_element_iterator_t octaspire_dern_map_element_iterator_init(
+    octaspire_dern_map_t * const self)
+{
+    octaspire_dern_map_element_iterator_t iter;
+
+    iter.hashMap = self;
+    iter.element = 0;
+    iter.index   = 0;
+
+    for (; iter.index < self->numUsedElements; ++(iter.index))
+    {
+        if (self->elements[iter.index].key)
+        {
+            iter.element = &(self->elements[iter.index]);
+            break;
+        }
+    }
+
+    return iter;
+}
+
+bool octaspire_dern_map_element_iterator_next(
+    octaspire_dern_map_element_iterator_t * const self)
+{
+    self->element = 0;
+
+    for (++(self->index); self->index < self->hashMap->numUsedElements; ++(self->index))
+    {
+        if (self->hashMap->elements[self->index].key)
+        {
+            self->element = &(self->hashMap->elements[self->index]);
+            break;
+        }
+    }
+
+    return self->element != 0;
+}
+
+octaspire_dern_map_element_const_iterator_t octaspire_dern_map_element_const_iterator_init(
+    octaspire_dern_map_t const * const self)
+{
+    octaspire_dern_map_element_const_iterator_t iter;
+
+    iter.hashMap = self;
+    iter.element = 0;
+    iter.index   = 0;
+
+    for (; iter.index < self->numUsedElements; ++(iter.index))
+    {
+        if (self->elements[iter.index].key)
+        {
+            iter.element = &(self->elements[iter.index]);
+            break;
+        }
+    }
+
+    return iter;
+}
+
+bool octaspire_dern_map_element_const_iterator_next(
+    octaspire_dern_map_element_const_iterator_t * const self)
+{
+    self->element = 0;
+
+    for (++(self->index); self->index < self->hashMap->numUsedElements; ++(self->index))
+    {
+        if (self->hashMap->elements[self->index].key)
+        {
+            self->element = &(self->hashMap->elements[self->index]);
+            break;
+        }
+    }
+
+    return self->element != 0;
+}
+
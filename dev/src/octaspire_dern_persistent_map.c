@@ -0,0 +1,698 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_persistent_map.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_value.h"
+
+#define OCTASPIRE_DERN_PERSISTENT_MAP_BITS 5
+#define OCTASPIRE_DERN_PERSISTENT_MAP_MASK 31
+
+struct octaspire_dern_persistent_map_node_t;
+
+typedef struct octaspire_dern_persistent_map_entry_t
+{
+    // Null key means that the entry refers to a child node.
+    octaspire_dern_value_t                          *key;
+
+    union
+    {
+        octaspire_dern_value_t                      *value;
+        struct octaspire_dern_persistent_map_node_t *node;
+    }
+    target;
+
+    uint32_t                                         hash;
+    char                                             padding[4];
+}
+octaspire_dern_persistent_map_entry_t;
+
+typedef struct octaspire_dern_persistent_map_node_t
+{
+    // Number of maps and nodes referring to this node.
+    uint32_t                              refCount;
+    uint32_t                              markEpoch;
+
+    // Bit for each five bit part of a hash that has an entry.
+    // Collision nodes hold keys with equal hashes and use no bitmap.
+    uint32_t                              bitmap;
+    uint32_t                              numEntries;
+
+    // Number of keys in this node and below it.
+    size_t                                numElements;
+
+    bool                                  isCollision;
+    char                                  padding[7];
+
+    octaspire_dern_persistent_map_entry_t entries[];
+}
+octaspire_dern_persistent_map_node_t;
+
+struct octaspire_dern_persistent_map_t
+{
+    octaspire_dern_persistent_map_node_t *root;
+    octaspire_allocator_t                *allocator;
+};
+
+static uint32_t octaspire_dern_persistent_map_private_count_bits(uint32_t bits)
+{
+    bits = bits - ((bits >> 1) & UINT32_C(0x55555555));
+    bits = (bits & UINT32_C(0x33333333)) + ((bits >> 2) & UINT32_C(0x33333333));
+    bits = (bits + (bits >> 4)) & UINT32_C(0x0F0F0F0F);
+    return (bits * UINT32_C(0x01010101)) >> 24;
+}
+
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_node_new(
+    octaspire_allocator_t * const allocator,
+    size_t const numEntries)
+{
+    // Failing here in the middle of copying a path would leave the map
+    // broken, so allocation failures of nodes are not recoverable.
+    size_t const size = sizeof(octaspire_dern_persistent_map_node_t) +
+        (numEntries * sizeof(octaspire_dern_persistent_map_entry_t));
+
+    octaspire_dern_persistent_map_node_t * const self =
+        octaspire_allocator_malloc(allocator, size);
+
+    octaspire_helpers_verify_not_null(self);
+
+    memset(self, 0, size);
+    self->refCount   = 1;
+    self->numEntries = (uint32_t)numEntries;
+
+    return self;
+}
+
+static void octaspire_dern_persistent_map_private_node_release(
+    octaspire_dern_persistent_map_node_t * const self,
+    octaspire_allocator_t * const allocator)
+{
+    assert(self->refCount > 0);
+
+    --(self->refCount);
+
+    if (self->refCount > 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < self->numEntries; ++i)
+    {
+        if (!self->entries[i].key)
+        {
+            octaspire_dern_persistent_map_private_node_release(
+                self->entries[i].target.node,
+                allocator);
+        }
+    }
+
+    octaspire_allocator_free(allocator, self);
+}
+
+// Copies the node with room for 'numExtraEntries' more entries. A node
+// owned by the caller alone is moved to the copy instead of shared.
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_node_copy(
+    octaspire_dern_persistent_map_node_t * const self,
+    size_t const numExtraEntries,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_map_node_t * const result =
+        octaspire_dern_persistent_map_private_node_new(
+            allocator,
+            self->numEntries + numExtraEntries);
+
+    result->bitmap      = self->bitmap;
+    result->numEntries  = self->numEntries;
+    result->numElements = self->numElements;
+    result->isCollision = self->isCollision;
+
+    memcpy(
+        result->entries,
+        self->entries,
+        sizeof(octaspire_dern_persistent_map_entry_t) * self->numEntries);
+
+    if (self->refCount == 1)
+    {
+        octaspire_allocator_free(allocator, self);
+        return result;
+    }
+
+    for (size_t i = 0; i < result->numEntries; ++i)
+    {
+        if (!result->entries[i].key)
+        {
+            ++(result->entries[i].target.node->refCount);
+        }
+    }
+
+    --(self->refCount);
+    return result;
+}
+
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_node_make_unique(
+    octaspire_dern_persistent_map_node_t * const self,
+    octaspire_allocator_t * const allocator)
+{
+    if (self->refCount == 1)
+    {
+        return self;
+    }
+
+    return octaspire_dern_persistent_map_private_node_copy(self, 0, allocator);
+}
+
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_node_insert_entry(
+    octaspire_dern_persistent_map_node_t * const self,
+    size_t const index,
+    octaspire_dern_persistent_map_entry_t const * const entry,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_map_node_t * const result =
+        octaspire_dern_persistent_map_private_node_copy(self, 1, allocator);
+
+    memmove(
+        &(result->entries[index + 1]),
+        &(result->entries[index]),
+        sizeof(octaspire_dern_persistent_map_entry_t) * (result->numEntries - index));
+
+    result->entries[index] = *entry;
+    ++(result->numEntries);
+
+    return result;
+}
+
+static void octaspire_dern_persistent_map_private_node_remove_entry(
+    octaspire_dern_persistent_map_node_t * const self,
+    size_t const index)
+{
+    assert(self->refCount == 1);
+
+    memmove(
+        &(self->entries[index]),
+        &(self->entries[index + 1]),
+        sizeof(octaspire_dern_persistent_map_entry_t) * (self->numEntries - index - 1));
+
+    --(self->numEntries);
+}
+
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_new_pair(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const shift,
+    octaspire_dern_persistent_map_entry_t const * const first,
+    octaspire_dern_persistent_map_entry_t const * const second)
+{
+    if (shift >= 32)
+    {
+        // All bits of the hashes are used and equal.
+        octaspire_dern_persistent_map_node_t * const result =
+            octaspire_dern_persistent_map_private_node_new(self->allocator, 2);
+
+        result->isCollision = true;
+        result->numElements = 2;
+        result->entries[0]  = *first;
+        result->entries[1]  = *second;
+
+        return result;
+    }
+
+    uint32_t const firstIndex  = (first->hash  >> shift) & OCTASPIRE_DERN_PERSISTENT_MAP_MASK;
+    uint32_t const secondIndex = (second->hash >> shift) & OCTASPIRE_DERN_PERSISTENT_MAP_MASK;
+
+    if (firstIndex == secondIndex)
+    {
+        octaspire_dern_persistent_map_node_t * const result =
+            octaspire_dern_persistent_map_private_node_new(self->allocator, 1);
+
+        result->bitmap                 = UINT32_C(1) << firstIndex;
+        result->numElements            = 2;
+        result->entries[0].target.node = octaspire_dern_persistent_map_private_new_pair(
+            self,
+            shift + OCTASPIRE_DERN_PERSISTENT_MAP_BITS,
+            first,
+            second);
+
+        return result;
+    }
+
+    octaspire_dern_persistent_map_node_t * const result =
+        octaspire_dern_persistent_map_private_node_new(self->allocator, 2);
+
+    result->bitmap      = (UINT32_C(1) << firstIndex) | (UINT32_C(1) << secondIndex);
+    result->numElements = 2;
+    result->entries[0]  = (firstIndex < secondIndex) ? *first  : *second;
+    result->entries[1]  = (firstIndex < secondIndex) ? *second : *first;
+
+    return result;
+}
+
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_put(
+    octaspire_dern_persistent_map_t * const self,
+    octaspire_dern_persistent_map_node_t *node,
+    uint32_t const shift,
+    octaspire_dern_persistent_map_entry_t const * const entry,
+    bool * const added)
+{
+    if (node->isCollision)
+    {
+        for (size_t i = 0; i < node->numEntries; ++i)
+        {
+            if (octaspire_dern_value_is_equal(node->entries[i].key, entry->key))
+            {
+                node = octaspire_dern_persistent_map_private_node_make_unique(
+                    node,
+                    self->allocator);
+
+                node->entries[i] = *entry;
+                return node;
+            }
+        }
+
+        node = octaspire_dern_persistent_map_private_node_insert_entry(
+            node,
+            node->numEntries,
+            entry,
+            self->allocator);
+
+        ++(node->numElements);
+        *added = true;
+        return node;
+    }
+
+    uint32_t const bit =
+        UINT32_C(1) << ((entry->hash >> shift) & OCTASPIRE_DERN_PERSISTENT_MAP_MASK);
+
+    size_t const index =
+        octaspire_dern_persistent_map_private_count_bits(node->bitmap & (bit - 1));
+
+    if (!(node->bitmap & bit))
+    {
+        node = octaspire_dern_persistent_map_private_node_insert_entry(
+            node,
+            index,
+            entry,
+            self->allocator);
+
+        node->bitmap |= bit;
+        ++(node->numElements);
+        *added = true;
+        return node;
+    }
+
+    node = octaspire_dern_persistent_map_private_node_make_unique(node, self->allocator);
+
+    octaspire_dern_persistent_map_entry_t * const existing = &(node->entries[index]);
+
+    if (!existing->key)
+    {
+        existing->target.node = octaspire_dern_persistent_map_private_put(
+            self,
+            existing->target.node,
+            shift + OCTASPIRE_DERN_PERSISTENT_MAP_BITS,
+            entry,
+            added);
+    }
+    else if (existing->hash == entry->hash &&
+             octaspire_dern_value_is_equal(existing->key, entry->key))
+    {
+        // Also the key is replaced, like in hash map values.
+        *existing = *entry;
+    }
+    else
+    {
+        octaspire_dern_persistent_map_node_t * const child =
+            octaspire_dern_persistent_map_private_new_pair(
+                self,
+                shift + OCTASPIRE_DERN_PERSISTENT_MAP_BITS,
+                existing,
+                entry);
+
+        existing->key         = 0;
+        existing->target.node = child;
+        existing->hash        = 0;
+        *added                = true;
+    }
+
+    if (*added)
+    {
+        ++(node->numElements);
+    }
+
+    return node;
+}
+
+// Removes a key that is known to be in the subtrie. Returns the
+// modified node, or null if the node became empty and was released.
+static octaspire_dern_persistent_map_node_t *octaspire_dern_persistent_map_private_remove(
+    octaspire_dern_persistent_map_t * const self,
+    octaspire_dern_persistent_map_node_t *node,
+    uint32_t const shift,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key)
+{
+    node = octaspire_dern_persistent_map_private_node_make_unique(node, self->allocator);
+
+    if (node->isCollision)
+    {
+        for (size_t i = 0; i < node->numEntries; ++i)
+        {
+            if (octaspire_dern_value_is_equal(node->entries[i].key, key))
+            {
+                octaspire_dern_persistent_map_private_node_remove_entry(node, i);
+                break;
+            }
+        }
+    }
+    else
+    {
+        uint32_t const bit =
+            UINT32_C(1) << ((hash >> shift) & OCTASPIRE_DERN_PERSISTENT_MAP_MASK);
+
+        size_t const index =
+            octaspire_dern_persistent_map_private_count_bits(node->bitmap & (bit - 1));
+
+        assert(node->bitmap & bit);
+
+        octaspire_dern_persistent_map_entry_t * const existing = &(node->entries[index]);
+
+        octaspire_dern_persistent_map_node_t * const child = existing->key ? 0 :
+            octaspire_dern_persistent_map_private_remove(
+                self,
+                existing->target.node,
+                shift + OCTASPIRE_DERN_PERSISTENT_MAP_BITS,
+                hash,
+                key);
+
+        if (!child)
+        {
+            octaspire_dern_persistent_map_private_node_remove_entry(node, index);
+            node->bitmap &= ~bit;
+        }
+        else if (child->numEntries == 1 && child->entries[0].key)
+        {
+            // A single key left in the child is moved up into this node.
+            *existing = child->entries[0];
+            octaspire_dern_persistent_map_private_node_release(child, self->allocator);
+        }
+        else
+        {
+            existing->target.node = child;
+        }
+    }
+
+    --(node->numElements);
+
+    if (node->numEntries == 0)
+    {
+        octaspire_dern_persistent_map_private_node_release(node, self->allocator);
+        return 0;
+    }
+
+    return node;
+}
+
+static octaspire_dern_persistent_map_entry_t const *octaspire_dern_persistent_map_private_find(
+    octaspire_dern_persistent_map_t const * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_dern_persistent_map_node_t const *node  = self->root;
+    uint32_t                                    shift = 0;
+
+    while (true)
+    {
+        if (node->isCollision)
+        {
+            for (size_t i = 0; i < node->numEntries; ++i)
+            {
+                if (node->entries[i].hash == hash &&
+                    octaspire_dern_value_is_equal(node->entries[i].key, key))
+                {
+                    return &(node->entries[i]);
+                }
+            }
+
+            return 0;
+        }
+
+        uint32_t const bit =
+            UINT32_C(1) << ((hash >> shift) & OCTASPIRE_DERN_PERSISTENT_MAP_MASK);
+
+        if (!(node->bitmap & bit))
+        {
+            return 0;
+        }
+
+        octaspire_dern_persistent_map_entry_t const * const entry = &(node->entries[
+            octaspire_dern_persistent_map_private_count_bits(node->bitmap & (bit - 1))]);
+
+        if (entry->key)
+        {
+            if (entry->hash == hash && octaspire_dern_value_is_equal(entry->key, key))
+            {
+                return entry;
+            }
+
+            return 0;
+        }
+
+        node   = entry->target.node;
+        shift += OCTASPIRE_DERN_PERSISTENT_MAP_BITS;
+    }
+}
+
+octaspire_dern_persistent_map_t *octaspire_dern_persistent_map_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_map_t * const self = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_persistent_map_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->allocator = allocator;
+    self->root      = octaspire_dern_persistent_map_private_node_new(allocator, 0);
+
+    return self;
+}
+
+octaspire_dern_persistent_map_t *octaspire_dern_persistent_map_new_copy(
+    octaspire_dern_persistent_map_t const * const other,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_map_t * const self = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_persistent_map_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->allocator = allocator;
+    self->root      = other->root;
+
+    ++(self->root->refCount);
+
+    return self;
+}
+
+void octaspire_dern_persistent_map_release(
+    octaspire_dern_persistent_map_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_dern_persistent_map_private_node_release(self->root, self->allocator);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_persistent_map_get_number_of_elements(
+    octaspire_dern_persistent_map_t const * const self)
+{
+    return self->root->numElements;
+}
+
+bool octaspire_dern_persistent_map_put(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_dern_persistent_map_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+
+    entry.key          = key;
+    entry.target.value = value;
+    entry.hash         = hash;
+
+    bool added = false;
+
+    self->root = octaspire_dern_persistent_map_private_put(
+        self,
+        self->root,
+        0,
+        &entry,
+        &added);
+
+    return true;
+}
+
+bool octaspire_dern_persistent_map_remove(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key)
+{
+    // Nodes on the path are copied only when the key is really there.
+    if (!octaspire_dern_persistent_map_private_find(self, hash, key))
+    {
+        return false;
+    }
+
+    self->root = octaspire_dern_persistent_map_private_remove(
+        self,
+        self->root,
+        0,
+        hash,
+        key);
+
+    if (!self->root)
+    {
+        self->root = octaspire_dern_persistent_map_private_node_new(self->allocator, 0);
+    }
+
+    return true;
+}
+
+octaspire_dern_value_t *octaspire_dern_persistent_map_get(
+    octaspire_dern_persistent_map_t const * const self,
+    uint32_t const hash,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_dern_persistent_map_entry_t const * const entry =
+        octaspire_dern_persistent_map_private_find(self, hash, key);
+
+    return entry ? entry->target.value : 0;
+}
+
+bool octaspire_dern_persistent_map_get_at_index(
+    octaspire_dern_persistent_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t ** const key,
+    octaspire_dern_value_t ** const value)
+{
+    ptrdiff_t const signedIndex = (possiblyNegativeIndex < 0) ?
+        ((ptrdiff_t)self->root->numElements + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (signedIndex < 0 || (size_t)signedIndex >= self->root->numElements)
+    {
+        return false;
+    }
+
+    size_t                                      index = (size_t)signedIndex;
+    octaspire_dern_persistent_map_node_t const *node  = self->root;
+
+    while (true)
+    {
+        octaspire_dern_persistent_map_node_t const *child = 0;
+
+        for (size_t i = 0; i < node->numEntries; ++i)
+        {
+            octaspire_dern_persistent_map_entry_t const * const entry = &(node->entries[i]);
+
+            if (entry->key)
+            {
+                if (index == 0)
+                {
+                    *key   = entry->key;
+                    *value = entry->target.value;
+                    return true;
+                }
+
+                --index;
+            }
+            else if (index < entry->target.node->numElements)
+            {
+                child = entry->target.node;
+                break;
+            }
+            else
+            {
+                index -= entry->target.node->numElements;
+            }
+        }
+
+        assert(child);
+        node = child;
+    }
+}
+
+static bool octaspire_dern_persistent_map_private_mark_node(
+    octaspire_dern_persistent_map_node_t * const self,
+    uint32_t const markEpoch)
+{
+    if (self->markEpoch == markEpoch)
+    {
+        return true;
+    }
+
+    self->markEpoch = markEpoch;
+
+    bool result = true;
+
+    for (size_t i = 0; i < self->numEntries; ++i)
+    {
+        octaspire_dern_persistent_map_entry_t * const entry = &(self->entries[i]);
+
+        if (entry->key)
+        {
+            if (!octaspire_dern_value_mark(entry->key) ||
+                !octaspire_dern_value_mark(entry->target.value))
+            {
+                result = false;
+            }
+        }
+        else if (!octaspire_dern_persistent_map_private_mark_node(
+                    entry->target.node,
+                    markEpoch))
+        {
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+bool octaspire_dern_persistent_map_mark(
+    octaspire_dern_persistent_map_t * const self,
+    uint32_t const markEpoch)
+{
+    return octaspire_dern_persistent_map_private_mark_node(self->root, markEpoch);
+}
+
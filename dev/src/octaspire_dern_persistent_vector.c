@@ -0,0 +1,512 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_persistent_vector.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_value.h"
+
+#define OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS  5
+#define OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH 32
+#define OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK  31
+
+typedef struct octaspire_dern_persistent_vector_node_t
+{
+    // Number of vectors and nodes referring to this node.
+    uint32_t refCount;
+    uint32_t markEpoch;
+
+    // Leaf nodes (level zero and the tail) hold values,
+    // other nodes hold child nodes.
+    union
+    {
+        struct octaspire_dern_persistent_vector_node_t *nodes[OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH];
+        octaspire_dern_value_t                         *values[OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH];
+    }
+    slots;
+}
+octaspire_dern_persistent_vector_node_t;
+
+struct octaspire_dern_persistent_vector_t
+{
+    octaspire_dern_persistent_vector_node_t *root;
+    octaspire_dern_persistent_vector_node_t *tail;
+    octaspire_allocator_t                   *allocator;
+    size_t                                   length;
+
+    // Level of the root in bits; leaves are at level zero.
+    uint32_t                                 shift;
+    char                                     padding[4];
+};
+
+static octaspire_dern_persistent_vector_node_t *octaspire_dern_persistent_vector_private_node_new(
+    octaspire_allocator_t * const allocator)
+{
+    // Failing here in the middle of copying a path would leave the vector
+    // broken, so allocation failures of nodes are not recoverable.
+    octaspire_dern_persistent_vector_node_t * const self = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_persistent_vector_node_t));
+
+    octaspire_helpers_verify_not_null(self);
+
+    memset(self, 0, sizeof(octaspire_dern_persistent_vector_node_t));
+    self->refCount = 1;
+    return self;
+}
+
+static void octaspire_dern_persistent_vector_private_node_release(
+    octaspire_dern_persistent_vector_node_t * const self,
+    uint32_t const level,
+    octaspire_allocator_t * const allocator)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    assert(self->refCount > 0);
+
+    --(self->refCount);
+
+    if (self->refCount > 0)
+    {
+        return;
+    }
+
+    if (level > 0)
+    {
+        for (size_t i = 0; i < OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH; ++i)
+        {
+            octaspire_dern_persistent_vector_private_node_release(
+                self->slots.nodes[i],
+                level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+                allocator);
+        }
+    }
+
+    octaspire_allocator_free(allocator, self);
+}
+
+// Returns a node that is owned by the caller alone and can be modified:
+// either the given node, or a copy of it if it is shared.
+static octaspire_dern_persistent_vector_node_t *octaspire_dern_persistent_vector_private_node_make_unique(
+    octaspire_dern_persistent_vector_node_t * const self,
+    uint32_t const level,
+    octaspire_allocator_t * const allocator)
+{
+    if (self->refCount == 1)
+    {
+        return self;
+    }
+
+    octaspire_dern_persistent_vector_node_t * const result =
+        octaspire_dern_persistent_vector_private_node_new(allocator);
+
+    memcpy(&(result->slots), &(self->slots), sizeof(self->slots));
+
+    if (level > 0)
+    {
+        for (size_t i = 0; i < OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH; ++i)
+        {
+            if (result->slots.nodes[i])
+            {
+                ++(result->slots.nodes[i]->refCount);
+            }
+        }
+    }
+
+    --(self->refCount);
+    return result;
+}
+
+static size_t octaspire_dern_persistent_vector_private_get_tail_offset(
+    octaspire_dern_persistent_vector_t const * const self)
+{
+    if (self->length < OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH)
+    {
+        return 0;
+    }
+
+    return ((self->length - 1) >> OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS) <<
+        OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS;
+}
+
+static ptrdiff_t octaspire_dern_persistent_vector_private_get_index(
+    octaspire_dern_persistent_vector_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    ptrdiff_t const index = (possiblyNegativeIndex < 0) ?
+        ((ptrdiff_t)self->length + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (index < 0 || (size_t)index >= self->length)
+    {
+        return -1;
+    }
+
+    return index;
+}
+
+octaspire_dern_persistent_vector_t *octaspire_dern_persistent_vector_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_vector_t * const self = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_persistent_vector_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_persistent_vector_t));
+
+    self->allocator = allocator;
+    self->shift     = OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS;
+    self->root      = octaspire_dern_persistent_vector_private_node_new(allocator);
+    self->tail      = octaspire_dern_persistent_vector_private_node_new(allocator);
+
+    return self;
+}
+
+octaspire_dern_persistent_vector_t *octaspire_dern_persistent_vector_new_copy(
+    octaspire_dern_persistent_vector_t const * const other,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_persistent_vector_t * const self = octaspire_allocator_malloc(
+        allocator,
+        sizeof(octaspire_dern_persistent_vector_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    *self = *other;
+    self->allocator = allocator;
+
+    ++(self->root->refCount);
+    ++(self->tail->refCount);
+
+    return self;
+}
+
+void octaspire_dern_persistent_vector_release(
+    octaspire_dern_persistent_vector_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_dern_persistent_vector_private_node_release(
+        self->root,
+        self->shift,
+        self->allocator);
+
+    octaspire_dern_persistent_vector_private_node_release(
+        self->tail,
+        0,
+        self->allocator);
+
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_persistent_vector_get_length(
+    octaspire_dern_persistent_vector_t const * const self)
+{
+    return self->length;
+}
+
+bool octaspire_dern_persistent_vector_is_index_valid(
+    octaspire_dern_persistent_vector_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    return octaspire_dern_persistent_vector_private_get_index(
+        self,
+        possiblyNegativeIndex) >= 0;
+}
+
+octaspire_dern_value_t *octaspire_dern_persistent_vector_get_element_at(
+    octaspire_dern_persistent_vector_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    ptrdiff_t const signedIndex = octaspire_dern_persistent_vector_private_get_index(
+        self,
+        possiblyNegativeIndex);
+
+    if (signedIndex < 0)
+    {
+        return 0;
+    }
+
+    size_t const index = (size_t)signedIndex;
+
+    if (index >= octaspire_dern_persistent_vector_private_get_tail_offset(self))
+    {
+        return self->tail->slots.values[index & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK];
+    }
+
+    octaspire_dern_persistent_vector_node_t const *node = self->root;
+
+    for (uint32_t level = self->shift; level > 0; level -= OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS)
+    {
+        node = node->slots.nodes[(index >> level) & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK];
+    }
+
+    return node->slots.values[index & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK];
+}
+
+static octaspire_dern_persistent_vector_node_t *octaspire_dern_persistent_vector_private_set(
+    octaspire_dern_persistent_vector_t * const self,
+    octaspire_dern_persistent_vector_node_t * const node,
+    uint32_t const level,
+    size_t const index,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_dern_persistent_vector_node_t * const result =
+        octaspire_dern_persistent_vector_private_node_make_unique(node, level, self->allocator);
+
+    size_t const subIndex = (index >> level) & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK;
+
+    if (level == 0)
+    {
+        result->slots.values[subIndex] = value;
+        return result;
+    }
+
+    result->slots.nodes[subIndex] = octaspire_dern_persistent_vector_private_set(
+        self,
+        result->slots.nodes[subIndex],
+        level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+        index,
+        value);
+
+    return result;
+}
+
+bool octaspire_dern_persistent_vector_set_element_at(
+    octaspire_dern_persistent_vector_t * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t * const value)
+{
+    ptrdiff_t const signedIndex = octaspire_dern_persistent_vector_private_get_index(
+        self,
+        possiblyNegativeIndex);
+
+    if (signedIndex < 0)
+    {
+        return false;
+    }
+
+    size_t const index = (size_t)signedIndex;
+
+    if (index >= octaspire_dern_persistent_vector_private_get_tail_offset(self))
+    {
+        self->tail = octaspire_dern_persistent_vector_private_node_make_unique(
+            self->tail,
+            0,
+            self->allocator);
+
+        self->tail->slots.values[index & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK] = value;
+        return true;
+    }
+
+    self->root = octaspire_dern_persistent_vector_private_set(
+        self,
+        self->root,
+        self->shift,
+        index,
+        value);
+
+    return true;
+}
+
+static octaspire_dern_persistent_vector_node_t *octaspire_dern_persistent_vector_private_new_path(
+    octaspire_dern_persistent_vector_t * const self,
+    uint32_t const level,
+    octaspire_dern_persistent_vector_node_t * const leaf)
+{
+    if (level == 0)
+    {
+        return leaf;
+    }
+
+    octaspire_dern_persistent_vector_node_t * const result =
+        octaspire_dern_persistent_vector_private_node_new(self->allocator);
+
+    result->slots.nodes[0] = octaspire_dern_persistent_vector_private_new_path(
+        self,
+        level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+        leaf);
+
+    return result;
+}
+
+static octaspire_dern_persistent_vector_node_t *octaspire_dern_persistent_vector_private_push_tail(
+    octaspire_dern_persistent_vector_t * const self,
+    octaspire_dern_persistent_vector_node_t * const node,
+    uint32_t const level,
+    octaspire_dern_persistent_vector_node_t * const leaf)
+{
+    octaspire_dern_persistent_vector_node_t * const result =
+        octaspire_dern_persistent_vector_private_node_make_unique(node, level, self->allocator);
+
+    size_t const subIndex =
+        ((self->length - 1) >> level) & OCTASPIRE_DERN_PERSISTENT_VECTOR_MASK;
+
+    octaspire_dern_persistent_vector_node_t *child = 0;
+
+    if (level == OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS)
+    {
+        child = leaf;
+    }
+    else if (result->slots.nodes[subIndex])
+    {
+        child = octaspire_dern_persistent_vector_private_push_tail(
+            self,
+            result->slots.nodes[subIndex],
+            level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+            leaf);
+    }
+    else
+    {
+        child = octaspire_dern_persistent_vector_private_new_path(
+            self,
+            level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+            leaf);
+    }
+
+    result->slots.nodes[subIndex] = child;
+    return result;
+}
+
+bool octaspire_dern_persistent_vector_push_back_element(
+    octaspire_dern_persistent_vector_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    size_t const tailLength =
+        self->length - octaspire_dern_persistent_vector_private_get_tail_offset(self);
+
+    if (tailLength < OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH)
+    {
+        self->tail = octaspire_dern_persistent_vector_private_node_make_unique(
+            self->tail,
+            0,
+            self->allocator);
+
+        self->tail->slots.values[tailLength] = value;
+        ++(self->length);
+        return true;
+    }
+
+    // The tail is full; it is moved into the trie and a new tail is started.
+    if ((self->length >> OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS) >
+        ((size_t)1 << self->shift))
+    {
+        // The trie is full; it grows one level higher.
+        octaspire_dern_persistent_vector_node_t * const newRoot =
+            octaspire_dern_persistent_vector_private_node_new(self->allocator);
+
+        newRoot->slots.nodes[0] = self->root;
+
+        newRoot->slots.nodes[1] = octaspire_dern_persistent_vector_private_new_path(
+            self,
+            self->shift,
+            self->tail);
+
+        self->root   = newRoot;
+        self->shift += OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS;
+    }
+    else
+    {
+        self->root = octaspire_dern_persistent_vector_private_push_tail(
+            self,
+            self->root,
+            self->shift,
+            self->tail);
+    }
+
+    self->tail = octaspire_dern_persistent_vector_private_node_new(self->allocator);
+    self->tail->slots.values[0] = value;
+    ++(self->length);
+
+    return true;
+}
+
+static bool octaspire_dern_persistent_vector_private_mark_node(
+    octaspire_dern_persistent_vector_node_t * const self,
+    uint32_t const level,
+    uint32_t const markEpoch)
+{
+    if (!self || self->markEpoch == markEpoch)
+    {
+        return true;
+    }
+
+    self->markEpoch = markEpoch;
+
+    bool result = true;
+
+    for (size_t i = 0; i < OCTASPIRE_DERN_PERSISTENT_VECTOR_WIDTH; ++i)
+    {
+        if (level > 0)
+        {
+            if (!octaspire_dern_persistent_vector_private_mark_node(
+                    self->slots.nodes[i],
+                    level - OCTASPIRE_DERN_PERSISTENT_VECTOR_BITS,
+                    markEpoch))
+            {
+                result = false;
+            }
+        }
+        else if (self->slots.values[i])
+        {
+            if (!octaspire_dern_value_mark(self->slots.values[i]))
+            {
+                result = false;
+            }
+        }
+    }
+
+    return result;
+}
+
+bool octaspire_dern_persistent_vector_mark(
+    octaspire_dern_persistent_vector_t * const self,
+    uint32_t const markEpoch)
+{
+    bool const rootStatus = octaspire_dern_persistent_vector_private_mark_node(
+        self->root,
+        self->shift,
+        markEpoch);
+
+    bool const tailStatus = octaspire_dern_persistent_vector_private_mark_node(
+        self->tail,
+        0,
+        markEpoch);
+
+    return rootStatus && tailStatus;
+}
+
@@ -23,6 +23,8 @@ limitations under the License.
     #include "octaspire/core/octaspire_helpers.h"
 #endif
 
+#include "octaspire/dern/octaspire_dern_helpers.h"
+
 struct octaspire_dern_port_t
 {
     octaspire_allocator_t *allocator;
@@ -52,7 +54,7 @@ octaspire_dern_port_t *octaspire_dern_port_new_copy(
     }
 
     self->allocator      = allocator;
-    self->name           = octaspire_string_new_copy(other->name, self->allocator);
+    self->name           = octaspire_dern_helpers_copy_string(other->name, self->allocator);
     self->typeTag        = other->typeTag;
     self->lengthInOctets = other->lengthInOctets;
 
@@ -0,0 +1,822 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_reader.h"
+#include <assert.h>
+#include <ctype.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_bytes.h"
+
+#ifdef OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+#define OCTASPIRE_DERN_READER_PRIVATE_CHUNK_LENGTH 16384
+
+// Form boundaries are found by following the lexical structure of the
+// octets. Every octet that has meaning here is ASCII, and octets of
+// multi-octet UTF-8 characters are never ASCII, so the text does not
+// have to be decoded.
+typedef enum octaspire_dern_reader_private_state_t
+{
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_STRING,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER_IN_STRING,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_AFTER_STRING,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_COMMENT,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT,
+    OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT_END
+}
+octaspire_dern_reader_private_state_t;
+
+struct octaspire_dern_reader_t
+{
+    octaspire_allocator_t                 *allocator;
+    octaspire_stdio_t                     *stdio;
+    FILE                                  *file;
+    octaspire_dern_reader_read_callback_t  callback;
+    void                                  *context;
+    octaspire_dern_bytes_t                *form;
+    octaspire_string_t                    *path;
+    char const                            *formOctets;
+    size_t                                 formLength;
+    char const                            *octets;
+    void                                  *mapping;
+    size_t                                 mappingLength;
+    size_t                                 chunkIndex;
+    size_t                                 chunkLength;
+    size_t                                 numOctetsRead;
+    size_t                                 lineNumber;
+    size_t                                 columnNumber;
+    size_t                                 ucsIndex;
+    size_t                                 formLineNumber;
+    size_t                                 formColumnNumber;
+    size_t                                 formUcsIndex;
+    ptrdiff_t                              depth;
+    octaspire_dern_reader_private_state_t  state;
+    bool                                   ownsFile;
+    bool                                   endOfInput;
+    bool                                   error;
+    bool                                   formStarted;
+    char                                   padding[4];
+    char                                   chunk[OCTASPIRE_DERN_READER_PRIVATE_CHUNK_LENGTH];
+};
+
+static octaspire_dern_reader_t *octaspire_dern_reader_private_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_reader_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_reader_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_reader_t));
+
+    self->allocator    = allocator;
+    self->lineNumber   = 1;
+    self->columnNumber = 1;
+    self->state        = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+    self->octets       = self->chunk;
+    self->form         = octaspire_dern_bytes_new(allocator);
+
+    if (!self->form)
+    {
+        octaspire_allocator_free(allocator, self);
+        return 0;
+    }
+
+    return self;
+}
+
+#ifdef OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES
+#ifndef _WIN32
+// Maps a regular file so that forms are read from the mapped pages
+// without copying. Returns false for pipes and other files that
+// cannot be mapped; those are read in chunks instead.
+static bool octaspire_dern_reader_private_map(
+    octaspire_dern_reader_t * const self,
+    char const * const path)
+{
+    int const fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t const length = (size_t)status.st_size;
+
+    void * const mapping = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    self->mapping       = mapping;
+    self->mappingLength = length;
+    self->octets        = mapping;
+    self->chunkLength   = length;
+    self->numOctetsRead = length;
+    self->endOfInput    = true;
+    return true;
+}
+#endif
+#endif
+
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_path(
+    char const * const path,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator)
+{
+#ifdef OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES
+#ifndef _WIN32
+    if (!octaspire_stdio_get_number_of_future_reads_to_be_rigged(stdio))
+    {
+        octaspire_dern_reader_t * const self = octaspire_dern_reader_private_new(allocator);
+
+        if (!self)
+        {
+            return self;
+        }
+
+        self->path = octaspire_string_new(path, allocator);
+
+        if (self->path && octaspire_dern_reader_private_map(self, path))
+        {
+            self->stdio = stdio;
+            return self;
+        }
+
+        octaspire_dern_reader_release(self);
+    }
+#endif
+#endif
+
+#ifdef _MSC_VER
+    FILE *file = 0;
+
+    if (fopen_s(&file, path, "rb"))
+    {
+        return 0;
+    }
+#else
+    FILE * const file = fopen(path, "rb");
+#endif
+
+    if (!file)
+    {
+        return 0;
+    }
+
+    octaspire_dern_reader_t * const self =
+        octaspire_dern_reader_new_from_file(file, stdio, allocator);
+
+    if (!self)
+    {
+        fclose(file);
+        return 0;
+    }
+
+    self->ownsFile = true;
+    self->path     = octaspire_string_new(path, allocator);
+
+    if (!self->path)
+    {
+        octaspire_dern_reader_release(self);
+        return 0;
+    }
+
+    return self;
+}
+
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_file(
+    FILE * const file,
+    octaspire_stdio_t * const stdio,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_helpers_verify_not_null(file);
+
+    octaspire_dern_reader_t * const self = octaspire_dern_reader_private_new(allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->file  = file;
+    self->stdio = stdio;
+    return self;
+}
+
+octaspire_dern_reader_t *octaspire_dern_reader_new_from_callback(
+    octaspire_dern_reader_read_callback_t const callback,
+    void * const context,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_helpers_verify_true(callback != 0);
+
+    octaspire_dern_reader_t * const self = octaspire_dern_reader_private_new(allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->callback = callback;
+    self->context  = context;
+    return self;
+}
+
+void octaspire_dern_reader_release(octaspire_dern_reader_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    if (self->ownsFile)
+    {
+        fclose(self->file);
+    }
+
+#ifdef OCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES
+#ifndef _WIN32
+    if (self->mapping)
+    {
+        munmap(self->mapping, self->mappingLength);
+    }
+#endif
+#endif
+
+    octaspire_string_release(self->path);
+    octaspire_dern_bytes_release(self->form);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+static bool octaspire_dern_reader_private_fill_chunk(
+    octaspire_dern_reader_t * const self)
+{
+    self->chunkIndex  = 0;
+    self->chunkLength = 0;
+    self->octets      = self->chunk;
+
+    if (self->endOfInput)
+    {
+        return false;
+    }
+
+    if (self->file)
+    {
+        size_t const numRead = octaspire_stdio_fread(
+            self->stdio,
+            self->chunk,
+            sizeof(char),
+            OCTASPIRE_DERN_READER_PRIVATE_CHUNK_LENGTH,
+            self->file);
+
+        if (numRead < OCTASPIRE_DERN_READER_PRIVATE_CHUNK_LENGTH)
+        {
+            self->endOfInput = true;
+            self->error      = (ferror(self->file) != 0);
+        }
+
+        self->chunkLength = numRead;
+    }
+    else
+    {
+        ptrdiff_t const numRead = self->callback(
+            self->context,
+            self->chunk,
+            OCTASPIRE_DERN_READER_PRIVATE_CHUNK_LENGTH);
+
+        if (numRead <= 0)
+        {
+            self->endOfInput = true;
+            self->error      = (numRead < 0);
+            return false;
+        }
+
+        self->chunkLength = (size_t)numRead;
+    }
+
+    self->numOctetsRead += self->chunkLength;
+    return self->chunkLength > 0;
+}
+
+// Same delimiters as in the lexer.
+static bool octaspire_dern_reader_private_is_delimiter(char const c)
+{
+    return
+        isspace((unsigned char)c) ||
+        c == '|'                  ||
+        c == '['                  ||
+        c == ']'                  ||
+        c == '('                  ||
+        c == ')'                  ||
+        c == '\'';
+}
+
+typedef enum octaspire_dern_reader_private_step_t
+{
+    // The octet belongs to the current form or to skipped text.
+    OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME,
+
+    // The octet is looked at again in the new state.
+    OCTASPIRE_DERN_READER_PRIVATE_STEP_AGAIN,
+
+    // The octet completes the form.
+    OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME_AND_END_FORM,
+
+    // The form ended before the octet.
+    OCTASPIRE_DERN_READER_PRIVATE_STEP_END_FORM
+}
+octaspire_dern_reader_private_step_t;
+
+static octaspire_dern_reader_private_step_t octaspire_dern_reader_private_end_datum(
+    octaspire_dern_reader_t * const self)
+{
+    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+
+    return (self->depth <= 0) ?
+        OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME_AND_END_FORM :
+        OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+}
+
+static octaspire_dern_reader_private_step_t octaspire_dern_reader_private_step(
+    octaspire_dern_reader_t * const self,
+    char const c)
+{
+    switch (self->state)
+    {
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START:
+        {
+            switch (c)
+            {
+                case ';':
+                {
+                    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_COMMENT;
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case '#':
+                {
+                    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN;
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case '(':
+                {
+                    ++(self->depth);
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case ')':
+                {
+                    --(self->depth);
+                    return octaspire_dern_reader_private_end_datum(self);
+                }
+
+                case '\'':
+                case '`':
+                {
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case '[':
+                {
+                    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_STRING;
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case '|':
+                {
+                    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER;
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                case '{':
+                {
+                    self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER;
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+
+                default:
+                {
+                    if (!isspace((unsigned char)c))
+                    {
+                        self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM;
+                    }
+
+                    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+                }
+            }
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM:
+        {
+            if (!octaspire_dern_reader_private_is_delimiter(c))
+            {
+                return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+            }
+
+            self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+
+            return (self->depth <= 0) ?
+                OCTASPIRE_DERN_READER_PRIVATE_STEP_END_FORM :
+                OCTASPIRE_DERN_READER_PRIVATE_STEP_AGAIN;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN:
+        {
+            if (c == '!')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT;
+                return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+            }
+
+            self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM;
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_AGAIN;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_STRING:
+        {
+            if (c == '|')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER_IN_STRING;
+            }
+            else if (c == ']')
+            {
+                // The lexer requires a delimiter after a string, so at the
+                // top level the form ends only at the next delimiter.
+                self->state = (self->depth <= 0) ?
+                    OCTASPIRE_DERN_READER_PRIVATE_STATE_AFTER_STRING :
+                    OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER_IN_STRING:
+        {
+            if (c == '|')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_STRING;
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_AFTER_STRING:
+        {
+            if (octaspire_dern_reader_private_is_delimiter(c))
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+                return OCTASPIRE_DERN_READER_PRIVATE_STEP_END_FORM;
+            }
+
+            self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM;
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER:
+        {
+            if (c == '|')
+            {
+                return octaspire_dern_reader_private_end_datum(self);
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER:
+        {
+            if (c == '}')
+            {
+                return octaspire_dern_reader_private_end_datum(self);
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_COMMENT:
+        {
+            if (c == '\n')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT:
+        {
+            if (c == '!')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT_END;
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT_END:
+        {
+            if (c == '#')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+            }
+            else if (c != '!')
+            {
+                self->state = OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT;
+            }
+
+            return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+        }
+    }
+
+    abort();
+    return OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME;
+}
+
+// Text between top-level forms is white space or comments. A '#' there
+// can start a comment or a symbol, so it is added to the form only when
+// the next octet shows that it starts a symbol.
+static bool octaspire_dern_reader_private_is_skipped(
+    octaspire_dern_reader_private_state_t const previousState,
+    char const c)
+{
+    switch (previousState)
+    {
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START:
+        {
+            return isspace((unsigned char)c) || c == ';' || c == '#';
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN:
+        {
+            return c == '!';
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_COMMENT:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_MULTILINE_COMMENT_END:
+        {
+            return true;
+        }
+
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_ATOM:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_STRING:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER_IN_STRING:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_AFTER_STRING:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_CHARACTER:
+        case OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER:
+        {
+            return false;
+        }
+    }
+
+    abort();
+    return false;
+}
+
+// Columns and indices are counted in characters, as the lexer counts
+// them, so continuation octets of UTF-8 are not counted.
+static void octaspire_dern_reader_private_count_position(
+    octaspire_dern_reader_t * const self,
+    char const c)
+{
+    if ((c & 0xC0) != 0x80)
+    {
+        ++(self->ucsIndex);
+    }
+
+    if (c == '\n')
+    {
+        ++(self->lineNumber);
+        self->columnNumber = 1;
+    }
+    else if ((c & 0xC0) != 0x80)
+    {
+        ++(self->columnNumber);
+    }
+}
+
+bool octaspire_dern_reader_read_next_form(octaspire_dern_reader_t * const self)
+{
+    octaspire_dern_bytes_clear(self->form);
+    self->formOctets  = 0;
+    self->formLength  = 0;
+    self->formStarted = false;
+    self->depth       = 0;
+
+    while (true)
+    {
+        if (self->chunkIndex >= self->chunkLength &&
+            !octaspire_dern_reader_private_fill_chunk(self))
+        {
+            // Incomplete form at the end of input is given to the lexer
+            // as it is, so that the error is reported as for any input.
+            if (!self->formStarted &&
+                self->state == OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN)
+            {
+                // Number sign was on this line, just before this column.
+                self->formStarted      = true;
+                self->formLineNumber   = self->lineNumber;
+                self->formColumnNumber = self->columnNumber - 1;
+                self->formUcsIndex     = self->ucsIndex - 1;
+
+                if (!octaspire_dern_bytes_push_back_octet(self->form, '#'))
+                {
+                    self->error = true;
+                }
+            }
+
+            self->state      = OCTASPIRE_DERN_READER_PRIVATE_STATE_TOKEN_START;
+            self->formOctets = (char const*)octaspire_dern_bytes_get_octets(self->form);
+            self->formLength = octaspire_dern_bytes_get_length(self->form);
+            return self->formStarted && !self->error;
+        }
+
+        // Octets of the form in this chunk are added to the form at once.
+        // A form that is completely in one chunk, or in the mapped file,
+        // is not copied at all.
+        size_t runStart = self->chunkIndex;
+
+        while (self->chunkIndex < self->chunkLength)
+        {
+            char const c = self->octets[self->chunkIndex];
+
+            octaspire_dern_reader_private_state_t const previousState = self->state;
+
+            octaspire_dern_reader_private_step_t const step =
+                octaspire_dern_reader_private_step(self, c);
+
+            if (!self->formStarted)
+            {
+                if (octaspire_dern_reader_private_is_skipped(previousState, c))
+                {
+                    octaspire_dern_reader_private_count_position(self, c);
+                    ++(self->chunkIndex);
+                    runStart = self->chunkIndex;
+                    continue;
+                }
+
+                self->formStarted      = true;
+                self->formLineNumber   = self->lineNumber;
+                self->formColumnNumber = self->columnNumber;
+                self->formUcsIndex     = self->ucsIndex;
+                runStart               = self->chunkIndex;
+
+                if (previousState == OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN)
+                {
+                    --(self->formColumnNumber);
+                    --(self->formUcsIndex);
+                }
+
+                if (previousState == OCTASPIRE_DERN_READER_PRIVATE_STATE_NUMBER_SIGN &&
+                    !octaspire_dern_bytes_push_back_octet(self->form, '#'))
+                {
+                    self->error = true;
+                    return false;
+                }
+            }
+
+            if (step == OCTASPIRE_DERN_READER_PRIVATE_STEP_AGAIN)
+            {
+                continue;
+            }
+
+            if (step != OCTASPIRE_DERN_READER_PRIVATE_STEP_END_FORM)
+            {
+                octaspire_dern_reader_private_count_position(self, c);
+                ++(self->chunkIndex);
+            }
+
+            if (step == OCTASPIRE_DERN_READER_PRIVATE_STEP_END_FORM ||
+                step == OCTASPIRE_DERN_READER_PRIVATE_STEP_CONSUME_AND_END_FORM)
+            {
+                if (octaspire_dern_bytes_get_length(self->form) == 0)
+                {
+                    self->formOctets = self->octets + runStart;
+                    self->formLength = self->chunkIndex - runStart;
+                    return true;
+                }
+
+                if (!octaspire_dern_bytes_push_back_buffer(
+                        self->form,
+                        self->octets + runStart,
+                        self->chunkIndex - runStart))
+                {
+                    self->error = true;
+                    return false;
+                }
+
+                self->formOctets = (char const*)octaspire_dern_bytes_get_octets(self->form);
+                self->formLength = octaspire_dern_bytes_get_length(self->form);
+                return true;
+            }
+        }
+
+        if (self->formStarted &&
+            !octaspire_dern_bytes_push_back_buffer(
+                self->form,
+                self->octets + runStart,
+                self->chunkIndex - runStart))
+        {
+            self->error = true;
+            return false;
+        }
+    }
+}
+
+char const *octaspire_dern_reader_get_form_octets(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->formOctets;
+}
+
+size_t octaspire_dern_reader_get_form_length_in_octets(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->formLength;
+}
+
+size_t octaspire_dern_reader_get_form_line_number(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->formLineNumber;
+}
+
+size_t octaspire_dern_reader_get_form_column_number(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->formColumnNumber;
+}
+
+size_t octaspire_dern_reader_get_form_ucs_index(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->formUcsIndex;
+}
+
+size_t octaspire_dern_reader_get_number_of_octets_read(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->numOctetsRead;
+}
+
+bool octaspire_dern_reader_has_error(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->error;
+}
+
+char const *octaspire_dern_reader_get_path(
+    octaspire_dern_reader_t const * const self)
+{
+    return self->path ? octaspire_string_get_c_string(self->path) : 0;
+}
+
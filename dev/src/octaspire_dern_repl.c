@@ -15,6 +15,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ******************************************************************************/
 #include "octaspire/dern/octaspire_dern_vm.h"
+#include "octaspire/dern/octaspire_dern_image.h"
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
@@ -189,6 +190,8 @@ void octaspire_dern_repl_print_usage(char const * const binaryName, bool const u
         "-c        --color-diagnostics : use colors on unix like systems\n"
         "-i        --interactive       : start REPL after any -e string or [file]s are evaluated\n"
         "-I dir    --include dir       : Search this directory for source (.dern) libraries\n"
+        "-F dir    --fasl-cache dir    : keep parsed forms of source libraries in this directory\n"
+        "-m file   --image file        : start from an image saved with 'save-image'\n"
         "-e string --evaluate string   : evaluate a string without entering the REPL (see -i)\n"
         "-v        --version           : print version information and exit\n"
         "-h        --help              : print this help message and exit\n"
@@ -257,6 +260,9 @@ void main(int argc, char *argv[])
     bool enterReplAlways         = false;
     bool evaluate                = false;
     bool include                 = false;
+    bool faslCache               = false;
+    bool image                   = false;
+    char const *imagePath        = 0;
 
     octaspire_dern_vm_config_t vmConfig = octaspire_dern_vm_config_default();
 
@@ -369,6 +375,18 @@ void main(int argc, char *argv[])
                 octaspire_vector_push_back_element(includeDirectories, &tmp);
                 vmConfig.includeDirectories = includeDirectories;
             }
+            else if (faslCache)
+            {
+                faslCache = false;
+
+                vmConfig.faslCacheOn        = true;
+                vmConfig.faslCacheDirectory = argv[i];
+            }
+            else if (image)
+            {
+                image     = false;
+                imagePath = argv[i];
+            }
             else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--color-diagnostics") == 0)
             {
                 useColors = true;
@@ -381,6 +399,14 @@ void main(int argc, char *argv[])
             {
                 include = true;
             }
+            else if (strcmp(argv[i], "-F") == 0 || strcmp(argv[i], "--fasl-cache") == 0)
+            {
+                faslCache = true;
+            }
+            else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--image") == 0)
+            {
+                image = true;
+            }
             else if (strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "--evaluate") == 0)
             {
                 evaluate = true;
@@ -441,6 +467,31 @@ void main(int argc, char *argv[])
     input = octaspire_input_new_from_c_string("", allocator);
     vm    = octaspire_dern_vm_new_with_config(allocator, stdio, vmConfig);
 
+    // Image is restored before any strings or files are evaluated.
+    if (imagePath)
+    {
+        octaspire_dern_value_t * const value = octaspire_dern_image_load(vm, imagePath);
+
+        if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_string_t *tmpStr =
+                octaspire_dern_value_to_string(value, allocator);
+
+            octaspire_dern_repl_print_message(
+                tmpStr,
+                OCTASPIRE_DERN_REPL_MESSAGE_ERROR,
+                useColors,
+                input);
+
+            printf("\n");
+
+            octaspire_string_release(tmpStr);
+            tmpStr = 0;
+
+            exit(EXIT_FAILURE);
+        }
+    }
+
 #ifndef OCTASPIRE_PLAN9_IMPLEMENTATION
 #ifndef _WIN32
     #ifndef __amigaos__
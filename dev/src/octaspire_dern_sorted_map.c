@@ -0,0 +1,956 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_sorted_map.h"
+#include <assert.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_value.h"
+
+// Maximum number of keys in a node. Keys of a node fill a few cache
+// lines and are searched with a binary search.
+#define OCTASPIRE_DERN_SORTED_MAP_ORDER 32
+
+typedef struct octaspire_dern_sorted_map_private_node_t
+{
+    octaspire_dern_value_t *keys[OCTASPIRE_DERN_SORTED_MAP_ORDER];
+    size_t                  numKeys;
+    bool                    isLeaf;
+    char                    padding[7];
+}
+octaspire_dern_sorted_map_private_node_t;
+
+struct octaspire_dern_sorted_map_private_leaf_t
+{
+    octaspire_dern_sorted_map_private_node_t  node;
+    octaspire_dern_value_t                   *values[OCTASPIRE_DERN_SORTED_MAP_ORDER];
+    octaspire_dern_sorted_map_private_leaf_t *previous;
+    octaspire_dern_sorted_map_private_leaf_t *next;
+};
+
+// Inner node with 'n' keys has 'n + 1' children. Child 'i' holds the
+// keys from 'keys[i - 1]' up to, but not including, 'keys[i]'.
+typedef struct octaspire_dern_sorted_map_private_inner_t
+{
+    octaspire_dern_sorted_map_private_node_t  node;
+    octaspire_dern_sorted_map_private_node_t *children[OCTASPIRE_DERN_SORTED_MAP_ORDER + 1];
+
+    // Number of elements in the subtree of each child.
+    size_t                                    counts[OCTASPIRE_DERN_SORTED_MAP_ORDER + 1];
+}
+octaspire_dern_sorted_map_private_inner_t;
+
+// Only the root leaf can be empty; other nodes are released when they
+// lose their last element, and are not merged otherwise.
+struct octaspire_dern_sorted_map_t
+{
+    octaspire_dern_sorted_map_private_node_t *root;
+    octaspire_allocator_t                    *allocator;
+    size_t                                    numElements;
+};
+
+static octaspire_dern_sorted_map_private_leaf_t *octaspire_dern_sorted_map_private_new_leaf(
+    octaspire_dern_sorted_map_t * const self)
+{
+    octaspire_dern_sorted_map_private_leaf_t * const leaf = octaspire_allocator_malloc(
+        self->allocator,
+        sizeof(octaspire_dern_sorted_map_private_leaf_t));
+
+    if (!leaf)
+    {
+        return leaf;
+    }
+
+    memset(leaf, 0, sizeof(octaspire_dern_sorted_map_private_leaf_t));
+    leaf->node.isLeaf = true;
+    return leaf;
+}
+
+static octaspire_dern_sorted_map_private_inner_t *octaspire_dern_sorted_map_private_new_inner(
+    octaspire_dern_sorted_map_t * const self)
+{
+    octaspire_dern_sorted_map_private_inner_t * const inner = octaspire_allocator_malloc(
+        self->allocator,
+        sizeof(octaspire_dern_sorted_map_private_inner_t));
+
+    if (!inner)
+    {
+        return inner;
+    }
+
+    memset(inner, 0, sizeof(octaspire_dern_sorted_map_private_inner_t));
+    return inner;
+}
+
+static void octaspire_dern_sorted_map_private_release_node(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_sorted_map_private_node_t * const node)
+{
+    if (!node->isLeaf)
+    {
+        octaspire_dern_sorted_map_private_inner_t * const inner =
+            (octaspire_dern_sorted_map_private_inner_t*)node;
+
+        for (size_t i = 0; i <= node->numKeys; ++i)
+        {
+            octaspire_dern_sorted_map_private_release_node(self, inner->children[i]);
+        }
+    }
+
+    octaspire_allocator_free(self->allocator, node);
+}
+
+static size_t octaspire_dern_sorted_map_private_get_count(
+    octaspire_dern_sorted_map_private_node_t const * const node)
+{
+    if (node->isLeaf)
+    {
+        return node->numKeys;
+    }
+
+    octaspire_dern_sorted_map_private_inner_t const * const inner =
+        (octaspire_dern_sorted_map_private_inner_t const*)node;
+
+    size_t result = 0;
+
+    for (size_t i = 0; i <= node->numKeys; ++i)
+    {
+        result += inner->counts[i];
+    }
+
+    return result;
+}
+
+// Index of the first key not less than 'key'.
+static size_t octaspire_dern_sorted_map_private_lower_bound(
+    octaspire_dern_sorted_map_private_node_t const * const node,
+    octaspire_dern_value_t const * const key)
+{
+    size_t first = 0;
+    size_t last  = node->numKeys;
+
+    while (first < last)
+    {
+        size_t const middle = first + (last - first) / 2;
+
+        if (octaspire_dern_value_compare(node->keys[middle], key) < 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+// Index of the first key greater than 'key'.
+static size_t octaspire_dern_sorted_map_private_upper_bound(
+    octaspire_dern_sorted_map_private_node_t const * const node,
+    octaspire_dern_value_t const * const key)
+{
+    size_t first = 0;
+    size_t last  = node->numKeys;
+
+    while (first < last)
+    {
+        size_t const middle = first + (last - first) / 2;
+
+        if (octaspire_dern_value_compare(node->keys[middle], key) <= 0)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+static octaspire_dern_sorted_map_private_leaf_t const *octaspire_dern_sorted_map_private_find_leaf(
+    octaspire_dern_sorted_map_t const * const self,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_dern_sorted_map_private_node_t const *node = self->root;
+
+    while (!node->isLeaf)
+    {
+        octaspire_dern_sorted_map_private_inner_t const * const inner =
+            (octaspire_dern_sorted_map_private_inner_t const*)node;
+
+        node = inner->children[octaspire_dern_sorted_map_private_upper_bound(node, key)];
+    }
+
+    return (octaspire_dern_sorted_map_private_leaf_t const*)node;
+}
+
+static bool octaspire_dern_sorted_map_private_insert_into_leaf(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_sorted_map_private_leaf_t * const leaf,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value,
+    bool const isRightmost,
+    bool * const added,
+    octaspire_dern_sorted_map_private_node_t ** const sibling,
+    octaspire_dern_value_t ** const separator)
+{
+    octaspire_dern_sorted_map_private_node_t * const node = &(leaf->node);
+
+    size_t const position = octaspire_dern_sorted_map_private_lower_bound(node, key);
+
+    if (position < node->numKeys &&
+        octaspire_dern_value_compare(node->keys[position], key) == 0)
+    {
+        // Key is kept, because inner nodes can refer to it.
+        leaf->values[position] = value;
+        return true;
+    }
+
+    *added = true;
+
+    size_t const numMoved = node->numKeys - position;
+
+    if (node->numKeys < OCTASPIRE_DERN_SORTED_MAP_ORDER)
+    {
+        memmove(
+            &(node->keys[position + 1]),
+            &(node->keys[position]),
+            sizeof(octaspire_dern_value_t*) * numMoved);
+
+        memmove(
+            &(leaf->values[position + 1]),
+            &(leaf->values[position]),
+            sizeof(octaspire_dern_value_t*) * numMoved);
+
+        node->keys[position]   = key;
+        leaf->values[position] = value;
+        ++(node->numKeys);
+        return true;
+    }
+
+    octaspire_dern_sorted_map_private_leaf_t * const right =
+        octaspire_dern_sorted_map_private_new_leaf(self);
+
+    if (!right)
+    {
+        return false;
+    }
+
+    size_t const numAll = OCTASPIRE_DERN_SORTED_MAP_ORDER + 1;
+
+    octaspire_dern_value_t *keys[OCTASPIRE_DERN_SORTED_MAP_ORDER + 1];
+    octaspire_dern_value_t *values[OCTASPIRE_DERN_SORTED_MAP_ORDER + 1];
+
+    memcpy(keys,   node->keys,   sizeof(octaspire_dern_value_t*) * position);
+    memcpy(values, leaf->values, sizeof(octaspire_dern_value_t*) * position);
+
+    keys[position]   = key;
+    values[position] = value;
+
+    memcpy(
+        &(keys[position + 1]),
+        &(node->keys[position]),
+        sizeof(octaspire_dern_value_t*) * numMoved);
+
+    memcpy(
+        &(values[position + 1]),
+        &(leaf->values[position]),
+        sizeof(octaspire_dern_value_t*) * numMoved);
+
+    // Appending to the end of the map keeps the left node full instead of
+    // splitting it in half, because more keys are likely to follow.
+    size_t const numLeft =
+        (isRightmost && position == OCTASPIRE_DERN_SORTED_MAP_ORDER) ?
+            OCTASPIRE_DERN_SORTED_MAP_ORDER :
+            numAll / 2;
+
+    memcpy(node->keys,   keys,   sizeof(octaspire_dern_value_t*) * numLeft);
+    memcpy(leaf->values, values, sizeof(octaspire_dern_value_t*) * numLeft);
+    node->numKeys = numLeft;
+
+    memcpy(right->node.keys, &(keys[numLeft]),   sizeof(octaspire_dern_value_t*) * (numAll - numLeft));
+    memcpy(right->values,    &(values[numLeft]), sizeof(octaspire_dern_value_t*) * (numAll - numLeft));
+    right->node.numKeys = numAll - numLeft;
+
+    right->previous = leaf;
+    right->next     = leaf->next;
+
+    if (leaf->next)
+    {
+        leaf->next->previous = right;
+    }
+
+    leaf->next = right;
+
+    *sibling   = &(right->node);
+    *separator = right->node.keys[0];
+    return true;
+}
+
+static bool octaspire_dern_sorted_map_private_insert(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_sorted_map_private_node_t * const node,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value,
+    bool const isRightmost,
+    bool * const added,
+    octaspire_dern_sorted_map_private_node_t ** const sibling,
+    octaspire_dern_value_t ** const separator)
+{
+    if (node->isLeaf)
+    {
+        return octaspire_dern_sorted_map_private_insert_into_leaf(
+            self,
+            (octaspire_dern_sorted_map_private_leaf_t*)node,
+            key,
+            value,
+            isRightmost,
+            added,
+            sibling,
+            separator);
+    }
+
+    octaspire_dern_sorted_map_private_inner_t * const inner =
+        (octaspire_dern_sorted_map_private_inner_t*)node;
+
+    size_t const index = octaspire_dern_sorted_map_private_upper_bound(node, key);
+
+    octaspire_dern_sorted_map_private_node_t *childSibling   = 0;
+    octaspire_dern_value_t                   *childSeparator = 0;
+
+    if (!octaspire_dern_sorted_map_private_insert(
+            self,
+            inner->children[index],
+            key,
+            value,
+            isRightmost && index == node->numKeys,
+            added,
+            &childSibling,
+            &childSeparator))
+    {
+        return false;
+    }
+
+    if (*added)
+    {
+        ++(inner->counts[index]);
+    }
+
+    if (!childSibling)
+    {
+        return true;
+    }
+
+    size_t const siblingCount =
+        octaspire_dern_sorted_map_private_get_count(childSibling);
+
+    inner->counts[index] -= siblingCount;
+
+    size_t const numMoved = node->numKeys - index;
+
+    if (node->numKeys < OCTASPIRE_DERN_SORTED_MAP_ORDER)
+    {
+        memmove(
+            &(node->keys[index + 1]),
+            &(node->keys[index]),
+            sizeof(octaspire_dern_value_t*) * numMoved);
+
+        memmove(
+            &(inner->children[index + 2]),
+            &(inner->children[index + 1]),
+            sizeof(octaspire_dern_sorted_map_private_node_t*) * numMoved);
+
+        memmove(
+            &(inner->counts[index + 2]),
+            &(inner->counts[index + 1]),
+            sizeof(size_t) * numMoved);
+
+        node->keys[index]            = childSeparator;
+        inner->children[index + 1]   = childSibling;
+        inner->counts[index + 1]     = siblingCount;
+        ++(node->numKeys);
+        return true;
+    }
+
+    octaspire_dern_sorted_map_private_inner_t * const right =
+        octaspire_dern_sorted_map_private_new_inner(self);
+
+    if (!right)
+    {
+        return false;
+    }
+
+    size_t const numAllKeys = OCTASPIRE_DERN_SORTED_MAP_ORDER + 1;
+
+    octaspire_dern_value_t                   *keys[OCTASPIRE_DERN_SORTED_MAP_ORDER + 1];
+    octaspire_dern_sorted_map_private_node_t *children[OCTASPIRE_DERN_SORTED_MAP_ORDER + 2];
+    size_t                                    counts[OCTASPIRE_DERN_SORTED_MAP_ORDER + 2];
+
+    memcpy(keys, node->keys, sizeof(octaspire_dern_value_t*) * index);
+    keys[index] = childSeparator;
+
+    memcpy(
+        &(keys[index + 1]),
+        &(node->keys[index]),
+        sizeof(octaspire_dern_value_t*) * numMoved);
+
+    memcpy(
+        children,
+        inner->children,
+        sizeof(octaspire_dern_sorted_map_private_node_t*) * (index + 1));
+
+    memcpy(counts, inner->counts, sizeof(size_t) * (index + 1));
+
+    children[index + 1] = childSibling;
+    counts[index + 1]   = siblingCount;
+
+    memcpy(
+        &(children[index + 2]),
+        &(inner->children[index + 1]),
+        sizeof(octaspire_dern_sorted_map_private_node_t*) * numMoved);
+
+    memcpy(&(counts[index + 2]), &(inner->counts[index + 1]), sizeof(size_t) * numMoved);
+
+    // Key at 'middle' moves up to the parent. As with leaves, appending
+    // keeps the left node full.
+    size_t const middle =
+        (isRightmost && index == OCTASPIRE_DERN_SORTED_MAP_ORDER) ?
+            OCTASPIRE_DERN_SORTED_MAP_ORDER :
+            numAllKeys / 2;
+
+    memcpy(node->keys, keys, sizeof(octaspire_dern_value_t*) * middle);
+
+    memcpy(
+        inner->children,
+        children,
+        sizeof(octaspire_dern_sorted_map_private_node_t*) * (middle + 1));
+
+    memcpy(inner->counts, counts, sizeof(size_t) * (middle + 1));
+    node->numKeys = middle;
+
+    size_t const numRightKeys = numAllKeys - middle - 1;
+
+    memcpy(
+        right->node.keys,
+        &(keys[middle + 1]),
+        sizeof(octaspire_dern_value_t*) * numRightKeys);
+
+    memcpy(
+        right->children,
+        &(children[middle + 1]),
+        sizeof(octaspire_dern_sorted_map_private_node_t*) * (numRightKeys + 1));
+
+    memcpy(right->counts, &(counts[middle + 1]), sizeof(size_t) * (numRightKeys + 1));
+    right->node.numKeys = numRightKeys;
+
+    *sibling   = &(right->node);
+    *separator = keys[middle];
+    return true;
+}
+
+static octaspire_dern_value_t *octaspire_dern_sorted_map_private_get_first_key(
+    octaspire_dern_sorted_map_private_node_t const *node)
+{
+    while (!node->isLeaf)
+    {
+        node = ((octaspire_dern_sorted_map_private_inner_t const*)node)->children[0];
+    }
+
+    return node->keys[0];
+}
+
+// Removes 'key' from the subtree of 'node'. 'isEmpty' tells whether
+// the node has no elements left.
+static bool octaspire_dern_sorted_map_private_remove(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_sorted_map_private_node_t * const node,
+    octaspire_dern_value_t const * const key,
+    bool * const isEmpty)
+{
+    if (node->isLeaf)
+    {
+        octaspire_dern_sorted_map_private_leaf_t * const leaf =
+            (octaspire_dern_sorted_map_private_leaf_t*)node;
+
+        size_t const position = octaspire_dern_sorted_map_private_lower_bound(node, key);
+
+        if (position >= node->numKeys ||
+            octaspire_dern_value_compare(node->keys[position], key) != 0)
+        {
+            return false;
+        }
+
+        size_t const numMoved = node->numKeys - position - 1;
+
+        memmove(
+            &(node->keys[position]),
+            &(node->keys[position + 1]),
+            sizeof(octaspire_dern_value_t*) * numMoved);
+
+        memmove(
+            &(leaf->values[position]),
+            &(leaf->values[position + 1]),
+            sizeof(octaspire_dern_value_t*) * numMoved);
+
+        --(node->numKeys);
+        *isEmpty = (node->numKeys == 0);
+        return true;
+    }
+
+    octaspire_dern_sorted_map_private_inner_t * const inner =
+        (octaspire_dern_sorted_map_private_inner_t*)node;
+
+    size_t const index = octaspire_dern_sorted_map_private_upper_bound(node, key);
+
+    octaspire_dern_sorted_map_private_node_t * const child = inner->children[index];
+
+    bool childIsEmpty = false;
+
+    if (!octaspire_dern_sorted_map_private_remove(self, child, key, &childIsEmpty))
+    {
+        return false;
+    }
+
+    --(inner->counts[index]);
+
+    if (!childIsEmpty)
+    {
+        // Keys of inner nodes must be keys of the map, because the map
+        // does not own its keys. Removed key is replaced with the next one.
+        if (index > 0 && octaspire_dern_value_compare(node->keys[index - 1], key) == 0)
+        {
+            node->keys[index - 1] = octaspire_dern_sorted_map_private_get_first_key(child);
+        }
+
+        return true;
+    }
+
+    if (child->isLeaf)
+    {
+        octaspire_dern_sorted_map_private_leaf_t * const leaf =
+            (octaspire_dern_sorted_map_private_leaf_t*)child;
+
+        if (leaf->previous)
+        {
+            leaf->previous->next = leaf->next;
+        }
+
+        if (leaf->next)
+        {
+            leaf->next->previous = leaf->previous;
+        }
+    }
+
+    // Empty inner child has no children left to release.
+    octaspire_allocator_free(self->allocator, child);
+
+    if (node->numKeys == 0)
+    {
+        *isEmpty = true;
+        return true;
+    }
+
+    size_t const keyIndex = (index > 0) ? (index - 1) : 0;
+
+    memmove(
+        &(node->keys[keyIndex]),
+        &(node->keys[keyIndex + 1]),
+        sizeof(octaspire_dern_value_t*) * (node->numKeys - keyIndex - 1));
+
+    memmove(
+        &(inner->children[index]),
+        &(inner->children[index + 1]),
+        sizeof(octaspire_dern_sorted_map_private_node_t*) * (node->numKeys - index));
+
+    memmove(
+        &(inner->counts[index]),
+        &(inner->counts[index + 1]),
+        sizeof(size_t) * (node->numKeys - index));
+
+    --(node->numKeys);
+    return true;
+}
+
+octaspire_dern_sorted_map_t *octaspire_dern_sorted_map_new(
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_sorted_map_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_sorted_map_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    self->allocator   = allocator;
+    self->numElements = 0;
+
+    octaspire_dern_sorted_map_private_leaf_t * const root =
+        octaspire_dern_sorted_map_private_new_leaf(self);
+
+    if (!root)
+    {
+        octaspire_allocator_free(allocator, self);
+        return 0;
+    }
+
+    self->root = &(root->node);
+    return self;
+}
+
+void octaspire_dern_sorted_map_release(octaspire_dern_sorted_map_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_dern_sorted_map_private_release_node(self, self->root);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+size_t octaspire_dern_sorted_map_get_number_of_elements(
+    octaspire_dern_sorted_map_t const * const self)
+{
+    return self->numElements;
+}
+
+bool octaspire_dern_sorted_map_put(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
+{
+    bool                                      added     = false;
+    octaspire_dern_sorted_map_private_node_t *sibling   = 0;
+    octaspire_dern_value_t                   *separator = 0;
+
+    if (!octaspire_dern_sorted_map_private_insert(
+            self,
+            self->root,
+            key,
+            value,
+            true,
+            &added,
+            &sibling,
+            &separator))
+    {
+        return false;
+    }
+
+    if (added)
+    {
+        ++(self->numElements);
+    }
+
+    if (!sibling)
+    {
+        return true;
+    }
+
+    octaspire_dern_sorted_map_private_inner_t * const root =
+        octaspire_dern_sorted_map_private_new_inner(self);
+
+    if (!root)
+    {
+        return false;
+    }
+
+    root->node.keys[0] = separator;
+    root->node.numKeys = 1;
+    root->children[0]  = self->root;
+    root->children[1]  = sibling;
+    root->counts[0]    = octaspire_dern_sorted_map_private_get_count(self->root);
+    root->counts[1]    = octaspire_dern_sorted_map_private_get_count(sibling);
+
+    self->root = &(root->node);
+    return true;
+}
+
+bool octaspire_dern_sorted_map_remove(
+    octaspire_dern_sorted_map_t * const self,
+    octaspire_dern_value_t const * const key)
+{
+    bool isEmpty = false;
+
+    if (!octaspire_dern_sorted_map_private_remove(self, self->root, key, &isEmpty))
+    {
+        return false;
+    }
+
+    --(self->numElements);
+
+    if (isEmpty && !self->root->isLeaf)
+    {
+        octaspire_allocator_free(self->allocator, self->root);
+
+        octaspire_dern_sorted_map_private_leaf_t * const root =
+            octaspire_dern_sorted_map_private_new_leaf(self);
+
+        octaspire_helpers_verify_not_null(root);
+
+        self->root = &(root->node);
+        return true;
+    }
+
+    // Root with only one child is not needed.
+    while (!self->root->isLeaf && self->root->numKeys == 0)
+    {
+        octaspire_dern_sorted_map_private_node_t * const child =
+            ((octaspire_dern_sorted_map_private_inner_t*)self->root)->children[0];
+
+        octaspire_allocator_free(self->allocator, self->root);
+        self->root = child;
+    }
+
+    return true;
+}
+
+void octaspire_dern_sorted_map_clear(
+    octaspire_dern_sorted_map_t * const self)
+{
+    self->numElements = 0;
+
+    if (self->root->isLeaf)
+    {
+        self->root->numKeys = 0;
+        return;
+    }
+
+    octaspire_dern_sorted_map_private_release_node(self, self->root);
+
+    octaspire_dern_sorted_map_private_leaf_t * const root =
+        octaspire_dern_sorted_map_private_new_leaf(self);
+
+    octaspire_helpers_verify_not_null(root);
+
+    self->root = &(root->node);
+}
+
+static bool octaspire_dern_sorted_map_private_set_results(
+    octaspire_dern_sorted_map_private_leaf_t const * const leaf,
+    size_t const index,
+    octaspire_dern_value_t ** const foundKey,
+    octaspire_dern_value_t ** const foundValue)
+{
+    if (foundKey)
+    {
+        *foundKey = leaf->node.keys[index];
+    }
+
+    if (foundValue)
+    {
+        *foundValue = leaf->values[index];
+    }
+
+    return true;
+}
+
+bool octaspire_dern_sorted_map_get(
+    octaspire_dern_sorted_map_t const * const self,
+    octaspire_dern_value_t const * const key,
+    octaspire_dern_value_t ** const foundKey,
+    octaspire_dern_value_t ** const foundValue)
+{
+    octaspire_dern_sorted_map_private_leaf_t const * const leaf =
+        octaspire_dern_sorted_map_private_find_leaf(self, key);
+
+    size_t const position = octaspire_dern_sorted_map_private_lower_bound(&(leaf->node), key);
+
+    if (position >= leaf->node.numKeys ||
+        octaspire_dern_value_compare(leaf->node.keys[position], key) != 0)
+    {
+        return false;
+    }
+
+    return octaspire_dern_sorted_map_private_set_results(
+        leaf,
+        position,
+        foundKey,
+        foundValue);
+}
+
+bool octaspire_dern_sorted_map_get_floor(
+    octaspire_dern_sorted_map_t const * const self,
+    octaspire_dern_value_t const * const key,
+    octaspire_dern_value_t ** const foundKey,
+    octaspire_dern_value_t ** const foundValue)
+{
+    octaspire_dern_sorted_map_private_leaf_t const * const leaf =
+        octaspire_dern_sorted_map_private_find_leaf(self, key);
+
+    size_t const position = octaspire_dern_sorted_map_private_upper_bound(&(leaf->node), key);
+
+    if (position > 0)
+    {
+        return octaspire_dern_sorted_map_private_set_results(
+            leaf,
+            position - 1,
+            foundKey,
+            foundValue);
+    }
+
+    // All keys of the leaf are greater; the floor is the last key of the
+    // previous leaf, if there is one.
+    if (!leaf->previous)
+    {
+        return false;
+    }
+
+    return octaspire_dern_sorted_map_private_set_results(
+        leaf->previous,
+        leaf->previous->node.numKeys - 1,
+        foundKey,
+        foundValue);
+}
+
+bool octaspire_dern_sorted_map_get_ceiling(
+    octaspire_dern_sorted_map_t const * const self,
+    octaspire_dern_value_t const * const key,
+    octaspire_dern_value_t ** const foundKey,
+    octaspire_dern_value_t ** const foundValue)
+{
+    octaspire_dern_sorted_map_iterator_t const iter =
+        octaspire_dern_sorted_map_iterator_init_at_ceiling(self, key);
+
+    if (!iter.key)
+    {
+        return false;
+    }
+
+    return octaspire_dern_sorted_map_private_set_results(
+        iter.leaf,
+        iter.index,
+        foundKey,
+        foundValue);
+}
+
+bool octaspire_dern_sorted_map_get_at_index(
+    octaspire_dern_sorted_map_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t ** const foundKey,
+    octaspire_dern_value_t ** const foundValue)
+{
+    ptrdiff_t const signedIndex = (possiblyNegativeIndex < 0) ?
+        ((ptrdiff_t)self->numElements + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (signedIndex < 0 || (size_t)signedIndex >= self->numElements)
+    {
+        return false;
+    }
+
+    size_t                                          index = (size_t)signedIndex;
+    octaspire_dern_sorted_map_private_node_t const *node  = self->root;
+
+    while (!node->isLeaf)
+    {
+        octaspire_dern_sorted_map_private_inner_t const * const inner =
+            (octaspire_dern_sorted_map_private_inner_t const*)node;
+
+        size_t i = 0;
+
+        while (index >= inner->counts[i])
+        {
+            index -= inner->counts[i];
+            ++i;
+        }
+
+        node = inner->children[i];
+    }
+
+    return octaspire_dern_sorted_map_private_set_results(
+        (octaspire_dern_sorted_map_private_leaf_t const*)node,
+        index,
+        foundKey,
+        foundValue);
+}
+
+static void octaspire_dern_sorted_map_private_iterator_update(
+    octaspire_dern_sorted_map_iterator_t * const self)
+{
+    if (self->leaf && self->index >= self->leaf->node.numKeys)
+    {
+        self->leaf  = self->leaf->next;
+        self->index = 0;
+    }
+
+    if (!self->leaf || self->leaf->node.numKeys == 0)
+    {
+        self->leaf  = 0;
+        self->key   = 0;
+        self->value = 0;
+        return;
+    }
+
+    self->key   = self->leaf->node.keys[self->index];
+    self->value = self->leaf->values[self->index];
+}
+
+octaspire_dern_sorted_map_iterator_t octaspire_dern_sorted_map_iterator_init(
+    octaspire_dern_sorted_map_t const * const self)
+{
+    octaspire_dern_sorted_map_private_node_t const *node = self->root;
+
+    while (!node->isLeaf)
+    {
+        node = ((octaspire_dern_sorted_map_private_inner_t const*)node)->children[0];
+    }
+
+    octaspire_dern_sorted_map_iterator_t iter;
+    memset(&iter, 0, sizeof(octaspire_dern_sorted_map_iterator_t));
+
+    iter.leaf = (octaspire_dern_sorted_map_private_leaf_t const*)node;
+    octaspire_dern_sorted_map_private_iterator_update(&iter);
+    return iter;
+}
+
+octaspire_dern_sorted_map_iterator_t octaspire_dern_sorted_map_iterator_init_at_ceiling(
+    octaspire_dern_sorted_map_t const * const self,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_dern_sorted_map_iterator_t iter;
+    memset(&iter, 0, sizeof(octaspire_dern_sorted_map_iterator_t));
+
+    iter.leaf  = octaspire_dern_sorted_map_private_find_leaf(self, key);
+    iter.index = octaspire_dern_sorted_map_private_lower_bound(&(iter.leaf->node), key);
+
+    octaspire_dern_sorted_map_private_iterator_update(&iter);
+    return iter;
+}
+
+bool octaspire_dern_sorted_map_iterator_next(
+    octaspire_dern_sorted_map_iterator_t * const self)
+{
+    if (!self->leaf)
+    {
+        return false;
+    }
+
+    ++(self->index);
+    octaspire_dern_sorted_map_private_iterator_update(self);
+    return self->key != 0;
+}
+
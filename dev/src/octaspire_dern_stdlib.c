@@ -32,6 +32,8 @@ limitations under the License.
 #include "octaspire/dern/octaspire_dern_vm.h"
 #include "octaspire/dern/octaspire_dern_config.h"
 #include "octaspire/dern/octaspire_dern_port.h"
+#include "octaspire/dern/octaspire_dern_helpers.h"
+#include "octaspire/dern/octaspire_dern_image.h"
 
 #ifdef OCTASPIRE_DERN_CONFIG_BINARY_PLUGINS
 #include <dlfcn.h>
@@ -2627,18 +2629,25 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
 
         octaspire_dern_vm_push_value(vm, container);
 
-        if (container->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING      &&
-            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_VECTOR      &&
-            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_LIST        &&
-            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_QUEUE       &&
-            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT &&
-            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_HASH_MAP    &&
+        if (container->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING              &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_VECTOR              &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_LIST                &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_QUEUE               &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT         &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_HASH_MAP            &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_SET                 &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP          &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR   &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY         &&
+            container->typeTag != OCTASPIRE_DERN_VALUE_TAG_BYTES               &&
             container->typeTag != OCTASPIRE_DERN_VALUE_TAG_PORT)
         {
             octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
                 vm,
                 "Third argument to special 'for' using 'in' must be a container "
-                "(string, vector, list, queue, hash map or environment) or a port. "
+                "(string, vector, list, queue, hash map, set, sorted map, environment, "
+                "persistent vector, persistent hash map, typed array or bytes) or a port. "
                 "Now it has type %s.",
                 octaspire_dern_value_helper_get_type_as_c_string(container->typeTag));
 
@@ -2818,6 +2827,8 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
         }
         else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
         {
+            octaspire_dern_value_prepare_for_element_access(container);
+
             octaspire_vector_t * const vec = container->value.vector;
             size_t const vecLen = octaspire_vector_get_length(vec);
 
@@ -2884,25 +2895,28 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
 
         else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST)
         {
-            octaspire_list_t * const list = container->value.list;
-            size_t const listLen = octaspire_list_get_length(list);
+            octaspire_dern_deque_t * const list = container->value.list;
+            size_t const listLen = octaspire_dern_deque_get_length(list);
 
             int32_t counter = 0;
 
-            // TODO more efficient iteration of list
             for (size_t i = 0; i < listLen; i += stepSize)
             {
-                octaspire_list_node_t *node =
-                    octaspire_list_get_at(
+                // The body can pop elements from the list.
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_deque_get_at(
                         list,
                         (ptrdiff_t)i);
 
-                octaspire_helpers_verify_not_null(node);
+                if (!element)
+                {
+                    break;
+                }
 
                 octaspire_dern_environment_set(
                     extendedEnvironment,
                     counterSymbol,
-                    octaspire_list_node_get_element(node));
+                    element);
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -2953,20 +2967,28 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
         }
         else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE)
         {
-            octaspire_queue_t * const queue = container->value.queue;
-            size_t const queueLen = octaspire_queue_get_length(queue);
+            octaspire_dern_deque_t * const queue = container->value.queue;
+            size_t const queueLen = octaspire_dern_deque_get_length(queue);
 
             int32_t counter = 0;
 
-            // TODO more efficient iteration of queue
             for (size_t i = 0; i < queueLen; i += stepSize)
             {
+                // The body can pop elements from the queue.
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_deque_get_at(
+                        queue,
+                        (ptrdiff_t)i);
+
+                if (!element)
+                {
+                    break;
+                }
+
                 octaspire_dern_environment_set(
                     extendedEnvironment,
                     counterSymbol,
-                    octaspire_queue_get_at(
-                        queue,
-                        (ptrdiff_t)i));
+                    element);
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3024,7 +3046,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
 
             for (size_t i = 0; i < envLen; i += stepSize)
             {
-                octaspire_map_element_t *element =
+                octaspire_dern_map_element_t *element =
                     octaspire_dern_environment_get_at_index(
                         env,
                         (ptrdiff_t)i);
@@ -3035,8 +3057,8 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
                     octaspire_dern_vm_create_new_value_vector_from_values(
                         vm,
                         2,
-                        octaspire_map_element_get_key(element),
-                        octaspire_map_element_get_value(element)));
+                        octaspire_dern_map_element_get_key(element),
+                        octaspire_dern_map_element_get_value(element)));
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3087,26 +3109,34 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
         }
         else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP)
         {
-            octaspire_map_t * const hashMap = container->value.hashMap;
-            size_t const hashMapLen = octaspire_map_get_number_of_elements(hashMap);
+            octaspire_dern_value_prepare_for_element_access(container);
+
+            octaspire_dern_map_t * const hashMap = container->value.hashMap;
+            size_t const hashMapLen = octaspire_dern_map_get_number_of_elements(hashMap);
 
             int32_t counter = 0;
 
             for (size_t i = 0; i < hashMapLen; i += stepSize)
             {
-                octaspire_map_element_t *element =
-                    octaspire_map_get_at_index(
+                octaspire_dern_map_element_t *element =
+                    octaspire_dern_map_get_at_index(
                         hashMap,
                         (ptrdiff_t)i);
 
+                if (!element)
+                {
+                    // GC can remove entries of a weak hash map during the loop.
+                    break;
+                }
+
                 octaspire_dern_environment_set(
                     extendedEnvironment,
                     counterSymbol,
                     octaspire_dern_vm_create_new_value_vector_from_values(
                         vm,
                         2,
-                        octaspire_map_element_get_key(element),
-                        octaspire_map_element_get_value(element)));
+                        octaspire_dern_map_element_get_key(element),
+                        octaspire_dern_map_element_get_value(element)));
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3155,43 +3185,30 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
-        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_PORT)
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET)
         {
-            octaspire_dern_port_t * const port = container->value.port;
+            octaspire_dern_map_t * const set = container->value.set;
+            size_t const setLen = octaspire_dern_map_get_number_of_elements(set);
 
             int32_t counter = 0;
-            size_t  skip    = 0;
 
-            bool noMoreInput = false;
-
-            while (!noMoreInput)
+            for (size_t i = 0; i < setLen; i += stepSize)
             {
-                char buffer[1];
-
-                for (size_t i = 0; i < skip; ++i)
-                {
-                    if (octaspire_dern_port_read(port, buffer, sizeof(char)) < 1)
-                    {
-                        noMoreInput = true;
-                        break;
-                    }
-                }
-
-                if (noMoreInput)
-                {
-                    break;
-                }
+                octaspire_dern_map_element_t *element =
+                    octaspire_dern_map_get_at_index(
+                        set,
+                        (ptrdiff_t)i);
 
-                if (octaspire_dern_port_read(port, buffer, sizeof(char)) < 1)
+                if (!element)
                 {
-                    noMoreInput = true;
+                    // The body can remove elements from the set.
                     break;
                 }
 
                 octaspire_dern_environment_set(
                     extendedEnvironment,
                     counterSymbol,
-                    octaspire_dern_vm_create_new_value_integer(vm, (int32_t)buffer[0]));
+                    octaspire_dern_map_element_get_key(element));
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3229,11 +3246,8 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
 
                         return result;
                     }
-
                 }
 
-                skip = (stepSize - 1);
-
                 ++counter;
             }
 
@@ -3243,194 +3257,38 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
-        else
-        {
-            abort();
-        }
-    }
-    else if (octaspire_string_is_equal_to_c_string(
-        inOrFromSymbol->value.symbol,
-        "from"))
-    {
-        // (for i from 0 to 100)
-        // TODO XXX
-
-        // 0
-        octaspire_dern_value_t *fromValue =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 2);
-
-        octaspire_helpers_verify_not_null(fromValue);
-
-        fromValue = octaspire_dern_vm_eval(vm, fromValue, environment);
-
-        octaspire_helpers_verify_not_null(fromValue);
-
-        octaspire_dern_vm_push_value(vm, fromValue);
-
-        if (fromValue->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
-        {
-            octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "Third argument to special 'for' using 'from' must be integer. "
-                "Now it has type %s.",
-                octaspire_dern_value_helper_get_type_as_c_string(fromValue->typeTag));
-
-            octaspire_dern_vm_pop_value(vm, fromValue);
-            octaspire_dern_vm_pop_value(vm, arguments);
-
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return result;
-        }
-
-        // 100
-        octaspire_dern_value_t *toValue =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 4);
-
-        octaspire_helpers_verify_not_null(toValue);
-
-        toValue = octaspire_dern_vm_eval(vm, toValue, environment);
-
-        octaspire_helpers_verify_not_null(toValue);
-
-        octaspire_dern_vm_push_value(vm, toValue);
-
-        if (toValue->typeTag != fromValue->typeTag)
-        {
-            octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "Fifth argument to special 'for' using 'from' must be of same type than the "
-                "third (%s). Now it has type %s.",
-                octaspire_dern_value_helper_get_type_as_c_string(fromValue->typeTag),
-                octaspire_dern_value_helper_get_type_as_c_string(toValue->typeTag));
-
-            octaspire_dern_vm_pop_value(vm, toValue);
-            octaspire_dern_vm_pop_value(vm, fromValue);
-            octaspire_dern_vm_pop_value(vm, arguments);
-
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return result;
-        }
-
-        // Check if there are optional 'step' and then integer
-        size_t currentArgIdx = 5;
-
-        // Optional 5. and 6. arguments: step integer
-        octaspire_dern_value_t const * const optionalStep =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)currentArgIdx);
-
-        octaspire_helpers_verify_not_null(optionalStep);
-
-        if (optionalStep->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL &&
-            octaspire_string_is_equal_to_c_string(
-                optionalStep->value.symbol,
-                "step"))
-        {
-            if (numArgs < 7)
-            {
-                octaspire_dern_vm_pop_value(vm, toValue);
-                octaspire_dern_vm_pop_value(vm, fromValue);
-                octaspire_dern_vm_pop_value(vm, arguments);
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Special 'for' expects at least seven arguments in numeric form with "
-                    "a given step size. %zu arguments were given.",
-                    numArgs);
-            }
-
-            // There is 'step'. Now an integer is required next
-            ++currentArgIdx;
-
-            octaspire_dern_value_t const * const requiredStepSize =
-                octaspire_dern_value_as_vector_get_element_at(
-                    arguments,
-                    (ptrdiff_t)currentArgIdx);
-
-            octaspire_helpers_verify_not_null(requiredStepSize);
-
-            if (requiredStepSize->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
-            {
-                octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Seventh argument to special 'for' using 'step' with numeric iteration must be "
-                    "an integer step size. Now it has type %s.",
-                    octaspire_dern_value_helper_get_type_as_c_string(requiredStepSize->typeTag));
-
-                octaspire_dern_vm_pop_value(vm, toValue);
-                octaspire_dern_vm_pop_value(vm, fromValue);
-                octaspire_dern_vm_pop_value(vm, arguments);
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return result;
-            }
-
-            if (requiredStepSize->value.integer <= 0)
-            {
-                octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "The 'step' of special 'for' must be larger than zero. "
-                    "Now it is %s%" PRId32 "}.",
-                    (requiredStepSize->value.integer >= 0) ? "{D+" : "{D",
-                    requiredStepSize->value.integer);
-
-                octaspire_dern_vm_pop_value(vm, toValue);
-                octaspire_dern_vm_pop_value(vm, fromValue);
-                octaspire_dern_vm_pop_value(vm, arguments);
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return result;
-            }
-
-            stepSize = (size_t)requiredStepSize->value.integer;
-        }
-
-        // Extend env for the counter variable
-        octaspire_dern_environment_t *extendedEnvironment =
-            octaspire_dern_environment_new(
-                environment,
-                vm,
-                octaspire_dern_vm_get_allocator(vm));
-
-        octaspire_helpers_verify_not_null(extendedEnvironment);
-
-        octaspire_dern_value_t *extendedEnvVal =
-            octaspire_dern_vm_create_new_value_environment_from_environment(
-                vm,
-                extendedEnvironment);
-
-        octaspire_helpers_verify_not_null(extendedEnvVal);
-
-        octaspire_dern_vm_push_value(vm, extendedEnvVal);
-
-        bool const fromIsSmaller = octaspire_dern_value_is_less_than_or_equal(fromValue, toValue);
-
-        if (fromIsSmaller)
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP)
         {
-            size_t const numIterations =
-                (size_t)(toValue->value.integer - fromValue->value.integer) + 1;
+            octaspire_dern_sorted_map_t * const sortedMap = container->value.sortedMap;
+            size_t const sortedMapLen =
+                octaspire_dern_sorted_map_get_number_of_elements(sortedMap);
 
             int32_t counter = 0;
 
-            for (size_t i = 0; i < numIterations; i += stepSize)
+            // Elements are visited in key order.
+            for (size_t i = 0; i < sortedMapLen; i += stepSize)
             {
-                octaspire_dern_value_t *iterator =
-                    octaspire_dern_vm_create_new_value_copy(vm, fromValue);
-
-                iterator->value.integer += i;
+                octaspire_dern_value_t *key   = 0;
+                octaspire_dern_value_t *value = 0;
+
+                if (!octaspire_dern_sorted_map_get_at_index(
+                        sortedMap,
+                        (ptrdiff_t)i,
+                        &key,
+                        &value))
+                {
+                    // The body can remove elements from the sorted map.
+                    break;
+                }
 
                 octaspire_dern_environment_set(
                     extendedEnvironment,
                     counterSymbol,
-                    iterator);
+                    octaspire_dern_vm_create_new_value_vector_from_values(
+                        vm,
+                        2,
+                        key,
+                        value));
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3446,8 +3304,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
                     if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
                     {
                         octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-                        octaspire_dern_vm_pop_value(vm, toValue);
-                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, container);
                         octaspire_dern_vm_pop_value(vm, arguments);
 
                         octaspire_helpers_verify_true(
@@ -3461,8 +3318,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
                         result = octaspire_dern_vm_get_function_return(vm);
                         //octaspire_dern_vm_set_function_return(vm, 0);
                         octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-                        octaspire_dern_vm_pop_value(vm, toValue);
-                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, container);
                         octaspire_dern_vm_pop_value(vm, arguments);
 
                         octaspire_helpers_verify_true(
@@ -3476,30 +3332,34 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
             }
 
             octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-            octaspire_dern_vm_pop_value(vm, toValue);
-            octaspire_dern_vm_pop_value(vm, fromValue);
+            octaspire_dern_vm_pop_value(vm, container);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
-        else
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR)
         {
-            size_t const numIterations =
-                (size_t)(fromValue->value.integer - toValue->value.integer) + 1;
+            size_t const vecLen = octaspire_dern_value_get_length(container);
 
             int32_t counter = 0;
 
-            for (size_t i = 0; i < numIterations; i += stepSize)
+            for (size_t i = 0; i < vecLen; i += stepSize)
             {
-                octaspire_dern_value_t *iterator =
-                    octaspire_dern_vm_create_new_value_copy(vm, fromValue);
-
-                iterator->value.integer -= i;
+                // The body can modify a transient vector during the loop.
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_value_as_persistent_vector_get_element_at(
+                        container,
+                        (ptrdiff_t)i);
 
-                octaspire_dern_environment_set(
-                    extendedEnvironment,
+                if (!element)
+                {
+                    break;
+                }
+
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
                     counterSymbol,
-                    iterator);
+                    element);
 
                 for (size_t j = currentArgIdx; j < numArgs; ++j)
                 {
@@ -3515,8 +3375,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
                     if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
                     {
                         octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-                        octaspire_dern_vm_pop_value(vm, toValue);
-                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, container);
                         octaspire_dern_vm_pop_value(vm, arguments);
 
                         octaspire_helpers_verify_true(
@@ -3530,8 +3389,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
                         result = octaspire_dern_vm_get_function_return(vm);
                         //octaspire_dern_vm_set_function_return(vm, 0);
                         octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-                        octaspire_dern_vm_pop_value(vm, toValue);
-                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, container);
                         octaspire_dern_vm_pop_value(vm, arguments);
 
                         octaspire_helpers_verify_true(
@@ -3545,396 +3403,567 @@ octaspire_dern_value_t *octaspire_dern_vm_special_for(
             }
 
             octaspire_dern_vm_pop_value(vm, extendedEnvVal);
-            octaspire_dern_vm_pop_value(vm, toValue);
-            octaspire_dern_vm_pop_value(vm, fromValue);
+            octaspire_dern_vm_pop_value(vm, container);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
-    }
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY ||
+                 container->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES)
+        {
+            size_t const vecLen = octaspire_dern_value_get_length(container);
 
-    return 0;
-}
+            int32_t counter = 0;
 
-// TODO move to other builtins
-octaspire_dern_value_t *octaspire_dern_vm_builtin_starts_with_question_mark(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+            for (size_t i = 0; i < vecLen; i += stepSize)
+            {
+                // Elements are stored unboxed; each one is read into a new number.
+                octaspire_dern_value_t * const element =
+                    octaspire_dern_value_is_bytes(container) ?
+                        octaspire_dern_value_as_bytes_get_element_at(
+                            container,
+                            (ptrdiff_t)i) :
+                        octaspire_dern_value_as_typed_array_get_element_at(
+                            container,
+                            (ptrdiff_t)i);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+                if (!element)
+                {
+                    break;
+                }
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
+                    counterSymbol,
+                    element);
 
-    if (numArgs != 2)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'starts-with?' expects two arguments.");
-    }
+                for (size_t j = currentArgIdx; j < numArgs; ++j)
+                {
+                    octaspire_dern_value_t *result = octaspire_dern_vm_eval(
+                        vm,
+                        octaspire_dern_value_as_vector_get_element_at(
+                            arguments,
+                            (ptrdiff_t)j),
+                        extendedEnvVal);
 
-    octaspire_dern_vm_push_value(vm, arguments);
+                    octaspire_helpers_verify_not_null(result);
 
-    octaspire_dern_value_t *firstArg = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-    octaspire_helpers_verify_not_null(firstArg);
+                    if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                    {
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-    octaspire_dern_value_t *secondArg = octaspire_dern_value_as_vector_get_element_at(arguments, 1);
-    octaspire_helpers_verify_not_null(secondArg);
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    if (firstArg->typeTag != secondArg->typeTag)
-    {
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_get_value_false(vm);
-    }
+                        return result;
+                    }
 
-    if (firstArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
-    {
-        // TODO XXX implement rest of the fitting types
-        //abort();
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_get_value_false(vm);
-    }
+                    if (octaspire_dern_vm_get_function_return(vm))
+                    {
+                        result = octaspire_dern_vm_get_function_return(vm);
+                        //octaspire_dern_vm_set_function_return(vm, 0);
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-    bool const result = octaspire_string_starts_with(
-        firstArg->value.string,
-        secondArg->value.string);
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    octaspire_dern_vm_pop_value(vm, arguments);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_boolean(vm, result);
-}
+                        return result;
+                    }
+                }
 
-/*
-    (= num 10)                         ; set variable to
-    (= vec 1 [kissa])                  ; set vector index to
-    (= map [john] [305-3848506428])    ; set map for key to
-    (= str 1 |a|)                      ; set character of string at index to
-*/
-octaspire_dern_value_t *octaspire_dern_vm_builtin_equals(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+                ++counter;
+            }
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+            octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+            octaspire_dern_vm_pop_value(vm, container);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_integer(vm, counter);
+        }
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP)
+        {
+            size_t const hashMapLen = octaspire_dern_value_get_length(container);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+            int32_t counter = 0;
 
-    if (numArgs < 2 || numArgs > 3)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin '=' expects two or three arguments.");
-    }
+            for (size_t i = 0; i < hashMapLen; i += stepSize)
+            {
+                octaspire_dern_value_t *key   = 0;
+                octaspire_dern_value_t *value = 0;
+
+                if (!octaspire_dern_value_as_persistent_hash_map_get_at_index(
+                        container,
+                        (ptrdiff_t)i,
+                        &key,
+                        &value))
+                {
+                    // The body can remove keys from a transient hash map during the loop.
+                    break;
+                }
 
-    octaspire_dern_vm_push_value(vm, arguments);
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
+                    counterSymbol,
+                    octaspire_dern_vm_create_new_value_vector_from_values(
+                        vm,
+                        2,
+                        key,
+                        value));
 
-    octaspire_dern_value_t *firstArg = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-    octaspire_helpers_verify_not_null(firstArg);
+                for (size_t j = currentArgIdx; j < numArgs; ++j)
+                {
+                    octaspire_dern_value_t *result = octaspire_dern_vm_eval(
+                        vm,
+                        octaspire_dern_value_as_vector_get_element_at(
+                            arguments,
+                            (ptrdiff_t)j),
+                        extendedEnvVal);
 
-    if (numArgs == 2)
-    {
-        octaspire_dern_value_t *secondArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+                    octaspire_helpers_verify_not_null(result);
 
-        octaspire_helpers_verify_not_null(secondArg);
+                    if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                    {
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-        if (octaspire_dern_value_set(firstArg, secondArg))
-        {
-            octaspire_dern_vm_pop_value(vm, arguments);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            //return octaspire_dern_vm_get_value_true(vm);
-            return firstArg;
-        }
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(vm, "Builtin '=' failed");
-    }
-    else
-    {
-        octaspire_dern_value_t *secondArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+                        return result;
+                    }
 
-        octaspire_helpers_verify_not_null(secondArg);
+                    if (octaspire_dern_vm_get_function_return(vm))
+                    {
+                        result = octaspire_dern_vm_get_function_return(vm);
+                        //octaspire_dern_vm_set_function_return(vm, 0);
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-        octaspire_dern_value_t *thirdArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 2);
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        octaspire_helpers_verify_not_null(thirdArg);
+                        return result;
+                    }
+                }
 
-        if (octaspire_dern_value_set_collection(firstArg, secondArg, thirdArg))
-        {
+                ++counter;
+            }
+
+            octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+            octaspire_dern_vm_pop_value(vm, container);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            //return octaspire_dern_vm_get_value_true(vm);
-            return firstArg;
+            return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
+        else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_PORT)
+        {
+            octaspire_dern_port_t * const port = container->value.port;
 
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(vm, "Builtin '=' failed");
-    }
-}
-
-octaspire_dern_value_t *octaspire_dern_vm_special_equals_equals(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+            int32_t counter = 0;
+            size_t  skip    = 0;
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+            bool noMoreInput = false;
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+            while (!noMoreInput)
+            {
+                char buffer[1];
 
-    if (numArgs < 2)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin '==' expects at least two arguments.");
-    }
+                for (size_t i = 0; i < skip; ++i)
+                {
+                    if (octaspire_dern_port_read(port, buffer, sizeof(char)) < 1)
+                    {
+                        noMoreInput = true;
+                        break;
+                    }
+                }
 
-    octaspire_dern_vm_push_value(vm, arguments);
+                if (noMoreInput)
+                {
+                    break;
+                }
 
-    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
-        vm,
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
-        environment);
-
-    octaspire_dern_vm_push_value(vm, firstValue);
-
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        octaspire_dern_value_t *secondValue = octaspire_dern_vm_eval(
-            vm,
-            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i),
-            environment);
-
-        octaspire_dern_vm_push_value(vm, secondValue);
-
-        if (!octaspire_dern_value_is_equal(firstValue, secondValue))
-        {
-            octaspire_dern_vm_pop_value(vm, secondValue);
-            octaspire_dern_vm_pop_value(vm, firstValue);
-            octaspire_dern_vm_pop_value(vm, arguments);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_get_value_false(vm);
-        }
-
-        octaspire_dern_vm_pop_value(vm, secondValue);
-    }
+                if (octaspire_dern_port_read(port, buffer, sizeof(char)) < 1)
+                {
+                    noMoreInput = true;
+                    break;
+                }
 
-    octaspire_dern_vm_pop_value(vm, firstValue);
-    octaspire_dern_vm_pop_value(vm, arguments);
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
+                    counterSymbol,
+                    octaspire_dern_vm_create_new_value_integer(vm, (int32_t)buffer[0]));
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
-}
+                for (size_t j = currentArgIdx; j < numArgs; ++j)
+                {
+                    octaspire_dern_value_t *result = octaspire_dern_vm_eval(
+                        vm,
+                        octaspire_dern_value_as_vector_get_element_at(
+                            arguments,
+                            (ptrdiff_t)j),
+                        extendedEnvVal);
 
-octaspire_dern_value_t *octaspire_dern_vm_special_equals_equals_equals(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+                    octaspire_helpers_verify_not_null(result);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+                    if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                    {
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+                        return result;
+                    }
 
-    if (numArgs < 2)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin '===' expects at least two arguments.");
-    }
+                    if (octaspire_dern_vm_get_function_return(vm))
+                    {
+                        result = octaspire_dern_vm_get_function_return(vm);
+                        //octaspire_dern_vm_set_function_return(vm, 0);
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, container);
+                        octaspire_dern_vm_pop_value(vm, arguments);
 
-    octaspire_dern_vm_push_value(vm, arguments);
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
-        vm,
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
-        environment);
+                        return result;
+                    }
 
-    octaspire_dern_vm_push_value(vm, firstValue);
+                }
 
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        octaspire_dern_value_t *secondValue = octaspire_dern_vm_eval(
-            vm,
-            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i),
-            environment);
+                skip = (stepSize - 1);
 
-        octaspire_dern_vm_push_value(vm, secondValue);
+                ++counter;
+            }
 
-        if (firstValue->uniqueId != secondValue->uniqueId)
-        {
-            octaspire_dern_vm_pop_value(vm, secondValue);
-            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+            octaspire_dern_vm_pop_value(vm, container);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_get_value_false(vm);
+            return octaspire_dern_vm_create_new_value_integer(vm, counter);
+        }
+        else
+        {
+            abort();
         }
-
-        octaspire_dern_vm_pop_value(vm, secondValue);
     }
+    else if (octaspire_string_is_equal_to_c_string(
+        inOrFromSymbol->value.symbol,
+        "from"))
+    {
+        // (for i from 0 to 100)
+        // TODO XXX
 
-    octaspire_dern_vm_pop_value(vm, firstValue);
-    octaspire_dern_vm_pop_value(vm, arguments);
+        // 0
+        octaspire_dern_value_t *fromValue =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 2);
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
-}
+        octaspire_helpers_verify_not_null(fromValue);
 
-octaspire_dern_value_t *octaspire_dern_vm_special_exclamation_equals(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    octaspire_dern_value_t *tmpVal =
-        octaspire_dern_vm_special_equals_equals(vm, arguments, environment);
+        fromValue = octaspire_dern_vm_eval(vm, fromValue, environment);
 
-    if (tmpVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-    {
-        return tmpVal;
-    }
+        octaspire_helpers_verify_not_null(fromValue);
 
-    if (tmpVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
-    {
-        abort();
-    }
+        octaspire_dern_vm_push_value(vm, fromValue);
 
-    return octaspire_dern_vm_create_new_value_boolean(
-        vm,
-        !octaspire_dern_value_as_boolean_get_value(tmpVal));
-}
+        if (fromValue->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        {
+            octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Third argument to special 'for' using 'from' must be integer. "
+                "Now it has type %s.",
+                octaspire_dern_value_helper_get_type_as_c_string(fromValue->typeTag));
 
-octaspire_dern_value_t *octaspire_dern_vm_special_less_than_or_equal(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+            octaspire_dern_vm_pop_value(vm, fromValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return result;
+        }
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+        // 100
+        octaspire_dern_value_t *toValue =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 4);
 
-    if (numArgs < 2)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Special '<=' expects at least two arguments.");
-    }
+        octaspire_helpers_verify_not_null(toValue);
 
-    octaspire_dern_vm_push_value(vm, arguments);
+        toValue = octaspire_dern_vm_eval(vm, toValue, environment);
 
-    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
-        vm,
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
-        environment);
+        octaspire_helpers_verify_not_null(toValue);
 
-    octaspire_dern_vm_push_value(vm, firstValue);
+        octaspire_dern_vm_push_value(vm, toValue);
 
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        if (!octaspire_dern_value_is_less_than_or_equal(
-                firstValue,
-                octaspire_dern_vm_eval(
-                    vm,
-                    octaspire_dern_value_as_vector_get_element_at(
-                        arguments,
-                        (ptrdiff_t)i),
-                    environment)))
+        if (toValue->typeTag != fromValue->typeTag)
         {
-            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Fifth argument to special 'for' using 'from' must be of same type than the "
+                "third (%s). Now it has type %s.",
+                octaspire_dern_value_helper_get_type_as_c_string(fromValue->typeTag),
+                octaspire_dern_value_helper_get_type_as_c_string(toValue->typeTag));
+
+            octaspire_dern_vm_pop_value(vm, toValue);
+            octaspire_dern_vm_pop_value(vm, fromValue);
             octaspire_dern_vm_pop_value(vm, arguments);
+
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_get_value_false(vm);
+            return result;
         }
-    }
 
-    octaspire_dern_vm_pop_value(vm, firstValue);
-    octaspire_dern_vm_pop_value(vm, arguments);
+        // Check if there are optional 'step' and then integer
+        size_t currentArgIdx = 5;
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
-}
+        // Optional 5. and 6. arguments: step integer
+        octaspire_dern_value_t const * const optionalStep =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)currentArgIdx);
 
-octaspire_dern_value_t *octaspire_dern_vm_special_less_than(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+        octaspire_helpers_verify_not_null(optionalStep);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+        if (optionalStep->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL &&
+            octaspire_string_is_equal_to_c_string(
+                optionalStep->value.symbol,
+                "step"))
+        {
+            if (numArgs < 7)
+            {
+                octaspire_dern_vm_pop_value(vm, toValue);
+                octaspire_dern_vm_pop_value(vm, fromValue);
+                octaspire_dern_vm_pop_value(vm, arguments);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    if (numArgs < 2)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Special '<' expects at least two arguments.");
-    }
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Special 'for' expects at least seven arguments in numeric form with "
+                    "a given step size. %zu arguments were given.",
+                    numArgs);
+            }
 
-    octaspire_dern_vm_push_value(vm, arguments);
+            // There is 'step'. Now an integer is required next
+            ++currentArgIdx;
 
-    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
-        vm,
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
-        environment);
+            octaspire_dern_value_t const * const requiredStepSize =
+                octaspire_dern_value_as_vector_get_element_at(
+                    arguments,
+                    (ptrdiff_t)currentArgIdx);
 
-    octaspire_dern_vm_push_value(vm, firstValue);
+            octaspire_helpers_verify_not_null(requiredStepSize);
 
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        if (!octaspire_dern_value_is_less_than(
-                firstValue,
-                octaspire_dern_vm_eval(
+            if (requiredStepSize->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+            {
+                octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    octaspire_dern_value_as_vector_get_element_at(
-                        arguments,
-                        (ptrdiff_t)i),
-                    environment)))
+                    "Seventh argument to special 'for' using 'step' with numeric iteration must be "
+                    "an integer step size. Now it has type %s.",
+                    octaspire_dern_value_helper_get_type_as_c_string(requiredStepSize->typeTag));
+
+                octaspire_dern_vm_pop_value(vm, toValue);
+                octaspire_dern_vm_pop_value(vm, fromValue);
+                octaspire_dern_vm_pop_value(vm, arguments);
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return result;
+            }
+
+            if (requiredStepSize->value.integer <= 0)
+            {
+                octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "The 'step' of special 'for' must be larger than zero. "
+                    "Now it is %s%" PRId32 "}.",
+                    (requiredStepSize->value.integer >= 0) ? "{D+" : "{D",
+                    requiredStepSize->value.integer);
+
+                octaspire_dern_vm_pop_value(vm, toValue);
+                octaspire_dern_vm_pop_value(vm, fromValue);
+                octaspire_dern_vm_pop_value(vm, arguments);
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return result;
+            }
+
+            stepSize = (size_t)requiredStepSize->value.integer;
+        }
+
+        // Extend env for the counter variable
+        octaspire_dern_environment_t *extendedEnvironment =
+            octaspire_dern_environment_new(
+                environment,
+                vm,
+                octaspire_dern_vm_get_allocator(vm));
+
+        octaspire_helpers_verify_not_null(extendedEnvironment);
+
+        octaspire_dern_value_t *extendedEnvVal =
+            octaspire_dern_vm_create_new_value_environment_from_environment(
+                vm,
+                extendedEnvironment);
+
+        octaspire_helpers_verify_not_null(extendedEnvVal);
+
+        octaspire_dern_vm_push_value(vm, extendedEnvVal);
+
+        bool const fromIsSmaller = octaspire_dern_value_is_less_than_or_equal(fromValue, toValue);
+
+        if (fromIsSmaller)
         {
-            octaspire_dern_vm_pop_value(vm, firstValue);
+            size_t const numIterations =
+                (size_t)(toValue->value.integer - fromValue->value.integer) + 1;
+
+            int32_t counter = 0;
+
+            for (size_t i = 0; i < numIterations; i += stepSize)
+            {
+                octaspire_dern_value_t *iterator =
+                    octaspire_dern_vm_create_new_value_copy(vm, fromValue);
+
+                iterator->value.integer += i;
+
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
+                    counterSymbol,
+                    iterator);
+
+                for (size_t j = currentArgIdx; j < numArgs; ++j)
+                {
+                    octaspire_dern_value_t *result = octaspire_dern_vm_eval(
+                        vm,
+                        octaspire_dern_value_as_vector_get_element_at(
+                            arguments,
+                            (ptrdiff_t)j),
+                        extendedEnvVal);
+
+                    octaspire_helpers_verify_not_null(result);
+
+                    if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                    {
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, toValue);
+                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, arguments);
+
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                        return result;
+                    }
+
+                    if (octaspire_dern_vm_get_function_return(vm))
+                    {
+                        result = octaspire_dern_vm_get_function_return(vm);
+                        //octaspire_dern_vm_set_function_return(vm, 0);
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, toValue);
+                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, arguments);
+
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                        return result;
+                    }
+                }
+
+                ++counter;
+            }
+
+            octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+            octaspire_dern_vm_pop_value(vm, toValue);
+            octaspire_dern_vm_pop_value(vm, fromValue);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_get_value_false(vm);
+            return octaspire_dern_vm_create_new_value_integer(vm, counter);
         }
-    }
+        else
+        {
+            size_t const numIterations =
+                (size_t)(fromValue->value.integer - toValue->value.integer) + 1;
 
-    octaspire_dern_vm_pop_value(vm, firstValue);
-    octaspire_dern_vm_pop_value(vm, arguments);
+            int32_t counter = 0;
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
+            for (size_t i = 0; i < numIterations; i += stepSize)
+            {
+                octaspire_dern_value_t *iterator =
+                    octaspire_dern_vm_create_new_value_copy(vm, fromValue);
+
+                iterator->value.integer -= i;
+
+                octaspire_dern_environment_set(
+                    extendedEnvironment,
+                    counterSymbol,
+                    iterator);
+
+                for (size_t j = currentArgIdx; j < numArgs; ++j)
+                {
+                    octaspire_dern_value_t *result = octaspire_dern_vm_eval(
+                        vm,
+                        octaspire_dern_value_as_vector_get_element_at(
+                            arguments,
+                            (ptrdiff_t)j),
+                        extendedEnvVal);
+
+                    octaspire_helpers_verify_not_null(result);
+
+                    if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                    {
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, toValue);
+                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, arguments);
+
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                        return result;
+                    }
+
+                    if (octaspire_dern_vm_get_function_return(vm))
+                    {
+                        result = octaspire_dern_vm_get_function_return(vm);
+                        //octaspire_dern_vm_set_function_return(vm, 0);
+                        octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+                        octaspire_dern_vm_pop_value(vm, toValue);
+                        octaspire_dern_vm_pop_value(vm, fromValue);
+                        octaspire_dern_vm_pop_value(vm, arguments);
+
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                        return result;
+                    }
+                }
+
+                ++counter;
+            }
+
+            octaspire_dern_vm_pop_value(vm, extendedEnvVal);
+            octaspire_dern_vm_pop_value(vm, toValue);
+            octaspire_dern_vm_pop_value(vm, fromValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_integer(vm, counter);
+        }
+    }
+
+    return 0;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_special_greater_than(
+// TODO move to other builtins
+octaspire_dern_value_t *octaspire_dern_vm_builtin_starts_with_question_mark(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -3946,49 +3975,142 @@ octaspire_dern_value_t *octaspire_dern_vm_special_greater_than(
 
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (numArgs < 2)
+    if (numArgs != 2)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_from_c_string(
             vm,
-            "Special '>' expects at least two arguments.");
+            "Builtin 'starts-with?' expects two arguments.");
     }
 
     octaspire_dern_vm_push_value(vm, arguments);
 
-    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
-        vm,
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
-        environment);
+    octaspire_dern_value_t *firstArg = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_helpers_verify_not_null(firstArg);
 
-    octaspire_dern_vm_push_value(vm, firstValue);
+    octaspire_dern_value_t *secondArg = octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+    octaspire_helpers_verify_not_null(secondArg);
 
-    for (size_t i = 1; i < numArgs; ++i)
+    bool const firstIsText =
+        octaspire_dern_value_is_string(firstArg) ||
+        octaspire_dern_value_is_string_slice(firstArg);
+
+    bool const secondIsText =
+        octaspire_dern_value_is_string(secondArg) ||
+        octaspire_dern_value_is_string_slice(secondArg);
+
+    if (!firstIsText || !secondIsText)
     {
-        if (!octaspire_dern_value_is_greater_than(
-                firstValue,
-                octaspire_dern_vm_eval(
-                    vm,
-                    octaspire_dern_value_as_vector_get_element_at(
-                        arguments,
-                        (ptrdiff_t)i),
-                    environment)))
+        // TODO XXX implement rest of the fitting types
+        //abort();
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_get_value_false(vm);
+    }
+
+    // A UTF-8 encoded string starts with the characters of another
+    // exactly when it starts with the octets of the other.
+    size_t const prefixLength = octaspire_dern_value_is_string(secondArg) ?
+        octaspire_string_get_length_in_octets(secondArg->value.string) :
+        octaspire_dern_value_as_string_slice_get_length_in_octets(secondArg);
+
+    size_t const textLength = octaspire_dern_value_is_string(firstArg) ?
+        octaspire_string_get_length_in_octets(firstArg->value.string) :
+        octaspire_dern_value_as_string_slice_get_length_in_octets(firstArg);
+
+    bool const result =
+        textLength >= prefixLength &&
+        memcmp(
+            octaspire_dern_value_is_string(firstArg) ?
+                octaspire_string_get_c_string(firstArg->value.string) :
+                octaspire_dern_value_as_string_slice_get_octets(firstArg),
+            octaspire_dern_value_is_string(secondArg) ?
+                octaspire_string_get_c_string(secondArg->value.string) :
+                octaspire_dern_value_as_string_slice_get_octets(secondArg),
+            prefixLength) == 0;
+
+    octaspire_dern_vm_pop_value(vm, arguments);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_boolean(vm, result);
+}
+
+/*
+    (= num 10)                         ; set variable to
+    (= vec 1 [kissa])                  ; set vector index to
+    (= map [john] [305-3848506428])    ; set map for key to
+    (= str 1 |a|)                      ; set character of string at index to
+*/
+octaspire_dern_value_t *octaspire_dern_vm_builtin_equals(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2 || numArgs > 3)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '=' expects two or three arguments.");
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstArg = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_helpers_verify_not_null(firstArg);
+
+    if (numArgs == 2)
+    {
+        octaspire_dern_value_t *secondArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+
+        octaspire_helpers_verify_not_null(secondArg);
+
+        if (octaspire_dern_value_set(firstArg, secondArg))
         {
-            octaspire_dern_vm_pop_value(vm, firstValue);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_get_value_false(vm);
+            //return octaspire_dern_vm_get_value_true(vm);
+            return firstArg;
         }
+
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(vm, "Builtin '=' failed");
     }
+    else
+    {
+        octaspire_dern_value_t *secondArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
 
-    octaspire_dern_vm_pop_value(vm, firstValue);
-    octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_not_null(secondArg);
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
+        octaspire_dern_value_t *thirdArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 2);
+
+        octaspire_helpers_verify_not_null(thirdArg);
+
+        if (octaspire_dern_value_set_collection(firstArg, secondArg, thirdArg))
+        {
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            //return octaspire_dern_vm_get_value_true(vm);
+            return firstArg;
+        }
+
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(vm, "Builtin '=' failed");
+    }
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_special_greater_than_or_equal(
+octaspire_dern_value_t *octaspire_dern_vm_special_equals_equals(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -4005,7 +4127,7 @@ octaspire_dern_value_t *octaspire_dern_vm_special_greater_than_or_equal(
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_from_c_string(
             vm,
-            "Special '>=' expects at least two arguments.");
+            "Builtin '==' expects at least two arguments.");
     }
 
     octaspire_dern_vm_push_value(vm, arguments);
@@ -4019,20 +4141,23 @@ octaspire_dern_value_t *octaspire_dern_vm_special_greater_than_or_equal(
 
     for (size_t i = 1; i < numArgs; ++i)
     {
-        if (!octaspire_dern_value_is_greater_than_or_equal(
-                firstValue,
-                octaspire_dern_vm_eval(
-                    vm,
-                    octaspire_dern_value_as_vector_get_element_at(
-                        arguments,
-                        (ptrdiff_t)i),
-                    environment)))
+        octaspire_dern_value_t *secondValue = octaspire_dern_vm_eval(
+            vm,
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i),
+            environment);
+
+        octaspire_dern_vm_push_value(vm, secondValue);
+
+        if (!octaspire_dern_value_is_equal(firstValue, secondValue))
         {
+            octaspire_dern_vm_pop_value(vm, secondValue);
             octaspire_dern_vm_pop_value(vm, firstValue);
             octaspire_dern_vm_pop_value(vm, arguments);
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_get_value_false(vm);
         }
+
+        octaspire_dern_vm_pop_value(vm, secondValue);
     }
 
     octaspire_dern_vm_pop_value(vm, firstValue);
@@ -4042,114 +4167,338 @@ octaspire_dern_value_t *octaspire_dern_vm_special_greater_than_or_equal(
     return octaspire_dern_vm_get_value_true(vm);
 }
 
-static size_t octaspire_dern_vm_private_template_helper(
+octaspire_dern_value_t *octaspire_dern_vm_special_equals_equals_equals(
     octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t * arguments,
-    size_t * currentIndex,
-    octaspire_dern_value_t *environment,
-    octaspire_dern_value_t **result)
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
-    char   const * const dernFuncName = "template";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    octaspire_dern_value_t * value =
-        octaspire_dern_value_as_vector_get_element_at(arguments, *currentIndex);
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
-    octaspire_helpers_verify_not_null(value);
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    if (octaspire_dern_value_is_symbol_and_equal_to_c_string(
-            value,
-            ","))
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2)
     {
-        if (*currentIndex == (numArgs - 1))
-        {
-            octaspire_dern_value_t * tmpVal =
-                octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Special '%s' expects a value after %zu. argument ','.",
-                    dernFuncName,
-                    (*currentIndex + 1));
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '===' expects at least two arguments.");
+    }
 
-            octaspire_helpers_verify_true(
-                octaspire_dern_vm_push_value(vm, tmpVal));
+    octaspire_dern_vm_push_value(vm, arguments);
 
+    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
+        vm,
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+        environment);
 
-            if (*result == 0)
-            {
-                *result = tmpVal;
-            }
-            else
-            {
-                octaspire_helpers_verify_true(
-                    octaspire_dern_value_as_vector_push_back_element(
-                        *result,
-                        &tmpVal));
-            }
+    octaspire_dern_vm_push_value(vm, firstValue);
 
-            octaspire_helpers_verify_true(
-                octaspire_dern_vm_pop_value(vm, tmpVal));
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t *secondValue = octaspire_dern_vm_eval(
+            vm,
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i),
+            environment);
 
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+        octaspire_dern_vm_push_value(vm, secondValue);
 
-            ++(*currentIndex);
-            return 1;
+        if (firstValue->uniqueId != secondValue->uniqueId)
+        {
+            octaspire_dern_vm_pop_value(vm, secondValue);
+            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_get_value_false(vm);
         }
 
-        ++(*currentIndex);
+        octaspire_dern_vm_pop_value(vm, secondValue);
+    }
 
-        value = octaspire_dern_value_as_vector_get_element_at(
-            arguments,
-            *currentIndex);
+    octaspire_dern_vm_pop_value(vm, firstValue);
+    octaspire_dern_vm_pop_value(vm, arguments);
 
-        octaspire_helpers_verify_not_null(value);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
 
-        octaspire_dern_value_t * tmpVal =
-            octaspire_dern_vm_eval(vm, value, environment);
+octaspire_dern_value_t *octaspire_dern_vm_special_exclamation_equals(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    octaspire_dern_value_t *tmpVal =
+        octaspire_dern_vm_special_equals_equals(vm, arguments, environment);
 
-        octaspire_helpers_verify_not_null(tmpVal);
+    if (tmpVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+    {
+        return tmpVal;
+    }
 
-        octaspire_helpers_verify_true(
-            octaspire_dern_vm_push_value(vm, tmpVal));
+    if (tmpVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+    {
+        abort();
+    }
 
-        if (*result == 0)
-        {
-            *result = tmpVal;
-        }
-        else
-        {
-            octaspire_helpers_verify_true(
-                octaspire_dern_value_as_vector_push_back_element(
-                    *result,
-                    &tmpVal));
-        }
+    return octaspire_dern_vm_create_new_value_boolean(
+        vm,
+        !octaspire_dern_value_as_boolean_get_value(tmpVal));
+}
 
-        octaspire_helpers_verify_true(
-            octaspire_dern_vm_pop_value(vm, tmpVal));
+octaspire_dern_value_t *octaspire_dern_vm_special_less_than_or_equal(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-        ++(*currentIndex);
-        return 2;
-    }
-    else if (octaspire_dern_value_is_symbol_and_equal_to_c_string(
-                 value,
-                 ",@"))
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Special '<=' expects at least two arguments.");
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
+        vm,
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+        environment);
+
+    octaspire_dern_vm_push_value(vm, firstValue);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        if (!octaspire_dern_value_is_less_than_or_equal(
+                firstValue,
+                octaspire_dern_vm_eval(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)i),
+                    environment)))
+        {
+            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_get_value_false(vm);
+        }
+    }
+
+    octaspire_dern_vm_pop_value(vm, firstValue);
+    octaspire_dern_vm_pop_value(vm, arguments);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_special_less_than(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Special '<' expects at least two arguments.");
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
+        vm,
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+        environment);
+
+    octaspire_dern_vm_push_value(vm, firstValue);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        if (!octaspire_dern_value_is_less_than(
+                firstValue,
+                octaspire_dern_vm_eval(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)i),
+                    environment)))
+        {
+            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_get_value_false(vm);
+        }
+    }
+
+    octaspire_dern_vm_pop_value(vm, firstValue);
+    octaspire_dern_vm_pop_value(vm, arguments);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_special_greater_than(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Special '>' expects at least two arguments.");
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
+        vm,
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+        environment);
+
+    octaspire_dern_vm_push_value(vm, firstValue);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        if (!octaspire_dern_value_is_greater_than(
+                firstValue,
+                octaspire_dern_vm_eval(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)i),
+                    environment)))
+        {
+            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_get_value_false(vm);
+        }
+    }
+
+    octaspire_dern_vm_pop_value(vm, firstValue);
+    octaspire_dern_vm_pop_value(vm, arguments);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_special_greater_than_or_equal(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs < 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Special '>=' expects at least two arguments.");
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstValue = octaspire_dern_vm_eval(
+        vm,
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+        environment);
+
+    octaspire_dern_vm_push_value(vm, firstValue);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        if (!octaspire_dern_value_is_greater_than_or_equal(
+                firstValue,
+                octaspire_dern_vm_eval(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)i),
+                    environment)))
+        {
+            octaspire_dern_vm_pop_value(vm, firstValue);
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_get_value_false(vm);
+        }
+    }
+
+    octaspire_dern_vm_pop_value(vm, firstValue);
+    octaspire_dern_vm_pop_value(vm, arguments);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+static size_t octaspire_dern_vm_private_template_helper(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t * arguments,
+    size_t * currentIndex,
+    octaspire_dern_value_t *environment,
+    octaspire_dern_value_t **result)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    char   const * const dernFuncName = "template";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    octaspire_dern_value_t * value =
+        octaspire_dern_value_as_vector_get_element_at(arguments, *currentIndex);
+
+    octaspire_helpers_verify_not_null(value);
+
+    if (octaspire_dern_value_is_symbol_and_equal_to_c_string(
+            value,
+            ","))
     {
         if (*currentIndex == (numArgs - 1))
         {
             octaspire_dern_value_t * tmpVal =
                 octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    "Special '%s' expects a value after %zu. argument ',@'.",
+                    "Special '%s' expects a value after %zu. argument ','.",
                     dernFuncName,
                     (*currentIndex + 1));
 
             octaspire_helpers_verify_true(
                 octaspire_dern_vm_push_value(vm, tmpVal));
 
+
             if (*result == 0)
             {
                 *result = tmpVal;
@@ -4188,25 +4537,100 @@ static size_t octaspire_dern_vm_private_template_helper(
         octaspire_helpers_verify_true(
             octaspire_dern_vm_push_value(vm, tmpVal));
 
-        if (octaspire_dern_value_is_vector(tmpVal))
+        if (*result == 0)
         {
-            if (*result == 0)
-            {
-                *result = tmpVal;
-            }
-            else
-            {
-                for (size_t i = 0;
-                     i < octaspire_dern_value_as_vector_get_length(tmpVal);
-                     ++i)
-                {
-                    octaspire_dern_value_t * const valueFromVector =
-                        octaspire_dern_value_as_vector_get_element_at(
-                            tmpVal,
-                            i);
+            *result = tmpVal;
+        }
+        else
+        {
+            octaspire_helpers_verify_true(
+                octaspire_dern_value_as_vector_push_back_element(
+                    *result,
+                    &tmpVal));
+        }
 
-                    octaspire_helpers_verify_true(
-                        octaspire_dern_value_as_vector_push_back_element(
+        octaspire_helpers_verify_true(
+            octaspire_dern_vm_pop_value(vm, tmpVal));
+
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        ++(*currentIndex);
+        return 2;
+    }
+    else if (octaspire_dern_value_is_symbol_and_equal_to_c_string(
+                 value,
+                 ",@"))
+    {
+        if (*currentIndex == (numArgs - 1))
+        {
+            octaspire_dern_value_t * tmpVal =
+                octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Special '%s' expects a value after %zu. argument ',@'.",
+                    dernFuncName,
+                    (*currentIndex + 1));
+
+            octaspire_helpers_verify_true(
+                octaspire_dern_vm_push_value(vm, tmpVal));
+
+            if (*result == 0)
+            {
+                *result = tmpVal;
+            }
+            else
+            {
+                octaspire_helpers_verify_true(
+                    octaspire_dern_value_as_vector_push_back_element(
+                        *result,
+                        &tmpVal));
+            }
+
+            octaspire_helpers_verify_true(
+                octaspire_dern_vm_pop_value(vm, tmpVal));
+
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            ++(*currentIndex);
+            return 1;
+        }
+
+        ++(*currentIndex);
+
+        value = octaspire_dern_value_as_vector_get_element_at(
+            arguments,
+            *currentIndex);
+
+        octaspire_helpers_verify_not_null(value);
+
+        octaspire_dern_value_t * tmpVal =
+            octaspire_dern_vm_eval(vm, value, environment);
+
+        octaspire_helpers_verify_not_null(tmpVal);
+
+        octaspire_helpers_verify_true(
+            octaspire_dern_vm_push_value(vm, tmpVal));
+
+        if (octaspire_dern_value_is_vector(tmpVal))
+        {
+            if (*result == 0)
+            {
+                *result = tmpVal;
+            }
+            else
+            {
+                for (size_t i = 0;
+                     i < octaspire_dern_value_as_vector_get_length(tmpVal);
+                     ++i)
+                {
+                    octaspire_dern_value_t * const valueFromVector =
+                        octaspire_dern_value_as_vector_get_element_at(
+                            tmpVal,
+                            i);
+
+                    octaspire_helpers_verify_true(
+                        octaspire_dern_value_as_vector_push_back_element(
                             *result,
                             &valueFromVector));
                 }
@@ -5129,6 +5553,62 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_port_close(
     return octaspire_dern_vm_create_new_value_boolean(vm, wasClosed);
 }
 
+// Reads at most 'numOctets' octets from the port in chunks, and appends
+// them into 'result', that is either bytes or a vector of integers.
+static void octaspire_dern_vm_builtin_private_port_read_octets(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_port_t * const port,
+    int32_t const numOctets,
+    octaspire_dern_value_t * const result)
+{
+    ptrdiff_t numOctetsLeft = numOctets;
+
+    while (numOctetsLeft > 0)
+    {
+        char buffer[512];
+
+        size_t const numOctetsToRead =
+            ((size_t)numOctetsLeft < sizeof(buffer))
+            ? (size_t)numOctetsLeft
+            : sizeof(buffer);
+
+        ptrdiff_t const numOctetsRead =
+            octaspire_dern_port_read(port, buffer, numOctetsToRead);
+
+        if (numOctetsRead <= 0)
+        {
+            break;
+        }
+
+        if (octaspire_dern_value_is_bytes(result))
+        {
+            if (!octaspire_dern_bytes_push_back_buffer(
+                    result->value.bytes,
+                    buffer,
+                    (size_t)numOctetsRead))
+            {
+                abort();
+            }
+        }
+        else
+        {
+            for (ptrdiff_t i = 0; i < numOctetsRead; ++i)
+            {
+                octaspire_dern_value_t *elem =
+                    octaspire_dern_vm_create_new_value_integer(vm, (int32_t)buffer[i]);
+
+                octaspire_helpers_verify_not_null(elem);
+
+                octaspire_dern_vm_push_value(vm, elem);
+                octaspire_dern_value_as_vector_push_back_element(result, &elem);
+                octaspire_dern_vm_pop_value(vm, elem);
+            }
+        }
+
+        numOctetsLeft -= numOctetsRead;
+    }
+}
+
 octaspire_dern_value_t *octaspire_dern_vm_builtin_port_read(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
@@ -5190,28 +5670,11 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_port_read(
 
         octaspire_dern_vm_push_value(vm, result);
 
-        // TODO better implementation
-        for (ptrdiff_t i = 0; i < secondArg->value.integer; ++i)
-        {
-            char buffer[1];
-
-            ptrdiff_t const numOctetsRead =
-                octaspire_dern_port_read(firstArg->value.port, buffer, sizeof(buffer));
-
-            if (numOctetsRead != 1)
-            {
-                break;
-            }
-
-            octaspire_dern_value_t *elem =
-                octaspire_dern_vm_create_new_value_integer(vm, (int32_t)buffer[0]);
-
-            octaspire_helpers_verify_not_null(elem);
-
-            octaspire_dern_vm_push_value(vm, elem);
-            octaspire_dern_value_as_vector_push_back_element(result, &elem);
-            octaspire_dern_vm_pop_value(vm, elem);
-        }
+        octaspire_dern_vm_builtin_private_port_read_octets(
+            vm,
+            firstArg->value.port,
+            secondArg->value.integer,
+            result);
 
         octaspire_helpers_verify_not_null(result);
 
@@ -5247,6 +5710,77 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_port_read(
     }
 }
 
+octaspire_dern_value_t *octaspire_dern_vm_builtin_port_read_bytes(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs != 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'port-read-bytes' expects exactly two arguments. "
+            "%zu arguments were given.",
+            numArgs);
+    }
+
+    octaspire_dern_vm_push_value(vm, arguments);
+
+    octaspire_dern_value_t *firstArg = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_helpers_verify_not_null(firstArg);
+
+    if (firstArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_PORT)
+    {
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The first argument to builtin 'port-read-bytes' must be a port. "
+            "Now type %s was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+    }
+
+    octaspire_dern_value_t *secondArg = octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+    octaspire_helpers_verify_not_null(secondArg);
+
+    if (secondArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+    {
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The second argument to builtin 'port-read-bytes' must be an integer. "
+            "Now type %s was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(secondArg->typeTag));
+    }
+
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_bytes(vm);
+
+    octaspire_helpers_verify_not_null(result);
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    // Octets are read in chunks straight into the buffer of the bytes.
+    octaspire_dern_vm_builtin_private_port_read_octets(
+        vm,
+        firstArg->value.port,
+        secondArg->value.integer,
+        result);
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_dern_vm_pop_value(vm, arguments);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
 octaspire_dern_value_t *octaspire_dern_vm_builtin_port_write(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
@@ -5379,6 +5913,29 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_port_write(
                     (int32_t)bufferLen);
             }
     }
+    else if (secondArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES)
+    {
+        size_t const bufferLen = octaspire_dern_bytes_get_length(secondArg->value.bytes);
+
+        ptrdiff_t const numWritten = octaspire_dern_port_write(
+            firstArg->value.port,
+            octaspire_dern_bytes_get_octets(secondArg->value.bytes),
+            bufferLen);
+
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        if (numWritten < 0 || (size_t)numWritten != bufferLen)
+        {
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Writing of %zu octets of bytes failed. Only %td octets were written.",
+                bufferLen,
+                numWritten);
+        }
+
+        return octaspire_dern_vm_create_new_value_integer(vm, (int32_t)bufferLen);
+    }
     else if (secondArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
     {
         int32_t counter = 0;
@@ -5794,26 +6351,2984 @@ octaspire_dern_value_t *octaspire_dern_vm_special_and(
 
         result = octaspire_dern_vm_eval(vm, arg, environment);
 
-        if (octaspire_dern_vm_get_function_return(vm))
+        if (octaspire_dern_vm_get_function_return(vm))
+        {
+            result = octaspire_dern_vm_get_function_return(vm);
+            break;
+        }
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        {
+            if (!result->value.boolean)
+            {
+                break;
+            }
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_special_or(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_boolean(vm, false);
+    }
+
+    octaspire_dern_value_t *result = 0;
+
+    for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(arguments); ++i)
+    {
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        result = octaspire_dern_vm_eval(vm, arg, environment);
+
+        if (octaspire_dern_vm_get_function_return(vm))
+        {
+            result = octaspire_dern_vm_get_function_return(vm);
+            break;
+        }
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        {
+            if (result->value.boolean)
+            {
+                break;
+            }
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_special_do(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Special 'do' expects at least one argument.");
+    }
+
+    octaspire_dern_value_t *result = 0;
+
+    for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(arguments); ++i)
+    {
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        result = octaspire_dern_vm_eval(vm, arg, environment);
+
+        if (octaspire_dern_vm_get_function_return(vm))
+        {
+            result = octaspire_dern_vm_get_function_return(vm);
+            //octaspire_dern_vm_set_function_return(vm, 0);
+            break;
+        }
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_string_t *tmpStr =
+                octaspire_dern_value_to_string(arg, octaspire_dern_vm_get_allocator(vm));
+
+            octaspire_string_concatenate_format(
+                result->value.error->message,
+                "\n\tAt form: >>>>>>>>>>%s<<<<<<<<<<\n",
+                octaspire_string_get_c_string(tmpStr));
+
+            octaspire_string_release(tmpStr);
+            tmpStr = 0;
+
+            break;
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_exit(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) > 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'exit' expects zero or one argument.");
+    }
+
+    if (octaspire_vector_get_length(vec) == 1)
+    {
+        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+
+        if (value->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin 'exit' expects integer argument. Type %s was given.",
+                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+        }
+
+        octaspire_dern_vm_set_exit_code(vm, value->value.integer);
+    }
+
+    octaspire_dern_vm_quit(vm);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_doc(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'doc' expects at least one argument.");
+    }
+
+    if (octaspire_vector_get_length(vec) == 1)
+    {
+        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+
+        if (value->docstr)
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return value->docstr;
+        }
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_get_value_nil(vm);
+    }
+    else
+    {
+        octaspire_vector_t *resultVec = octaspire_vector_new(
+            sizeof(octaspire_dern_value_t*),
+            true,
+            0,
+            octaspire_dern_vm_get_allocator(vm));
+
+        octaspire_dern_value_t *resultVal =
+            octaspire_dern_vm_create_new_value_vector_from_vector(vm, resultVec);
+
+        octaspire_dern_vm_push_value(vm, resultVal);
+
+        for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
+        {
+            octaspire_dern_value_t * const value =
+                octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
+
+            if (value->docstr)
+            {
+                octaspire_vector_push_back_element(resultVec, &(value->docstr));
+            }
+            else
+            {
+                octaspire_dern_value_t *valueNil = octaspire_dern_vm_get_value_nil(vm);
+                octaspire_vector_push_back_element(resultVec, &valueNil);
+            }
+        }
+
+        octaspire_dern_vm_pop_value(vm, resultVal);
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return resultVal;
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_len(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'len' expects at least one argument.");
+    }
+
+    if (octaspire_vector_get_length(vec) == 1)
+    {
+        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+
+        // TODO XXX check number ranges for too large size_t value for int32_t?
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_integer(
+            vm,
+            (int32_t)octaspire_dern_value_get_length(value));
+    }
+    else
+    {
+        octaspire_dern_value_t *resultVal = octaspire_dern_vm_create_new_value_vector(vm);
+
+        octaspire_dern_vm_push_value(vm, resultVal);
+
+        for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
+        {
+            octaspire_dern_value_t * const value =
+                octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
+
+            // TODO XXX check number ranges for too large size_t value for int32_t?
+            octaspire_dern_value_t *valueLen = octaspire_dern_vm_create_new_value_integer(
+                vm,
+                (int32_t)octaspire_dern_value_get_length(value));
+
+            // TODO & or not?
+            if (!octaspire_dern_value_as_vector_push_back_element(
+                resultVal,
+                &valueLen))
+            {
+                abort();
+            }
+        }
+
+        octaspire_dern_vm_pop_value(vm, resultVal);
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return resultVal;
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_read_and_eval_path(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    size_t const numPaths = octaspire_vector_get_length(vec);
+
+    if (numPaths < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'read-and-eval-path' expects at least one argument. "
+            "%zu arguments were given.",
+            numPaths);
+    }
+
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        octaspire_dern_value_t const * const path =
+            octaspire_vector_get_element_at_const(vec, (ptrdiff_t)i);
+
+        if (path->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Arguments to builtin 'read-and-eval-path' must be strings (paths). "
+                "Type '%s' was given as argument %zu.",
+                octaspire_dern_value_helper_get_type_as_c_string(path->typeTag),
+                i + 1);
+        }
+    }
+
+    if (numPaths == 1)
+    {
+        octaspire_dern_value_t const * const path =
+            octaspire_vector_get_element_at_const(vec, 0);
+
+        octaspire_dern_value_t *result =
+            octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
+                vm,
+                octaspire_string_get_c_string(path->value.string));
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
+    }
+
+    char const ** const paths = octaspire_allocator_malloc(
+        octaspire_dern_vm_get_allocator(vm),
+        sizeof(char const *) * numPaths);
+
+    if (!paths)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'read-and-eval-path' failed to allocate paths.");
+    }
+
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        octaspire_dern_value_t const * const path =
+            octaspire_vector_get_element_at_const(vec, (ptrdiff_t)i);
+
+        paths[i] = octaspire_string_get_c_string(path->value.string);
+    }
+
+    // The arguments are on the stack during the call, so the paths stay
+    // valid while the files are evaluated.
+    octaspire_dern_value_t *result =
+        octaspire_dern_vm_read_from_paths_and_eval_in_global_environment(vm, paths, numPaths);
+
+    octaspire_allocator_free(octaspire_dern_vm_get_allocator(vm), paths);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_save_image(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'save-image' expects one argument. "
+            "%zu arguments were given.",
+            numArgs);
+    }
+
+    octaspire_dern_value_t const * const path =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    if (path->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'save-image' expects string (path) as the first argument. "
+            "Type '%s' was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(path->typeTag));
+    }
+
+    octaspire_dern_value_t * const result = octaspire_dern_image_save(
+        vm,
+        octaspire_string_get_c_string(path->value.string));
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_read_and_eval_string(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'read-and-eval-string' expects one argument. %zu arguments were given.",
+            octaspire_vector_get_length(vec));
+    }
+
+    octaspire_dern_value_t *stringToEval = octaspire_vector_get_element_at(vec, 0);
+
+    if (stringToEval->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin 'read-and-eval-string' must be string (to be evaluated). "
+            "Type '%s' was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(stringToEval->typeTag));
+    }
+
+    octaspire_dern_value_t *result =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            octaspire_string_get_c_string(stringToEval->value.string));
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_format(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'string-format' expects one or more arguments.");
+    }
+
+    octaspire_dern_value_t const * const fmtStr =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    octaspire_helpers_verify_not_null(fmtStr);
+
+    octaspire_string_t *resultStr = 0;
+
+    if (numArgs == 1)
+    {
+        octaspire_string_t *str =
+            octaspire_dern_value_to_string(fmtStr, octaspire_dern_vm_get_allocator(vm));
+
+        octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_string(vm, str);
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
+    }
+    else
+    {
+        if (fmtStr->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin 'string-format' must be format string if there are more "
+                "than one argument. Type '%s' was given.",
+                octaspire_dern_value_helper_get_type_as_c_string(fmtStr->typeTag));
+
+        }
+
+        resultStr = octaspire_string_new(
+            "",
+            octaspire_dern_vm_get_allocator(vm));
+
+        size_t const fmtStrLen =
+            octaspire_string_get_length_in_ucs_characters(fmtStr->value.string);
+
+        uint32_t prevChar = 0;
+        uint32_t curChar = 0;
+        uint32_t nextChar = 0;
+
+        size_t fmtValueIndex = 1;
+
+        for (size_t c = 0; c < fmtStrLen; ++c)
+        {
+            curChar =
+                octaspire_string_get_ucs_character_at_index(
+                    fmtStr->value.string,
+                    (ptrdiff_t)c);
+
+            if ((c + 1) < fmtStrLen)
+            {
+                nextChar =
+                    octaspire_string_get_ucs_character_at_index(
+                        fmtStr->value.string,
+                        (ptrdiff_t)(c + 1));
+            }
+            else
+            {
+                nextChar = 0;
+            }
+
+            if (curChar == '\'' && prevChar == '\'')
+            {
+                octaspire_string_push_back_ucs_character(resultStr, '\'');
+                curChar = 0; // To prevent prevChar from becoming '
+            }
+            else if (curChar == '{' && prevChar != '\'')
+            {
+                if (nextChar == '}')
+                {
+                    if (fmtValueIndex >= numArgs)
+                    {
+                        octaspire_helpers_verify_true(
+                            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                        return octaspire_dern_vm_create_new_value_error_from_c_string(
+                            vm,
+                            "Not enough arguments for the format string of 'string-format'.");
+                    }
+
+                    octaspire_string_t *tmpStr =
+                        octaspire_dern_value_to_string_plain(
+                            octaspire_dern_value_as_vector_get_element_at(
+                                arguments,
+                                (ptrdiff_t)fmtValueIndex),
+                            octaspire_dern_vm_get_allocator(vm));
+
+                    octaspire_string_concatenate(resultStr, tmpStr);
+
+                    octaspire_string_release(tmpStr);
+                    tmpStr = 0;
+
+                    ++c;
+                    ++fmtValueIndex;
+                }
+                else
+                {
+                    octaspire_string_push_back_ucs_character(
+                        resultStr,
+                        curChar);
+                }
+            }
+            else
+            {
+                octaspire_string_push_back_ucs_character(
+                    resultStr,
+                    curChar);
+            }
+
+            prevChar = curChar;
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_string(vm, resultStr);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_to_string(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'to-string' expects one or more arguments.");
+    }
+    else
+    {
+        octaspire_string_t * const str = octaspire_dern_value_to_string(
+            octaspire_dern_value_as_vector_get_element_at_const(
+                arguments,
+                0),
+            octaspire_dern_vm_get_allocator(vm));
+
+        for (size_t i = 1; i < numArgs; ++i)
+        {
+            octaspire_string_t * tmpStr =
+                octaspire_dern_value_to_string(
+                octaspire_dern_value_as_vector_get_element_at_const(
+                    arguments,
+                    (ptrdiff_t)i),
+                octaspire_dern_vm_get_allocator(vm));
+
+            octaspire_string_concatenate(str, tmpStr);
+
+            octaspire_string_release(tmpStr);
+            tmpStr = 0;
+        }
+
+        return octaspire_dern_vm_create_new_value_string(vm, str);
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_to_real(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "to-real";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs != numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t const * const value =
+        octaspire_dern_value_as_vector_get_element_at_const(
+            arguments,
+            0);
+
+    // TODO other types
+    if (octaspire_dern_value_is_number(value))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_real(
+            vm,
+            octaspire_dern_value_as_number_get_value(value));
+    }
+    else if (octaspire_dern_value_is_character(value))
+    {
+        octaspire_string_t const * const str =
+            value->value.character;
+
+        octaspire_helpers_verify_not_null(str);
+
+        if (octaspire_string_is_index_valid(str, 0))
+        {
+            return octaspire_dern_vm_create_new_value_real(
+                vm,
+                (double)(octaspire_string_get_ucs_character_at_index(str, 0)));
+        }
+
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_real(vm, 0.0);
+    }
+    else if (octaspire_dern_value_is_text(value))
+    {
+        // TODO error checking.
+        double const valueAsReal = strtod(
+            octaspire_dern_value_as_text_get_c_string(value),
+            0);
+
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_real(vm, valueAsReal);
+    }
+    else
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to '%s' is currently unsupported type. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_to_integer(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'to-integer' expects one or more arguments.");
+    }
+    else if (numArgs == 1)
+    {
+        octaspire_dern_value_t const * const value =
+            octaspire_dern_value_as_vector_get_element_at_const(
+                arguments,
+                0);
+
+        // TODO other types
+        if (octaspire_dern_value_is_number(value))
+        {
+            return octaspire_dern_vm_create_new_value_integer(
+                vm,
+                (int32_t)(octaspire_dern_value_as_number_get_value(value)));
+        }
+        else if (octaspire_dern_value_is_character(value))
+        {
+            octaspire_string_t const * const str =
+                value->value.character;
+
+            octaspire_helpers_verify_not_null(str);
+
+            if (octaspire_string_is_index_valid(str, 0))
+            {
+                return octaspire_dern_vm_create_new_value_integer(
+                    vm,
+                    (int32_t)(octaspire_string_get_ucs_character_at_index(str, 0)));
+            }
+
+            return octaspire_dern_vm_create_new_value_integer(vm, 0);
+        }
+        else if (octaspire_dern_value_is_text(value))
+        {
+            int32_t valueAsInt =
+#ifdef OCTASPIRE_PLAN9_IMPLEMENTATION
+                (int32_t)strtol(
+#else
+    #ifdef __amigaos__
+                (int32_t)strtol(
+    #else
+                (int32_t)strtoimax(
+    #endif
+#endif
+                octaspire_dern_value_as_text_get_c_string(value),
+                0,
+                10);
+
+            return octaspire_dern_vm_create_new_value_integer(vm, valueAsInt);
+        }
+        else
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to 'to-integer' is currently unsupported type. "
+                "Type '%s' was given.",
+                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+        }
+    }
+    else
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'to-integer' supports at the moment only one argument.");
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_print_readably(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs != 0 && numArgs != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'print-readably' expects zero or one argument.");
+    }
+
+    if (numArgs == 1)
+    {
+        octaspire_dern_vm_push_value(vm, arguments);
+
+        octaspire_dern_value_t *firstArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+        octaspire_helpers_verify_not_null(firstArg);
+
+        if (firstArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        {
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_from_c_string(
+                vm,
+                "Builtin 'print-readably' expects boolean argument or no arguments.");
+        }
+
+        bool const given = firstArg->value.boolean;
+        octaspire_dern_vm_set_print_readably(vm, given);
+        octaspire_dern_vm_pop_value(vm, arguments);
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_boolean(
+        vm,
+        octaspire_dern_vm_get_print_readably(vm));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_print(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'print' expects one or more arguments.");
+    }
+
+    octaspire_dern_value_t const * const fmtStr =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    octaspire_helpers_verify_not_null(fmtStr);
+
+    if (fmtStr->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING || numArgs == 1)
+    {
+        octaspire_dern_value_print(fmtStr, octaspire_dern_vm_get_allocator(vm));
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_get_value_true(vm);
+    }
+
+    size_t const fmtStrLen =
+        octaspire_string_get_length_in_ucs_characters(fmtStr->value.string);
+
+    uint32_t prevChar = 0;
+    uint32_t curChar = 0;
+    uint32_t nextChar = 0;
+
+    size_t fmtValueIndex = 1;
+
+    for (size_t c = 0; c < fmtStrLen; ++c)
+    {
+        curChar =
+            octaspire_string_get_ucs_character_at_index(
+                fmtStr->value.string,
+                (ptrdiff_t)c);
+
+        if ((c + 1) < fmtStrLen)
+        {
+            nextChar =
+                octaspire_string_get_ucs_character_at_index(
+                    fmtStr->value.string,
+                    (ptrdiff_t)(c + 1));
+        }
+        else
+        {
+            nextChar = 0;
+        }
+
+        if (curChar == '\'' && prevChar == '\'')
+        {
+            printf("'");
+            curChar = 0; // To prevent prevChar from becoming '
+        }
+        else if (curChar == '{' && prevChar != '\'')
+        {
+            if (nextChar == '}')
+            {
+                if (fmtValueIndex >= numArgs)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Not enough arguments for the format string of 'println'.");
+                }
+
+                octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)fmtValueIndex),
+                    octaspire_dern_vm_get_allocator(vm));
+
+                printf("%s", octaspire_string_get_c_string(tmpStr));
+
+                octaspire_string_release(tmpStr);
+                tmpStr = 0;
+
+                ++c;
+                ++fmtValueIndex;
+            }
+            else
+            {
+                printf("%c", (char)curChar);
+            }
+        }
+        else
+        {
+            printf("%c", (char)curChar);
+        }
+
+        prevChar = curChar;
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_get_value_true(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_println(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
+    {
+        printf("\n");
+        return octaspire_dern_vm_get_value_true(vm);
+    }
+    else
+    {
+        octaspire_dern_value_t *result =
+            octaspire_dern_vm_builtin_print(vm, arguments, environment);
+
+        printf("\n");
+        return result;
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_env_new(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_environment(vm, 0);
+    }
+    else if (octaspire_vector_get_length(vec) == 1)
+    {
+        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+        octaspire_helpers_verify_not_null(value);
+
+        if (value->typeTag != OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT)
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Argument to builtin 'env-new' must be an environment. Now argument has type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+        }
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_environment(vm, value);
+    }
+    else
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'env-new' expects zero or one arguments.");
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_env_current(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) != 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'env-current' expects zero arguments.");
+    }
+
+    return environment;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_env_global(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) != 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'env-global' expects zero arguments.");
+    }
+
+    return octaspire_dern_vm_get_global_environment(vm);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '-=' expects at least one argument.");
+    }
+
+    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+
+    switch (firstArg->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (i == 1)
+                {
+                    octaspire_dern_value_as_character_subtract(firstArg, anotherArg);
+                }
+                else
+                {
+                    octaspire_dern_value_as_string_pop_back_ucs_character(firstArg);
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_real_subtract(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_integer_subtract(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                // TODO XXX remove the need for '&' in &another for vectors!!!!!
+                for (size_t j = 0; j < octaspire_dern_value_as_vector_get_length(firstArg); /*NOP*/)
+                {
+                    octaspire_dern_value_t * const val =
+                        octaspire_dern_value_as_vector_get_element_at(
+                            firstArg,
+                            (ptrdiff_t)j);
+
+                    if (octaspire_dern_value_is_equal(anotherArg, val))
+                    {
+                        octaspire_dern_value_as_vector_remove_element_at(
+                            firstArg,
+                            (ptrdiff_t)j);
+                    }
+                    else
+                    {
+                        ++j;
+                    }
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_string_remove_all_substrings(firstArg, anotherArg))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin '-=' failed");
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_hash_map_remove(firstArg, anotherArg))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin '-=' failed");
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            // Removing an element that is not in the set is not an error.
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_as_set_remove(
+                    firstArg,
+                    octaspire_vector_get_element_at(vec, (ptrdiff_t)i));
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            // Removing a key that is not in the map is not an error.
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_as_sorted_map_remove(
+                    firstArg,
+                    octaspire_vector_get_element_at(vec, (ptrdiff_t)i));
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_semver_add_or_subtract(firstArg, anotherArg, false))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin '-=' failed on SemVer");
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return firstArg;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin '-=' cannot be of type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return firstArg;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals_equals(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '-==' expects at least one argument.");
+    }
+
+    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+
+    switch (firstArg->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin '-==' cannot be of type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                for (size_t j = 0; j < octaspire_dern_value_as_vector_get_length(firstArg); /*NOP*/)
+                {
+                    octaspire_dern_value_t * const val =
+                        octaspire_dern_value_as_vector_get_element_at(
+                            firstArg,
+                            (ptrdiff_t)j);
+
+                    if (anotherArg->uniqueId == val->uniqueId)
+                    {
+                        octaspire_dern_value_as_vector_remove_element_at(
+                            firstArg,
+                            (ptrdiff_t)j);
+                    }
+                    else
+                    {
+                        ++j;
+                    }
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return firstArg;
+        }
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return firstArg;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_back(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) != 1)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'pop-back' expects exactly one argument.");
+    }
+
+    octaspire_dern_value_t * const firstArg =
+        octaspire_vector_get_element_at(vec, 0);
+
+    switch (firstArg->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            octaspire_dern_value_as_vector_pop_back_element(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            octaspire_dern_value_as_list_pop_back(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        {
+            octaspire_dern_value_as_queue_pop(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            octaspire_dern_value_as_string_pop_back_ucs_character(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        {
+            octaspire_dern_value_as_symbol_pop_back(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            octaspire_dern_value_as_semver_pop_back(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return firstArg;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin 'pop-back' cannot be of type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+        }
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return firstArg;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_front(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) != 1)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'pop-front' expects exactly one argument.");
+    }
+
+    octaspire_dern_value_t * const firstArg =
+        octaspire_vector_get_element_at(vec, 0);
+
+    switch (firstArg->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            octaspire_dern_value_as_vector_pop_front_element(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            octaspire_dern_value_as_list_pop_front(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            octaspire_dern_value_as_string_pop_front_ucs_character(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        {
+            octaspire_dern_value_as_symbol_pop_front(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            octaspire_dern_value_as_semver_pop_front(firstArg);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return firstArg;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin 'pop-front' cannot be of type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+        }
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return firstArg;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_distance(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "distance";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs != 2)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects two arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
+
+    // TODO support also other types in addition to text (string or symbol)
+    // and numeric arguments.
+
+    octaspire_dern_value_t * const firstArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    if (!octaspire_dern_value_is_number(firstArgVal) &&
+        !octaspire_dern_value_is_text(firstArgVal))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The first argument to builtin '%s' must be a number or text. "
+            "Type %s was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
+    }
+
+    octaspire_dern_value_t * const secondArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+
+    if (!octaspire_dern_value_is_number(secondArgVal) &&
+        !octaspire_dern_value_is_text(secondArgVal))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The second argument to builtin '%s' must be a number or text. "
+            "Type %s was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+    }
+
+    if (octaspire_dern_value_is_number(firstArgVal))
+    {
+        if (octaspire_dern_value_is_text(secondArgVal))
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "The second argument to builtin '%s' must be a number "
+                "when first is a number. Type %s was given.",
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+        }
+
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        // TODO maybe return integer if both arguments were integers, and so on.
+        return octaspire_dern_vm_create_new_value_real(
+            vm,
+            fabs(
+                octaspire_dern_value_as_number_get_value(firstArgVal) -
+                octaspire_dern_value_as_number_get_value(secondArgVal)));
+    }
+
+    if (octaspire_dern_value_is_number(secondArgVal))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The second argument to builtin '%s' must be textual "
+            "when first is textual. Type %s was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return octaspire_dern_vm_create_new_value_integer(
+        vm,
+        octaspire_string_levenshtein_distance(
+            octaspire_dern_value_as_text_get_string_const(firstArgVal),
+            octaspire_dern_value_as_text_get_string_const(secondArgVal)));
+}
+
+static bool octaspire_dern_vm_builtin_private_has_typed_array_argument(
+    octaspire_dern_value_t const * const arguments)
+{
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const argVal =
+            octaspire_dern_value_as_vector_get_element_at_const(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(argVal);
+
+        if (octaspire_dern_value_is_typed_array(argVal))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Applies 'operation' element-wise to typed arrays and numbers given as
+// arguments. Numbers are broadcast to every element. The element type of
+// the result is the type of the first typed array argument, except that
+// division, pow, sqrt and sin of integer arrays give 'f64 arrays.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_typed_array_operation(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    octaspire_dern_typed_array_operation_t const operation,
+    char const * const dernFuncName)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    size_t const numArgs     = octaspire_dern_value_get_length(arguments);
+
+    octaspire_dern_typed_array_t const * firstTypedArray = 0;
+
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const argVal =
+            octaspire_dern_value_as_vector_get_element_at_const(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(argVal);
+
+        if (octaspire_dern_value_is_typed_array(argVal))
+        {
+            if (!firstTypedArray)
+            {
+                firstTypedArray = argVal->value.typedArray;
+            }
+            else if (octaspire_dern_typed_array_get_length(argVal->value.typedArray) !=
+                     octaspire_dern_typed_array_get_length(firstTypedArray))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Typed arrays given to builtin '%s' must have the same length. "
+                    "Lengths %zu and %zu were given.",
+                    dernFuncName,
+                    octaspire_dern_typed_array_get_length(firstTypedArray),
+                    octaspire_dern_typed_array_get_length(argVal->value.typedArray));
+            }
+        }
+        else if (!octaspire_dern_value_is_number(argVal))
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Arguments to builtin '%s' should be typed arrays or numbers. "
+                "Type '%s' was given as argument %zu.",
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag),
+                i + 1);
+        }
+    }
+
+    octaspire_helpers_verify_not_null(firstTypedArray);
+
+    octaspire_dern_typed_array_element_type_t elementType =
+        octaspire_dern_typed_array_get_element_type(firstTypedArray);
+
+    if (octaspire_dern_typed_array_element_type_is_integer(elementType) &&
+        (operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE ||
+         operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_POW    ||
+         operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT   ||
+         operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN))
+    {
+        elementType = OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64;
+    }
+
+    size_t const length = octaspire_dern_typed_array_get_length(firstTypedArray);
+
+    octaspire_dern_value_t const * const firstArgVal =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArgVal);
+
+    octaspire_dern_value_t * result = 0;
+
+    // (- arr) and (/ arr) work like (- 0 arr) and (/ 1 arr).
+    size_t firstOperand = 1;
+
+    if (numArgs == 1 &&
+        (operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SUBTRACT ||
+         operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE))
+    {
+        result = octaspire_dern_vm_create_new_value_typed_array(vm, elementType, length);
+
+        octaspire_dern_typed_array_fill_real(
+            result->value.typedArray,
+            (operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE) ? 1 : 0);
+
+        firstOperand = 0;
+    }
+    else if (octaspire_dern_value_is_typed_array(firstArgVal))
+    {
+        result = octaspire_dern_vm_create_new_value_typed_array_copy(
+            vm,
+            firstArgVal->value.typedArray,
+            elementType);
+    }
+    else
+    {
+        result = octaspire_dern_vm_create_new_value_typed_array(vm, elementType, length);
+
+        octaspire_dern_typed_array_fill_real(
+            result->value.typedArray,
+            octaspire_dern_value_as_number_get_value(firstArgVal));
+    }
+
+    octaspire_dern_typed_array_t * const resultArray = result->value.typedArray;
+
+    if (operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT ||
+        operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN)
+    {
+        octaspire_dern_typed_array_apply_unary(resultArray, operation);
+
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return result;
+    }
+
+    for (size_t i = firstOperand; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const argVal =
+            octaspire_dern_value_as_vector_get_element_at_const(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(argVal);
+
+        if (!octaspire_dern_value_is_typed_array(argVal))
+        {
+            octaspire_dern_typed_array_apply_scalar(
+                resultArray,
+                operation,
+                octaspire_dern_value_as_number_get_value(argVal));
+        }
+        else if (octaspire_dern_typed_array_get_element_type(argVal->value.typedArray) ==
+                 elementType)
+        {
+            octaspire_dern_typed_array_apply_array(
+                resultArray,
+                operation,
+                argVal->value.typedArray);
+        }
+        else
+        {
+            octaspire_dern_typed_array_t * const converted =
+                octaspire_dern_typed_array_new_copy(
+                    argVal->value.typedArray,
+                    elementType,
+                    octaspire_dern_vm_get_allocator(vm));
+
+            octaspire_helpers_verify_not_null(converted);
+
+            octaspire_dern_typed_array_apply_array(resultArray, operation, converted);
+            octaspire_dern_typed_array_release(converted);
+        }
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_max(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "max";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 2;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
+            vm,
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MAX,
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * largestArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(largestArgVal);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t * const nextArgVal =
+            octaspire_dern_value_as_vector_get_element_at(arguments, i);
+
+        octaspire_helpers_verify_not_null(nextArgVal);
+
+        if (octaspire_dern_value_is_greater_than(nextArgVal, largestArgVal))
+        {
+            largestArgVal = nextArgVal;
+        }
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return largestArgVal;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_min(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "min";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 2;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
+            vm,
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MIN,
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * smallestArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(smallestArgVal);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t * const nextArgVal =
+            octaspire_dern_value_as_vector_get_element_at(arguments, i);
+
+        octaspire_helpers_verify_not_null(nextArgVal);
+
+        if (octaspire_dern_value_is_less_than(nextArgVal, smallestArgVal))
+        {
+            smallestArgVal = nextArgVal;
+        }
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return smallestArgVal;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_cos(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "cos";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        cos(octaspire_dern_value_as_number_get_value(argVal)));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sin(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "sin";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
+            vm,
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN,
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        sin(octaspire_dern_value_as_number_get_value(argVal)));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_tan(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "tan";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        tan(octaspire_dern_value_as_number_get_value(argVal)));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_asin(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "asin";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    double const result = asin(octaspire_dern_value_as_number_get_value(argVal));
+
+    if (isnan(result))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "%s: math domain error.",
+            dernFuncName);
+    }
+
+    return octaspire_dern_vm_create_new_value_real(vm, result);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_acos(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "acos";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    double const result = acos(octaspire_dern_value_as_number_get_value(argVal));
+
+    if (isnan(result))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "%s: math domain error.",
+            dernFuncName);
+    }
+
+    return octaspire_dern_vm_create_new_value_real(vm, result);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_atan(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "atan";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs < numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    double const result = atan(octaspire_dern_value_as_number_get_value(argVal));
+
+    if (isnan(result))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "%s: math domain error.",
+            dernFuncName);
+    }
+
+    return octaspire_dern_vm_create_new_value_real(vm, result);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sqrt(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "sqrt";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 1;
+
+    if (numArgs != numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
+            vm,
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT,
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * argVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(argVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(argVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+    }
+
+    if (octaspire_dern_value_as_number_get_value(argVal) < 0)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' have to be non-negative. "
+            "Value '%f' was given.",
+            dernFuncName,
+            octaspire_dern_value_as_number_get_value(argVal));
+    }
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        sqrt(octaspire_dern_value_as_number_get_value(argVal)));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_pow(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "pow";
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numExpectedArgs = 2;
+
+    if (numArgs != numExpectedArgs)
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numExpectedArgs,
+            numArgs);
+    }
+
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
+    {
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
+            vm,
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_POW,
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * firstArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArgVal);
+
+    octaspire_dern_value_t * secondArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+
+    octaspire_helpers_verify_not_null(secondArgVal);
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (!octaspire_dern_value_is_number(firstArgVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
+    }
+
+    if (!octaspire_dern_value_is_number(secondArgVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Second argument to builtin '%s' should be a number. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+    }
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        pow(
+            octaspire_dern_value_as_number_get_value(firstArgVal),
+            octaspire_dern_value_as_number_get_value(secondArgVal)));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_equals(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '+=' expects at least one argument.");
+    }
+
+    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+
+    switch (firstArg->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (i == 1)
+                {
+                    octaspire_dern_value_as_character_add(firstArg, anotherArg);
+                }
+                else
+                {
+                    octaspire_dern_value_as_string_push_back(firstArg, anotherArg);
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_real_add(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_integer_add(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                // TODO XXX remove the need for '&' in &another for vectors!!!!!
+                octaspire_dern_value_as_vector_push_back_element(firstArg, &anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_list_push_back(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_as_queue_push(firstArg, anotherArg);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                octaspire_dern_value_t *tmpArgs = octaspire_dern_vm_create_new_value_vector(vm);
+
+                octaspire_dern_vm_push_value(vm, tmpArgs);
+
+                octaspire_dern_value_as_vector_push_back_element(tmpArgs, &firstArg);
+                octaspire_dern_value_as_vector_push_back_element(tmpArgs, &anotherArg);
+
+                octaspire_dern_vm_builtin_port_write(vm, tmpArgs, environment);
+
+                octaspire_dern_vm_pop_value(vm, tmpArgs);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            //bool success = true;
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_string_push_back(firstArg, anotherArg))
+                {
+                    //success = false;
+                }
+            }
+
+            // TODO report possible error?
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        {
+            //bool success = true;
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_symbol_push_back(firstArg, anotherArg))
+                {
+                    //success = false;
+                }
+            }
+
+            // TODO report possible error?
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t * const anotherArg =
+                    octaspire_vector_get_element_at(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_semver_add_or_subtract(firstArg, anotherArg, true))
+                {
+                    //success = false;
+                }
+
+                // TODO report possible error?
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            if (octaspire_vector_get_length(vec) == 2)
+            {
+                if (!octaspire_dern_value_as_hash_map_add(
+                        firstArg,
+                        octaspire_vector_get_element_at(vec, 1),
+                        0))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin '+=' failed");
+                }
+            }
+            else if (octaspire_vector_get_length(vec) == 3)
+            {
+                if (!octaspire_dern_value_as_hash_map_add(
+                        firstArg,
+                        octaspire_vector_get_element_at(vec, 1),
+                        octaspire_vector_get_element_at(vec, 2)))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin '+=' failed");
+                }
+            }
+            else
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin '+=' expects one or two additional arguments for hash map");
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                octaspire_dern_value_t const * const anotherArg =
+                    octaspire_vector_get_element_at_const(
+                        vec,
+                        (ptrdiff_t)i);
+
+                if (!octaspire_dern_value_as_string_builder_push_back(firstArg, anotherArg))
+                {
+                    abort();
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            {
+                if (!octaspire_dern_value_as_set_add(
+                        firstArg,
+                        octaspire_vector_get_element_at(vec, (ptrdiff_t)i)))
+                {
+                    abort();
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            if (octaspire_vector_get_length(vec) % 2 != 1)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin '+=' expects pairs of keys and values for sorted map");
+            }
+
+            for (size_t i = 1; i < octaspire_vector_get_length(vec); i += 2)
+            {
+                if (!octaspire_dern_value_as_sorted_map_put(
+                        firstArg,
+                        octaspire_vector_get_element_at(vec, (ptrdiff_t)i),
+                        octaspire_vector_get_element_at(vec, (ptrdiff_t)(i + 1))))
+                {
+                    abort();
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
         {
-            result = octaspire_dern_vm_get_function_return(vm);
-            break;
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return firstArg;
         }
 
-        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
-            if (!result->value.boolean)
-            {
-                break;
-            }
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "First argument to builtin '+=' cannot be of type '%s'.",
+                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return firstArg;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_special_or(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_plus(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -5823,45 +9338,49 @@ octaspire_dern_value_t *octaspire_dern_vm_special_or(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_boolean(vm, false);
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin '++' expects at least one argument.");
     }
 
-    octaspire_dern_value_t *result = 0;
+    octaspire_dern_value_t *value = 0;
 
-    for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(arguments); ++i)
+    for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
     {
-        octaspire_dern_value_t * const arg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        value = octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
 
-        octaspire_helpers_verify_not_null(arg);
+        if (!octaspire_dern_value_is_number(value))
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Arguments to builtin '++' must be numbers. %zuth argument has type '%s'.",
+                i + 1,
+                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+        }
 
-        result = octaspire_dern_vm_eval(vm, arg, environment);
+        octaspire_dern_value_prepare_for_mutation(value);
 
-        if (octaspire_dern_vm_get_function_return(vm))
+        if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER)
         {
-            result = octaspire_dern_vm_get_function_return(vm);
-            break;
+            ++(value->value.integer);
         }
-
-        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        else
         {
-            if (result->value.boolean)
-            {
-                break;
-            }
+            ++(value->value.real);
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return value;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_special_do(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_minus(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -5871,99 +9390,100 @@ octaspire_dern_value_t *octaspire_dern_vm_special_do(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
+    octaspire_vector_t * const vec = arguments->value.vector;
+
+    if (octaspire_vector_get_length(vec) < 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_from_c_string(
             vm,
-            "Special 'do' expects at least one argument.");
+            "Builtin '--' expects at least one argument.");
     }
 
-    octaspire_dern_value_t *result = 0;
+    octaspire_dern_value_t *value = 0;
 
-    for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(arguments); ++i)
+    for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
     {
-        octaspire_dern_value_t * const arg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
-
-        octaspire_helpers_verify_not_null(arg);
-
-        result = octaspire_dern_vm_eval(vm, arg, environment);
+        value = octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
 
-        if (octaspire_dern_vm_get_function_return(vm))
+        if (octaspire_dern_value_is_integer(value))
         {
-            result = octaspire_dern_vm_get_function_return(vm);
-            //octaspire_dern_vm_set_function_return(vm, 0);
-            break;
+            octaspire_dern_value_prepare_for_mutation(value);
+            --(value->value.integer);
         }
-
-        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        else if (octaspire_dern_value_is_real(value))
         {
-            octaspire_string_t *tmpStr =
-                octaspire_dern_value_to_string(arg, octaspire_dern_vm_get_allocator(vm));
-
-            octaspire_string_concatenate_format(
-                result->value.error->message,
-                "\n\tAt form: >>>>>>>>>>%s<<<<<<<<<<\n",
-                octaspire_string_get_c_string(tmpStr));
-
-            octaspire_string_release(tmpStr);
-            tmpStr = 0;
-
-            break;
+            octaspire_dern_value_prepare_for_mutation(value);
+            --(value->value.real);
         }
-    }
-
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
-}
-
-octaspire_dern_value_t *octaspire_dern_vm_builtin_exit(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
-
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+        else if (octaspire_dern_value_is_queue(value))
+        {
+            if (!octaspire_dern_value_as_queue_pop(value))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '--' failed on %zuth argument (queue)",
+                    i + 1);
+            }
+        }
+        else if (octaspire_dern_value_is_list(value))
+        {
+            if (!octaspire_dern_value_as_list_pop_back(value))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    if (octaspire_vector_get_length(vec) > 1)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'exit' expects zero or one argument.");
-    }
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '--' failed on %zuth argument (list)",
+                    i + 1);
+            }
+        }
+        else if (octaspire_dern_value_is_vector(value))
+        {
+            if (!octaspire_dern_value_as_vector_pop_back_element(value))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    if (octaspire_vector_get_length(vec) == 1)
-    {
-        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '--' failed on %zuth argument (vector)",
+                    i + 1);
+            }
+        }
+        else if (octaspire_dern_value_is_string(value))
+        {
+            if (!octaspire_dern_value_as_string_pop_back_ucs_character(value))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        if (value->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '--' failed on %zuth argument (string)",
+                    i + 1);
+            }
+        }
+        else
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
                 vm,
-                "Builtin 'exit' expects integer argument. Type %s was given.",
+                "%zuth argument to builtin '--' has unsupported type '%s'.",
+                i + 1,
                 octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
         }
-
-        octaspire_dern_vm_set_exit_code(vm, value->value.integer);
     }
 
-    octaspire_dern_vm_quit(vm);
-
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
+    return value;
 }
 
-
-octaspire_dern_value_t *octaspire_dern_vm_builtin_doc(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_mod(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -5973,66 +9493,70 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_doc(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
+    if (numArgs != 2)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'doc' expects at least one argument.");
+            "Builtin 'mod' expects two arguments (integers). %zu arguments were given.",
+            numArgs);
     }
 
-    if (octaspire_vector_get_length(vec) == 1)
-    {
-        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+    octaspire_dern_value_t * const firstArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-        if (value->docstr)
+    if (firstArgVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+    {
+        if (firstArgVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return value->docstr;
+            return firstArgVal;
         }
 
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_get_value_nil(vm);
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The first argument to builtin 'mod' must be integer. Type %s was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
     }
-    else
-    {
-        octaspire_vector_t *resultVec = octaspire_vector_new(
-            sizeof(octaspire_dern_value_t*),
-            true,
-            0,
-            octaspire_dern_vm_get_allocator(vm));
-
-        octaspire_dern_value_t *resultVal =
-            octaspire_dern_vm_create_new_value_vector_from_vector(vm, resultVec);
-
-        octaspire_dern_vm_push_value(vm, resultVal);
-
-        for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
-        {
-            octaspire_dern_value_t * const value =
-                octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
-
-            if (value->docstr)
-            {
-                octaspire_vector_push_back_element(resultVec, &(value->docstr));
-            }
-            else
-            {
-                octaspire_dern_value_t *valueNil = octaspire_dern_vm_get_value_nil(vm);
-                octaspire_vector_push_back_element(resultVec, &valueNil);
-            }
+
+    octaspire_dern_value_t * const secondArgVal =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+
+    if (secondArgVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+    {
+        if (secondArgVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return secondArgVal;
         }
 
-        octaspire_dern_vm_pop_value(vm, resultVal);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "The second argument to builtin 'mod' must be integer. Type %s was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+    }
 
+    if (secondArgVal->value.integer == 0)
+    {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return resultVal;
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "The second argument to builtin 'mod' cannot be zero. "
+            "It would cause division by zero.");
     }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return octaspire_dern_vm_create_new_value_integer(
+        vm,
+        firstArgVal->value.integer % secondArgVal->value.integer);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_len(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_slash(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6042,101 +9566,239 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_len(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
+    if (numArgs < 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_from_c_string(
             vm,
-            "Builtin 'len' expects at least one argument.");
+            "Builtin '/' expects at least one numeric argument (integer or real).");
     }
 
-    if (octaspire_vector_get_length(vec) == 1)
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
     {
-        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        // TODO XXX check number ranges for too large size_t value for int32_t?
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_integer(
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
             vm,
-            (int32_t)octaspire_dern_value_get_length(value));
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE,
+            "/");
     }
-    else
+
+    if (numArgs == 1)
     {
-        octaspire_dern_value_t *resultVal = octaspire_dern_vm_create_new_value_vector(vm);
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-        octaspire_dern_vm_push_value(vm, resultVal);
+        octaspire_helpers_verify_not_null(currentArg);
 
-        for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
+        switch (currentArg->typeTag)
         {
-            octaspire_dern_value_t * const value =
-                octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
-
-            // TODO XXX check number ranges for too large size_t value for int32_t?
-            octaspire_dern_value_t *valueLen = octaspire_dern_vm_create_new_value_integer(
-                vm,
-                (int32_t)octaspire_dern_value_get_length(value));
-
-            // TODO & or not?
-            if (!octaspire_dern_value_as_vector_push_back_element(
-                resultVal,
-                &valueLen))
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
             {
                 abort();
             }
-        }
 
-        octaspire_dern_vm_pop_value(vm, resultVal);
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return resultVal;
-    }
-}
+                double const currentArgAsReal = currentArg->value.integer;
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_read_and_eval_path(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+                // Fix warning on clang's -Weverything level
+                if (currentArgAsReal >= 0 &&
+                    currentArgAsReal <= 0)
+                {
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "First argument to builtin '/' cannot be zero. "
+                        "It would cause division by zero.");
+                }
+                else
+                {
+                    return octaspire_dern_vm_create_new_value_real(vm, 1.0 / currentArgAsReal);
+                }
+            }
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+                double const currentArgAsReal = currentArg->value.real;
 
-    if (octaspire_vector_get_length(vec) != 1)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin 'read-and-eval-path' expects one argument. %zu arguments were given.",
-            octaspire_vector_get_length(vec));
+                if (currentArgAsReal >= 0 && currentArgAsReal <= 0)
+                {
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "First argument to builtin '/' cannot be zero. "
+                        "It would cause division by zero.");
+                }
+                else
+                {
+                    return octaspire_dern_vm_create_new_value_real(vm, 1.0 / currentArgAsReal);
+                }
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return currentArg;
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '/' expects numeric arguments (integer or real). First argument has "
+                    "type %s.",
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
     }
 
-    octaspire_dern_value_t *path = octaspire_vector_get_element_at(vec, 0);
+    double realResult = 1;
 
-    if (path->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin 'read-and-eval-path' must be string (path). "
-            "Type '%s' was given.",
-            octaspire_dern_value_helper_get_type_as_c_string(path->typeTag));
-    }
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(currentArg);
+
+        double currentValueAsNumber = 0;
+
+        switch (currentArg->typeTag)
+        {
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            {
+                currentValueAsNumber = currentArg->value.integer;
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            {
+                currentValueAsNumber = currentArg->value.real;
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return currentArg;
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '/' expects numeric arguments (integer or real). %zuth argument has "
+                    "type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
+
+        if (i == 0)
+        {
+            realResult = currentValueAsNumber;
+        }
+        else
+        {
+            if (currentValueAsNumber >= 0 && currentValueAsNumber <= 0)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Argument number %zu to builtin '/' cannot be zero. "
+                    "It would cause division by zero.",
+                    i + 1);
+            }
 
-    octaspire_dern_value_t *result =
-        octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
-            vm,
-            octaspire_string_get_c_string(path->value.string));
+            realResult /= currentValueAsNumber;
+        }
+    }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return octaspire_dern_vm_create_new_value_real(vm, realResult);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_read_and_eval_string(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_times(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6146,39 +9808,116 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_read_and_eval_string(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) != 1)
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
     {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
+        octaspire_helpers_verify_true(
+            stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
             vm,
-            "Builtin 'read-and-eval-string' expects one argument. %zu arguments were given.",
-            octaspire_vector_get_length(vec));
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MULTIPLY,
+            "*");
     }
 
-    octaspire_dern_value_t *stringToEval = octaspire_vector_get_element_at(vec, 0);
+    bool allArgsAreIntegers = true;
+    double realResult = 1;
+    int32_t integerResult = 1;
 
-    if (stringToEval->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin 'read-and-eval-string' must be string (to be evaluated). "
-            "Type '%s' was given.",
-            octaspire_dern_value_helper_get_type_as_c_string(stringToEval->typeTag));
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(currentArg);
+
+        switch (currentArg->typeTag)
+        {
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            {
+                integerResult *= currentArg->value.integer;
+                realResult    *= (double)currentArg->value.integer;
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            {
+                allArgsAreIntegers = false;
+
+                integerResult *= (int32_t)(currentArg->value.real);
+                realResult    *= currentArg->value.real;
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return currentArg;
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '*' expects numeric arguments (integer or real). %zuth argument has "
+                    "type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
     }
 
-    octaspire_dern_value_t *result =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            octaspire_string_get_c_string(stringToEval->value.string));
+    if (allArgsAreIntegers)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+    }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return octaspire_dern_vm_create_new_value_real(vm, realResult);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_string_format(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_numerical(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6188,135 +9927,104 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_string_format(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
-
-    if (numArgs == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'string-format' expects one or more arguments.");
-    }
-
-    octaspire_dern_value_t const * const fmtStr =
-        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
-
-    octaspire_helpers_verify_not_null(fmtStr);
-
-    octaspire_string_t *resultStr = 0;
-
-    if (numArgs == 1)
-    {
-        octaspire_string_t *str =
-            octaspire_dern_value_to_string(fmtStr, octaspire_dern_vm_get_allocator(vm));
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-        octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_string(vm, str);
+    bool allArgsAreIntegers = true;
+    double realResult = 0;
+    int32_t integerResult = 0;
 
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return result;
-    }
-    else
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        if (fmtStr->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING)
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to builtin 'string-format' must be format string if there are more "
-                "than one argument. Type '%s' was given.",
-                octaspire_dern_value_helper_get_type_as_c_string(fmtStr->typeTag));
-
-        }
-
-        resultStr = octaspire_string_new(
-            "",
-            octaspire_dern_vm_get_allocator(vm));
-
-        size_t const fmtStrLen =
-            octaspire_string_get_length_in_ucs_characters(fmtStr->value.string);
-
-        uint32_t prevChar = 0;
-        uint32_t curChar = 0;
-        uint32_t nextChar = 0;
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        size_t fmtValueIndex = 1;
+        octaspire_helpers_verify_not_null(currentArg);
 
-        for (size_t c = 0; c < fmtStrLen; ++c)
+        switch (currentArg->typeTag)
         {
-            curChar =
-                octaspire_string_get_ucs_character_at_index(
-                    fmtStr->value.string,
-                    (ptrdiff_t)c);
-
-            if ((c + 1) < fmtStrLen)
-            {
-                nextChar =
-                    octaspire_string_get_ucs_character_at_index(
-                        fmtStr->value.string,
-                        (ptrdiff_t)(c + 1));
-            }
-            else
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
             {
-                nextChar = 0;
+                abort();
             }
 
-            if (curChar == '\'' && prevChar == '\'')
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
             {
-                octaspire_string_push_back_ucs_character(resultStr, '\'');
-                curChar = 0; // To prevent prevChar from becoming '
+                integerResult += currentArg->value.integer;
+                realResult    += (double)currentArg->value.integer;
             }
-            else if (curChar == '{' && prevChar != '\'')
-            {
-                if (nextChar == '}')
-                {
-                    if (fmtValueIndex >= numArgs)
-                    {
-                        octaspire_helpers_verify_true(
-                            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                        return octaspire_dern_vm_create_new_value_error_from_c_string(
-                            vm,
-                            "Not enough arguments for the format string of 'string-format'.");
-                    }
-
-                    octaspire_string_t *tmpStr =
-                        octaspire_dern_value_to_string_plain(
-                            octaspire_dern_value_as_vector_get_element_at(
-                                arguments,
-                                (ptrdiff_t)fmtValueIndex),
-                            octaspire_dern_vm_get_allocator(vm));
-
-                    octaspire_string_concatenate(resultStr, tmpStr);
+            break;
 
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            {
+                allArgsAreIntegers = false;
 
-                    ++c;
-                    ++fmtValueIndex;
-                }
-                else
-                {
-                    octaspire_string_push_back_ucs_character(
-                        resultStr,
-                        curChar);
-                }
+                integerResult += (int32_t)(currentArg->value.real);
+                realResult    += currentArg->value.real;
             }
-            else
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
             {
-                octaspire_string_push_back_ucs_character(
-                    resultStr,
-                    curChar);
-            }
+                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-            prevChar = curChar;
+                    return currentArg;
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '+' expects numeric arguments (integer or real). %zuth argument has "
+                    "type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
         }
     }
 
+    if (allArgsAreIntegers)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+    }
+
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_string(vm, resultStr);
+    return octaspire_dern_vm_create_new_value_real(vm, realResult);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_to_string(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_string(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6326,134 +10034,219 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_to_string(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (numArgs == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArg);
+    octaspire_helpers_verify_true(firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_string(
             vm,
-            "Builtin 'to-string' expects one or more arguments.");
-    }
-    else
+            octaspire_dern_helpers_copy_string(
+                firstArg->value.string,
+                octaspire_dern_vm_get_allocator(vm)));
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_string_t * const str = octaspire_dern_value_to_string(
-            octaspire_dern_value_as_vector_get_element_at_const(
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
                 arguments,
-                0),
-            octaspire_dern_vm_get_allocator(vm));
+                (ptrdiff_t)i);
 
-        for (size_t i = 1; i < numArgs; ++i)
+        octaspire_helpers_verify_not_null(currentArg);
+
+        switch (currentArg->typeTag)
         {
-            octaspire_string_t * tmpStr =
-                octaspire_dern_value_to_string(
-                octaspire_dern_value_as_vector_get_element_at_const(
-                    arguments,
-                    (ptrdiff_t)i),
-                octaspire_dern_vm_get_allocator(vm));
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
 
-            octaspire_string_concatenate(str, tmpStr);
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            {
+                octaspire_string_concatenate(
+                    result->value.string,
+                    currentArg->value.string);
+            }
+            break;
 
-            octaspire_string_release(tmpStr);
-            tmpStr = 0;
-        }
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            {
+                octaspire_string_concatenate(
+                    result->value.string,
+                    currentArg->value.character);
+            }
+            break;
 
-        return octaspire_dern_vm_create_new_value_string(vm, str);
+            // TODO Add symbol and maybe automatic conversion from number -> string
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_dern_vm_pop_value(vm, result);
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '+' expects textual arguments if the first argument is string. %zuth "
+                    "argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
     }
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    // TODO what to return? Count of removals or the modified string-value?
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_to_real(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_char(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "to-real";
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
 
-    if (numArgs != numExpectedArgs)
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin '%s' expects %zu arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
-            numArgs);
-    }
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_dern_value_t const * const value =
-        octaspire_dern_value_as_vector_get_element_at_const(
-            arguments,
-            0);
+    octaspire_helpers_verify_not_null(firstArg);
 
-    // TODO other types
-    if (octaspire_dern_value_is_number(value))
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER);
 
-        return octaspire_dern_vm_create_new_value_real(
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_string(
             vm,
-            octaspire_dern_value_as_number_get_value(value));
-    }
-    else if (octaspire_dern_value_is_character(value))
+            octaspire_dern_helpers_copy_string(
+                firstArg->value.character,
+                octaspire_dern_vm_get_allocator(vm)));
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_string_t const * const str =
-            value->value.character;
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        octaspire_helpers_verify_not_null(str);
+        octaspire_helpers_verify_not_null(currentArg);
 
-        if (octaspire_string_is_index_valid(str, 0))
+        switch (currentArg->typeTag)
         {
-            return octaspire_dern_vm_create_new_value_real(
-                vm,
-                (double)(octaspire_string_get_ucs_character_at_index(str, 0)));
-        }
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
 
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            {
+                octaspire_string_concatenate(
+                    result->value.string,
+                    currentArg->value.string);
+            }
+            break;
 
-        return octaspire_dern_vm_create_new_value_real(vm, 0.0);
-    }
-    else if (octaspire_dern_value_is_text(value))
-    {
-        // TODO error checking.
-        double const valueAsReal = strtod(
-            octaspire_dern_value_as_text_get_c_string(value),
-            0);
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            {
+                octaspire_string_concatenate(
+                    result->value.string,
+                    currentArg->value.character);
+            }
+            break;
 
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+            // TODO Add symbol and maybe automatic conversion from number -> string
 
-        return octaspire_dern_vm_create_new_value_real(vm, valueAsReal);
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_dern_vm_pop_value(vm, result);
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '+' expects textual arguments if the first argument is character. "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
     }
-    else
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to '%s' is currently unsupported type. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
-    }
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    // TODO what to return? Count of removals or the modified string-value?
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_to_integer(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_symbol(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6463,83 +10256,115 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_to_integer(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (numArgs == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArg);
+
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_symbol(
             vm,
-            "Builtin 'to-integer' expects one or more arguments.");
-    }
-    else if (numArgs == 1)
+            octaspire_dern_helpers_copy_string(
+                firstArg->value.symbol,
+                octaspire_dern_vm_get_allocator(vm)));
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_dern_value_t const * const value =
-            octaspire_dern_value_as_vector_get_element_at_const(
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
                 arguments,
-                0);
+                (ptrdiff_t)i);
 
-        // TODO other types
-        if (octaspire_dern_value_is_number(value))
-        {
-            return octaspire_dern_vm_create_new_value_integer(
-                vm,
-                (int32_t)(octaspire_dern_value_as_number_get_value(value)));
-        }
-        else if (octaspire_dern_value_is_character(value))
+        octaspire_helpers_verify_not_null(currentArg);
+
+        switch (currentArg->typeTag)
         {
-            octaspire_string_t const * const str =
-                value->value.character;
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
 
-            octaspire_helpers_verify_not_null(str);
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            {
+                octaspire_string_concatenate(
+                    result->value.symbol,
+                    currentArg->value.string);
+            }
+            break;
 
-            if (octaspire_string_is_index_valid(str, 0))
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
             {
-                return octaspire_dern_vm_create_new_value_integer(
-                    vm,
-                    (int32_t)(octaspire_string_get_ucs_character_at_index(str, 0)));
+                octaspire_string_concatenate(
+                    result->value.symbol,
+                    currentArg->value.character);
             }
+            break;
 
-            return octaspire_dern_vm_create_new_value_integer(vm, 0);
-        }
-        else if (octaspire_dern_value_is_text(value))
-        {
-            int32_t valueAsInt =
-#ifdef OCTASPIRE_PLAN9_IMPLEMENTATION
-                (int32_t)strtol(
-#else
-    #ifdef __amigaos__
-                (int32_t)strtol(
-    #else
-                (int32_t)strtoimax(
-    #endif
-#endif
-                octaspire_dern_value_as_text_get_c_string(value),
-                0,
-                10);
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            {
+                octaspire_string_concatenate(
+                    result->value.symbol,
+                    currentArg->value.symbol);
+            }
+            break;
 
-            return octaspire_dern_vm_create_new_value_integer(vm, valueAsInt);
-        }
-        else
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to 'to-integer' is currently unsupported type. "
-                "Type '%s' was given.",
-                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+            // TODO Add symbol and maybe automatic conversion from number -> string
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_dern_vm_pop_value(vm, result);
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '+' expects textual arguments if the first argument is symbol. "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
         }
     }
-    else
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'to-integer' supports at the moment only one argument.");
-    }
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    // TODO what to return? Count of removals or the modified string-value?
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_print_readably(
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_semver(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6551,44 +10376,97 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_print_readably(
 
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (numArgs != 0 && numArgs != 1)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArg);
+
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_semver(
             vm,
-            "Builtin 'print-readably' expects zero or one argument.");
-    }
+            octaspire_semver_new_copy(
+                firstArg->value.semver,
+                octaspire_dern_vm_get_allocator(vm)));
 
-    if (numArgs == 1)
-    {
-        octaspire_dern_vm_push_value(vm, arguments);
+    octaspire_dern_vm_push_value(vm, result);
 
-        octaspire_dern_value_t *firstArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        octaspire_helpers_verify_not_null(firstArg);
+        octaspire_helpers_verify_not_null(currentArg);
 
-        if (firstArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_BOOLEAN)
+        switch (currentArg->typeTag)
         {
-            octaspire_dern_vm_pop_value(vm, arguments);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_from_c_string(
-                vm,
-                "Builtin 'print-readably' expects boolean argument or no arguments.");
-        }
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
 
-        bool const given = firstArg->value.boolean;
-        octaspire_dern_vm_set_print_readably(vm, given);
-        octaspire_dern_vm_pop_value(vm, arguments);
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_semver_add_or_subtract(
+                    result->value.semver,
+                    currentArg->value.semver,
+                    true);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            {
+                octaspire_dern_vm_pop_value(vm, result);
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '+' expects SemVer arguments if the first argument is SemVer. "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
+        }
     }
 
+    octaspire_dern_vm_pop_value(vm, result);
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_boolean(
-        vm,
-        octaspire_dern_vm_get_print_readably(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_print(
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_semver(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6598,217 +10476,292 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_print(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
-
-    if (numArgs == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'print' expects one or more arguments.");
-    }
-
-    octaspire_dern_value_t const * const fmtStr =
-        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
-
-    octaspire_helpers_verify_not_null(fmtStr);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (fmtStr->typeTag != OCTASPIRE_DERN_VALUE_TAG_STRING || numArgs == 1)
-    {
-        octaspire_dern_value_print(fmtStr, octaspire_dern_vm_get_allocator(vm));
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_get_value_true(vm);
-    }
+    octaspire_helpers_verify_not_null(firstArg);
 
-    size_t const fmtStrLen =
-        octaspire_string_get_length_in_ucs_characters(fmtStr->value.string);
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
 
-    uint32_t prevChar = 0;
-    uint32_t curChar = 0;
-    uint32_t nextChar = 0;
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_semver(
+            vm,
+            octaspire_semver_new_copy(
+                firstArg->value.semver,
+                octaspire_dern_vm_get_allocator(vm)));
 
-    size_t fmtValueIndex = 1;
+    octaspire_dern_vm_push_value(vm, result);
 
-    for (size_t c = 0; c < fmtStrLen; ++c)
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        curChar =
-            octaspire_string_get_ucs_character_at_index(
-                fmtStr->value.string,
-                (ptrdiff_t)c);
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        if ((c + 1) < fmtStrLen)
-        {
-            nextChar =
-                octaspire_string_get_ucs_character_at_index(
-                    fmtStr->value.string,
-                    (ptrdiff_t)(c + 1));
-        }
-        else
-        {
-            nextChar = 0;
-        }
+        octaspire_helpers_verify_not_null(currentArg);
 
-        if (curChar == '\'' && prevChar == '\'')
-        {
-            printf("'");
-            curChar = 0; // To prevent prevChar from becoming '
-        }
-        else if (curChar == '{' && prevChar != '\'')
+        switch (currentArg->typeTag)
         {
-            if (nextChar == '}')
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
             {
-                if (fmtValueIndex >= numArgs)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Not enough arguments for the format string of 'println'.");
-                }
-
-                octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
-                    octaspire_dern_value_as_vector_get_element_at(
-                        arguments,
-                        (ptrdiff_t)fmtValueIndex),
-                    octaspire_dern_vm_get_allocator(vm));
-
-                printf("%s", octaspire_string_get_c_string(tmpStr));
-
-                octaspire_string_release(tmpStr);
-                tmpStr = 0;
+                abort();
+            }
 
-                ++c;
-                ++fmtValueIndex;
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_semver_add_or_subtract(
+                    result->value.semver,
+                    currentArg->value.semver,
+                    false);
             }
-            else
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
             {
-                printf("%c", (char)curChar);
+                octaspire_dern_vm_pop_value(vm, result);
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '-' expects SemVer arguments if the first argument is SemVer. "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
             }
         }
-        else
-        {
-            printf("%c", (char)curChar);
-        }
-
-        prevChar = curChar;
     }
 
+    octaspire_dern_vm_pop_value(vm, result);
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_get_value_true(vm);
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_println(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_vector(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
-    if (octaspire_dern_value_as_vector_get_length(arguments) == 0)
-    {
-        printf("\n");
-        return octaspire_dern_vm_get_value_true(vm);
-    }
-    else
-    {
-        octaspire_dern_value_t *result =
-            octaspire_dern_vm_builtin_print(vm, arguments, environment);
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-        printf("\n");
-        return result;
-    }
-}
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_env_new(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    octaspire_dern_value_t * const firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    if (octaspire_vector_get_length(vec) == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_environment(vm, 0);
-    }
-    else if (octaspire_vector_get_length(vec) == 1)
+    octaspire_helpers_verify_not_null(firstArg);
+
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_copy(
+            vm,
+            firstArg);
+
+    octaspire_helpers_verify_not_null(result);
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_dern_value_t *value = octaspire_vector_get_element_at(vec, 0);
-        octaspire_helpers_verify_not_null(value);
+        octaspire_dern_value_t * const currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        if (value->typeTag != OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT)
+        octaspire_helpers_verify_not_null(currentArg);
+
+        switch (currentArg->typeTag)
         {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "Argument to builtin 'env-new' must be an environment. Now argument has type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
-        }
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            {
+                abort();
+            }
 
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_environment(vm, value);
-    }
-    else
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'env-new' expects zero or one arguments.");
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_dern_value_t * const copyOfArg =
+                    octaspire_dern_vm_create_new_value_copy(
+                        vm,
+                        currentArg);
+
+                octaspire_helpers_verify_not_null(copyOfArg);
+
+                octaspire_helpers_verify_true(
+                    octaspire_dern_value_as_vector_push_back_element(
+                        result,
+                        &copyOfArg));
+            }
+            break;
+        }
     }
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_env_current(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_hash_map(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(
+        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    octaspire_helpers_verify_true(
+        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    if (octaspire_vector_get_length(vec) != 0)
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+
+    if (numArgs == 0 || (octaspire_helpers_is_odd_size_t(numArgs - 1)))
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'env-current' expects zero arguments.");
+            "Builtin '+' for hash maps expects odd number of arguments. "
+            "%zu arguments were given.",
+            numArgs);
     }
 
-    return environment;
-}
+    octaspire_dern_value_t * const firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_env_global(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    octaspire_helpers_verify_not_null(firstArg);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(
+        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_copy(
+            vm,
+            firstArg);
 
-    if (octaspire_vector_get_length(vec) != 0)
+    octaspire_helpers_verify_not_null(result);
+
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < (numArgs - 1); i += 2)
     {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin 'env-global' expects zero arguments.");
+        octaspire_dern_value_t * const keyArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
+
+        octaspire_dern_value_t * const valArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)(i + 1));
+
+        octaspire_helpers_verify_not_null(keyArg);
+        octaspire_helpers_verify_not_null(valArg);
+
+        octaspire_helpers_verify_true(
+            keyArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_ILLEGAL);
+
+        octaspire_helpers_verify_true(
+            valArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_ILLEGAL);
+
+        octaspire_dern_value_t * const copyOfKey =
+            octaspire_dern_vm_create_new_value_copy(
+                vm,
+                keyArg);
+
+        octaspire_helpers_verify_not_null(copyOfKey);
+        octaspire_dern_vm_push_value(vm, copyOfKey);
+
+        octaspire_dern_value_t * const copyOfVal =
+            octaspire_dern_vm_create_new_value_copy(
+                vm,
+                valArg);
+
+        octaspire_helpers_verify_not_null(copyOfVal);
+        octaspire_dern_vm_push_value(vm, copyOfVal);
+
+        octaspire_helpers_verify_true(
+            octaspire_dern_value_as_hash_map_add(
+                result,
+                copyOfKey,
+                copyOfVal));
+
+        octaspire_dern_vm_pop_value(vm, copyOfVal);
+        octaspire_dern_vm_pop_value(vm, copyOfKey);
     }
 
-    return octaspire_dern_vm_get_global_environment(vm);
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_numerical(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -6818,204 +10771,136 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
-
-    if (octaspire_vector_get_length(vec) < 1)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin '-=' expects at least one argument.");
-    }
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+    bool allArgsAreIntegers = true;
+    double realResult = 0;
+    int32_t integerResult = 0;
 
-    switch (firstArg->typeTag)
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
-
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (i == 1)
-                {
-                    octaspire_dern_value_as_character_subtract(firstArg, anotherArg);
-                }
-                else
-                {
-                    octaspire_dern_value_as_string_pop_back_ucs_character(firstArg);
-                }
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-                octaspire_dern_value_as_real_subtract(firstArg, anotherArg);
-            }
-        }
-        break;
+        octaspire_helpers_verify_not_null(currentArg);
 
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        switch (currentArg->typeTag)
         {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                octaspire_dern_value_as_integer_subtract(firstArg, anotherArg);
+                abort();
             }
-        }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                // TODO XXX remove the need for '&' in &another for vectors!!!!!
-                for (size_t j = 0; j < octaspire_dern_value_as_vector_get_length(firstArg); /*NOP*/)
+                if (numArgs == 1)
                 {
-                    octaspire_dern_value_t * const val =
-                        octaspire_dern_value_as_vector_get_element_at(
-                            firstArg,
-                            (ptrdiff_t)j);
-
-                    if (octaspire_dern_value_is_equal(anotherArg, val))
+                    integerResult = -currentArg->value.integer;
+                    realResult    = -(double)currentArg->value.integer;
+                }
+                else
+                {
+                    if (i == 0)
                     {
-                        octaspire_dern_value_as_vector_remove_element_at(
-                            firstArg,
-                            (ptrdiff_t)j);
+                        integerResult = currentArg->value.integer;
+                        realResult    = (double)currentArg->value.integer;
                     }
                     else
                     {
-                        ++j;
+                        integerResult -= currentArg->value.integer;
+                        realResult    -= (double)currentArg->value.integer;
                     }
                 }
             }
-        }
-        break;
+            break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
+                allArgsAreIntegers = false;
 
-                if (!octaspire_dern_value_as_string_remove_all_substrings(firstArg, anotherArg))
+                if (numArgs == 1)
                 {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin '-=' failed");
+                    integerResult = (int32_t)-currentArg->value.real;
+                    realResult    = -currentArg->value.real;
                 }
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (!octaspire_dern_value_as_hash_map_remove(firstArg, anotherArg))
+                else
                 {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin '-=' failed");
+                    if (i == 0)
+                    {
+                        integerResult = (int32_t)currentArg->value.real;
+                        realResult    = currentArg->value.real;
+                    }
+                    else
+                    {
+                        integerResult -= (int32_t)(currentArg->value.real);
+                        realResult    -= currentArg->value.real;
+                    }
                 }
             }
-        }
-        break;
+            break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (!octaspire_dern_value_as_semver_add_or_subtract(firstArg, anotherArg, false))
+                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
                 {
                     octaspire_helpers_verify_true(
                         stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin '-=' failed on SemVer");
+                    return currentArg;
                 }
-            }
-        }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return firstArg;
-        }
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to builtin '-=' cannot be of type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '-' expects numeric arguments (integer or real). "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
         }
     }
 
+    if (allArgsAreIntegers)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+    }
+
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return firstArg;
+    return octaspire_dern_vm_create_new_value_real(vm, realResult);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals_equals(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_textual(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -7025,120 +10910,130 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_equals_equals(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            vm,
-            "Builtin '-==' expects at least one argument.");
-    }
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+    octaspire_helpers_verify_not_null(firstArg);
+    octaspire_helpers_verify_true(firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
 
-    switch (firstArg->typeTag)
+    octaspire_dern_value_prepare_for_mutation(firstArg);
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
+        octaspire_dern_value_t *currentArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to builtin '-==' cannot be of type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
-        }
+        octaspire_helpers_verify_not_null(currentArg);
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        switch (currentArg->typeTag)
         {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
+                abort();
+            }
 
-                for (size_t j = 0; j < octaspire_dern_value_as_vector_get_length(firstArg); /*NOP*/)
-                {
-                    octaspire_dern_value_t * const val =
-                        octaspire_dern_value_as_vector_get_element_at(
-                            firstArg,
-                            (ptrdiff_t)j);
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            {
+                octaspire_string_remove_all_substrings(
+                    firstArg->value.string,
+                    currentArg->value.string);
+            }
+            break;
 
-                    if (anotherArg->uniqueId == val->uniqueId)
-                    {
-                        octaspire_dern_value_as_vector_remove_element_at(
-                            firstArg,
-                            (ptrdiff_t)j);
-                    }
-                    else
-                    {
-                        ++j;
-                    }
-                }
+            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            {
+                octaspire_string_remove_all_substrings(
+                    firstArg->value.string,
+                    currentArg->value.character);
             }
-        }
-        break;
+            break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return firstArg;
+            // TODO Add symbol and maybe automatic conversion from number -> string
+
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '-' expects textual arguments if the first argument is textual. "
+                    "%zuth argument has type %s.",
+                    i + 1,
+                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            }
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    // TODO what to return? Count of removals or the modified string-value?
     return firstArg;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_back(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_plus(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_builtin_private_plus_numerical(vm, arguments, environment);
+    }
 
-    if (octaspire_vector_get_length(vec) != 1)
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
     {
         octaspire_helpers_verify_true(
             stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
             vm,
-            "Builtin 'pop-back' expects exactly one argument.");
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_ADD,
+            "+");
     }
 
-    octaspire_dern_value_t * const firstArg =
-        octaspire_vector_get_element_at(vec, 0);
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArg);
 
     switch (firstArg->typeTag)
     {
@@ -7147,107 +11042,144 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_back(
             abort();
         }
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
         {
-            octaspire_dern_value_as_vector_pop_back_element(firstArg);
-        }
-        break;
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        {
-            octaspire_dern_value_as_list_pop_back(firstArg);
+            return octaspire_dern_vm_builtin_private_plus_textual_string(
+                vm,
+                arguments,
+                environment);
         }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         {
-            octaspire_dern_value_as_queue_pop(firstArg);
-        }
-        break;
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
-        {
-            octaspire_dern_value_as_string_pop_back_ucs_character(firstArg);
+            return octaspire_dern_vm_builtin_private_plus_textual_char(
+                vm,
+                arguments,
+                environment);
         }
         break;
 
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         {
-            octaspire_dern_value_as_symbol_pop_back(firstArg);
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_builtin_private_plus_textual_symbol(
+                vm,
+                arguments,
+                environment);
         }
         break;
 
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
-            octaspire_dern_value_as_semver_pop_back(firstArg);
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_builtin_private_plus_semver(
+                vm,
+                arguments,
+                environment);
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
             octaspire_helpers_verify_true(
                 stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-            return firstArg;
+            return octaspire_dern_vm_builtin_private_plus_vector(
+                vm,
+                arguments,
+                environment);
         }
+        break;
 
         case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_builtin_private_plus_hash_map(
+                vm,
+                arguments,
+                environment);
+        }
+        break;
+
         case OCTASPIRE_DERN_VALUE_TAG_NIL:
         case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
         case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
         case OCTASPIRE_DERN_VALUE_TAG_MACRO:
         case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to builtin 'pop-back' cannot be of type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_plus_numerical(vm, arguments, environment);
         }
     }
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-    return firstArg;
+    abort();
+    return 0;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_front(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_minus(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    if (numArgs == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_builtin_private_minus_numerical(vm, arguments, environment);
+    }
 
-    if (octaspire_vector_get_length(vec) != 1)
+    if (octaspire_dern_vm_builtin_private_has_typed_array_argument(arguments))
     {
         octaspire_helpers_verify_true(
             stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_builtin_private_typed_array_operation(
             vm,
-            "Builtin 'pop-front' expects exactly one argument.");
+            arguments,
+            OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SUBTRACT,
+            "-");
     }
 
-    octaspire_dern_value_t * const firstArg =
-        octaspire_vector_get_element_at(vec, 0);
+    octaspire_dern_value_t *firstArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+
+    octaspire_helpers_verify_not_null(firstArg);
 
     switch (firstArg->typeTag)
     {
@@ -7256,784 +11188,1034 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_pop_front(
             abort();
         }
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        {
-            octaspire_dern_value_as_vector_pop_front_element(firstArg);
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        {
-            octaspire_dern_value_as_list_pop_front(firstArg);
-        }
-        break;
-
         case OCTASPIRE_DERN_VALUE_TAG_STRING:
         {
-            octaspire_dern_value_as_string_pop_front_ucs_character(firstArg);
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        {
-            octaspire_dern_value_as_symbol_pop_front(firstArg);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_minus_textual(vm, arguments, environment);
         }
-        break;
 
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
-            octaspire_dern_value_as_semver_pop_front(firstArg);
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-            return firstArg;
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_minus_semver(vm, arguments, environment);
         }
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         case OCTASPIRE_DERN_VALUE_TAG_NIL:
         case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
         case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
         case OCTASPIRE_DERN_VALUE_TAG_MACRO:
         case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "First argument to builtin 'pop-front' cannot be of type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_minus_numerical(vm, arguments, environment);
         }
     }
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-    return firstArg;
+    abort();
+    return 0;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_distance(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_find(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_dern_vm_push_value(vm, arguments);
+    octaspire_dern_vm_push_value(vm, environment);
 
-    char   const * const dernFuncName = "distance";
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
 
-    if (numArgs != 2)
+    if (numArgs < 2)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_dern_vm_pop_value(vm, environment);
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects two arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
+            "Builtin 'find' expects at least two arguments. %zu arguments was given.",
             numArgs);
     }
 
-    // TODO support also other types in addition to text (string or symbol)
-    // and numeric arguments.
-
-    octaspire_dern_value_t * const firstArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    if (!octaspire_dern_value_is_number(firstArgVal) &&
-        !octaspire_dern_value_is_text(firstArgVal))
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t *container = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "The first argument to builtin '%s' must be a number or text. "
-            "Type %s was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
-    }
+    octaspire_helpers_verify_not_null(container);
 
-    octaspire_dern_value_t * const secondArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+    octaspire_dern_value_t *result = 0;
 
-    if (!octaspire_dern_value_is_number(secondArgVal) &&
-        !octaspire_dern_value_is_text(secondArgVal))
+    if (numArgs > 2)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "The second argument to builtin '%s' must be a number or text. "
-            "Type %s was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
-    }
+        result = octaspire_dern_vm_create_new_value_vector(vm);
+        octaspire_dern_vm_push_value(vm, result);
 
-    if (octaspire_dern_value_is_number(firstArgVal))
-    {
-        if (octaspire_dern_value_is_text(secondArgVal))
+        for (size_t i = 1; i < numArgs; ++i)
         {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+            octaspire_dern_value_t *keyArg =
+                octaspire_dern_value_as_vector_get_element_at(
+                    arguments,
+                    (ptrdiff_t)i);
 
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "The second argument to builtin '%s' must be a number "
-                "when first is a number. Type %s was given.",
-                dernFuncName,
-                octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
-        }
+            octaspire_helpers_verify_not_null(keyArg);
 
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+            octaspire_dern_value_t *tmpVal =
+                octaspire_dern_vm_find_from_value(vm, container, keyArg);
 
-        // TODO maybe return integer if both arguments were integers, and so on.
-        return octaspire_dern_vm_create_new_value_real(
-            vm,
-            fabs(
-                octaspire_dern_value_as_number_get_value(firstArgVal) -
-                octaspire_dern_value_as_number_get_value(secondArgVal)));
-    }
+            octaspire_dern_value_as_vector_push_back_element(
+                result,
+                &tmpVal);
+        }
 
-    if (octaspire_dern_value_is_number(secondArgVal))
+        octaspire_dern_vm_pop_value(vm, result);
+        octaspire_dern_vm_pop_value(vm, environment);
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
+    }
+    else
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+        octaspire_dern_value_t *keyArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
 
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "The second argument to builtin '%s' must be textual "
-            "when first is textual. Type %s was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
-    }
+        octaspire_helpers_verify_not_null(keyArg);
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+        result = octaspire_dern_vm_find_from_value(vm, container, keyArg);
 
-    return octaspire_dern_vm_create_new_value_integer(
-        vm,
-        octaspire_string_levenshtein_distance(
-            octaspire_dern_value_as_text_get_string_const(firstArgVal),
-            octaspire_dern_value_as_text_get_string_const(secondArgVal)));
+        octaspire_dern_vm_pop_value(vm, environment);
+        octaspire_dern_vm_pop_value(vm, arguments);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
+    }
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_max(
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_split(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
+    octaspire_dern_value_t *environment,
+    bool const asSlices,
+    char const * const dernFuncName)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "max";
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 2;
 
-    if (numArgs < numExpectedArgs)
+    if (numArgs != 2)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects at least %zu arguments. "
-            "%zu arguments were given.",
+            "Builtin '%s' expects two arguments. %zu arguments was given.",
             dernFuncName,
-            numExpectedArgs,
             numArgs);
     }
 
-    octaspire_dern_value_t * largestArgVal =
+    octaspire_dern_value_t *container =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(largestArgVal);
+    octaspire_helpers_verify_not_null(container);
 
-    for (size_t i = 1; i < numArgs; ++i)
+    octaspire_dern_value_t *splitByArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+
+    octaspire_helpers_verify_not_null(splitByArg);
+
+    switch (container->typeTag)
     {
-        octaspire_dern_value_t * const nextArgVal =
-            octaspire_dern_value_as_vector_get_element_at(arguments, i);
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        {
+            abort();
+        }
 
-        octaspire_helpers_verify_not_null(nextArgVal);
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_string_t const * delimiter = 0;
 
-        if (octaspire_dern_value_is_greater_than(nextArgVal, largestArgVal))
+            if (octaspire_dern_value_is_character(splitByArg))
+            {
+                delimiter = splitByArg->value.character;
+            }
+            else if (octaspire_dern_value_is_string(splitByArg))
+            {
+                delimiter = splitByArg->value.string;
+            }
+            else
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "The second argument to builtin '%s' must be a character or string "
+                    "when the first is a string. Type '%s' was given.",
+                    dernFuncName,
+                    octaspire_dern_value_helper_get_type_as_c_string(splitByArg->typeTag));
+            }
+
+            size_t const delimiterLength = octaspire_string_get_length_in_octets(delimiter);
+
+            if (!delimiterLength)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "The second argument to builtin '%s' cannot be an empty string.",
+                    dernFuncName);
+            }
+
+            octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_vector(vm);
+            octaspire_helpers_verify_not_null(result);
+
+            octaspire_dern_vm_push_value(vm, result);
+            octaspire_dern_vm_push_value(vm, arguments);
+
+            // Search the octets of the string and create every non-empty
+            // piece directly from its octets, or as a slice viewing them.
+            bool const isSlice = octaspire_dern_value_is_string_slice(container);
+
+            size_t const numOctets = isSlice ?
+                octaspire_dern_value_as_string_slice_get_length_in_octets(container) :
+                octaspire_string_get_length_in_octets(container->value.string);
+
+            char const * const delimiterOctets = octaspire_string_get_c_string(delimiter);
+
+            size_t pieceStart = 0;
+
+            while (pieceStart < numOctets)
+            {
+                // Creating a piece can run the GC, that can give the
+                // container storage of its own. Octets are looked up again.
+                char const * const octets = isSlice ?
+                    octaspire_dern_value_as_string_slice_get_octets(container) :
+                    octaspire_string_get_c_string(container->value.string);
+
+                size_t pieceEnd = numOctets;
+
+                if (!octaspire_dern_helpers_find_octets(
+                        octets,
+                        numOctets,
+                        delimiterOctets,
+                        delimiterLength,
+                        pieceStart,
+                        &pieceEnd))
+                {
+                    pieceEnd = numOctets;
+                }
+
+                if (pieceEnd > pieceStart && asSlices)
+                {
+                    octaspire_dern_value_t * const pieceVal =
+                        octaspire_dern_vm_create_new_value_string_slice(
+                            vm,
+                            container,
+                            pieceStart,
+                            pieceEnd - pieceStart);
+
+                    octaspire_dern_value_as_vector_push_back_element(result, &pieceVal);
+                }
+                else if (pieceEnd > pieceStart)
+                {
+                    octaspire_string_t * const piece = octaspire_string_new_from_buffer(
+                        octets + pieceStart,
+                        pieceEnd - pieceStart,
+                        octaspire_dern_vm_get_allocator(vm));
+
+                    octaspire_helpers_verify_not_null(piece);
+
+                    octaspire_dern_value_t * const pieceVal =
+                        octaspire_dern_vm_create_new_value_string(vm, piece);
+
+                    octaspire_dern_value_as_vector_push_back_element(result, &pieceVal);
+                }
+
+                pieceStart = pieceEnd + delimiterLength;
+            }
+
+            octaspire_dern_vm_pop_value(vm, arguments);
+            octaspire_dern_vm_pop_value(vm, result);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return result;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
-            largestArgVal = nextArgVal;
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "The first argument to builtin '%s' must be a container. Currently only "
+                "strings and string slices are supported. Type '%s' was given.",
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(container->typeTag));
         }
     }
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    abort();
+    return 0;
+}
 
-    return largestArgVal;
+octaspire_dern_value_t *octaspire_dern_vm_builtin_split(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_split(
+        vm,
+        arguments,
+        environment,
+        false,
+        "split");
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_min(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_split_slices(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    return octaspire_dern_vm_builtin_private_split(
+        vm,
+        arguments,
+        environment,
+        true,
+        "split-slices");
+}
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_hash_map(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment,
+    bool const weakKeys,
+    char const * const dernFuncName)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "min";
     size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 2;
 
-    if (numArgs < numExpectedArgs)
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t *result = weakKeys ?
+        octaspire_dern_vm_create_new_value_weak_hash_map(vm) :
+        octaspire_dern_vm_create_new_value_hash_map(vm);
 
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin '%s' expects at least %zu arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
-            numArgs);
-    }
+    octaspire_dern_vm_push_value(vm, result);
 
-    octaspire_dern_value_t * smallestArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    for (size_t i = 0; i < numArgs; i += 2)
+    {
+        octaspire_dern_value_t *keyArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)i);
 
-    octaspire_helpers_verify_not_null(smallestArgVal);
+        if (!keyArg)
+        {
+            octaspire_dern_vm_pop_value(vm, result);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin '%s' expects key here.",
+                dernFuncName);
+        }
 
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        octaspire_dern_value_t * const nextArgVal =
-            octaspire_dern_value_as_vector_get_element_at(arguments, i);
+        octaspire_dern_value_t *valArg =
+            octaspire_dern_value_as_vector_get_element_at(
+                arguments,
+                (ptrdiff_t)(i + 1));
 
-        octaspire_helpers_verify_not_null(nextArgVal);
+        if (!valArg)
+        {
+            octaspire_dern_vm_pop_value(vm, result);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin '%s' expects key here.",
+                dernFuncName);
+        }
 
-        if (octaspire_dern_value_is_less_than(nextArgVal, smallestArgVal))
+        if (!octaspire_dern_value_as_hash_map_put(
+            result,
+            octaspire_dern_value_get_hash(keyArg),
+            keyArg,
+            valArg))
         {
-            smallestArgVal = nextArgVal;
+            abort();
         }
     }
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_hash_map(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_hash_map(
+        vm,
+        arguments,
+        environment,
+        false,
+        "hash-map");
+}
 
-    return smallestArgVal;
+octaspire_dern_value_t *octaspire_dern_vm_builtin_weak_hash_map(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_hash_map(
+        vm,
+        arguments,
+        environment,
+        true,
+        "weak-hash-map");
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_cos(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_weak_reference(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "cos";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs < numExpectedArgs)
+    if (numArgs != 1)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
+            "Builtin 'weak-reference' expects one argument. "
             "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
             numArgs);
     }
 
-    octaspire_dern_value_t * argVal =
+    octaspire_dern_value_t * const target =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(argVal);
-
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-    if (!octaspire_dern_value_is_number(argVal))
-    {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
-    }
+    octaspire_helpers_verify_not_null(target);
 
-    return octaspire_dern_vm_create_new_value_real(
-        vm,
-        cos(octaspire_dern_value_as_number_get_value(argVal)));
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_weak_reference(vm, target);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_sin(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_weak_reference_get(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "sin";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs < numExpectedArgs)
+    if (numArgs != 1)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
+            "Builtin 'weak-reference-get' expects one argument. "
             "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
             numArgs);
     }
 
-    octaspire_dern_value_t * argVal =
+    octaspire_dern_value_t * const referenceVal =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(argVal);
-
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_not_null(referenceVal);
 
-    if (!octaspire_dern_value_is_number(argVal))
+    if (!octaspire_dern_value_is_weak_reference(referenceVal))
     {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "First argument to builtin '%s' should be a number. "
+            "Builtin 'weak-reference-get' expects weak reference as the first argument. "
             "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+            octaspire_dern_value_helper_get_type_as_c_string(referenceVal->typeTag));
     }
 
-    return octaspire_dern_vm_create_new_value_real(
-        vm,
-        sin(octaspire_dern_value_as_number_get_value(argVal)));
-}
-
-octaspire_dern_value_t *octaspire_dern_vm_builtin_tan(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
-
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_dern_value_t * const target =
+        octaspire_dern_value_as_weak_reference_get_value(referenceVal);
 
-    char   const * const dernFuncName = "tan";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    if (numArgs < numExpectedArgs)
+    if (!target)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin '%s' expects %zu arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
-            numArgs);
+        return octaspire_dern_vm_get_value_nil(vm);
     }
 
-    octaspire_dern_value_t * argVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(argVal);
-
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return target;
+}
 
-    if (!octaspire_dern_value_is_number(argVal))
+// Elements of persistent collections are never modified, so atoms
+// given as arguments are copied like in 'vector'.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_persistent_element(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const value)
+{
+    if (octaspire_dern_value_is_atom(value))
     {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+        return octaspire_dern_vm_create_new_value_copy(vm, value);
     }
 
-    return octaspire_dern_vm_create_new_value_real(
-        vm,
-        tan(octaspire_dern_value_as_number_get_value(argVal)));
+    return value;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_asin(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_persistent_vector(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
-
-    char   const * const dernFuncName = "asin";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
-
-    if (numArgs < numExpectedArgs)
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin '%s' expects %zu arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
-            numArgs);
-    }
-
-    octaspire_dern_value_t * argVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_not_null(argVal);
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_persistent_vector(vm);
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_vm_push_value(vm, result);
 
-    if (!octaspire_dern_value_is_number(argVal))
+    for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(arguments); ++i)
     {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
-    }
-
-    double const result = asin(octaspire_dern_value_as_number_get_value(argVal));
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_vm_builtin_private_persistent_element(
+                vm,
+                octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i));
 
-    if (isnan(result))
-    {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "%s: math domain error.",
-            dernFuncName);
+        if (!octaspire_dern_value_as_persistent_vector_push_back_element(result, arg))
+        {
+            abort();
+        }
     }
 
-    return octaspire_dern_vm_create_new_value_real(vm, result);
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_acos(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_persistent_hash_map(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "acos";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs < numExpectedArgs)
+    if (numArgs % 2 != 0)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
+            "Builtin 'persistent-hash-map' expects pairs of keys and values. "
             "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
             numArgs);
     }
 
-    octaspire_dern_value_t * argVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_persistent_hash_map(vm);
 
-    octaspire_helpers_verify_not_null(argVal);
+    octaspire_dern_vm_push_value(vm, result);
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    for (size_t i = 0; i < numArgs; i += 2)
+    {
+        octaspire_dern_value_t * const keyArg =
+            octaspire_dern_vm_builtin_private_persistent_element(
+                vm,
+                octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i));
 
-    if (!octaspire_dern_value_is_number(argVal))
+        octaspire_dern_vm_push_value(vm, keyArg);
+
+        octaspire_dern_value_t * const valArg =
+            octaspire_dern_vm_builtin_private_persistent_element(
+                vm,
+                octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)(i + 1)));
+
+        if (!octaspire_dern_value_as_persistent_hash_map_put(result, keyArg, valArg))
+        {
+            abort();
+        }
+
+        octaspire_dern_vm_pop_value(vm, keyArg);
+    }
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+// Returns the collection that builtin 'dernFuncName' modifies: a transient
+// collection is modified in place, and a persistent one through a new
+// version that shares its nodes. Returns an error value if the collection
+// is not of the expected kind.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_get_persistent_target(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const collection,
+    bool const transient,
+    char const * const dernFuncName)
+{
+    if (!octaspire_dern_value_is_persistent_vector(collection) &&
+        !octaspire_dern_value_is_persistent_hash_map(collection))
     {
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
+            "Builtin '%s' expects persistent vector or persistent hash map "
+            "as the first argument. Type '%s' was given.",
             dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+            octaspire_dern_value_helper_get_type_as_c_string(collection->typeTag));
     }
 
-    double const result = acos(octaspire_dern_value_as_number_get_value(argVal));
-
-    if (isnan(result))
+    if (octaspire_dern_value_is_transient(collection) != transient)
     {
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "%s: math domain error.",
+            transient ?
+                "Builtin '%s' expects a transient collection. Use 'transient' first." :
+                "Builtin '%s' does not accept a transient collection. "
+                "Use 'persistent!' first.",
             dernFuncName);
     }
 
-    return octaspire_dern_vm_create_new_value_real(vm, result);
+    if (transient)
+    {
+        return collection;
+    }
+
+    return octaspire_dern_vm_create_new_value_copy(vm, collection);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_atan(
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_conj(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
+    octaspire_dern_value_t *environment,
+    bool const transient,
+    char const * const dernFuncName)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "atan";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs < numExpectedArgs)
+    if (numArgs < 1)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
-
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
-            "%zu arguments were given.",
-            dernFuncName,
-            numExpectedArgs,
-            numArgs);
+            "Builtin '%s' expects at least one argument.",
+            dernFuncName);
     }
 
-    octaspire_dern_value_t * argVal =
+    octaspire_dern_value_t * const collection =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(argVal);
-
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-    if (!octaspire_dern_value_is_number(argVal))
+    if (!octaspire_dern_value_is_persistent_vector(collection))
     {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "First argument to builtin '%s' should be a number. "
+            "Builtin '%s' expects persistent vector as the first argument. "
             "Type '%s' was given.",
             dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+            octaspire_dern_value_helper_get_type_as_c_string(collection->typeTag));
     }
 
-    double const result = atan(octaspire_dern_value_as_number_get_value(argVal));
-
-    if (isnan(result))
-    {
-        return octaspire_dern_vm_create_new_value_error_format(
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_get_persistent_target(
             vm,
-            "%s: math domain error.",
+            collection,
+            transient,
             dernFuncName);
+
+    if (octaspire_dern_value_is_error(result))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
     }
 
-    return octaspire_dern_vm_create_new_value_real(vm, result);
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_vm_builtin_private_persistent_element(
+                vm,
+                octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i));
+
+        if (!octaspire_dern_value_as_persistent_vector_push_back_element(result, arg))
+        {
+            abort();
+        }
+    }
+
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_sqrt(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_conj(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    return octaspire_dern_vm_builtin_private_conj(
+        vm,
+        arguments,
+        environment,
+        false,
+        "conj");
+}
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+octaspire_dern_value_t *octaspire_dern_vm_builtin_conj_exclamation(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_conj(
+        vm,
+        arguments,
+        environment,
+        true,
+        "conj!");
+}
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_assoc(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment,
+    bool const transient,
+    char const * const dernFuncName)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    char   const * const dernFuncName = "sqrt";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 1;
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    if (numArgs != numExpectedArgs)
-    {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
+    if (numArgs < 1 || numArgs % 2 != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
+            "Builtin '%s' expects a collection and pairs of keys and values. "
             "%zu arguments were given.",
             dernFuncName,
-            numExpectedArgs,
             numArgs);
     }
 
-    octaspire_dern_value_t * argVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(argVal);
-
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_get_persistent_target(
+            vm,
+            octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+            transient,
+            dernFuncName);
 
-    if (!octaspire_dern_value_is_number(argVal))
+    if (octaspire_dern_value_is_error(result))
     {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(argVal->typeTag));
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
     }
 
-    if (octaspire_dern_value_as_number_get_value(argVal) < 0)
+    octaspire_dern_vm_push_value(vm, result);
+
+    for (size_t i = 1; i < numArgs; i += 2)
     {
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "First argument to builtin '%s' have to be non-negative. "
-            "Value '%f' was given.",
-            dernFuncName,
-            octaspire_dern_value_as_number_get_value(argVal));
+        octaspire_dern_value_t * const keyArg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i);
+
+        if (octaspire_dern_value_is_persistent_vector(result))
+        {
+            // An index one past the last element appends.
+            size_t const length = octaspire_dern_value_get_length(result);
+
+            if (!octaspire_dern_value_is_integer(keyArg) ||
+                octaspire_dern_value_as_integer_get_value(keyArg) < 0 ||
+                (size_t)octaspire_dern_value_as_integer_get_value(keyArg) > length)
+            {
+                octaspire_dern_vm_pop_value(vm, result);
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '%s' expects index between 0 and %zu for persistent vector.",
+                    dernFuncName,
+                    length);
+            }
+
+            octaspire_dern_value_t * const valArg =
+                octaspire_dern_vm_builtin_private_persistent_element(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)(i + 1)));
+
+            size_t const index = (size_t)octaspire_dern_value_as_integer_get_value(keyArg);
+
+            bool const status = (index == length) ?
+                octaspire_dern_value_as_persistent_vector_push_back_element(
+                    result,
+                    valArg) :
+                octaspire_dern_value_as_persistent_vector_set_element_at(
+                    result,
+                    (ptrdiff_t)index,
+                    valArg);
+
+            if (!status)
+            {
+                abort();
+            }
+        }
+        else
+        {
+            octaspire_dern_value_t * const keyCopy =
+                octaspire_dern_vm_builtin_private_persistent_element(vm, keyArg);
+
+            octaspire_dern_vm_push_value(vm, keyCopy);
+
+            octaspire_dern_value_t * const valArg =
+                octaspire_dern_vm_builtin_private_persistent_element(
+                    vm,
+                    octaspire_dern_value_as_vector_get_element_at(
+                        arguments,
+                        (ptrdiff_t)(i + 1)));
+
+            if (!octaspire_dern_value_as_persistent_hash_map_put(result, keyCopy, valArg))
+            {
+                abort();
+            }
+
+            octaspire_dern_vm_pop_value(vm, keyCopy);
+        }
     }
 
-    return octaspire_dern_vm_create_new_value_real(
+    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_assoc(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_assoc(
         vm,
-        sqrt(octaspire_dern_value_as_number_get_value(argVal)));
+        arguments,
+        environment,
+        false,
+        "assoc");
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_pow(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_assoc_exclamation(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    return octaspire_dern_vm_builtin_private_assoc(
+        vm,
+        arguments,
+        environment,
+        true,
+        "assoc!");
+}
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_dissoc(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment,
+    bool const transient,
+    char const * const dernFuncName)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    char   const * const dernFuncName = "pow";
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-    size_t const numExpectedArgs = 2;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs != numExpectedArgs)
+    if (numArgs < 1)
     {
-        octaspire_helpers_verify_true(
-            stackLength == octaspire_dern_vm_get_stack_length(vm));
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least one argument.",
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * const collection =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
+    if (!octaspire_dern_value_is_persistent_hash_map(collection))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '%s' expects %zu arguments. "
-            "%zu arguments were given.",
+            "Builtin '%s' expects persistent hash map as the first argument. "
+            "Type '%s' was given.",
             dernFuncName,
-            numExpectedArgs,
-            numArgs);
+            octaspire_dern_value_helper_get_type_as_c_string(collection->typeTag));
     }
 
-    octaspire_dern_value_t * firstArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_get_persistent_target(
+            vm,
+            collection,
+            transient,
+            dernFuncName);
 
-    octaspire_helpers_verify_not_null(firstArgVal);
+    if (octaspire_dern_value_is_error(result))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
+    }
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        // Missing keys are ignored.
+        octaspire_dern_value_as_persistent_hash_map_remove(
+            result,
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i));
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_dissoc(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_dissoc(
+        vm,
+        arguments,
+        environment,
+        false,
+        "dissoc");
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_dissoc_exclamation(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_dissoc(
+        vm,
+        arguments,
+        environment,
+        true,
+        "dissoc!");
+}
 
-    octaspire_dern_value_t * secondArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+octaspire_dern_value_t *octaspire_dern_vm_builtin_transient(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_not_null(secondArgVal);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (!octaspire_dern_value_is_number(firstArgVal))
+    if (numArgs != 1)
     {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "First argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
+            "Builtin 'transient' expects one argument. "
+            "%zu arguments were given.",
+            numArgs);
     }
 
-    if (!octaspire_dern_value_is_number(secondArgVal))
-    {
-        return octaspire_dern_vm_create_new_value_error_format(
+    // The transient is a new version; the argument stays unmodified.
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_get_persistent_target(
             vm,
-            "Second argument to builtin '%s' should be a number. "
-            "Type '%s' was given.",
-            dernFuncName,
-            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+            octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+            false,
+            "transient");
+
+    if (!octaspire_dern_value_is_error(result))
+    {
+        octaspire_dern_value_set_transient(result, true);
     }
 
-    return octaspire_dern_vm_create_new_value_real(
-        vm,
-        pow(
-            octaspire_dern_value_as_number_get_value(firstArgVal),
-            octaspire_dern_value_as_number_get_value(secondArgVal)));
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_equals(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_persistent_exclamation(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8043,271 +12225,230 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_equals(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
+    if (numArgs != 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '+=' expects at least one argument.");
+            "Builtin 'persistent!' expects one argument. "
+            "%zu arguments were given.",
+            numArgs);
     }
 
-    octaspire_dern_value_t * const firstArg = octaspire_vector_get_element_at(vec, 0);
+    // The transient itself becomes persistent; no copy is made.
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_get_persistent_target(
+            vm,
+            octaspire_dern_value_as_vector_get_element_at(arguments, 0),
+            true,
+            "persistent!");
 
-    switch (firstArg->typeTag)
+    if (!octaspire_dern_value_is_error(result))
     {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
-
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (i == 1)
-                {
-                    octaspire_dern_value_as_character_add(firstArg, anotherArg);
-                }
-                else
-                {
-                    octaspire_dern_value_as_string_push_back(firstArg, anotherArg);
-                }
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
+        octaspire_dern_value_set_transient(result, false);
+    }
 
-                octaspire_dern_value_as_real_add(firstArg, anotherArg);
-            }
-        }
-        break;
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
 
+// Adds 'value' to the end of 'typedArray'. Numbers are added as such and
+// the elements of vectors and typed arrays one by one. Returns false if
+// 'value' or some element of it is not a number.
+static bool octaspire_dern_vm_builtin_private_typed_array_push_back(
+    octaspire_dern_typed_array_t * const typedArray,
+    octaspire_dern_value_t const * const value)
+{
+    switch (value->typeTag)
+    {
         case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
         {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                octaspire_dern_value_as_integer_add(firstArg, anotherArg);
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                // TODO XXX remove the need for '&' in &another for vectors!!!!!
-                octaspire_dern_value_as_vector_push_back_element(firstArg, &anotherArg);
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                octaspire_dern_value_as_list_push_back(firstArg, anotherArg);
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                octaspire_dern_value_as_queue_push(firstArg, anotherArg);
-            }
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                octaspire_dern_value_t *tmpArgs = octaspire_dern_vm_create_new_value_vector(vm);
-
-                octaspire_dern_vm_push_value(vm, tmpArgs);
-
-                octaspire_dern_value_as_vector_push_back_element(tmpArgs, &firstArg);
-                octaspire_dern_value_as_vector_push_back_element(tmpArgs, &anotherArg);
-
-                octaspire_dern_vm_builtin_port_write(vm, tmpArgs, environment);
-
-                octaspire_dern_vm_pop_value(vm, tmpArgs);
-            }
+            return octaspire_dern_typed_array_push_back_integer(
+                typedArray,
+                value->value.integer);
         }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
         {
-            //bool success = true;
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (!octaspire_dern_value_as_string_push_back(firstArg, anotherArg))
-                {
-                    //success = false;
-                }
-            }
-
-            // TODO report possible error?
+            return octaspire_dern_typed_array_push_back_real(
+                typedArray,
+                value->value.real);
         }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
-            //bool success = true;
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
+            for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(value); ++i)
             {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
+                octaspire_dern_value_t const * const element =
+                    octaspire_dern_value_as_vector_get_element_at_const(
+                        value,
                         (ptrdiff_t)i);
 
-                if (!octaspire_dern_value_as_symbol_push_back(firstArg, anotherArg))
+                if (!octaspire_dern_value_is_number(element) ||
+                    !octaspire_dern_vm_builtin_private_typed_array_push_back(
+                        typedArray,
+                        element))
                 {
-                    //success = false;
+                    return false;
                 }
             }
 
-            // TODO report possible error?
-        }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            for (size_t i = 1; i < octaspire_vector_get_length(vec); ++i)
-            {
-                octaspire_dern_value_t * const anotherArg =
-                    octaspire_vector_get_element_at(
-                        vec,
-                        (ptrdiff_t)i);
-
-                if (!octaspire_dern_value_as_semver_add_or_subtract(firstArg, anotherArg, true))
-                {
-                    //success = false;
-                }
-
-                // TODO report possible error?
-            }
+            return true;
         }
-        break;
-
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        {
-            if (octaspire_vector_get_length(vec) == 2)
-            {
-                if (!octaspire_dern_value_as_hash_map_add(
-                        firstArg,
-                        octaspire_vector_get_element_at(vec, 1),
-                        0))
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin '+=' failed");
-                }
-            }
-            else if (octaspire_vector_get_length(vec) == 3)
-            {
-                if (!octaspire_dern_value_as_hash_map_add(
-                        firstArg,
-                        octaspire_vector_get_element_at(vec, 1),
-                        octaspire_vector_get_element_at(vec, 2)))
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin '+=' failed");
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            octaspire_dern_typed_array_t const * const other = value->value.typedArray;
+            bool const isInteger = octaspire_dern_typed_array_element_type_is_integer(
+                octaspire_dern_typed_array_get_element_type(other));
+
+            for (size_t i = 0; i < octaspire_dern_typed_array_get_length(other); ++i)
+            {
+                bool const pushed = isInteger ?
+                    octaspire_dern_typed_array_push_back_integer(
+                        typedArray,
+                        octaspire_dern_typed_array_get_integer_at(other, i)) :
+                    octaspire_dern_typed_array_push_back_real(
+                        typedArray,
+                        octaspire_dern_typed_array_get_real_at(other, i));
+
+                if (!pushed)
+                {
+                    return false;
                 }
             }
-            else
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_error_from_c_string(
-                    vm,
-                    "Builtin '+=' expects one or two additional arguments for hash map");
-            }
+            return true;
         }
-        break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        default:
         {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return firstArg;
+            return false;
         }
+    }
+}
 
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+octaspire_dern_value_t *octaspire_dern_vm_builtin_typed_array(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "typed-array";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs < 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
+
+    octaspire_dern_value_t const * const typeArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    octaspire_helpers_verify_not_null(typeArg);
+
+    octaspire_dern_typed_array_element_type_t elementType =
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64;
+
+    if (!octaspire_dern_value_is_symbol(typeArg) ||
+        !octaspire_dern_typed_array_element_type_from_name(
+            octaspire_dern_value_as_symbol_get_c_string(typeArg),
+            &elementType))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be one of the element types "
+            "'f64, 'f32, 'i64, 'i32 or 'u8.",
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_typed_array(vm, elementType, 0);
+
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        if (!octaspire_dern_vm_builtin_private_typed_array_push_back(
+                result->value.typedArray,
+                arg))
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
                 vm,
-                "First argument to builtin '+=' cannot be of type '%s'.",
-                octaspire_dern_value_helper_get_type_as_c_string(firstArg->typeTag));
+                "Builtin '%s' expects numbers, vectors of numbers or typed arrays "
+                "after the element type. Argument %zu has type '%s'.",
+                dernFuncName,
+                i + 1,
+                octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return firstArg;
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_plus(
+// Returns the typed array given as argument 'index' to builtin
+// 'dernFuncName' or an error value if the argument is something else.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_get_typed_array_arg(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    size_t const index,
+    char const * const dernFuncName)
+{
+    octaspire_dern_value_t * const arg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)index);
+
+    octaspire_helpers_verify_not_null(arg);
+
+    if (!octaspire_dern_value_is_typed_array(arg))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Argument %zu to builtin '%s' must be typed array. Type '%s' was given.",
+            index + 1,
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
+    }
+
+    return arg;
+}
+
+// Results of reductions over integer arrays are integers when they fit
+// into an integer value of Dern, otherwise reals.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_typed_array_result(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_typed_array_t const * const typedArray,
+    double const value)
+{
+    if (octaspire_dern_typed_array_element_type_is_integer(
+            octaspire_dern_typed_array_get_element_type(typedArray)) &&
+        value >= INT32_MIN &&
+        value <= INT32_MAX)
+    {
+        return octaspire_dern_vm_create_new_value_integer(vm, (int32_t)value);
+    }
+
+    return octaspire_dern_vm_create_new_value_real(vm, value);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sum(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8317,47 +12458,89 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_plus_plus(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    char   const * const dernFuncName = "sum";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
+    if (numArgs != 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '++' expects at least one argument.");
+            "Builtin '%s' expects one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
     }
 
-    octaspire_dern_value_t *value = 0;
+    octaspire_dern_value_t * const arg =
+        octaspire_dern_vm_builtin_private_get_typed_array_arg(vm, arguments, 0, dernFuncName);
 
-    for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
+    if (octaspire_dern_value_is_error(arg))
     {
-        value = octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return arg;
+    }
 
-        if (!octaspire_dern_value_is_number(value))
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "Arguments to builtin '++' must be numbers. %zuth argument has type '%s'.",
-                i + 1,
-                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
-        }
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER)
-        {
-            ++(value->value.integer);
-        }
-        else
-        {
-            ++(value->value.real);
-        }
+    return octaspire_dern_vm_builtin_private_typed_array_result(
+        vm,
+        arg->value.typedArray,
+        octaspire_dern_typed_array_get_sum(arg->value.typedArray));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_mean(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    char   const * const dernFuncName = "mean";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * const arg =
+        octaspire_dern_vm_builtin_private_get_typed_array_arg(vm, arguments, 0, dernFuncName);
+
+    if (octaspire_dern_value_is_error(arg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return arg;
+    }
+
+    size_t const length = octaspire_dern_typed_array_get_length(arg->value.typedArray);
+
+    if (length == 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' cannot compute the mean of an empty typed array.",
+            dernFuncName);
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return value;
+
+    return octaspire_dern_vm_create_new_value_real(
+        vm,
+        octaspire_dern_typed_array_get_sum(arg->value.typedArray) / (double)length);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_minus(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_dot(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8367,98 +12550,163 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_minus_minus(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_vector_t * const vec = arguments->value.vector;
+    char   const * const dernFuncName = "dot";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (octaspire_vector_get_length(vec) < 1)
+    if (numArgs != 2)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '--' expects at least one argument.");
+            "Builtin '%s' expects two arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
     }
 
-    octaspire_dern_value_t *value = 0;
+    octaspire_dern_value_t * const firstArg =
+        octaspire_dern_vm_builtin_private_get_typed_array_arg(vm, arguments, 0, dernFuncName);
 
-    for (size_t i = 0; i < octaspire_vector_get_length(vec); ++i)
+    if (octaspire_dern_value_is_error(firstArg))
     {
-        value = octaspire_vector_get_element_at(vec, (ptrdiff_t)i);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return firstArg;
+    }
 
-        if (octaspire_dern_value_is_integer(value))
-        {
-            --(value->value.integer);
-        }
-        else if (octaspire_dern_value_is_real(value))
-        {
-            --(value->value.real);
-        }
-        else if (octaspire_dern_value_is_queue(value))
-        {
-            if (!octaspire_dern_value_as_queue_pop(value))
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t * const secondArg =
+        octaspire_dern_vm_builtin_private_get_typed_array_arg(vm, arguments, 1, dernFuncName);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '--' failed on %zuth argument (queue)",
-                    i + 1);
-            }
-        }
-        else if (octaspire_dern_value_is_list(value))
+    if (octaspire_dern_value_is_error(secondArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return secondArg;
+    }
+
+    if (octaspire_dern_typed_array_get_length(firstArg->value.typedArray) !=
+        octaspire_dern_typed_array_get_length(secondArg->value.typedArray))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Typed arrays given to builtin '%s' must have the same length. "
+            "Lengths %zu and %zu were given.",
+            dernFuncName,
+            octaspire_dern_typed_array_get_length(firstArg->value.typedArray),
+            octaspire_dern_typed_array_get_length(secondArg->value.typedArray));
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    return octaspire_dern_vm_builtin_private_typed_array_result(
+        vm,
+        firstArg->value.typedArray,
+        octaspire_dern_typed_array_get_dot_product(
+            firstArg->value.typedArray,
+            secondArg->value.typedArray));
+}
+
+// Appends the octets of 'value' to 'bytes'. Integers are added as single
+// octets, strings and characters as their UTF-8 octets and the elements
+// of vectors and other bytes one by one. Returns false if 'value' cannot
+// be given as octets.
+static bool octaspire_dern_vm_builtin_private_bytes_push_back(
+    octaspire_dern_bytes_t * const bytes,
+    octaspire_dern_value_t const * const value)
+{
+    switch (value->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
         {
-            if (!octaspire_dern_value_as_list_pop_back(value))
+            if (value->value.integer < 0 || value->value.integer > UINT8_MAX)
             {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '--' failed on %zuth argument (list)",
-                    i + 1);
+                return false;
             }
+
+            return octaspire_dern_bytes_push_back_octet(
+                bytes,
+                (uint8_t)value->value.integer);
         }
-        else if (octaspire_dern_value_is_vector(value))
-        {
-            if (!octaspire_dern_value_as_vector_pop_back_element(value))
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '--' failed on %zuth argument (vector)",
-                    i + 1);
-            }
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            return octaspire_dern_bytes_push_back_buffer(
+                bytes,
+                octaspire_dern_value_as_text_get_c_string(value),
+                octaspire_dern_value_as_text_get_length_in_octets(value));
         }
-        else if (octaspire_dern_value_is_string(value))
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
-            if (!octaspire_dern_value_as_string_pop_back_ucs_character(value))
+            for (size_t i = 0; i < octaspire_dern_value_as_vector_get_length(value); ++i)
             {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+                octaspire_dern_value_t const * const element =
+                    octaspire_dern_value_as_vector_get_element_at_const(
+                        value,
+                        (ptrdiff_t)i);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '--' failed on %zuth argument (string)",
-                    i + 1);
+                if (!octaspire_dern_value_is_integer(element) ||
+                    !octaspire_dern_vm_builtin_private_bytes_push_back(bytes, element))
+                {
+                    return false;
+                }
             }
+
+            return true;
         }
-        else
+
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            return octaspire_dern_bytes_push_back_buffer(
+                bytes,
+                octaspire_dern_bytes_get_octets(value->value.bytes),
+                octaspire_dern_bytes_get_length(value->value.bytes));
+        }
+
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_bytes(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_bytes(vm);
+
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        if (!octaspire_dern_vm_builtin_private_bytes_push_back(result->value.bytes, arg))
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
                 vm,
-                "%zuth argument to builtin '--' has unsupported type '%s'.",
-                i + 1,
-                octaspire_dern_value_helper_get_type_as_c_string(value->typeTag));
+                "Builtin 'bytes' expects octets (integers from 0 to 255), strings, "
+                "characters, vectors of octets or bytes. Argument %zu is not valid.",
+                i + 1);
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return value;
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_mod(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_bytes_slice(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8468,70 +12716,112 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_mod(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    char   const * const dernFuncName = "bytes-slice";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs != 2)
+    if (numArgs != 2 && numArgs != 3)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'mod' expects two arguments (integers). %zu arguments were given.",
+            "Builtin '%s' expects two or three arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
             numArgs);
     }
 
-    octaspire_dern_value_t * const firstArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    octaspire_dern_value_t const * const bytesArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-    if (firstArgVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
-    {
-        if (firstArgVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return firstArgVal;
-        }
+    octaspire_helpers_verify_not_null(bytesArg);
 
+    if (!octaspire_dern_value_is_bytes(bytesArg))
+    {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "The first argument to builtin 'mod' must be integer. Type %s was given.",
-            octaspire_dern_value_helper_get_type_as_c_string(firstArgVal->typeTag));
+            "First argument to builtin '%s' must be bytes. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(bytesArg->typeTag));
     }
 
-    octaspire_dern_value_t * const secondArgVal =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+    ptrdiff_t const length =
+        (ptrdiff_t)octaspire_dern_bytes_get_length(bytesArg->value.bytes);
 
-    if (secondArgVal->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+    // Start and end can be negative to count from the end, like with 'ln@'.
+    ptrdiff_t bounds[2] = {0, length};
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        if (secondArgVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        if (!octaspire_dern_value_is_integer(arg))
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return secondArgVal;
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Argument %zu to builtin '%s' must be integer. Type '%s' was given.",
+                i + 1,
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
         }
 
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "The second argument to builtin 'mod' must be integer. Type %s was given.",
-            octaspire_dern_value_helper_get_type_as_c_string(secondArgVal->typeTag));
+        ptrdiff_t const index = arg->value.integer;
+        bounds[i - 1] = (index < 0) ? (length + index) : index;
     }
 
-    if (secondArgVal->value.integer == 0)
+    if (bounds[0] < 0 || bounds[1] > length || bounds[0] > bounds[1])
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "The second argument to builtin 'mod' cannot be zero. "
-            "It would cause division by zero.");
+            "Builtin '%s' was given a range that is not valid for bytes of length %td.",
+            dernFuncName,
+            length);
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    return octaspire_dern_vm_create_new_value_integer(
+    return octaspire_dern_vm_create_new_value_bytes_from_buffer(
         vm,
-        firstArgVal->value.integer % secondArgVal->value.integer);
+        octaspire_dern_bytes_get_octets(bytesArg->value.bytes) + bounds[0],
+        (size_t)(bounds[1] - bounds[0]));
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_slash(
+// Reads the integer format given as symbol argument 'index' to builtin
+// 'dernFuncName'. Returns an error value if the argument is not valid,
+// otherwise null.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_get_integer_format_arg(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t const * const arguments,
+    size_t const index,
+    char const * const dernFuncName,
+    octaspire_dern_bytes_integer_format_t * const format)
+{
+    octaspire_dern_value_t const * const arg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)index);
+
+    octaspire_helpers_verify_not_null(arg);
+
+    if (!octaspire_dern_value_is_symbol(arg) ||
+        !octaspire_dern_bytes_integer_format_from_name(
+            octaspire_dern_value_as_symbol_get_c_string(arg),
+            format))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Argument %zu to builtin '%s' must be one of the formats 'u8, 'i8, "
+            "'u16le, 'u16be, 'i16le, 'i16be, 'u32le, 'u32be, 'i32le, 'i32be, "
+            "'u64le, 'u64be, 'i64le or 'i64be.",
+            index + 1,
+            dernFuncName);
+    }
+
+    return 0;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_bytes_pack(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8541,209 +12831,88 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_slash(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    char   const * const dernFuncName = "bytes-pack";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs < 1)
+    if (numArgs < 3)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin '/' expects at least one numeric argument (integer or real).");
-    }
-
-    if (numArgs == 1)
-    {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-        octaspire_helpers_verify_not_null(currentArg);
-
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                double const currentArgAsReal = currentArg->value.integer;
-
-                // Fix warning on clang's -Weverything level
-                if (currentArgAsReal >= 0 &&
-                    currentArgAsReal <= 0)
-                {
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "First argument to builtin '/' cannot be zero. "
-                        "It would cause division by zero.");
-                }
-                else
-                {
-                    return octaspire_dern_vm_create_new_value_real(vm, 1.0 / currentArgAsReal);
-                }
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                double const currentArgAsReal = currentArg->value.real;
-
-                if (currentArgAsReal >= 0 && currentArgAsReal <= 0)
-                {
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "First argument to builtin '/' cannot be zero. "
-                        "It would cause division by zero.");
-                }
-                else
-                {
-                    return octaspire_dern_vm_create_new_value_real(vm, 1.0 / currentArgAsReal);
-                }
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return currentArg;
-                }
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '/' expects numeric arguments (integer or real). First argument has "
-                    "type %s.",
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
-        }
+            "Builtin '%s' expects at least three arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
     }
 
-    double realResult = 1;
-
-    for (size_t i = 0; i < numArgs; ++i)
-    {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
-
-        octaspire_helpers_verify_not_null(currentArg);
-
-        double currentValueAsNumber = 0;
-
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            {
-                currentValueAsNumber = currentArg->value.integer;
-            }
-            break;
-
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            {
-                currentValueAsNumber = currentArg->value.real;
-            }
-            break;
+    octaspire_dern_value_t * const bytesArg =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_not_null(bytesArg);
 
-                    return currentArg;
-                }
+    if (!octaspire_dern_value_is_bytes(bytesArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be bytes. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(bytesArg->typeTag));
+    }
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_bytes_integer_format_t format = OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U8;
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '/' expects numeric arguments (integer or real). %zuth argument has "
-                    "type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
-        }
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_get_integer_format_arg(
+            vm,
+            arguments,
+            1,
+            dernFuncName,
+            &format);
 
-        if (i == 0)
+    if (error)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return error;
+    }
+
+    // All values are checked first, so that nothing is appended on error.
+    for (size_t i = 2; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        if (!octaspire_dern_value_is_integer(arg))
         {
-            realResult = currentValueAsNumber;
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Argument %zu to builtin '%s' must be integer. Type '%s' was given.",
+                i + 1,
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
         }
-        else
-        {
-            if (currentValueAsNumber >= 0 && currentValueAsNumber <= 0)
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    }
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Argument number %zu to builtin '/' cannot be zero. "
-                    "It would cause division by zero.",
-                    i + 1);
-            }
+    for (size_t i = 2; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
 
-            realResult /= currentValueAsNumber;
+        if (!octaspire_dern_bytes_pack_integer(
+                bytesArg->value.bytes,
+                format,
+                arg->value.integer))
+        {
+            abort();
         }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_real(vm, realResult);
+    return bytesArg;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_times(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_bytes_unpack(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8753,95 +12922,92 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_times(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    bool allArgsAreIntegers = true;
-    double realResult = 1;
-    int32_t integerResult = 1;
+    char   const * const dernFuncName = "bytes-unpack";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    for (size_t i = 0; i < numArgs; ++i)
+    if (numArgs != 3)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
-
-        octaspire_helpers_verify_not_null(currentArg);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects three arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
 
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+    octaspire_dern_value_t const * const bytesArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            {
-                integerResult *= currentArg->value.integer;
-                realResult    *= (double)currentArg->value.integer;
-            }
-            break;
+    octaspire_helpers_verify_not_null(bytesArg);
 
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            {
-                allArgsAreIntegers = false;
+    if (!octaspire_dern_value_is_bytes(bytesArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be bytes. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(bytesArg->typeTag));
+    }
 
-                integerResult *= (int32_t)(currentArg->value.real);
-                realResult    *= currentArg->value.real;
-            }
-            break;
+    octaspire_dern_bytes_integer_format_t format = OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U8;
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_get_integer_format_arg(
+            vm,
+            arguments,
+            1,
+            dernFuncName,
+            &format);
 
-                    return currentArg;
-                }
+    if (error)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return error;
+    }
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t const * const indexArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 2);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '*' expects numeric arguments (integer or real). %zuth argument has "
-                    "type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
-        }
-    }
+    int64_t result = 0;
 
-    if (allArgsAreIntegers)
+    if (!octaspire_dern_value_is_integer(indexArg) ||
+        indexArg->value.integer < 0 ||
+        !octaspire_dern_bytes_unpack_integer(
+            bytesArg->value.bytes,
+            (size_t)indexArg->value.integer,
+            format,
+            &result))
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Third argument to builtin '%s' must be an index that has enough "
+            "octets after it in the bytes.",
+            dernFuncName);
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_real(vm, realResult);
+
+    // Integer values of Dern have 32 bits, values outside of that range
+    // are given as reals.
+    if (result < 0 &&
+        (format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64LE ||
+         format == OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U64BE))
+    {
+        return octaspire_dern_vm_create_new_value_real(vm, (double)(uint64_t)result);
+    }
+
+    if (result > INT32_MAX || result < INT32_MIN)
+    {
+        return octaspire_dern_vm_create_new_value_real(vm, (double)result);
+    }
+
+    return octaspire_dern_vm_create_new_value_integer(vm, (int32_t)result);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_numerical(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_bytes_to_string(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8851,95 +13017,79 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_numerical(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    bool allArgsAreIntegers = true;
-    double realResult = 0;
-    int32_t integerResult = 0;
+    char   const * const dernFuncName = "bytes-to-string";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    for (size_t i = 0; i < numArgs; ++i)
+    if (numArgs != 1)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
 
-        octaspire_helpers_verify_not_null(currentArg);
+    octaspire_dern_value_t const * const bytesArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+    octaspire_helpers_verify_not_null(bytesArg);
 
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            {
-                integerResult += currentArg->value.integer;
-                realResult    += (double)currentArg->value.integer;
-            }
-            break;
+    if (!octaspire_dern_value_is_bytes(bytesArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be bytes. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(bytesArg->typeTag));
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            {
-                allArgsAreIntegers = false;
+    octaspire_string_t * const str = octaspire_string_new_from_buffer(
+        (char const*)octaspire_dern_bytes_get_octets(bytesArg->value.bytes),
+        octaspire_dern_bytes_get_length(bytesArg->value.bytes),
+        octaspire_dern_vm_get_allocator(vm));
 
-                integerResult += (int32_t)(currentArg->value.real);
-                realResult    += currentArg->value.real;
-            }
-            break;
+    octaspire_helpers_verify_not_null(str);
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_string(vm, str);
+}
 
-                    return currentArg;
-                }
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_builder(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '+' expects numeric arguments (integer or real). %zuth argument has "
-                    "type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
-        }
-    }
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (allArgsAreIntegers)
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_string_builder(vm);
+
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        if (!octaspire_dern_value_as_string_builder_push_back(result, arg))
+        {
+            abort();
+        }
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_real(vm, realResult);
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_string(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_builder_to_string(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -8949,397 +13099,600 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_string(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    char   const * const dernFuncName = "string-builder-to-string";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    octaspire_dern_value_t *firstArg =
+    if (numArgs != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
+
+    octaspire_dern_value_t * const builderArg =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(firstArg);
-    octaspire_helpers_verify_true(firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
+    octaspire_helpers_verify_not_null(builderArg);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_string_from_c_string(
+    if (!octaspire_dern_value_is_string_builder(builderArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            octaspire_string_get_c_string(firstArg->value.symbol));
+            "First argument to builtin '%s' must be string builder. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(builderArg->typeTag));
+    }
 
-    octaspire_dern_vm_push_value(vm, result);
+    // The text is decoded only once here. The builder is emptied, so that
+    // its buffer can be reused for building the next string.
+    octaspire_string_t * const str = octaspire_string_new_from_buffer(
+        (char const*)octaspire_dern_bytes_get_octets(builderArg->value.stringBuilder),
+        octaspire_dern_bytes_get_length(builderArg->value.stringBuilder),
+        octaspire_dern_vm_get_allocator(vm));
 
-    for (size_t i = 1; i < numArgs; ++i)
+    octaspire_helpers_verify_not_null(str);
+
+    octaspire_dern_bytes_clear(builderArg->value.stringBuilder);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_string(vm, str);
+}
+
+typedef enum octaspire_dern_vm_builtin_private_sort_mode_t
+{
+    OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_NUMBER,
+    OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_STRING,
+    OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_VALUE,
+    OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_COMPARATOR
+}
+octaspire_dern_vm_builtin_private_sort_mode_t;
+
+typedef struct octaspire_dern_vm_builtin_private_sort_context_t
+{
+    octaspire_dern_vm_t                            *vm;
+    octaspire_dern_value_t                         *environment;
+    octaspire_dern_value_t                         *comparator;
+    octaspire_dern_value_t                         *error;
+    octaspire_dern_value_t                        **keys;
+    double                                         *numbers;
+    char const                                    **strings;
+    char const                                     *dernFuncName;
+    octaspire_dern_vm_builtin_private_sort_mode_t   mode;
+    char                                            padding[4];
+}
+octaspire_dern_vm_builtin_private_sort_context_t;
+
+// Specials evaluate their arguments, so values given to them are quoted.
+static void octaspire_dern_vm_builtin_private_sort_push_back_argument(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const callArgs,
+    octaspire_dern_value_t *value,
+    bool const quote)
+{
+    if (quote)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_dern_value_t * const quoteSym =
+            octaspire_dern_vm_create_new_value_symbol_from_c_string(vm, "quote");
 
-        octaspire_helpers_verify_not_null(currentArg);
+        octaspire_dern_vm_push_value(vm, quoteSym);
 
-        switch (currentArg->typeTag)
+        octaspire_dern_value_t * const quoted = value;
+
+        value = octaspire_dern_vm_create_new_value_vector_from_values(
+            vm,
+            2,
+            quoteSym,
+            quoted);
+
+        octaspire_dern_vm_pop_value(vm, quoteSym);
+    }
+
+    if (!octaspire_dern_value_as_vector_push_back_element(callArgs, &value))
+    {
+        abort();
+    }
+}
+
+// Calls 'callable', that must be a function, builtin or special, with the
+// given already evaluated arguments.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_sort_call(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const callable,
+    octaspire_dern_value_t * const first,
+    octaspire_dern_value_t * const second,
+    octaspire_dern_value_t * const environment)
+{
+    bool const isSpecial = (callable->typeTag == OCTASPIRE_DERN_VALUE_TAG_SPECIAL);
+
+    octaspire_dern_value_t * const callArgs =
+        octaspire_dern_vm_create_new_value_vector(vm);
+
+    octaspire_dern_vm_push_value(vm, callArgs);
+
+    octaspire_dern_vm_builtin_private_sort_push_back_argument(
+        vm,
+        callArgs,
+        first,
+        isSpecial);
+
+    if (second)
+    {
+        octaspire_dern_vm_builtin_private_sort_push_back_argument(
+            vm,
+            callArgs,
+            second,
+            isSpecial);
+    }
+
+    octaspire_dern_value_t *result = 0;
+
+    if (callable->typeTag == OCTASPIRE_DERN_VALUE_TAG_FUNCTION)
+    {
+        result = octaspire_dern_vm_call_lambda(
+            vm,
+            callable->value.function,
+            callArgs,
+            environment);
+    }
+    else if (isSpecial)
+    {
+        result = (callable->value.special->cFunction)(vm, callArgs, environment);
+    }
+    else
+    {
+        octaspire_helpers_verify_true(
+            callable->typeTag == OCTASPIRE_DERN_VALUE_TAG_BUILTIN);
+
+        result = (callable->value.builtin->cFunction)(vm, callArgs, environment);
+    }
+
+    octaspire_helpers_verify_not_null(result);
+
+    octaspire_dern_vm_pop_value(vm, callArgs);
+    return result;
+}
+
+static int octaspire_dern_vm_builtin_private_sort_compare(
+    size_t const first,
+    size_t const second,
+    void * const context)
+{
+    octaspire_dern_vm_builtin_private_sort_context_t * const sortContext =
+        (octaspire_dern_vm_builtin_private_sort_context_t*)context;
+
+    switch (sortContext->mode)
+    {
+        case OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_NUMBER:
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+            double const a = sortContext->numbers[first];
+            double const b = sortContext->numbers[second];
+            return (a > b) - (a < b);
+        }
 
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            {
-                octaspire_string_concatenate(
-                    result->value.string,
-                    currentArg->value.string);
-            }
-            break;
+        case OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_STRING:
+        {
+            return strcmp(sortContext->strings[first], sortContext->strings[second]);
+        }
 
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_VALUE:
+        {
+            return octaspire_dern_value_compare(
+                sortContext->keys[first],
+                sortContext->keys[second]);
+        }
+
+        case OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_COMPARATOR:
+        {
+            // After the first error the order does not matter anymore.
+            if (sortContext->error)
             {
-                octaspire_string_concatenate(
-                    result->value.string,
-                    currentArg->value.character);
+                return 0;
             }
-            break;
 
-            // TODO Add symbol and maybe automatic conversion from number -> string
+            octaspire_dern_value_t * const result =
+                octaspire_dern_vm_builtin_private_sort_call(
+                    sortContext->vm,
+                    sortContext->comparator,
+                    sortContext->keys[first],
+                    sortContext->keys[second],
+                    sortContext->environment);
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+            if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
             {
-                octaspire_dern_vm_pop_value(vm, result);
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+                sortContext->error = result;
+                octaspire_dern_vm_push_value(sortContext->vm, result);
+                return 0;
+            }
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '+' expects textual arguments if the first argument is string. %zuth "
-                    "argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+            if (!octaspire_dern_value_is_boolean(result))
+            {
+                sortContext->error = octaspire_dern_vm_create_new_value_error_format(
+                    sortContext->vm,
+                    "Comparator of builtin '%s' must return boolean. "
+                    "Type '%s' was returned.",
+                    sortContext->dernFuncName,
+                    octaspire_dern_value_helper_get_type_as_c_string(result->typeTag));
+
+                octaspire_dern_vm_push_value(sortContext->vm, sortContext->error);
+                return 0;
             }
+
+            return octaspire_dern_value_as_boolean_get_value(result) ? -1 : 0;
         }
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    // TODO what to return? Count of removals or the modified string-value?
-    return result;
+    abort();
+    return 0;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_char(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_sort(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    octaspire_dern_value_t * const environment,
+    bool const inPlace,
+    char const * const dernFuncName)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    if (numArgs < 1 || numArgs > 3)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects one to three arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
 
-    octaspire_helpers_verify_not_null(firstArg);
+    octaspire_dern_value_t * const collection =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER);
+    octaspire_helpers_verify_not_null(collection);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_string_from_c_string(
+    if (!octaspire_dern_value_is_vector(collection) &&
+        !octaspire_dern_value_is_list(collection)   &&
+        !octaspire_dern_value_is_typed_array(collection))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            octaspire_string_get_c_string(firstArg->value.character));
+            "First argument to builtin '%s' must be vector, list or typed array. "
+            "Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(collection->typeTag));
+    }
 
-    octaspire_dern_vm_push_value(vm, result);
+    octaspire_dern_value_t *keyFunction = 0;
+    octaspire_dern_value_t *comparator  = 0;
 
     for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i);
 
-        octaspire_helpers_verify_not_null(currentArg);
+        octaspire_helpers_verify_not_null(arg);
 
-        switch (currentArg->typeTag)
+        if (i == 1 && octaspire_dern_value_is_nil(arg))
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            {
-                octaspire_string_concatenate(
-                    result->value.string,
-                    currentArg->value.string);
-            }
-            break;
-
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            {
-                octaspire_string_concatenate(
-                    result->value.string,
-                    currentArg->value.character);
-            }
-            break;
+            continue;
+        }
 
-            // TODO Add symbol and maybe automatic conversion from number -> string
+        if (!octaspire_dern_value_is_function(arg) &&
+            !octaspire_dern_value_is_builtin(arg)  &&
+            !octaspire_dern_value_is_special(arg))
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "%s argument to builtin '%s' must be function, builtin or special. "
+                "Type '%s' was given.",
+                (i == 1) ? "Second" : "Third",
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
+        }
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_dern_vm_pop_value(vm, result);
+        if (i == 1)
+        {
+            keyFunction = arg;
+        }
+        else
+        {
+            comparator = arg;
+        }
+    }
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    // Typed arrays of numbers can be sorted directly without boxing
+    // the elements.
+    if (octaspire_dern_value_is_typed_array(collection) && !keyFunction && !comparator)
+    {
+        octaspire_dern_value_t *result = collection;
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '+' expects textual arguments if the first argument is character. "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
+        if (inPlace)
+        {
+            octaspire_dern_value_prepare_for_mutation(collection);
+        }
+        else
+        {
+            result = octaspire_dern_vm_create_new_value_typed_array_copy(
+                vm,
+                collection->value.typedArray,
+                octaspire_dern_typed_array_get_element_type(collection->value.typedArray));
         }
+
+        octaspire_dern_typed_array_sort(result->value.typedArray);
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return result;
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    // TODO what to return? Count of removals or the modified string-value?
-    return result;
-}
+    // The elements are collected into a vector that keeps them reachable
+    // while the key function and comparator are called.
+    octaspire_dern_value_t * const elements =
+        octaspire_dern_vm_create_new_value_vector(vm);
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_textual_symbol(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    octaspire_dern_vm_push_value(vm, elements);
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_dern_value_prepare_for_element_access(collection);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    if (octaspire_dern_value_is_vector(collection))
+    {
+        size_t const length = octaspire_dern_value_as_vector_get_length(collection);
 
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+        for (size_t i = 0; i < length; ++i)
+        {
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_vector_get_element_at(collection, (ptrdiff_t)i);
 
-    octaspire_helpers_verify_not_null(firstArg);
+            octaspire_dern_value_as_vector_push_back_element(elements, &element);
+        }
+    }
+    else if (octaspire_dern_value_is_list(collection))
+    {
+        octaspire_dern_deque_iterator_t iter =
+            octaspire_dern_deque_iterator_init(collection->value.list);
 
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
+        while (iter.element)
+        {
+            octaspire_dern_value_as_vector_push_back_element(elements, &iter.element);
+            octaspire_dern_deque_iterator_next(&iter);
+        }
+    }
+    else
+    {
+        size_t const length =
+            octaspire_dern_typed_array_get_length(collection->value.typedArray);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_symbol_from_c_string(
-            vm,
-            octaspire_string_get_c_string(firstArg->value.symbol));
+        for (size_t i = 0; i < length; ++i)
+        {
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_typed_array_get_element_at(collection, (ptrdiff_t)i);
 
-    octaspire_dern_vm_push_value(vm, result);
+            octaspire_dern_value_as_vector_push_back_element(elements, &element);
+        }
+    }
 
-    for (size_t i = 1; i < numArgs; ++i)
-    {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+    size_t const length = octaspire_dern_value_as_vector_get_length(elements);
 
-        octaspire_helpers_verify_not_null(currentArg);
+    octaspire_dern_value_t *keys = elements;
 
-        switch (currentArg->typeTag)
+    if (keyFunction)
+    {
+        keys = octaspire_dern_vm_create_new_value_vector(vm);
+        octaspire_dern_vm_push_value(vm, keys);
+
+        for (size_t i = 0; i < length; ++i)
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+            octaspire_dern_value_t * const key =
+                octaspire_dern_vm_builtin_private_sort_call(
+                    vm,
+                    keyFunction,
+                    octaspire_dern_value_as_vector_get_element_at(elements, (ptrdiff_t)i),
+                    0,
+                    environment);
 
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
             {
-                octaspire_string_concatenate(
-                    result->value.symbol,
-                    currentArg->value.string);
+                octaspire_dern_vm_pop_value(vm, keys);
+                octaspire_dern_vm_pop_value(vm, elements);
+                octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+                return key;
             }
-            break;
 
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            {
-                octaspire_string_concatenate(
-                    result->value.symbol,
-                    currentArg->value.character);
-            }
-            break;
+            octaspire_dern_value_as_vector_push_back_element(keys, &key);
+        }
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            {
-                octaspire_string_concatenate(
-                    result->value.symbol,
-                    currentArg->value.symbol);
-            }
-            break;
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
 
-            // TODO Add symbol and maybe automatic conversion from number -> string
+    // One extra slot keeps the sizes of the allocations nonzero.
+    size_t * const order =
+        octaspire_allocator_malloc(allocator, (length + 1) * sizeof(size_t));
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_dern_vm_pop_value(vm, result);
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t ** const keyArray = octaspire_allocator_malloc(
+        allocator,
+        (length + 1) * sizeof(octaspire_dern_value_t*));
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '+' expects textual arguments if the first argument is symbol. "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
-        }
+    octaspire_helpers_verify_not_null(order);
+    octaspire_helpers_verify_not_null(keyArray);
+
+    bool allNumbers = true;
+    bool allStrings = true;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        order[i]    = i;
+        keyArray[i] = octaspire_dern_value_as_vector_get_element_at(keys, (ptrdiff_t)i);
+
+        allNumbers = allNumbers && octaspire_dern_value_is_number(keyArray[i]);
+        allStrings = allStrings && octaspire_dern_value_is_string(keyArray[i]);
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    // TODO what to return? Count of removals or the modified string-value?
-    return result;
-}
+    octaspire_dern_vm_builtin_private_sort_context_t context;
+    memset(&context, 0, sizeof(context));
 
-static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_semver(
-    octaspire_dern_vm_t *vm,
-    octaspire_dern_value_t *arguments,
-    octaspire_dern_value_t *environment)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+    context.vm           = vm;
+    context.environment  = environment;
+    context.comparator   = comparator;
+    context.keys         = keyArray;
+    context.dernFuncName = dernFuncName;
+    context.mode         = OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_VALUE;
 
-    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    // Homogeneous keys are compared from plain C arrays without
+    // calling back into the interpreter.
+    if (comparator)
+    {
+        context.mode = OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_COMPARATOR;
+    }
+    else if (allNumbers)
+    {
+        context.mode    = OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_NUMBER;
+        context.numbers = octaspire_allocator_malloc(allocator, (length + 1) * sizeof(double));
+        octaspire_helpers_verify_not_null(context.numbers);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+        for (size_t i = 0; i < length; ++i)
+        {
+            context.numbers[i] = octaspire_dern_value_as_number_get_value(keyArray[i]);
+        }
+    }
+    else if (allStrings)
+    {
+        context.mode    = OCTASPIRE_DERN_VM_BUILTIN_PRIVATE_SORT_MODE_STRING;
+        context.strings = octaspire_allocator_malloc(allocator, (length + 1) * sizeof(char const*));
+        octaspire_helpers_verify_not_null(context.strings);
 
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+        for (size_t i = 0; i < length; ++i)
+        {
+            context.strings[i] = octaspire_dern_value_as_string_get_c_string(keyArray[i]);
+        }
+    }
 
-    octaspire_helpers_verify_not_null(firstArg);
+    if (!octaspire_dern_helpers_sort_indices(
+            order,
+            length,
+            octaspire_dern_vm_builtin_private_sort_compare,
+            &context,
+            allocator))
+    {
+        abort();
+    }
 
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
+    octaspire_dern_value_t *result = context.error;
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_semver(
-            vm,
-            octaspire_semver_new_copy(
-                firstArg->value.semver,
-                octaspire_dern_vm_get_allocator(vm)));
+    if (result)
+    {
+        octaspire_dern_vm_pop_value(vm, result);
+    }
+    else if (octaspire_dern_value_is_typed_array(collection))
+    {
+        result = collection;
 
-    octaspire_dern_vm_push_value(vm, result);
+        if (inPlace)
+        {
+            octaspire_dern_value_prepare_for_mutation(collection);
+        }
+        else
+        {
+            result = octaspire_dern_vm_create_new_value_typed_array_copy(
+                vm,
+                collection->value.typedArray,
+                octaspire_dern_typed_array_get_element_type(collection->value.typedArray));
+        }
 
-    for (size_t i = 1; i < numArgs; ++i)
+        if (!octaspire_dern_typed_array_reorder(result->value.typedArray, order))
+        {
+            abort();
+        }
+    }
+    else if (octaspire_dern_value_is_vector(collection))
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        result = inPlace ? collection : octaspire_dern_vm_create_new_value_vector(vm);
 
-        octaspire_helpers_verify_not_null(currentArg);
+        if (inPlace)
+        {
+            octaspire_dern_value_as_vector_clear(collection);
+        }
 
-        switch (currentArg->typeTag)
+        for (size_t i = 0; i < length; ++i)
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_vector_get_element_at(elements, (ptrdiff_t)order[i]);
 
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_semver_add_or_subtract(
-                    result->value.semver,
-                    currentArg->value.semver,
-                    true);
-            }
-            break;
+            octaspire_dern_value_as_vector_push_back_element(result, &element);
+        }
+    }
+    else
+    {
+        result = inPlace ? collection : octaspire_dern_vm_create_new_value_list(vm);
 
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            {
-                octaspire_dern_vm_pop_value(vm, result);
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+        octaspire_dern_value_prepare_for_mutation(result);
+        octaspire_dern_deque_clear(result->value.list);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '+' expects SemVer arguments if the first argument is SemVer. "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+        for (size_t i = 0; i < length; ++i)
+        {
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_vector_get_element_at(elements, (ptrdiff_t)order[i]);
+
+            if (!octaspire_dern_deque_push_back(result->value.list, element))
+            {
+                abort();
             }
         }
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    octaspire_allocator_free(allocator, context.strings);
+    octaspire_allocator_free(allocator, context.numbers);
+    octaspire_allocator_free(allocator, keyArray);
+    octaspire_allocator_free(allocator, order);
+
+    if (keys != elements)
+    {
+        octaspire_dern_vm_pop_value(vm, keys);
+    }
+
+    octaspire_dern_vm_pop_value(vm, elements);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sort(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_sort(
+        vm,
+        arguments,
+        environment,
+        false,
+        "sort");
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sort_exclamation(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    return octaspire_dern_vm_builtin_private_sort(
+        vm,
+        arguments,
+        environment,
+        true,
+        "sort!");
 }
 
-static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_semver(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_set(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -9349,274 +13702,245 @@ static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_semver(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(firstArg);
-
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_semver(
-            vm,
-            octaspire_semver_new_copy(
-                firstArg->value.semver,
-                octaspire_dern_vm_get_allocator(vm)));
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_set(vm);
 
     octaspire_dern_vm_push_value(vm, result);
 
-    for (size_t i = 1; i < numArgs; ++i)
+    if (!octaspire_dern_map_reserve(result->value.set, numArgs))
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
-
-        octaspire_helpers_verify_not_null(currentArg);
-
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+        abort();
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_semver_add_or_subtract(
-                    result->value.semver,
-                    currentArg->value.semver,
-                    false);
-            }
-            break;
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t * const arg =
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i);
 
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            {
-                octaspire_dern_vm_pop_value(vm, result);
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+        octaspire_helpers_verify_not_null(arg);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '-' expects SemVer arguments if the first argument is SemVer. "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
+        if (!octaspire_dern_value_as_set_add(result, arg))
+        {
+            abort();
         }
     }
 
     octaspire_dern_vm_pop_value(vm, result);
+
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
     return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_vector(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_set_contains_question_mark(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    char   const * const dernFuncName = "set-contains?";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    octaspire_dern_value_t * const firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    if (numArgs < 2)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least two arguments. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
 
-    octaspire_helpers_verify_not_null(firstArg);
+    octaspire_dern_value_t const * const setArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_not_null(setArg);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_copy(
+    if (!octaspire_dern_value_is_set(setArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            firstArg);
-
-    octaspire_helpers_verify_not_null(result);
-
-    octaspire_dern_vm_push_value(vm, result);
+            "First argument to builtin '%s' must be set. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(setArg->typeTag));
+    }
 
+    // With many elements the result tells whether the set contains all of them.
     for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_dern_value_t * const currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_dern_value_t const * const element =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
 
-        octaspire_helpers_verify_not_null(currentArg);
+        octaspire_helpers_verify_not_null(element);
 
-        switch (currentArg->typeTag)
+        if (!octaspire_dern_value_as_set_contains(setArg, element))
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_boolean(vm, false);
+        }
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_dern_value_t * const copyOfArg =
-                    octaspire_dern_vm_create_new_value_copy(
-                        vm,
-                        currentArg);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_boolean(vm, true);
+}
 
-                octaspire_helpers_verify_not_null(copyOfArg);
+// Checks that all arguments are sets. Returns an error value, or null
+// if the arguments are valid.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_check_set_arguments(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    char const * const dernFuncName)
+{
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-                octaspire_helpers_verify_true(
-                    octaspire_dern_value_as_vector_push_back_element(
-                        result,
-                        &copyOfArg));
-            }
-            break;
+    if (numArgs < 1)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects at least one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
+
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        octaspire_dern_value_t const * const arg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
+
+        octaspire_helpers_verify_not_null(arg);
+
+        if (!octaspire_dern_value_is_set(arg))
+        {
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Argument %zu to builtin '%s' must be set. Type '%s' was given.",
+                i + 1,
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(arg->typeTag));
         }
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return 0;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_plus_hash_map(
+static octaspire_dern_map_t const *octaspire_dern_vm_builtin_private_get_set_argument(
+    octaspire_dern_value_t const * const arguments,
+    size_t const index)
+{
+    return octaspire_dern_value_as_vector_get_element_at_const(
+        arguments,
+        (ptrdiff_t)index)->value.set;
+}
+
+// Elements of the result are shared with the argument sets and are put
+// with their stored hashes, so that nothing is copied or hashed again.
+static void octaspire_dern_vm_builtin_private_set_put_element(
+    octaspire_dern_map_t * const set,
+    octaspire_dern_map_element_t const * const element)
+{
+    if (!octaspire_dern_map_put(
+            set,
+            octaspire_dern_map_element_get_hash(element),
+            octaspire_dern_map_element_get_key(element),
+            0))
+    {
+        abort();
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_set_union(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-    octaspire_helpers_verify_true(
-        arguments->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
-
-    octaspire_helpers_verify_true(
-        environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_check_set_arguments(vm, arguments, "set-union");
 
-    if (numArgs == 0 || (octaspire_helpers_is_odd_size_t(numArgs - 1)))
+    if (error)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin '+' for hash maps expects odd number of arguments. "
-            "%zu arguments were given.",
-            numArgs);
+        return error;
     }
 
-    octaspire_dern_value_t * const firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(firstArg);
-
-    octaspire_helpers_verify_true(
-        firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
-
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_create_new_value_copy(
-            vm,
-            firstArg);
-
-    octaspire_helpers_verify_not_null(result);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    octaspire_dern_vm_push_value(vm, result);
+    // The largest set is copied as a whole and the others are added to it.
+    size_t largestIndex     = 0;
+    size_t numElementsTotal = 0;
 
-    for (size_t i = 1; i < (numArgs - 1); i += 2)
+    for (size_t i = 0; i < numArgs; ++i)
     {
-        octaspire_dern_value_t * const keyArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        size_t const numElements = octaspire_dern_map_get_number_of_elements(
+            octaspire_dern_vm_builtin_private_get_set_argument(arguments, i));
 
-        octaspire_dern_value_t * const valArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)(i + 1));
+        if (numElements > octaspire_dern_map_get_number_of_elements(
+                octaspire_dern_vm_builtin_private_get_set_argument(arguments, largestIndex)))
+        {
+            largestIndex = i;
+        }
+
+        numElementsTotal += numElements;
+    }
 
-        octaspire_helpers_verify_not_null(keyArg);
-        octaspire_helpers_verify_not_null(valArg);
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_set(vm);
 
-        octaspire_helpers_verify_true(
-            keyArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_ILLEGAL);
+    octaspire_dern_map_release(result->value.set);
 
-        octaspire_helpers_verify_true(
-            valArg->typeTag != OCTASPIRE_DERN_VALUE_TAG_ILLEGAL);
+    result->value.set = octaspire_dern_map_new_copy(
+        octaspire_dern_vm_builtin_private_get_set_argument(arguments, largestIndex),
+        octaspire_dern_vm_get_allocator(vm));
 
-        octaspire_dern_value_t * const copyOfKey =
-            octaspire_dern_vm_create_new_value_copy(
-                vm,
-                keyArg);
+    octaspire_helpers_verify_not_null(result->value.set);
 
-        octaspire_helpers_verify_not_null(copyOfKey);
-        octaspire_dern_vm_push_value(vm, copyOfKey);
+    if (!octaspire_dern_map_reserve(result->value.set, numElementsTotal))
+    {
+        abort();
+    }
 
-        octaspire_dern_value_t * const copyOfVal =
-            octaspire_dern_vm_create_new_value_copy(
-                vm,
-                valArg);
+    for (size_t i = 0; i < numArgs; ++i)
+    {
+        if (i == largestIndex)
+        {
+            continue;
+        }
 
-        octaspire_helpers_verify_not_null(copyOfVal);
-        octaspire_dern_vm_push_value(vm, copyOfVal);
+        octaspire_dern_map_element_const_iterator_t iter =
+            octaspire_dern_map_element_const_iterator_init(
+                octaspire_dern_vm_builtin_private_get_set_argument(arguments, i));
 
-        octaspire_helpers_verify_true(
-            octaspire_dern_value_as_hash_map_add(
-                result,
-                copyOfKey,
-                copyOfVal));
+        while (iter.element)
+        {
+            if (!octaspire_dern_map_get_const(
+                    result->value.set,
+                    octaspire_dern_map_element_get_hash(iter.element),
+                    octaspire_dern_map_element_get_key_const(iter.element)))
+            {
+                octaspire_dern_vm_builtin_private_set_put_element(
+                    result->value.set,
+                    iter.element);
+            }
 
-        octaspire_dern_vm_pop_value(vm, copyOfVal);
-        octaspire_dern_vm_pop_value(vm, copyOfKey);
+            octaspire_dern_map_element_const_iterator_next(&iter);
+        }
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
     return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_numerical(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_set_intersection(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -9626,127 +13950,76 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_numerical(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    bool allArgsAreIntegers = true;
-    double realResult = 0;
-    int32_t integerResult = 0;
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_check_set_arguments(vm, arguments, "set-intersection");
 
-    for (size_t i = 0; i < numArgs; ++i)
+    if (error)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return error;
+    }
 
-        octaspire_helpers_verify_not_null(currentArg);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-        switch (currentArg->typeTag)
-        {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-            {
-                abort();
-            }
+    // Elements of the smallest set are probed from the other sets.
+    size_t smallestIndex = 0;
 
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            {
-                if (numArgs == 1)
-                {
-                    integerResult = -currentArg->value.integer;
-                    realResult    = -(double)currentArg->value.integer;
-                }
-                else
-                {
-                    if (i == 0)
-                    {
-                        integerResult = currentArg->value.integer;
-                        realResult    = (double)currentArg->value.integer;
-                    }
-                    else
-                    {
-                        integerResult -= currentArg->value.integer;
-                        realResult    -= (double)currentArg->value.integer;
-                    }
-                }
-            }
-            break;
+    for (size_t i = 1; i < numArgs; ++i)
+    {
+        if (octaspire_dern_map_get_number_of_elements(
+                octaspire_dern_vm_builtin_private_get_set_argument(arguments, i)) <
+            octaspire_dern_map_get_number_of_elements(
+                octaspire_dern_vm_builtin_private_get_set_argument(arguments, smallestIndex)))
+        {
+            smallestIndex = i;
+        }
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            {
-                allArgsAreIntegers = false;
+    octaspire_dern_map_t const * const smallest =
+        octaspire_dern_vm_builtin_private_get_set_argument(arguments, smallestIndex);
 
-                if (numArgs == 1)
-                {
-                    integerResult = (int32_t)-currentArg->value.real;
-                    realResult    = -currentArg->value.real;
-                }
-                else
-                {
-                    if (i == 0)
-                    {
-                        integerResult = (int32_t)currentArg->value.real;
-                        realResult    = currentArg->value.real;
-                    }
-                    else
-                    {
-                        integerResult -= (int32_t)(currentArg->value.real);
-                        realResult    -= currentArg->value.real;
-                    }
-                }
-            }
-            break;
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_set(vm);
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                if (currentArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+    if (!octaspire_dern_map_reserve(
+            result->value.set,
+            octaspire_dern_map_get_number_of_elements(smallest)))
+    {
+        abort();
+    }
 
-                    return currentArg;
-                }
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(smallest);
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    while (iter.element)
+    {
+        bool isInAll = true;
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '-' expects numeric arguments (integer or real). "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
+        for (size_t i = 0; i < numArgs && isInAll; ++i)
+        {
+            if (i == smallestIndex)
+            {
+                continue;
             }
+
+            isInAll = octaspire_dern_map_get_const(
+                octaspire_dern_vm_builtin_private_get_set_argument(arguments, i),
+                octaspire_dern_map_element_get_hash(iter.element),
+                octaspire_dern_map_element_get_key_const(iter.element)) != 0;
         }
-    }
 
-    if (allArgsAreIntegers)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_integer(vm, integerResult);
+        if (isInAll)
+        {
+            octaspire_dern_vm_builtin_private_set_put_element(result->value.set, iter.element);
+        }
+
+        octaspire_dern_map_element_const_iterator_next(&iter);
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return octaspire_dern_vm_create_new_value_real(vm, realResult);
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_textual(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_set_difference(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -9756,86 +14029,141 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_minus_textual(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_check_set_arguments(vm, arguments, "set-difference");
 
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
+    if (error)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return error;
+    }
 
-    octaspire_helpers_verify_not_null(firstArg);
-    octaspire_helpers_verify_true(firstArg->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
+
+    octaspire_dern_map_t *difference = octaspire_dern_map_new_copy(
+        octaspire_dern_vm_builtin_private_get_set_argument(arguments, 0),
+        allocator);
+
+    octaspire_helpers_verify_not_null(difference);
 
     for (size_t i = 1; i < numArgs; ++i)
     {
-        octaspire_dern_value_t *currentArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
+        octaspire_dern_map_t const * const other =
+            octaspire_dern_vm_builtin_private_get_set_argument(arguments, i);
 
-        octaspire_helpers_verify_not_null(currentArg);
-
-        switch (currentArg->typeTag)
+        if (octaspire_dern_map_get_number_of_elements(other) <=
+            octaspire_dern_map_get_number_of_elements(difference))
         {
-            case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+            // Elements of the smaller set are removed from the result.
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(other);
+
+            while (iter.element)
             {
-                abort();
+                octaspire_dern_map_remove(
+                    difference,
+                    octaspire_dern_map_element_get_hash(iter.element),
+                    octaspire_dern_map_element_get_key_const(iter.element));
+
+                octaspire_dern_map_element_const_iterator_next(&iter);
             }
+        }
+        else
+        {
+            // Elements of the smaller result are probed from the larger set.
+            octaspire_dern_map_t * const kept = octaspire_dern_map_new(allocator);
 
-            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            octaspire_helpers_verify_not_null(kept);
+
+            if (!octaspire_dern_map_reserve(
+                    kept,
+                    octaspire_dern_map_get_number_of_elements(difference)))
             {
-                octaspire_string_remove_all_substrings(
-                    firstArg->value.string,
-                    currentArg->value.string);
+                abort();
             }
-            break;
 
-            case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(difference);
+
+            while (iter.element)
             {
-                octaspire_string_remove_all_substrings(
-                    firstArg->value.string,
-                    currentArg->value.character);
+                if (!octaspire_dern_map_get_const(
+                        other,
+                        octaspire_dern_map_element_get_hash(iter.element),
+                        octaspire_dern_map_element_get_key_const(iter.element)))
+                {
+                    octaspire_dern_vm_builtin_private_set_put_element(kept, iter.element);
+                }
+
+                octaspire_dern_map_element_const_iterator_next(&iter);
             }
-            break;
 
-            // TODO Add symbol and maybe automatic conversion from number -> string
+            octaspire_dern_map_release(difference);
+            difference = kept;
+        }
+    }
 
-            case OCTASPIRE_DERN_VALUE_TAG_NIL:
-            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-            case OCTASPIRE_DERN_VALUE_TAG_REAL:
-            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-            case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_set(vm);
+
+    octaspire_dern_map_release(result->value.set);
+    result->value.set = difference;
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sorted_map(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
+
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    if (numArgs % 2 != 0)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'sorted-map' expects pairs of keys and values. "
+            "%zu arguments was given.",
+            numArgs);
+    }
+
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_sorted_map(vm);
+
+    octaspire_dern_vm_push_value(vm, result);
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "Builtin '-' expects textual arguments if the first argument is textual. "
-                    "%zuth argument has type %s.",
-                    i + 1,
-                    octaspire_dern_value_helper_get_type_as_c_string(currentArg->typeTag));
-            }
+    for (size_t i = 0; i < numArgs; i += 2)
+    {
+        octaspire_dern_value_t * const key =
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)i);
+
+        octaspire_dern_value_t * const value =
+            octaspire_dern_value_as_vector_get_element_at(arguments, (ptrdiff_t)(i + 1));
+
+        octaspire_helpers_verify_not_null(key);
+        octaspire_helpers_verify_not_null(value);
+
+        if (!octaspire_dern_value_as_sorted_map_put(result, key, value))
+        {
+            abort();
         }
     }
 
+    octaspire_dern_vm_pop_value(vm, result);
+
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    // TODO what to return? Count of removals or the modified string-value?
-    return firstArg;
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_plus(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sorted_map_question_mark(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -9845,122 +14173,105 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_plus(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs == 0)
+    if (numArgs != 1)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_builtin_private_plus_numerical(vm, arguments, environment);
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'sorted-map?' expects one argument.");
     }
 
-    octaspire_dern_value_t *firstArg =
+    octaspire_dern_value_t const * const value =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(firstArg);
-
-    switch (firstArg->typeTag)
-    {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return octaspire_dern_vm_create_new_value_boolean(
+        vm,
+        octaspire_dern_value_is_sorted_map(value));
+}
 
-            return octaspire_dern_vm_builtin_private_plus_textual_string(
-                vm,
-                arguments,
-                environment);
-        }
+// Checks that there are 'numRequired' arguments and that the first one is
+// a sorted map. Returns error value, or null if the arguments are valid.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_check_sorted_map_arguments(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    size_t const numRequired,
+    char const * const dernFuncName)
+{
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+    if (numArgs != numRequired)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects %zu arguments. %zu arguments was given.",
+            dernFuncName,
+            numRequired,
+            numArgs);
+    }
 
-            return octaspire_dern_vm_builtin_private_plus_textual_char(
-                vm,
-                arguments,
-                environment);
-        }
-        break;
+    octaspire_dern_value_t const * const sortedMapVal =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+    if (!octaspire_dern_value_is_sorted_map(sortedMapVal))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be sorted map. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(sortedMapVal->typeTag));
+    }
 
-            return octaspire_dern_vm_builtin_private_plus_textual_symbol(
-                vm,
-                arguments,
-                environment);
-        }
-        break;
+    return 0;
+}
 
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_sorted_map_floor_or_ceiling(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    bool const isFloor,
+    char const * const dernFuncName)
+{
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_check_sorted_map_arguments(
+            vm,
+            arguments,
+            2,
+            dernFuncName);
 
-            return octaspire_dern_vm_builtin_private_plus_semver(
-                vm,
-                arguments,
-                environment);
-        }
-        break;
+    if (error)
+    {
+        return error;
+    }
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_sorted_map_t const * const sortedMap =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0)->value.sortedMap;
 
-            return octaspire_dern_vm_builtin_private_plus_vector(
-                vm,
-                arguments,
-                environment);
-        }
-        break;
+    octaspire_dern_value_t const * const key =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
 
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        {
-            octaspire_helpers_verify_true(
-                stackLength == octaspire_dern_vm_get_stack_length(vm));
+    octaspire_dern_value_t *foundKey   = 0;
+    octaspire_dern_value_t *foundValue = 0;
 
-            return octaspire_dern_vm_builtin_private_plus_hash_map(
-                vm,
-                arguments,
-                environment);
-        }
-        break;
+    bool const found = isFloor ?
+        octaspire_dern_sorted_map_get_floor(sortedMap, key, &foundKey, &foundValue) :
+        octaspire_dern_sorted_map_get_ceiling(sortedMap, key, &foundKey, &foundValue);
 
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_builtin_private_plus_numerical(vm, arguments, environment);
-        }
+    if (!found)
+    {
+        return octaspire_dern_vm_get_value_nil(vm);
     }
 
-    abort();
-    return 0;
+    return octaspire_dern_vm_create_new_value_vector_from_values(
+        vm,
+        2,
+        foundKey,
+        foundValue);
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_minus(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sorted_map_floor(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -9970,67 +14281,39 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_minus(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    if (numArgs == 0)
-    {
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_builtin_private_minus_numerical(vm, arguments, environment);
-    }
-
-    octaspire_dern_value_t *firstArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(firstArg);
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_sorted_map_floor_or_ceiling(
+            vm,
+            arguments,
+            true,
+            "sorted-map-floor");
 
-    switch (firstArg->typeTag)
-    {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_builtin_private_minus_textual(vm, arguments, environment);
-        }
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sorted_map_ceiling(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_builtin_private_minus_semver(vm, arguments, environment);
-        }
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_builtin_private_minus_numerical(vm, arguments, environment);
-        }
-    }
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_builtin_private_sorted_map_floor_or_ceiling(
+            vm,
+            arguments,
+            false,
+            "sorted-map-ceiling");
 
-    abort();
-    return 0;
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_find(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_sorted_map_range(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -10040,73 +14323,54 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_find(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    octaspire_dern_vm_push_value(vm, arguments);
-    octaspire_dern_vm_push_value(vm, environment);
-
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    octaspire_dern_value_t * const error =
+        octaspire_dern_vm_builtin_private_check_sorted_map_arguments(
+            vm,
+            arguments,
+            3,
+            "sorted-map-range");
 
-    if (numArgs < 2)
+    if (error)
     {
-        octaspire_dern_vm_pop_value(vm, environment);
-        octaspire_dern_vm_pop_value(vm, arguments);
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
-            vm,
-            "Builtin 'find' expects at least two arguments. %zu arguments was given.",
-            numArgs);
+        return error;
     }
 
-    octaspire_dern_value_t *container = octaspire_dern_value_as_vector_get_element_at(arguments, 0);
-
-    octaspire_helpers_verify_not_null(container);
-
-    octaspire_dern_value_t *result = 0;
+    octaspire_dern_sorted_map_t const * const sortedMap =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0)->value.sortedMap;
 
-    if (numArgs > 2)
-    {
-        result = octaspire_dern_vm_create_new_value_vector(vm);
-        octaspire_dern_vm_push_value(vm, result);
+    octaspire_dern_value_t const * const first =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
 
-        for (size_t i = 1; i < numArgs; ++i)
-        {
-            octaspire_dern_value_t *keyArg =
-                octaspire_dern_value_as_vector_get_element_at(
-                    arguments,
-                    (ptrdiff_t)i);
+    octaspire_dern_value_t const * const last =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 2);
 
-            octaspire_helpers_verify_not_null(keyArg);
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_sorted_map(vm);
 
-            octaspire_dern_value_t *tmpVal =
-                octaspire_dern_vm_find_from_value(vm, container, keyArg);
+    octaspire_dern_vm_push_value(vm, result);
 
-            octaspire_dern_value_as_vector_push_back_element(
-                result,
-                &tmpVal);
-        }
+    // Elements are found by walking the linked leaves from the first key,
+    // and appended to the result in order, which fills its nodes fully.
+    octaspire_dern_sorted_map_iterator_t iter =
+        octaspire_dern_sorted_map_iterator_init_at_ceiling(sortedMap, first);
 
-        octaspire_dern_vm_pop_value(vm, result);
-        octaspire_dern_vm_pop_value(vm, environment);
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return result;
-    }
-    else
+    while (iter.key && octaspire_dern_value_compare(iter.key, last) <= 0)
     {
-        octaspire_dern_value_t *keyArg =
-            octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+        if (!octaspire_dern_value_as_sorted_map_put(result, iter.key, iter.value))
+        {
+            abort();
+        }
 
-        octaspire_helpers_verify_not_null(keyArg);
+        octaspire_dern_sorted_map_iterator_next(&iter);
+    }
 
-        result = octaspire_dern_vm_find_from_value(vm, container, keyArg);
+    octaspire_dern_vm_pop_value(vm, result);
 
-        octaspire_dern_vm_pop_value(vm, environment);
-        octaspire_dern_vm_pop_value(vm, arguments);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return result;
-    }
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_split(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_slice(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -10116,126 +14380,146 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_split(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs != 2)
+    if (numArgs < 1 || numArgs > 3)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-        return octaspire_dern_vm_create_new_value_error_format(
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
             vm,
-            "Builtin 'split' expects two arguments. %zu arguments was given.",
-            numArgs);
+            "Builtin 'string-slice' expects one to three arguments.");
     }
 
-    octaspire_dern_value_t *container =
+    octaspire_dern_value_t * const textVal =
         octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-    octaspire_helpers_verify_not_null(container);
+    octaspire_helpers_verify_not_null(textVal);
 
-    octaspire_dern_value_t *splitByArg =
-        octaspire_dern_value_as_vector_get_element_at(arguments, 1);
+    if (!octaspire_dern_value_is_string(textVal) &&
+        !octaspire_dern_value_is_string_slice(textVal))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'string-slice' expects string or string slice as first argument. "
+            "Now type '%s' was given.",
+            octaspire_dern_value_helper_get_type_as_c_string(textVal->typeTag));
+    }
 
-    octaspire_helpers_verify_not_null(splitByArg);
+    bool const isSlice = octaspire_dern_value_is_string_slice(textVal);
 
-    switch (container->typeTag)
+    char const * const octets = isSlice ?
+        octaspire_dern_value_as_string_slice_get_octets(textVal) :
+        octaspire_string_get_c_string(textVal->value.string);
+
+    size_t const numOctets = isSlice ?
+        octaspire_dern_value_as_string_slice_get_length_in_octets(textVal) :
+        octaspire_string_get_length_in_octets(textVal->value.string);
+
+    int32_t const length = (int32_t)octaspire_dern_value_get_length(textVal);
+
+    // Start index and number of characters.
+    int32_t bounds[2] = {0, length};
+
+    for (size_t i = 1; i < numArgs; ++i)
     {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
-        {
-            abort();
-        }
+        octaspire_dern_value_t const * const boundVal =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, (ptrdiff_t)i);
 
-        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        octaspire_helpers_verify_not_null(boundVal);
+
+        if (!octaspire_dern_value_is_integer(boundVal))
         {
-            if (!octaspire_dern_value_is_character(splitByArg))
-            {
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin 'string-slice' expects integer as %s argument. "
+                "Now type '%s' was given.",
+                (i == 1) ? "second" : "third",
+                octaspire_dern_value_helper_get_type_as_c_string(boundVal->typeTag));
+        }
 
-                return octaspire_dern_vm_create_new_value_error_format(
-                    vm,
-                    "The second argument to builtin 'split' must be a character when the first "
-                    "is a string. Type '%s' was given.",
-                    octaspire_dern_value_helper_get_type_as_c_string(splitByArg->typeTag));
-            }
+        bounds[i - 1] = boundVal->value.integer;
+    }
 
-            octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_vector(vm);
-            octaspire_helpers_verify_not_null(result);
+    if (numArgs < 3)
+    {
+        bounds[1] = length - bounds[0];
+    }
 
-            octaspire_dern_vm_push_value(vm, result);
+    if (bounds[0] < 0 || bounds[0] > length)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Index %" PRId32 " to builtin 'string-slice' is not valid for text of "
+            "%" PRId32 " characters.",
+            bounds[0],
+            length);
+    }
 
-            octaspire_string_t *containerAsStr = container->value.string;
-            octaspire_helpers_verify_not_null(containerAsStr);
+    if (bounds[1] < 0 || bounds[1] > length - bounds[0])
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin 'string-slice' cannot take %" PRId32 " characters starting at index "
+            "%" PRId32 " from text of %" PRId32 " characters.",
+            bounds[1],
+            bounds[0],
+            length);
+    }
 
-            octaspire_vector_t *tokens = octaspire_string_split(
-                containerAsStr,
-                octaspire_dern_value_as_character_get_c_string(splitByArg));
+    size_t const octetIndex = octaspire_dern_helpers_get_octet_index_of_ucs_index(
+        octets,
+        numOctets,
+        (size_t)bounds[0]);
 
-            octaspire_helpers_verify_not_null(tokens);
+    size_t const octetEnd = octetIndex + octaspire_dern_helpers_get_octet_index_of_ucs_index(
+        octets + octetIndex,
+        numOctets - octetIndex,
+        (size_t)bounds[1]);
 
-            for (size_t i = 0; i < octaspire_vector_get_length(tokens); ++i)
-            {
-                octaspire_string_t const * const token =
-                    (octaspire_string_t const * const)
-                        octaspire_vector_get_element_at(
-                            tokens,
-                            (ptrdiff_t)i);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                octaspire_helpers_verify_not_null(token);
+    return octaspire_dern_vm_create_new_value_string_slice(
+        vm,
+        textVal,
+        octetIndex,
+        octetEnd - octetIndex);
+}
 
-                octaspire_string_t * const copy =
-                    octaspire_string_new_copy(
-                        token,
-                        octaspire_dern_vm_get_allocator(vm));
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_slice_question_mark(
+    octaspire_dern_vm_t *vm,
+    octaspire_dern_value_t *arguments,
+    octaspire_dern_value_t *environment)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(vm);
 
-                octaspire_dern_value_t * const copyVal = octaspire_dern_vm_create_new_value_string(
-                    vm,
-                    copy);
+    octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
+    octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-                octaspire_dern_value_as_vector_push_back_element(result, &copyVal);
-            }
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-            octaspire_vector_release(tokens);
-            tokens = 0;
+    if (numArgs != 1)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            vm,
+            "Builtin 'string-slice?' expects one argument.");
+    }
 
-            octaspire_dern_vm_pop_value(vm, result);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return result;
-        }
+    octaspire_dern_value_t const * const value =
+        octaspire_dern_value_as_vector_get_element_at(arguments, 0);
 
-        case OCTASPIRE_DERN_VALUE_TAG_NIL:
-        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
-        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
-        case OCTASPIRE_DERN_VALUE_TAG_REAL:
-        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
-        {
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_format(
-                vm,
-                "The first argument to builtin 'split' must be a container. Currently only "
-                "strings are supported. Type '%s' was given.",
-                octaspire_dern_value_helper_get_type_as_c_string(container->typeTag));
-        }
-    }
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-    abort();
-    return 0;
+    return octaspire_dern_vm_create_new_value_boolean(
+        vm,
+        octaspire_dern_value_is_string_slice(value));
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_builtin_hash_map(
+octaspire_dern_value_t *octaspire_dern_vm_builtin_string_slice_to_string(
     octaspire_dern_vm_t *vm,
     octaspire_dern_value_t *arguments,
     octaspire_dern_value_t *environment)
@@ -10245,54 +14529,44 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_hash_map(
     octaspire_helpers_verify_true(arguments->typeTag   == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_true(environment->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
 
-    size_t const numArgs = octaspire_dern_value_get_length(arguments);
-
-    octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_hash_map(vm);
-    octaspire_dern_vm_push_value(vm, result);
+    char   const * const dernFuncName = "string-slice-to-string";
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    for (size_t i = 0; i < numArgs; i += 2)
+    if (numArgs != 1)
     {
-        octaspire_dern_value_t *keyArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)i);
-
-        if (!keyArg)
-        {
-            octaspire_dern_vm_pop_value(vm, result);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_from_c_string(
-                vm,
-                "Builtin 'hash-map' expects key here.");
-        }
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects one argument. "
+            "%zu arguments were given.",
+            dernFuncName,
+            numArgs);
+    }
 
-        octaspire_dern_value_t *valArg =
-            octaspire_dern_value_as_vector_get_element_at(
-                arguments,
-                (ptrdiff_t)(i + 1));
+    octaspire_dern_value_t const * const sliceArg =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
 
-        if (!valArg)
-        {
-            octaspire_dern_vm_pop_value(vm, result);
-            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_error_from_c_string(
-                vm,
-                "Builtin 'hash-map' expects key here.");
-        }
+    octaspire_helpers_verify_not_null(sliceArg);
 
-        if (!octaspire_dern_value_as_hash_map_put(
-            result,
-            octaspire_dern_value_get_hash(keyArg),
-            keyArg,
-            valArg))
-        {
-            abort();
-        }
+    if (!octaspire_dern_value_is_string_slice(sliceArg))
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "First argument to builtin '%s' must be string slice. Type '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_helper_get_type_as_c_string(sliceArg->typeTag));
     }
 
-    octaspire_dern_vm_pop_value(vm, result);
+    octaspire_string_t * const str = octaspire_string_new_from_buffer(
+        octaspire_dern_value_as_string_slice_get_octets(sliceArg),
+        octaspire_dern_value_as_string_slice_get_length_in_octets(sliceArg),
+        octaspire_dern_vm_get_allocator(vm));
+
+    octaspire_helpers_verify_not_null(str);
+
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return octaspire_dern_vm_create_new_value_string(vm, str);
 }
 
 octaspire_dern_value_t *octaspire_dern_vm_builtin_queue(
@@ -10548,7 +14822,10 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
 
     octaspire_helpers_verify_not_null(fileName);
 
-    octaspire_input_t *input = 0;
+    // Custom pre-loader gives an input. Files are read form by form with
+    // a reader, that maps them into memory when it can.
+    octaspire_input_t       *input  = 0;
+    octaspire_dern_reader_t *reader = 0;
 
     if (octaspire_dern_vm_get_custom_require_source_file_pre_loader(vm))
     {
@@ -10590,15 +14867,15 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
 
                 octaspire_helpers_verify_not_null(newPath);
 
-                input = octaspire_input_new_from_path(
+                reader = octaspire_dern_reader_new_from_path(
                     octaspire_string_get_c_string(newPath),
-                    octaspire_dern_vm_get_allocator(vm),
-                    octaspire_dern_vm_get_stdio(vm));
+                    octaspire_dern_vm_get_stdio(vm),
+                    octaspire_dern_vm_get_allocator(vm));
 
                 octaspire_string_release(newPath);
                 newPath = 0;
 
-                if (input)
+                if (reader)
                 {
                     break;
                 }
@@ -10606,14 +14883,14 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
         }
         else
         {
-            input = octaspire_input_new_from_path(
+            reader = octaspire_dern_reader_new_from_path(
                 octaspire_string_get_c_string(fileName),
-                octaspire_dern_vm_get_allocator(vm),
-                octaspire_dern_vm_get_stdio(vm));
+                octaspire_dern_vm_get_stdio(vm),
+                octaspire_dern_vm_get_allocator(vm));
         }
     }
 
-    if (!input)
+    if (!input && !reader)
     {
         octaspire_string_release(fileName);
         fileName = 0;
@@ -10622,11 +14899,17 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
         return 0;
     }
 
-    octaspire_dern_lib_t *library = octaspire_dern_lib_new_source(
-        name,
-        input,
-        vm,
-        octaspire_dern_vm_get_allocator(vm));
+    octaspire_dern_lib_t *library = input ?
+        octaspire_dern_lib_new_source(
+            name,
+            input,
+            vm,
+            octaspire_dern_vm_get_allocator(vm)) :
+        octaspire_dern_lib_new_source_from_reader(
+            name,
+            reader,
+            vm,
+            octaspire_dern_vm_get_allocator(vm));
 
     octaspire_helpers_verify_not_null(library);
 
@@ -10646,6 +14929,9 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
         octaspire_input_release(input);
         input = 0;
 
+        octaspire_dern_reader_release(reader);
+        reader = 0;
+
         octaspire_dern_lib_release(library);
         library = 0;
 
@@ -10656,6 +14942,9 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_source_file(
     octaspire_input_release(input);
     input = 0;
 
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
     if (!octaspire_dern_vm_add_library(vm, name, library))
     {
         abort();
@@ -10756,10 +15045,92 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_private_require_binary_file(
 
     octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_string(vm, fileName);
 
-    octaspire_helpers_verify_not_null(result);
+    octaspire_helpers_verify_not_null(result);
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+    return result;
+}
+
+// Finds the element for 'ln@' and 'cp@' from a sorted map. The second
+// argument is a key or, with symbol 'index' as the third argument, an
+// index in key order. Returns error value if the element is not found.
+static octaspire_dern_value_t *octaspire_dern_vm_builtin_private_sorted_map_get(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    char const * const dernFuncName)
+{
+    size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
+
+    octaspire_dern_value_t const * const collectionVal =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 0);
+
+    octaspire_dern_value_t const * const symbolVal = (numArgs == 3) ?
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 2) :
+        0;
+
+    if (numArgs > 3 || (symbolVal && !octaspire_dern_value_is_symbol(symbolVal)))
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects a key and optionally symbol 'key' or 'index' "
+            "when used with sorted map.",
+            dernFuncName);
+    }
+
+    octaspire_dern_value_t const * const keyVal =
+        octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
+
+    octaspire_helpers_verify_not_null(keyVal);
+
+    octaspire_dern_value_t *element = 0;
+    bool                    found   = false;
+
+    if (symbolVal && octaspire_dern_value_as_text_is_equal_to_c_string(symbolVal, "index"))
+    {
+        if (!octaspire_dern_value_is_integer(keyVal))
+        {
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin '%s' expects integer as second argument when indexing a "
+                "sorted map with given symbol 'index'. Now type '%s' was given.",
+                dernFuncName,
+                octaspire_dern_value_helper_get_type_as_c_string(keyVal->typeTag));
+        }
+
+        found = octaspire_dern_sorted_map_get_at_index(
+            collectionVal->value.sortedMap,
+            (ptrdiff_t)octaspire_dern_value_as_integer_get_value(keyVal),
+            0,
+            &element);
+    }
+    else if (!symbolVal ||
+             octaspire_dern_value_as_text_is_equal_to_c_string(symbolVal, "key"))
+    {
+        found = octaspire_dern_sorted_map_get(
+            collectionVal->value.sortedMap,
+            keyVal,
+            0,
+            &element);
+    }
+    else
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' expects symbol 'key' or 'index' as third argument when "
+            "indexing a sorted map. Now symbol '%s' was given.",
+            dernFuncName,
+            octaspire_dern_value_as_text_get_c_string(symbolVal));
+    }
+
+    if (!found)
+    {
+        return octaspire_dern_vm_create_new_value_error_format(
+            vm,
+            "Builtin '%s' could not find the requested element from sorted map.",
+            dernFuncName);
+    }
 
-    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-    return result;
+    return element;
 }
 
 octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
@@ -10804,6 +15175,16 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
                 "Builtin 'ln@' cannot be used with strings. Use 'cp@' instead.");
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_error_from_c_string(
+                vm,
+                "Builtin 'ln@' cannot be used with string slices. Use 'string-slice' instead.");
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
             if (numArgs > 2)
@@ -10873,22 +15254,304 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
                     "Builtin 'ln@' expects exactly three arguments when used with hash map.");
             }
 
-            octaspire_dern_value_t const * const symbolVal =
-                octaspire_dern_value_as_vector_get_element_at_const(arguments, 2);
+            octaspire_dern_value_t const * const symbolVal =
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 2);
+
+            octaspire_helpers_verify_not_null(symbolVal);
+
+            if (!octaspire_dern_value_is_symbol(symbolVal))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'ln@' expects symbol as third argument when indexing a hash map. "
+                    "Now type '%s' was given.",
+                    octaspire_dern_value_helper_get_type_as_c_string(
+                        symbolVal->typeTag));
+            }
+
+            octaspire_dern_value_t const * const indexVal =
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
+
+            octaspire_helpers_verify_not_null(indexVal);
+
+            if (octaspire_dern_value_as_text_is_equal_to_c_string(
+                    symbolVal,
+                    "index"))
+            {
+                if (!octaspire_dern_value_is_integer(indexVal))
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_format(
+                        vm,
+                        "Builtin 'ln@' expects integer as second argument when indexing a hash "
+                        "map with given symbol 'index'. "
+                        "Now type '%s' was given.",
+                        octaspire_dern_value_helper_get_type_as_c_string(
+                            indexVal->typeTag));
+                }
+
+                octaspire_dern_map_element_t * const element =
+                    octaspire_dern_value_as_hash_map_get_at_index(
+                        collectionVal,
+                        octaspire_dern_value_as_integer_get_value(indexVal));
+
+                if (!element)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin 'ln@' could not find the requested element from hash map.");
+
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_map_element_get_value(element);
+            }
+            else if (octaspire_dern_value_as_text_is_equal_to_c_string(
+                    symbolVal,
+                    "hash"))
+            {
+                octaspire_dern_map_element_t * const element =
+                    octaspire_dern_value_as_hash_map_get(
+                        collectionVal,
+                        octaspire_dern_value_get_hash(indexVal),
+                        indexVal);
+
+                if (!element)
+                {
+                    octaspire_helpers_verify_true(
+                        stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                    return octaspire_dern_vm_create_new_value_error_from_c_string(
+                        vm,
+                        "Builtin 'ln@' could not find the requested element from hash map.");
+
+                }
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_map_element_get_value(element);
+            }
+            else
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'ln@' expects symbol 'hash' or 'index' as third argument when "
+                    "indexing a hash map. "
+                    "Now symbol '%s' was given.",
+                    octaspire_dern_value_as_text_get_c_string(symbolVal));
+            }
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            if (numArgs > 2)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin 'ln@' expects exactly two arguments when used with "
+                    "persistent vector.");
+            }
+
+            octaspire_dern_value_t const * const indexVal =
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
+
+            octaspire_helpers_verify_not_null(indexVal);
+
+            if (!octaspire_dern_value_is_integer(indexVal))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'ln@' expects integer as second argument when indexing a "
+                    "persistent vector. Now type '%s' was given.",
+                    octaspire_dern_value_helper_get_type_as_c_string(
+                        indexVal->typeTag));
+            }
+
+            ptrdiff_t const index =
+                (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal);
+
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_persistent_vector_get_element_at(
+                    collectionVal,
+                    index);
+
+            if (!element)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin 'ln@' is not valid for the given persistent vector. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    index);
+            }
+
+            // Atoms are not linked, so that no version can be changed through the result.
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_persistent_element(vm, element);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            if (numArgs > 2)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin 'ln@' expects exactly two arguments when used with "
+                    "typed array.");
+            }
+
+            octaspire_dern_value_t const * const indexVal =
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
+
+            octaspire_helpers_verify_not_null(indexVal);
+
+            if (!octaspire_dern_value_is_integer(indexVal))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'ln@' expects integer as second argument when indexing a "
+                    "typed array. Now type '%s' was given.",
+                    octaspire_dern_value_helper_get_type_as_c_string(
+                        indexVal->typeTag));
+            }
+
+            ptrdiff_t const index =
+                (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal);
+
+            // The element is read into a new number value.
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_typed_array_get_element_at(
+                    collectionVal,
+                    index);
+
+            if (!element)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin 'ln@' is not valid for the given typed array. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    index);
+            }
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return element;
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            if (numArgs > 2)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin 'ln@' expects exactly two arguments when used with "
+                    "bytes.");
+            }
+
+            octaspire_dern_value_t const * const indexVal =
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
+
+            octaspire_helpers_verify_not_null(indexVal);
+
+            if (!octaspire_dern_value_is_integer(indexVal))
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'ln@' expects integer as second argument when indexing "
+                    "bytes. Now type '%s' was given.",
+                    octaspire_dern_value_helper_get_type_as_c_string(
+                        indexVal->typeTag));
+            }
+
+            ptrdiff_t const index =
+                (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal);
+
+            // The octet is read into a new integer value.
+            octaspire_dern_value_t * const element =
+                octaspire_dern_value_as_bytes_get_element_at(
+                    collectionVal,
+                    index);
+
+            if (!element)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin 'ln@' is not valid for the given bytes. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    index);
+            }
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return element;
+        }
 
-            octaspire_helpers_verify_not_null(symbolVal);
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        {
+            // Without the third argument the second one is a key.
+            octaspire_dern_value_t const * const symbolVal = (numArgs == 3) ?
+                octaspire_dern_value_as_vector_get_element_at_const(arguments, 2) :
+                0;
 
-            if (!octaspire_dern_value_is_symbol(symbolVal))
+            if (numArgs > 3 || (symbolVal && !octaspire_dern_value_is_symbol(symbolVal)))
             {
                 octaspire_helpers_verify_true(
                     stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_error_format(
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
                     vm,
-                    "Builtin 'ln@' expects symbol as third argument when indexing a hash map. "
-                    "Now type '%s' was given.",
-                    octaspire_dern_value_helper_get_type_as_c_string(
-                        symbolVal->typeTag));
+                    "Builtin 'ln@' expects a key and optionally symbol 'hash' or 'index' "
+                    "when used with persistent hash map.");
             }
 
             octaspire_dern_value_t const * const indexVal =
@@ -10896,9 +15559,11 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
 
             octaspire_helpers_verify_not_null(indexVal);
 
-            if (octaspire_dern_value_as_text_is_equal_to_c_string(
-                    symbolVal,
-                    "index"))
+            octaspire_dern_value_t *key     = 0;
+            octaspire_dern_value_t *element = 0;
+
+            if (symbolVal &&
+                octaspire_dern_value_as_text_is_equal_to_c_string(symbolVal, "index"))
             {
                 if (!octaspire_dern_value_is_integer(indexVal))
                 {
@@ -10907,59 +15572,25 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
 
                     return octaspire_dern_vm_create_new_value_error_format(
                         vm,
-                        "Builtin 'ln@' expects integer as second argument when indexing a hash "
-                        "map with given symbol 'index'. "
+                        "Builtin 'ln@' expects integer as second argument when indexing a "
+                        "persistent hash map with given symbol 'index'. "
                         "Now type '%s' was given.",
                         octaspire_dern_value_helper_get_type_as_c_string(
                             indexVal->typeTag));
                 }
 
-                octaspire_map_element_t * const element =
-                    octaspire_dern_value_as_hash_map_get_at_index(
-                        collectionVal,
-                        octaspire_dern_value_as_integer_get_value(indexVal));
-
-                if (!element)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin 'ln@' could not find the requested element from hash map.");
-
-                }
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return octaspire_map_element_get_value(element);
+                octaspire_dern_value_as_persistent_hash_map_get_at_index(
+                    collectionVal,
+                    (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal),
+                    &key,
+                    &element);
             }
-            else if (octaspire_dern_value_as_text_is_equal_to_c_string(
-                    symbolVal,
-                    "hash"))
+            else if (!symbolVal ||
+                     octaspire_dern_value_as_text_is_equal_to_c_string(symbolVal, "hash"))
             {
-                octaspire_map_element_t * const element =
-                    octaspire_dern_value_as_hash_map_get(
-                        collectionVal,
-                        octaspire_dern_value_get_hash(indexVal),
-                        indexVal);
-
-                if (!element)
-                {
-                    octaspire_helpers_verify_true(
-                        stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                    return octaspire_dern_vm_create_new_value_error_from_c_string(
-                        vm,
-                        "Builtin 'ln@' could not find the requested element from hash map.");
-
-                }
-
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(vm));
-
-                return octaspire_map_element_get_value(element);
+                element = octaspire_dern_value_as_persistent_hash_map_get(
+                    collectionVal,
+                    indexVal);
             }
             else
             {
@@ -10969,27 +15600,47 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
                 return octaspire_dern_vm_create_new_value_error_format(
                     vm,
                     "Builtin 'ln@' expects symbol 'hash' or 'index' as third argument when "
-                    "indexing a hash map. "
+                    "indexing a persistent hash map. "
                     "Now symbol '%s' was given.",
                     octaspire_dern_value_as_text_get_c_string(symbolVal));
             }
+
+            if (!element)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                    vm,
+                    "Builtin 'ln@' could not find the requested element from "
+                    "persistent hash map.");
+            }
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_persistent_element(vm, element);
         }
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
         {
-            abort();
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_builtin_private_sorted_map_get(vm, arguments, "ln@");
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         {
+            char const * const typeName =
+                (collectionVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE) ? "queue" : "list";
+
             if (numArgs > 2)
             {
                 octaspire_helpers_verify_true(
                     stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                return octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    "Builtin 'ln@' expects exactly two arguments when used with list.");
+                    "Builtin 'ln@' expects exactly two arguments when used with %s.",
+                    typeName);
             }
 
             octaspire_dern_value_t const * const indexVal =
@@ -11004,16 +15655,39 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
 
                 return octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    "Builtin 'ln@' expects integer as second argument when indexing a list. "
+                    "Builtin 'ln@' expects integer as second argument when indexing a %s. "
                     "Now type '%s' was given.",
+                    typeName,
                     octaspire_dern_value_helper_get_type_as_c_string(
                         indexVal->typeTag));
             }
 
+            ptrdiff_t const index =
+                (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal);
+
+            // Both are deques, that find an element by index in constant time.
+            octaspire_dern_value_t * const result =
+                (collectionVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE) ?
+                    octaspire_dern_value_as_queue_get_element_at(collectionVal, index) :
+                    octaspire_dern_value_as_list_get_element_at(collectionVal, index);
+
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_value_as_list_get_element_at(
-                collectionVal,
-                octaspire_dern_value_as_integer_get_value(indexVal));
+
+            if (!result)
+            {
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin 'ln@' is not valid for the given %s. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    typeName,
+                    index);
+            }
+
+            return result;
         }
 
         case OCTASPIRE_DERN_VALUE_TAG_NIL:
@@ -11030,7 +15704,10 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_ln_at_sign(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
@@ -11081,6 +15758,91 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
             abort();
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            if (numArgs > 2)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin '%s' expects exactly two arguments when used with string slice.",
+                    dernFuncName);
+            }
+
+            octaspire_dern_number_or_unpushed_error_const_t const numberOrError =
+                octaspire_dern_value_as_vector_get_element_at_as_number_or_unpushed_error_const(
+                    arguments,
+                    1,
+                    dernFuncName);
+
+            if (numberOrError.unpushedError)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return numberOrError.unpushedError;
+            }
+
+            ptrdiff_t const length = (ptrdiff_t)
+                octaspire_dern_value_as_string_slice_get_length_in_ucs_characters(collectionVal);
+
+            ptrdiff_t index = numberOrError.number;
+
+            if (index < 0)
+            {
+                index += length;
+            }
+
+            if (index < 0 || index >= length)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin '%s' is not valid for the given string slice. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    dernFuncName,
+                    numberOrError.number);
+            }
+
+            char const * const octets =
+                octaspire_dern_value_as_string_slice_get_octets(collectionVal);
+
+            size_t const numOctets =
+                octaspire_dern_value_as_string_slice_get_length_in_octets(collectionVal);
+
+            size_t const octetIndex = octaspire_dern_helpers_get_octet_index_of_ucs_index(
+                octets,
+                numOctets,
+                (size_t)index);
+
+            uint32_t character = 0;
+            int      numCharOctets = 0;
+
+            if (octaspire_utf8_decode_character(
+                    octets + octetIndex,
+                    numOctets - octetIndex,
+                    &character,
+                    &numCharOctets) != OCTASPIRE_UTF8_DECODE_STATUS_OK)
+            {
+                abort();
+            }
+
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_vm_create_new_value_character_from_uint32t(
+                vm,
+                character);
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_STRING:
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         {
@@ -11449,7 +16211,7 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
                             indexVal->typeTag));
                 }
 
-                octaspire_map_element_t * const element =
+                octaspire_dern_map_element_t * const element =
                     octaspire_dern_value_as_hash_map_get_at_index(
                         collectionVal,
                         octaspire_dern_value_as_integer_get_value(indexVal));
@@ -11470,13 +16232,13 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
 
                 return octaspire_dern_vm_create_new_value_copy(
                     vm,
-                    octaspire_map_element_get_value(element));
+                    octaspire_dern_map_element_get_value(element));
             }
             else if (octaspire_dern_value_as_text_is_equal_to_c_string(
                     symbolVal,
                     "hash"))
             {
-                octaspire_map_element_t * const element =
+                octaspire_dern_map_element_t * const element =
                     octaspire_dern_value_as_hash_map_get(
                         collectionVal,
                         octaspire_dern_value_get_hash(indexVal),
@@ -11498,7 +16260,7 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
 
                 return octaspire_dern_vm_create_new_value_copy(
                     vm,
-                    octaspire_map_element_get_value(element));
+                    octaspire_dern_map_element_get_value(element));
             }
             else
             {
@@ -11513,21 +16275,33 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
             }
         }
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
         {
-            abort();
+            octaspire_dern_value_t * const element =
+                octaspire_dern_vm_builtin_private_sorted_map_get(vm, arguments, dernFuncName);
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+            return octaspire_dern_value_is_error(element) ?
+                element :
+                octaspire_dern_vm_create_new_value_copy(vm, element);
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         {
+            char const * const typeName =
+                (collectionVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE) ? "queue" : "list";
+
             if (numArgs > 2)
             {
                 octaspire_helpers_verify_true(
                     stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_error_from_c_string(
+                return octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    "Builtin 'cp@' expects exactly two arguments when used with list.");
+                    "Builtin 'cp@' expects exactly two arguments when used with %s.",
+                    typeName);
             }
 
             octaspire_dern_value_t const * const indexVal =
@@ -11542,18 +16316,38 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
 
                 return octaspire_dern_vm_create_new_value_error_format(
                     vm,
-                    "Builtin 'cp@' expects integer as second argument when indexing a list. "
+                    "Builtin 'cp@' expects integer as second argument when indexing a %s. "
                     "Now type '%s' was given.",
+                    typeName,
                     octaspire_dern_value_helper_get_type_as_c_string(
                         indexVal->typeTag));
             }
 
+            ptrdiff_t const index =
+                (ptrdiff_t)octaspire_dern_value_as_integer_get_value(indexVal);
+
+            octaspire_dern_value_t * const element =
+                (collectionVal->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE) ?
+                    octaspire_dern_value_as_queue_get_element_at(collectionVal, index) :
+                    octaspire_dern_value_as_list_get_element_at(collectionVal, index);
+
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
-            return octaspire_dern_vm_create_new_value_copy(
-                vm,
-                octaspire_dern_value_as_list_get_element_at(
-                    collectionVal,
-                    octaspire_dern_value_as_integer_get_value(indexVal)));
+
+            if (!element)
+            {
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Index to builtin 'cp@' is not valid for the given %s. "
+#ifdef __AROS__
+                    "Index '%ld' was given.",
+#else
+                    "Index '%td' was given.",
+#endif
+                    typeName,
+                    index);
+            }
+
+            return octaspire_dern_vm_create_new_value_copy(vm, element);
         }
 
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
@@ -11686,6 +16480,13 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_cp_at_sign(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
@@ -12187,6 +16988,14 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
+            if (numArgs == 1)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_copy(vm, collectionVal);
+            }
+
             octaspire_vector_t * const copyVec =
                 octaspire_vector_new(
                     sizeof(octaspire_dern_value_t*),
@@ -12280,17 +17089,10 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_copy(
         {
             if (numArgs == 1)
             {
-                octaspire_string_t * const copyStr =
-                    octaspire_string_new_copy(
-                        collectionVal->value.string,
-                        octaspire_dern_vm_get_allocator(vm));
-
-                octaspire_helpers_verify_not_null(copyStr);
-
                 octaspire_helpers_verify_true(
                     stackLength == octaspire_dern_vm_get_stack_length(vm));
 
-                return octaspire_dern_vm_create_new_value_string(vm, copyStr);
+                return octaspire_dern_vm_create_new_value_copy(vm, collectionVal);
             }
 
             octaspire_string_t * const copyStr =
@@ -12448,13 +17250,78 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_copy(
             }
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            if (numArgs == 1)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_copy(vm, collectionVal);
+            }
+            else
+            {
+                octaspire_helpers_verify_true(stackLength ==
+                        octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'copy' expects one argument when used with hash map. "
+                    "%zu arguments was given.",
+                    numArgs);
+            }
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            if (numArgs == 1)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_copy(vm, collectionVal);
+            }
+            else
+            {
+                octaspire_helpers_verify_true(stackLength ==
+                        octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'copy' expects one argument when used with set. "
+                    "%zu arguments was given.",
+                    numArgs);
+            }
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            if (numArgs == 1)
+            {
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_copy(vm, collectionVal);
+            }
+            else
+            {
+                octaspire_helpers_verify_true(stackLength ==
+                        octaspire_dern_vm_get_stack_length(vm));
+
+                return octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'copy' expects one argument when used with sorted map. "
+                    "%zu arguments was given.",
+                    numArgs);
+            }
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_NIL:
         case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
         case OCTASPIRE_DERN_VALUE_TAG_REAL:
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         case OCTASPIRE_DERN_VALUE_TAG_ERROR:
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
         case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
@@ -12464,6 +17331,13 @@ octaspire_dern_value_t *octaspire_dern_vm_builtin_copy(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
             return octaspire_dern_vm_create_new_value_error_format(
@@ -12593,11 +17467,11 @@ bool octaspire_dern_stdlib_private_special_howto_helper(
 
     for (size_t i = 0; i < octaspire_dern_environment_get_length(actualEnv); ++i)
     {
-        octaspire_map_element_t * const element =
+        octaspire_dern_map_element_t * const element =
             octaspire_dern_environment_get_at_index(actualEnv, i);
 
         octaspire_dern_value_t * const value =
-            octaspire_map_element_get_value(element);
+            octaspire_dern_map_element_get_value(element);
 
         if (octaspire_dern_value_is_builtin(value) ||
             octaspire_dern_value_is_special(value) ||
@@ -0,0 +1,940 @@
+/******************************************************************************
+Octaspire Dern - Programming language
+Copyright 2017 www.octaspire.com
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+******************************************************************************/
+#include "octaspire/dern/octaspire_dern_typed_array.h"
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef OCTASPIRE_DERN_DO_NOT_USE_AMALGAMATED_CORE
+    #include "octaspire-core-amalgamated.c"
+#else
+    #include <octaspire/core/octaspire_helpers.h>
+#endif
+
+#include "octaspire/dern/octaspire_dern_helpers.h"
+
+struct octaspire_dern_typed_array_t
+{
+    void                                      *data;
+    octaspire_allocator_t                     *allocator;
+    size_t                                     length;
+    size_t                                     capacity;
+    octaspire_dern_typed_array_element_type_t  elementType;
+    char                                       padding[4];
+};
+
+static size_t octaspire_dern_typed_array_private_get_element_size(
+    octaspire_dern_typed_array_element_type_t const elementType)
+{
+    switch (elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64: return sizeof(double);
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32: return sizeof(float);
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64: return sizeof(int64_t);
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32: return sizeof(int32_t);
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:  return sizeof(uint8_t);
+    }
+
+    abort();
+    return 0;
+}
+
+// Conversions from real numbers into integer elements saturate at the
+// limits of the element type and turn NaN into zero.
+static int64_t octaspire_dern_typed_array_private_real_to_i64(double const value)
+{
+    if (isnan(value))
+    {
+        return 0;
+    }
+
+    if (value >= 9223372036854775807.0)
+    {
+        return INT64_MAX;
+    }
+
+    if (value <= -9223372036854775808.0)
+    {
+        return INT64_MIN;
+    }
+
+    return (int64_t)value;
+}
+
+static int32_t octaspire_dern_typed_array_private_real_to_i32(double const value)
+{
+    if (isnan(value))
+    {
+        return 0;
+    }
+
+    if (value >= (double)INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+
+    if (value <= (double)INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+
+    return (int32_t)value;
+}
+
+static uint8_t octaspire_dern_typed_array_private_real_to_u8(double const value)
+{
+    if (isnan(value) || value <= 0)
+    {
+        return 0;
+    }
+
+    if (value >= (double)UINT8_MAX)
+    {
+        return UINT8_MAX;
+    }
+
+    return (uint8_t)value;
+}
+
+octaspire_dern_typed_array_t *octaspire_dern_typed_array_new(
+    octaspire_dern_typed_array_element_type_t const elementType,
+    size_t const length,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_typed_array_t * const self =
+        octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_typed_array_t));
+
+    if (!self)
+    {
+        return self;
+    }
+
+    memset(self, 0, sizeof(octaspire_dern_typed_array_t));
+    self->allocator   = allocator;
+    self->elementType = elementType;
+
+    if (length > 0)
+    {
+        size_t const numOctets =
+            length * octaspire_dern_typed_array_private_get_element_size(elementType);
+
+        self->data = octaspire_allocator_malloc(allocator, numOctets);
+
+        if (!self->data)
+        {
+            octaspire_allocator_free(allocator, self);
+            return 0;
+        }
+
+        memset(self->data, 0, numOctets);
+        self->length   = length;
+        self->capacity = length;
+    }
+
+    return self;
+}
+
+octaspire_dern_typed_array_t *octaspire_dern_typed_array_new_copy(
+    octaspire_dern_typed_array_t const * const other,
+    octaspire_dern_typed_array_element_type_t const elementType,
+    octaspire_allocator_t * const allocator)
+{
+    octaspire_dern_typed_array_t * const self =
+        octaspire_dern_typed_array_new(elementType, other->length, allocator);
+
+    if (!self)
+    {
+        return self;
+    }
+
+    if (elementType == other->elementType)
+    {
+        if (other->length > 0)
+        {
+            memcpy(
+                self->data,
+                other->data,
+                other->length *
+                    octaspire_dern_typed_array_private_get_element_size(elementType));
+        }
+
+        return self;
+    }
+
+    // Integer elements are converted with wrap around,
+    // real elements with saturation.
+    bool const otherIsInteger =
+        octaspire_dern_typed_array_element_type_is_integer(other->elementType);
+
+    for (size_t i = 0; i < other->length; ++i)
+    {
+        if (otherIsInteger)
+        {
+            octaspire_dern_typed_array_set_integer_at(
+                self,
+                i,
+                octaspire_dern_typed_array_get_integer_at(other, i));
+        }
+        else
+        {
+            octaspire_dern_typed_array_set_real_at(
+                self,
+                i,
+                octaspire_dern_typed_array_get_real_at(other, i));
+        }
+    }
+
+    return self;
+}
+
+void octaspire_dern_typed_array_release(octaspire_dern_typed_array_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_allocator_free(self->allocator, self->data);
+    octaspire_allocator_free(self->allocator, self);
+}
+
+octaspire_dern_typed_array_element_type_t octaspire_dern_typed_array_get_element_type(
+    octaspire_dern_typed_array_t const * const self)
+{
+    return self->elementType;
+}
+
+size_t octaspire_dern_typed_array_get_length(
+    octaspire_dern_typed_array_t const * const self)
+{
+    return self->length;
+}
+
+bool octaspire_dern_typed_array_element_type_is_integer(
+    octaspire_dern_typed_array_element_type_t const elementType)
+{
+    return elementType != OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64 &&
+           elementType != OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32;
+}
+
+char const *octaspire_dern_typed_array_element_type_get_name(
+    octaspire_dern_typed_array_element_type_t const elementType)
+{
+    switch (elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64: return "f64";
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32: return "f32";
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64: return "i64";
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32: return "i32";
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:  return "u8";
+    }
+
+    abort();
+    return 0;
+}
+
+bool octaspire_dern_typed_array_element_type_from_name(
+    char const * const name,
+    octaspire_dern_typed_array_element_type_t * const result)
+{
+    octaspire_dern_typed_array_element_type_t const types[] =
+    {
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64,
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32,
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64,
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32,
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8
+    };
+
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i)
+    {
+        if (strcmp(name, octaspire_dern_typed_array_element_type_get_name(types[i])) == 0)
+        {
+            *result = types[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool octaspire_dern_typed_array_private_grow(
+    octaspire_dern_typed_array_t * const self)
+{
+    if (self->length < self->capacity)
+    {
+        return true;
+    }
+
+    size_t const newCapacity = (self->capacity < 8) ? 8 : (self->capacity * 2);
+
+    void * const newData = octaspire_allocator_realloc(
+        self->allocator,
+        self->data,
+        newCapacity *
+            octaspire_dern_typed_array_private_get_element_size(self->elementType));
+
+    if (!newData)
+    {
+        return false;
+    }
+
+    self->data     = newData;
+    self->capacity = newCapacity;
+    return true;
+}
+
+bool octaspire_dern_typed_array_push_back_real(
+    octaspire_dern_typed_array_t * const self,
+    double const value)
+{
+    if (!octaspire_dern_typed_array_private_grow(self))
+    {
+        return false;
+    }
+
+    ++(self->length);
+    octaspire_dern_typed_array_set_real_at(self, self->length - 1, value);
+    return true;
+}
+
+bool octaspire_dern_typed_array_push_back_integer(
+    octaspire_dern_typed_array_t * const self,
+    int64_t const value)
+{
+    if (!octaspire_dern_typed_array_private_grow(self))
+    {
+        return false;
+    }
+
+    ++(self->length);
+    octaspire_dern_typed_array_set_integer_at(self, self->length - 1, value);
+    return true;
+}
+
+void octaspire_dern_typed_array_set_real_at(
+    octaspire_dern_typed_array_t * const self,
+    size_t const index,
+    double const value)
+{
+    assert(index < self->length);
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+            ((double*)self->data)[index] = value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+            ((float*)self->data)[index] = (float)value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+            ((int64_t*)self->data)[index] = octaspire_dern_typed_array_private_real_to_i64(value);
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+            ((int32_t*)self->data)[index] = octaspire_dern_typed_array_private_real_to_i32(value);
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+            ((uint8_t*)self->data)[index] = octaspire_dern_typed_array_private_real_to_u8(value);
+            break;
+    }
+}
+
+void octaspire_dern_typed_array_set_integer_at(
+    octaspire_dern_typed_array_t * const self,
+    size_t const index,
+    int64_t const value)
+{
+    assert(index < self->length);
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+            ((double*)self->data)[index] = (double)value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+            ((float*)self->data)[index] = (float)value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+            ((int64_t*)self->data)[index] = value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+            ((int32_t*)self->data)[index] = (int32_t)(uint32_t)value;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+            ((uint8_t*)self->data)[index] = (uint8_t)value;
+            break;
+    }
+}
+
+double octaspire_dern_typed_array_get_real_at(
+    octaspire_dern_typed_array_t const * const self,
+    size_t const index)
+{
+    assert(index < self->length);
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64: return ((double  const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32: return ((float   const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64: return (double)((int64_t const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32: return ((int32_t const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:  return ((uint8_t const*)self->data)[index];
+    }
+
+    abort();
+    return 0;
+}
+
+int64_t octaspire_dern_typed_array_get_integer_at(
+    octaspire_dern_typed_array_t const * const self,
+    size_t const index)
+{
+    assert(index < self->length);
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+            return octaspire_dern_typed_array_private_real_to_i64(
+                ((double const*)self->data)[index]);
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+            return octaspire_dern_typed_array_private_real_to_i64(
+                ((float const*)self->data)[index]);
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64: return ((int64_t const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32: return ((int32_t const*)self->data)[index];
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:  return ((uint8_t const*)self->data)[index];
+    }
+
+    abort();
+    return 0;
+}
+
+void octaspire_dern_typed_array_fill_real(
+    octaspire_dern_typed_array_t * const self,
+    double const value)
+{
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+        {
+            double * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { a[i] = value; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+        {
+            float * const a = self->data;
+            float   const v = (float)value;
+            for (size_t i = 0; i < self->length; ++i) { a[i] = v; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+        {
+            int64_t * const a = self->data;
+            int64_t   const v = octaspire_dern_typed_array_private_real_to_i64(value);
+            for (size_t i = 0; i < self->length; ++i) { a[i] = v; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+        {
+            int32_t * const a = self->data;
+            int32_t   const v = octaspire_dern_typed_array_private_real_to_i32(value);
+            for (size_t i = 0; i < self->length; ++i) { a[i] = v; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+        {
+            if (self->length > 0)
+            {
+                memset(
+                    self->data,
+                    octaspire_dern_typed_array_private_real_to_u8(value),
+                    self->length);
+            }
+        }
+        break;
+    }
+}
+
+// The loops below are generated for every element type from one body, so
+// that each one is a simple loop over contiguous elements of one C type.
+// 'RHS' is the right hand side operand and can refer to the loop index 'i'.
+// Integer addition, subtraction and multiplication are done in the
+// unsigned type 'UTYPE' to make them wrap around; integer division and
+// power are computed with reals and saturated by 'TO_TYPE'.
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(TYPE, UTYPE, IS_INTEGER, TO_TYPE, a, n, operation, RHS) \
+    switch (operation)                                                                              \
+    {                                                                                               \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_ADD:                                              \
+            for (size_t i = 0; i < (n); ++i) { a[i] = (TYPE)((UTYPE)a[i] + (UTYPE)(RHS)); }         \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SUBTRACT:                                         \
+            for (size_t i = 0; i < (n); ++i) { a[i] = (TYPE)((UTYPE)a[i] - (UTYPE)(RHS)); }         \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MULTIPLY:                                         \
+            for (size_t i = 0; i < (n); ++i) { a[i] = (TYPE)((UTYPE)a[i] * (UTYPE)(RHS)); }         \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_DIVIDE:                                           \
+            if (IS_INTEGER)                                                                         \
+            {                                                                                       \
+                for (size_t i = 0; i < (n); ++i)                                                    \
+                {                                                                                   \
+                    a[i] = TO_TYPE((double)a[i] / (double)(RHS));                                   \
+                }                                                                                   \
+            }                                                                                       \
+            else                                                                                    \
+            {                                                                                       \
+                for (size_t i = 0; i < (n); ++i) { a[i] = (TYPE)(a[i] / (RHS)); }                   \
+            }                                                                                       \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MIN:                                              \
+            for (size_t i = 0; i < (n); ++i) { a[i] = ((RHS) < a[i]) ? (TYPE)(RHS) : a[i]; }        \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MAX:                                              \
+            for (size_t i = 0; i < (n); ++i) { a[i] = ((RHS) > a[i]) ? (TYPE)(RHS) : a[i]; }        \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_POW:                                              \
+            for (size_t i = 0; i < (n); ++i) { a[i] = TO_TYPE(pow((double)a[i], (double)(RHS))); }  \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT:                                             \
+            for (size_t i = 0; i < (n); ++i) { a[i] = TO_TYPE(sqrt((double)a[i])); }                \
+            break;                                                                                  \
+        case OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN:                                              \
+            for (size_t i = 0; i < (n); ++i) { a[i] = TO_TYPE(sin((double)a[i])); }                 \
+            break;                                                                                  \
+    }
+
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F64(value) (value)
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F32(value) ((float)(value))
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I64(value) octaspire_dern_typed_array_private_real_to_i64(value)
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I32(value) octaspire_dern_typed_array_private_real_to_i32(value)
+#define OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_U8(value)  octaspire_dern_typed_array_private_real_to_u8(value)
+
+void octaspire_dern_typed_array_apply_array(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation,
+    octaspire_dern_typed_array_t const * const other)
+{
+    octaspire_helpers_verify_true(self->elementType == other->elementType);
+    octaspire_helpers_verify_true(self->length      == other->length);
+
+    size_t const n = self->length;
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+        {
+            double       * const a = self->data;
+            double const * const b = other->data;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                double, double, false, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F64, a, n, operation, b[i])
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+        {
+            float       * const a = self->data;
+            float const * const b = other->data;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                float, float, false, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F32, a, n, operation, b[i])
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+        {
+            int64_t       * const a = self->data;
+            int64_t const * const b = other->data;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                int64_t, uint64_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I64, a, n, operation, b[i])
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+        {
+            int32_t       * const a = self->data;
+            int32_t const * const b = other->data;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                int32_t, uint32_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I32, a, n, operation, b[i])
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+        {
+            uint8_t       * const a = self->data;
+            uint8_t const * const b = other->data;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                uint8_t, uint32_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_U8, a, n, operation, b[i])
+        }
+        break;
+    }
+}
+
+void octaspire_dern_typed_array_apply_scalar(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation,
+    double const scalar)
+{
+    size_t const n = self->length;
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+        {
+            double * const a = self->data;
+            double   const s = scalar;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                double, double, false, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F64, a, n, operation, s)
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+        {
+            float * const a = self->data;
+            float   const s = (float)scalar;
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                float, float, false, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_F32, a, n, operation, s)
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+        {
+            int64_t * const a = self->data;
+            int64_t   const s = octaspire_dern_typed_array_private_real_to_i64(scalar);
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                int64_t, uint64_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I64, a, n, operation, s)
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+        {
+            int32_t * const a = self->data;
+            int32_t   const s = octaspire_dern_typed_array_private_real_to_i32(scalar);
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                int32_t, uint32_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_I32, a, n, operation, s)
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+        {
+            uint8_t * const a = self->data;
+            uint8_t   const s = octaspire_dern_typed_array_private_real_to_u8(scalar);
+            OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_APPLY(
+                uint8_t, uint32_t, true, OCTASPIRE_DERN_TYPED_ARRAY_PRIVATE_TO_U8, a, n, operation, s)
+        }
+        break;
+    }
+}
+
+void octaspire_dern_typed_array_apply_unary(
+    octaspire_dern_typed_array_t * const self,
+    octaspire_dern_typed_array_operation_t const operation)
+{
+    octaspire_helpers_verify_true(
+        operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SQRT ||
+        operation == OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_SIN);
+
+    octaspire_dern_typed_array_apply_scalar(self, operation, 0);
+}
+
+double octaspire_dern_typed_array_get_sum(
+    octaspire_dern_typed_array_t const * const self)
+{
+    double result = 0;
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+        {
+            double const * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { result += a[i]; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+        {
+            float const * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { result += a[i]; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+        {
+            int64_t const * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { result += (double)a[i]; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+        {
+            int32_t const * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { result += a[i]; }
+        }
+        break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+        {
+            uint8_t const * const a = self->data;
+            for (size_t i = 0; i < self->length; ++i) { result += a[i]; }
+        }
+        break;
+    }
+
+    return result;
+}
+
+double octaspire_dern_typed_array_get_dot_product(
+    octaspire_dern_typed_array_t const * const self,
+    octaspire_dern_typed_array_t const * const other)
+{
+    octaspire_helpers_verify_true(self->length == other->length);
+
+    double result = 0;
+
+    if (self->elementType == other->elementType &&
+        self->elementType == OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64)
+    {
+        double const * const a = self->data;
+        double const * const b = other->data;
+
+        for (size_t i = 0; i < self->length; ++i)
+        {
+            result += a[i] * b[i];
+        }
+
+        return result;
+    }
+
+    if (self->elementType == other->elementType &&
+        self->elementType == OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32)
+    {
+        float const * const a = self->data;
+        float const * const b = other->data;
+
+        for (size_t i = 0; i < self->length; ++i)
+        {
+            result += (double)a[i] * (double)b[i];
+        }
+
+        return result;
+    }
+
+    for (size_t i = 0; i < self->length; ++i)
+    {
+        result +=
+            octaspire_dern_typed_array_get_real_at(self,  i) *
+            octaspire_dern_typed_array_get_real_at(other, i);
+    }
+
+    return result;
+}
+
+static int octaspire_dern_typed_array_private_compare_f64(
+    void const * const first,
+    void const * const second)
+{
+    double const a = *(double const*)first;
+    double const b = *(double const*)second;
+
+    if (isnan(a) || isnan(b))
+    {
+        return (int)isnan(a) - (int)isnan(b);
+    }
+
+    return (a > b) - (a < b);
+}
+
+static int octaspire_dern_typed_array_private_compare_f32(
+    void const * const first,
+    void const * const second)
+{
+    float const a = *(float const*)first;
+    float const b = *(float const*)second;
+
+    if (isnan(a) || isnan(b))
+    {
+        return (int)isnan(a) - (int)isnan(b);
+    }
+
+    return (a > b) - (a < b);
+}
+
+static int octaspire_dern_typed_array_private_compare_i64(
+    void const * const first,
+    void const * const second)
+{
+    int64_t const a = *(int64_t const*)first;
+    int64_t const b = *(int64_t const*)second;
+    return (a > b) - (a < b);
+}
+
+static int octaspire_dern_typed_array_private_compare_i32(
+    void const * const first,
+    void const * const second)
+{
+    int32_t const a = *(int32_t const*)first;
+    int32_t const b = *(int32_t const*)second;
+    return (a > b) - (a < b);
+}
+
+static int octaspire_dern_typed_array_private_compare_u8(
+    void const * const first,
+    void const * const second)
+{
+    return (int)*(uint8_t const*)first - (int)*(uint8_t const*)second;
+}
+
+void octaspire_dern_typed_array_sort(
+    octaspire_dern_typed_array_t * const self)
+{
+    if (self->length < 2)
+    {
+        return;
+    }
+
+    int (*compare)(void const *, void const *) = 0;
+
+    switch (self->elementType)
+    {
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64:
+            compare = octaspire_dern_typed_array_private_compare_f64;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F32:
+            compare = octaspire_dern_typed_array_private_compare_f32;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I64:
+            compare = octaspire_dern_typed_array_private_compare_i64;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_I32:
+            compare = octaspire_dern_typed_array_private_compare_i32;
+            break;
+
+        case OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8:
+            compare = octaspire_dern_typed_array_private_compare_u8;
+            break;
+    }
+
+    qsort(
+        self->data,
+        self->length,
+        octaspire_dern_typed_array_private_get_element_size(self->elementType),
+        compare);
+}
+
+bool octaspire_dern_typed_array_reorder(
+    octaspire_dern_typed_array_t * const self,
+    size_t const * const order)
+{
+    if (self->length < 2)
+    {
+        return true;
+    }
+
+    size_t const elementSize =
+        octaspire_dern_typed_array_private_get_element_size(self->elementType);
+
+    char * const buffer =
+        octaspire_allocator_malloc(self->allocator, self->length * elementSize);
+
+    if (!buffer)
+    {
+        return false;
+    }
+
+    char const * const data = (char const*)self->data;
+
+    for (size_t i = 0; i < self->length; ++i)
+    {
+        assert(order[i] < self->length);
+        memcpy(buffer + i * elementSize, data + order[i] * elementSize, elementSize);
+    }
+
+    memcpy(self->data, buffer, self->length * elementSize);
+    octaspire_allocator_free(self->allocator, buffer);
+    return true;
+}
+
+int octaspire_dern_typed_array_compare(
+    octaspire_dern_typed_array_t const * const self,
+    octaspire_dern_typed_array_t const * const other)
+{
+    if (self->elementType != other->elementType)
+    {
+        return (int)self->elementType - (int)other->elementType;
+    }
+
+    if (self->length != other->length)
+    {
+        return (self->length < other->length) ? -1 : 1;
+    }
+
+    for (size_t i = 0; i < self->length; ++i)
+    {
+        if (octaspire_dern_typed_array_element_type_is_integer(self->elementType))
+        {
+            int64_t const a = octaspire_dern_typed_array_get_integer_at(self,  i);
+            int64_t const b = octaspire_dern_typed_array_get_integer_at(other, i);
+
+            if (a != b)
+            {
+                return (a < b) ? -1 : 1;
+            }
+        }
+        else
+        {
+            double const a = octaspire_dern_typed_array_get_real_at(self,  i);
+            double const b = octaspire_dern_typed_array_get_real_at(other, i);
+
+            if (a < b)
+            {
+                return -1;
+            }
+
+            if (a > b)
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+uint32_t octaspire_dern_typed_array_get_hash(
+    octaspire_dern_typed_array_t const * const self)
+{
+    return octaspire_dern_helpers_calculate_hash_for_octets(
+        self->data,
+        self->length *
+            octaspire_dern_typed_array_private_get_element_size(self->elementType)) ^
+        (uint32_t)self->elementType;
+}
@@ -29,6 +29,7 @@ limitations under the License.
 
 #include "octaspire/dern/octaspire_dern_environment.h"
 #include "octaspire/dern/octaspire_dern_vm.h"
+#include "octaspire/dern/octaspire_dern_helpers.h"
 #include "octaspire/dern/octaspire_dern_port.h"
 #include "octaspire/dern/octaspire_dern_helpers.h"
 
@@ -54,7 +55,16 @@ static char const * const octaspire_dern_value_helper_type_tags_as_c_strings[] =
     "builtin",
     "port",
     "C data",
-    "semver"
+    "semver",
+    "weak reference",
+    "persistent vector",
+    "persistent hash map",
+    "typed array",
+    "bytes",
+    "string builder",
+    "set",
+    "sorted map",
+    "string slice"
 };
 
 static octaspire_string_t *octaspire_dern_function_private_is_string_in_vector(
@@ -67,6 +77,220 @@ static octaspire_string_t *octaspire_dern_private_value_to_string(
     bool const plain,
     octaspire_allocator_t * const allocator);
 
+bool octaspire_dern_value_is_copy_on_write_pending(
+    octaspire_dern_value_t const * const self)
+{
+    return octaspire_dern_value_get_copy_on_write_source(self) != 0;
+}
+
+octaspire_dern_value_t *octaspire_dern_value_get_copy_on_write_source(
+    octaspire_dern_value_t const * const self)
+{
+    return self->isCopyOnWriteSource ? 0 : self->copyOnWrite.source;
+}
+
+void octaspire_dern_value_prepare_for_mutation(
+    octaspire_dern_value_t * const self)
+{
+    self->hashIsCached = false;
+
+    if (self->copyOnWritePins)
+    {
+        // Pending copies must see the value as it was before the mutation.
+        octaspire_dern_vm_materialize_copies_sharing_value(self->vm, self);
+    }
+
+    octaspire_dern_vm_materialize_copy_on_write_value(self->vm, self);
+}
+
+void octaspire_dern_value_prepare_for_element_access(
+    octaspire_dern_value_t * const self)
+{
+    // Slices have no elements and stay attached until their source is
+    // mutated.
+    if (!octaspire_dern_value_is_copy_on_write_pending(self) ||
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE)
+    {
+        return;
+    }
+
+    if (self->copyOnWritePins)
+    {
+        // Elements of a pending copy that is itself shared cannot be
+        // handed out before the copies sharing it are materialized.
+        octaspire_dern_vm_materialize_copies_sharing_value(self->vm, self);
+    }
+
+    octaspire_dern_vm_materialize_copy_on_write_value(self->vm, self);
+}
+
+bool octaspire_dern_value_is_copy_on_write_shareable(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING ||
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR ||
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP;
+}
+
+static void octaspire_dern_value_private_unpin_hash_map_elements(
+    octaspire_dern_value_t * const self,
+    size_t const numElements)
+{
+    // Keys and values are unpinned in the order they were pinned.
+    octaspire_dern_map_element_iterator_t iter =
+        octaspire_dern_map_element_iterator_init(self->value.hashMap);
+
+    size_t numUnpinned = 0;
+
+    while (iter.element && numUnpinned < numElements)
+    {
+        octaspire_dern_value_unpin_for_copy_on_write(
+            octaspire_dern_map_element_get_key(iter.element));
+
+        ++numUnpinned;
+
+        if (numUnpinned < numElements)
+        {
+            octaspire_dern_value_unpin_for_copy_on_write(
+                octaspire_dern_map_element_get_value(iter.element));
+
+            ++numUnpinned;
+        }
+
+        octaspire_dern_map_element_iterator_next(&iter);
+    }
+}
+
+bool octaspire_dern_value_pin_for_copy_on_write(
+    octaspire_dern_value_t * const self)
+{
+    if (self->copyOnWritePins == UINT16_MAX)
+    {
+        return false;
+    }
+
+    // A pending copy is pinned as a whole; its elements are protected
+    // by the pins of its own source.
+    if (octaspire_dern_value_is_copy_on_write_pending(self))
+    {
+        ++(self->copyOnWritePins);
+        return true;
+    }
+
+    switch (self->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_NIL:
+        case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_ERROR:
+        case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            for (size_t i = 0; i < octaspire_vector_get_length(self->value.vector); ++i)
+            {
+                if (!octaspire_dern_value_pin_for_copy_on_write(
+                        octaspire_vector_get_element_at(self->value.vector, (ptrdiff_t)i)))
+                {
+                    // The same element can be in the vector many times, so
+                    // its pins are not known before all are pinned.
+                    for (size_t j = 0; j < i; ++j)
+                    {
+                        octaspire_dern_value_unpin_for_copy_on_write(
+                            octaspire_vector_get_element_at(
+                                self->value.vector,
+                                (ptrdiff_t)j));
+                    }
+
+                    return false;
+                }
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            if (self->hashMapHasWeakKeys)
+            {
+                // GC removes entries of weak hash maps, so those are never shared.
+                return false;
+            }
+
+            octaspire_dern_map_element_iterator_t iter =
+                octaspire_dern_map_element_iterator_init(self->value.hashMap);
+
+            size_t numPinned = 0;
+
+            while (iter.element)
+            {
+                if (!octaspire_dern_value_pin_for_copy_on_write(
+                        octaspire_dern_map_element_get_key(iter.element)))
+                {
+                    octaspire_dern_value_private_unpin_hash_map_elements(self, numPinned);
+                    return false;
+                }
+
+                ++numPinned;
+
+                if (!octaspire_dern_value_pin_for_copy_on_write(
+                        octaspire_dern_map_element_get_value(iter.element)))
+                {
+                    octaspire_dern_value_private_unpin_hash_map_elements(self, numPinned);
+                    return false;
+                }
+
+                ++numPinned;
+
+                octaspire_dern_map_element_iterator_next(&iter);
+            }
+        }
+        break;
+
+        default:
+        {
+            return false;
+        }
+    }
+
+    ++(self->copyOnWritePins);
+    return true;
+}
+
+void octaspire_dern_value_unpin_for_copy_on_write(
+    octaspire_dern_value_t * const self)
+{
+    octaspire_helpers_verify_true(self->copyOnWritePins > 0);
+    --(self->copyOnWritePins);
+
+    if (octaspire_dern_value_is_copy_on_write_pending(self))
+    {
+        return;
+    }
+
+    if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
+    {
+        for (size_t i = 0; i < octaspire_vector_get_length(self->value.vector); ++i)
+        {
+            octaspire_dern_value_unpin_for_copy_on_write(
+                octaspire_vector_get_element_at(self->value.vector, (ptrdiff_t)i));
+        }
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP)
+    {
+        octaspire_dern_value_private_unpin_hash_map_elements(
+            self,
+            2 * octaspire_dern_map_get_number_of_elements(self->value.hashMap));
+    }
+}
+
 static int octaspire_dern_value_private_compare_void_pointers(
     void const * const a,
     void const * const b);
@@ -117,10 +341,10 @@ octaspire_dern_function_t *octaspire_dern_function_new_copy(
     }
 
     self->name
-        = octaspire_string_new_copy(other->name, allocator);
+        = octaspire_dern_helpers_copy_string(other->name, allocator);
 
     self->docstr
-        = octaspire_string_new_copy(other->docstr, allocator);
+        = octaspire_dern_helpers_copy_string(other->docstr, allocator);
 
     self->howtoAllowed = other->howtoAllowed;
 
@@ -453,12 +677,12 @@ octaspire_dern_special_t *octaspire_dern_special_new_copy(
     self->allocator                  = allocator;
 
     self->name                       =
-        octaspire_string_new_copy(other->name, allocator);
+        octaspire_dern_helpers_copy_string(other->name, allocator);
 
     self->numRequiredActualArguments = other->numRequiredActualArguments;
 
     self->docstr                     =
-        octaspire_string_new_copy(other->docstr, allocator);
+        octaspire_dern_helpers_copy_string(other->docstr, allocator);
 
     self->howtoAllowed               = other->howtoAllowed;
 
@@ -550,7 +774,7 @@ octaspire_dern_error_message_t *octaspire_dern_error_message_new_copy(
 
     self->allocator                  = allocator;
 
-    self->message    = octaspire_string_new_copy(other->message, allocator);
+    self->message    = octaspire_dern_helpers_copy_string(other->message, allocator);
     self->lineNumber = other->lineNumber;
 
     return self;
@@ -632,12 +856,12 @@ octaspire_dern_builtin_t *octaspire_dern_builtin_new_copy(
     self->allocator                  = allocator;
 
     self->name                       =
-        octaspire_string_new_copy(other->name, allocator);
+        octaspire_dern_helpers_copy_string(other->name, allocator);
 
     self->numRequiredActualArguments = other->numRequiredActualArguments;
 
     self->docstr                     =
-        octaspire_string_new_copy(other->docstr, allocator);
+        octaspire_dern_helpers_copy_string(other->docstr, allocator);
 
     self->howtoAllowed               = other->howtoAllowed;
 
@@ -743,6 +967,14 @@ bool octaspire_dern_value_set(
         return true;
     }
 
+    if (self->copyOnWritePins)
+    {
+        octaspire_dern_vm_materialize_copies_sharing_value(self->vm, self);
+    }
+
+    // Elements of a vector or hash map are shared with 'self' below.
+    octaspire_dern_value_prepare_for_element_access(value);
+
     octaspire_dern_vm_clear_value_to_nil(self->vm, self);
 
     self->typeTag = value->typeTag;
@@ -781,7 +1013,7 @@ bool octaspire_dern_value_set(
         case OCTASPIRE_DERN_VALUE_TAG_STRING:
         {
             self->value.string =
-                octaspire_string_new_copy(
+                octaspire_dern_helpers_copy_string(
                     value->value.string,
                     octaspire_dern_vm_get_allocator(self->vm));
         }
@@ -799,7 +1031,7 @@ bool octaspire_dern_value_set(
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         {
             self->value.character =
-                octaspire_string_new_copy(
+                octaspire_dern_helpers_copy_string(
                     value->value.character,
                     octaspire_dern_vm_get_allocator(self->vm));
         }
@@ -808,7 +1040,7 @@ bool octaspire_dern_value_set(
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         {
             self->value.symbol =
-                octaspire_string_new_copy(
+                octaspire_dern_helpers_copy_string(
                     value->value.symbol,
                     octaspire_dern_vm_get_allocator(self->vm));
         }
@@ -857,33 +1089,40 @@ bool octaspire_dern_value_set(
 
         case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
         {
-            self->value.hashMap = octaspire_map_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                sizeof(octaspire_dern_value_t*),
-                true,
-                (octaspire_map_key_compare_function_t)octaspire_dern_value_is_equal,
-                (octaspire_map_key_hash_function_t)octaspire_dern_value_get_hash,
-                0,
-                0,
+            self->hashMapHasWeakKeys = value->hashMapHasWeakKeys;
+
+            self->value.hashMap = octaspire_dern_map_new(
                 octaspire_dern_vm_get_allocator(self->vm));
 
+            octaspire_dern_map_set_hashes_collection_keys_by_identity(
+                self->value.hashMap,
+                value->hashMapHasWeakKeys);
+
+            // GC removes entries from weak hash maps; it must not run while
+            // the source is iterated.
+            bool const preventGc = octaspire_dern_vm_get_prevent_gc(self->vm);
+
+            if (value->hashMapHasWeakKeys)
+            {
+                octaspire_dern_vm_set_prevent_gc(self->vm, true);
+            }
+
             for (size_t i = 0;
-                 i < octaspire_map_get_number_of_elements(
+                 i < octaspire_dern_map_get_number_of_elements(
                      value->value.hashMap);
                  ++i)
             {
-                octaspire_map_element_t * const element =
-                    octaspire_map_get_at_index(
+                octaspire_dern_map_element_t * const element =
+                    octaspire_dern_map_get_at_index(
                         value->value.hashMap,
                         (ptrdiff_t)i);
 
-                octaspire_dern_value_t *key = octaspire_map_element_get_key(element);
+                octaspire_dern_value_t *key = octaspire_dern_map_element_get_key(element);
 
                 octaspire_dern_value_t *val =
-                    octaspire_map_element_get_value(element);
+                    octaspire_dern_map_element_get_value(element);
 
-                if (octaspire_dern_value_is_atom(key))
+                if (octaspire_dern_value_is_atom(key) && !value->hashMapHasWeakKeys)
                 {
                     key = octaspire_dern_vm_create_new_value_copy(self->vm, key);
                 }
@@ -897,19 +1136,13 @@ bool octaspire_dern_value_set(
 
                 octaspire_dern_vm_push_value(self->vm, val);
 
-                // Any previous value must be removed, because hash map
-                // can contain multiple values per key, and we must replace, not
-                // add the value.
-                octaspire_map_remove(
-                    self->value.hashMap,
-                    octaspire_map_element_get_hash(element),
-                    &key);
-
-                if (!octaspire_map_put(
+                // Also the key of a previous element is replaced and not
+                // only the value, but the element keeps its place.
+                if (!octaspire_dern_map_put_replacing_key(
                     self->value.hashMap,
-                    octaspire_map_element_get_hash(element),
-                    &key,
-                    &val))
+                    octaspire_dern_map_element_get_hash(element),
+                    key,
+                    val))
                 {
                     abort();
                 }
@@ -917,24 +1150,29 @@ bool octaspire_dern_value_set(
                 octaspire_dern_vm_pop_value(self->vm, val);
                 octaspire_dern_vm_pop_value(self->vm, key);
             }
+
+            octaspire_dern_vm_set_prevent_gc(self->vm, preventGc);
         }
         break;
 
         case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         {
-            self->value.queue = octaspire_queue_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                0,
-                octaspire_dern_vm_get_allocator(self->vm));
+            self->value.queue =
+                octaspire_dern_deque_has_max_length(value->value.queue) ?
+                    octaspire_dern_deque_new_with_max_length(
+                        octaspire_dern_deque_get_max_length(value->value.queue),
+                        octaspire_dern_vm_get_allocator(self->vm)) :
+                    octaspire_dern_deque_new(
+                        octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(self->value.queue);
 
-            // TODO Add iterator to queue and use it here
             for (size_t i = 0;
-                 i < octaspire_queue_get_length(value->value.queue);
+                 i < octaspire_dern_deque_get_length(value->value.queue);
                  ++i)
             {
                 octaspire_dern_value_t * tmpVal =
-                    octaspire_queue_get_at(
+                    octaspire_dern_deque_get_at(
                         value->value.queue,
                         (ptrdiff_t)i);
 
@@ -945,7 +1183,7 @@ bool octaspire_dern_value_set(
 
                 octaspire_dern_vm_push_value(self->vm, tmpVal);
 
-                if (!octaspire_queue_push(self->value.queue, &tmpVal))
+                if (!octaspire_dern_deque_push_back(self->value.queue, tmpVal))
                 {
                     abort();
                 }
@@ -957,22 +1195,19 @@ bool octaspire_dern_value_set(
 
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         {
-            self->value.list = octaspire_list_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                0,
+            self->value.list = octaspire_dern_deque_new(
                 octaspire_dern_vm_get_allocator(self->vm));
 
-            // TODO more efficient iteration
+            octaspire_helpers_verify_not_null(self->value.list);
+
             for (size_t i = 0;
-                 i < octaspire_list_get_length(value->value.list);
+                 i < octaspire_dern_deque_get_length(value->value.list);
                  ++i)
             {
                 octaspire_dern_value_t * tmpVal =
-                    octaspire_list_node_get_element(
-                        octaspire_list_get_at(
-                            value->value.list,
-                            (ptrdiff_t)i));
+                    octaspire_dern_deque_get_at(
+                        value->value.list,
+                        (ptrdiff_t)i);
 
                 if (octaspire_dern_value_is_atom(tmpVal))
                 {
@@ -981,7 +1216,7 @@ bool octaspire_dern_value_set(
 
                 octaspire_dern_vm_push_value(self->vm, tmpVal);
 
-                if (!octaspire_list_push_back(self->value.list, &tmpVal))
+                if (!octaspire_dern_deque_push_back(self->value.list, tmpVal))
                 {
                     abort();
                 }
@@ -1014,95 +1249,272 @@ bool octaspire_dern_value_set(
                     octaspire_dern_vm_get_allocator(self->vm));
         }
         break;
-    }
 
-    if (value->docstr)
-    {
-        // GC releases old if created
-        self->docstr = octaspire_dern_vm_create_new_value_copy(self->vm, value->docstr);
-    }
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        {
+            self->value.weakReference = value->value.weakReference;
+        }
+        break;
 
-    if (value->docvec)
-    {
-        // GC releases old if created
-        self->docvec = octaspire_dern_vm_create_new_value_copy(self->vm, value->docvec);
-    }
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            self->isTransient = value->isTransient;
 
-    return true;
-}
+            self->value.persistentVector = octaspire_dern_persistent_vector_new_copy(
+                value->value.persistentVector,
+                octaspire_dern_vm_get_allocator(self->vm));
 
-bool octaspire_dern_value_set_collection(
-    octaspire_dern_value_t * const self,
-    octaspire_dern_value_t const * const indexOrKey,
-    octaspire_dern_value_t * const value)
-{
-    octaspire_helpers_verify_true(self && indexOrKey && value);
+            octaspire_helpers_verify_not_null(self->value.persistentVector);
+        }
+        break;
 
-    if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
-    {
-        if (value->typeTag      != OCTASPIRE_DERN_VALUE_TAG_CHARACTER ||
-            indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
         {
-            return false;
+            self->isTransient = value->isTransient;
+
+            self->value.persistentHashMap = octaspire_dern_persistent_map_new_copy(
+                value->value.persistentHashMap,
+                octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(self->value.persistentHashMap);
         }
+        break;
 
-        return octaspire_string_overwrite_with_string_at(
-            self->value.string,
-            value->value.character,
-            indexOrKey->value.integer);
-    }
-    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
-    {
-        if (indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
         {
-            return false;
+            self->value.typedArray = octaspire_dern_typed_array_new_copy(
+                value->value.typedArray,
+                octaspire_dern_typed_array_get_element_type(value->value.typedArray),
+                octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(self->value.typedArray);
         }
+        break;
 
-        //bool const result = octaspire_vector_insert_element_before_the_element_at_index(
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            self->value.bytes = octaspire_dern_bytes_new_from_buffer(
+                octaspire_dern_bytes_get_octets(value->value.bytes),
+                octaspire_dern_bytes_get_length(value->value.bytes),
+                octaspire_dern_vm_get_allocator(self->vm));
 
-        if (indexOrKey->value.integer < 0)
+            octaspire_helpers_verify_not_null(self->value.bytes);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
         {
-            // TODO index from back?
-            return false;
+            self->value.stringBuilder = octaspire_dern_bytes_new_from_buffer(
+                octaspire_dern_bytes_get_octets(value->value.stringBuilder),
+                octaspire_dern_bytes_get_length(value->value.stringBuilder),
+                octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(self->value.stringBuilder);
         }
+        break;
 
-        // TODO XXX is this correct?
-        if (octaspire_vector_get_length(self->value.vector) <=
-            (size_t)indexOrKey->value.integer)
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
         {
+            self->value.set = octaspire_dern_map_new(
+                octaspire_dern_vm_get_allocator(self->vm));
 
-            // octaspire_vector_insert_element_at cannot be used here, because
-            // it fills the missing indices with 0. Now those must be nil-values.
+            octaspire_helpers_verify_not_null(self->value.set);
 
-            for (size_t i = octaspire_vector_get_length(self->value.vector);
-                 i < (size_t)indexOrKey->value.integer;
-                 ++i)
+            if (!octaspire_dern_map_reserve(
+                    self->value.set,
+                    octaspire_dern_map_get_number_of_elements(value->value.set)))
             {
-                octaspire_dern_value_t *nilValue = octaspire_dern_vm_get_value_nil(self->vm);
+                abort();
+            }
 
-                if (!octaspire_vector_push_back_element(
-                    self->value.vector,
-                    &nilValue))
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(value->value.set);
+
+            while (iter.element)
+            {
+                if (!octaspire_dern_value_as_set_add(
+                        self,
+                        octaspire_dern_map_element_get_key(iter.element)))
                 {
                     abort();
                 }
-            }
-
-            octaspire_dern_value_t * const tmpValueForInsertion =
-                octaspire_dern_value_is_atom(value) ?
-                    octaspire_dern_vm_create_new_value_copy(self->vm, value) :
-                    value;
 
-            return octaspire_vector_push_back_element(
-                self->value.vector,
-                &tmpValueForInsertion);
+                octaspire_dern_map_element_const_iterator_next(&iter);
+            }
         }
-        else
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
         {
-            octaspire_dern_value_t * const tmpValueForInsertion =
-                octaspire_dern_value_is_atom(value) ?
-                    octaspire_dern_vm_create_new_value_copy(self->vm, value) :
-                    value;
+            self->value.sortedMap = octaspire_dern_sorted_map_new(
+                octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(self->value.sortedMap);
+
+            octaspire_dern_sorted_map_iterator_t iter =
+                octaspire_dern_sorted_map_iterator_init(value->value.sortedMap);
+
+            while (iter.key)
+            {
+                if (!octaspire_dern_value_as_sorted_map_put(self, iter.key, iter.value))
+                {
+                    abort();
+                }
+
+                octaspire_dern_sorted_map_iterator_next(&iter);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            // Assigned slice gets its own octets, like assigned strings.
+            octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(self->vm);
+
+            octaspire_dern_string_slice_t * const slice =
+                octaspire_allocator_malloc(allocator, sizeof(octaspire_dern_string_slice_t));
+
+            octaspire_helpers_verify_not_null(slice);
+
+            *slice            = *(value->value.stringSlice);
+            slice->octetIndex = 0;
+            slice->octets     = octaspire_allocator_malloc(allocator, slice->numOctets + 1);
+
+            octaspire_helpers_verify_not_null(slice->octets);
+
+            memcpy(
+                slice->octets,
+                octaspire_dern_value_as_string_slice_get_octets(value),
+                slice->numOctets);
+
+            self->value.stringSlice = slice;
+        }
+        break;
+    }
+
+    if (value->docstr)
+    {
+        // GC releases old if created
+        self->docstr = octaspire_dern_vm_create_new_value_copy(self->vm, value->docstr);
+    }
+
+    if (value->docvec)
+    {
+        // GC releases old if created
+        self->docvec = octaspire_dern_vm_create_new_value_copy(self->vm, value->docvec);
+    }
+
+    return true;
+}
+
+// Keys that are mutable collections are stored as copies, so that
+// mutating the value used as a key does not invalidate the hash that the
+// key is stored with. Keys of weak hash maps are stored as they are,
+// because nothing else would keep a copy alive.
+static octaspire_dern_value_t *octaspire_dern_value_private_get_key_for_insertion(
+    octaspire_dern_value_t const * const self,
+    octaspire_dern_value_t const * const key)
+{
+    if (self->hashMapHasWeakKeys)
+    {
+        return (octaspire_dern_value_t*)key;
+    }
+
+    switch (key->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            return octaspire_dern_vm_create_new_value_copy(
+                self->vm,
+                (octaspire_dern_value_t*)key);
+        }
+
+        default:
+        {
+            return (octaspire_dern_value_t*)key;
+        }
+    }
+}
+
+bool octaspire_dern_value_set_collection(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const indexOrKey,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_helpers_verify_true(self && indexOrKey && value);
+
+    octaspire_dern_value_prepare_for_mutation(self);
+
+    if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
+    {
+        if (value->typeTag      != OCTASPIRE_DERN_VALUE_TAG_CHARACTER ||
+            indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        {
+            return false;
+        }
+
+        return octaspire_string_overwrite_with_string_at(
+            self->value.string,
+            value->value.character,
+            indexOrKey->value.integer);
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
+    {
+        if (indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        {
+            return false;
+        }
+
+        //bool const result = octaspire_vector_insert_element_before_the_element_at_index(
+
+        if (indexOrKey->value.integer < 0)
+        {
+            // TODO index from back?
+            return false;
+        }
+
+        // TODO XXX is this correct?
+        if (octaspire_vector_get_length(self->value.vector) <=
+            (size_t)indexOrKey->value.integer)
+        {
+
+            // octaspire_vector_insert_element_at cannot be used here, because
+            // it fills the missing indices with 0. Now those must be nil-values.
+
+            for (size_t i = octaspire_vector_get_length(self->value.vector);
+                 i < (size_t)indexOrKey->value.integer;
+                 ++i)
+            {
+                octaspire_dern_value_t *nilValue = octaspire_dern_vm_get_value_nil(self->vm);
+
+                if (!octaspire_vector_push_back_element(
+                    self->value.vector,
+                    &nilValue))
+                {
+                    abort();
+                }
+            }
+
+            octaspire_dern_value_t * const tmpValueForInsertion =
+                octaspire_dern_value_is_atom(value) ?
+                    octaspire_dern_vm_create_new_value_copy(self->vm, value) :
+                    value;
+
+            return octaspire_vector_push_back_element(
+                self->value.vector,
+                &tmpValueForInsertion);
+        }
+        else
+        {
+            octaspire_dern_value_t * const tmpValueForInsertion =
+                octaspire_dern_value_is_atom(value) ?
+                    octaspire_dern_vm_create_new_value_copy(self->vm, value) :
+                    value;
 
             return octaspire_vector_replace_element_at(
                 self->value.vector,
@@ -1117,19 +1529,95 @@ bool octaspire_dern_value_set_collection(
             octaspire_dern_vm_create_new_value_copy(self->vm, value) :
             value;
 
-        // Any previous value must be removed, because hash map
-        // can contain multiple values per key, and we must replace, not
-        // add the value.
-        octaspire_map_remove(
-            self->value.hashMap,
-            octaspire_dern_value_get_hash(indexOrKey),
-            &indexOrKey);
+        uint32_t const hash = octaspire_dern_value_get_hash(indexOrKey);
+
+        octaspire_dern_vm_push_value(self->vm, tmpValueForInsertion);
+
+        octaspire_dern_value_t * const tmpKeyForInsertion =
+            octaspire_dern_value_private_get_key_for_insertion(self, indexOrKey);
 
-        return octaspire_map_put(
+        octaspire_dern_vm_pop_value(self->vm, tmpValueForInsertion);
+
+        // Also the key of a previous element is replaced and not only the
+        // value, but the element keeps its place in the insertion order.
+        return octaspire_dern_map_put_replacing_key(
             self->value.hashMap,
-            octaspire_dern_value_get_hash(indexOrKey),
-            &indexOrKey,
-            &tmpValueForInsertion);
+            hash,
+            tmpKeyForInsertion,
+            tmpValueForInsertion);
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP)
+    {
+        return octaspire_dern_value_as_sorted_map_put(
+            self,
+            (octaspire_dern_value_t*)indexOrKey,
+            value);
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY)
+    {
+        if (indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER ||
+            !octaspire_dern_value_is_number(value))
+        {
+            return false;
+        }
+
+        ptrdiff_t const length =
+            (ptrdiff_t)octaspire_dern_typed_array_get_length(self->value.typedArray);
+
+        ptrdiff_t const index = (indexOrKey->value.integer < 0) ?
+            (length + indexOrKey->value.integer) :
+            indexOrKey->value.integer;
+
+        if (index < 0 || index >= length)
+        {
+            return false;
+        }
+
+        if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER)
+        {
+            octaspire_dern_typed_array_set_integer_at(
+                self->value.typedArray,
+                (size_t)index,
+                value->value.integer);
+        }
+        else
+        {
+            octaspire_dern_typed_array_set_real_at(
+                self->value.typedArray,
+                (size_t)index,
+                value->value.real);
+        }
+
+        return true;
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES)
+    {
+        if (indexOrKey->typeTag != OCTASPIRE_DERN_VALUE_TAG_INTEGER ||
+            value->typeTag      != OCTASPIRE_DERN_VALUE_TAG_INTEGER ||
+            value->value.integer < 0                                 ||
+            value->value.integer > UINT8_MAX)
+        {
+            return false;
+        }
+
+        ptrdiff_t const length =
+            (ptrdiff_t)octaspire_dern_bytes_get_length(self->value.bytes);
+
+        ptrdiff_t const index = (indexOrKey->value.integer < 0) ?
+            (length + indexOrKey->value.integer) :
+            indexOrKey->value.integer;
+
+        if (index < 0 || index >= length)
+        {
+            return false;
+        }
+
+        octaspire_dern_bytes_set_octet_at(
+            self->value.bytes,
+            (size_t)index,
+            (uint8_t)value->value.integer);
+
+        return true;
     }
     else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE)
     {
@@ -1153,8 +1641,197 @@ bool octaspire_dern_value_set_collection(
     return false;
 }
 
+static uint32_t octaspire_dern_value_private_get_cached_hash_for_string(
+    octaspire_dern_value_t const * const self,
+    octaspire_string_t const * const str)
+{
+    // The cache is not part of the observable state of the value.
+    octaspire_dern_value_t * const mutableSelf = (octaspire_dern_value_t*)self;
+
+    if (!self->hashIsCached)
+    {
+        mutableSelf->cachedHash = octaspire_dern_helpers_calculate_hash_for_octets(
+            octaspire_string_get_c_string(str),
+            octaspire_string_get_length_in_octets(str));
+
+        mutableSelf->hashIsCached = true;
+    }
+
+    return self->cachedHash;
+}
+
+// Composite values are hashed from their elements, so that values that
+// are equal by 'octaspire_dern_value_compare' get equal hashes. Elements
+// deeper than this contribute only their type and number of elements;
+// this also ends hashing of values that contain themselves.
+static size_t const octaspire_dern_value_private_hash_max_depth = 8;
+
+static uint32_t octaspire_dern_value_private_get_hash(
+    octaspire_dern_value_t const * const self,
+    size_t const depth);
+
+static uint32_t octaspire_dern_value_private_combine_hashes(
+    uint32_t const seed,
+    uint32_t const hash)
+{
+    return seed ^ (hash + UINT32_C(0x9E3779B9) + (seed << 6) + (seed >> 2));
+}
+
+static uint32_t octaspire_dern_value_private_get_hash_for_composite(
+    octaspire_dern_value_t const * const self,
+    size_t const depth)
+{
+    size_t const numElements = octaspire_dern_value_get_length(self);
+
+    uint32_t result = octaspire_dern_value_private_combine_hashes(
+        octaspire_helpers_calculate_hash_for_int32_t_argument((int32_t)self->typeTag),
+        octaspire_helpers_calculate_hash_for_size_t_argument(numElements));
+
+    if (depth >= octaspire_dern_value_private_hash_max_depth)
+    {
+        return result;
+    }
+
+    size_t const nextDepth = depth + 1;
+
+    // Hashes of the elements of unordered collections are summed, so that
+    // the order of the elements in the storage does not matter.
+    uint32_t sum = 0;
+
+    switch (self->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            for (size_t i = 0; i < numElements; ++i)
+            {
+                result = octaspire_dern_value_private_combine_hashes(
+                    result,
+                    octaspire_dern_value_private_get_hash(
+                        octaspire_vector_get_element_at_const(
+                            self->value.vector,
+                            (ptrdiff_t)i),
+                        nextDepth));
+            }
+        }
+        return result;
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            octaspire_dern_deque_iterator_t iter = octaspire_dern_deque_iterator_init(
+                (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE) ?
+                    self->value.queue :
+                    self->value.list);
+
+            while (iter.element)
+            {
+                result = octaspire_dern_value_private_combine_hashes(
+                    result,
+                    octaspire_dern_value_private_get_hash(iter.element, nextDepth));
+
+                octaspire_dern_deque_iterator_next(&iter);
+            }
+        }
+        return result;
+
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            for (size_t i = 0; i < numElements; ++i)
+            {
+                result = octaspire_dern_value_private_combine_hashes(
+                    result,
+                    octaspire_dern_value_private_get_hash(
+                        octaspire_dern_persistent_vector_get_element_at(
+                            self->value.persistentVector,
+                            (ptrdiff_t)i),
+                        nextDepth));
+            }
+        }
+        return result;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            octaspire_dern_sorted_map_iterator_t iter =
+                octaspire_dern_sorted_map_iterator_init(self->value.sortedMap);
+
+            while (iter.key)
+            {
+                result = octaspire_dern_value_private_combine_hashes(
+                    result,
+                    octaspire_dern_value_private_get_hash(iter.key, nextDepth));
+
+                result = octaspire_dern_value_private_combine_hashes(
+                    result,
+                    octaspire_dern_value_private_get_hash(iter.value, nextDepth));
+
+                octaspire_dern_sorted_map_iterator_next(&iter);
+            }
+        }
+        return result;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(
+                    (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET) ?
+                        self->value.set :
+                        self->value.hashMap);
+
+            while (iter.element)
+            {
+                // Hashes of the keys are stored in the map already.
+                octaspire_dern_value_t const * const value =
+                    octaspire_dern_map_element_get_value_const(iter.element);
+
+                sum += octaspire_dern_value_private_combine_hashes(
+                    octaspire_dern_map_element_get_hash(iter.element),
+                    value ? octaspire_dern_value_private_get_hash(value, nextDepth) : 0);
+
+                octaspire_dern_map_element_const_iterator_next(&iter);
+            }
+        }
+        return octaspire_dern_value_private_combine_hashes(result, sum);
+
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        {
+            for (size_t i = 0; i < numElements; ++i)
+            {
+                octaspire_dern_value_t *key   = 0;
+                octaspire_dern_value_t *value = 0;
+
+                octaspire_helpers_verify_true(
+                    octaspire_dern_persistent_map_get_at_index(
+                        self->value.persistentHashMap,
+                        (ptrdiff_t)i,
+                        &key,
+                        &value));
+
+                sum += octaspire_dern_value_private_combine_hashes(
+                    octaspire_dern_value_get_hash(key),
+                    octaspire_dern_value_private_get_hash(value, nextDepth));
+            }
+        }
+        return octaspire_dern_value_private_combine_hashes(result, sum);
+
+        default:
+        {
+            abort();
+        }
+    }
+
+    return result;
+}
+
 uint32_t octaspire_dern_value_get_hash(
     octaspire_dern_value_t const * const self)
+{
+    return octaspire_dern_value_private_get_hash(self, 0);
+}
+
+static uint32_t octaspire_dern_value_private_get_hash(
+    octaspire_dern_value_t const * const self,
+    size_t const depth)
 {
     switch (self->typeTag)
     {
@@ -1176,14 +1853,22 @@ uint32_t octaspire_dern_value_get_hash(
             return octaspire_helpers_calculate_hash_for_double_argument(self->value.real);
 
         case OCTASPIRE_DERN_VALUE_TAG_STRING:
-            return octaspire_string_get_hash(self->value.string);
+            return octaspire_dern_value_private_get_cached_hash_for_string(
+                self,
+                self->value.string);
 
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
+            if (self->hashIsCached)
+            {
+                return self->cachedHash;
+            }
+
             octaspire_string_t * str =
                 octaspire_semver_to_string(self->value.semver);
 
-            uint32_t const result = octaspire_string_get_hash(str);
+            uint32_t const result =
+                octaspire_dern_value_private_get_cached_hash_for_string(self, str);
 
             octaspire_string_release(str);
             str = 0;
@@ -1191,25 +1876,21 @@ uint32_t octaspire_dern_value_get_hash(
         }
 
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
-            return octaspire_string_get_hash(self->value.character);
+            return octaspire_dern_value_private_get_cached_hash_for_string(
+                self,
+                self->value.character);
 
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
-            return octaspire_string_get_hash(self->value.symbol);
+            return octaspire_dern_value_private_get_cached_hash_for_string(
+                self,
+                self->value.symbol);
 
         case OCTASPIRE_DERN_VALUE_TAG_ERROR:
             return octaspire_string_get_hash(self->value.error->message);
 
-        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
-            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.vector);
 
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
-            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.hashMap);
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
-            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.queue);
 
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
-            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.list);
 
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
             return octaspire_helpers_calculate_hash_for_void_pointer_argument(
@@ -1230,8 +1911,37 @@ uint32_t octaspire_dern_value_get_hash(
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
             return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.port);
 
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.cData);
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            return octaspire_helpers_calculate_hash_for_void_pointer_argument(self->value.cData);
+
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            return octaspire_helpers_calculate_hash_for_void_pointer_argument(
+                self->value.weakReference);
+
+
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            return octaspire_dern_typed_array_get_hash(self->value.typedArray);
+
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            return octaspire_dern_bytes_get_hash(self->value.bytes);
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+            return octaspire_dern_bytes_get_hash(self->value.stringBuilder);
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+            return octaspire_dern_helpers_calculate_hash_for_octets(
+                octaspire_dern_value_as_string_slice_get_octets(self),
+                self->value.stringSlice->numOctets);
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            return octaspire_dern_value_private_get_hash_for_composite(self, depth);
     }
 
     return 0;
@@ -1356,9 +2066,15 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
 
             case OCTASPIRE_DERN_VALUE_TAG_STRING:
             {
+                if (plain || !printReadably)
+                {
+                    // Copying avoids formatting and decoding the text again.
+                    return octaspire_dern_helpers_copy_string(self->value.string, allocator);
+                }
+
                 return octaspire_string_new_format(
                     allocator,
-                    (plain || !printReadably) ? "%s" :"[%s]",
+                    "[%s]",
                     octaspire_string_get_c_string(self->value.string));
             }
 
@@ -1393,19 +2109,22 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                         (plain || !printReadably) ? "\t" :"|tab|",
                         allocator);
                 }
+                else if (plain || !printReadably)
+                {
+                    return octaspire_dern_helpers_copy_string(self->value.character, allocator);
+                }
                 else
                 {
                     return octaspire_string_new_format(
                         allocator,
-                        (plain || !printReadably) ? "%s" : "|%s|",
+                        "|%s|",
                         octaspire_string_get_c_string(self->value.character));
                 }
             }
 
             case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
             {
-                return octaspire_string_new_format(allocator, "%s",
-                    octaspire_string_get_c_string(self->value.symbol));
+                return octaspire_dern_helpers_copy_string(self->value.symbol, allocator);
             }
 
             case OCTASPIRE_DERN_VALUE_TAG_ERROR:
@@ -1465,24 +2184,25 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
 
             case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
             {
-                octaspire_string_t *result =
-                    octaspire_string_new("(hash-map ", allocator);
+                octaspire_string_t *result = octaspire_string_new(
+                    self->hashMapHasWeakKeys ? "(weak-hash-map " : "(hash-map ",
+                    allocator);
 
                 octaspire_helpers_verify_not_null(result);
 
                 for (size_t i = 0;
-                     i < octaspire_map_get_number_of_elements(
+                     i < octaspire_dern_map_get_number_of_elements(
                          self->value.hashMap);
                     ++i)
                 {
-                    octaspire_map_element_t *element =
-                        octaspire_map_get_at_index(
+                    octaspire_dern_map_element_t *element =
+                        octaspire_dern_map_get_at_index(
                             self->value.hashMap,
                             (ptrdiff_t)i);
 
                     // Key
                     octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
-                        octaspire_map_element_get_key(element),
+                        octaspire_dern_map_element_get_key(element),
                         allocator);
 
                     octaspire_helpers_verify_not_null(tmpStr);
@@ -1507,7 +2227,106 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
 
                     // Value
                     tmpStr = octaspire_dern_value_to_string(
-                        octaspire_map_element_get_value(element),
+                        octaspire_dern_map_element_get_value(element),
+                        allocator);
+
+                    octaspire_helpers_verify_not_null(tmpStr);
+
+                    if (!octaspire_string_concatenate_c_string(
+                        result,
+                        octaspire_string_get_c_string(tmpStr)))
+                    {
+                        abort();
+                    }
+
+                    octaspire_string_release(tmpStr);
+                    tmpStr = 0;
+
+                    if ((i+1) < octaspire_dern_map_get_number_of_elements(
+                        self->value.hashMap))
+                    {
+                        octaspire_string_concatenate_c_string(
+                            result,
+                            "\n          ");
+                    }
+                }
+
+                if (!octaspire_string_concatenate_c_string(
+                    result,
+                    ")"))
+                {
+                    abort();
+                }
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            {
+                octaspire_string_t *result =
+                    octaspire_string_new("(queue ", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                octaspire_dern_deque_iterator_t iter =
+                    octaspire_dern_deque_iterator_init(self->value.queue);
+
+                while (iter.element)
+                {
+                    octaspire_dern_value_t *tmpValue = iter.element;
+
+                    octaspire_helpers_verify_not_null(tmpValue);
+
+                    octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
+                        tmpValue,
+                        allocator);
+
+                    octaspire_helpers_verify_not_null(tmpStr);
+
+                    if (!octaspire_string_concatenate_c_string(
+                        result,
+                        octaspire_string_get_c_string(tmpStr)))
+                    {
+                        abort();
+                    }
+
+                    octaspire_string_release(tmpStr);
+                    tmpStr = 0;
+
+                    if (octaspire_dern_deque_iterator_next(&iter))
+                    {
+                        octaspire_string_concatenate_c_string(result, " ");
+                    }
+                }
+
+                if (!octaspire_string_concatenate_c_string(
+                    result,
+                    ")"))
+                {
+                    abort();
+                }
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            {
+                octaspire_string_t *result =
+                    octaspire_string_new("(list ", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                octaspire_dern_deque_iterator_t iter =
+                    octaspire_dern_deque_iterator_init(self->value.list);
+
+                while (iter.element)
+                {
+                    octaspire_dern_value_t *tmpValue = iter.element;
+
+                    octaspire_helpers_verify_not_null(tmpValue);
+
+                    octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
+                        tmpValue,
                         allocator);
 
                     octaspire_helpers_verify_not_null(tmpStr);
@@ -1519,21 +2338,263 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                         abort();
                     }
 
-                    octaspire_string_release(tmpStr);
-                    tmpStr = 0;
+                    octaspire_string_release(tmpStr);
+                    tmpStr = 0;
+
+                    if (octaspire_dern_deque_iterator_next(&iter))
+                    {
+                        octaspire_string_concatenate_c_string(result, " ");
+                    }
+                }
+
+                if (!octaspire_string_concatenate_c_string(
+                    result,
+                    ")"))
+                {
+                    abort();
+                }
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+            {
+                return octaspire_dern_function_to_string(self->value.function, allocator);
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+            {
+                octaspire_string_t * tmpStr =
+                    octaspire_dern_function_to_string(self->value.function, allocator);
+
+                octaspire_helpers_verify_not_null(tmpStr);
+
+                octaspire_string_t * const result = octaspire_string_new_format(
+                    allocator,
+                    "macro %s",
+                    octaspire_string_get_c_string(tmpStr));
+
+                octaspire_helpers_verify_not_null(result);
+
+                octaspire_string_release(tmpStr);
+                tmpStr = 0;
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+            {
+                return octaspire_dern_builtin_to_string(self->value.builtin, allocator);
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_PORT:
+            {
+                return octaspire_dern_port_to_string(self->value.port, allocator);
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+            {
+                return octaspire_dern_c_data_to_string(self->value.cData, allocator);
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+            {
+                if (!self->value.weakReference)
+                {
+                    return octaspire_string_new("<weak reference (collected)>", allocator);
+                }
+
+                octaspire_string_t * tmpStr = octaspire_dern_value_to_string(
+                    self->value.weakReference,
+                    allocator);
+
+                octaspire_helpers_verify_not_null(tmpStr);
+
+                octaspire_string_t * const result = octaspire_string_new_format(
+                    allocator,
+                    "<weak reference to %s>",
+                    octaspire_string_get_c_string(tmpStr));
+
+                octaspire_helpers_verify_not_null(result);
+
+                octaspire_string_release(tmpStr);
+                tmpStr = 0;
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+            {
+                octaspire_string_t *result =
+                    octaspire_string_new("(persistent-vector", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                for (size_t i = 0;
+                     i < octaspire_dern_persistent_vector_get_length(
+                         self->value.persistentVector);
+                     ++i)
+                {
+                    octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
+                        octaspire_dern_persistent_vector_get_element_at(
+                            self->value.persistentVector,
+                            (ptrdiff_t)i),
+                        allocator);
+
+                    octaspire_helpers_verify_not_null(tmpStr);
+
+                    if (!octaspire_string_concatenate_format(
+                        result,
+                        " %s",
+                        octaspire_string_get_c_string(tmpStr)))
+                    {
+                        abort();
+                    }
+
+                    octaspire_string_release(tmpStr);
+                    tmpStr = 0;
+                }
+
+                if (!octaspire_string_concatenate_c_string(result, ")"))
+                {
+                    abort();
+                }
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+            {
+                octaspire_string_t *result =
+                    octaspire_string_new("(persistent-hash-map", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                size_t const numElements = octaspire_dern_persistent_map_get_number_of_elements(
+                    self->value.persistentHashMap);
+
+                for (size_t i = 0; i < numElements; ++i)
+                {
+                    octaspire_dern_value_t *key   = 0;
+                    octaspire_dern_value_t *value = 0;
+
+                    octaspire_helpers_verify_true(
+                        octaspire_dern_persistent_map_get_at_index(
+                            self->value.persistentHashMap,
+                            (ptrdiff_t)i,
+                            &key,
+                            &value));
+
+                    octaspire_string_t *keyStr = octaspire_dern_value_to_string(key, allocator);
+                    octaspire_helpers_verify_not_null(keyStr);
+
+                    octaspire_string_t *valueStr = octaspire_dern_value_to_string(value, allocator);
+                    octaspire_helpers_verify_not_null(valueStr);
+
+                    if (!octaspire_string_concatenate_format(
+                        result,
+                        (i == 0) ? " %s %s" : "\n                     %s %s",
+                        octaspire_string_get_c_string(keyStr),
+                        octaspire_string_get_c_string(valueStr)))
+                    {
+                        abort();
+                    }
+
+                    octaspire_string_release(keyStr);
+                    keyStr = 0;
+
+                    octaspire_string_release(valueStr);
+                    valueStr = 0;
+                }
+
+                if (!octaspire_string_concatenate_c_string(result, ")"))
+                {
+                    abort();
+                }
+
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+            {
+                octaspire_dern_typed_array_t const * const typedArray =
+                    self->value.typedArray;
+
+                octaspire_dern_typed_array_element_type_t const elementType =
+                    octaspire_dern_typed_array_get_element_type(typedArray);
+
+                octaspire_string_t *result = octaspire_string_new_format(
+                    allocator,
+                    "(typed-array '%s",
+                    octaspire_dern_typed_array_element_type_get_name(elementType));
+
+                octaspire_helpers_verify_not_null(result);
+
+                bool const isInteger =
+                    octaspire_dern_typed_array_element_type_is_integer(elementType);
+
+                for (size_t i = 0; i < octaspire_dern_typed_array_get_length(typedArray); ++i)
+                {
+                    bool success = false;
+
+                    if (isInteger)
+                    {
+                        int64_t const element =
+                            octaspire_dern_typed_array_get_integer_at(typedArray, i);
+
+                        success = octaspire_string_concatenate_format(
+                            result,
+                            printReadably ? " %s%" PRId64 "}" : " %s%" PRId64,
+                            printReadably ? ((element >= 0) ? "{D+" : "{D") : "",
+                            element);
+                    }
+                    else
+                    {
+                        double const element =
+                            octaspire_dern_typed_array_get_real_at(typedArray, i);
+
+                        success = octaspire_string_concatenate_format(
+                            result,
+                            printReadably ? " %s%g}" : " %s%g",
+                            printReadably ? ((element >= 0) ? "{D+" : "{D") : "",
+                            element);
+                    }
+
+                    if (!success)
+                    {
+                        abort();
+                    }
+                }
+
+                if (!octaspire_string_concatenate_c_string(result, ")"))
+                {
+                    abort();
+                }
 
-                    if ((i+1) < octaspire_map_get_number_of_elements(
-                        self->value.hashMap))
-                    {
-                        octaspire_string_concatenate_c_string(
+                return result;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            {
+                octaspire_dern_bytes_t const * const bytes = self->value.bytes;
+
+                octaspire_string_t *result =
+                    octaspire_string_new("(bytes", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                for (size_t i = 0; i < octaspire_dern_bytes_get_length(bytes); ++i)
+                {
+                    if (!octaspire_string_concatenate_format(
                             result,
-                            "\n          ");
+                            printReadably ? " {D+%u}" : " %u",
+                            (unsigned int)octaspire_dern_bytes_get_octet_at(bytes, i)))
+                    {
+                        abort();
                     }
                 }
 
-                if (!octaspire_string_concatenate_c_string(
-                    result,
-                    ")"))
+                if (!octaspire_string_concatenate_c_string(result, ")"))
                 {
                     abort();
                 }
@@ -1541,25 +2602,42 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                 return result;
             }
 
-            case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
             {
-                octaspire_string_t *result =
-                    octaspire_string_new("(queue ", allocator);
+                octaspire_string_t * const result = octaspire_string_new_from_buffer(
+                    (char const*)octaspire_dern_bytes_get_octets(self->value.stringBuilder),
+                    octaspire_dern_bytes_get_length(self->value.stringBuilder),
+                    allocator);
 
                 octaspire_helpers_verify_not_null(result);
 
-                // Add iterator into queue and use it here
-                for (size_t i = 0; i < octaspire_queue_get_length(self->value.queue); ++i)
+                if (plain || !printReadably)
                 {
-                    octaspire_dern_value_t *tmpValue =
-                        octaspire_queue_get_at(
-                            self->value.queue,
-                            (ptrdiff_t)i);
+                    return result;
+                }
 
-                    octaspire_helpers_verify_not_null(tmpValue);
+                octaspire_string_t * const readable = octaspire_string_new_format(
+                    allocator,
+                    "(string-builder [%s])",
+                    octaspire_string_get_c_string(result));
+
+                octaspire_string_release(result);
+                return readable;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_SET:
+            {
+                octaspire_string_t *result = octaspire_string_new("(set ", allocator);
+
+                octaspire_helpers_verify_not_null(result);
+
+                octaspire_dern_map_element_const_iterator_t iter =
+                    octaspire_dern_map_element_const_iterator_init(self->value.set);
 
+                while (iter.element)
+                {
                     octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
-                        tmpValue,
+                        octaspire_dern_map_element_get_key_const(iter.element),
                         allocator);
 
                     octaspire_helpers_verify_not_null(tmpStr);
@@ -1574,7 +2652,7 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                     octaspire_string_release(tmpStr);
                     tmpStr = 0;
 
-                    if ((i+1) < octaspire_queue_get_length(self->value.queue))
+                    if (octaspire_dern_map_element_const_iterator_next(&iter))
                     {
                         octaspire_string_concatenate_c_string(result, " ");
                     }
@@ -1590,33 +2668,58 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                 return result;
             }
 
-            case OCTASPIRE_DERN_VALUE_TAG_LIST:
+            case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
             {
-                octaspire_string_t *result =
-                    octaspire_string_new("(list ", allocator);
+                octaspire_string_t * const result = octaspire_string_new_from_buffer(
+                    octaspire_dern_value_as_string_slice_get_octets(self),
+                    self->value.stringSlice->numOctets,
+                    allocator);
 
                 octaspire_helpers_verify_not_null(result);
 
-                // More efficient iteration
-                for (size_t i = 0; i < octaspire_list_get_length(self->value.list); ++i)
+                if (plain || !printReadably)
                 {
-                    octaspire_dern_value_t *tmpValue =
-                        octaspire_list_node_get_element(
-                            octaspire_list_get_at(
-                                self->value.list,
-                                (ptrdiff_t)i));
+                    return result;
+                }
 
-                    octaspire_helpers_verify_not_null(tmpValue);
+                octaspire_string_t * const readable = octaspire_string_new_format(
+                    allocator,
+                    "(string-slice [%s])",
+                    octaspire_string_get_c_string(result));
+
+                octaspire_string_release(result);
+                return readable;
+            }
+
+            case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+            {
+                octaspire_string_t *result =
+                    octaspire_string_new("(sorted-map ", allocator);
+
+                octaspire_helpers_verify_not_null(result);
 
+                octaspire_dern_sorted_map_iterator_t iter =
+                    octaspire_dern_sorted_map_iterator_init(self->value.sortedMap);
+
+                while (iter.key)
+                {
                     octaspire_string_t *tmpStr = octaspire_dern_value_to_string(
-                        tmpValue,
+                        iter.key,
                         allocator);
 
                     octaspire_helpers_verify_not_null(tmpStr);
 
-                    if (!octaspire_string_concatenate_c_string(
+                    octaspire_string_t *tmpStr2 = octaspire_dern_value_to_string(
+                        iter.value,
+                        allocator);
+
+                    octaspire_helpers_verify_not_null(tmpStr2);
+
+                    if (!octaspire_string_concatenate_format(
                         result,
-                        octaspire_string_get_c_string(tmpStr)))
+                        "%s %s",
+                        octaspire_string_get_c_string(tmpStr),
+                        octaspire_string_get_c_string(tmpStr2)))
                     {
                         abort();
                     }
@@ -1624,7 +2727,10 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                     octaspire_string_release(tmpStr);
                     tmpStr = 0;
 
-                    if ((i+1) < octaspire_list_get_length(self->value.list))
+                    octaspire_string_release(tmpStr2);
+                    tmpStr2 = 0;
+
+                    if (octaspire_dern_sorted_map_iterator_next(&iter))
                     {
                         octaspire_string_concatenate_c_string(result, " ");
                     }
@@ -1640,46 +2746,6 @@ octaspire_string_t *octaspire_dern_private_value_to_string(
                 return result;
             }
 
-            case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
-            {
-                return octaspire_dern_function_to_string(self->value.function, allocator);
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-            {
-                octaspire_string_t * tmpStr =
-                    octaspire_dern_function_to_string(self->value.function, allocator);
-
-                octaspire_helpers_verify_not_null(tmpStr);
-
-                octaspire_string_t * const result = octaspire_string_new_format(
-                    allocator,
-                    "macro %s",
-                    octaspire_string_get_c_string(tmpStr));
-
-                octaspire_helpers_verify_not_null(result);
-
-                octaspire_string_release(tmpStr);
-                tmpStr = 0;
-
-                return result;
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
-            {
-                return octaspire_dern_builtin_to_string(self->value.builtin, allocator);
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_PORT:
-            {
-                return octaspire_dern_port_to_string(self->value.port, allocator);
-            }
-
-            case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
-            {
-                return octaspire_dern_c_data_to_string(self->value.cData, allocator);
-            }
-
             case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
             {
                 return octaspire_dern_special_to_string(self->value.special, allocator);
@@ -1790,141 +2856,383 @@ bool octaspire_dern_value_is_queue(
     return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE;
 }
 
-bool octaspire_dern_value_is_list(
+bool octaspire_dern_value_is_list(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST;
+}
+
+bool octaspire_dern_value_is_port(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PORT;
+}
+
+bool octaspire_dern_value_is_environment(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT;
+}
+
+bool octaspire_dern_value_is_error(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR;
+}
+
+void octaspire_dern_value_as_error_set_line_number(
+    octaspire_dern_value_t const * const self,
+    size_t const lineNumber)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR);
+    self->value.error->lineNumber = lineNumber;
+}
+
+char const *octaspire_dern_value_as_error_get_c_string(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR);
+    return octaspire_string_get_c_string(self->value.error->message);
+}
+
+octaspire_dern_environment_t *octaspire_dern_value_as_environment_get_value(
+    octaspire_dern_value_t * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    return self->value.environment;
+}
+
+octaspire_dern_environment_t const *octaspire_dern_value_as_environment_get_value_const(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
+    return self->value.environment;
+}
+
+bool octaspire_dern_value_is_callable(
+    octaspire_dern_value_t const * const self)
+{
+    if (octaspire_dern_value_is_function(self))
+    {
+        return true;
+    }
+
+    if (octaspire_dern_value_is_macro(self))
+    {
+        return true;
+    }
+
+    if (octaspire_dern_value_is_builtin(self))
+    {
+        return true;
+    }
+
+    if (octaspire_dern_value_is_special(self))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+bool octaspire_dern_value_is_function(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_FUNCTION;
+}
+
+bool octaspire_dern_value_is_macro(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_MACRO;
+}
+
+bool octaspire_dern_value_is_builtin(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BUILTIN;
+}
+
+bool octaspire_dern_value_is_special(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SPECIAL;
+}
+
+bool octaspire_dern_value_is_howto_allowed(
+    octaspire_dern_value_t const * const self)
+{
+    // TODO XXX make user functions to support setting
+    // howto
+    octaspire_helpers_verify_true(
+        octaspire_dern_value_is_builtin(self)  ||
+        octaspire_dern_value_is_special(self)  ||
+        octaspire_dern_value_is_function(self) ||
+        octaspire_dern_value_is_macro(self));
+
+    return self->howtoAllowed;
+}
+
+bool octaspire_dern_value_is_c_data(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA;
+}
+
+octaspire_dern_c_data_t *octaspire_dern_value_as_c_data_get_value(
+    octaspire_dern_value_t * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA);
+    return self->value.cData;
+}
+
+octaspire_dern_c_data_t const *octaspire_dern_value_as_c_data_get_value_const(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA);
+    return self->value.cData;
+}
+
+bool octaspire_dern_value_is_weak_reference(
+    octaspire_dern_value_t const * const self)
+{
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE;
+}
+
+octaspire_dern_value_t *octaspire_dern_value_as_weak_reference_get_value(
+    octaspire_dern_value_t * const self)
+{
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE);
+
+    return self->value.weakReference;
+}
+
+bool octaspire_dern_value_as_hash_map_has_weak_keys(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
+    return self->hashMapHasWeakKeys;
+}
+
+bool octaspire_dern_value_is_persistent_vector(
     octaspire_dern_value_t const * const self)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR;
 }
 
-bool octaspire_dern_value_is_port(
+bool octaspire_dern_value_is_persistent_hash_map(
     octaspire_dern_value_t const * const self)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PORT;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP;
 }
 
-bool octaspire_dern_value_is_environment(
+bool octaspire_dern_value_is_typed_array(
     octaspire_dern_value_t const * const self)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY;
 }
 
-bool octaspire_dern_value_is_error(
+bool octaspire_dern_value_is_bytes(
     octaspire_dern_value_t const * const self)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES;
 }
 
-void octaspire_dern_value_as_error_set_line_number(
-    octaspire_dern_value_t const * const self,
-    size_t const lineNumber)
+bool octaspire_dern_value_is_string_builder(
+    octaspire_dern_value_t const * const self)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR);
-    self->value.error->lineNumber = lineNumber;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER;
 }
 
-char const *octaspire_dern_value_as_error_get_c_string(
+bool octaspire_dern_value_is_set(
     octaspire_dern_value_t const * const self)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR);
-    return octaspire_string_get_c_string(self->value.error->message);
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET;
 }
 
-octaspire_dern_environment_t *octaspire_dern_value_as_environment_get_value(
-    octaspire_dern_value_t * const self)
+bool octaspire_dern_value_is_sorted_map(
+    octaspire_dern_value_t const * const self)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
-    return self->value.environment;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP;
 }
 
-octaspire_dern_environment_t const *octaspire_dern_value_as_environment_get_value_const(
+bool octaspire_dern_value_is_string_slice(
     octaspire_dern_value_t const * const self)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT);
-    return self->value.environment;
+    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE;
 }
 
-bool octaspire_dern_value_is_callable(
+bool octaspire_dern_value_is_transient(
     octaspire_dern_value_t const * const self)
 {
-    if (octaspire_dern_value_is_function(self))
-    {
-        return true;
-    }
+    return self->isTransient;
+}
 
-    if (octaspire_dern_value_is_macro(self))
-    {
-        return true;
-    }
+void octaspire_dern_value_set_transient(
+    octaspire_dern_value_t * const self,
+    bool const transient)
+{
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR ||
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
 
-    if (octaspire_dern_value_is_builtin(self))
-    {
-        return true;
-    }
+    self->isTransient = transient;
+}
 
-    if (octaspire_dern_value_is_special(self))
-    {
-        return true;
-    }
+octaspire_dern_value_t *octaspire_dern_value_as_persistent_vector_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR);
 
-    return false;
+    return octaspire_dern_persistent_vector_get_element_at(
+        self->value.persistentVector,
+        possiblyNegativeIndex);
 }
 
-bool octaspire_dern_value_is_function(
-    octaspire_dern_value_t const * const self)
+bool octaspire_dern_value_as_persistent_vector_set_element_at(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t * const value)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_FUNCTION;
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR);
+
+    return octaspire_dern_persistent_vector_set_element_at(
+        self->value.persistentVector,
+        possiblyNegativeIndex,
+        value);
 }
 
-bool octaspire_dern_value_is_macro(
-    octaspire_dern_value_t const * const self)
+bool octaspire_dern_value_as_persistent_vector_push_back_element(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const value)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_MACRO;
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR);
+
+    return octaspire_dern_persistent_vector_push_back_element(
+        self->value.persistentVector,
+        value);
 }
 
-bool octaspire_dern_value_is_builtin(
-    octaspire_dern_value_t const * const self)
+octaspire_dern_value_t *octaspire_dern_value_as_persistent_hash_map_get(
+    octaspire_dern_value_t const * const self,
+    octaspire_dern_value_t const * const key)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BUILTIN;
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
+
+    return octaspire_dern_persistent_map_get(
+        self->value.persistentHashMap,
+        octaspire_dern_value_get_hash(key),
+        key);
 }
 
-bool octaspire_dern_value_is_special(
-    octaspire_dern_value_t const * const self)
+bool octaspire_dern_value_as_persistent_hash_map_get_at_index(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex,
+    octaspire_dern_value_t ** const key,
+    octaspire_dern_value_t ** const value)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SPECIAL;
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
+
+    return octaspire_dern_persistent_map_get_at_index(
+        self->value.persistentHashMap,
+        possiblyNegativeIndex,
+        key,
+        value);
 }
 
-bool octaspire_dern_value_is_howto_allowed(
-    octaspire_dern_value_t const * const self)
+bool octaspire_dern_value_as_persistent_hash_map_put(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
 {
-    // TODO XXX make user functions to support setting
-    // howto
     octaspire_helpers_verify_true(
-        octaspire_dern_value_is_builtin(self)  ||
-        octaspire_dern_value_is_special(self)  ||
-        octaspire_dern_value_is_function(self) ||
-        octaspire_dern_value_is_macro(self));
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
 
-    return self->howtoAllowed;
+    return octaspire_dern_persistent_map_put(
+        self->value.persistentHashMap,
+        octaspire_dern_value_get_hash(key),
+        key,
+        value);
 }
 
-bool octaspire_dern_value_is_c_data(
-    octaspire_dern_value_t const * const self)
+bool octaspire_dern_value_as_persistent_hash_map_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key)
 {
-    return self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA;
+    octaspire_helpers_verify_true(
+        self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
+
+    return octaspire_dern_persistent_map_remove(
+        self->value.persistentHashMap,
+        octaspire_dern_value_get_hash(key),
+        key);
 }
 
-octaspire_dern_c_data_t *octaspire_dern_value_as_c_data_get_value(
-    octaspire_dern_value_t * const self)
+octaspire_dern_value_t *octaspire_dern_value_as_typed_array_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA);
-    return self->value.cData;
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY);
+
+    octaspire_dern_typed_array_t const * const typedArray = self->value.typedArray;
+    ptrdiff_t const length = (ptrdiff_t)octaspire_dern_typed_array_get_length(typedArray);
+
+    ptrdiff_t const index = (possiblyNegativeIndex < 0) ?
+        (length + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (index < 0 || index >= length)
+    {
+        return 0;
+    }
+
+    if (!octaspire_dern_typed_array_element_type_is_integer(
+            octaspire_dern_typed_array_get_element_type(typedArray)))
+    {
+        return octaspire_dern_vm_create_new_value_real(
+            self->vm,
+            octaspire_dern_typed_array_get_real_at(typedArray, (size_t)index));
+    }
+
+    int64_t const element =
+        octaspire_dern_typed_array_get_integer_at(typedArray, (size_t)index);
+
+    // Integer values of Dern have 32 bits, larger elements are given as reals.
+    if (element < INT32_MIN || element > INT32_MAX)
+    {
+        return octaspire_dern_vm_create_new_value_real(self->vm, (double)element);
+    }
+
+    return octaspire_dern_vm_create_new_value_integer(self->vm, (int32_t)element);
 }
 
-octaspire_dern_c_data_t const *octaspire_dern_value_as_c_data_get_value_const(
-    octaspire_dern_value_t const * const self)
+octaspire_dern_value_t *octaspire_dern_value_as_bytes_get_element_at(
+    octaspire_dern_value_t const * const self,
+    ptrdiff_t const possiblyNegativeIndex)
 {
-    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_C_DATA);
-    return self->value.cData;
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES);
+
+    ptrdiff_t const length = (ptrdiff_t)octaspire_dern_bytes_get_length(self->value.bytes);
+
+    ptrdiff_t const index = (possiblyNegativeIndex < 0) ?
+        (length + possiblyNegativeIndex) :
+        possiblyNegativeIndex;
+
+    if (index < 0 || index >= length)
+    {
+        return 0;
+    }
+
+    return octaspire_dern_vm_create_new_value_integer(
+        self->vm,
+        octaspire_dern_bytes_get_octet_at(self->value.bytes, (size_t)index));
 }
 
 void octaspire_dern_value_print(
@@ -1954,6 +3262,8 @@ void octaspire_dern_value_as_boolean_set_value(
     octaspire_dern_value_t * const self,
     bool const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_BOOLEAN);
     self->value.boolean = value;
 }
@@ -1969,6 +3279,8 @@ void octaspire_dern_value_as_integer_set_value(
     octaspire_dern_value_t * const self,
     int32_t const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER);
     self->value.integer = value;
 }
@@ -1984,6 +3296,8 @@ void octaspire_dern_value_as_real_set_value(
     octaspire_dern_value_t * const self,
     double const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_REAL);
     self->value.real = value;
 }
@@ -1992,6 +3306,8 @@ void octaspire_dern_value_as_number_set_value(
     octaspire_dern_value_t * const self,
     double const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(
         octaspire_dern_value_is_number(self));
 
@@ -2022,12 +3338,104 @@ bool octaspire_dern_value_as_hash_map_remove(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const keyValue)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
 
-    return octaspire_map_remove(
+    return octaspire_dern_map_remove(
         self->value.hashMap,
         octaspire_dern_value_get_hash(keyValue),
-        &keyValue);
+        keyValue);
+}
+
+bool octaspire_dern_value_as_set_add(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const element)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET);
+
+    uint32_t const hash = octaspire_dern_value_get_hash(element);
+
+    if (octaspire_dern_map_get_const(self->value.set, hash, element))
+    {
+        return true;
+    }
+
+    octaspire_dern_value_t * const tmpElementForInsertion =
+        octaspire_dern_value_is_atom(element) ?
+        octaspire_dern_vm_create_new_value_copy(self->vm, element) :
+        octaspire_dern_value_private_get_key_for_insertion(self, element);
+
+    // Elements of sets have no values.
+    return octaspire_dern_map_put(
+        self->value.set,
+        hash,
+        tmpElementForInsertion,
+        0);
+}
+
+bool octaspire_dern_value_as_set_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const element)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET);
+
+    return octaspire_dern_map_remove(
+        self->value.set,
+        octaspire_dern_value_get_hash(element),
+        element);
+}
+
+bool octaspire_dern_value_as_set_contains(
+    octaspire_dern_value_t const * const self,
+    octaspire_dern_value_t const * const element)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET);
+
+    return octaspire_dern_map_get_const(
+        self->value.set,
+        octaspire_dern_value_get_hash(element),
+        element) != 0;
+}
+
+bool octaspire_dern_value_as_sorted_map_put(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t * const key,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP);
+
+    octaspire_dern_vm_push_value(self->vm, key);
+    octaspire_dern_vm_push_value(self->vm, value);
+
+    octaspire_dern_value_t * const tmpKeyForInsertion =
+        octaspire_dern_value_is_atom(key) ?
+        octaspire_dern_vm_create_new_value_copy(self->vm, key) :
+        octaspire_dern_value_private_get_key_for_insertion(self, key);
+
+    octaspire_dern_vm_push_value(self->vm, tmpKeyForInsertion);
+
+    octaspire_dern_value_t * const tmpValueForInsertion =
+        octaspire_dern_value_is_atom(value) ?
+        octaspire_dern_vm_create_new_value_copy(self->vm, value) :
+        value;
+
+    octaspire_dern_vm_pop_value(self->vm, tmpKeyForInsertion);
+    octaspire_dern_vm_pop_value(self->vm, value);
+    octaspire_dern_vm_pop_value(self->vm, key);
+
+    return octaspire_dern_sorted_map_put(
+        self->value.sortedMap,
+        tmpKeyForInsertion,
+        tmpValueForInsertion);
+}
+
+bool octaspire_dern_value_as_sorted_map_remove(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP);
+    return octaspire_dern_sorted_map_remove(self->value.sortedMap, key);
 }
 
 octaspire_dern_function_t *octaspire_dern_value_as_function(
@@ -2049,6 +3457,8 @@ bool octaspire_dern_value_as_hash_map_add(
     octaspire_dern_value_t * const toBeAdded1,
     octaspire_dern_value_t * const toBeAdded2)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
 
     switch (toBeAdded1->typeTag)
@@ -2062,7 +3472,7 @@ bool octaspire_dern_value_as_hash_map_add(
         {
             octaspire_helpers_verify_null(toBeAdded2);
 
-            return octaspire_map_add_hash_map(
+            return octaspire_dern_map_add_map(
                 self->value.hashMap,
                 toBeAdded1->value.hashMap);
         }
@@ -2123,6 +3533,15 @@ bool octaspire_dern_value_as_hash_map_add(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             if (!toBeAdded2)
@@ -2152,35 +3571,41 @@ bool octaspire_dern_value_as_queue_push(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const toBeAdded)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE);
 if (octaspire_dern_value_is_atom(toBeAdded))
     {
         octaspire_dern_value_t * const copyVal =
             octaspire_dern_vm_create_new_value_copy(self->vm, toBeAdded);
 
-        return octaspire_queue_push(self->value.queue, &copyVal);
+        return octaspire_dern_deque_push_back(self->value.queue, copyVal);
     }
 
-    return octaspire_queue_push(self->value.queue, &toBeAdded);
+    return octaspire_dern_deque_push_back(self->value.queue, toBeAdded);
 }
 
 bool octaspire_dern_value_as_queue_pop(octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE);
-    return octaspire_queue_pop(self->value.queue);
+    return octaspire_dern_deque_pop_front(self->value.queue);
 }
 
 size_t octaspire_dern_value_as_queue_get_length(
     octaspire_dern_value_t const * const self)
 {
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE);
-    return octaspire_queue_get_length(self->value.queue);
+    return octaspire_dern_deque_get_length(self->value.queue);
 }
 
 bool octaspire_dern_value_as_list_push_back(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const toBeAdded)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST);
 
     if (octaspire_dern_value_is_atom(toBeAdded))
@@ -2188,35 +3613,41 @@ bool octaspire_dern_value_as_list_push_back(
         octaspire_dern_value_t * const copyVal =
             octaspire_dern_vm_create_new_value_copy(self->vm, toBeAdded);
 
-        return octaspire_list_push_back(self->value.list, &copyVal);
+        return octaspire_dern_deque_push_back(self->value.list, copyVal);
     }
 
-    return octaspire_list_push_back(self->value.list, &toBeAdded);
+    return octaspire_dern_deque_push_back(self->value.list, toBeAdded);
 }
 
 bool octaspire_dern_value_as_list_pop_back(octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST);
-    return octaspire_list_pop_back(self->value.list);
+    return octaspire_dern_deque_pop_back(self->value.list);
 }
 
 bool octaspire_dern_value_as_list_pop_front(octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST);
-    return octaspire_list_pop_front(self->value.list);
+    return octaspire_dern_deque_pop_front(self->value.list);
 }
 
 size_t octaspire_dern_value_as_list_get_length(
     octaspire_dern_value_t const * const self)
 {
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST);
-    return octaspire_list_get_length(self->value.list);
+    return octaspire_dern_deque_get_length(self->value.list);
 }
 
 bool octaspire_dern_value_as_character_add(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER);
 
     switch (other->typeTag)
@@ -2246,7 +3677,7 @@ bool octaspire_dern_value_as_character_add(
 
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         {
-           octaspire_string_t *newStr = octaspire_string_new_copy(
+           octaspire_string_t *newStr = octaspire_dern_helpers_copy_string(
                 self->value.character,
                 octaspire_dern_vm_get_allocator(self->vm));
 
@@ -2279,6 +3710,15 @@ bool octaspire_dern_value_as_character_add(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2293,6 +3733,8 @@ bool octaspire_dern_value_as_character_subtract(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER);
 
     switch (other->typeTag)
@@ -2354,6 +3796,15 @@ bool octaspire_dern_value_as_character_subtract(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2368,6 +3819,8 @@ bool octaspire_dern_value_as_integer_add(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER);
 
     switch (other->typeTag)
@@ -2461,6 +3914,15 @@ bool octaspire_dern_value_as_integer_add(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2475,6 +3937,8 @@ bool octaspire_dern_value_as_integer_subtract(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER);
 
     switch (other->typeTag)
@@ -2568,6 +4032,15 @@ bool octaspire_dern_value_as_integer_subtract(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2582,6 +4055,8 @@ bool octaspire_dern_value_as_semver_add_or_subtract(
     octaspire_dern_value_t * const other,
     bool                     const add)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
 
     switch (other->typeTag)
@@ -2618,6 +4093,15 @@ bool octaspire_dern_value_as_semver_add_or_subtract(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
             return false;
         }
@@ -2629,6 +4113,8 @@ bool octaspire_dern_value_as_semver_add_or_subtract(
 bool octaspire_dern_value_as_semver_pop_back(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
     return octaspire_semver_pop_back(self->value.semver);
 }
@@ -2636,6 +4122,8 @@ bool octaspire_dern_value_as_semver_pop_back(
 bool octaspire_dern_value_as_semver_pop_front(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SEMVER);
     return octaspire_semver_pop_front(self->value.semver);
 }
@@ -2645,6 +4133,8 @@ bool octaspire_dern_value_as_real_add(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_REAL);
 
     switch (other->typeTag)
@@ -2733,6 +4223,15 @@ bool octaspire_dern_value_as_real_add(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2747,6 +4246,8 @@ bool octaspire_dern_value_as_real_subtract(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const other)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_REAL);
 
     switch (other->typeTag)
@@ -2835,6 +4336,15 @@ bool octaspire_dern_value_as_real_subtract(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -2856,6 +4366,8 @@ bool octaspire_dern_value_as_string_push_back(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
 
     switch (value->typeTag)
@@ -2919,6 +4431,15 @@ bool octaspire_dern_value_as_string_push_back(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_string_t *tmpStr =
@@ -2940,6 +4461,8 @@ bool octaspire_dern_value_as_symbol_push_back(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
 
     switch (value->typeTag)
@@ -3003,6 +4526,15 @@ bool octaspire_dern_value_as_symbol_push_back(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_string_t *tmpStr =
@@ -3024,9 +4556,106 @@ bool octaspire_dern_value_as_symbol_push_back(
     return false;
 }
 
+bool octaspire_dern_value_as_string_builder_push_back(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const value)
+{
+    octaspire_dern_value_prepare_for_mutation(self);
+
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER);
+
+    switch (value->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+        case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
+        {
+            return octaspire_dern_bytes_push_back_buffer(
+                self->value.stringBuilder,
+                octaspire_dern_value_as_text_get_c_string(value),
+                octaspire_dern_value_as_text_get_length_in_octets(value));
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+        case OCTASPIRE_DERN_VALUE_TAG_REAL:
+        {
+            char buffer[64];
+
+            int const length = octaspire_dern_value_is_integer(value)
+                ? snprintf(buffer, sizeof(buffer), "%" PRId32, value->value.integer)
+                : snprintf(buffer, sizeof(buffer), "%g", value->value.real);
+
+            octaspire_helpers_verify_true(length > 0 && (size_t)length < sizeof(buffer));
+
+            return octaspire_dern_bytes_push_back_buffer(
+                self->value.stringBuilder,
+                buffer,
+                (size_t)length);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            return octaspire_dern_bytes_push_back_buffer(
+                self->value.stringBuilder,
+                octaspire_dern_bytes_get_octets(value->value.stringBuilder),
+                octaspire_dern_bytes_get_length(value->value.stringBuilder));
+        }
+
+        default:
+        {
+            octaspire_string_t *tmpStr =
+                octaspire_dern_value_to_string(value, octaspire_dern_vm_get_allocator(self->vm));
+
+            octaspire_helpers_verify_not_null(tmpStr);
+
+            bool const result = octaspire_dern_bytes_push_back_buffer(
+                self->value.stringBuilder,
+                octaspire_string_get_c_string(tmpStr),
+                octaspire_string_get_length_in_octets(tmpStr));
+
+            octaspire_string_release(tmpStr);
+            tmpStr = 0;
+
+            return result;
+        }
+    }
+}
+
+char const *octaspire_dern_value_as_string_slice_get_octets(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE);
+
+    octaspire_dern_string_slice_t const * const slice = self->value.stringSlice;
+
+    if (slice->octets)
+    {
+        return slice->octets;
+    }
+
+    return octaspire_string_get_c_string(self->copyOnWrite.source->value.string) +
+        slice->octetIndex;
+}
+
+size_t octaspire_dern_value_as_string_slice_get_length_in_octets(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE);
+    return self->value.stringSlice->numOctets;
+}
+
+size_t octaspire_dern_value_as_string_slice_get_length_in_ucs_characters(
+    octaspire_dern_value_t const * const self)
+{
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE);
+    return self->value.stringSlice->numUcsCharacters;
+}
+
 bool octaspire_dern_value_as_symbol_pop_back(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
     return octaspire_string_pop_back_ucs_character(self->value.symbol);
 }
@@ -3034,6 +4663,8 @@ bool octaspire_dern_value_as_symbol_pop_back(
 bool octaspire_dern_value_as_symbol_pop_front(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
     return octaspire_string_pop_front_ucs_character(self->value.symbol);
 }
@@ -3041,6 +4672,8 @@ bool octaspire_dern_value_as_symbol_pop_front(
 bool octaspire_dern_value_as_string_pop_back_ucs_character(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
 
     return octaspire_string_pop_back_ucs_character(self->value.string);
@@ -3049,6 +4682,8 @@ bool octaspire_dern_value_as_string_pop_back_ucs_character(
 bool octaspire_dern_value_as_string_pop_front_ucs_character(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
 
     return octaspire_string_pop_front_ucs_character(self->value.string);
@@ -3078,6 +4713,8 @@ bool octaspire_dern_value_as_string_remove_all_substrings(
     octaspire_dern_value_t * const self,
     octaspire_dern_value_t * const value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING);
 
     switch (value->typeTag)
@@ -3120,6 +4757,15 @@ bool octaspire_dern_value_as_string_remove_all_substrings(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
@@ -3220,6 +4866,8 @@ bool octaspire_dern_value_as_symbol_set_c_string(
     octaspire_dern_value_t * const self,
     char const * const str)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL);
     return octaspire_string_set_from_c_string(self->value.symbol, str);
 }
@@ -3303,6 +4951,15 @@ bool octaspire_dern_value_as_text_is_equal_to_c_string(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
             octaspire_helpers_verify_true(false);
         }
@@ -3353,6 +5010,15 @@ char const *octaspire_dern_value_as_text_get_c_string(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(false);
@@ -3367,6 +5033,8 @@ bool octaspire_dern_value_as_text_set_c_string(
     octaspire_dern_value_t * const self,
     char const * const str)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     switch (self->typeTag)
     {
         case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
@@ -3403,6 +5071,15 @@ bool octaspire_dern_value_as_text_set_c_string(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(false);
@@ -3454,6 +5131,15 @@ octaspire_string_t const *octaspire_dern_value_as_text_get_string_const(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(false);
@@ -3467,6 +5153,8 @@ octaspire_string_t const *octaspire_dern_value_as_text_get_string_const(
 octaspire_string_t *octaspire_dern_value_as_text_get_string(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     return (octaspire_string_t*)
         octaspire_dern_value_as_text_get_string_const(self);
 }
@@ -3515,6 +5203,15 @@ size_t octaspire_dern_value_as_text_get_length_in_octets(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(false);
@@ -3569,6 +5266,15 @@ size_t octaspire_dern_value_as_text_get_length_in_ucs_characters(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(false);
@@ -3608,6 +5314,8 @@ bool octaspire_dern_value_as_vector_push_front_element(
     octaspire_dern_value_t *self,
     void const *element)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_not_null(element);
 
@@ -3618,6 +5326,8 @@ bool octaspire_dern_value_as_vector_push_back_element(
     octaspire_dern_value_t *self,
     void const *element)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
     octaspire_helpers_verify_not_null(element);
 
@@ -3661,6 +5371,8 @@ bool octaspire_dern_value_as_text_push_back_character(
     octaspire_dern_value_t * const charVal =
         (octaspire_dern_value_t * const)element;
 
+    octaspire_dern_value_prepare_for_mutation(self);
+
     if (octaspire_dern_value_is_string(self))
     {
         return octaspire_string_push_back_ucs_character(
@@ -3683,6 +5395,8 @@ bool octaspire_dern_value_as_vector_remove_element_at(
     octaspire_dern_value_t *self,
     ptrdiff_t const possiblyNegativeIndex)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
     return octaspire_vector_remove_element_at(
@@ -3693,6 +5407,8 @@ bool octaspire_dern_value_as_vector_remove_element_at(
 bool octaspire_dern_value_as_vector_clear(
     octaspire_dern_value_t * const self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(
         self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
@@ -3701,6 +5417,8 @@ bool octaspire_dern_value_as_vector_clear(
 
 bool octaspire_dern_value_as_vector_pop_back_element(octaspire_dern_value_t *self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
     return octaspire_vector_pop_back_element(self->value.vector);
@@ -3708,6 +5426,8 @@ bool octaspire_dern_value_as_vector_pop_back_element(octaspire_dern_value_t *sel
 
 bool octaspire_dern_value_as_vector_pop_front_element(octaspire_dern_value_t *self)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
     return octaspire_vector_pop_front_element(self->value.vector);
@@ -3717,6 +5437,8 @@ octaspire_dern_value_t *octaspire_dern_value_as_vector_get_element_at(
     octaspire_dern_value_t * const self,
     ptrdiff_t const possiblyNegativeIndex)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR);
 
     return octaspire_vector_get_element_at(
@@ -4465,6 +6187,8 @@ octaspire_dern_value_t *octaspire_dern_value_as_vector_get_element_of_type_at(
     octaspire_dern_value_tag_t const typeTag,
     ptrdiff_t const possiblyNegativeIndex)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_dern_value_t * result =
         octaspire_dern_value_as_vector_get_element_at(
             self,
@@ -4521,17 +6245,22 @@ octaspire_dern_value_t *octaspire_dern_value_as_list_get_element_at(
     octaspire_dern_value_t * const self,
     ptrdiff_t const possiblyNegativeIndex)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST);
 
-    octaspire_list_node_t * const node =
-        octaspire_list_get_at(self->value.list, possiblyNegativeIndex);
+    return octaspire_dern_deque_get_at(self->value.list, possiblyNegativeIndex);
+}
 
-    if (!node)
-    {
-        return 0;
-    }
+octaspire_dern_value_t *octaspire_dern_value_as_queue_get_element_at(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    octaspire_dern_value_prepare_for_element_access(self);
+
+    octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE);
 
-    return octaspire_list_node_get_element(node);
+    return octaspire_dern_deque_get_at(self->value.queue, possiblyNegativeIndex);
 }
 
 // TODO how about as_vector, should it have void* replaced with octaspire_dern_value_t*?
@@ -4541,50 +6270,117 @@ bool octaspire_dern_value_as_hash_map_put(
     octaspire_dern_value_t const * const key,
     octaspire_dern_value_t *value)
 {
+    octaspire_dern_value_prepare_for_mutation(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
-    return octaspire_map_put(self->value.hashMap, hash, &key, &value);
+
+    octaspire_dern_vm_push_value(self->vm, value);
+
+    octaspire_dern_value_t * const tmpKeyForInsertion =
+        octaspire_dern_value_private_get_key_for_insertion(self, key);
+
+    octaspire_dern_vm_pop_value(self->vm, value);
+
+    return octaspire_dern_map_put(
+        self->value.hashMap,
+        hash,
+        tmpKeyForInsertion,
+        value);
 }
 
 size_t octaspire_dern_value_as_hash_map_get_number_of_elements(
     octaspire_dern_value_t const * const self)
 {
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
-    return octaspire_map_get_number_of_elements(self->value.hashMap);
+    return octaspire_dern_map_get_number_of_elements(self->value.hashMap);
 }
 
-octaspire_map_element_t *octaspire_dern_value_as_hash_map_get_at_index(
+octaspire_dern_map_element_t *octaspire_dern_value_as_hash_map_get_at_index(
     octaspire_dern_value_t * const self,
     ptrdiff_t const possiblyNegativeIndex)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
 
-    return octaspire_map_get_at_index(
+    return octaspire_dern_map_get_at_index(
         self->value.hashMap,
         possiblyNegativeIndex);
 }
 
-octaspire_map_element_t *octaspire_dern_value_as_hash_map_get(
+octaspire_dern_map_element_t *octaspire_dern_value_as_hash_map_get(
     octaspire_dern_value_t * const self,
     uint32_t const hash,
     octaspire_dern_value_t const * const key)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
-    return octaspire_map_get(self->value.hashMap, hash, &key);
+    return octaspire_dern_map_get(self->value.hashMap, hash, key);
 }
 
-octaspire_map_element_t const * octaspire_dern_value_as_hash_map_get_const(
+octaspire_dern_map_element_t const * octaspire_dern_value_as_hash_map_get_const(
     octaspire_dern_value_t const * const self,
     uint32_t const hash,
     octaspire_dern_value_t const * const key)
 {
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
-    return octaspire_map_get_const(self->value.hashMap, hash, &key);
+    return octaspire_dern_map_get_const(self->value.hashMap, hash, key);
+}
+
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_key_at_index(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    octaspire_dern_map_element_t * const element =
+        octaspire_dern_value_as_hash_map_get_at_index(self, possiblyNegativeIndex);
+
+    if (!element)
+    {
+        return 0;
+    }
+
+    return octaspire_dern_map_element_get_key(element);
+}
+
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_at_index(
+    octaspire_dern_value_t * const self,
+    ptrdiff_t const possiblyNegativeIndex)
+{
+    octaspire_dern_map_element_t * const element =
+        octaspire_dern_value_as_hash_map_get_at_index(self, possiblyNegativeIndex);
+
+    if (!element)
+    {
+        return 0;
+    }
+
+    return octaspire_dern_map_element_get_value(element);
+}
+
+octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value(
+    octaspire_dern_value_t * const self,
+    octaspire_dern_value_t const * const key)
+{
+    octaspire_dern_map_element_t * const element = octaspire_dern_value_as_hash_map_get(
+        self,
+        octaspire_dern_value_get_hash(key),
+        key);
+
+    if (!element)
+    {
+        return 0;
+    }
+
+    return octaspire_dern_map_element_get_value(element);
 }
 
 octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_for_symbol_key_using_c_string(
     octaspire_dern_value_t * const self,
     char const * const keySymbolsContentAsCString)
 {
+    octaspire_dern_value_prepare_for_element_access(self);
+
     octaspire_helpers_verify_true(self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
 
     octaspire_dern_value_t * const key = octaspire_dern_vm_create_new_value_symbol_from_c_string(
@@ -4593,7 +6389,7 @@ octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_for_symbol_ke
 
     octaspire_helpers_verify_not_null(key);
 
-    octaspire_map_element_t * const element = octaspire_dern_value_as_hash_map_get(
+    octaspire_dern_map_element_t * const element = octaspire_dern_value_as_hash_map_get(
         self,
         octaspire_dern_value_get_hash(key),
         key);
@@ -4603,7 +6399,7 @@ octaspire_dern_value_t *octaspire_dern_value_as_hash_map_get_value_for_symbol_ke
         return 0;
     }
 
-    return octaspire_map_element_get_value(element);
+    return octaspire_dern_map_element_get_value(element);
 }
 
 octaspire_dern_value_t const *
@@ -4623,7 +6419,7 @@ octaspire_dern_value_as_hash_map_get_value_for_symbol_key_using_c_string_const(
 
     octaspire_dern_vm_push_value(self->vm, key);
 
-    octaspire_map_element_t const * const element =
+    octaspire_dern_map_element_t const * const element =
         octaspire_dern_value_as_hash_map_get_const(
             self,
             octaspire_dern_value_get_hash(key),
@@ -4637,7 +6433,7 @@ octaspire_dern_value_as_hash_map_get_value_for_symbol_key_using_c_string_const(
         return 0;
     }
 
-    return octaspire_map_element_get_value(element);
+    return octaspire_dern_map_element_get_value(element);
 }
 
 size_t octaspire_dern_value_get_length(
@@ -4659,6 +6455,7 @@ size_t octaspire_dern_value_get_length(
         case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
         case OCTASPIRE_DERN_VALUE_TAG_REAL:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         {
             return 1;
@@ -4685,16 +6482,16 @@ size_t octaspire_dern_value_get_length(
         }
         case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
         {
-            return octaspire_map_get_number_of_elements(
+            return octaspire_dern_map_get_number_of_elements(
                 self->value.hashMap);
         }
         case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         {
-            return octaspire_queue_get_length(self->value.queue);
+            return octaspire_dern_deque_get_length(self->value.queue);
         }
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         {
-            return octaspire_list_get_length(self->value.list);
+            return octaspire_dern_deque_get_length(self->value.list);
         }
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
         {
@@ -4724,11 +6521,62 @@ size_t octaspire_dern_value_get_length(
                 octaspire_semver_get_num_pre_release_identifiers(self->value.semver) +
                 octaspire_semver_get_num_build_metadata_identifiers(self->value.semver);
         }
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            return octaspire_dern_persistent_vector_get_length(
+                self->value.persistentVector);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        {
+            return octaspire_dern_persistent_map_get_number_of_elements(
+                self->value.persistentHashMap);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            return octaspire_dern_typed_array_get_length(self->value.typedArray);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            return octaspire_dern_bytes_get_length(self->value.bytes);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            return octaspire_dern_bytes_get_length(self->value.stringBuilder);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            return octaspire_dern_map_get_number_of_elements(self->value.set);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            return octaspire_dern_sorted_map_get_number_of_elements(self->value.sortedMap);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            return self->value.stringSlice->numUcsCharacters;
+        }
     }
 
     return 0;
 }
 
+// A slice this many times shorter than its source, when the source is
+// at least 'OCTASPIRE_DERN_VALUE_PRIVATE_LONG_SLICE_SOURCE' octets, is
+// copied instead of keeping the source alive.
+#define OCTASPIRE_DERN_VALUE_PRIVATE_SHORT_SLICE_RATIO   16
+#define OCTASPIRE_DERN_VALUE_PRIVATE_LONG_SLICE_SOURCE 1024
+
+static bool octaspire_dern_value_private_is_short_slice(
+    octaspire_dern_value_t const * const self)
+{
+    size_t const sourceLength =
+        octaspire_string_get_length_in_octets(self->copyOnWrite.source->value.string);
+
+    return sourceLength >= OCTASPIRE_DERN_VALUE_PRIVATE_LONG_SLICE_SOURCE &&
+        self->value.stringSlice->numOctets * OCTASPIRE_DERN_VALUE_PRIVATE_SHORT_SLICE_RATIO <
+            sourceLength;
+}
+
 bool octaspire_dern_value_mark(octaspire_dern_value_t *self)
 {
     if (self->mark)
@@ -4746,6 +6594,19 @@ bool octaspire_dern_value_mark(octaspire_dern_value_t *self)
         }
     }
 
+    if (octaspire_dern_value_is_copy_on_write_pending(self))
+    {
+        if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE &&
+            octaspire_dern_value_private_is_short_slice(self))
+        {
+            // GC detaches the slice if nothing else marks the source.
+            return true;
+        }
+
+        // Shared storage is owned, and its elements marked, by the source.
+        return octaspire_dern_value_mark(self->copyOnWrite.source);
+    }
+
     if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
     {
         for (size_t i = 0;
@@ -4765,65 +6626,102 @@ bool octaspire_dern_value_mark(octaspire_dern_value_t *self)
             }
         }
     }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE)
+    {
+        // The target is not marked; GC clears the reference if nothing else does.
+        if (self->value.weakReference)
+        {
+            octaspire_dern_vm_add_weak_value(self->vm, self);
+        }
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP &&
+             self->hashMapHasWeakKeys)
+    {
+        // Values are marked by the GC only after their keys are found reachable.
+        octaspire_dern_vm_add_weak_value(self->vm, self);
+    }
     else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP)
     {
-        octaspire_map_element_iterator_t iter =
-            octaspire_map_element_iterator_init(self->value.hashMap);
+        octaspire_dern_map_element_iterator_t iter =
+            octaspire_dern_map_element_iterator_init(self->value.hashMap);
 
         while (iter.element)
         {
             if (!octaspire_dern_value_mark(
-                    octaspire_map_element_get_key(iter.element)))
+                    octaspire_dern_map_element_get_key(iter.element)))
             {
                 return false;
             }
 
             if (!octaspire_dern_value_mark(
-                    octaspire_map_element_get_value(iter.element)))
+                    octaspire_dern_map_element_get_value(iter.element)))
             {
                 return false;
             }
 
-            octaspire_map_element_iterator_next(&iter);
+            octaspire_dern_map_element_iterator_next(&iter);
         }
     }
-    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE)
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SET)
     {
-        // TODO Add iterator into queue and use it here
-        for (size_t i = 0; i < octaspire_queue_get_length(self->value.queue); ++i)
+        octaspire_dern_map_element_iterator_t iter =
+            octaspire_dern_map_element_iterator_init(self->value.set);
+
+        while (iter.element)
         {
-            octaspire_dern_value_t * const tmpVal =
-                octaspire_queue_get_at(
-                    self->value.queue,
-                    (ptrdiff_t)i);
+            if (!octaspire_dern_value_mark(
+                    octaspire_dern_map_element_get_key(iter.element)))
+            {
+                return false;
+            }
 
-            octaspire_helpers_verify_not_null(tmpVal);
+            octaspire_dern_map_element_iterator_next(&iter);
+        }
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP)
+    {
+        octaspire_dern_sorted_map_iterator_t iter =
+            octaspire_dern_sorted_map_iterator_init(self->value.sortedMap);
 
-            if (!octaspire_dern_value_mark(tmpVal))
+        while (iter.key)
+        {
+            if (!octaspire_dern_value_mark(iter.key) ||
+                !octaspire_dern_value_mark(iter.value))
             {
                 return false;
             }
+
+            octaspire_dern_sorted_map_iterator_next(&iter);
         }
     }
-    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST)
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_QUEUE)
     {
-        // TODO More efficient iteration
-        for (size_t i = 0;
-             i < octaspire_list_get_length(self->value.list);
-             ++i)
+        octaspire_dern_deque_iterator_t iter =
+            octaspire_dern_deque_iterator_init(self->value.queue);
+
+        while (iter.element)
         {
-            octaspire_dern_value_t * const tmpVal =
-                octaspire_list_node_get_element(
-                    octaspire_list_get_at(
-                        self->value.list,
-                        (ptrdiff_t)i));
+            if (!octaspire_dern_value_mark(iter.element))
+            {
+                return false;
+            }
 
-            octaspire_helpers_verify_not_null(tmpVal);
+            octaspire_dern_deque_iterator_next(&iter);
+        }
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_LIST)
+    {
+        octaspire_dern_deque_iterator_t iter =
+            octaspire_dern_deque_iterator_init(self->value.list);
 
-            if (!octaspire_dern_value_mark(tmpVal))
+        while (iter.element)
+        {
+            if (!octaspire_dern_value_mark(iter.element))
             {
                 return false;
             }
+
+            octaspire_dern_deque_iterator_next(&iter);
         }
     }
     else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_FUNCTION ||
@@ -4852,6 +6750,18 @@ bool octaspire_dern_value_mark(octaspire_dern_value_t *self)
     {
         return octaspire_dern_environment_mark(self->value.environment);
     }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR)
+    {
+        return octaspire_dern_persistent_vector_mark(
+            self->value.persistentVector,
+            octaspire_dern_vm_get_mark_epoch(self->vm));
+    }
+    else if (self->typeTag == OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP)
+    {
+        return octaspire_dern_persistent_map_mark(
+            self->value.persistentHashMap,
+            octaspire_dern_vm_get_mark_epoch(self->vm));
+    }
 
     return true;
 }
@@ -4911,8 +6821,16 @@ int octaspire_dern_value_compare(
             }
             else
             {
-                return octaspire_dern_value_as_integer_get_value(self) -
-                    octaspire_dern_value_as_integer_get_value(other);
+                int32_t const a = octaspire_dern_value_as_integer_get_value(self);
+                int32_t const b = octaspire_dern_value_as_integer_get_value(other);
+
+                // Difference of the integers could overflow.
+                if (a < b)
+                {
+                    return -1;
+                }
+
+                return (a > b) ? 1 : 0;
             }
         }
     }
@@ -4939,7 +6857,12 @@ int octaspire_dern_value_compare(
         }
         case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
         {
-            return self->value.integer - other->value.integer;
+            if (self->value.integer < other->value.integer)
+            {
+                return -1;
+            }
+
+            return (self->value.integer > other->value.integer) ? 1 : 0;
         }
         case OCTASPIRE_DERN_VALUE_TAG_REAL:
         {
@@ -5028,23 +6951,16 @@ int octaspire_dern_value_compare(
                     octaspire_dern_value_as_queue_get_length(other);
             }
 
-            octaspire_queue_iterator_t myIter =
-                octaspire_queue_iterator_init(self->value.queue);
+            octaspire_dern_deque_iterator_t myIter =
+                octaspire_dern_deque_iterator_init(self->value.queue);
 
-            octaspire_queue_iterator_t otherIter =
-                octaspire_queue_iterator_init(other->value.queue);
+            octaspire_dern_deque_iterator_t otherIter =
+                octaspire_dern_deque_iterator_init(other->value.queue);
 
-            while (myIter.iterator.currentNode)
+            while (myIter.element)
             {
-                octaspire_helpers_verify_not_null(otherIter.iterator.currentNode);
-
-                octaspire_dern_value_t const * const myVal =
-                    octaspire_list_node_get_element(
-                        myIter.iterator.currentNode);
-
-                octaspire_dern_value_t const * const otherVal =
-                    octaspire_list_node_get_element(
-                        otherIter.iterator.currentNode);
+                octaspire_dern_value_t const * const myVal    = myIter.element;
+                octaspire_dern_value_t const * const otherVal = otherIter.element;
 
                 octaspire_helpers_verify_not_null(myVal);
                 octaspire_helpers_verify_not_null(otherVal);
@@ -5056,8 +6972,8 @@ int octaspire_dern_value_compare(
                     return cmp;
                 }
 
-                octaspire_queue_iterator_next(&myIter);
-                octaspire_queue_iterator_next(&otherIter);
+                octaspire_dern_deque_iterator_next(&myIter);
+                octaspire_dern_deque_iterator_next(&otherIter);
             }
 
             return 0;
@@ -5071,23 +6987,16 @@ int octaspire_dern_value_compare(
                     octaspire_dern_value_as_list_get_length(other);
             }
 
-            octaspire_list_node_iterator_t myIter =
-                octaspire_list_node_iterator_init(self->value.list);
+            octaspire_dern_deque_iterator_t myIter =
+                octaspire_dern_deque_iterator_init(self->value.list);
 
-            octaspire_list_node_iterator_t otherIter =
-                octaspire_list_node_iterator_init(other->value.list);
+            octaspire_dern_deque_iterator_t otherIter =
+                octaspire_dern_deque_iterator_init(other->value.list);
 
-            while (myIter.currentNode)
+            while (myIter.element)
             {
-                octaspire_helpers_verify_not_null(otherIter.currentNode);
-
-                octaspire_dern_value_t const * const myVal =
-                    octaspire_list_node_get_element(
-                        myIter.currentNode);
-
-                octaspire_dern_value_t const * const otherVal =
-                    octaspire_list_node_get_element(
-                        otherIter.currentNode);
+                octaspire_dern_value_t const * const myVal    = myIter.element;
+                octaspire_dern_value_t const * const otherVal = otherIter.element;
 
                 octaspire_helpers_verify_not_null(myVal);
                 octaspire_helpers_verify_not_null(otherVal);
@@ -5099,8 +7008,8 @@ int octaspire_dern_value_compare(
                     return cmp;
                 }
 
-                octaspire_list_node_iterator_next(&myIter);
-                octaspire_list_node_iterator_next(&otherIter);
+                octaspire_dern_deque_iterator_next(&myIter);
+                octaspire_dern_deque_iterator_next(&otherIter);
             }
 
             return 0;
@@ -5136,6 +7045,192 @@ int octaspire_dern_value_compare(
         {
             return octaspire_dern_c_data_compare(self->value.cData, other->value.cData);
         }
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        {
+            return octaspire_dern_value_private_compare_void_pointers(
+                       self->value.weakReference, other->value.weakReference);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            size_t const length =
+                octaspire_dern_persistent_vector_get_length(self->value.persistentVector);
+
+            size_t const otherLength =
+                octaspire_dern_persistent_vector_get_length(other->value.persistentVector);
+
+            if (length != otherLength)
+            {
+                return (length < otherLength) ? -1 : 1;
+            }
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                int const cmp = octaspire_dern_value_compare(
+                    octaspire_dern_persistent_vector_get_element_at(
+                        self->value.persistentVector,
+                        (ptrdiff_t)i),
+                    octaspire_dern_persistent_vector_get_element_at(
+                        other->value.persistentVector,
+                        (ptrdiff_t)i));
+
+                if (cmp)
+                {
+                    return cmp;
+                }
+            }
+
+            return 0;
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        {
+            size_t const numElements = octaspire_dern_persistent_map_get_number_of_elements(
+                self->value.persistentHashMap);
+
+            size_t const otherNumElements = octaspire_dern_persistent_map_get_number_of_elements(
+                other->value.persistentHashMap);
+
+            if (numElements != otherNumElements)
+            {
+                return (numElements < otherNumElements) ? -1 : 1;
+            }
+
+            for (size_t i = 0; i < numElements; ++i)
+            {
+                octaspire_dern_value_t *key   = 0;
+                octaspire_dern_value_t *value = 0;
+
+                octaspire_helpers_verify_true(
+                    octaspire_dern_persistent_map_get_at_index(
+                        self->value.persistentHashMap,
+                        (ptrdiff_t)i,
+                        &key,
+                        &value));
+
+                octaspire_dern_value_t const * const otherValue =
+                    octaspire_dern_persistent_map_get(
+                        other->value.persistentHashMap,
+                        octaspire_dern_value_get_hash(key),
+                        key);
+
+                if (!otherValue)
+                {
+                    return 1;
+                }
+
+                int const cmp = octaspire_dern_value_compare(value, otherValue);
+
+                if (cmp)
+                {
+                    return cmp;
+                }
+            }
+
+            return 0;
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            return octaspire_dern_typed_array_compare(
+                self->value.typedArray,
+                other->value.typedArray);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            return octaspire_dern_bytes_compare(self->value.bytes, other->value.bytes);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            return octaspire_dern_bytes_compare(
+                self->value.stringBuilder,
+                other->value.stringBuilder);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            size_t const myLength =
+                octaspire_dern_map_get_number_of_elements(self->value.set);
+
+            size_t const otherLength =
+                octaspire_dern_map_get_number_of_elements(other->value.set);
+
+            if (myLength != otherLength)
+            {
+                return (myLength < otherLength) ? -1 : 1;
+            }
+
+            octaspire_dern_map_element_const_iterator_t iter =
+                octaspire_dern_map_element_const_iterator_init(self->value.set);
+
+            while (iter.element)
+            {
+                if (!octaspire_dern_value_as_set_contains(
+                        other,
+                        octaspire_dern_map_element_get_key_const(iter.element)))
+                {
+                    return 1;
+                }
+
+                octaspire_dern_map_element_const_iterator_next(&iter);
+            }
+
+            return 0;
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            size_t const myLength    = self->value.stringSlice->numOctets;
+            size_t const otherLength = other->value.stringSlice->numOctets;
+
+            int const cmp = memcmp(
+                octaspire_dern_value_as_string_slice_get_octets(self),
+                octaspire_dern_value_as_string_slice_get_octets(other),
+                (myLength < otherLength) ? myLength : otherLength);
+
+            if (cmp)
+            {
+                return cmp;
+            }
+
+            return (myLength == otherLength) ? 0 : ((myLength < otherLength) ? -1 : 1);
+        }
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            size_t const myLength =
+                octaspire_dern_sorted_map_get_number_of_elements(self->value.sortedMap);
+
+            size_t const otherLength =
+                octaspire_dern_sorted_map_get_number_of_elements(other->value.sortedMap);
+
+            if (myLength != otherLength)
+            {
+                return (myLength < otherLength) ? -1 : 1;
+            }
+
+            octaspire_dern_sorted_map_iterator_t iter =
+                octaspire_dern_sorted_map_iterator_init(self->value.sortedMap);
+
+            octaspire_dern_sorted_map_iterator_t otherIter =
+                octaspire_dern_sorted_map_iterator_init(other->value.sortedMap);
+
+            while (iter.key)
+            {
+                int cmp = octaspire_dern_value_compare(iter.key, otherIter.key);
+
+                if (cmp)
+                {
+                    return cmp;
+                }
+
+                cmp = octaspire_dern_value_compare(iter.value, otherIter.value);
+
+                if (cmp)
+                {
+                    return cmp;
+                }
+
+                octaspire_dern_sorted_map_iterator_next(&iter);
+                octaspire_dern_sorted_map_iterator_next(&otherIter);
+            }
+
+            return 0;
+        }
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return octaspire_semver_compare(self->value.semver, other->value.semver);
@@ -5177,6 +7272,15 @@ bool octaspire_dern_value_is_atom(octaspire_dern_value_t const * const self)
         case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             return false;
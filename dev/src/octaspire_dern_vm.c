@@ -33,6 +33,9 @@ limitations under the License.
 #include "octaspire/dern/octaspire_dern_environment.h"
 #include "octaspire/dern/octaspire_dern_lexer.h"
 #include "octaspire/dern/octaspire_dern_stdlib.h"
+#include "octaspire/dern/octaspire_dern_helpers.h"
+#include "octaspire/dern/octaspire_dern_fasl.h"
+#include "octaspire/dern/octaspire_dern_loader.h"
 
 
 static void octaspire_dern_vm_private_release_value(
@@ -42,11 +45,11 @@ static void octaspire_dern_vm_private_release_value(
 static
 octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_queue_from_queue(
     octaspire_dern_vm_t *self,
-    octaspire_queue_t * const queue);
+    octaspire_dern_deque_t * const queue);
 
 static octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_list_from_list(
     octaspire_dern_vm_t *self,
-    octaspire_list_t * const list);
+    octaspire_dern_deque_t * const list);
 
 
 struct octaspire_dern_vm_t
@@ -55,6 +58,8 @@ struct octaspire_dern_vm_t
     octaspire_allocator_t     *allocator;
     octaspire_stdio_t         *stdio;
     octaspire_vector_t        *all;
+    octaspire_vector_t        *copyOnWriteSources;
+    octaspire_vector_t        *weakValues;
     octaspire_dern_value_t    *globalEnvironment;
     octaspire_dern_value_t    *valueNil;
     octaspire_dern_value_t    *valueTrue;
@@ -68,6 +73,10 @@ struct octaspire_dern_vm_t
     size_t                     gcTriggerLimit;
     uintmax_t                  nextFreeUniqueIdForValues;
     int32_t                    exitCode;
+    uint32_t                   markEpoch;
+    size_t                     inputFirstLineNumber;
+    size_t                     inputFirstColumnNumber;
+    size_t                     inputFirstUcsIndex;
     bool                       preventGc;
     bool                       quit;
     bool                       printReadably;
@@ -82,6 +91,10 @@ bool octaspire_dern_vm_private_mark_all(octaspire_dern_vm_t *self);
 bool octaspire_dern_vm_private_mark(octaspire_dern_vm_t *self, octaspire_dern_value_t *value);
 bool octaspire_dern_vm_private_sweep(octaspire_dern_vm_t *self);
 
+static void octaspire_dern_vm_private_release_copy_on_write_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value);
+
 octaspire_dern_vm_config_t octaspire_dern_vm_config_default(void)
 {
     octaspire_dern_vm_config_t result =
@@ -89,7 +102,9 @@ octaspire_dern_vm_config_t octaspire_dern_vm_config_default(void)
         .preLoaderForRequireSrc  = 0,
         .debugModeOn             = false,
         .noDlClose               = false,
-        .includeDirectories      = 0
+        .includeDirectories      = 0,
+        .faslCacheOn             = false,
+        .faslCacheDirectory      = 0
     };
 
     return result;
@@ -127,6 +142,10 @@ octaspire_dern_vm_t *octaspire_dern_vm_new_with_config(
     self->quit                      = false;
     self->userData                  = 0;
     self->nextFreeUniqueIdForValues = 0;
+    self->markEpoch                 = 0;
+    self->inputFirstLineNumber      = 1;
+    self->inputFirstColumnNumber    = 1;
+    self->inputFirstUcsIndex        = 0;
     self->functionReturn            = 0;
     self->printReadably             = true;
     self->config                    = config;
@@ -186,6 +205,32 @@ octaspire_dern_vm_t *octaspire_dern_vm_new_with_config(
         return 0;
     }
 
+    self->copyOnWriteSources = octaspire_vector_new(
+        sizeof(octaspire_dern_value_t*),
+        true,
+        0,
+        self->allocator);
+
+    if (!self->copyOnWriteSources)
+    {
+        octaspire_dern_vm_release(self);
+        self = 0;
+        return 0;
+    }
+
+    self->weakValues = octaspire_vector_new(
+        sizeof(octaspire_dern_value_t*),
+        true,
+        0,
+        self->allocator);
+
+    if (!self->weakValues)
+    {
+        octaspire_dern_vm_release(self);
+        self = 0;
+        return 0;
+    }
+
     octaspire_dern_environment_t *env =
         octaspire_dern_environment_new(0, self, self->allocator);
 
@@ -480,13 +525,26 @@ octaspire_dern_vm_t *octaspire_dern_vm_new_with_config(
         abort();
     }
 
+    // port-read-bytes
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "port-read-bytes",
+        octaspire_dern_vm_builtin_port_read_bytes,
+        2,
+        "Read from a port a given number of octets into new bytes",
+        false,
+        env))
+    {
+        abort();
+    }
+
     // port-write
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
         "port-write",
         octaspire_dern_vm_builtin_port_write,
         1,
-        "Write one integer or all integers from a vector to a port supporting writing",
+        "Write one integer, all integers from a vector or all octets of bytes to a port supporting writing",
         false,
         env))
     {
@@ -1119,7 +1177,20 @@ octaspire_dern_vm_t *octaspire_dern_vm_new_with_config(
         "split",
         octaspire_dern_vm_builtin_split,
         2,
-        "Split a collection by value",
+        "Split a string by a character or string",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // split-slices
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "split-slices",
+        octaspire_dern_vm_builtin_split_slices,
+        2,
+        "Split a string or string slice by a character or string into string slices",
         true,
         env))
     {
@@ -1140,684 +1211,1738 @@ octaspire_dern_vm_t *octaspire_dern_vm_new_with_config(
         abort();
      }
 
-    // queue
+    // weak-hash-map
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "queue",
-        octaspire_dern_vm_builtin_queue,
+        "weak-hash-map",
+        octaspire_dern_vm_builtin_weak_hash_map,
         0,
-        "Create new queue",
+        "Create new hash map whose keys do not keep its entries alive",
         true,
         env))
     {
         abort();
     }
 
-    // queue-with-max-length
+    // weak-reference
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "queue-with-max-length",
-        octaspire_dern_vm_builtin_queue_with_max_length,
-        0,
-        "Create new queue with maximum length",
+        "weak-reference",
+        octaspire_dern_vm_builtin_weak_reference,
+        1,
+        "Create new weak reference that does not keep the argument alive",
         true,
         env))
     {
         abort();
     }
 
-    // list
+    // weak-reference-get
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "list",
-        octaspire_dern_vm_builtin_list,
-        0,
-        "Create new list",
+        "weak-reference-get",
+        octaspire_dern_vm_builtin_weak_reference_get,
+        1,
+        "Get the target of a weak reference, or nil if it was collected",
         true,
         env))
     {
         abort();
     }
 
-    // exit
+    // persistent-vector
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "exit",
-        octaspire_dern_vm_builtin_exit,
+        "persistent-vector",
+        octaspire_dern_vm_builtin_persistent_vector,
         0,
-        "Quit and exit the vm execution or REPL",
-        false,
+        "Create new persistent vector of the given values",
+        true,
         env))
     {
         abort();
     }
 
-    // doc
+    // persistent-hash-map
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "doc",
-        octaspire_dern_vm_builtin_doc,
-        1,
-        "Get documentation string of a value or values",
+        "persistent-hash-map",
+        octaspire_dern_vm_builtin_persistent_hash_map,
+        0,
+        "Create new persistent hash map from the given keys and values",
         true,
         env))
     {
         abort();
     }
 
-    // len
+    // conj
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "len",
-        octaspire_dern_vm_builtin_len,
+        "conj",
+        octaspire_dern_vm_builtin_conj,
         1,
-        "Get length of a value or values",
+        "Get new version of a persistent vector with the given values added to the end",
         true,
         env))
     {
         abort();
     }
 
-    // read-and-eval-path
+    // assoc
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "read-and-eval-path",
-        octaspire_dern_vm_builtin_read_and_eval_path,
-        1,
-        "Read and evaluate a file from the given path",
-        false,
+        "assoc",
+        octaspire_dern_vm_builtin_assoc,
+        3,
+        "Get new version of a persistent vector or hash map with the given indices or keys set to the given values",
+        true,
         env))
     {
         abort();
     }
 
-    // read-and-eval-string
+    // dissoc
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "read-and-eval-string",
-        octaspire_dern_vm_builtin_read_and_eval_string,
+        "dissoc",
+        octaspire_dern_vm_builtin_dissoc,
         1,
-        "Read and evaluate the given string",
+        "Get new version of a persistent hash map without the given keys",
         true,
         env))
     {
         abort();
     }
 
-    // copy
+    // transient
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "copy",
-        octaspire_dern_vm_builtin_copy,
+        "transient",
+        octaspire_dern_vm_builtin_transient,
         1,
-        "Create full or partial copy of a value",
+        "Get transient version of a persistent vector or hash map that can be modified in place with conj!, assoc! and dissoc!",
         true,
         env))
     {
         abort();
     }
 
-
-
-    //////////////////////////////////////// Specials ////////////////////////////////////////////
-
-
-    // define
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // persistent!
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "define",
-        octaspire_dern_vm_special_define,
-        3,
-        "Bind value to name and document the binding",
-        false,
+        "persistent!",
+        octaspire_dern_vm_builtin_persistent_exclamation,
+        1,
+        "Make a transient vector or hash map persistent again",
+        true,
         env))
     {
         abort();
     }
 
-    // eval
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // conj!
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "eval",
-        octaspire_dern_vm_special_eval,
+        "conj!",
+        octaspire_dern_vm_builtin_conj_exclamation,
         1,
-        "Either (1) evaluate a value (first argument) in global environment\n"
-        "or, if given, in the given environment; or (2) apply function given\n"
-        "as the first argument in the environment given as the second argument\n"
-        "as a form with the rest of the arguments spread as the arguments to the call.",
+        "Add the given values to the end of a transient vector",
         true,
         env))
     {
         abort();
     }
 
-    // generate
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // assoc!
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "generate",
-        octaspire_dern_vm_special_generate,
-        4,
-        "Either (1) generate a collection of values, or (2) do the same\n"
-        "thing that other Lisps use 'map' or 'mapcar' for.",
+        "assoc!",
+        octaspire_dern_vm_builtin_assoc_exclamation,
+        3,
+        "Set the given indices or keys of a transient vector or hash map to the given values",
         true,
         env))
     {
         abort();
     }
 
-    // quote
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // dissoc!
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "quote",
-        octaspire_dern_vm_special_quote,
+        "dissoc!",
+        octaspire_dern_vm_builtin_dissoc_exclamation,
         1,
-        "Quote a value",
+        "Remove the given keys from a transient hash map",
         true,
         env))
     {
         abort();
     }
 
-    // select
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // typed-array
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "select",
-        octaspire_dern_vm_special_select,
+        "typed-array",
+        octaspire_dern_vm_builtin_typed_array,
         1,
-        "Select one of values, default, or no value and evaluate it according to boolean test",
+        "Create new typed array of the given element type (f64, f32, i64, i32 or u8) from numbers, vectors and typed arrays",
         true,
         env))
     {
         abort();
     }
 
-    // if
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // sum
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "if",
-        octaspire_dern_vm_special_if,
+        "sum",
+        octaspire_dern_vm_builtin_sum,
         1,
-        "Select value or no value and evaluate it according to boolean test",
+        "Get the sum of the elements of a typed array",
         true,
         env))
     {
         abort();
     }
 
-    // while
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // mean
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "while",
-        octaspire_dern_vm_special_while,
-        2,
-        "Evaluate values repeatedly as long as predicate is true",
+        "mean",
+        octaspire_dern_vm_builtin_mean,
+        1,
+        "Get the mean of the elements of a typed array",
         true,
         env))
     {
         abort();
     }
 
-    // for
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // dot
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "for",
-        octaspire_dern_vm_special_for,
-        3, // or 5
-        "Evaluate values repeatedly over a numeric range or container",
+        "dot",
+        octaspire_dern_vm_builtin_dot,
+        2,
+        "Get the dot product of two typed arrays of the same length",
         true,
         env))
     {
         abort();
     }
 
-    // ==
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // bytes
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "==",
-        octaspire_dern_vm_special_equals_equals,
-        1,
-        "Predicate telling whether all the given values are equal. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are equal. "
-        "Does not evaluate rest of the arguments if one is not equal",
+        "bytes",
+        octaspire_dern_vm_builtin_bytes,
+        0,
+        "Create new bytes from octets, strings, characters, vectors of octets and other bytes",
         true,
         env))
     {
         abort();
     }
 
-    // ===
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // bytes-slice
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "===",
-        octaspire_dern_vm_special_equals_equals_equals,
+        "bytes-slice",
+        octaspire_dern_vm_builtin_bytes_slice,
         2,
-        "Predicate telling whether all the given values are the same. "
-        "Two values that are equal might not be the same value. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are the same. "
-        "Does not evaluate rest of the arguments if one is not the same",
+        "Copy the octets from start index up to (not including) optional end index into new bytes",
         true,
         env))
     {
         abort();
     }
 
-    // !=
-    if (!octaspire_dern_vm_create_and_register_new_special( self,
-        "!=",
-        octaspire_dern_vm_special_exclamation_equals,
-        1,
-        "Predicate telling whether all the given values are not equal. "
-        "Takes 2..n arguments. Evaluates arguments only as long as unequal is not found. "
-        "Does not evaluate rest of the arguments if one is unequal",
+    // bytes-pack
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "bytes-pack",
+        octaspire_dern_vm_builtin_bytes_pack,
+        3,
+        "Append integers to bytes in the given format ('u8, 'i8, 'u16le, 'u16be, 'i16le, 'i16be, 'u32le, 'u32be, 'i32le, 'i32be, 'u64le, 'u64be, 'i64le or 'i64be). Integers have 32 bits, so they are sign extended to 64-bit formats",
         true,
         env))
     {
         abort();
     }
 
-    // <
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // bytes-unpack
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "<",
-        octaspire_dern_vm_special_less_than,
-        1,
-        "Predicate telling whether the arguments are less than the previous argument. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are less than the "
-        "previous. Does not evaluate rest of the arguments if one is larger or equal",
+        "bytes-unpack",
+        octaspire_dern_vm_builtin_bytes_unpack,
+        3,
+        "Read integer in the given format from bytes starting at the given index. Values that do not fit into 32 bits are given as reals, that are exact up to 2^53",
         true,
         env))
     {
         abort();
     }
 
-    // >
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // bytes-to-string
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        ">",
-        octaspire_dern_vm_special_greater_than,
+        "bytes-to-string",
+        octaspire_dern_vm_builtin_bytes_to_string,
         1,
-        "Predicate telling whether the arguments are greater than the previous argument. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are greater than the "
-        "previous. Does not evaluate rest of the arguments if one is smaller or equal",
+        "Create new string from the octets of bytes",
         true,
         env))
     {
         abort();
     }
 
-    // <=
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // string-builder
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "<=",
-        octaspire_dern_vm_special_less_than_or_equal,
-        1,
-        "Predicate telling whether the arguments are equal or less than the previous argument. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are equal or less than "
-        "the previous. Does not evaluate rest of the arguments if one is larger",
+        "string-builder",
+        octaspire_dern_vm_builtin_string_builder,
+        0,
+        "Create new string builder holding the text of the arguments. Append to it with '+='",
         true,
         env))
     {
         abort();
     }
 
-    // >=
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // string-builder-to-string
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        ">=",
-        octaspire_dern_vm_special_greater_than_or_equal,
+        "string-builder-to-string",
+        octaspire_dern_vm_builtin_string_builder_to_string,
         1,
-        "Predicate telling whether the arguments are equal or greater than the previous argument. "
-        "Takes 2..n arguments. Evaluates arguments only as long as those are equal or greater than "
-        "the previous. Does not evaluate rest of the arguments if one is smaller",
+        "Create new string from the text of string builder and empty the builder",
         true,
         env))
     {
         abort();
     }
 
-    // template
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // sort
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "template",
-        octaspire_dern_vm_special_template,
+        "sort",
+        octaspire_dern_vm_builtin_sort,
         1,
-        "TODO",
+        "Return sorted copy of vector, list or typed array. Optional key function and comparator",
         true,
         env))
     {
         abort();
     }
 
-    // fn
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // sort!
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "fn",
-        octaspire_dern_vm_special_fn,
-        2,
-        "Create new anonymous function",
+        "sort!",
+        octaspire_dern_vm_builtin_sort_exclamation,
+        1,
+        "Sort vector, list or typed array in place. Optional key function and comparator",
         true,
         env))
     {
         abort();
     }
 
-    // macro
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // set
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "macro",
-        octaspire_dern_vm_special_macro,
-        2,
-        "Create new anonymous macro",
+        "set",
+        octaspire_dern_vm_builtin_set,
+        0,
+        "Create new set holding the arguments as elements. Add with '+=' and remove with '-='",
         true,
         env))
     {
         abort();
     }
 
-    // uid
+    // set-contains?
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "uid",
-        octaspire_dern_vm_builtin_uid,
+        "set-contains?",
+        octaspire_dern_vm_builtin_set_contains_question_mark,
         2,
-        "Get unique id of a value",
-        false,
+        "Predicate telling whether set contains all the given elements",
+        true,
         env))
     {
         abort();
     }
 
-    // integer?
+    // set-union
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "integer?",
-        octaspire_dern_vm_builtin_integer_question_mark,
+        "set-union",
+        octaspire_dern_vm_builtin_set_union,
         1,
-        "Predicate telling whether the argument is an integer",
+        "Create new set holding the elements of all the given sets",
         true,
         env))
     {
         abort();
     }
 
-    // real?
+    // set-intersection
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "real?",
-        octaspire_dern_vm_builtin_real_question_mark,
+        "set-intersection",
+        octaspire_dern_vm_builtin_set_intersection,
         1,
-        "Predicate telling whether the argument is a real",
+        "Create new set holding the elements that are in every given set",
         true,
         env))
     {
         abort();
     }
 
-    // number?
+    // set-difference
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "number?",
-        octaspire_dern_vm_builtin_number_question_mark,
+        "set-difference",
+        octaspire_dern_vm_builtin_set_difference,
         1,
-        "Predicate telling whether the argument is a number (integer or real)",
+        "Create new set holding the elements of the first set that are not in any other given set",
         true,
         env))
     {
         abort();
     }
 
-    // nil?
+    // sorted-map
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "nil?",
-        octaspire_dern_vm_builtin_nil_question_mark,
-        1,
-        "Predicate telling whether the argument is nil",
+        "sorted-map",
+        octaspire_dern_vm_builtin_sorted_map,
+        0,
+        "Create new sorted map from pairs of keys and values. Keys are kept in order",
         true,
         env))
     {
         abort();
     }
 
-    // boolean?
+    // sorted-map?
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "boolean?",
-        octaspire_dern_vm_builtin_boolean_question_mark,
+        "sorted-map?",
+        octaspire_dern_vm_builtin_sorted_map_question_mark,
         1,
-        "Predicate telling whether the argument is a boolean",
+        "Predicate telling whether the argument is a sorted map",
         true,
         env))
     {
         abort();
     }
 
-    // character
+    // sorted-map-floor
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "character",
-        octaspire_dern_vm_builtin_character,
-        1,
-        "Create a character value from the given number or description",
+        "sorted-map-floor",
+        octaspire_dern_vm_builtin_sorted_map_floor,
+        2,
+        "Get (key value) with the greatest key less than or equal to the given key, or nil",
         true,
         env))
     {
         abort();
     }
 
-    // character?
+    // sorted-map-ceiling
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "character?",
-        octaspire_dern_vm_builtin_character_question_mark,
-        1,
-        "Predicate telling whether the argument is a character",
+        "sorted-map-ceiling",
+        octaspire_dern_vm_builtin_sorted_map_ceiling,
+        2,
+        "Get (key value) with the smallest key greater than or equal to the given key, or nil",
         true,
         env))
     {
         abort();
     }
 
-    // string?
+    // sorted-map-range
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "string?",
-        octaspire_dern_vm_builtin_string_question_mark,
-        1,
-        "Predicate telling whether the argument is a string",
+        "sorted-map-range",
+        octaspire_dern_vm_builtin_sorted_map_range,
+        3,
+        "Create new sorted map holding the elements with keys from the first to the last, inclusive",
         true,
         env))
     {
         abort();
     }
 
-    // symbol?
+    // string-slice
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "symbol?",
-        octaspire_dern_vm_builtin_symbol_question_mark,
+        "string-slice",
+        octaspire_dern_vm_builtin_string_slice,
         1,
-        "Predicate telling whether the argument is a symbol",
+        "Create new string slice viewing characters of a string without copying them",
         true,
         env))
     {
         abort();
     }
 
-    // vector?
+    // string-slice?
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "vector?",
-        octaspire_dern_vm_builtin_vector_question_mark,
+        "string-slice?",
+        octaspire_dern_vm_builtin_string_slice_question_mark,
         1,
-        "Predicate telling whether the argument is a vector",
+        "Predicate telling whether the argument is a string slice",
         true,
         env))
     {
         abort();
     }
 
-    // hash-map?
+    // string-slice-to-string
     if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "hash-map?",
-        octaspire_dern_vm_builtin_hash_map_question_mark,
+        "string-slice-to-string",
+        octaspire_dern_vm_builtin_string_slice_to_string,
         1,
-        "Predicate telling whether the argument is a hash map",
+        "Create new string holding a copy of the text of string slice",
         true,
         env))
     {
         abort();
     }
 
-    // TODO move to specials
-    // howto
-    if (!octaspire_dern_vm_create_and_register_new_special(
+    // queue
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
         self,
-        "howto",
-        octaspire_dern_vm_special_howto,
-        1,
-        "Suggest functions by giving arguments and expected result",
+        "queue",
+        octaspire_dern_vm_builtin_queue,
+        0,
+        "Create new queue",
         true,
         env))
     {
         abort();
     }
 
-    return self;
-}
-
-void octaspire_dern_vm_release(octaspire_dern_vm_t *self)
-{
-    if (!self)
+    // queue-with-max-length
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "queue-with-max-length",
+        octaspire_dern_vm_builtin_queue_with_max_length,
+        0,
+        "Create new queue with maximum length",
+        true,
+        env))
     {
-        return;
+        abort();
     }
 
-    octaspire_map_release(self->libraries);
-    self->libraries = 0;
-
-    octaspire_vector_release(self->commandLineArguments);
-    self->commandLineArguments = 0;
-
-    octaspire_vector_release(self->environmentVariables);
-    self->environmentVariables = 0;
-
-    // At this point stack had nil and self->globalEnvironment was tried to remove
-    //octaspire_dern_vm_pop_value(self, self->globalEnvironment);
-
-    octaspire_vector_clear(self->stack);
-    octaspire_dern_vm_gc(self);
-
-    octaspire_vector_release(self->stack);
-
-    octaspire_vector_release(self->all);
-
-    octaspire_allocator_free(self->allocator, self);
-}
-
-bool octaspire_dern_vm_push_value(
-    octaspire_dern_vm_t * const self,
-    octaspire_dern_value_t * const value)
-{
-    return octaspire_vector_push_back_element(self->stack, &value);
-}
-
-bool octaspire_dern_vm_pop_value(
-    octaspire_dern_vm_t * const self,
-    octaspire_dern_value_t * const valueForBalanceCheck)
-{
-    if (octaspire_vector_peek_back_element(self->stack) != valueForBalanceCheck)
+    // list
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "list",
+        octaspire_dern_vm_builtin_list,
+        0,
+        "Create new list",
+        true,
+        env))
     {
-        printf(
-            "\n\n ----- STACK UNBALANCED! -----\n (real top)%p != (user says is top)%p\n\n",
-            (void*)octaspire_vector_peek_back_element(self->stack),
-            (void*)valueForBalanceCheck);
-
-        printf("REAL TOP IS:\n");
-
-        octaspire_dern_value_print(
-            octaspire_vector_peek_back_element(self->stack), self->allocator);
-
-        printf("USER SAYS THIS IS TOP:\n");
-        octaspire_dern_value_print(valueForBalanceCheck, self->allocator);
+        abort();
     }
 
-    if (octaspire_vector_peek_back_element(self->stack) != valueForBalanceCheck)
+    // exit
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "exit",
+        octaspire_dern_vm_builtin_exit,
+        0,
+        "Quit and exit the vm execution or REPL",
+        false,
+        env))
     {
         abort();
     }
 
-    return octaspire_vector_pop_back_element(self->stack);
-}
-
-void const * octaspire_dern_vm_get_top_value(octaspire_dern_vm_t const * const self)
-{
-    return octaspire_vector_peek_back_element(self->stack);
-}
-
-octaspire_dern_value_t *octaspire_dern_vm_peek_value(octaspire_dern_vm_t *self)
-{
-    return octaspire_vector_peek_back_element(self->stack);
-}
-
-octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_struct(
-    octaspire_dern_vm_t* self,
-    octaspire_dern_value_tag_t const typeTag)
-{
-    if (self->numAllocatedWithoutGc >= self->gcTriggerLimit && !self->preventGc)
+    // doc
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "doc",
+        octaspire_dern_vm_builtin_doc,
+        1,
+        "Get documentation string of a value or values",
+        true,
+        env))
     {
-        octaspire_dern_vm_gc(self);
-        self->numAllocatedWithoutGc = 0;
+        abort();
     }
-    else
+
+    // len
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "len",
+        octaspire_dern_vm_builtin_len,
+        1,
+        "Get length of a value or values",
+        true,
+        env))
     {
-        ++(self->numAllocatedWithoutGc);
+        abort();
     }
 
-    octaspire_dern_value_t *result =
-        octaspire_allocator_malloc(self->allocator, sizeof(octaspire_dern_value_t));
-
-    if (!result)
+    // read-and-eval-path
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "read-and-eval-path",
+        octaspire_dern_vm_builtin_read_and_eval_path,
+        1,
+        "Read and evaluate files from the given paths, in order",
+        false,
+        env))
     {
-        octaspire_helpers_verify_not_null(false);
-        return 0;
+        abort();
     }
 
-    octaspire_vector_push_back_element(self->all, &result);
-
-    result->typeTag      = typeTag;
-    result->mark         = false;
-    result->docstr       = 0;
-    result->vm           = self;
-    result->uniqueId     = self->nextFreeUniqueIdForValues;
-    result->howtoAllowed = false;
+    // save-image
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "save-image",
+        octaspire_dern_vm_builtin_save_image,
+        1,
+        "Save the global environment and loaded libraries into an image file. "
+        "Fails if the environment reaches a port, C data, error, persistent vector, "
+        "persistent hash map, sorted map, string slice or weak reference",
+        false,
+        env))
+    {
+        abort();
+    }
 
-    if (self->nextFreeUniqueIdForValues == UINTMAX_MAX)
+    // read-and-eval-string
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "read-and-eval-string",
+        octaspire_dern_vm_builtin_read_and_eval_string,
+        1,
+        "Read and evaluate the given string",
+        true,
+        env))
     {
         abort();
     }
 
-    ++(self->nextFreeUniqueIdForValues);
+    // copy
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "copy",
+        octaspire_dern_vm_builtin_copy,
+        1,
+        "Create full or partial copy of a value",
+        true,
+        env))
+    {
+        abort();
+    }
 
-    return result;
-}
 
-octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
-    octaspire_dern_vm_t *self,
-    octaspire_dern_value_t *valueToBeCopied)
-{
-    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
 
-    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
-        self,
-        valueToBeCopied->typeTag);
+    //////////////////////////////////////// Specials ////////////////////////////////////////////
 
-    octaspire_dern_vm_push_value(self, result);
 
-    switch (result->typeTag)
+    // define
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "define",
+        octaspire_dern_vm_special_define,
+        3,
+        "Bind value to name and document the binding",
+        false,
+        env))
     {
-        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
+        abort();
+    }
+
+    // eval
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "eval",
+        octaspire_dern_vm_special_eval,
+        1,
+        "Either (1) evaluate a value (first argument) in global environment\n"
+        "or, if given, in the given environment; or (2) apply function given\n"
+        "as the first argument in the environment given as the second argument\n"
+        "as a form with the rest of the arguments spread as the arguments to the call.",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // generate
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "generate",
+        octaspire_dern_vm_special_generate,
+        4,
+        "Either (1) generate a collection of values, or (2) do the same\n"
+        "thing that other Lisps use 'map' or 'mapcar' for.",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // quote
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "quote",
+        octaspire_dern_vm_special_quote,
+        1,
+        "Quote a value",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // select
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "select",
+        octaspire_dern_vm_special_select,
+        1,
+        "Select one of values, default, or no value and evaluate it according to boolean test",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // if
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "if",
+        octaspire_dern_vm_special_if,
+        1,
+        "Select value or no value and evaluate it according to boolean test",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // while
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "while",
+        octaspire_dern_vm_special_while,
+        2,
+        "Evaluate values repeatedly as long as predicate is true",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // for
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "for",
+        octaspire_dern_vm_special_for,
+        3, // or 5
+        "Evaluate values repeatedly over a numeric range or container",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // ==
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "==",
+        octaspire_dern_vm_special_equals_equals,
+        1,
+        "Predicate telling whether all the given values are equal. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are equal. "
+        "Does not evaluate rest of the arguments if one is not equal",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // ===
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "===",
+        octaspire_dern_vm_special_equals_equals_equals,
+        2,
+        "Predicate telling whether all the given values are the same. "
+        "Two values that are equal might not be the same value. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are the same. "
+        "Does not evaluate rest of the arguments if one is not the same",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // !=
+    if (!octaspire_dern_vm_create_and_register_new_special( self,
+        "!=",
+        octaspire_dern_vm_special_exclamation_equals,
+        1,
+        "Predicate telling whether all the given values are not equal. "
+        "Takes 2..n arguments. Evaluates arguments only as long as unequal is not found. "
+        "Does not evaluate rest of the arguments if one is unequal",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // <
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "<",
+        octaspire_dern_vm_special_less_than,
+        1,
+        "Predicate telling whether the arguments are less than the previous argument. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are less than the "
+        "previous. Does not evaluate rest of the arguments if one is larger or equal",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // >
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        ">",
+        octaspire_dern_vm_special_greater_than,
+        1,
+        "Predicate telling whether the arguments are greater than the previous argument. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are greater than the "
+        "previous. Does not evaluate rest of the arguments if one is smaller or equal",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // <=
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "<=",
+        octaspire_dern_vm_special_less_than_or_equal,
+        1,
+        "Predicate telling whether the arguments are equal or less than the previous argument. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are equal or less than "
+        "the previous. Does not evaluate rest of the arguments if one is larger",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // >=
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        ">=",
+        octaspire_dern_vm_special_greater_than_or_equal,
+        1,
+        "Predicate telling whether the arguments are equal or greater than the previous argument. "
+        "Takes 2..n arguments. Evaluates arguments only as long as those are equal or greater than "
+        "the previous. Does not evaluate rest of the arguments if one is smaller",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // template
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "template",
+        octaspire_dern_vm_special_template,
+        1,
+        "TODO",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // fn
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "fn",
+        octaspire_dern_vm_special_fn,
+        2,
+        "Create new anonymous function",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // macro
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "macro",
+        octaspire_dern_vm_special_macro,
+        2,
+        "Create new anonymous macro",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // uid
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "uid",
+        octaspire_dern_vm_builtin_uid,
+        2,
+        "Get unique id of a value",
+        false,
+        env))
+    {
+        abort();
+    }
+
+    // integer?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "integer?",
+        octaspire_dern_vm_builtin_integer_question_mark,
+        1,
+        "Predicate telling whether the argument is an integer",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // real?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "real?",
+        octaspire_dern_vm_builtin_real_question_mark,
+        1,
+        "Predicate telling whether the argument is a real",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // number?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "number?",
+        octaspire_dern_vm_builtin_number_question_mark,
+        1,
+        "Predicate telling whether the argument is a number (integer or real)",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // nil?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "nil?",
+        octaspire_dern_vm_builtin_nil_question_mark,
+        1,
+        "Predicate telling whether the argument is nil",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // boolean?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "boolean?",
+        octaspire_dern_vm_builtin_boolean_question_mark,
+        1,
+        "Predicate telling whether the argument is a boolean",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // character
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "character",
+        octaspire_dern_vm_builtin_character,
+        1,
+        "Create a character value from the given number or description",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // character?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "character?",
+        octaspire_dern_vm_builtin_character_question_mark,
+        1,
+        "Predicate telling whether the argument is a character",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // string?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "string?",
+        octaspire_dern_vm_builtin_string_question_mark,
+        1,
+        "Predicate telling whether the argument is a string",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // symbol?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "symbol?",
+        octaspire_dern_vm_builtin_symbol_question_mark,
+        1,
+        "Predicate telling whether the argument is a symbol",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // vector?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "vector?",
+        octaspire_dern_vm_builtin_vector_question_mark,
+        1,
+        "Predicate telling whether the argument is a vector",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // hash-map?
+    if (!octaspire_dern_vm_create_and_register_new_builtin(
+        self,
+        "hash-map?",
+        octaspire_dern_vm_builtin_hash_map_question_mark,
+        1,
+        "Predicate telling whether the argument is a hash map",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    // TODO move to specials
+    // howto
+    if (!octaspire_dern_vm_create_and_register_new_special(
+        self,
+        "howto",
+        octaspire_dern_vm_special_howto,
+        1,
+        "Suggest functions by giving arguments and expected result",
+        true,
+        env))
+    {
+        abort();
+    }
+
+    return self;
+}
+
+void octaspire_dern_vm_release(octaspire_dern_vm_t *self)
+{
+    if (!self)
+    {
+        return;
+    }
+
+    octaspire_map_release(self->libraries);
+    self->libraries = 0;
+
+    octaspire_vector_release(self->commandLineArguments);
+    self->commandLineArguments = 0;
+
+    octaspire_vector_release(self->environmentVariables);
+    self->environmentVariables = 0;
+
+    // At this point stack had nil and self->globalEnvironment was tried to remove
+    //octaspire_dern_vm_pop_value(self, self->globalEnvironment);
+
+    octaspire_vector_clear(self->stack);
+    octaspire_dern_vm_gc(self);
+
+    octaspire_vector_release(self->stack);
+
+    octaspire_vector_release(self->all);
+
+    if (self->copyOnWriteSources)
+    {
+        for (size_t i = 0; i < octaspire_vector_get_length(self->copyOnWriteSources); ++i)
+        {
+            octaspire_dern_value_t * const source =
+                octaspire_vector_get_element_at(self->copyOnWriteSources, (ptrdiff_t)i);
+
+            octaspire_vector_release(source->copyOnWrite.copies);
+            source->copyOnWrite.copies  = 0;
+            source->isCopyOnWriteSource = false;
+        }
+    }
+
+    octaspire_vector_release(self->copyOnWriteSources);
+
+    octaspire_vector_release(self->weakValues);
+
+    octaspire_allocator_free(self->allocator, self);
+}
+
+bool octaspire_dern_vm_push_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    return octaspire_vector_push_back_element(self->stack, &value);
+}
+
+bool octaspire_dern_vm_pop_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const valueForBalanceCheck)
+{
+    if (octaspire_vector_peek_back_element(self->stack) != valueForBalanceCheck)
+    {
+        printf(
+            "\n\n ----- STACK UNBALANCED! -----\n (real top)%p != (user says is top)%p\n\n",
+            (void*)octaspire_vector_peek_back_element(self->stack),
+            (void*)valueForBalanceCheck);
+
+        printf("REAL TOP IS:\n");
+
+        octaspire_dern_value_print(
+            octaspire_vector_peek_back_element(self->stack), self->allocator);
+
+        printf("USER SAYS THIS IS TOP:\n");
+        octaspire_dern_value_print(valueForBalanceCheck, self->allocator);
+    }
+
+    if (octaspire_vector_peek_back_element(self->stack) != valueForBalanceCheck)
+    {
+        abort();
+    }
+
+    return octaspire_vector_pop_back_element(self->stack);
+}
+
+void const * octaspire_dern_vm_get_top_value(octaspire_dern_vm_t const * const self)
+{
+    return octaspire_vector_peek_back_element(self->stack);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_peek_value(octaspire_dern_vm_t *self)
+{
+    return octaspire_vector_peek_back_element(self->stack);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_struct(
+    octaspire_dern_vm_t* self,
+    octaspire_dern_value_tag_t const typeTag)
+{
+    if (self->numAllocatedWithoutGc >= self->gcTriggerLimit && !self->preventGc)
+    {
+        octaspire_dern_vm_gc(self);
+        self->numAllocatedWithoutGc = 0;
+    }
+    else
+    {
+        ++(self->numAllocatedWithoutGc);
+    }
+
+    octaspire_dern_value_t *result =
+        octaspire_allocator_malloc(self->allocator, sizeof(octaspire_dern_value_t));
+
+    if (!result)
+    {
+        octaspire_helpers_verify_not_null(false);
+        return 0;
+    }
+
+    octaspire_vector_push_back_element(self->all, &result);
+
+    result->typeTag            = typeTag;
+    result->mark               = false;
+    result->docstr             = 0;
+    result->docvec             = 0;
+    result->copyOnWrite.source  = 0;
+    result->copyOnWritePins     = 0;
+    result->isCopyOnWriteSource = false;
+    result->hashMapHasWeakKeys = false;
+    result->hashIsCached       = false;
+    result->isTransient        = false;
+    result->cachedHash         = 0;
+    result->vm                 = self;
+    result->uniqueId           = self->nextFreeUniqueIdForValues;
+    result->howtoAllowed       = false;
+
+    if (self->nextFreeUniqueIdForValues == UINTMAX_MAX)
+    {
+        abort();
+    }
+
+    ++(self->nextFreeUniqueIdForValues);
+
+    return result;
+}
+
+// Source must be pinned for the value already.
+static void octaspire_dern_vm_private_add_copy_on_write_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const source,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_helpers_verify_true(!octaspire_dern_value_is_copy_on_write_pending(source));
+
+    if (!source->isCopyOnWriteSource)
+    {
+        octaspire_vector_t * const copies = octaspire_vector_new(
+            sizeof(octaspire_dern_value_t*),
+            true,
+            0,
+            self->allocator);
+
+        octaspire_helpers_verify_not_null(copies);
+
+        source->copyOnWrite.copies  = copies;
+        source->isCopyOnWriteSource = true;
+
+        if (!octaspire_vector_push_back_element(self->copyOnWriteSources, &source))
+        {
+            abort();
+        }
+    }
+
+    value->copyOnWrite.source = source;
+
+    if (!octaspire_vector_push_back_element(source->copyOnWrite.copies, &value))
+    {
+        abort();
+    }
+}
+
+static octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_copy_on_write(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const valueToBeCopied)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    // Copy of a pending copy shares the storage of the original source,
+    // because the pending copy can be materialized before this one.
+    octaspire_dern_value_t * const pendingSource =
+        octaspire_dern_value_get_copy_on_write_source(valueToBeCopied);
+
+    octaspire_dern_value_t * const source =
+        pendingSource ? pendingSource : valueToBeCopied;
+
+    if (!octaspire_dern_value_pin_for_copy_on_write(source))
+    {
+        return 0;
+    }
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_private_create_new_value_struct(self, source->typeTag);
+
+    result->value = source->value;
+
+    octaspire_dern_vm_private_add_copy_on_write_value(self, source, result);
+
+    octaspire_dern_vm_push_value(self, result);
+
+    if (valueToBeCopied->docstr)
+    {
+        result->docstr = octaspire_dern_vm_create_new_value_copy(self, valueToBeCopied->docstr);
+    }
+
+    if (valueToBeCopied->docvec)
+    {
+        result->docvec = octaspire_dern_vm_create_new_value_copy(self, valueToBeCopied->docvec);
+    }
+
+    octaspire_dern_vm_pop_value(self, result);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+    return result;
+}
+
+void octaspire_dern_vm_materialize_copy_on_write_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_dern_value_t * const source =
+        octaspire_dern_value_get_copy_on_write_source(value);
+
+    if (!source)
+    {
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+        return;
+    }
+
+    // Value stays shared until the new storage is complete; GC marks the
+    // elements of the source through 'copyOnWrite.source' meanwhile.
+    // The value is left in the list of copies of the source, and removed
+    // from there by the next sweep.
+    octaspire_dern_vm_push_value(self, value);
+
+    switch (value->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_STRING:
+        {
+            octaspire_string_t * const str =
+                octaspire_dern_helpers_copy_string(source->value.string, self->allocator);
+
+            octaspire_helpers_verify_not_null(str);
+
+            value->value.string = str;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
+        {
+            octaspire_dern_value_t * const tmpVal =
+                octaspire_dern_vm_create_new_value_vector(self);
+
+            octaspire_dern_vm_push_value(self, tmpVal);
+
+            for (size_t i = 0; i < octaspire_vector_get_length(source->value.vector); ++i)
+            {
+                octaspire_dern_value_t * const elemCopy =
+                    octaspire_dern_vm_create_new_value_copy(
+                        self,
+                        octaspire_vector_get_element_at(
+                            source->value.vector,
+                            (ptrdiff_t)i));
+
+                if (!octaspire_vector_push_back_element(tmpVal->value.vector, &elemCopy))
+                {
+                    abort();
+                }
+            }
+
+            value->value.vector  = tmpVal->value.vector;
+            tmpVal->value.vector = 0;
+            tmpVal->typeTag      = OCTASPIRE_DERN_VALUE_TAG_NIL;
+
+            octaspire_dern_vm_pop_value(self, tmpVal);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            octaspire_dern_value_t * const tmpVal =
+                octaspire_dern_vm_create_new_value_hash_map(self);
+
+            octaspire_dern_vm_push_value(self, tmpVal);
+
+            octaspire_dern_map_element_iterator_t iter =
+                octaspire_dern_map_element_iterator_init(source->value.hashMap);
+
+            while (iter.element)
+            {
+                octaspire_dern_value_t * const keyCopy =
+                    octaspire_dern_vm_create_new_value_copy(
+                        self,
+                        octaspire_dern_map_element_get_key(iter.element));
+
+                octaspire_dern_vm_push_value(self, keyCopy);
+
+                octaspire_dern_value_t * const valCopy =
+                    octaspire_dern_vm_create_new_value_copy(
+                        self,
+                        octaspire_dern_map_element_get_value(iter.element));
+
+                octaspire_dern_vm_push_value(self, valCopy);
+
+                if (!octaspire_dern_map_put(
+                        tmpVal->value.hashMap,
+                        octaspire_dern_map_element_get_hash(iter.element),
+                        keyCopy,
+                        valCopy))
+                {
+                    abort();
+                }
+
+                octaspire_dern_vm_pop_value(self, valCopy);
+                octaspire_dern_vm_pop_value(self, keyCopy);
+
+                octaspire_dern_map_element_iterator_next(&iter);
+            }
+
+            value->value.hashMap  = tmpVal->value.hashMap;
+            tmpVal->value.hashMap = 0;
+            tmpVal->typeTag       = OCTASPIRE_DERN_VALUE_TAG_NIL;
+
+            octaspire_dern_vm_pop_value(self, tmpVal);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            // Only octets are copied, so this is safe also during GC.
+            octaspire_dern_string_slice_t * const slice = value->value.stringSlice;
+
+            char * const octets =
+                octaspire_allocator_malloc(self->allocator, slice->numOctets + 1);
+
+            octaspire_helpers_verify_not_null(octets);
+
+            memcpy(
+                octets,
+                octaspire_string_get_c_string(source->value.string) + slice->octetIndex,
+                slice->numOctets);
+
+            slice->octets     = octets;
+            slice->octetIndex = 0;
+        }
+        break;
+
+        default:
+        {
+            abort();
+        }
+    }
+
+    value->copyOnWrite.source = 0;
+    octaspire_dern_value_unpin_for_copy_on_write(source);
+
+    octaspire_dern_vm_pop_value(self, value);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+}
+
+static bool octaspire_dern_vm_private_materialize_copies_of_source(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const source)
+{
+    if (!source->isCopyOnWriteSource)
+    {
+        return false;
+    }
+
+    octaspire_vector_t * const copies = source->copyOnWrite.copies;
+    bool materialized = false;
+
+    while (!octaspire_vector_is_empty(copies))
+    {
+        octaspire_dern_value_t * const value = octaspire_vector_peek_back_element(copies);
+
+        if (!octaspire_vector_pop_back_element(copies))
+        {
+            abort();
+        }
+
+        // Copies materialized earlier are still in the list.
+        if (octaspire_dern_value_get_copy_on_write_source(value) == source)
+        {
+            octaspire_dern_vm_materialize_copy_on_write_value(self, value);
+            materialized = true;
+        }
+    }
+
+    return materialized;
+}
+
+static bool octaspire_dern_vm_private_shares_value(
+    octaspire_dern_value_t const * const container,
+    octaspire_dern_value_t const * const value)
+{
+    if (container == value)
+    {
+        return true;
+    }
+
+    // Pending copies are pinned as a whole, like in pinning.
+    if (octaspire_dern_value_is_copy_on_write_pending(container))
+    {
+        return false;
+    }
+
+    if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_VECTOR)
+    {
+        for (size_t i = 0; i < octaspire_vector_get_length(container->value.vector); ++i)
+        {
+            if (octaspire_dern_vm_private_shares_value(
+                    octaspire_vector_get_element_at_const(
+                        container->value.vector,
+                        (ptrdiff_t)i),
+                    value))
+            {
+                return true;
+            }
+        }
+    }
+    else if (container->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP)
+    {
+        octaspire_dern_map_element_const_iterator_t iter =
+            octaspire_dern_map_element_const_iterator_init(container->value.hashMap);
+
+        while (iter.element)
+        {
+            if (octaspire_dern_vm_private_shares_value(
+                    octaspire_dern_map_element_get_key(iter.element),
+                    value) ||
+                octaspire_dern_vm_private_shares_value(
+                    octaspire_dern_map_element_get_value(iter.element),
+                    value))
+            {
+                return true;
+            }
+
+            octaspire_dern_map_element_const_iterator_next(&iter);
+        }
+    }
+
+    return false;
+}
+
+void octaspire_dern_vm_materialize_copies_sharing_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    // GC would compact the lists of copies iterated here.
+    bool const preventGc = self->preventGc;
+    self->preventGc = true;
+
+    while (value->copyOnWritePins)
+    {
+        bool materialized = false;
+
+        // Copies of the vectors and hash maps holding 'value' share it too.
+        // Materializing those turns them into direct copies of 'value'.
+        for (size_t i = 0; i < octaspire_vector_get_length(self->copyOnWriteSources); ++i)
+        {
+            octaspire_dern_value_t * const source =
+                octaspire_vector_get_element_at(self->copyOnWriteSources, (ptrdiff_t)i);
+
+            if (source != value &&
+                source->copyOnWritePins &&
+                octaspire_dern_vm_private_shares_value(source, value) &&
+                octaspire_dern_vm_private_materialize_copies_of_source(self, source))
+            {
+                materialized = true;
+            }
+        }
+
+        if (octaspire_dern_vm_private_materialize_copies_of_source(self, value))
+        {
+            materialized = true;
+        }
+
+        octaspire_helpers_verify_true(materialized);
+    }
+
+    self->preventGc = preventGc;
+}
+
+void octaspire_dern_vm_materialize_all_copy_on_write_values(
+    octaspire_dern_vm_t * const self)
+{
+    bool const preventGc = self->preventGc;
+    self->preventGc = true;
+
+    // Materializing a vector or hash map adds copies of its elements,
+    // so this loop ends only when nothing is shared anymore.
+    bool materialized = true;
+
+    while (materialized)
+    {
+        materialized = false;
+
+        for (size_t i = 0; i < octaspire_vector_get_length(self->copyOnWriteSources); ++i)
+        {
+            if (octaspire_dern_vm_private_materialize_copies_of_source(
+                    self,
+                    octaspire_vector_get_element_at(self->copyOnWriteSources, (ptrdiff_t)i)))
+            {
+                materialized = true;
+            }
+        }
+    }
+
+    self->preventGc = preventGc;
+}
+
+static void octaspire_dern_vm_private_release_copy_on_write_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    octaspire_dern_value_t * const source = value->copyOnWrite.source;
+
+    if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE)
+    {
+        // Octets belong to the source, but the slice itself does not.
+        octaspire_allocator_free(self->allocator, value->value.stringSlice);
+    }
+
+    // Storage belongs to the source; the shared pointer is just forgotten.
+    value->copyOnWrite.source = 0;
+    value->value.vector       = 0;
+    value->typeTag            = OCTASPIRE_DERN_VALUE_TAG_NIL;
+
+    octaspire_dern_value_unpin_for_copy_on_write(source);
+}
+
+static void octaspire_dern_vm_private_sweep_copy_on_write_values(
+    octaspire_dern_vm_t * const self)
+{
+    // Runs before any value is released, so that unreachable copies can still
+    // unpin their sources. Only reachable pending copies are kept, and only
+    // sources that still have some are.
+    size_t numSourcesKept = 0;
+
+    for (size_t i = 0; i < octaspire_vector_get_length(self->copyOnWriteSources); ++i)
+    {
+        octaspire_dern_value_t * const source =
+            octaspire_vector_get_element_at(self->copyOnWriteSources, (ptrdiff_t)i);
+
+        octaspire_vector_t * const copies = source->copyOnWrite.copies;
+        size_t numKept = 0;
+
+        for (size_t j = 0; j < octaspire_vector_get_length(copies); ++j)
+        {
+            octaspire_dern_value_t * const value =
+                octaspire_vector_get_element_at(copies, (ptrdiff_t)j);
+
+            if (octaspire_dern_value_get_copy_on_write_source(value) != source)
+            {
+                continue;
+            }
+
+            if (!value->mark)
+            {
+                octaspire_dern_vm_private_release_copy_on_write_value(self, value);
+                continue;
+            }
+
+            if (!source->mark)
+            {
+                // Only short slices leave their source unmarked; those are
+                // detached so that the source can be released.
+                octaspire_helpers_verify_true(
+                    value->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE);
+
+                octaspire_dern_vm_materialize_copy_on_write_value(self, value);
+                continue;
+            }
+
+            if (!octaspire_vector_replace_element_at(copies, (ptrdiff_t)numKept, &value))
+            {
+                abort();
+            }
+
+            ++numKept;
+        }
+
+        if (!numKept)
+        {
+            octaspire_vector_release(copies);
+            source->copyOnWrite.copies  = 0;
+            source->isCopyOnWriteSource = false;
+            continue;
+        }
+
+        while (octaspire_vector_get_length(copies) > numKept)
+        {
+            if (!octaspire_vector_pop_back_element(copies))
+            {
+                abort();
+            }
+        }
+
+        if (!octaspire_vector_replace_element_at(
+                self->copyOnWriteSources,
+                (ptrdiff_t)numSourcesKept,
+                &source))
+        {
+            abort();
+        }
+
+        ++numSourcesKept;
+    }
+
+    while (octaspire_vector_get_length(self->copyOnWriteSources) > numSourcesKept)
+    {
+        if (!octaspire_vector_pop_back_element(self->copyOnWriteSources))
+        {
+            abort();
+        }
+    }
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_value_t *valueToBeCopied)
+{
+    if (octaspire_dern_value_is_copy_on_write_shareable(valueToBeCopied))
+    {
+        octaspire_dern_value_t * const result =
+            octaspire_dern_vm_private_create_new_value_copy_on_write(
+                self,
+                valueToBeCopied);
+
+        // Values that cannot be pinned are copied eagerly below.
+        if (result)
+        {
+            return result;
+        }
+    }
+
+    if (octaspire_dern_value_is_string_slice(valueToBeCopied))
+    {
+        // Slices are never mutated, so a copy is just another slice.
+        return octaspire_dern_vm_create_new_value_string_slice(
+            self,
+            valueToBeCopied,
+            0,
+            valueToBeCopied->value.stringSlice->numOctets);
+    }
+
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        valueToBeCopied->typeTag);
+
+    octaspire_dern_vm_push_value(self, result);
+
+    switch (result->typeTag)
+    {
+        case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
         {
             abort();
         }
@@ -1848,7 +2973,7 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_STRING:
         {
-            result->value.string = octaspire_string_new_copy(
+            result->value.string = octaspire_dern_helpers_copy_string(
                 valueToBeCopied->value.string,
                 self->allocator);
         }
@@ -1856,7 +2981,7 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_CHARACTER:
         {
-            result->value.character = octaspire_string_new_copy(
+            result->value.character = octaspire_dern_helpers_copy_string(
                 valueToBeCopied->value.character,
                 self->allocator);
         }
@@ -1864,7 +2989,7 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         {
-            result->value.symbol = octaspire_string_new_copy(
+            result->value.symbol = octaspire_dern_helpers_copy_string(
                 valueToBeCopied->value.symbol,
                 self->allocator);
         }
@@ -1919,18 +3044,21 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
         {
-            result->value.queue = octaspire_queue_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                0,
-                self->allocator);
+            result->value.queue =
+                octaspire_dern_deque_has_max_length(valueToBeCopied->value.queue) ?
+                    octaspire_dern_deque_new_with_max_length(
+                        octaspire_dern_deque_get_max_length(valueToBeCopied->value.queue),
+                        self->allocator) :
+                    octaspire_dern_deque_new(self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.queue);
 
             for (size_t i = 0;
-                 i < octaspire_queue_get_length(valueToBeCopied->value.queue);
+                 i < octaspire_dern_deque_get_length(valueToBeCopied->value.queue);
                  ++i)
             {
                 octaspire_dern_value_t * const tmpValToCopy =
-                    octaspire_queue_get_at(
+                    octaspire_dern_deque_get_at(
                         valueToBeCopied->value.queue,
                         (ptrdiff_t)i);
 
@@ -1939,9 +3067,9 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
                 octaspire_dern_value_t * const tmpValCopied =
                     octaspire_dern_vm_create_new_value_copy(self, tmpValToCopy);
 
-                if (!octaspire_queue_push(
+                if (!octaspire_dern_deque_push_back(
                     result->value.queue,
-                    &tmpValCopied))
+                    tmpValCopied))
                 {
                     abort();
                 }
@@ -1951,31 +3079,27 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_LIST:
         {
-            result->value.list = octaspire_list_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                0,
-                self->allocator);
+            result->value.list = octaspire_dern_deque_new(self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.list);
 
-            // TODO more efficient iteration
             for (size_t i = 0;
-                 i < octaspire_list_get_length(valueToBeCopied->value.list);
+                 i < octaspire_dern_deque_get_length(valueToBeCopied->value.list);
                  ++i)
             {
                 octaspire_dern_value_t * const tmpValToCopy =
-                    octaspire_list_node_get_element(
-                        octaspire_list_get_at(
-                            valueToBeCopied->value.list,
-                            (ptrdiff_t)i));
+                    octaspire_dern_deque_get_at(
+                        valueToBeCopied->value.list,
+                        (ptrdiff_t)i);
 
                 assert(tmpValToCopy);
 
                 octaspire_dern_value_t * const tmpValCopied =
                     octaspire_dern_vm_create_new_value_copy(self, tmpValToCopy);
 
-                if (!octaspire_list_push_back(
+                if (!octaspire_dern_deque_push_back(
                     result->value.list,
-                    &tmpValCopied))
+                    tmpValCopied))
                 {
                     abort();
                 }
@@ -1985,31 +3109,36 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
         case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
         {
-            result->value.hashMap = octaspire_map_new(
-                sizeof(octaspire_dern_value_t*),
-                true,
-                sizeof(octaspire_dern_value_t*),
-                true,
-                (octaspire_map_key_compare_function_t)
-                    octaspire_dern_value_is_equal,
-                (octaspire_map_key_hash_function_t)
-                    octaspire_dern_value_get_hash,
-                0,
-                0,
-                self->allocator);
+            result->hashMapHasWeakKeys = valueToBeCopied->hashMapHasWeakKeys;
+
+            result->value.hashMap = octaspire_dern_map_new(self->allocator);
+
+            octaspire_dern_map_set_hashes_collection_keys_by_identity(
+                result->value.hashMap,
+                valueToBeCopied->hashMapHasWeakKeys);
+
+            // GC removes entries from weak hash maps; it must not run while
+            // the source is iterated. Keys of a weak hash map are identities
+            // and are shared, not copied.
+            bool const preventGc = self->preventGc;
 
-            octaspire_map_element_iterator_t iter =
-                octaspire_map_element_iterator_init(
+            if (valueToBeCopied->hashMapHasWeakKeys)
+            {
+                self->preventGc = true;
+            }
+
+            octaspire_dern_map_element_iterator_t iter =
+                octaspire_dern_map_element_iterator_init(
                     valueToBeCopied->value.hashMap);
             do
             {
                 if (iter.element)
                 {
                     octaspire_dern_value_t * const keyToCopy =
-                        octaspire_map_element_get_key(iter.element);
+                        octaspire_dern_map_element_get_key(iter.element);
 
                     octaspire_dern_value_t * const valToCopy =
-                        octaspire_map_element_get_value(iter.element);
+                        octaspire_dern_map_element_get_value(iter.element);
 
                     octaspire_helpers_verify_not_null(keyToCopy);
                     octaspire_helpers_verify_not_null(valToCopy);
@@ -2017,7 +3146,9 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
 
                     octaspire_dern_value_t * const copyOfKeyVal =
-                        octaspire_dern_vm_create_new_value_copy(self, keyToCopy);
+                        valueToBeCopied->hashMapHasWeakKeys ?
+                            keyToCopy :
+                            octaspire_dern_vm_create_new_value_copy(self, keyToCopy);
 
                     octaspire_helpers_verify_not_null(copyOfKeyVal);
 
@@ -2034,11 +3165,11 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
 
 
-                    if (!octaspire_map_put(
+                    if (!octaspire_dern_map_put(
                             result->value.hashMap,
                             octaspire_dern_value_get_hash(copyOfKeyVal),
-                            &copyOfKeyVal,
-                            &copyOfValVal))
+                            copyOfKeyVal,
+                            copyOfValVal))
                     {
                         abort();
                     }
@@ -2047,7 +3178,9 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
                     octaspire_dern_vm_pop_value(self, copyOfKeyVal);
                 }
             }
-            while (octaspire_map_element_iterator_next(&iter));
+            while (octaspire_dern_map_element_iterator_next(&iter));
+
+            self->preventGc = preventGc;
         }
         break;
 
@@ -2112,19 +3245,168 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_copy(
 
                 octaspire_helpers_verify_not_null(errorVal);
 
-                octaspire_string_release(str);
-                str = 0;
+                octaspire_string_release(str);
+                str = 0;
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(self));
+
+                return errorVal;
+            }
+
+            result->value.cData =
+                octaspire_dern_c_data_new_copy(valueToBeCopied->value.cData, self->allocator);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        {
+            result->value.weakReference = valueToBeCopied->value.weakReference;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        {
+            // Constant time; the nodes are shared until either one is modified.
+            result->isTransient = valueToBeCopied->isTransient;
+
+            result->value.persistentVector = octaspire_dern_persistent_vector_new_copy(
+                valueToBeCopied->value.persistentVector,
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.persistentVector);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        {
+            result->isTransient = valueToBeCopied->isTransient;
+
+            result->value.persistentHashMap = octaspire_dern_persistent_map_new_copy(
+                valueToBeCopied->value.persistentHashMap,
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.persistentHashMap);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        {
+            result->value.typedArray = octaspire_dern_typed_array_new_copy(
+                valueToBeCopied->value.typedArray,
+                octaspire_dern_typed_array_get_element_type(
+                    valueToBeCopied->value.typedArray),
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.typedArray);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            result->value.bytes = octaspire_dern_bytes_new_from_buffer(
+                octaspire_dern_bytes_get_octets(valueToBeCopied->value.bytes),
+                octaspire_dern_bytes_get_length(valueToBeCopied->value.bytes),
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.bytes);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        {
+            result->value.stringBuilder = octaspire_dern_bytes_new_from_buffer(
+                octaspire_dern_bytes_get_octets(valueToBeCopied->value.stringBuilder),
+                octaspire_dern_bytes_get_length(valueToBeCopied->value.stringBuilder),
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.stringBuilder);
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            result->value.set = octaspire_dern_map_new(self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.set);
+
+            if (!octaspire_dern_map_reserve(
+                    result->value.set,
+                    octaspire_dern_map_get_number_of_elements(valueToBeCopied->value.set)))
+            {
+                abort();
+            }
+
+            octaspire_dern_map_element_iterator_t iter =
+                octaspire_dern_map_element_iterator_init(valueToBeCopied->value.set);
+
+            while (iter.element)
+            {
+                octaspire_dern_value_t * const copyOfElement =
+                    octaspire_dern_vm_create_new_value_copy(
+                        self,
+                        octaspire_dern_map_element_get_key(iter.element));
+
+                octaspire_helpers_verify_not_null(copyOfElement);
+
+                if (!octaspire_dern_map_put(
+                        result->value.set,
+                        octaspire_dern_value_get_hash(copyOfElement),
+                        copyOfElement,
+                        0))
+                {
+                    abort();
+                }
+
+                octaspire_dern_map_element_iterator_next(&iter);
+            }
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            result->value.sortedMap = octaspire_dern_sorted_map_new(self->allocator);
+
+            octaspire_helpers_verify_not_null(result->value.sortedMap);
+
+            // Elements are copied in key order, so the copy is bulk loaded.
+            octaspire_dern_sorted_map_iterator_t iter =
+                octaspire_dern_sorted_map_iterator_init(valueToBeCopied->value.sortedMap);
+
+            while (iter.key)
+            {
+                octaspire_dern_value_t * const copyOfKey =
+                    octaspire_dern_vm_create_new_value_copy(self, iter.key);
+
+                octaspire_helpers_verify_not_null(copyOfKey);
+
+                octaspire_dern_vm_push_value(self, copyOfKey);
+
+                octaspire_dern_value_t * const copyOfValue =
+                    octaspire_dern_vm_create_new_value_copy(self, iter.value);
+
+                octaspire_helpers_verify_not_null(copyOfValue);
+
+                octaspire_dern_vm_pop_value(self, copyOfKey);
 
-                octaspire_helpers_verify_true(
-                    stackLength == octaspire_dern_vm_get_stack_length(self));
+                if (!octaspire_dern_sorted_map_put(
+                        result->value.sortedMap,
+                        copyOfKey,
+                        copyOfValue))
+                {
+                    abort();
+                }
 
-                return errorVal;
+                octaspire_dern_sorted_map_iterator_next(&iter);
             }
-
-            result->value.cData =
-                octaspire_dern_c_data_new_copy(valueToBeCopied->value.cData, self->allocator);
         }
         break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            // Copies of slices are created above.
+            abort();
+        }
     }
 
     if (valueToBeCopied->docstr)
@@ -2530,7 +3812,7 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_vector(octaspire_dern
 
 octaspire_dern_value_t *octaspire_dern_vm_create_new_value_hash_map_from_hash_map(
     octaspire_dern_vm_t *self,
-    octaspire_map_t * const value)
+    octaspire_dern_map_t * const value)
 {
     octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
         self,
@@ -2542,7 +3824,7 @@ octaspire_dern_value_t *octaspire_dern_vm_create_new_value_hash_map_from_hash_ma
 
 octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_queue_from_queue(
     octaspire_dern_vm_t *self,
-    octaspire_queue_t * const queue)
+    octaspire_dern_deque_t * const queue)
 {
     octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
         self,
@@ -2554,7 +3836,7 @@ octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_queue_from_qu
 
 octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_list_from_list(
     octaspire_dern_vm_t *self,
-    octaspire_list_t * const list)
+    octaspire_dern_deque_t * const list)
 {
     octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
         self,
@@ -2566,27 +3848,261 @@ octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_list_from_lis
 
 octaspire_dern_value_t *octaspire_dern_vm_create_new_value_hash_map(octaspire_dern_vm_t *self)
 {
-    octaspire_map_t *hashMap = octaspire_map_new(
-        sizeof(octaspire_dern_value_t*),
-        true,
-        sizeof(octaspire_dern_value_t*),
-        true,
-        (octaspire_map_key_compare_function_t)octaspire_dern_value_is_equal,
-        (octaspire_map_key_hash_function_t)octaspire_dern_value_get_hash,
-        0,
-        0,
-        self->allocator);
+    octaspire_dern_map_t *hashMap = octaspire_dern_map_new(self->allocator);
 
     return octaspire_dern_vm_create_new_value_hash_map_from_hash_map(self, hashMap);
 }
 
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_weak_hash_map(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_create_new_value_hash_map(self);
+
+    result->hashMapHasWeakKeys = true;
+
+    octaspire_dern_map_set_hashes_collection_keys_by_identity(
+        result->value.hashMap,
+        true);
+
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_weak_reference(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_value_t * const target)
+{
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE);
+
+    result->value.weakReference = target;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_persistent_vector(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_persistent_vector_t * const persistentVector =
+        octaspire_dern_persistent_vector_new(self->allocator);
+
+    octaspire_helpers_verify_not_null(persistentVector);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR);
+
+    result->value.persistentVector = persistentVector;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_persistent_hash_map(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_persistent_map_t * const persistentHashMap =
+        octaspire_dern_persistent_map_new(self->allocator);
+
+    octaspire_helpers_verify_not_null(persistentHashMap);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP);
+
+    result->value.persistentHashMap = persistentHashMap;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_typed_array(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_typed_array_element_type_t const elementType,
+    size_t const length)
+{
+    octaspire_dern_typed_array_t * const typedArray =
+        octaspire_dern_typed_array_new(elementType, length, self->allocator);
+
+    octaspire_helpers_verify_not_null(typedArray);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY);
+
+    result->value.typedArray = typedArray;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_typed_array_copy(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_typed_array_t const * const other,
+    octaspire_dern_typed_array_element_type_t const elementType)
+{
+    octaspire_dern_typed_array_t * const typedArray =
+        octaspire_dern_typed_array_new_copy(other, elementType, self->allocator);
+
+    octaspire_helpers_verify_not_null(typedArray);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY);
+
+    result->value.typedArray = typedArray;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_bytes(
+    octaspire_dern_vm_t *self)
+{
+    return octaspire_dern_vm_create_new_value_bytes_from_buffer(self, 0, 0);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_bytes_from_buffer(
+    octaspire_dern_vm_t *self,
+    void const * const buffer,
+    size_t const length)
+{
+    octaspire_dern_bytes_t * const bytes =
+        octaspire_dern_bytes_new_from_buffer(buffer, length, self->allocator);
+
+    octaspire_helpers_verify_not_null(bytes);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_BYTES);
+
+    result->value.bytes = bytes;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_string_builder(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_bytes_t * const stringBuilder =
+        octaspire_dern_bytes_new(self->allocator);
+
+    octaspire_helpers_verify_not_null(stringBuilder);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER);
+
+    result->value.stringBuilder = stringBuilder;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_set(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_map_t * const set = octaspire_dern_map_new(self->allocator);
+
+    octaspire_helpers_verify_not_null(set);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_SET);
+
+    result->value.set = set;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_sorted_map(
+    octaspire_dern_vm_t *self)
+{
+    octaspire_dern_sorted_map_t * const sortedMap =
+        octaspire_dern_sorted_map_new(self->allocator);
+
+    octaspire_helpers_verify_not_null(sortedMap);
+
+    octaspire_dern_value_t *result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP);
+
+    result->value.sortedMap = sortedMap;
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_create_new_value_string_slice(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_value_t * const value,
+    size_t const octetIndex,
+    size_t const numOctets)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_helpers_verify_true(
+        octaspire_dern_value_is_string(value) ||
+        octaspire_dern_value_is_string_slice(value));
+
+    octaspire_dern_string_slice_t * const slice =
+        octaspire_allocator_malloc(self->allocator, sizeof(octaspire_dern_string_slice_t));
+
+    octaspire_helpers_verify_not_null(slice);
+
+    octaspire_dern_vm_push_value(self, value);
+
+    octaspire_dern_value_t * const result = octaspire_dern_vm_private_create_new_value_struct(
+        self,
+        OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE);
+
+    // The GC can have detached 'value' above, so its storage is looked
+    // up only now. Slices of slices share the original string.
+    octaspire_dern_value_t *source      = 0;
+    size_t                  sourceIndex = octetIndex;
+
+    if (octaspire_dern_value_is_string(value))
+    {
+        source = octaspire_dern_value_get_copy_on_write_source(value);
+
+        if (!source)
+        {
+            source = value;
+        }
+    }
+    else if (octaspire_dern_value_is_copy_on_write_pending(value))
+    {
+        source       = value->copyOnWrite.source;
+        sourceIndex += value->value.stringSlice->octetIndex;
+    }
+
+    slice->octets           = 0;
+    slice->octetIndex       = sourceIndex;
+    slice->numOctets        = numOctets;
+    slice->numUcsCharacters = 0;
+
+    result->value.stringSlice = slice;
+
+    char const * const first = octaspire_dern_value_is_string(value) ?
+        (octaspire_string_get_c_string(value->value.string) + octetIndex) :
+        (octaspire_dern_value_as_string_slice_get_octets(value) + octetIndex);
+
+    for (size_t i = 0; i < numOctets; ++i)
+    {
+        if ((first[i] & 0xC0) != 0x80)
+        {
+            ++(slice->numUcsCharacters);
+        }
+    }
+
+    if (source && octaspire_dern_value_pin_for_copy_on_write(source))
+    {
+        octaspire_dern_vm_private_add_copy_on_write_value(self, source, result);
+    }
+    else
+    {
+        slice->octetIndex = 0;
+        slice->octets     = octaspire_allocator_malloc(self->allocator, numOctets + 1);
+
+        octaspire_helpers_verify_not_null(slice->octets);
+
+        memcpy(slice->octets, first, numOctets);
+    }
+
+    octaspire_dern_vm_pop_value(self, value);
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+    return result;
+}
+
 octaspire_dern_value_t *octaspire_dern_vm_create_new_value_queue(octaspire_dern_vm_t *self)
 {
-    octaspire_queue_t *queue = octaspire_queue_new(
-        sizeof(octaspire_dern_value_t*),
-        true,
-        0,
-        self->allocator);
+    octaspire_dern_deque_t * const queue = octaspire_dern_deque_new(self->allocator);
 
     return octaspire_dern_vm_private_create_new_value_queue_from_queue(self, queue);
 }
@@ -2595,23 +4111,15 @@ struct octaspire_dern_value_t *octaspire_dern_vm_create_new_value_queue_with_max
         octaspire_dern_vm_t * const self,
         size_t const maxLength)
 {
-    octaspire_queue_t * const queue = octaspire_queue_new_with_max_length(
-        maxLength,
-        sizeof(octaspire_dern_value_t*),
-        true,
-        0,
-        self->allocator);
+    octaspire_dern_deque_t * const queue =
+        octaspire_dern_deque_new_with_max_length(maxLength, self->allocator);
 
     return octaspire_dern_vm_private_create_new_value_queue_from_queue(self, queue);
 }
 
 octaspire_dern_value_t *octaspire_dern_vm_create_new_value_list(octaspire_dern_vm_t *self)
 {
-    octaspire_list_t *list = octaspire_list_new(
-        sizeof(octaspire_dern_value_t*),
-        true,
-        0,
-        self->allocator);
+    octaspire_dern_deque_t * const list = octaspire_dern_deque_new(self->allocator);
 
     return octaspire_dern_vm_private_create_new_value_list_from_list(self, list);
 }
@@ -2805,13 +4313,19 @@ void octaspire_dern_vm_clear_value_to_nil(
     octaspire_dern_vm_t *self,
     octaspire_dern_value_t *value)
 {
-    OCTASPIRE_HELPERS_UNUSED_PARAMETER(self);
-
     if (!value)
     {
         return;
     }
 
+    value->hashIsCached = false;
+
+    if (octaspire_dern_value_is_copy_on_write_pending(value))
+    {
+        octaspire_dern_vm_private_release_copy_on_write_value(self, value);
+        return;
+    }
+
     switch (value->typeTag)
     {
         case OCTASPIRE_DERN_VALUE_TAG_ILLEGAL:
@@ -2869,86 +4383,153 @@ void octaspire_dern_vm_clear_value_to_nil(
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
+        {
+            // Elements are NOT released here, because it would lead to double free.
+            // GC releases the elements (those are stored in the all-vector also).
+            octaspire_dern_map_clear(value->value.hashMap);
+            octaspire_dern_map_release(value->value.hashMap);
+            value->value.hashMap      = 0;
+            value->hashMapHasWeakKeys = false;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        {
+            // Elements are NOT released here, because it would lead to double free.
+            // GC releases the elements (those are stored in the all-vector also).
+            octaspire_dern_deque_release(value->value.queue);
+            value->value.queue = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        {
+            // Elements are NOT released here, because it would lead to double free.
+            // GC releases the elements (those are stored in the all-vector also).
+            octaspire_dern_deque_release(value->value.list);
+            value->value.list = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        {
+            octaspire_dern_environment_release(value->value.environment);
+            value->value.environment = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
+        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        {
+            octaspire_dern_function_release(value->value.function);
+            value->value.function = 0;
+
+            //octaspire_dern_vm_private_release_value(self, fun->formals);
+            //octaspire_dern_vm_private_release_value(self, fun->body);
+            //octaspire_dern_vm_private_release_value(self, fun->definitionEnvironment);
+            //fun->definitionEnvironment = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        {
+            octaspire_dern_special_release(value->value.special);
+            value->value.special = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        {
+            octaspire_dern_builtin_release(value->value.builtin);
+            value->value.builtin = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        {
+            octaspire_dern_port_release(value->value.port);
+            value->value.port = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        {
+            octaspire_dern_c_data_release(value->value.cData);
+            value->value.cData = 0;
+        }
+        break;
+
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
         {
-            // Elements are NOT released here, because it would lead to double free.
-            // GC releases the elements (those are stored in the all-vector also).
-            octaspire_map_clear(value->value.hashMap);
-            octaspire_map_release(value->value.hashMap);
-            value->value.hashMap = 0;
+            // Target is not owned by the reference.
+            value->value.weakReference = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_QUEUE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
         {
-            // Elements are NOT released here, because it would lead to double free.
-            // GC releases the elements (those are stored in the all-vector also).
-            octaspire_queue_clear(value->value.queue);
-            octaspire_queue_release(value->value.queue);
-            value->value.queue = 0;
+            octaspire_dern_persistent_vector_release(value->value.persistentVector);
+            value->value.persistentVector = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_LIST:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
         {
-            // Elements are NOT released here, because it would lead to double free.
-            // GC releases the elements (those are stored in the all-vector also).
-            octaspire_list_clear(value->value.list);
-            octaspire_list_release(value->value.list);
-            value->value.list = 0;
+            octaspire_dern_persistent_map_release(value->value.persistentHashMap);
+            value->value.persistentHashMap = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
         {
-            octaspire_dern_environment_release(value->value.environment);
-            value->value.environment = 0;
+            octaspire_dern_typed_array_release(value->value.typedArray);
+            value->value.typedArray = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_MACRO:
-        case OCTASPIRE_DERN_VALUE_TAG_FUNCTION:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
         {
-            octaspire_dern_function_release(value->value.function);
-            value->value.function = 0;
-
-            //octaspire_dern_vm_private_release_value(self, fun->formals);
-            //octaspire_dern_vm_private_release_value(self, fun->body);
-            //octaspire_dern_vm_private_release_value(self, fun->definitionEnvironment);
-            //fun->definitionEnvironment = 0;
+            octaspire_dern_bytes_release(value->value.bytes);
+            value->value.bytes = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_SPECIAL:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
         {
-            octaspire_dern_special_release(value->value.special);
-            value->value.special = 0;
+            octaspire_dern_bytes_release(value->value.stringBuilder);
+            value->value.stringBuilder = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
         {
-            octaspire_dern_builtin_release(value->value.builtin);
-            value->value.builtin = 0;
+            // Elements are NOT released here, because it would lead to double free.
+            // GC releases the elements (those are stored in the all-vector also).
+            octaspire_dern_map_release(value->value.set);
+            value->value.set = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_PORT:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
         {
-            octaspire_dern_port_release(value->value.port);
-            value->value.port = 0;
+            // Elements are released by the GC, as with sets.
+            octaspire_dern_sorted_map_release(value->value.sortedMap);
+            value->value.sortedMap = 0;
         }
         break;
 
-        case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
-            octaspire_dern_c_data_release(value->value.cData);
-            value->value.cData = 0;
+            octaspire_allocator_free(self->allocator, value->value.stringSlice->octets);
+            octaspire_allocator_free(self->allocator, value->value.stringSlice);
+            value->value.stringSlice = 0;
         }
         break;
     }
 
-    value->typeTag = OCTASPIRE_DERN_VALUE_TAG_NIL;
+    value->isTransient = false;
+    value->typeTag     = OCTASPIRE_DERN_VALUE_TAG_NIL;
 }
 
 static void octaspire_dern_vm_private_release_value(
@@ -2976,10 +4557,158 @@ bool octaspire_dern_vm_gc(octaspire_dern_vm_t *self)
     return octaspire_dern_vm_private_sweep(self);
 }
 
+void octaspire_dern_vm_add_weak_value(
+    octaspire_dern_vm_t * const self,
+    octaspire_dern_value_t * const value)
+{
+    if (!octaspire_vector_push_back_element(self->weakValues, &value))
+    {
+        abort();
+    }
+}
+
+static bool octaspire_dern_vm_private_mark_values_of_weak_hash_maps(
+    octaspire_dern_vm_t * const self)
+{
+    // A value in a weak hash map is reachable only through a reachable key.
+    // Marking a value can make more keys reachable, so repeat until stable.
+    bool markedSomething = true;
+
+    while (markedSomething)
+    {
+        markedSomething = false;
+
+        for (size_t i = 0; i < octaspire_vector_get_length(self->weakValues); ++i)
+        {
+            octaspire_dern_value_t * const value =
+                octaspire_vector_get_element_at(self->weakValues, (ptrdiff_t)i);
+
+            if (value->typeTag != OCTASPIRE_DERN_VALUE_TAG_HASH_MAP)
+            {
+                continue;
+            }
+
+            octaspire_dern_map_element_iterator_t iter =
+                octaspire_dern_map_element_iterator_init(value->value.hashMap);
+
+            while (iter.element)
+            {
+                octaspire_dern_value_t * const key =
+                    octaspire_dern_map_element_get_key(iter.element);
+
+                octaspire_dern_value_t * const val =
+                    octaspire_dern_map_element_get_value(iter.element);
+
+                if (key->mark && !val->mark)
+                {
+                    if (!octaspire_dern_value_mark(val))
+                    {
+                        return false;
+                    }
+
+                    markedSomething = true;
+                }
+
+                octaspire_dern_map_element_iterator_next(&iter);
+            }
+        }
+    }
+
+    return true;
+}
+
+static void octaspire_dern_vm_private_sweep_weak_values(
+    octaspire_dern_vm_t * const self)
+{
+    // Runs before any value is released, so that keys of removed entries
+    // can still be compared and references be cleared before targets are freed.
+    octaspire_vector_t *deadKeys = 0;
+
+    for (size_t i = 0; i < octaspire_vector_get_length(self->weakValues); ++i)
+    {
+        octaspire_dern_value_t * const value =
+            octaspire_vector_get_element_at(self->weakValues, (ptrdiff_t)i);
+
+        if (value->typeTag == OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE)
+        {
+            if (value->value.weakReference && !value->value.weakReference->mark)
+            {
+                value->value.weakReference = 0;
+            }
+
+            continue;
+        }
+
+        octaspire_helpers_verify_true(value->typeTag == OCTASPIRE_DERN_VALUE_TAG_HASH_MAP);
+
+        if (!deadKeys)
+        {
+            deadKeys = octaspire_vector_new(
+                sizeof(octaspire_dern_value_t*),
+                true,
+                0,
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(deadKeys);
+        }
+
+        octaspire_dern_map_element_iterator_t iter =
+            octaspire_dern_map_element_iterator_init(value->value.hashMap);
+
+        while (iter.element)
+        {
+            octaspire_dern_value_t * const key =
+                octaspire_dern_map_element_get_key(iter.element);
+
+            if (!key->mark)
+            {
+                if (!octaspire_vector_push_back_element(deadKeys, &key))
+                {
+                    abort();
+                }
+            }
+
+            octaspire_dern_map_element_iterator_next(&iter);
+        }
+
+        for (size_t j = 0; j < octaspire_vector_get_length(deadKeys); ++j)
+        {
+            octaspire_dern_value_t * const key =
+                octaspire_vector_get_element_at(deadKeys, (ptrdiff_t)j);
+
+            if (!octaspire_dern_map_remove(
+                    value->value.hashMap,
+                    octaspire_dern_value_get_hash(key),
+                    key))
+            {
+                abort();
+            }
+        }
+
+        octaspire_vector_clear(deadKeys);
+    }
+
+    octaspire_vector_release(deadKeys);
+    deadKeys = 0;
+
+    octaspire_vector_clear(self->weakValues);
+}
+
 bool octaspire_dern_vm_private_mark_all(octaspire_dern_vm_t *self)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
 
+    // Nodes shared by persistent collections are marked once per epoch;
+    // new nodes start from epoch zero, so it is never used.
+    ++(self->markEpoch);
+
+    if (self->markEpoch == 0)
+    {
+        self->markEpoch = 1;
+    }
+
+    octaspire_vector_clear(self->weakValues);
+
     for (size_t i = 0; i < octaspire_vector_get_length(self->stack); ++i)
     {
         octaspire_dern_value_t * const value =
@@ -3008,58 +4737,269 @@ bool octaspire_dern_vm_private_mark_all(octaspire_dern_vm_t *self)
                 ((octaspire_dern_lib_t*)octaspire_map_element_get_value(
                     iterator.element)));
 
-            octaspire_map_element_iterator_next(&iterator);
+            octaspire_map_element_iterator_next(&iterator);
+        }
+    }
+
+    if (!octaspire_dern_vm_private_mark_values_of_weak_hash_maps(self))
+    {
+        return false;
+    }
+
+    octaspire_helpers_verify_true(
+        stackLength == octaspire_dern_vm_get_stack_length(self));
+
+    return true;
+}
+
+bool octaspire_dern_vm_private_mark(octaspire_dern_vm_t *self, octaspire_dern_value_t *value)
+{
+    OCTASPIRE_HELPERS_UNUSED_PARAMETER(self);
+    return octaspire_dern_value_mark(value);
+}
+
+bool octaspire_dern_vm_private_sweep(octaspire_dern_vm_t *self)
+{
+    octaspire_dern_vm_private_sweep_copy_on_write_values(self);
+    octaspire_dern_vm_private_sweep_weak_values(self);
+
+    for (size_t i = 0; i < octaspire_vector_get_length(self->all); /* NOP */ )
+    {
+        octaspire_dern_value_t * const value =
+            octaspire_vector_get_element_at(
+                self->all,
+                (ptrdiff_t)i);
+
+        if (value->mark)
+        {
+            value->mark = false;
+
+            ++i;
+        }
+        else
+        {
+            octaspire_dern_vm_private_release_value(self, value);
+
+            octaspire_dern_value_t *value2 =
+                octaspire_vector_get_element_at(
+                    self->all,
+                    (ptrdiff_t)i);
+
+            octaspire_helpers_verify_true(value == value2);
+
+            if (!octaspire_vector_remove_element_at(
+                    self->all,
+                    (ptrdiff_t)i))
+            {
+                abort();
+            }
+        }
+    }
+
+    return true;
+}
+
+// Reads the datum after a quote and gives it as (quote datum).
+static octaspire_dern_value_t *octaspire_dern_vm_private_parse_quoted(
+    octaspire_dern_vm_t * const self,
+    octaspire_input_t *input)
+{
+    octaspire_dern_value_t *result = octaspire_dern_vm_create_new_value_vector(self);
+
+    if (!result)
+    {
+        result = octaspire_dern_vm_create_new_value_error_from_c_string(
+            self,
+            "Allocation failure");
+    }
+    else
+    {
+        octaspire_dern_vm_push_value(self, result);
+
+        octaspire_dern_value_t *quoteSym =
+            octaspire_dern_vm_create_new_value_symbol_from_c_string(self, "quote");
+
+        octaspire_helpers_verify_not_null(quoteSym);
+
+        if (!octaspire_dern_value_as_vector_push_back_element(result, &quoteSym))
+        {
+            abort();
+        }
+
+        octaspire_dern_value_t *quotedValue = octaspire_dern_vm_parse(
+            self,
+            input);
+
+        if (!quotedValue || quotedValue->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_dern_vm_pop_value(self, result);
+            result = quotedValue; // report error to caller
+        }
+        else
+        {
+            if (!octaspire_dern_value_as_vector_push_back_element(
+                result,
+                &quotedValue))
+            {
+                abort();
+            }
+
+            octaspire_dern_vm_pop_value(self, result);
+        }
+    }
+
+    return result;
+}
+
+// Reads the datum after a back quote and gives it as a template.
+static octaspire_dern_value_t *octaspire_dern_vm_private_parse_template(
+    octaspire_dern_vm_t * const self,
+    octaspire_input_t *input)
+{
+    octaspire_dern_value_t *result = 0;
+
+    octaspire_dern_value_t *templateValue = octaspire_dern_vm_parse(
+        self,
+        input);
+
+    octaspire_dern_vm_push_value(self, templateValue);
+
+    if (!templateValue || templateValue->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+    {
+        result = templateValue; // report error to caller
+    }
+    else
+    {
+        octaspire_dern_value_t *templateSym =
+            octaspire_dern_vm_create_new_value_symbol_from_c_string(
+                self,
+                "template");
+
+        octaspire_helpers_verify_not_null(templateSym);
+        octaspire_dern_vm_push_value(self, templateSym);
+
+        if (octaspire_dern_value_is_vector(templateValue))
+        {
+            if (!octaspire_dern_value_as_vector_push_front_element(
+                    templateValue,
+                    &templateSym))
+            {
+                abort();
+            }
+
+            result = templateValue;
+        }
+        else
+        {
+            result = octaspire_dern_vm_create_new_value_vector(self);
+
+            if (!result)
+            {
+                result = octaspire_dern_vm_create_new_value_error_from_c_string(
+                    self,
+                    "Allocation failure");
+            }
+            else
+            {
+                octaspire_dern_vm_push_value(self, result);
+
+                if (!octaspire_dern_value_as_vector_push_back_element(
+                        result,
+                        &templateSym))
+                {
+                    abort();
+                }
+
+                if (!octaspire_dern_value_as_vector_push_back_element(
+                        result,
+                        &templateValue))
+                {
+                    abort();
+                }
+
+                octaspire_dern_vm_pop_value(self, result);
+            }
         }
+
+        octaspire_dern_vm_pop_value(self, templateSym);
     }
 
-    octaspire_helpers_verify_true(
-        stackLength == octaspire_dern_vm_get_stack_length(self));
+    octaspire_dern_vm_pop_value(self, templateValue);
 
-    return true;
+    return result;
 }
 
-bool octaspire_dern_vm_private_mark(octaspire_dern_vm_t *self, octaspire_dern_value_t *value)
+// Lines and columns of the input being parsed are counted from the start
+// of the input; these give them as positions in the source where the
+// input starts. Only the first line of the input starts at a column
+// other than one.
+static size_t octaspire_dern_vm_private_get_source_line_number(
+    octaspire_dern_vm_t const * const self,
+    size_t const line)
 {
-    OCTASPIRE_HELPERS_UNUSED_PARAMETER(self);
-    return octaspire_dern_value_mark(value);
+    return line + self->inputFirstLineNumber - 1;
 }
 
-bool octaspire_dern_vm_private_sweep(octaspire_dern_vm_t *self)
+static size_t octaspire_dern_vm_private_get_source_column_number(
+    octaspire_dern_vm_t const * const self,
+    size_t const column,
+    size_t const line)
 {
-    for (size_t i = 0; i < octaspire_vector_get_length(self->all); /* NOP */ )
+    return (line == 1) ? (column + self->inputFirstColumnNumber - 1) : column;
+}
+
+// Tokens are popped with positions in the source, so that every message
+// of the parser tells where in the source the token is.
+static octaspire_dern_lexer_token_t *octaspire_dern_vm_private_pop_next_token(
+    octaspire_dern_vm_t * const self,
+    octaspire_input_t * const input)
+{
+    octaspire_dern_lexer_token_t * const token =
+        octaspire_dern_lexer_pop_next_token(input, self->allocator);
+
+    if (!token)
     {
-        octaspire_dern_value_t * const value =
-            octaspire_vector_get_element_at(
-                self->all,
-                (ptrdiff_t)i);
+        return token;
+    }
 
-        if (value->mark)
-        {
-            value->mark = false;
+    octaspire_dern_lexer_token_position_t * const line =
+        octaspire_dern_lexer_token_get_position_line(token);
 
-            ++i;
-        }
-        else
-        {
-            octaspire_dern_vm_private_release_value(self, value);
+    octaspire_dern_lexer_token_position_t * const column =
+        octaspire_dern_lexer_token_get_position_column(token);
 
-            octaspire_dern_value_t *value2 =
-                octaspire_vector_get_element_at(
-                    self->all,
-                    (ptrdiff_t)i);
+    octaspire_dern_lexer_token_position_t * const ucsIndex =
+        octaspire_dern_lexer_token_get_position_ucs_index(token);
 
-            octaspire_helpers_verify_true(value == value2);
+    column->start =
+        octaspire_dern_vm_private_get_source_column_number(self, column->start, line->start);
 
-            if (!octaspire_vector_remove_element_at(
-                    self->all,
-                    (ptrdiff_t)i))
-            {
-                abort();
-            }
-        }
-    }
+    column->end =
+        octaspire_dern_vm_private_get_source_column_number(self, column->end, line->end);
 
-    return true;
+    line->start = octaspire_dern_vm_private_get_source_line_number(self, line->start);
+    line->end   = octaspire_dern_vm_private_get_source_line_number(self, line->end);
+
+    ucsIndex->start += self->inputFirstUcsIndex;
+    ucsIndex->end   += self->inputFirstUcsIndex;
+
+    return token;
+}
+
+// 'column' and 'line' are positions in the source.
+static octaspire_dern_value_t *octaspire_dern_vm_private_create_new_value_error_missing_right_parenthesis(
+    octaspire_dern_vm_t * const self,
+    size_t const column,
+    size_t const line)
+{
+    return octaspire_dern_vm_create_new_value_error(
+        self,
+        octaspire_string_new_format(
+            self->allocator,
+            "Balancing right parenthesis ')' missing for left "
+            "parenthesis given at column %zu of line %zu",
+            column,
+            line));
 }
 
 octaspire_dern_value_t *octaspire_dern_vm_parse_token(
@@ -3110,7 +5050,7 @@ octaspire_dern_value_t *octaspire_dern_vm_parse_token(
                     token2 = 0;
                     octaspire_helpers_verify_true(token2 == 0);
 
-                    token2 = octaspire_dern_lexer_pop_next_token(input, self->allocator);
+                    token2 = octaspire_dern_vm_private_pop_next_token(self, input);
 
                     if (!token2)
                     {
@@ -3124,14 +5064,10 @@ octaspire_dern_value_t *octaspire_dern_vm_parse_token(
                         octaspire_helpers_verify_true(
                             stackLength == octaspire_dern_vm_get_stack_length(self));
 
-                        return octaspire_dern_vm_create_new_value_error(
+                        return octaspire_dern_vm_private_create_new_value_error_missing_right_parenthesis(
                             self,
-                            octaspire_string_new_format(
-                                self->allocator,
-                                "Balancing right parenthesis ')' missing for left "
-                                "parenthesis given at column %zu of line %zu",
-                                octaspire_dern_lexer_token_get_position_column(token)->start,
-                                octaspire_dern_lexer_token_get_position_line(token)->start));
+                            octaspire_dern_lexer_token_get_position_column(token)->start,
+                            octaspire_dern_lexer_token_get_position_line(token)->start);
                     }
                     else if (
                         octaspire_dern_lexer_token_get_type_tag(token2) ==
@@ -3191,14 +5127,10 @@ octaspire_dern_value_t *octaspire_dern_vm_parse_token(
                                 octaspire_helpers_verify_true(
                                     stackLength == octaspire_dern_vm_get_stack_length(self));
 
-                                return octaspire_dern_vm_create_new_value_error(
+                                return octaspire_dern_vm_private_create_new_value_error_missing_right_parenthesis(
                                     self,
-                                    octaspire_string_new_format(
-                                        self->allocator,
-                                        "Balancing right parenthesis ')' missing for left "
-                                        "parenthesis given at column %zu of line %zu",
-                                        octaspire_dern_lexer_token_get_position_column(token)->start,
-                                        octaspire_dern_lexer_token_get_position_line(token)->start));
+                                    octaspire_dern_lexer_token_get_position_column(token)->start,
+                                    octaspire_dern_lexer_token_get_position_line(token)->start);
                             }
 
                             if (element->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
@@ -3231,121 +5163,13 @@ octaspire_dern_value_t *octaspire_dern_vm_parse_token(
 
         case OCTASPIRE_DERN_LEXER_TOKEN_TAG_QUOTE:
         {
-            result = octaspire_dern_vm_create_new_value_vector(self);
-
-            if (!result)
-            {
-                result = octaspire_dern_vm_create_new_value_error_from_c_string(
-                    self,
-                    "Allocation failure");
-            }
-            else
-            {
-                octaspire_dern_vm_push_value(self, result);
-
-                octaspire_dern_value_t *quoteSym =
-                    octaspire_dern_vm_create_new_value_symbol_from_c_string(self, "quote");
-
-                octaspire_helpers_verify_not_null(quoteSym);
-
-                if (!octaspire_dern_value_as_vector_push_back_element(result, &quoteSym))
-                {
-                    abort();
-                }
-
-                octaspire_dern_value_t *quotedValue = octaspire_dern_vm_parse(
-                    self,
-                    input);
-
-                if (!quotedValue || quotedValue->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-                {
-                    octaspire_dern_vm_pop_value(self, result);
-                    result = quotedValue; // report error to caller
-                }
-                else
-                {
-                    if (!octaspire_dern_value_as_vector_push_back_element(
-                        result,
-                        &quotedValue))
-                    {
-                        abort();
-                    }
-
-                    octaspire_dern_vm_pop_value(self, result);
-                }
-            }
+            result = octaspire_dern_vm_private_parse_quoted(self, input);
         }
         break;
 
         case OCTASPIRE_DERN_LEXER_TOKEN_TAG_BACK_QUOTE:
         {
-            octaspire_dern_value_t *templateValue = octaspire_dern_vm_parse(
-                self,
-                input);
-
-            octaspire_dern_vm_push_value(self, templateValue);
-
-            if (!templateValue || templateValue->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
-            {
-                result = templateValue; // report error to caller
-            }
-            else
-            {
-                octaspire_dern_value_t *templateSym =
-                    octaspire_dern_vm_create_new_value_symbol_from_c_string(
-                        self,
-                        "template");
-
-                octaspire_helpers_verify_not_null(templateSym);
-                octaspire_dern_vm_push_value(self, templateSym);
-
-                if (octaspire_dern_value_is_vector(templateValue))
-                {
-                    if (!octaspire_dern_value_as_vector_push_front_element(
-                            templateValue,
-                            &templateSym))
-                    {
-                        abort();
-                    }
-
-                    result = templateValue;
-                }
-                else
-                {
-                    result = octaspire_dern_vm_create_new_value_vector(self);
-
-                    if (!result)
-                    {
-                        result = octaspire_dern_vm_create_new_value_error_from_c_string(
-                            self,
-                            "Allocation failure");
-                    }
-                    else
-                    {
-                        octaspire_dern_vm_push_value(self, result);
-
-                        if (!octaspire_dern_value_as_vector_push_back_element(
-                                result,
-                                &templateSym))
-                        {
-                            abort();
-                        }
-
-                        if (!octaspire_dern_value_as_vector_push_back_element(
-                                result,
-                                &templateValue))
-                        {
-                            abort();
-                        }
-
-                        octaspire_dern_vm_pop_value(self, result);
-                    }
-                }
-
-                octaspire_dern_vm_pop_value(self, templateSym);
-            }
-
-            octaspire_dern_vm_pop_value(self, templateValue);
+            result = octaspire_dern_vm_private_parse_template(self, input);
         }
         break;
 
@@ -3459,12 +5283,12 @@ octaspire_dern_value_t *octaspire_dern_vm_parse_token(
     return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_parse(
+static octaspire_dern_value_t *octaspire_dern_vm_private_parse_from_token(
     octaspire_dern_vm_t *self,
     octaspire_input_t *input)
 {
     octaspire_dern_lexer_token_t *token =
-        octaspire_dern_lexer_pop_next_token(input, self->allocator);
+        octaspire_dern_vm_private_pop_next_token(self, input);
 
     octaspire_dern_value_t *result =
         octaspire_dern_vm_parse_token(self, token, input);
@@ -3475,6 +5299,205 @@ octaspire_dern_value_t *octaspire_dern_vm_parse(
     return result;
 }
 
+// Reads the elements of a list after its left parenthesis. Only the
+// position of the left parenthesis is kept, for reporting a missing
+// right parenthesis.
+static octaspire_dern_value_t *octaspire_dern_vm_private_parse_list(
+    octaspire_dern_vm_t *self,
+    octaspire_input_t *input,
+    size_t const line,
+    size_t const column)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_dern_value_t * const result = octaspire_dern_vm_create_new_value_vector(self);
+
+    // Protect result (and all values inside it) from the garbage collector during
+    // this phase.
+    octaspire_dern_vm_push_value(self, result);
+
+    while (true)
+    {
+        octaspire_dern_lexer_pop_whitespace_and_line_comments(input);
+
+        if (octaspire_input_peek_next_ucs_character(input) == ')' &&
+            octaspire_input_is_good(input))
+        {
+            if (!octaspire_input_pop_next_ucs_character(input))
+            {
+                abort();
+            }
+
+            octaspire_dern_vm_pop_value(self, result);
+
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(self));
+
+            return result;
+        }
+
+        octaspire_dern_value_t *element = 0;
+
+        if (octaspire_input_peek_next_ucs_character(input)      == '#' &&
+            octaspire_input_peek_next_next_ucs_character(input) == '!')
+        {
+            // Multiline comment can be followed by the right parenthesis,
+            // so the lexer reads past the comment to the next token.
+            octaspire_dern_lexer_token_t *token =
+                octaspire_dern_vm_private_pop_next_token(self, input);
+
+            if (token &&
+                octaspire_dern_lexer_token_get_type_tag(token) ==
+                    OCTASPIRE_DERN_LEXER_TOKEN_TAG_RPAREN)
+            {
+                octaspire_dern_lexer_token_release(token);
+                token = 0;
+
+                octaspire_dern_vm_pop_value(self, result);
+
+                octaspire_helpers_verify_true(
+                    stackLength == octaspire_dern_vm_get_stack_length(self));
+
+                return result;
+            }
+
+            element = octaspire_dern_vm_parse_token(self, token, input);
+
+            octaspire_dern_lexer_token_release(token);
+            token = 0;
+        }
+        else
+        {
+            element = octaspire_dern_vm_parse(self, input);
+        }
+
+        if (!element)
+        {
+            // We have not seen balancing right parenthesis yet,
+            // report an error.
+            octaspire_dern_vm_pop_value(self, result);
+
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(self));
+
+            return octaspire_dern_vm_private_create_new_value_error_missing_right_parenthesis(
+                self,
+                column,
+                line);
+        }
+
+        if (element->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_dern_vm_pop_value(self, result);
+
+            octaspire_helpers_verify_true(
+                stackLength == octaspire_dern_vm_get_stack_length(self));
+
+            return element;
+        }
+
+        // TODO report allocation error instead of asserting
+        if (!octaspire_vector_push_back_element(
+            result->value.vector,
+            &element))
+        {
+            abort();
+        }
+    }
+}
+
+// Builds values straight from the input. Lists, quotes and symbols are
+// read without creating lexer tokens; other data is read as a token.
+octaspire_dern_value_t *octaspire_dern_vm_parse(
+    octaspire_dern_vm_t *self,
+    octaspire_input_t *input)
+{
+    octaspire_dern_lexer_pop_whitespace_and_line_comments(input);
+
+    if (!octaspire_input_is_good(input))
+    {
+        return 0;
+    }
+
+    switch (octaspire_input_peek_next_ucs_character(input))
+    {
+        case '(':
+        {
+            size_t const line = octaspire_input_get_line_number(input);
+
+            size_t const column = octaspire_dern_vm_private_get_source_column_number(
+                self,
+                octaspire_input_get_column_number(input),
+                line);
+
+            if (!octaspire_input_pop_next_ucs_character(input))
+            {
+                abort();
+            }
+
+            return octaspire_dern_vm_private_parse_list(
+                self,
+                input,
+                octaspire_dern_vm_private_get_source_line_number(self, line),
+                column);
+        }
+
+        case '\'':
+        {
+            if (!octaspire_input_pop_next_ucs_character(input))
+            {
+                abort();
+            }
+
+            return octaspire_dern_vm_private_parse_quoted(self, input);
+        }
+
+        case '`':
+        {
+            if (!octaspire_input_pop_next_ucs_character(input))
+            {
+                abort();
+            }
+
+            return octaspire_dern_vm_private_parse_template(self, input);
+        }
+    }
+
+    if (!octaspire_dern_lexer_is_symbol_next(input))
+    {
+        return octaspire_dern_vm_private_parse_from_token(self, input);
+    }
+
+    octaspire_string_t *text = octaspire_dern_lexer_pop_symbol_text(input, self->allocator);
+
+    if (!text)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            self,
+            "Allocation failure");
+    }
+
+    if (octaspire_string_is_equal_to_c_string(text, "true"))
+    {
+        octaspire_string_release(text);
+        return octaspire_dern_vm_get_value_true(self);
+    }
+
+    if (octaspire_string_is_equal_to_c_string(text, "false"))
+    {
+        octaspire_string_release(text);
+        return octaspire_dern_vm_get_value_false(self);
+    }
+
+    if (octaspire_string_is_equal_to_c_string(text, "nil"))
+    {
+        octaspire_string_release(text);
+        return octaspire_dern_vm_get_value_nil(self);
+    }
+
+    return octaspire_dern_vm_create_new_value_symbol(self, text);
+}
+
 octaspire_dern_value_t *octaspire_dern_vm_eval_in_global_environment(
     octaspire_dern_vm_t *self,
     octaspire_dern_value_t *value)
@@ -3494,6 +5517,9 @@ octaspire_dern_value_t *octaspire_dern_vm_call_lambda(
 
     octaspire_helpers_verify_not_null(function);
     octaspire_helpers_verify_not_null(function->formals);
+    octaspire_dern_value_prepare_for_element_access(function->formals);
+    octaspire_dern_value_prepare_for_element_access(function->body);
+
     octaspire_helpers_verify_not_null(function->formals->value.vector);
     octaspire_helpers_verify_not_null(function->body);
     octaspire_helpers_verify_not_null(function->body->value.vector);
@@ -3588,6 +5614,80 @@ octaspire_dern_value_t *octaspire_dern_vm_call_lambda(
     return result;
 }
 
+// Names at the smallest edit distance from a misspelled name are
+// suggested for it. Ties are broken by preferring names that start like
+// the misspelled name, and then names of similar length.
+typedef struct octaspire_dern_vm_private_suggestion_rank_t
+{
+    size_t distance;
+    size_t numSharedPrefixChars;
+    size_t lengthDifference;
+}
+octaspire_dern_vm_private_suggestion_rank_t;
+
+static octaspire_dern_vm_private_suggestion_rank_t octaspire_dern_vm_private_rank_suggestion(
+    octaspire_string_t const * const misspelled,
+    octaspire_string_t const * const name)
+{
+    size_t const misspelledLength =
+        octaspire_string_get_length_in_ucs_characters(misspelled);
+
+    size_t const nameLength = octaspire_string_get_length_in_ucs_characters(name);
+
+    octaspire_dern_vm_private_suggestion_rank_t result =
+    {
+        .distance             = octaspire_string_levenshtein_distance(misspelled, name),
+        .numSharedPrefixChars = 0,
+        .lengthDifference     = (misspelledLength > nameLength) ?
+            (misspelledLength - nameLength) : (nameLength - misspelledLength)
+    };
+
+    while (result.numSharedPrefixChars < misspelledLength &&
+           result.numSharedPrefixChars < nameLength &&
+           octaspire_string_get_ucs_character_at_index(
+               misspelled,
+               (ptrdiff_t)result.numSharedPrefixChars) ==
+           octaspire_string_get_ucs_character_at_index(
+               name,
+               (ptrdiff_t)result.numSharedPrefixChars))
+    {
+        ++(result.numSharedPrefixChars);
+    }
+
+    return result;
+}
+
+// Negative if 'self' is a better suggestion than 'other'.
+static int octaspire_dern_vm_private_compare_suggestion_ranks(
+    octaspire_dern_vm_private_suggestion_rank_t const * const self,
+    octaspire_dern_vm_private_suggestion_rank_t const * const other)
+{
+    if (self->distance != other->distance)
+    {
+        return (self->distance < other->distance) ? -1 : 1;
+    }
+
+    if (self->numSharedPrefixChars != other->numSharedPrefixChars)
+    {
+        return (self->numSharedPrefixChars > other->numSharedPrefixChars) ? -1 : 1;
+    }
+
+    if (self->lengthDifference != other->lengthDifference)
+    {
+        return (self->lengthDifference < other->lengthDifference) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+// Names that need more edits than about a third of the misspelled name
+// have little in common with it, and are not suggested.
+static size_t octaspire_dern_vm_private_get_max_suggestion_distance(
+    octaspire_string_t const * const misspelled)
+{
+    return (octaspire_string_get_length_in_ucs_characters(misspelled) + 2) / 3;
+}
+
 static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
     octaspire_dern_vm_t    * self,
     octaspire_dern_value_t * value,
@@ -3674,8 +5774,6 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
                     value,
                     self->allocator);
 
-                int    bestDist                      = INT_MAX;
-
                 octaspire_string_t * bestNames = octaspire_string_new(
                     "",
                     octaspire_dern_vm_get_allocator(self));
@@ -3686,24 +5784,14 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
 
                 assert(names);
 
-                // Find the shortest distance.
+                // Find the best rank and the number of names that have it.
 
-                for (size_t i = 0; i < octaspire_vector_get_length(names); ++i)
+                octaspire_dern_vm_private_suggestion_rank_t bestRank =
                 {
-                    octaspire_string_t const * const elemAsStr =
-                        octaspire_vector_get_element_at_const(names, i);
-
-                    assert(elemAsStr);
-
-                    int dist = octaspire_string_levenshtein_distance(str, elemAsStr);
-
-                    if (dist < bestDist)
-                    {
-                        bestDist  = dist;
-                    }
-                }
-
-                // Count the number of best alternatives.
+                    .distance              = SIZE_MAX,
+                    .numSharedPrefixChars  = 0,
+                    .lengthDifference      = 0
+                };
 
                 size_t numBestDist = 0;
 
@@ -3714,35 +5802,55 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
 
                     assert(elemAsStr);
 
-                    int dist = octaspire_string_levenshtein_distance(str, elemAsStr);
+                    octaspire_dern_vm_private_suggestion_rank_t const rank =
+                        octaspire_dern_vm_private_rank_suggestion(str, elemAsStr);
 
-                    if (dist == bestDist)
+                    int const cmp =
+                        octaspire_dern_vm_private_compare_suggestion_ranks(&rank, &bestRank);
+
+                    if (cmp < 0)
+                    {
+                        bestRank    = rank;
+                        numBestDist = 1;
+                    }
+                    else if (cmp == 0)
                     {
                         ++numBestDist;
                     }
                 }
 
+                if (bestRank.distance >
+                    octaspire_dern_vm_private_get_max_suggestion_distance(str))
+                {
+                    numBestDist = 0;
+                }
+
                 // Concatenate into a string to collect all
                 // the best alternatives.
 
                 size_t numBestAdded = 0;
 
-                for (size_t i = 0; i < octaspire_vector_get_length(names); ++i)
+                for (size_t i = 0;
+                     numBestDist && i < octaspire_vector_get_length(names);
+                     ++i)
                 {
                     octaspire_string_t const * const elemAsStr =
                         octaspire_vector_get_element_at_const(names, i);
 
                     assert(elemAsStr);
 
-                    int dist = octaspire_string_levenshtein_distance(str, elemAsStr);
+                    octaspire_dern_vm_private_suggestion_rank_t const rank =
+                        octaspire_dern_vm_private_rank_suggestion(str, elemAsStr);
 
-                    if (dist == bestDist)
+                    if (octaspire_dern_vm_private_compare_suggestion_ranks(
+                            &rank,
+                            &bestRank) == 0)
                     {
                         if (!numBestAdded)
                         {
                             octaspire_string_concatenate_format(
                                 bestNames,
-                                "Did you mean '%s'%s",
+                                " Did you mean '%s'%s",
                                 octaspire_string_get_c_string(elemAsStr),
                                 (numBestAdded == (numBestDist - 1)) ? "?" : "");
                         }
@@ -3769,7 +5877,7 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
                         self,
                         octaspire_string_new_format(
                             self->allocator,
-                            "Unbound symbol '%s'. %s",
+                            "Unbound symbol '%s'.%s",
                             octaspire_string_get_c_string(str),
                             octaspire_string_get_c_string(bestNames)));
 
@@ -3787,6 +5895,8 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
 
         case OCTASPIRE_DERN_VALUE_TAG_VECTOR:
         {
+            octaspire_dern_value_prepare_for_element_access(value);
+
             octaspire_vector_t *vec = value->value.vector;
 
             if (octaspire_vector_is_empty(vec))
@@ -4067,6 +6177,9 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
                         octaspire_helpers_verify_not_null(function);
                         octaspire_helpers_verify_not_null(function->formals);
                         // Invalid read of size 4 below
+                        octaspire_dern_value_prepare_for_element_access(function->formals);
+                        octaspire_dern_value_prepare_for_element_access(function->body);
+
                         octaspire_helpers_verify_not_null(function->formals->value.vector);
                         octaspire_helpers_verify_not_null(function->body);
                         octaspire_helpers_verify_not_null(function->body->value.vector);
@@ -4204,6 +6317,15 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
                 case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
                 case OCTASPIRE_DERN_VALUE_TAG_PORT:
                 case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+                case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+                case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+                case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+                case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+                case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+                case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+                case OCTASPIRE_DERN_VALUE_TAG_SET:
+                case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+                case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
                 case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
                 {
                     octaspire_string_t *str = octaspire_dern_value_to_string(
@@ -4235,6 +6357,15 @@ static octaspire_dern_value_t *octaspire_dern_vm_private_eval_impl(
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
         {
             result = octaspire_dern_vm_create_new_value_error(
                 self,
@@ -4308,61 +6439,338 @@ octaspire_dern_value_t *octaspire_dern_vm_eval(
             wasMacroCall = true;
         }
 
-        value = result;
+        value = result;
+    }
+}
+
+// Parsed forms are added to 'fasl', if it is given, before they are
+// evaluated. 'firstLineNumber', 'firstColumnNumber' and 'firstUcsIndex'
+// are the position in the source where 'input' starts.
+static octaspire_dern_value_t *octaspire_dern_vm_private_read_from_octaspire_input_and_eval(
+    octaspire_dern_vm_t *self,
+    octaspire_input_t * const input,
+    octaspire_dern_fasl_t * const fasl,
+    size_t const firstLineNumber,
+    size_t const firstColumnNumber,
+    size_t const firstUcsIndex)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    if (!input || !octaspire_input_is_good(input))
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    octaspire_dern_value_t *lastGoodResult = 0;
+    octaspire_dern_value_t *result = 0;
+
+    while (octaspire_input_is_good(input))
+    {
+        // Positions in the messages of the parser are positions in the
+        // source, not in 'input'.
+        self->inputFirstLineNumber   = firstLineNumber;
+        self->inputFirstColumnNumber = firstColumnNumber;
+        self->inputFirstUcsIndex     = firstUcsIndex;
+
+        octaspire_dern_value_t * const form = octaspire_dern_vm_parse(self, input);
+
+        self->inputFirstLineNumber   = 1;
+        self->inputFirstColumnNumber = 1;
+        self->inputFirstUcsIndex     = 0;
+
+        if (fasl && form)
+        {
+            octaspire_dern_fasl_push_back_form(
+                fasl,
+                form,
+                firstLineNumber + octaspire_input_get_line_number(input) - 1);
+        }
+
+        result = octaspire_dern_vm_eval_in_global_environment(self, form);
+
+        if (!result)
+        {
+            break;
+        }
+
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_pop_value(self, lastGoodResult);
+        }
+
+        lastGoodResult = result;
+        octaspire_dern_vm_push_value(self, lastGoodResult);
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_dern_value_as_error_set_line_number(
+                result,
+                octaspire_input_get_line_number(input));
+
+            break;
+        }
+    }
+
+    //octaspire_input_release(input);
+    //input = 0;
+
+    if (!result && lastGoodResult)
+    {
+        octaspire_dern_vm_pop_value(self, lastGoodResult);
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+        return lastGoodResult;
+    }
+
+    if (lastGoodResult)
+    {
+        octaspire_dern_vm_pop_value(self, lastGoodResult);
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    octaspire_input_t * const input)
+{
+    return octaspire_dern_vm_private_read_from_octaspire_input_and_eval(self, input, 0, 1, 1, 0);
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    char const * const str)
+{
+    if (!str)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    // TODO should more efficient version without strlen be used?
+    return octaspire_dern_vm_read_from_buffer_and_eval_in_global_environment(
+        self,
+        str,
+        strlen(str));
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_read_from_buffer_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    char const * const buffer,
+    size_t const lengthInOctets)
+{
+    if (!buffer || lengthInOctets == 0)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    octaspire_input_t *input =
+        octaspire_input_new_from_buffer(buffer, lengthInOctets, self->allocator);
+
+    if (!input)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            self,
+            "Allocation failure of input");
+    }
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(self, input);
+
+    octaspire_input_release(input);
+    input = 0;
+
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    char const * const path)
+{
+    octaspire_dern_reader_t *reader =
+        octaspire_dern_reader_new_from_path(path, self->stdio, self->allocator);
+
+    if (!reader)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(self, reader);
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    return result;
+}
+
+octaspire_dern_value_t *octaspire_dern_vm_read_from_file_and_eval_in_global_environment(
+    octaspire_dern_vm_t *self,
+    FILE * const file)
+{
+    if (!file)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    octaspire_dern_reader_t *reader =
+        octaspire_dern_reader_new_from_file(file, self->stdio, self->allocator);
+
+    if (!reader)
+    {
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            self,
+            "Allocation failure of reader");
+    }
+
+    octaspire_dern_value_t * const result =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(self, reader);
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    return result;
+}
+
+static octaspire_dern_value_t *octaspire_dern_vm_private_read_from_reader_and_eval(
+    octaspire_dern_vm_t *self,
+    octaspire_dern_reader_t * const reader,
+    octaspire_dern_fasl_t * const fasl)
+{
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_dern_value_t *lastGoodResult = 0;
+    octaspire_dern_value_t *result = 0;
+
+    // Every form gets an input of its own, so that the decoded characters
+    // of only one form are in memory at a time.
+    while (octaspire_dern_reader_read_next_form(reader))
+    {
+        octaspire_input_t *input = octaspire_input_new_from_buffer(
+            octaspire_dern_reader_get_form_octets(reader),
+            octaspire_dern_reader_get_form_length_in_octets(reader),
+            self->allocator);
+
+        if (!input)
+        {
+            result = octaspire_dern_vm_create_new_value_error_from_c_string(
+                self,
+                "Allocation failure of input");
+
+            break;
+        }
+
+        result = octaspire_dern_vm_private_read_from_octaspire_input_and_eval(
+            self,
+            input,
+            fasl,
+            octaspire_dern_reader_get_form_line_number(reader),
+            octaspire_dern_reader_get_form_column_number(reader),
+            octaspire_dern_reader_get_form_ucs_index(reader));
+
+        octaspire_input_release(input);
+        input = 0;
+
+        if (!result)
+        {
+            break;
+        }
+
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            // Line number of the form in the input is counted from the
+            // line where the form starts.
+            octaspire_dern_value_as_error_set_line_number(
+                result,
+                octaspire_dern_reader_get_form_line_number(reader) +
+                    result->value.error->lineNumber - 1);
+
+            break;
+        }
+
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_pop_value(self, lastGoodResult);
+        }
+
+        lastGoodResult = result;
+        octaspire_dern_vm_push_value(self, lastGoodResult);
+    }
+
+    if (octaspire_dern_reader_has_error(reader) ||
+        octaspire_dern_reader_get_number_of_octets_read(reader) == 0)
+    {
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_pop_value(self, lastGoodResult);
+        }
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+    }
+
+    if (lastGoodResult)
+    {
+        octaspire_dern_vm_pop_value(self, lastGoodResult);
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+
+    if (!result || result == lastGoodResult)
+    {
+        return lastGoodResult;
     }
+
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(
+// Evaluates the loaded forms of 'fasl' as the forms of the source would
+// have been evaluated.
+static octaspire_dern_value_t *octaspire_dern_vm_private_read_from_fasl_and_eval(
     octaspire_dern_vm_t *self,
-    octaspire_input_t * const input)
+    octaspire_dern_fasl_t * const fasl)
 {
     size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
 
-    if (!input || !octaspire_input_is_good(input))
-    {
-        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
-    }
-
     octaspire_dern_value_t *lastGoodResult = 0;
     octaspire_dern_value_t *result = 0;
+    size_t lineNumber = 0;
 
-    while (octaspire_input_is_good(input))
+    while (true)
     {
-        result = octaspire_dern_vm_eval_in_global_environment(
-            self,
-            octaspire_dern_vm_parse(self, input));
+        octaspire_dern_value_t * const form =
+            octaspire_dern_fasl_read_next_form(fasl, self, &lineNumber);
 
-        if (!result)
+        if (!form)
         {
             break;
         }
 
-        if (lastGoodResult)
+        if (form->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
         {
-            octaspire_dern_vm_pop_value(self, lastGoodResult);
+            result = form;
+            break;
         }
 
-        lastGoodResult = result;
-        octaspire_dern_vm_push_value(self, lastGoodResult);
+        result = octaspire_dern_vm_eval_in_global_environment(self, form);
 
-        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        if (!result)
         {
-            octaspire_dern_value_as_error_set_line_number(
-                result,
-                octaspire_input_get_line_number(input));
+            break;
+        }
 
+        if (result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_dern_value_as_error_set_line_number(result, lineNumber);
             break;
         }
-    }
 
-    //octaspire_input_release(input);
-    //input = 0;
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_pop_value(self, lastGoodResult);
+        }
 
-    if (!result && lastGoodResult)
-    {
-        octaspire_dern_vm_pop_value(self, lastGoodResult);
-        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
-        return lastGoodResult;
+        lastGoodResult = result;
+        octaspire_dern_vm_push_value(self, lastGoodResult);
     }
 
     if (lastGoodResult)
@@ -4371,72 +6779,134 @@ octaspire_dern_value_t *octaspire_dern_vm_read_from_octaspire_input_and_eval_in_
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
-    return result;
-}
 
-octaspire_dern_value_t *octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-    octaspire_dern_vm_t *self,
-    char const * const str)
-{
-    if (!str)
+    if (!result || result == lastGoodResult)
     {
-        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+        return lastGoodResult;
     }
 
-    // TODO should more efficient version without strlen be used?
-    return octaspire_dern_vm_read_from_buffer_and_eval_in_global_environment(
-        self,
-        str,
-        strlen(str));
+    return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_read_from_buffer_and_eval_in_global_environment(
+octaspire_dern_value_t *octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(
     octaspire_dern_vm_t *self,
-    char const * const buffer,
-    size_t const lengthInOctets)
+    octaspire_dern_reader_t * const reader)
 {
-    if (!buffer || lengthInOctets == 0)
+    char const * const path = octaspire_dern_reader_get_path(reader);
+
+    octaspire_dern_fasl_t *fasl = (self->config.faslCacheOn && path) ?
+        octaspire_dern_fasl_new(
+            path,
+            self->config.faslCacheDirectory,
+            self->stdio,
+            self->allocator) :
+        0;
+
+    if (!fasl)
     {
-        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+        return octaspire_dern_vm_private_read_from_reader_and_eval(self, reader, 0);
     }
 
-    octaspire_input_t *input =
-        octaspire_input_new_from_buffer(buffer, lengthInOctets, self->allocator);
+    octaspire_dern_value_t *result = 0;
 
-    if (!input)
+    if (octaspire_dern_fasl_load(fasl))
     {
-        return octaspire_dern_vm_create_new_value_error_from_c_string(
-            self,
-            "Allocation failure of input");
+        result = octaspire_dern_vm_private_read_from_fasl_and_eval(self, fasl);
     }
+    else
+    {
+        result = octaspire_dern_vm_private_read_from_reader_and_eval(self, reader, fasl);
 
-    octaspire_dern_value_t * const result =
-        octaspire_dern_vm_read_from_octaspire_input_and_eval_in_global_environment(self, input);
+        // Forms are saved only when all of them were read and evaluated.
+        if (!result || result->typeTag != OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            octaspire_dern_fasl_save(fasl);
+        }
+    }
 
-    octaspire_input_release(input);
-    input = 0;
+    octaspire_dern_fasl_release(fasl);
+    fasl = 0;
 
     return result;
 }
 
-octaspire_dern_value_t *octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
+octaspire_dern_value_t *octaspire_dern_vm_read_from_paths_and_eval_in_global_environment(
     octaspire_dern_vm_t *self,
-    char const * const path)
+    char const * const * const paths,
+    size_t const numPaths)
 {
-    size_t bufLen = 0;
-    char *buffer = octaspire_helpers_path_to_buffer(path, &bufLen, self->allocator, self->stdio);
+    octaspire_dern_loader_t *loader = octaspire_dern_loader_new(
+        paths,
+        numPaths,
+        self->config.faslCacheOn,
+        self->config.faslCacheDirectory,
+        self->allocator);
 
-    if (!buffer || !bufLen)
+    if (!loader)
     {
-        return octaspire_dern_vm_create_new_value_error_from_c_string(self, "No input");
+        return octaspire_dern_vm_create_new_value_error_from_c_string(
+            self,
+            "Allocation failure of loader");
     }
 
-    octaspire_dern_value_t *result =
-        octaspire_dern_vm_read_from_buffer_and_eval_in_global_environment(self, buffer, bufLen);
+    size_t const stackLength = octaspire_dern_vm_get_stack_length(self);
+
+    octaspire_dern_value_t *lastGoodResult = 0;
+    octaspire_dern_value_t *result = 0;
+
+    for (size_t i = 0; i < numPaths; ++i)
+    {
+        bool isLoadedFromCache = false;
+
+        octaspire_dern_fasl_t * const fasl =
+            octaspire_dern_loader_wait_for_forms(loader, i, &isLoadedFromCache);
+
+        if (fasl)
+        {
+            result = octaspire_dern_vm_private_read_from_fasl_and_eval(self, fasl);
+
+            if (self->config.faslCacheOn &&
+                !isLoadedFromCache       &&
+                (!result || result->typeTag != OCTASPIRE_DERN_VALUE_TAG_ERROR))
+            {
+                octaspire_dern_fasl_save(fasl);
+            }
+        }
+        else
+        {
+            // The reader reports errors of the file as usual.
+            result = octaspire_dern_vm_read_from_path_and_eval_in_global_environment(
+                self,
+                paths[i]);
+        }
+
+        if (result && result->typeTag == OCTASPIRE_DERN_VALUE_TAG_ERROR)
+        {
+            break;
+        }
+
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_pop_value(self, lastGoodResult);
+        }
+
+        lastGoodResult = result;
+
+        if (lastGoodResult)
+        {
+            octaspire_dern_vm_push_value(self, lastGoodResult);
+        }
+    }
 
-    octaspire_allocator_free(self->allocator, buffer);
-    buffer = 0;
-    bufLen = 0;
+    octaspire_dern_loader_release(loader);
+    loader = 0;
+
+    if (lastGoodResult)
+    {
+        octaspire_dern_vm_pop_value(self, lastGoodResult);
+    }
+
+    octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
 
     return result;
 }
@@ -4758,10 +7228,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER)
             {
                 octaspire_vector_t *foundIndices =
-                    octaspire_string_find_char(
+                    octaspire_dern_helpers_find_string(
                         value->value.string,
                         key->value.character,
-                        0);
+                        self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4778,11 +7248,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             }
             else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
             {
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.string,
                     key->value.string,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(key->value.string));
+                    self->allocator);
 
                 if (!foundIndices)
                 {
@@ -4807,11 +7276,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             }
             else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL)
             {
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.string,
                     key->value.symbol,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(key->value.symbol));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4834,11 +7302,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
                         "%" PRId32 "",
                         key->value.integer);
 
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.string,
                     tmpStr,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(tmpStr));
+                    self->allocator);
 
                 octaspire_string_release(tmpStr);
                 tmpStr = 0;
@@ -4864,11 +7331,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
                         "%g",
                         key->value.real);
 
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.string,
                     tmpStr,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(tmpStr));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4896,14 +7362,67 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             }
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE:
+        {
+            octaspire_string_t const * keyStr = 0;
+
+            if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER)
+            {
+                keyStr = key->value.character;
+            }
+            else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
+            {
+                keyStr = key->value.string;
+            }
+            else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL)
+            {
+                keyStr = key->value.symbol;
+            }
+            else
+            {
+                octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+                return octaspire_dern_vm_create_new_value_error_format(
+                    self,
+                    "Type '%s' cannot be searched from type 'string slice'",
+                    octaspire_dern_value_helper_get_type_as_c_string(key->typeTag));
+            }
+
+            size_t const numOctets =
+                octaspire_dern_value_as_string_slice_get_length_in_octets(value);
+
+            octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_all_octets(
+                octaspire_dern_value_as_string_slice_get_octets(value),
+                numOctets,
+                numOctets ==
+                    octaspire_dern_value_as_string_slice_get_length_in_ucs_characters(value),
+                octaspire_string_get_c_string(keyStr),
+                octaspire_string_get_length_in_octets(keyStr),
+                self->allocator);
+
+            octaspire_helpers_verify_not_null(foundIndices);
+
+            octaspire_dern_value_t * const result =
+                octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
+                    self,
+                    foundIndices);
+
+            octaspire_helpers_verify_not_null(result);
+
+            octaspire_vector_release(foundIndices);
+            foundIndices = 0;
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+            return result;
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
         {
             if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_CHARACTER)
             {
-                octaspire_vector_t *foundIndices = octaspire_string_find_char(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.symbol,
                     key->value.character,
-                    0);
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4920,11 +7439,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             }
             else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
             {
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.symbol,
                     key->value.string,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(key->value.string));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4941,11 +7459,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             }
             else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_SYMBOL)
             {
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.symbol,
                     key->value.symbol,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(key->value.symbol));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4968,11 +7485,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
                         "%" PRId32 "",
                         key->value.integer);
 
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.symbol,
                     tmpStr,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(tmpStr));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -4998,11 +7514,10 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
                         "%g",
                         key->value.real);
 
-                octaspire_vector_t *foundIndices = octaspire_string_find_string(
+                octaspire_vector_t *foundIndices = octaspire_dern_helpers_find_string(
                     value->value.symbol,
                     tmpStr,
-                    0,
-                    octaspire_string_get_length_in_ucs_characters(tmpStr));
+                    self->allocator);
 
                 octaspire_dern_value_t * const result =
                     octaspire_dern_vm_helper_create_new_value_vector_of_integers_from_vector_of_size_t(
@@ -5059,15 +7574,17 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
 
         case OCTASPIRE_DERN_VALUE_TAG_HASH_MAP:
         {
+            octaspire_dern_value_prepare_for_element_access(value);
+
             uint32_t const hash = octaspire_dern_value_get_hash(key);
 
-            octaspire_map_element_t * const element =
-                octaspire_map_get(value->value.hashMap, hash, &key);
+            octaspire_dern_map_element_t * const element =
+                octaspire_dern_map_get(value->value.hashMap, hash, key);
 
             if (element)
             {
                 octaspire_dern_value_t * const resVal =
-                    octaspire_map_element_get_value(element);
+                    octaspire_dern_map_element_get_value(element);
 
                 if (resVal)
                 {
@@ -5080,6 +7597,31 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             return octaspire_dern_vm_get_value_nil(self);
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_SET:
+        {
+            octaspire_dern_map_element_t * const element = octaspire_dern_map_get(
+                value->value.set,
+                octaspire_dern_value_get_hash(key),
+                key);
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+
+            return element ?
+                octaspire_dern_map_element_get_key(element) :
+                octaspire_dern_vm_get_value_nil(self);
+        }
+
+        case OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP:
+        {
+            octaspire_dern_value_t *resVal = 0;
+
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+
+            return octaspire_dern_sorted_map_get(value->value.sortedMap, key, 0, &resVal) ?
+                resVal :
+                octaspire_dern_vm_get_value_nil(self);
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_ENVIRONMENT:
         {
             octaspire_dern_value_t *result =
@@ -5095,6 +7637,73 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
             return octaspire_dern_vm_get_value_nil(self);
         }
 
+        case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+        {
+            uint8_t      octet     = 0;
+            void const * needle    = &octet;
+            size_t       needleLen = 1;
+
+            if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_INTEGER &&
+                key->value.integer >= 0 &&
+                key->value.integer <= UINT8_MAX)
+            {
+                octet = (uint8_t)key->value.integer;
+            }
+            else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_BYTES)
+            {
+                needle    = octaspire_dern_bytes_get_octets(key->value.bytes);
+                needleLen = octaspire_dern_bytes_get_length(key->value.bytes);
+            }
+            else if (key->typeTag == OCTASPIRE_DERN_VALUE_TAG_STRING)
+            {
+                needle    = octaspire_string_get_c_string(key->value.string);
+                needleLen = octaspire_string_get_length_in_octets(key->value.string);
+            }
+            else
+            {
+                octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+                return octaspire_dern_vm_create_new_value_error_format(
+                    self,
+                    "'find' from bytes expects octet, bytes or string as key. "
+                    "Type '%s' was given.",
+                    octaspire_dern_value_helper_get_type_as_c_string(key->typeTag));
+            }
+
+            octaspire_dern_value_t * const result =
+                octaspire_dern_vm_create_new_value_vector(self);
+
+            octaspire_dern_vm_push_value(self, result);
+
+            ptrdiff_t index =
+                octaspire_dern_bytes_find(value->value.bytes, needle, needleLen, 0);
+
+            while (index >= 0)
+            {
+                octaspire_dern_value_t * const indexVal =
+                    octaspire_dern_vm_create_new_value_integer(self, (int32_t)index);
+
+                if (!octaspire_dern_value_as_vector_push_back_element(result, &indexVal))
+                {
+                    abort();
+                }
+
+                if (needleLen == 0)
+                {
+                    break;
+                }
+
+                index = octaspire_dern_bytes_find(
+                    value->value.bytes,
+                    needle,
+                    needleLen,
+                    (size_t)index + 1);
+            }
+
+            octaspire_dern_vm_pop_value(self, result);
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
+            return result;
+        }
+
         case OCTASPIRE_DERN_VALUE_TAG_NIL:
         case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
         case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
@@ -5109,6 +7718,11 @@ octaspire_dern_value_t *octaspire_dern_vm_find_from_value(
         case OCTASPIRE_DERN_VALUE_TAG_BUILTIN:
         case OCTASPIRE_DERN_VALUE_TAG_PORT:
         case OCTASPIRE_DERN_VALUE_TAG_C_DATA:
+        case OCTASPIRE_DERN_VALUE_TAG_WEAK_REFERENCE:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_VECTOR:
+        case OCTASPIRE_DERN_VALUE_TAG_PERSISTENT_HASH_MAP:
+        case OCTASPIRE_DERN_VALUE_TAG_TYPED_ARRAY:
+        case OCTASPIRE_DERN_VALUE_TAG_STRING_BUILDER:
         case OCTASPIRE_DERN_VALUE_TAG_SEMVER:
         {
             octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(self));
@@ -5169,6 +7783,16 @@ void octaspire_dern_vm_set_prevent_gc(octaspire_dern_vm_t * const self, bool con
     self->preventGc = prevent;
 }
 
+bool octaspire_dern_vm_get_prevent_gc(octaspire_dern_vm_t const * const self)
+{
+    return self->preventGc;
+}
+
+uint32_t octaspire_dern_vm_get_mark_epoch(octaspire_dern_vm_t const * const self)
+{
+    return self->markEpoch;
+}
+
 void octaspire_dern_vm_set_gc_trigger_limit(octaspire_dern_vm_t * const self, size_t const numAllocs)
 {
     self->gcTriggerLimit = numAllocs;
@@ -5275,6 +7899,27 @@ octaspire_dern_lib_t const * octaspire_dern_vm_get_library_const(
     return octaspire_map_element_get_value_const(element);
 }
 
+size_t octaspire_dern_vm_get_number_of_libraries(
+    octaspire_dern_vm_t const * const self)
+{
+    return octaspire_map_get_number_of_elements(self->libraries);
+}
+
+octaspire_dern_lib_t *octaspire_dern_vm_get_library_at(
+    octaspire_dern_vm_t * const self,
+    ptrdiff_t const index)
+{
+    octaspire_map_element_t * const element =
+        octaspire_map_get_at_index(self->libraries, index);
+
+    if (!element)
+    {
+        return 0;
+    }
+
+    return octaspire_map_element_get_value(element);
+}
+
 octaspire_stdio_t *octaspire_dern_vm_get_stdio(octaspire_dern_vm_t * const self)
 {
     return self->stdio;
@@ -200,6 +200,21 @@ int main(int argc, char **argv)
                 octaspire_read_and_eval_path_test_dern);
 
 
+            char const * const octaspire_require_from_file_test_dern =
+                "; Library loaded from a file by 'require'.\n"
+                "(define require-from-file-add as (fn (a b) (+ a b))\n"
+                "  [add a and b]\n"
+                "  '(a [first]\n"
+                "    b [second])\n"
+                "  howto-no)\n"
+                "\n"
+                "#! Strings can hold parentheses: !#\n"
+                "(define require-from-file-text as [text with ) in it] [text])\n";
+
+            octaspire_dern_amalgamated_write_test_file(
+                "octaspire_require_from_file_test.dern",
+                octaspire_require_from_file_test_dern);
+
             char const * const octaspire_io_file_open_test_txt =
                 "ABCABC\n";
 
@@ -2159,6 +2159,65 @@ TEST octaspire_dern_lexer_pop_next_token_string_cat_and_dog_test(void)
     PASS();
 }
 
+TEST octaspire_dern_lexer_pop_next_token_long_string_with_non_ascii_characters_test(void)
+{
+    // The lexer collects ASCII text into a buffer of its own. The first
+    // string does not fit into it and the second has a character that
+    // is not ASCII.
+    octaspire_dern_lexer_token_t *expected1 = octaspire_dern_lexer_token_new(
+        OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING,
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" "\xc3\xa4" "bbbbb",
+        octaspire_dern_lexer_token_position_init(1, 1),
+        octaspire_dern_lexer_token_position_init(1, 78),
+        octaspire_dern_lexer_token_position_init(0, 77),
+        octaspireDernLexerTestAllocator);
+    ASSERT(expected1);
+
+    octaspire_dern_lexer_token_t *expected2 = octaspire_dern_lexer_token_new(
+        OCTASPIRE_DERN_LEXER_TOKEN_TAG_STRING,
+        "aaaaa" "\xc3\xb6" "bbbbb",
+        octaspire_dern_lexer_token_position_init(1, 1),
+        octaspire_dern_lexer_token_position_init(80, 92),
+        octaspire_dern_lexer_token_position_init(79, 91),
+        octaspireDernLexerTestAllocator);
+    ASSERT(expected2);
+
+    octaspire_input_t *input = octaspire_input_new_from_c_string(
+        "[aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" "\xc3\xa4" "bbbbb] [aaaaa" "\xc3\xb6" "bbbbb]",
+        octaspireDernLexerTestAllocator);
+
+    ASSERT(input);
+
+    octaspire_dern_lexer_token_t *token = octaspire_dern_lexer_pop_next_token(input, octaspireDernLexerTestAllocator);
+    ASSERT(token);
+
+    ASSERT(octaspire_dern_lexer_token_is_equal(expected1, token));
+
+    octaspire_dern_lexer_token_release(token);
+    token = 0;
+
+    token = octaspire_dern_lexer_pop_next_token(input, octaspireDernLexerTestAllocator);
+    ASSERT(token);
+
+    ASSERT(octaspire_dern_lexer_token_is_equal(expected2, token));
+
+    octaspire_dern_lexer_token_release(token);
+    token = 0;
+
+    octaspire_input_release(input);
+    input = 0;
+
+    octaspire_dern_lexer_token_release(expected1);
+    expected1 = 0;
+
+    octaspire_dern_lexer_token_release(expected2);
+    expected2 = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_lexer_pop_next_token_character_a_test(void)
 {
     char const * const value = "a";
@@ -2724,6 +2783,7 @@ GREATEST_SUITE(octaspire_dern_lexer_suite)
     RUN_TEST(octaspire_dern_lexer_pop_next_token_failure_on_illegal_integer_12_minus_22_test);
     RUN_TEST(octaspire_dern_lexer_pop_next_token_failure_on_illegal_integer_12_dot_22_minus_22_test);
     RUN_TEST(octaspire_dern_lexer_pop_next_token_string_cat_and_dog_test);
+    RUN_TEST(octaspire_dern_lexer_pop_next_token_long_string_with_non_ascii_characters_test);
     RUN_TEST(octaspire_dern_lexer_pop_next_token_character_a_test);
     RUN_TEST(octaspire_dern_lexer_pop_next_token_character_vertical_line_test);
     RUN_TEST(octaspire_dern_lexer_pop_next_token_character_newline_test);
@@ -17,6 +17,7 @@ limitations under the License.
 #include "../src/octaspire_dern_vm.c"
 #include "external/greatest.h"
 #include "octaspire/dern/octaspire_dern_vm.h"
+#include "octaspire/dern/octaspire_dern_image.h"
 #include "octaspire/dern/octaspire_dern_config.h"
 
 static octaspire_allocator_t *octaspireDernVmTestAllocator = 0;
@@ -508,6 +509,86 @@ TEST octaspire_dern_vm_special_select_function_selectors_failure_on_unknown_symb
     PASS();
 }
 
+TEST octaspire_dern_vm_unbound_symbol_suggestions_are_sorted_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    // Names are defined out of order, so that the suggestions cannot
+    // follow the order of definition or of the table of bindings.
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define qqq3 as {D+3} [3]) (define qqq1 as {D+1} [1]) "
+            "(define qqq4 as {D+4} [4]) (define qqq2 as {D+2} [2]))");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "qqq");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Unbound symbol 'qqq'. Did you mean 'qqq1', 'qqq2', 'qqq3' or 'qqq4'?",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_unbound_symbol_suggestions_break_ties_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    // All of these are one edit away from 'qqqx'.
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define aqqx as {D+1} [1]) (define qqq as {D+2} [2]) "
+            "(define qqqy as {D+3} [3]))");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    // 'qqq' and 'qqqy' share the longest prefix, and 'qqqy'
+    // has the same length.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "qqqx");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Unbound symbol 'qqqx'. Did you mean 'qqqy'?",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    // Nothing is close enough to be suggested.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "NoSuchFunction");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Unbound symbol 'NoSuchFunction'.",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_special_select_called_with_zero_arguments_failure_test(void)
 {
     octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -903,8 +984,7 @@ TEST octaspire_dern_vm_special_define_called_with_eight_arguments_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "Unbound symbol 'f'. Did you mean '/', '<', 'if', '>', '*', '+', '-',"
-        " 'fn' or '='?",
+        "Unbound symbol 'f'. Did you mean 'fn'?",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
     // Make sure f IS defined in myEnv-environment
@@ -1002,7 +1082,7 @@ TEST octaspire_dern_vm_special_define_called_with_four_arguments_error_at_first_
 
     ASSERT_STR_EQ(
         "Cannot evaluate operator of type 'error' (<error>: Unbound symbol "
-        "'noSuchFuNcTion'. Did you mean 'character' or 'character?'?)\n"
+        "'noSuchFuNcTion'.)\n"
         "\tAt form: >>>>>>>>>>(define x as (noSuchFuNcTion) [x])<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
@@ -1099,8 +1179,7 @@ TEST octaspire_dern_vm_special_define_called_with_eight_arguments_error_in_envir
     ASSERT_STR_EQ(
         "Special 'define' expects environment as the seventh argument in this "
         "context. Value '<error>: Cannot evaluate operator of type 'error' (<error>: "
-        "Unbound symbol 'noSuchFuNcTion'. Did you mean 'character' or "
-        "'character?'?)' was given.\n"
+        "Unbound symbol 'noSuchFuNcTion'.)' was given.\n"
         "\tAt form: >>>>>>>>>>(define f as (fn () (quote x)) [f] (quote ()) in (noSuchFuNcTion) howto-ok)<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
@@ -2647,6 +2726,150 @@ TEST octaspire_dern_vm_builtin_read_and_eval_path_test(void)
     PASS();
 }
 
+TEST octaspire_dern_vm_builtin_read_and_eval_path_with_many_paths_test(void)
+{
+    char const * const brokenPath =
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_paths_test_broken.dern";
+
+    FILE *file = fopen(brokenPath, "wb");
+    ASSERT(file);
+    fputs("(define z as {D+1} [z])\n\n(+ z\n", file);
+    fclose(file);
+    file = 0;
+
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(read-and-eval-path "
+            "[" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern] "
+            "[" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_path_test.dern])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(200,                              evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require-from-file-add y require-from-file-text)");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require-from-file-add y {D+1})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(101,                              evaluatedValue->value.integer);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    // The file with an error is evaluated up to the error, and the files
+    // after it are not evaluated at all.
+    vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(read-and-eval-path "
+            "[" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern] "
+            "[" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_paths_test_broken.dern] "
+            "[" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_path_test.dern])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require-from-file-add z {D+1})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(2,                                evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(vm, "y");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(read-and-eval-path [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_path_test.dern] {D+1})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Arguments to builtin 'read-and-eval-path' must be strings (paths). "
+        "Type 'integer' was given as argument 2.\n"
+        "\tAt form: >>>>>>>>>>(read-and-eval-path [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+        "octaspire_read_and_eval_path_test.dern] {D+1})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    remove(brokenPath);
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_loader_waits_for_files_in_any_order_test(void)
+{
+    char const * const paths[] =
+    {
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern",
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_read_and_eval_path_test.dern",
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_loader_test_no_such_file.dern"
+    };
+
+    octaspire_dern_loader_t *loader = octaspire_dern_loader_new(
+        paths,
+        3,
+        false,
+        0,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(loader);
+    ASSERT_EQ(3, octaspire_dern_loader_get_number_of_paths(loader));
+
+    // Files are read with the allocator of the loader, so failing
+    // allocations of the given allocator do not matter.
+    octaspire_allocator_set_number_and_type_of_future_allocations_to_be_rigged(
+        octaspireDernVmTestAllocator,
+        32,
+        0);
+
+    bool isLoadedFromCache = true;
+
+    ASSERT_FALSE(octaspire_dern_loader_wait_for_forms(loader, 2, &isLoadedFromCache));
+    ASSERT(octaspire_dern_loader_wait_for_forms(loader, 1, &isLoadedFromCache));
+    ASSERT_FALSE(isLoadedFromCache);
+    ASSERT(octaspire_dern_loader_wait_for_forms(loader, 0, &isLoadedFromCache));
+    ASSERT_FALSE(isLoadedFromCache);
+
+    octaspire_allocator_set_number_and_type_of_future_allocations_to_be_rigged(
+        octaspireDernVmTestAllocator,
+        0,
+        0);
+
+    ASSERT_STR_EQ(paths[1], octaspire_dern_loader_get_path_at(loader, 1));
+
+    octaspire_dern_loader_release(loader);
+    loader = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_builtin_read_and_eval_string_test(void)
 {
     octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -3274,7 +3497,7 @@ TEST octaspire_dern_vm_builtin_plus_hash_map_1_a_and_2_and_b_test(void)
         octaspire_dern_vm_get_allocator(vm));
 
     ASSERT_STR_EQ(
-        "(hash-map {D+2} |b|\n          {D+1} |a|)",
+        "(hash-map {D+1} |a|\n          {D+2} |b|)",
         octaspire_string_get_c_string(tmpStr));
 
     octaspire_string_release(tmpStr);
@@ -3304,7 +3527,7 @@ TEST octaspire_dern_vm_builtin_plus_hash_map_1_a_and_2_and_b_and_3_and_c_test(vo
         octaspire_dern_vm_get_allocator(vm));
 
     ASSERT_STR_EQ(
-        "(hash-map {D+2} |b|\n          {D+3} |c|\n          {D+1} |a|)",
+        "(hash-map {D+1} |a|\n          {D+2} |b|\n          {D+3} |c|)",
         octaspire_string_get_c_string(tmpStr));
 
     octaspire_string_release(tmpStr);
@@ -4793,17 +5016,17 @@ TEST octaspire_dern_vm_builtin_hash_map_one_element_symbol_one_1_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(1, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t *element =
+    octaspire_dern_map_element_t *element =
         octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    evaluatedValue = octaspire_map_element_get_key(element);
+    evaluatedValue = octaspire_dern_map_element_get_key(element);
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_SYMBOL, evaluatedValue->typeTag);
     ASSERT_STR_EQ("one", octaspire_string_get_c_string(evaluatedValue->value.symbol));
 
-    evaluatedValue = octaspire_map_element_get_value(element);
+    evaluatedValue = octaspire_dern_map_element_get_value(element);
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
     ASSERT_EQ(1, evaluatedValue->value.integer);
@@ -4814,6 +5037,52 @@ TEST octaspire_dern_vm_builtin_hash_map_one_element_symbol_one_1_test(void)
     PASS();
 }
 
+TEST octaspire_dern_vm_hash_map_key_and_value_accessors_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(hash-map 'one {D+1} 'two {D+2})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
+
+    octaspire_dern_vm_push_value(vm, evaluatedValue);
+
+    octaspire_dern_value_t *key =
+        octaspire_dern_value_as_hash_map_get_key_at_index(evaluatedValue, -1);
+
+    ASSERT(key);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_SYMBOL, key->typeTag);
+
+    octaspire_dern_value_t *value =
+        octaspire_dern_value_as_hash_map_get_value_at_index(evaluatedValue, -1);
+
+    ASSERT(value);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, value->typeTag);
+    ASSERT(value == octaspire_dern_value_as_hash_map_get_value(evaluatedValue, key));
+
+    ASSERT_FALSE(octaspire_dern_value_as_hash_map_get_key_at_index(evaluatedValue, 2));
+    ASSERT_FALSE(octaspire_dern_value_as_hash_map_get_value_at_index(evaluatedValue, -3));
+
+    key = octaspire_dern_vm_create_new_value_symbol_from_c_string(vm, "two");
+    value = octaspire_dern_value_as_hash_map_get_value(evaluatedValue, key);
+
+    ASSERT(value);
+    ASSERT_EQ(2, value->value.integer);
+
+    key = octaspire_dern_vm_create_new_value_symbol_from_c_string(vm, "three");
+    ASSERT_FALSE(octaspire_dern_value_as_hash_map_get_value(evaluatedValue, key));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_builtin_hash_map_one_element_1_symbol_one_test(void)
 {
     octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -4827,17 +5096,17 @@ TEST octaspire_dern_vm_builtin_hash_map_one_element_1_symbol_one_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(1, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t *element =
+    octaspire_dern_map_element_t *element =
         octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    evaluatedValue = octaspire_map_element_get_key(element);
+    evaluatedValue = octaspire_dern_map_element_get_key(element);
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
     ASSERT_EQ(1, evaluatedValue->value.integer);
 
-    evaluatedValue = octaspire_map_element_get_value(element);
+    evaluatedValue = octaspire_dern_map_element_get_value(element);
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_SYMBOL, evaluatedValue->typeTag);
     ASSERT_STR_EQ("one", octaspire_string_get_c_string(evaluatedValue->value.symbol));
@@ -4885,14 +5154,14 @@ TEST octaspire_dern_vm_builtin_hash_map_two_elements_strings_dog_barks_and_sun_s
 
         ASSERT(keyValue);
 
-        octaspire_map_element_t *element = octaspire_dern_value_as_hash_map_get(
+        octaspire_dern_map_element_t *element = octaspire_dern_value_as_hash_map_get(
             evaluatedValue,
             octaspire_dern_value_get_hash(keyValue),
             keyValue);
 
         ASSERT(element);
 
-        octaspire_dern_value_t *valueValue = octaspire_map_element_get_value(element);
+        octaspire_dern_value_t *valueValue = octaspire_dern_map_element_get_value(element);
         ASSERT(valueValue);
         ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, valueValue->typeTag);
         ASSERT_STR_EQ(expected[i], octaspire_string_get_c_string(valueValue->value.string));
@@ -5267,21 +5536,21 @@ TEST octaspire_dern_vm_builtin_equals_with_hash_map_and_same_key_inserted_multip
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
 
-    octaspire_map_t * hashMap = evaluatedValue->value.hashMap;
+    octaspire_dern_map_t * hashMap = evaluatedValue->value.hashMap;
 
-    ASSERT_EQ(1, octaspire_map_get_number_of_elements(hashMap));
+    ASSERT_EQ(1, octaspire_dern_map_get_number_of_elements(hashMap));
 
-    octaspire_map_element_t *element =
-        octaspire_map_get_at_index(hashMap, 0);
+    octaspire_dern_map_element_t *element =
+        octaspire_dern_map_get_at_index(hashMap, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t *key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t *key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, key->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(key->value.string));
 
-    octaspire_dern_value_t *value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t *value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, value->typeTag);
     ASSERT_EQ(2,                                 value->value.integer);
@@ -5307,19 +5576,19 @@ TEST octaspire_dern_vm_builtin_equals_with_hash_map_and_same_key_inserted_multip
 
     hashMap = evaluatedValue->value.hashMap;
 
-    ASSERT_EQ(1, octaspire_map_get_number_of_elements(hashMap));
+    ASSERT_EQ(1, octaspire_dern_map_get_number_of_elements(hashMap));
 
     element =
-        octaspire_map_get_at_index(hashMap, 0);
+        octaspire_dern_map_get_at_index(hashMap, 0);
 
     ASSERT(element);
 
-    key = octaspire_map_element_get_key(element);
+    key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, key->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(key->value.string));
 
-    value = octaspire_map_element_get_value(element);
+    value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, value->typeTag);
     ASSERT_EQ(3,                                 value->value.integer);
@@ -5368,36 +5637,36 @@ TEST octaspire_dern_vm_builtin_equals_with_hash_map_and_hash_map_with_elements_t
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
 
-    octaspire_map_t * const hashMap = evaluatedValue->value.hashMap;
+    octaspire_dern_map_t * const hashMap = evaluatedValue->value.hashMap;
 
-    ASSERT_EQ(2, octaspire_map_get_number_of_elements(hashMap));
+    ASSERT_EQ(2, octaspire_dern_map_get_number_of_elements(hashMap));
 
-    octaspire_map_element_t *element =
-        octaspire_map_get_at_index(hashMap, 1);
+    octaspire_dern_map_element_t *element =
+        octaspire_dern_map_get_at_index(hashMap, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t *key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t *key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, key->typeTag);
     ASSERT_EQ(1,                                key->value.integer);
 
-    octaspire_dern_value_t *value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t *value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(value->value.character));
 
     element =
-        octaspire_map_get_at_index(hashMap, 0);
+        octaspire_dern_map_get_at_index(hashMap, 1);
 
     ASSERT(element);
 
-    key = octaspire_map_element_get_key(element);
+    key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, key->typeTag);
     ASSERT_EQ(2,                                key->value.integer);
 
-    value = octaspire_map_element_get_value(element);
+    value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("b", octaspire_string_get_c_string(value->value.character));
@@ -5446,9 +5715,9 @@ TEST octaspire_dern_vm_builtin_equals_with_hash_map_and_empty_hash_map_test(void
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
 
-    octaspire_map_t * const hashMap = evaluatedValue->value.hashMap;
+    octaspire_dern_map_t * const hashMap = evaluatedValue->value.hashMap;
 
-    ASSERT_EQ(0, octaspire_map_get_number_of_elements(hashMap));
+    ASSERT_EQ(0, octaspire_dern_map_get_number_of_elements(hashMap));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -5795,17 +6064,17 @@ TEST octaspire_dern_vm_builtin_minus_equals_with_hash_map_1_a_2_b_3_c_and_value_
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(1, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t const * const element =
+    octaspire_dern_map_element_t const * const element =
         octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t const * const key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t const * const key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER,  key->typeTag);
     ASSERT_EQ(1,                                 key->value.integer);
 
-    octaspire_dern_value_t const * const value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t const * const value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(value->value.character));
@@ -6522,17 +6791,17 @@ TEST octaspire_dern_vm_builtin_plus_equals_with_hash_map_and_hash_map_1_a_test(v
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(1, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t const * const element =
+    octaspire_dern_map_element_t const * const element =
         octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t const * const key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t const * const key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER,  key->typeTag);
     ASSERT_EQ(1,                                 key->value.integer);
 
-    octaspire_dern_value_t const * const value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t const * const value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(value->value.character));
@@ -6565,17 +6834,17 @@ TEST octaspire_dern_vm_builtin_plus_equals_with_hash_map_and_1_a_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(1, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t const * const element =
+    octaspire_dern_map_element_t const * const element =
         octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t const * const key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t const * const key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER,  key->typeTag);
     ASSERT_EQ(1,                                 key->value.integer);
 
-    octaspire_dern_value_t const * const value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t const * const value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(value->value.character));
@@ -6608,32 +6877,32 @@ TEST octaspire_dern_vm_builtin_plus_equals_with_hash_map_and_list_1_a_2_b_test(v
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
     ASSERT_EQ(2, octaspire_dern_value_as_hash_map_get_number_of_elements(evaluatedValue));
 
-    octaspire_map_element_t const * element =
-        octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 1);
+    octaspire_dern_map_element_t const * element =
+        octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
 
     ASSERT(element);
 
-    octaspire_dern_value_t const * key = octaspire_map_element_get_key(element);
+    octaspire_dern_value_t const * key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER,  key->typeTag);
     ASSERT_EQ(1,                                 key->value.integer);
 
-    octaspire_dern_value_t const * value = octaspire_map_element_get_value(element);
+    octaspire_dern_value_t const * value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("a", octaspire_string_get_c_string(value->value.character));
 
     element =
-        octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 0);
+        octaspire_dern_value_as_hash_map_get_at_index(evaluatedValue, 1);
 
     ASSERT(element);
 
-    key = octaspire_map_element_get_key(element);
+    key = octaspire_dern_map_element_get_key(element);
     ASSERT(key);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER,  key->typeTag);
     ASSERT_EQ(2,                                 key->value.integer);
 
-    value = octaspire_map_element_get_value(element);
+    value = octaspire_dern_map_element_get_value(element);
     ASSERT(value);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, value->typeTag);
     ASSERT_STR_EQ("b", octaspire_string_get_c_string(value->value.character));
@@ -7459,81 +7728,261 @@ TEST octaspire_dern_vm_run_user_factorial_function_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_special_for_from_0_to_10_test(void)
+typedef struct octaspire_dern_vm_test_reader_context_t
 {
-    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
-
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define v as '() [v])");
-
-    ASSERT(evaluatedValue);
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
-
-    evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(for i from {D+0} to {D+10} (+= v i))");
-
-    ASSERT(evaluatedValue);
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(11,                               evaluatedValue->value.integer);
+    char const *text;
+    size_t      length;
+    size_t      index;
+}
+octaspire_dern_vm_test_reader_context_t;
 
-    evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "v");
+static ptrdiff_t octaspire_dern_vm_test_reader_read_three_octets(
+    void * const context,
+    void * const buffer,
+    size_t const size)
+{
+    octaspire_dern_vm_test_reader_context_t * const c = context;
 
-    ASSERT(evaluatedValue);
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
-    ASSERT_EQ(11, octaspire_dern_value_as_vector_get_length(evaluatedValue));
+    size_t numOctets = c->length - c->index;
 
-    for (int32_t i = 0; i < 11; ++i)
+    if (numOctets > 3)
     {
-        octaspire_dern_value_t const * const tmp =
-            octaspire_dern_value_as_vector_get_element_of_type_at_const(
-                evaluatedValue,
-                OCTASPIRE_DERN_VALUE_TAG_INTEGER,
-                i);
-
-        ASSERT(tmp);
-        ASSERT_EQ(i, tmp->value.integer);
+        numOctets = 3;
     }
 
-    octaspire_dern_vm_release(vm);
-    vm = 0;
+    if (numOctets > size)
+    {
+        numOctets = size;
+    }
 
-    PASS();
+    memcpy(buffer, c->text + c->index, numOctets);
+    c->index += numOctets;
+    return (ptrdiff_t)numOctets;
 }
 
-TEST octaspire_dern_vm_special_for_from_0_to_10_with_step_2_test(void)
+TEST octaspire_dern_vm_read_from_reader_and_eval_in_global_environment_test(void)
 {
     octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define v as '() [v])");
+    octaspire_dern_vm_test_reader_context_t context =
+    {
+        "; comment with (\n"
+        "#! multiline ( comment\n"
+        "   ends here !#\n"
+        "(define s as [a)b] [s])\n"
+        "'sym [text] |)|\n"
+        "(define v as '(|(| [(] #! ) !# {D+1}) [v])\n"
+        "(+ (len s) (len v))",
+        0,
+        0
+    };
 
-    ASSERT(evaluatedValue);
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    context.length = strlen(context.text);
 
-    evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(for i from {D+0} to {D+10} step {D+2} (+= v i))");
+    octaspire_dern_reader_t *reader = octaspire_dern_reader_new_from_callback(
+        octaspire_dern_vm_test_reader_read_three_octets,
+        &context,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reader);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader);
 
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
     ASSERT_EQ(6,                                evaluatedValue->value.integer);
+    ASSERT_EQ(7,                                octaspire_dern_reader_get_form_line_number(reader));
+    ASSERT_EQ(context.length,                   octaspire_dern_reader_get_number_of_octets_read(reader));
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    context.text   = "(define x as {D+1} [x])\n\n(no-such-function\n x)\n(define y as {D+2} [y])";
+    context.length = strlen(context.text);
+    context.index  = 0;
+
+    reader = octaspire_dern_reader_new_from_callback(
+        octaspire_dern_vm_test_reader_read_three_octets,
+        &context,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reader);
 
     evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "v");
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader);
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+    ASSERT_EQ(4,                              evaluatedValue->value.error->lineNumber);
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(vm, "y");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    context.text   = "(define z as {D+1} [z])\n\n\n  (+ z\n {D+2}\n";
+    context.length = strlen(context.text);
+    context.index  = 0;
+
+    reader = octaspire_dern_reader_new_from_callback(
+        octaspire_dern_vm_test_reader_read_three_octets,
+        &context,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reader);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader);
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Balancing right parenthesis ')' missing for left parenthesis given at "
+        "column 3 of line 4",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    // Positions of a stray right parenthesis are positions in the source,
+    // counted in characters.
+    context.text   = "(define w as [ä] [w])\n(define u as {D+2} [u])  )\n";
+    context.length = strlen(context.text);
+    context.index  = 0;
+
+    reader = octaspire_dern_reader_new_from_callback(
+        octaspire_dern_vm_test_reader_read_three_octets,
+        &context,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reader);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader);
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+    ASSERT_EQ(2,                              evaluatedValue->value.error->lineNumber);
+
+    ASSERT_STR_EQ(
+        "unexpected token: line=2,2 column=26,26 ucsIndex=47,47 "
+        "type=OCTASPIRE_DERN_LEXER_TOKEN_TAG_RPAREN value=right parenthesis",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    context.text   = "";
+    context.length = 0;
+    context.index  = 0;
+
+    reader = octaspire_dern_reader_new_from_callback(
+        octaspire_dern_vm_test_reader_read_three_octets,
+        &context,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reader);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_reader_and_eval_in_global_environment(vm, reader);
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "No input",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_reader_release(reader);
+    reader = 0;
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_special_for_from_0_to_10_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define v as '() [v])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(for i from {D+0} to {D+10} (+= v i))");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(11,                               evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "v");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
+    ASSERT_EQ(11, octaspire_dern_value_as_vector_get_length(evaluatedValue));
+
+    for (int32_t i = 0; i < 11; ++i)
+    {
+        octaspire_dern_value_t const * const tmp =
+            octaspire_dern_value_as_vector_get_element_of_type_at_const(
+                evaluatedValue,
+                OCTASPIRE_DERN_VALUE_TAG_INTEGER,
+                i);
+
+        ASSERT(tmp);
+        ASSERT_EQ(i, tmp->value.integer);
+    }
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_special_for_from_0_to_10_with_step_2_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define v as '() [v])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(for i from {D+0} to {D+10} step {D+2} (+= v i))");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(6,                                evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "v");
 
     ASSERT(evaluatedValue);
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
@@ -8148,7 +8597,7 @@ TEST octaspire_dern_vm_special_for_in_with_environment_step_2_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
     ASSERT_EQ(2,                                evaluatedValue->value.integer);
 
-    // octaspire_map_t is not ordered map, so we cannot know for sure which
+    // octaspire_dern_map_t is not ordered map, so we cannot know for sure which
     // two values are the first ones in the map.
 
     octaspire_dern_vm_release(vm);
@@ -8315,8 +8764,25 @@ TEST octaspire_dern_vm_special_for_in_with_hash_map_step_2_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
     ASSERT_EQ(2,                                evaluatedValue->value.integer);
 
-    // octaspire_map_t is not ordered map, so we cannot know for sure which
-    // two values are the first ones in the map.
+    // Hash maps iterate in insertion order, so the first and the third
+    // element are defined in the environment.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(eval a e)");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(1,                                evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(eval c e)");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(3,                                evaluatedValue->value.integer);
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -8482,7 +8948,7 @@ TEST octaspire_dern_vm_error_in_function_body_is_reported_test(void)
     // TODO type of 'error' or 'vector'?
     ASSERT_STR_EQ(
         "Cannot evaluate operator of type 'error' (<error>: Unbound symbol "
-        "'NoSuchFunction'. Did you mean 'character' or 'character?'?)\n"
+        "'NoSuchFunction'.)\n"
         "\tAt form: >>>>>>>>>>(f {D+1})<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
@@ -8758,6 +9224,104 @@ TEST octaspire_dern_vm_builtin_cp_at_sign_called_with_3_and_string_abc_failure_t
     PASS();
 }
 
+TEST octaspire_dern_vm_builtin_ln_at_sign_and_cp_at_sign_called_with_queue_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define q as (queue |a| |b| |c|) [q])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(ln@ q {D+1})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("b", octaspire_dern_value_as_character_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(cp@ q {D-1})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("c", octaspire_dern_value_as_character_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_ln_at_sign_and_cp_at_sign_called_with_invalid_index_failure_test(void)
+{
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(ln@ (queue |a| |b|) {D+2})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Index to builtin 'ln@' is not valid for the given queue. Index '2' was given.\n"
+        "\tAt form: >>>>>>>>>>(ln@ (queue |a| |b|) {D+2})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(ln@ (list |a| |b|) {D-3})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Index to builtin 'ln@' is not valid for the given list. Index '-3' was given.\n"
+        "\tAt form: >>>>>>>>>>(ln@ (list |a| |b|) {D-3})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(cp@ (list |a| |b|) {D+5})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Index to builtin 'cp@' is not valid for the given list. Index '5' was given.\n"
+        "\tAt form: >>>>>>>>>>(cp@ (list |a| |b|) {D+5})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(cp@ (queue |a| |b|) {D-3})");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Index to builtin 'cp@' is not valid for the given queue. Index '-3' was given.\n"
+        "\tAt form: >>>>>>>>>>(cp@ (queue |a| |b|) {D-3})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_builtin_cp_at_sign_called_with_3_and_nil_test(void)
 {
     octaspire_dern_vm_t *vm = octaspire_dern_vm_new(
@@ -9066,7 +9630,7 @@ TEST octaspire_dern_vm_builtin_ln_at_sign_called_with_0_and_index_and_hash_map_1
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "b",
+        "a",
         octaspire_string_get_c_string(evaluatedValue->value.character));
 
     octaspire_dern_vm_release(vm);
@@ -9088,7 +9652,7 @@ TEST octaspire_dern_vm_builtin_ln_at_sign_called_with_1_and_index_and_hash_map_1
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "c",
+        "b",
         octaspire_string_get_c_string(evaluatedValue->value.character));
 
     octaspire_dern_vm_release(vm);
@@ -9110,7 +9674,7 @@ TEST octaspire_dern_vm_builtin_ln_at_sign_called_with_2_and_index_and_hash_map_1
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "a",
+        "c",
         octaspire_string_get_c_string(evaluatedValue->value.character));
 
     octaspire_dern_vm_release(vm);
@@ -9288,7 +9852,7 @@ TEST octaspire_dern_vm_special_do_error_stops_evaluation_and_is_reported_test(vo
 
     ASSERT_STR_EQ(
         "Cannot evaluate operator of type 'error' (<error>: Unbound symbol "
-        "'NoSuchFunction'. Did you mean 'character', 'counter' or 'character?'?)\n"
+        "'NoSuchFunction'.)\n"
         "\tAt form: >>>>>>>>>>(NoSuchFunction)<<<<<<<<<<\n\n"
         "\tAt form: >>>>>>>>>>(do (++ counter) (NoSuchFunction) (++ counter))<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
@@ -12795,7 +13359,7 @@ TEST octaspire_dern_vm_error_during_user_function_call_test(void)
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
     ASSERT_STR_EQ(
         "Cannot evaluate operator of type 'error' (<error>: Unbound symbol "
-        "'NoSuchFunction'. Did you mean 'character' or 'character?'?)\n"
+        "'NoSuchFunction'.)\n"
         "\tAt form: >>>>>>>>>>(f)<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
@@ -13191,9 +13755,7 @@ TEST octaspire_dern_vm_special_eval_failure_on_unbound_symbol_on_second_argument
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "Unbound symbol 'pi'. Did you mean '/', '--', 'do', '<', 'uid', "
-        "'cp@', 'if', 'min', '>', '+=', '++', '*', 'nil', '+', '-', '<=', "
-        "'fn', '==', '=', 'or', 'sin', '!=', 'pow', '-=' or '>='?\n"
+        "Unbound symbol 'pi'.\n"
         "\tAt form: >>>>>>>>>>(eval (+ {D+1} {D+1}) pi)<<<<<<<<<<\n",
         octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
@@ -13249,6 +13811,7 @@ TEST octaspire_dern_vm_create_new_value_copy_called_with_vector_value_of_int_val
 
     ASSERT(copiedVal);
     ASSERT(originalVal != copiedVal);
+    ASSERT(octaspire_dern_value_is_copy_on_write_pending(copiedVal));
 
     ASSERT_EQ(
         octaspire_dern_value_as_vector_get_length(originalVal),
@@ -13262,12 +13825,15 @@ TEST octaspire_dern_vm_create_new_value_copy_called_with_vector_value_of_int_val
                 OCTASPIRE_DERN_VALUE_TAG_INTEGER,
                 0);
 
+        // Non-const access materializes the copy-on-write copy.
         octaspire_dern_value_t const * const copied =
-            octaspire_dern_value_as_vector_get_element_of_type_at_const(
+            octaspire_dern_value_as_vector_get_element_of_type_at(
                 copiedVal,
                 OCTASPIRE_DERN_VALUE_TAG_INTEGER,
                 0);
 
+        ASSERT_FALSE(octaspire_dern_value_is_copy_on_write_pending(copiedVal));
+
         ASSERT(original && copied);
         ASSERT(original != copied);
         ASSERT_EQ(original->value.integer, copied->value.integer);
@@ -13515,31 +14081,71 @@ TEST octaspire_dern_vm_input_file_open_success_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_output_file_open_success_test(void)
+TEST octaspire_dern_vm_port_read_with_count_test(void)
 {
-    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
-
-    octaspire_dern_vm_t *vm = octaspire_dern_vm_new_with_config(octaspireDernVmTestAllocator, octaspireDernVmTestStdio, config);
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define f as (output-file-open [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_io_file_open_test.txt]) [f])");
+            "(define f as (input-file-open [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_io_file_open_test.txt]) [f])");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
     ASSERT_EQ(true,                             evaluatedValue->value.boolean);
 
-    octaspire_dern_vm_release(vm);
-    vm = 0;
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(to-string (port-read f {D+2}) (port-read-bytes f {D+3}) (port-read-bytes f {D+100}))");
 
-    PASS();
-}
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-TEST octaspire_dern_vm_port_supports_input_question_mark_called_with_output_file_test(void)
-{
-    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
+    ASSERT_STR_EQ(
+        "({D+65} {D+66})(bytes {D+67} {D+65} {D+66})(bytes {D+67} {D+10})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    octaspire_dern_vm_t *vm = octaspire_dern_vm_new_with_config(octaspireDernVmTestAllocator, octaspireDernVmTestStdio, config);
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(port-read-bytes f)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'port-read-bytes' expects exactly two arguments. 1 arguments were given.\n"
+        "\tAt form: >>>>>>>>>>(port-read-bytes f)<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_output_file_open_success_test(void)
+{
+    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
+
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new_with_config(octaspireDernVmTestAllocator, octaspireDernVmTestStdio, config);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define f as (output-file-open [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_io_file_open_test.txt]) [f])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_port_supports_input_question_mark_called_with_output_file_test(void)
+{
+    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
+
+    octaspire_dern_vm_t *vm = octaspire_dern_vm_new_with_config(octaspireDernVmTestAllocator, octaspireDernVmTestStdio, config);
 
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
@@ -15488,6 +16094,184 @@ TEST octaspire_dern_vm_list_test(void)
     PASS();
 }
 
+TEST octaspire_dern_vm_deque_push_and_pop_at_both_ends_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_deque_t *deque = octaspire_dern_deque_new(octaspireDernVmTestAllocator);
+    ASSERT(deque);
+
+    octaspire_dern_value_t *values[300];
+
+    for (size_t i = 0; i < 300; ++i)
+    {
+        values[i] = octaspire_dern_vm_create_new_value_integer(vm, (int32_t)i);
+    }
+
+    // Elements 100..299 are pushed to the back and 99..0 to the front,
+    // so that both ends grow over several chunks.
+    for (size_t i = 100; i < 300; ++i)
+    {
+        ASSERT(octaspire_dern_deque_push_back(deque, values[i]));
+    }
+
+    for (size_t i = 100; i > 0; --i)
+    {
+        ASSERT(octaspire_dern_deque_push_front(deque, values[i - 1]));
+    }
+
+    ASSERT_EQ(300, octaspire_dern_deque_get_length(deque));
+
+    for (size_t i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(values[i], octaspire_dern_deque_get_at(deque, (ptrdiff_t)i));
+    }
+
+    ASSERT_EQ(values[299], octaspire_dern_deque_get_at(deque, -1));
+    ASSERT_EQ(values[0],   octaspire_dern_deque_get_at(deque, -300));
+    ASSERT_FALSE(octaspire_dern_deque_get_at(deque, 300));
+    ASSERT_FALSE(octaspire_dern_deque_get_at(deque, -301));
+
+    octaspire_dern_deque_iterator_t iter = octaspire_dern_deque_iterator_init(deque);
+
+    for (size_t i = 0; i < 300; ++i)
+    {
+        ASSERT_EQ(values[i], iter.element);
+        ASSERT_EQ(i < 299, octaspire_dern_deque_iterator_next(&iter));
+    }
+
+    ASSERT_FALSE(iter.element);
+
+    for (size_t i = 0; i < 130; ++i)
+    {
+        ASSERT(octaspire_dern_deque_pop_front(deque));
+        ASSERT(octaspire_dern_deque_pop_back(deque));
+    }
+
+    ASSERT_EQ(40, octaspire_dern_deque_get_length(deque));
+    ASSERT_EQ(values[130], octaspire_dern_deque_get_at(deque, 0));
+    ASSERT_EQ(values[169], octaspire_dern_deque_get_at(deque, -1));
+
+    octaspire_dern_deque_clear(deque);
+    ASSERT(octaspire_dern_deque_is_empty(deque));
+    ASSERT_FALSE(octaspire_dern_deque_pop_front(deque));
+    ASSERT_FALSE(octaspire_dern_deque_pop_back(deque));
+    ASSERT_FALSE(octaspire_dern_deque_iterator_init(deque).element);
+
+    octaspire_dern_deque_release(deque);
+    deque = 0;
+
+    // A deque with a maximum length drops elements from the front.
+    deque = octaspire_dern_deque_new_with_max_length(3, octaspireDernVmTestAllocator);
+    ASSERT(deque);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ASSERT(octaspire_dern_deque_push_back(deque, values[i]));
+    }
+
+    ASSERT_EQ(3,          octaspire_dern_deque_get_length(deque));
+    ASSERT_EQ(values[97], octaspire_dern_deque_get_at(deque, 0));
+    ASSERT_EQ(values[99], octaspire_dern_deque_get_at(deque, 2));
+
+    octaspire_dern_deque_release(deque);
+    deque = 0;
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_long_list_and_queue_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define l as (list) [list])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(define q as (queue) [queue])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(define i as {D+0} [i])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(while (< i {D+500}) (+= l i) (+= q i) (++ i))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(= i {D+0})");
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(while (< i {D+200}) (pop-front l) (pop-back l) (pop-back q) (++ i))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(len l)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(100,                              evaluatedValue->value.integer);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(len q)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(300,                              evaluatedValue->value.integer);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(ln@ l {D+99})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(299,                              evaluatedValue->value.integer);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(define s as {D+0} [s])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(for e in q (+= s e))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(300,                              evaluatedValue->value.integer);
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "s");
+
+    // Sum of 200..499.
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(104850,                           evaluatedValue->value.integer);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_copy_test(void)
 {
     octaspire_dern_vm_t *vm =
@@ -15548,7 +16332,7 @@ TEST octaspire_dern_vm_copy_test(void)
 }
 
 
-TEST octaspire_dern_vm_split_called_with_string_and_char_test(void)
+TEST octaspire_dern_vm_copy_is_copy_on_write_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -15556,64 +16340,108 @@ TEST octaspire_dern_vm_split_called_with_string_and_char_test(void)
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(split [here is some text] | |)");
+            "(define v as '({D+1} {D+2} [a]) [v])");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
 
-    size_t const expectedNumOfElems = 4;
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define c as (copy v) [c])");
 
-    ASSERT_EQ(expectedNumOfElems, octaspire_dern_value_as_vector_get_length(evaluatedValue));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
 
-    char const * const expected[] = {"here", "is", "some", "text" };
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "c");
 
-    for (size_t i = 0; i < expectedNumOfElems; ++i)
-    {
-        ASSERT_STR_EQ(
-            expected[i],
-            octaspire_dern_value_as_string_get_c_string(
-                octaspire_dern_value_as_vector_get_element_at_const(
-                    evaluatedValue,
-                    (ptrdiff_t)i)));
-    }
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_is_copy_on_write_pending(evaluatedValue));
 
-    octaspire_dern_vm_release(vm);
-    vm = 0;
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (= v {D+0} {D+10}) (+= (ln@ v {D+2}) [b]) (to-string v))");
 
-    PASS();
-}
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-TEST octaspire_dern_vm_cp_at_sign_with_vector_test(void)
-{
-    octaspire_dern_vm_t *vm =
-        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+    ASSERT_STR_EQ(
+        "({D+10} {D+2} [ab])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    octaspire_dern_value_t *evaluatedValue =
+    evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define v as '({D+1} {D+2} {D+3}) [v])");
+            "(to-string c)");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-    for (int32_t i = 0; i < 10; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+    ASSERT_STR_EQ(
+        "({D+1} {D+2} [a])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(++ (cp@ v {D+1}))");
+            "(do (= (ln@ c {D+1}) {D+20}) (+= (ln@ c {D+2}) [c]) (to-string c))");
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3,                               evaluatedValue->value.integer);
-    }
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(to-string v)");
+    ASSERT_STR_EQ(
+        "({D+1} {D+20} [ac])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string v)");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "({D+1} {D+2} {D+3})",
-        octaspire_string_get_c_string(evaluatedValue->value.string));
+        "({D+10} {D+2} [ab])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as [abc] [s]) (define t as (copy s) [t]) (+= s [d]) t)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("abc", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define h as (hash-map |a| '({D+1})) [h]) "
+            "    (define hc as (copy h) [hc]) "
+            "    (= (ln@ (ln@ h |a| 'hash) {D+0}) {D+2}) "
+            "    (to-string (find hc |a|)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("({D+1})", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Mutating a value materializes only the copies that share it.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define p as [xyz] [p]) (define pc as (copy p) [pc]) "
+            "    (define n as '([a] [b]) [n]) (define nc as (copy n) [nc]) "
+            "    (+= (ln@ n {D+0}) [c]) "
+            "    (to-string nc))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("([a] [b])", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "pc");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_is_copy_on_write_pending(evaluatedValue));
+    ASSERT_STR_EQ("xyz", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15621,42 +16449,26 @@ TEST octaspire_dern_vm_cp_at_sign_with_vector_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_cp_at_sign_with_string_test(void)
+TEST octaspire_dern_vm_copy_of_vector_with_repeated_element_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
+    // Every copy pins the element once for each time it is in the vector,
+    // so copies are made eagerly when the pins would overflow.
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define s as [abc] [s])");
+            "(do (define e as [e] [e]) (define a as '() [a]) (define cs as '() [cs]) "
+            "    (for i from {D+1} to {D+22000} (+= a e)) "
+            "    (for i from {D+1} to {D+3} (+= cs (copy a))) "
+            "    (to-string (len cs) (len (ln@ cs {D+2})) (ln@ (ln@ cs {D+2}) {D+21999})))");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
-
-    for (int32_t i = 0; i < 10; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(+= (cp@ s {D+1}) {D+2})");
-
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
-
-        ASSERT_STR_EQ(
-            "d",
-            octaspire_string_get_c_string(
-                evaluatedValue->value.character));
-    }
-
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "s");
-
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "abc",
-        octaspire_string_get_c_string(evaluatedValue->value.string));
+        "{D+3}{D+22000}[e]",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15664,7 +16476,7 @@ TEST octaspire_dern_vm_cp_at_sign_with_string_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_one_test(void)
+TEST octaspire_dern_vm_copy_is_not_changed_by_increment_or_decrement_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -15672,40 +16484,32 @@ TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_one_test(void)
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define h as (hash-map [a] {D+2}) [h])");
-
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+            "(do (define c as '({D+1} {D+2.5}) [c]) "
+            "    (define c2 as (copy c) [c2]) "
+            "    (++ (ln@ c {D+0})) "
+            "    (-- (ln@ c {D+1})) "
+            "    (to-string c c2))");
 
-    for (int32_t i = 0; i < 5; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(++ (cp@ h {D+0} 'index))");
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3,                                evaluatedValue->value.integer);
-    }
+    ASSERT_STR_EQ(
+        "({D+2} {D+1.5})({D+1} {D+2.5})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    for (int32_t i = 0; i < 5; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(++ (cp@ h [a] 'hash))");
-
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3,                                evaluatedValue->value.integer);
-    }
-
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(to-string h)");
+            "(do (define h as (hash-map |a| {D+1} |b| {D+2}) [h]) "
+            "    (define h2 as (copy h) [h2]) "
+            "    (++ (ln@ h |a| 'hash)) "
+            "    (-- (ln@ h |b| 'hash)) "
+            "    (to-string (find h2 |a|) (find h2 |b|) (find h |a|) (find h |b|)))");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "(hash-map [a] {D+2})",
-        octaspire_string_get_c_string(evaluatedValue->value.string));
+        "{D+1}{D+2}{D+2}{D+1}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15713,93 +16517,90 @@ TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_one_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_three_test(void)
+TEST octaspire_dern_vm_environment_copy_shares_bindings_until_set_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define h as (hash-map [a] {D+1}   [b] {D+2}   [c] {D+3}) [h])");
+    octaspire_dern_environment_t *env =
+        octaspire_dern_environment_new(0, vm, octaspireDernVmTestAllocator);
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    octaspire_dern_value_t * const envVal =
+        octaspire_dern_vm_create_new_value_environment_from_environment(vm, env);
 
-    for (int32_t i = 0; i < 10; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(++ (cp@ h [b] 'hash))");
+    ASSERT(octaspire_dern_vm_push_value(vm, envVal));
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3,                                evaluatedValue->value.integer);
-    }
+    octaspire_dern_value_t * const keyVal =
+        octaspire_dern_vm_create_new_value_symbol_from_c_string(vm, "a");
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [a])");
+    ASSERT(octaspire_dern_vm_push_value(vm, keyVal));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    octaspire_dern_value_t * const oneVal =
+        octaspire_dern_vm_create_new_value_integer(vm, 1);
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [b])");
+    ASSERT(octaspire_dern_environment_set(env, keyVal, oneVal));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(2, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    octaspire_dern_value_t * const copyVal =
+        octaspire_dern_vm_create_new_value_copy(vm, envVal);
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [c])");
+    ASSERT(octaspire_dern_vm_push_value(vm, copyVal));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(3, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    octaspire_dern_environment_t * const copy =
+        octaspire_dern_value_as_environment_get_value(copyVal);
 
-    octaspire_dern_vm_release(vm);
-    vm = 0;
+    ASSERT(copy != env);
+    ASSERT_EQ(env->bindings, copy->bindings);
+    ASSERT_EQ(oneVal, octaspire_dern_environment_get(copy, keyVal));
 
-    PASS();
-}
+    octaspire_dern_value_t * const twoVal =
+        octaspire_dern_vm_create_new_value_integer(vm, 2);
 
+    ASSERT(octaspire_dern_environment_set(copy, keyVal, twoVal));
 
+    ASSERT(env->bindings != copy->bindings);
+    ASSERT_EQ(oneVal, octaspire_dern_environment_get(env,  keyVal));
+    ASSERT_EQ(twoVal, octaspire_dern_environment_get(copy, keyVal));
 
+    octaspire_dern_vm_pop_value(vm, copyVal);
+    octaspire_dern_vm_pop_value(vm, keyVal);
+    octaspire_dern_vm_pop_value(vm, envVal);
 
+    octaspire_dern_vm_release(vm);
+    vm = 0;
 
+    PASS();
+}
 
-TEST octaspire_dern_vm_ln_at_sign_with_vector_test(void)
+TEST octaspire_dern_vm_weak_reference_is_cleared_by_gc_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define v as '({D+1} {D+2} {D+3}) [v])");
+    octaspire_dern_value_t * const targetVal =
+        octaspire_dern_vm_create_new_value_vector(vm);
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    ASSERT(octaspire_dern_vm_push_value(vm, targetVal));
 
-    for (int32_t i = 0; i < 10; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(++ (ln@ v {D+1}))");
+    octaspire_dern_value_t * const referenceVal =
+        octaspire_dern_vm_create_new_value_weak_reference(vm, targetVal);
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
-    }
+    ASSERT(octaspire_dern_vm_push_value(vm, referenceVal));
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(to-string v)");
+    ASSERT(octaspire_dern_vm_gc(vm));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_EQ(
+        targetVal,
+        octaspire_dern_value_as_weak_reference_get_value(referenceVal));
 
-    ASSERT_STR_EQ(
-        "({D+1} {D+12} {D+3})",
-        octaspire_string_get_c_string(evaluatedValue->value.string));
+    ASSERT(octaspire_dern_vm_pop_value(vm, referenceVal));
+    ASSERT(octaspire_dern_vm_pop_value(vm, targetVal));
+    ASSERT(octaspire_dern_vm_push_value(vm, referenceVal));
+
+    ASSERT(octaspire_dern_vm_gc(vm));
+
+    ASSERT_FALSE(octaspire_dern_value_as_weak_reference_get_value(referenceVal));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, referenceVal));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15807,79 +16608,70 @@ TEST octaspire_dern_vm_ln_at_sign_with_vector_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_ln_at_sign_with_string_test(void)
+TEST octaspire_dern_vm_weak_hash_map_entries_are_removed_by_gc_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define s as [abc] [s])");
+    octaspire_dern_value_t * const mapVal =
+        octaspire_dern_vm_create_new_value_weak_hash_map(vm);
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    ASSERT(octaspire_dern_vm_push_value(vm, mapVal));
+    ASSERT(octaspire_dern_value_as_hash_map_has_weak_keys(mapVal));
 
-    evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(ln@ [abc] {D+1})");
+    // Entry 'a' is alive, because its key is on the stack. Entry 'b' is alive
+    // only through the value of 'a'. Entry 'c' is referred only by its own value.
+    octaspire_dern_value_t * const keyA = octaspire_dern_vm_create_new_value_vector(vm);
+    ASSERT(octaspire_dern_vm_push_value(vm, keyA));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+    octaspire_dern_value_t * const keyB = octaspire_dern_vm_create_new_value_vector(vm);
+    ASSERT(octaspire_dern_vm_push_value(vm, keyB));
 
-    ASSERT_STR_EQ(
-        "Builtin 'ln@' cannot be used with strings. Use 'cp@' instead.\n"
-        "\tAt form: >>>>>>>>>>(ln@ [abc] {D+1})<<<<<<<<<<\n",
-        octaspire_string_get_c_string(evaluatedValue->value.error->message)); 
+    octaspire_dern_value_t * const keyC = octaspire_dern_vm_create_new_value_vector(vm);
+    ASSERT(octaspire_dern_vm_push_value(vm, keyC));
 
-    octaspire_dern_vm_release(vm);
-    vm = 0;
+    octaspire_dern_value_t * const valA =
+        octaspire_dern_vm_create_new_value_vector_from_values(vm, 1, keyB);
 
-    PASS();
-}
+    ASSERT(octaspire_dern_value_as_hash_map_put(
+        mapVal, octaspire_dern_value_get_hash(keyA), keyA, valA));
 
-TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_one_test(void)
-{
-    octaspire_dern_vm_t *vm =
-        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+    octaspire_dern_value_t * const valB =
+        octaspire_dern_vm_create_new_value_string_from_c_string(vm, "b");
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(define h as (hash-map [a] {D+2}) [h])");
+    ASSERT(octaspire_dern_value_as_hash_map_put(
+        mapVal, octaspire_dern_value_get_hash(keyB), keyB, valB));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    octaspire_dern_value_t * const valC =
+        octaspire_dern_vm_create_new_value_vector_from_values(vm, 1, keyC);
 
-    for (int32_t i = 0; i < 5; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(++ (ln@ h {D+0} 'index))");
+    ASSERT(octaspire_dern_value_as_hash_map_put(
+        mapVal, octaspire_dern_value_get_hash(keyC), keyC, valC));
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
-    }
+    ASSERT_EQ(3, octaspire_dern_value_as_hash_map_get_number_of_elements(mapVal));
 
-    for (int32_t i = 0; i < 5; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(++ (ln@ h [a] 'hash))");
+    ASSERT(octaspire_dern_vm_pop_value(vm, keyC));
+    ASSERT(octaspire_dern_vm_pop_value(vm, keyB));
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3 + 5 + i,                        evaluatedValue->value.integer);
-    }
+    ASSERT(octaspire_dern_vm_gc(vm));
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(to-string h)");
+    ASSERT_EQ(2, octaspire_dern_value_as_hash_map_get_number_of_elements(mapVal));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_as_hash_map_get(
+        mapVal, octaspire_dern_value_get_hash(keyA), keyA));
 
-    ASSERT_STR_EQ(
-        "(hash-map [a] {D+12})",
-        octaspire_string_get_c_string(evaluatedValue->value.string));
+    ASSERT(octaspire_dern_value_as_hash_map_get(
+        mapVal, octaspire_dern_value_get_hash(keyB), keyB));
+
+    ASSERT_STR_EQ("b", octaspire_dern_value_as_string_get_c_string(valB));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, keyA));
+
+    ASSERT(octaspire_dern_vm_gc(vm));
+
+    ASSERT_EQ(0, octaspire_dern_value_as_hash_map_get_number_of_elements(mapVal));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, mapVal));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15887,7 +16679,7 @@ TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_one_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_three_test(void)
+TEST octaspire_dern_vm_builtin_weak_reference_and_weak_hash_map_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
@@ -15895,41 +16687,49 @@ TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_three_test(void)
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define h as (hash-map [a] {D+1}   [b] {D+2}   [c] {D+3}) [h])");
+            "(do (define v as '({D+1} {D+2}) [v]) "
+            "    (define r as (weak-reference v) [r]) "
+            "    (to-string (weak-reference-get r)))");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-    for (int32_t i = 0; i < 10; ++i)
-    {
-        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+    ASSERT_STR_EQ(
+        "({D+1} {D+2})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(++ (ln@ h [b] 'hash))");
+            "(do (define k as '() [k]) "
+            "    (define w as (weak-hash-map k [cached]) [w]) "
+            "    (to-string (find w k)))");
 
-        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
-    }
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [a])");
+    ASSERT_STR_EQ(
+        "[cached]",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(hash-map? w)");
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [b])");
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT(evaluatedValue->value.boolean);
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(weak-reference-get v)");
 
-    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-        vm,
-        "(find h [c])");
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(3, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    ASSERT_STR_EQ(
+        "Builtin 'weak-reference-get' expects weak reference as the first argument. "
+        "Type 'vector' was given.\n"
+        "\tAt form: >>>>>>>>>>(weak-reference-get v)<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -15937,71 +16737,2041 @@ TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_three_test(void)
     PASS();
 }
 
-TEST octaspire_dern_vm_host_command_line_arguments_test(void)
+TEST octaspire_dern_vm_plus_keeps_multi_octet_characters_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    // Test with missing command line arguments
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(to-string (host-get-command-line-arguments))");
+            "(+ [\xc3\xa4" "b] |\xc3\xb6| [\xe2\x82\xac])");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "()",
+        "\xc3\xa4" "b\xc3\xb6\xe2\x82\xac",
         octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    // Test with existing command line arguments
-    char const * const expected[] =
-    {
-        "a",
-        "\"this is 2. argument\"",
-        "--do-something",
-        "1234",
-        "-c"
-    };
-
-    for (size_t i = 0; i < 5; ++i)
-    {
-        ASSERT(octaspire_dern_vm_add_command_line_argument(vm, expected[i]));
-    }
+    ASSERT_EQ(4, octaspire_dern_value_as_text_get_length_in_ucs_characters(evaluatedValue));
 
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(to-string (host-get-command-line-arguments))");
+            "(+ |\xc3\xa4| [b])");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "([a] [\"this is 2. argument\"] [--do-something] [1234] [-c])",
+        "\xc3\xa4" "b",
         octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
+    // Empty strings are copied too.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(+ [] (to-string []) [b])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("[]b", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
     octaspire_dern_vm_release(vm);
     vm = 0;
 
     PASS();
 }
 
-TEST octaspire_dern_vm_host_environment_variables_test(void)
+TEST octaspire_dern_vm_cached_hash_is_invalidated_by_mutation_test(void)
 {
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    // Test with missing environment variables
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(to-string (host-get-environment-variables))");
+    octaspire_dern_value_t * const str1 =
+        octaspire_dern_vm_create_new_value_string_from_c_string(vm, "abcdefghijk");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_vm_push_value(vm, str1));
 
-    ASSERT_STR_EQ(
-        "()",
-        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+    octaspire_dern_value_t * const str2 =
+        octaspire_dern_vm_create_new_value_string_from_c_string(vm, "abcdefghijkl");
+
+    ASSERT(octaspire_dern_vm_push_value(vm, str2));
+
+    octaspire_dern_value_t * const sym =
+        octaspire_dern_vm_create_new_value_symbol_from_c_string(vm, "abcdefghijk");
+
+    ASSERT(octaspire_dern_vm_push_value(vm, sym));
+
+    ASSERT(octaspire_dern_value_get_hash(str1) != octaspire_dern_value_get_hash(str2));
+    ASSERT_EQ(octaspire_dern_value_get_hash(str1), octaspire_dern_value_get_hash(sym));
+
+    octaspire_dern_value_t * const suffix =
+        octaspire_dern_vm_create_new_value_string_from_c_string(vm, "l");
+
+    ASSERT(octaspire_dern_vm_push_value(vm, suffix));
+
+    ASSERT(octaspire_dern_value_as_string_push_back(str1, suffix));
+    ASSERT_EQ(octaspire_dern_value_get_hash(str2), octaspire_dern_value_get_hash(str1));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, suffix));
+    ASSERT(octaspire_dern_vm_pop_value(vm, sym));
+    ASSERT(octaspire_dern_vm_pop_value(vm, str2));
+    ASSERT(octaspire_dern_vm_pop_value(vm, str1));
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define k as [ab] [key])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define m as (hash-map [abc] [one] k [two]) [map])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(+= k |c|)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(ln@ m k (quote hash))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "one",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_map_put_get_and_remove_many_elements_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_vm_set_prevent_gc(vm, true);
+
+    octaspire_dern_map_t * const hashMap =
+        octaspire_dern_map_new(octaspire_dern_vm_get_allocator(vm));
+
+    ASSERT(hashMap);
+
+    size_t const numElements = 1000;
+
+    for (size_t i = 0; i < numElements; ++i)
+    {
+        octaspire_dern_value_t * const key =
+            octaspire_dern_vm_create_new_value_integer(vm, (int32_t)i);
+
+        octaspire_dern_value_t * const value =
+            octaspire_dern_vm_create_new_value_integer(vm, (int32_t)(i * 2));
+
+        ASSERT(octaspire_dern_map_put(
+            hashMap,
+            octaspire_dern_value_get_hash(key),
+            key,
+            value));
+    }
+
+    ASSERT_EQ(numElements, octaspire_dern_map_get_number_of_elements(hashMap));
+
+    for (size_t i = 0; i < numElements; i += 2)
+    {
+        octaspire_dern_value_t * const key =
+            octaspire_dern_vm_create_new_value_integer(vm, (int32_t)i);
+
+        ASSERT(octaspire_dern_map_remove(
+            hashMap,
+            octaspire_dern_value_get_hash(key),
+            key));
+
+        ASSERT_FALSE(octaspire_dern_map_remove(
+            hashMap,
+            octaspire_dern_value_get_hash(key),
+            key));
+    }
+
+    ASSERT_EQ(numElements / 2, octaspire_dern_map_get_number_of_elements(hashMap));
+
+    for (size_t i = 0; i < numElements; ++i)
+    {
+        octaspire_dern_value_t * const key =
+            octaspire_dern_vm_create_new_value_integer(vm, (int32_t)i);
+
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_const(
+                hashMap,
+                octaspire_dern_value_get_hash(key),
+                key);
+
+        if (i % 2 == 0)
+        {
+            ASSERT_FALSE(element);
+        }
+        else
+        {
+            ASSERT(element);
+
+            ASSERT_EQ(
+                (int32_t)(i * 2),
+                octaspire_dern_map_element_get_value_const(element)->value.integer);
+        }
+    }
+
+    size_t numIterated = 0;
+
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(hashMap);
+
+    while (iter.element)
+    {
+        ASSERT_EQ(1, octaspire_dern_map_element_get_key_const(iter.element)->value.integer % 2);
+        ++numIterated;
+        octaspire_dern_map_element_const_iterator_next(&iter);
+    }
+
+    ASSERT_EQ(numElements / 2, numIterated);
+
+    ASSERT(octaspire_dern_map_clear(hashMap));
+    ASSERT(octaspire_dern_map_is_empty(hashMap));
+
+    octaspire_dern_map_release(hashMap);
+
+    octaspire_dern_vm_set_prevent_gc(vm, false);
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_map_get_at_index_in_any_order_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_vm_set_prevent_gc(vm, true);
+
+    octaspire_dern_map_t * const hashMap =
+        octaspire_dern_map_new(octaspire_dern_vm_get_allocator(vm));
+
+    ASSERT(hashMap);
+
+    int32_t const numElements = 300;
+    int32_t       sumOfKeys   = 0;
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        octaspire_dern_value_t * const key =
+            octaspire_dern_vm_create_new_value_integer(vm, i);
+
+        ASSERT(octaspire_dern_map_put(
+            hashMap,
+            octaspire_dern_value_get_hash(key),
+            key,
+            key));
+
+        sumOfKeys += i;
+    }
+
+    int32_t sumOfKeysByIndex = 0;
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_at_index_const(hashMap, i);
+
+        ASSERT(element);
+
+        sumOfKeysByIndex += octaspire_dern_map_element_get_key_const(element)->value.integer;
+
+        ASSERT_EQ(
+            element,
+            octaspire_dern_map_get_at_index_const(hashMap, i - numElements));
+    }
+
+    ASSERT_EQ(sumOfKeys, sumOfKeysByIndex);
+
+    for (int32_t i = numElements - 1; i >= 0; i -= 7)
+    {
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_at_index_const(hashMap, i);
+
+        octaspire_dern_map_element_const_iterator_t iter =
+            octaspire_dern_map_element_const_iterator_init(hashMap);
+
+        for (int32_t j = 0; j < i; ++j)
+        {
+            octaspire_dern_map_element_const_iterator_next(&iter);
+        }
+
+        ASSERT_EQ(iter.element, element);
+    }
+
+    ASSERT_FALSE(octaspire_dern_map_get_at_index_const(hashMap, numElements));
+    ASSERT_FALSE(octaspire_dern_map_get_at_index_const(hashMap, -numElements - 1));
+
+    octaspire_dern_map_release(hashMap);
+
+    octaspire_dern_vm_set_prevent_gc(vm, false);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define m as (hash-map) [m]) "
+            "(define sum as {D+0} [sum]) "
+            "(for i from {D+1} to {D+500} (+= m i i)) "
+            "(for e in m (+= sum (ln@ e {D+1}))) "
+            "(for i from {D+0} to {D+499} (+= sum (ln@ m i 'index))) "
+            "sum)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(2 * 125250, evaluatedValue->value.integer);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_map_keeps_insertion_order_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_vm_set_prevent_gc(vm, true);
+
+    octaspire_dern_map_t * const hashMap =
+        octaspire_dern_map_new(octaspire_dern_vm_get_allocator(vm));
+
+    ASSERT(hashMap);
+
+    int32_t const numElements = 100;
+
+    octaspire_dern_value_t *keys[100];
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        keys[i] = octaspire_dern_vm_create_new_value_integer(vm, numElements - i);
+
+        ASSERT(octaspire_dern_map_put(
+            hashMap,
+            octaspire_dern_value_get_hash(keys[i]),
+            keys[i],
+            keys[i]));
+    }
+
+    // Remove every element with an odd index, and then put the first one
+    // again. Overwriting a value must not move the element.
+    for (int32_t i = 1; i < numElements; i += 2)
+    {
+        ASSERT(octaspire_dern_map_remove(
+            hashMap,
+            octaspire_dern_value_get_hash(keys[i]),
+            keys[i]));
+    }
+
+    ASSERT_FALSE(octaspire_dern_map_remove(
+        hashMap,
+        octaspire_dern_value_get_hash(keys[1]),
+        keys[1]));
+
+    ASSERT(octaspire_dern_map_put(
+        hashMap,
+        octaspire_dern_value_get_hash(keys[0]),
+        keys[0],
+        keys[1]));
+
+    ASSERT_EQ(numElements / 2, octaspire_dern_map_get_number_of_elements(hashMap));
+
+    int32_t index = 0;
+
+    octaspire_dern_map_element_const_iterator_t iter =
+        octaspire_dern_map_element_const_iterator_init(hashMap);
+
+    while (iter.element)
+    {
+        ASSERT_EQ(keys[index * 2], octaspire_dern_map_element_get_key_const(iter.element));
+        ++index;
+        octaspire_dern_map_element_const_iterator_next(&iter);
+    }
+
+    ASSERT_EQ(numElements / 2, index);
+
+    ASSERT_EQ(
+        keys[1],
+        octaspire_dern_map_element_get_value_const(
+            octaspire_dern_map_get_at_index_const(hashMap, 0)));
+
+    // Removed keys are appended to the end when they are put again.
+    ASSERT(octaspire_dern_map_put(
+        hashMap,
+        octaspire_dern_value_get_hash(keys[1]),
+        keys[1],
+        keys[1]));
+
+    for (int32_t i = 0; i < numElements / 2; ++i)
+    {
+        octaspire_dern_map_element_t const * const element =
+            octaspire_dern_map_get_at_index(hashMap, i);
+
+        ASSERT(element);
+        ASSERT_EQ(keys[i * 2], octaspire_dern_map_element_get_key_const(element));
+
+        ASSERT(octaspire_dern_map_get_const(
+            hashMap,
+            octaspire_dern_value_get_hash(keys[i * 2]),
+            keys[i * 2]));
+    }
+
+    ASSERT_EQ(
+        keys[1],
+        octaspire_dern_map_element_get_key_const(
+            octaspire_dern_map_get_at_index_const(hashMap, -1)));
+
+    octaspire_dern_map_release(hashMap);
+
+    octaspire_dern_vm_set_prevent_gc(vm, false);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define m as (hash-map |c| {D+1} |a| {D+2} |b| {D+3}) [m]) "
+            "(-= m |a|) "
+            "(+= m |a| {D+4}) "
+            "(+= m |c| {D+5}) "
+            "m)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
+
+    octaspire_string_t *tmpStr =
+        octaspire_dern_value_to_string(evaluatedValue, octaspireDernVmTestAllocator);
+
+    ASSERT_STR_EQ(
+        "(hash-map |c| {D+5}\n          |b| {D+3}\n          |a| {D+4})",
+        octaspire_string_get_c_string(tmpStr));
+
+    octaspire_string_release(tmpStr);
+    tmpStr = 0;
+
+    // Setting an existing key keeps the element in its place.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (= m |c| {D+6}) (= m |b| {D+7}) m)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
+
+    tmpStr = octaspire_dern_value_to_string(evaluatedValue, octaspireDernVmTestAllocator);
+
+    ASSERT_STR_EQ(
+        "(hash-map |c| {D+6}\n          |b| {D+7}\n          |a| {D+4})",
+        octaspire_string_get_c_string(tmpStr));
+
+    octaspire_string_release(tmpStr);
+    tmpStr = 0;
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_persistent_vector_shares_structure_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t * const firstVal =
+        octaspire_dern_vm_create_new_value_persistent_vector(vm);
+
+    ASSERT(octaspire_dern_vm_push_value(vm, firstVal));
+
+    // Enough elements for a trie of three levels.
+    int32_t const numElements = 2000;
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        ASSERT(octaspire_dern_value_as_persistent_vector_push_back_element(
+            firstVal,
+            octaspire_dern_vm_create_new_value_integer(vm, i)));
+    }
+
+    octaspire_dern_value_t * const secondVal =
+        octaspire_dern_vm_create_new_value_copy(vm, firstVal);
+
+    ASSERT(octaspire_dern_vm_push_value(vm, secondVal));
+
+    octaspire_dern_value_t * const changedVal =
+        octaspire_dern_vm_create_new_value_integer(vm, -1);
+
+    ASSERT(octaspire_dern_value_as_persistent_vector_set_element_at(
+        secondVal, 5, changedVal));
+
+    ASSERT(octaspire_dern_value_as_persistent_vector_set_element_at(
+        secondVal, -1, changedVal));
+
+    ASSERT(octaspire_dern_value_as_persistent_vector_push_back_element(
+        secondVal, changedVal));
+
+    ASSERT_FALSE(octaspire_dern_value_as_persistent_vector_set_element_at(
+        secondVal, numElements + 1, changedVal));
+
+    // Elements must stay alive through the nodes shared by both vectors.
+    ASSERT(octaspire_dern_vm_gc(vm));
+
+    ASSERT_EQ(numElements,     (int32_t)octaspire_dern_value_get_length(firstVal));
+    ASSERT_EQ(numElements + 1, (int32_t)octaspire_dern_value_get_length(secondVal));
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        octaspire_dern_value_t const * const firstElement =
+            octaspire_dern_value_as_persistent_vector_get_element_at(firstVal, i);
+
+        octaspire_dern_value_t const * const secondElement =
+            octaspire_dern_value_as_persistent_vector_get_element_at(secondVal, i);
+
+        ASSERT_EQ(i, octaspire_dern_value_as_integer_get_value(firstElement));
+
+        if (i == 5 || i == numElements - 1)
+        {
+            ASSERT_EQ(changedVal, secondElement);
+        }
+        else
+        {
+            ASSERT_EQ(firstElement, secondElement);
+        }
+    }
+
+    ASSERT_FALSE(octaspire_dern_value_as_persistent_vector_get_element_at(
+        firstVal, numElements));
+
+    ASSERT_EQ(
+        changedVal,
+        octaspire_dern_value_as_persistent_vector_get_element_at(secondVal, numElements));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, secondVal));
+    ASSERT(octaspire_dern_vm_pop_value(vm, firstVal));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_persistent_hash_map_put_and_remove_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_vm_set_prevent_gc(vm, true);
+
+    octaspire_allocator_t * const allocator = octaspire_dern_vm_get_allocator(vm);
+
+    octaspire_dern_persistent_map_t * const firstMap =
+        octaspire_dern_persistent_map_new(allocator);
+
+    ASSERT(firstMap);
+
+    int32_t const numElements = 1000;
+
+    octaspire_dern_value_t *keys[1000];
+
+    // Every fourth key has the same hash, so that they end up in a collision node.
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        keys[i] = octaspire_dern_vm_create_new_value_integer(vm, i);
+
+        uint32_t const hash = (i % 4 == 0) ?
+            UINT32_C(0xC0FFEE) : octaspire_dern_value_get_hash(keys[i]);
+
+        ASSERT(octaspire_dern_persistent_map_put(firstMap, hash, keys[i], keys[i]));
+    }
+
+    octaspire_dern_persistent_map_t * const secondMap =
+        octaspire_dern_persistent_map_new_copy(firstMap, allocator);
+
+    ASSERT(secondMap);
+
+    for (int32_t i = 0; i < numElements; i += 2)
+    {
+        uint32_t const hash = (i % 4 == 0) ?
+            UINT32_C(0xC0FFEE) : octaspire_dern_value_get_hash(keys[i]);
+
+        ASSERT(octaspire_dern_persistent_map_remove(secondMap, hash, keys[i]));
+        ASSERT_FALSE(octaspire_dern_persistent_map_remove(secondMap, hash, keys[i]));
+    }
+
+    ASSERT_EQ(numElements,     octaspire_dern_persistent_map_get_number_of_elements(firstMap));
+    ASSERT_EQ(numElements / 2, octaspire_dern_persistent_map_get_number_of_elements(secondMap));
+
+    for (int32_t i = 0; i < numElements; ++i)
+    {
+        uint32_t const hash = (i % 4 == 0) ?
+            UINT32_C(0xC0FFEE) : octaspire_dern_value_get_hash(keys[i]);
+
+        ASSERT_EQ(keys[i], octaspire_dern_persistent_map_get(firstMap, hash, keys[i]));
+
+        ASSERT_EQ(
+            (i % 2 == 0) ? 0 : keys[i],
+            octaspire_dern_persistent_map_get(secondMap, hash, keys[i]));
+    }
+
+    // Positional access visits every remaining key once.
+    int32_t sum = 0;
+
+    for (size_t i = 0; i < octaspire_dern_persistent_map_get_number_of_elements(secondMap); ++i)
+    {
+        octaspire_dern_value_t *key   = 0;
+        octaspire_dern_value_t *value = 0;
+
+        ASSERT(octaspire_dern_persistent_map_get_at_index(
+            secondMap, (ptrdiff_t)i, &key, &value));
+
+        ASSERT_EQ(key, value);
+        sum += octaspire_dern_value_as_integer_get_value(key);
+    }
+
+    ASSERT_EQ((numElements / 2) * (numElements / 2), sum);
+
+    octaspire_dern_persistent_map_release(firstMap);
+    octaspire_dern_persistent_map_release(secondMap);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_persistent_vector_and_hash_map_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define v1 as (persistent-vector |a| |b|) [v1]) "
+            "    (define v2 as (assoc (conj v1 |c|) {D+0} |x|) [v2]) "
+            "    (to-string v1 v2 (len v2) (ln@ v2 {D-1})))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(persistent-vector |a| |b|)(persistent-vector |x| |b| |c|){D+3}|c|",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Transients are built in place and made persistent again.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define t as (transient v1) [t]) "
+            "    (define i as {D+0} [i]) "
+            "    (while (< i {D+100}) (conj! t i) (++ i)) "
+            "    (define v3 as (persistent! t) [v3]) "
+            "    (define s as {D+0} [s]) "
+            "    (for e in v3 step {D+50} (+= s {D+1})) "
+            "    (to-string (len v1) (len v3) (ln@ v3 {D+101}) s))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+2}{D+102}{D+99}{D+3}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define m1 as (persistent-hash-map |a| {D+1} |b| {D+2}) [m1]) "
+            "    (define m2 as (dissoc (assoc m1 |c| {D+3}) |a|) [m2]) "
+            "    (define tm as (transient m2) [tm]) "
+            "    (assoc! tm |d| {D+4}) "
+            "    (dissoc! tm |b|) "
+            "    (to-string (len m1) (len m2) (ln@ m1 |a|) (ln@ m2 |c| 'hash) "
+            "               (len (persistent! tm)) (ln@ tm |d|)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+2}{D+2}{D+1}{D+3}{D+2}{D+4}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define n as {D+0} [n]) "
+            "    (for e in m1 (+= n (ln@ e {D+1}))) "
+            "    (to-string n (== m1 (persistent-hash-map |b| {D+2} |a| {D+1}))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+3}true",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(conj! v1 |d|)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'conj!' expects a transient collection. Use 'transient' first.\n"
+        "\tAt form: >>>>>>>>>>(conj! v1 |d|)<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_typed_array_wraps_and_saturates_test(void)
+{
+    octaspire_dern_typed_array_t *typedArray = octaspire_dern_typed_array_new(
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_U8,
+        0,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(typedArray);
+
+    for (int64_t i = 0; i < 300; ++i)
+    {
+        ASSERT(octaspire_dern_typed_array_push_back_integer(typedArray, i));
+    }
+
+    ASSERT_EQ(300, octaspire_dern_typed_array_get_length(typedArray));
+    ASSERT_EQ(255, octaspire_dern_typed_array_get_integer_at(typedArray, 255));
+    ASSERT_EQ(0,   octaspire_dern_typed_array_get_integer_at(typedArray, 256));
+
+    octaspire_dern_typed_array_set_real_at(typedArray, 0, 1000.5);
+    octaspire_dern_typed_array_set_real_at(typedArray, 1, -3);
+    ASSERT_EQ(255, octaspire_dern_typed_array_get_integer_at(typedArray, 0));
+    ASSERT_EQ(0,   octaspire_dern_typed_array_get_integer_at(typedArray, 1));
+
+    octaspire_dern_typed_array_apply_scalar(
+        typedArray,
+        OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_ADD,
+        1);
+
+    ASSERT_EQ(0, octaspire_dern_typed_array_get_integer_at(typedArray, 0));
+    ASSERT_EQ(3, octaspire_dern_typed_array_get_integer_at(typedArray, 2));
+
+    octaspire_dern_typed_array_t *reals = octaspire_dern_typed_array_new_copy(
+        typedArray,
+        OCTASPIRE_DERN_TYPED_ARRAY_ELEMENT_TYPE_F64,
+        octaspireDernVmTestAllocator);
+
+    ASSERT(reals);
+
+    octaspire_dern_typed_array_apply_array(
+        reals,
+        OCTASPIRE_DERN_TYPED_ARRAY_OPERATION_MULTIPLY,
+        reals);
+
+    ASSERT_EQ(9, octaspire_dern_typed_array_get_real_at(reals, 2));
+
+    ASSERT_IN_RANGE(
+        octaspire_dern_typed_array_get_dot_product(typedArray, typedArray),
+        octaspire_dern_typed_array_get_sum(reals),
+        0.000001);
+
+    octaspire_dern_typed_array_release(reals);
+    reals = 0;
+
+    octaspire_dern_typed_array_release(typedArray);
+    typedArray = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_typed_array_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define a as (typed-array 'f64 {D+1} {D+2} '({D+3} {D+4.5})) [a]) "
+            "    (to-string a (len a) (ln@ a {D-1}) (+ a {D+1}) (- a) (* a a)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(typed-array 'f64 {D+1} {D+2} {D+3} {D+4.5}){D+4}{D+4.5}"
+        "(typed-array 'f64 {D+2} {D+3} {D+4} {D+5.5})"
+        "(typed-array 'f64 {D-1} {D-2} {D-3} {D-4.5})"
+        "(typed-array 'f64 {D+1} {D+4} {D+9} {D+20.25})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as {D+0} [s]) "
+            "    (for e in a (+= s e)) "
+            "    (= a {D+0} {D+100}) "
+            "    (to-string s (sum a) (mean a) (dot a a) "
+            "               (max a (typed-array 'i32 {D+5} {D+5} {D+5} {D+5}))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+10.5}{D+109.5}{D+27.375}{D+10033.2}"
+        "(typed-array 'f64 {D+100} {D+5} {D+5} {D+5})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Integer elements wrap around, but division, pow, sqrt and sin
+    // give 'f64 arrays.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define i as (typed-array 'i32 {D+2147483647} {D+9}) [i]) "
+            "    (to-string (+ i {D+1}) (sqrt i) (/ i {D+2}) (sum (typed-array 'u8 {D+1} {D+2}))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(typed-array 'i32 {D-2147483648} {D+10})"
+        "(typed-array 'f64 {D+46341} {D+3})"
+        "(typed-array 'f64 {D+1.07374e+09} {D+4.5}){D+3}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(+ a (typed-array 'f64 {D+1}))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Typed arrays given to builtin '+' must have the same length. "
+        "Lengths 4 and 1 were given.\n"
+        "\tAt form: >>>>>>>>>>(+ a (typed-array (quote f64) {D+1}))<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_bytes_pack_unpack_and_find_test(void)
+{
+    octaspire_dern_bytes_t *bytes = octaspire_dern_bytes_new(octaspireDernVmTestAllocator);
+
+    ASSERT(bytes);
+
+    ASSERT(octaspire_dern_bytes_pack_integer(bytes, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16LE, 0x1234));
+    ASSERT(octaspire_dern_bytes_pack_integer(bytes, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16BE, 0x1234));
+    ASSERT(octaspire_dern_bytes_pack_integer(bytes, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE, -2));
+
+    ASSERT_EQ(8, octaspire_dern_bytes_get_length(bytes));
+
+    uint8_t const expected[] = {0x34, 0x12, 0x12, 0x34, 0xFF, 0xFF, 0xFF, 0xFE};
+    ASSERT_MEM_EQ(expected, octaspire_dern_bytes_get_octets(bytes), sizeof(expected));
+
+    int64_t value = 0;
+
+    ASSERT(octaspire_dern_bytes_unpack_integer(bytes, 0, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U16LE, &value));
+    ASSERT_EQ(0x1234, value);
+
+    ASSERT(octaspire_dern_bytes_unpack_integer(bytes, 4, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I32BE, &value));
+    ASSERT_EQ(-2, value);
+
+    ASSERT(octaspire_dern_bytes_unpack_integer(bytes, 4, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32BE, &value));
+    ASSERT_EQ(0xFFFFFFFE, value);
+
+    ASSERT(octaspire_dern_bytes_unpack_integer(bytes, 7, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_I8, &value));
+    ASSERT_EQ(-2, value);
+
+    ASSERT_FALSE(octaspire_dern_bytes_unpack_integer(bytes, 6, OCTASPIRE_DERN_BYTES_INTEGER_FORMAT_U32LE, &value));
+
+    ASSERT_EQ(1,  octaspire_dern_bytes_find(bytes, "\x12", 1, 0));
+    ASSERT_EQ(2,  octaspire_dern_bytes_find(bytes, "\x12", 1, 2));
+    ASSERT_EQ(2,  octaspire_dern_bytes_find(bytes, "\x12\x34", 2, 0));
+    ASSERT_EQ(5,  octaspire_dern_bytes_find(bytes, "\xFF\xFF\xFE", 3, 0));
+    ASSERT_EQ(-1, octaspire_dern_bytes_find(bytes, "\xFF\xFF\xFE\x00", 4, 0));
+    ASSERT_EQ(-1, octaspire_dern_bytes_find(bytes, "\x12", 1, 4));
+
+    octaspire_dern_bytes_release(bytes);
+    bytes = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_bytes_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define b as (bytes {D+1} [AB] |C| '({D+255}) (bytes {D+0})) [b]) "
+            "    (to-string b (len b) (ln@ b {D-2}) (bytes-slice b {D+1} {D+3}) "
+            "               (bytes-slice b {D-2}) (bytes-to-string (bytes-slice b {D+1} {D-2}))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(bytes {D+1} {D+65} {D+66} {D+67} {D+255} {D+0}){D+6}{D+255}"
+        "(bytes {D+65} {D+66})(bytes {D+255} {D+0})[ABC]",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as {D+0} [s]) "
+            "    (for e in b (+= s e)) "
+            "    (= b {D+0} {D+66}) "
+            "    (to-string s b (find b {D+66}) (find b [BC]) (find b (bytes {D+9}))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+454}(bytes {D+66} {D+65} {D+66} {D+67} {D+255} {D+0})"
+        "({D+0} {D+2})({D+2})()",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define p as (bytes-pack (bytes) 'u16be {D+258} {D-1}) [p]) "
+            "    (bytes-pack p 'i32le {D-2}) "
+            "    (to-string p (bytes-unpack p 'u16be {D+0}) (bytes-unpack p 'i16be {D+2}) "
+            "               (bytes-unpack p 'i32le {D+4}) (bytes-unpack p 'u32le {D+4})))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(bytes {D+1} {D+2} {D+255} {D+255} {D+254} {D+255} {D+255} {D+255})"
+        "{D+258}{D-1}{D-2}{D+4.29497e+09}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(bytes {D+256})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'bytes' expects octets (integers from 0 to 255), strings, "
+        "characters, vectors of octets or bytes. Argument 1 is not valid.\n"
+        "\tAt form: >>>>>>>>>>(bytes {D+256})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(bytes-unpack p 'u32be {D+6})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Third argument to builtin 'bytes-unpack' must be an index that has enough "
+        "octets after it in the bytes.\n"
+        "\tAt form: >>>>>>>>>>(bytes-unpack p (quote u32be) {D+6})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define q as (bytes-pack (bytes) 'u64le {D+258}) [q]) "
+            "    (bytes-pack q 'i64be {D-2}) "
+            "    (to-string q (bytes-unpack q 'u64le {D+0}) (bytes-unpack q 'i64be {D+8}) "
+            "               (bytes-unpack q 'u64be {D+8}) (bytes-unpack q 'i64le {D+8})))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(bytes {D+2} {D+1} {D+0} {D+0} {D+0} {D+0} {D+0} {D+0} "
+        "{D+255} {D+255} {D+255} {D+255} {D+255} {D+255} {D+255} {D+254})"
+        "{D+258}{D-2}{D+1.84467e+19}{D-7.20576e+16}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_string_builder_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define sb as (string-builder [abc] |d|) [sb]) "
+            "    (for i from {D+1} to {D+3} (+= sb | | i)) "
+            "    (+= sb | | {D+2.5} | | 'sym | | '({D+1} {D+2})) "
+            "    (to-string sb (len sb)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(string-builder [abcd 1 2 3 2.5 sym ({D+1} {D+2})]){D+32}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(string-builder-to-string sb)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "abcd 1 2 3 2.5 sym ({D+1} {D+2})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // The builder is empty after conversion and can be used again.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (+= sb [öä] |x|) (string-builder-to-string sb))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("öäx", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+    ASSERT_EQ(3, octaspire_dern_value_as_text_get_length_in_ucs_characters(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(string-builder-to-string [abc])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "First argument to builtin 'string-builder-to-string' must be string builder. "
+        "Type 'string' was given.\n"
+        "\tAt form: >>>>>>>>>>(string-builder-to-string [abc])<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_sort_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (sort '({D+3} {D+1} {D+2.5} {D-4})))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "({D-4} {D+1} {D+2.5} {D+3})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Elements with equal keys keep their order.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (sort '([bb] [a] [cc] [d]) (fn (s) (len s))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "([a] [d] [bb] [cc])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (sort '([pear] [apple] [fig]) nil >))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "([pear] [fig] [apple])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define l as (list {D+5} {D+1} {D+3}) [l]) "
+            "    (define v as '(|c| |a| |b|) [v]) "
+            "    (sort! l) "
+            "    (sort! v (fn (c) c) (fn (a b) (< b a))) "
+            "    (to-string l v))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(list {D+1} {D+3} {D+5})(|c| |b| |a|)",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define t as (typed-array 'i32 {D+3} {D-1} {D+2}) [t]) "
+            "    (define s as (sort t nil >) [s]) "
+            "    (sort! t) "
+            "    (to-string t s))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(typed-array 'i32 {D-1} {D+2} {D+3})(typed-array 'i32 {D+3} {D+2} {D-1})",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(sort '({D+1} {D+2}) nil (fn (a b) {D+1}))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Comparator of builtin 'sort' must return boolean. Type 'integer' was returned.\n"
+        "\tAt form: >>>>>>>>>>(sort (quote ({D+1} {D+2})) nil (fn (a b) {D+1}))<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_set_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as (set {D+1} {D+2} {D+2} [a] 'b) [s]) "
+            "    (+= s {D+3} [a]) "
+            "    (-= s {D+1} {D+99}) "
+            "    (to-string (len s) "
+            "               (set-contains? s {D+2} {D+3} [a] 'b) "
+            "               (set-contains? s {D+1})))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "{D+4}truefalse",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define a as (set {D+1} {D+2} {D+3} {D+4}) [a]) "
+            "    (define b as (set {D+3} {D+4} {D+5}) [b]) "
+            "    (define c as (set {D+4} {D+3} {D+9}) [c]) "
+            "    (to-string (== (set-union a b c) "
+            "                   (set {D+1} {D+2} {D+3} {D+4} {D+5} {D+9})) "
+            "               (== (set-intersection a b c) (set {D+3} {D+4})) "
+            "               (== (set-difference a b) (set {D+1} {D+2})) "
+            "               (== (set-difference a (set {D+1}) c) (set {D+2})) "
+            "               (len a)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "truetruetruetrue{D+4}",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define sum as {D+0} [sum]) "
+            "    (for x in (set {D+1} {D+2} {D+4}) (+= sum x)) "
+            "    sum)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(7, evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(set-union (set) '({D+1}))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Argument 2 to builtin 'set-union' must be set. Type 'vector' was given.\n"
+        "\tAt form: >>>>>>>>>>(set-union (set) (quote ({D+1})))<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_structural_hash_of_collections_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t * const first =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define first as (hash-map [a] '({D+1} (list |x|)) [b] (set {D+2} {D+3})) [f])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, first->typeTag);
+
+    octaspire_dern_value_t * const second =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define second as (hash-map [b] (set {D+3} {D+2}) [a] '({D+1} (list |x|))) [s])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, second->typeTag);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "first");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_vm_push_value(vm, evaluatedValue));
+
+    octaspire_dern_value_t * const secondValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "second");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_HASH_MAP, secondValue->typeTag);
+
+    ASSERT(evaluatedValue != secondValue);
+
+    ASSERT_EQ(
+        octaspire_dern_value_get_hash(evaluatedValue),
+        octaspire_dern_value_get_hash(secondValue));
+
+    ASSERT(octaspire_dern_vm_pop_value(vm, evaluatedValue));
+
+    // Keys that are equal find each other; mutating the value that was
+    // used as a key does not change the stored key.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define memo as (hash-map) [memo]) "
+            "    (define key as '({D+1} {D+2}) [key]) "
+            "    (= memo key [a]) "
+            "    (= memo first [b]) "
+            "    (+= key {D+3}) "
+            "    (to-string (ln@ memo '({D+1} {D+2}) 'hash) "
+            "               (ln@ memo second 'hash) "
+            "               (len memo) "
+            "               (set-contains? (set '(|x| |y|)) '(|x| |y|))))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "[a][b]{D+2}true",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_builtin_sorted_map_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define m as (sorted-map [c] {D+3} [a] {D+1} [b] {D+2}) [m])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "m");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_SORTED_MAP, evaluatedValue->typeTag);
+    ASSERT_EQ(3, octaspire_dern_value_get_length(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (= m [d] {D+4}) "
+            "    (+= m [e] {D+5} [aa] {D+11}) "
+            "    (-= m [c] [x]) "
+            "    (to-string m "
+            "               (ln@ m [b]) "
+            "               (cp@ m {D-1} 'index) "
+            "               (sorted-map-floor m [c]) "
+            "               (sorted-map-ceiling m [c]) "
+            "               (sorted-map-floor m [0]) "
+            "               (sorted-map-range m [aa] [d]) "
+            "               (find m [e]) "
+            "               (sorted-map? m) "
+            "               (hash-map? m)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(sorted-map [a] {D+1} [aa] {D+11} [b] {D+2} [d] {D+4} [e] {D+5})"
+        "{D+2}{D+5}([b] {D+2})([d] {D+4})nil"
+        "(sorted-map [aa] {D+11} [b] {D+2} [d] {D+4})"
+        "{D+5}truefalse",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // 'for' visits the elements in key order as (key value) pairs.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as [] [s]) "
+            "    (for p in (sorted-map {D+2} |b| {D+1} |a| {D+3} |c|) (+= s (to-string p))) "
+            "    s)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "({D+1} |a|)({D+2} |b|)({D+3} |c|)",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Enough elements to split nodes on many levels; every third key is
+    // removed and the rest must still be found by key and by index.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define big as (sorted-map) [big]) "
+            "    (define i as {D+0} [i]) "
+            "    (while (< i {D+3000}) (= big i (* i {D+2})) (++ i)) "
+            "    (= i {D+0}) "
+            "    (while (< i {D+3000}) (-= big i) (+= i {D+3})) "
+            "    (define ok as true [ok]) "
+            "    (= i {D+0}) "
+            "    (while (< i {D+3000}) "
+            "        (if (== (mod i {D+3}) {D+0}) "
+            "            (if (not (== (find big i) nil)) (= ok false)) "
+            "            (if (not (== (ln@ big i) (* i {D+2}))) (= ok false))) "
+            "        (++ i)) "
+            "    (to-string ok "
+            "               (len big) "
+            "               (ln@ big {D+1000} 'index) "
+            "               (sorted-map-ceiling big {D+3}) "
+            "               (sorted-map-floor big {D+2999}) "
+            "               (len (sorted-map-range big {D+100} {D+199})) "
+            "               (== (copy big) big)))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "true{D+2000}{D+3002}({D+4} {D+8})({D+2999} {D+5998}){D+67}true",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(sorted-map [a])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'sorted-map' expects pairs of keys and values. 1 arguments was given.\n"
+        "\tAt form: >>>>>>>>>>(sorted-map [a])<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(sorted-map-floor (hash-map) {D+1})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "First argument to builtin 'sorted-map-floor' must be sorted map. "
+        "Type 'hash map' was given.\n"
+        "\tAt form: >>>>>>>>>>(sorted-map-floor (hash-map) {D+1})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_split_called_with_string_and_char_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(split [here is some text] | |)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
+
+    size_t const expectedNumOfElems = 4;
+
+    ASSERT_EQ(expectedNumOfElems, octaspire_dern_value_as_vector_get_length(evaluatedValue));
+
+    char const * const expected[] = {"here", "is", "some", "text" };
+
+    for (size_t i = 0; i < expectedNumOfElems; ++i)
+    {
+        ASSERT_STR_EQ(
+            expected[i],
+            octaspire_dern_value_as_string_get_c_string(
+                octaspire_dern_value_as_vector_get_element_at_const(
+                    evaluatedValue,
+                    (ptrdiff_t)i)));
+    }
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_split_called_with_string_and_string_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (split [ä, öö,, å, ] [, ]))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "([ä] [öö,] [å])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(split [abc] [])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "The second argument to builtin 'split' cannot be an empty string.\n"
+        "\tAt form: >>>>>>>>>>(split [abc] [])<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_find_from_string_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    // Overlapping occurrences, indices of characters encoded in several
+    // octets and needles long enough to be searched with two-way.
+    char const * const inputs[] =
+    {
+        "(to-string (find [aaaa] [aa]))",
+        "(to-string (find [äxäyä] |ä|))",
+        "(to-string (find [äxäyä] [yä]))",
+        "(to-string (find [abc] []))",
+        "(to-string (find [xxabcabcabcabcabcabcabcdabcabcabcabcabcabcabcdö] "
+            "[abcabcabcabcabcabcabcd]))",
+        "(to-string (find [ååååååååååååååååååååååå] [åååååååååååååååååååå]))",
+        "(to-string (starts-with? [ääkkönen] [ääk]))",
+        "(to-string (starts-with? [ääkkönen] [äk]))"
+    };
+
+    char const * const expected[] =
+    {
+        "({D+0} {D+1} {D+2})",
+        "({D+0} {D+2} {D+4})",
+        "({D+3})",
+        "()",
+        "({D+2} {D+24})",
+        "({D+0} {D+1} {D+2} {D+3})",
+        "true",
+        "false"
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    {
+        octaspire_dern_value_t const * const evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                inputs[i]);
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+        ASSERT_STR_EQ(
+            expected[i],
+            octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+    }
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_string_slice_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (define s as [hello wörld] [s]) "
+            "    (define w as (string-slice s {D+6}) [w]) "
+            "    (define r as (string-slice w {D+2} {D+2}) [r]) "
+            "    (+= s [ and more]) "
+            "    (string-slice-to-string r))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+    ASSERT_STR_EQ("rl", octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    char const * const inputs[] =
+    {
+        "(to-string (string-slice? w) (string-slice? s) (len w) (cp@ w {D+1}) (cp@ w {D-1}))",
+        "(to-string (split-slices [a,bö,,c] |,|))",
+        "(to-string (split w [ö]))",
+        "(to-string (find w |l|) (starts-with? w [wö]) (starts-with? s w))",
+        "(to-string (== w (string-slice [a wörld] {D+2})) (== w [wörld]))"
+    };
+
+    char const * const expected[] =
+    {
+        "truefalse{D+5}|ö||d|",
+        "((string-slice [a]) (string-slice [bö]) (string-slice [c]))",
+        "([w] [rld])",
+        "({D+3})truefalse",
+        "truefalse"
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    {
+        evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                inputs[i]);
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+        ASSERT_STR_EQ(
+            expected[i],
+            octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+    }
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(string-slice [abc] {D+1} {D+3})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'string-slice' cannot take 3 characters starting at index 1 "
+        "from text of 3 characters.\n"
+        "\tAt form: >>>>>>>>>>(string-slice [abc] {D+1} {D+3})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
+
+    // A short slice does not keep a long string alive; the GC gives the
+    // slice a copy of its characters when the string is collected.
+    octaspire_string_t *input =
+        octaspire_string_new("(define long as [", octaspireDernVmTestAllocator);
+
+    for (size_t i = 0; i < 2048; ++i)
+    {
+        ASSERT(octaspire_string_push_back_ucs_character(input, 'x'));
+    }
+
+    ASSERT(octaspire_string_concatenate_c_string(input, "short] [l])"));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            octaspire_string_get_c_string(input));
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    octaspire_string_release(input);
+    input = 0;
+
+    octaspire_dern_value_t * const slice =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(string-slice long {D+2048})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING_SLICE, slice->typeTag);
+    ASSERT(octaspire_dern_value_is_copy_on_write_pending(slice));
+
+    octaspire_dern_vm_push_value(vm, slice);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define long as [] [l])");
+
+    ASSERT(octaspire_dern_vm_gc(vm));
+
+    ASSERT_FALSE(octaspire_dern_value_is_copy_on_write_pending(slice));
+
+    ASSERT_EQ(
+        5,
+        octaspire_dern_value_as_string_slice_get_length_in_octets(slice));
+
+    ASSERT_MEM_EQ(
+        "short",
+        octaspire_dern_value_as_string_slice_get_octets(slice),
+        5);
+
+    octaspire_dern_vm_pop_value(vm, slice);
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_cp_at_sign_with_vector_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define v as '({D+1} {D+2} {D+3}) [v])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (cp@ v {D+1}))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3,                               evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(to-string v)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "({D+1} {D+2} {D+3})",
+        octaspire_string_get_c_string(evaluatedValue->value.string));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_cp_at_sign_with_string_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define s as [abc] [s])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(+= (cp@ s {D+1}) {D+2})");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_CHARACTER, evaluatedValue->typeTag);
+
+        ASSERT_STR_EQ(
+            "d",
+            octaspire_string_get_c_string(
+                evaluatedValue->value.character));
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "s");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "abc",
+        octaspire_string_get_c_string(evaluatedValue->value.string));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_one_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define h as (hash-map [a] {D+2}) [h])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 5; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (cp@ h {D+0} 'index))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3,                                evaluatedValue->value.integer);
+    }
+
+    for (int32_t i = 0; i < 5; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (cp@ h [a] 'hash))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3,                                evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(to-string h)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(hash-map [a] {D+2})",
+        octaspire_string_get_c_string(evaluatedValue->value.string));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_cp_at_sign_with_hash_map_of_size_three_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define h as (hash-map [a] {D+1}   [b] {D+2}   [c] {D+3}) [h])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (cp@ h [b] 'hash))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3,                                evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [a])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [b])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(2, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [c])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(3, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+
+
+
+
+
+TEST octaspire_dern_vm_ln_at_sign_with_vector_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define v as '({D+1} {D+2} {D+3}) [v])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (ln@ v {D+1}))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(to-string v)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "({D+1} {D+12} {D+3})",
+        octaspire_string_get_c_string(evaluatedValue->value.string));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_ln_at_sign_with_string_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define s as [abc] [s])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(ln@ [abc] {D+1})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "Builtin 'ln@' cannot be used with strings. Use 'cp@' instead.\n"
+        "\tAt form: >>>>>>>>>>(ln@ [abc] {D+1})<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message)); 
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_one_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define h as (hash-map [a] {D+2}) [h])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 5; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (ln@ h {D+0} 'index))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
+    }
+
+    for (int32_t i = 0; i < 5; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (ln@ h [a] 'hash))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3 + 5 + i,                        evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(to-string h)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "(hash-map [a] {D+12})",
+        octaspire_string_get_c_string(evaluatedValue->value.string));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_ln_at_sign_with_hash_map_of_size_three_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define h as (hash-map [a] {D+1}   [b] {D+2}   [c] {D+3}) [h])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true,                             evaluatedValue->value.boolean);
+
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(++ (ln@ h [b] 'hash))");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(3 + i,                            evaluatedValue->value.integer);
+    }
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [a])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [b])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue = octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+        vm,
+        "(find h [c])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(3, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_host_command_line_arguments_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    // Test with missing command line arguments
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (host-get-command-line-arguments))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "()",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    // Test with existing command line arguments
+    char const * const expected[] =
+    {
+        "a",
+        "\"this is 2. argument\"",
+        "--do-something",
+        "1234",
+        "-c"
+    };
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ASSERT(octaspire_dern_vm_add_command_line_argument(vm, expected[i]));
+    }
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (host-get-command-line-arguments))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "([a] [\"this is 2. argument\"] [--do-something] [1234] [-c])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_host_environment_variables_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    // Test with missing environment variables
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (host-get-environment-variables))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "()",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
     // Test with existing environment variables
     char const * const expected[] =
@@ -16013,21 +18783,295 @@ TEST octaspire_dern_vm_host_environment_variables_test(void)
         "_=/usr/bin/env"
     };
 
-    for (size_t i = 0; i < 5; ++i)
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ASSERT(octaspire_dern_vm_add_environment_variable(vm, expected[i]));
+    }
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(to-string (host-get-environment-variables))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "([a=0] [LD_LIBRARY_PATH=/some_path/xyz] [b=1] "
+        "[LANGUAGE=en_US:en] [_=/usr/bin/env])",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+static char const * const octaspireDernVmTestCreateNewUserDataTestPluginName =
+    "octaspireDernUnitTestPluginName";
+
+static char const * const octaspireDernVmTestCreateNewUserDataTestPayloadTypeName =
+    "payloadTypeName";
+
+static char const * const octaspireDernVmTestCreateNewUserDataTestPayload =
+    "This is the payload...";
+
+octaspire_dern_value_t *octaspire_dern_test_dern_vm_create_new_user_data(
+    octaspire_dern_vm_t * const vm,
+    octaspire_dern_value_t * const arguments,
+    octaspire_dern_value_t * const environment)
+{
+    OCTASPIRE_HELPERS_UNUSED_PARAMETER(arguments);
+    OCTASPIRE_HELPERS_UNUSED_PARAMETER(environment);
+
+    return octaspire_dern_vm_create_new_value_c_data(
+            vm,
+            octaspireDernVmTestCreateNewUserDataTestPluginName,
+            octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
+            "",
+            "",
+            "",
+            "",
+            "",
+            "",
+            true,
+            (void*)octaspireDernVmTestCreateNewUserDataTestPayload);
+}
+
+TEST octaspire_dern_vm_create_user_data_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    ASSERT(octaspire_dern_vm_create_and_register_new_builtin(
+            vm,
+            "octaspire-dern-test-dern-vm-create-new-user-data",
+            octaspire_dern_test_dern_vm_create_new_user_data,
+            0,
+            "...",
+            false,
+            octaspire_dern_value_as_environment_get_value(
+                octaspire_dern_vm_get_global_environment(vm))));
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(octaspire-dern-test-dern-vm-create-new-user-data)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_C_DATA, evaluatedValue->typeTag);
+
+    octaspire_dern_c_data_t const * const cData =
+        octaspire_dern_value_as_c_data_get_value(evaluatedValue);
+
+    ASSERT_STR_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPluginName,
+        octaspire_dern_c_data_get_plugin_name(cData));
+
+    ASSERT_STR_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
+        octaspire_dern_c_data_get_payload_typename(cData));
+
+    ASSERT_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPayload,
+        octaspire_dern_c_data_get_payload(cData));
+
+    ASSERT_STR_EQ(
+        (char const * const)octaspireDernVmTestCreateNewUserDataTestPayload,
+        (char const * const)octaspire_dern_c_data_get_payload(cData));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_copy_user_data_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    ASSERT(octaspire_dern_vm_create_and_register_new_builtin(
+            vm,
+            "octaspire-dern-test-dern-vm-create-new-user-data",
+            octaspire_dern_test_dern_vm_create_new_user_data,
+            0,
+            "...",
+            false,
+            octaspire_dern_value_as_environment_get_value(
+                octaspire_dern_vm_get_global_environment(vm))));
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define a as (octaspire-dern-test-dern-vm-create-new-user-data) [a])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true, octaspire_dern_value_as_boolean_get_value(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define b as (copy a) [b])");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT_EQ(true, octaspire_dern_value_as_boolean_get_value(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(= a {D+1})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "b");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_C_DATA, evaluatedValue->typeTag);
+
+    octaspire_dern_c_data_t const * const cData =
+        octaspire_dern_value_as_c_data_get_value(evaluatedValue);
+
+    ASSERT_STR_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPluginName,
+        octaspire_dern_c_data_get_plugin_name(cData));
+
+    ASSERT_STR_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
+        octaspire_dern_c_data_get_payload_typename(cData));
+
+    ASSERT_EQ(
+        octaspireDernVmTestCreateNewUserDataTestPayload,
+        octaspire_dern_c_data_get_payload(cData));
+
+    ASSERT_STR_EQ(
+        (char const * const)octaspireDernVmTestCreateNewUserDataTestPayload,
+        (char const * const)octaspire_dern_c_data_get_payload(cData));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+octaspire_input_t *octaspire_test_dern_vm_custom_require_file_loader(
+    char const * const name,
+    octaspire_allocator_t * const allocator)
+{
+    if (strcmp("test1.dern", name) == 0)
     {
-        ASSERT(octaspire_dern_vm_add_environment_variable(vm, expected[i]));
+        return octaspire_input_new_from_c_string(
+            "(define f1 as (fn (a b) (+ a b)) [f1] '(a [a] b [b]) howto-ok)",
+            allocator);
     }
+    else if (strcmp("test2.dern", name) == 0)
+    {
+        return octaspire_input_new_from_c_string(
+            "(define f2 as (fn (a b) (* a b)) [f2] '(a [a] b [b]) howto-ok)",
+            allocator);
+    }
+
+    return 0;
+}
+
+TEST octaspire_dern_vm_require_a_source_library_test(void)
+{
+    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
+    config.preLoaderForRequireSrc = octaspire_test_dern_vm_custom_require_file_loader;
+
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new_with_config(
+            octaspireDernVmTestAllocator,
+            octaspireDernVmTestStdio,
+            config);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require 'test1)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "test1.dern",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
 
+
+    // Test function from the 'test1' library
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(to-string (host-get-environment-variables))");
+            "(f1 {D+2} {D+10})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+
+
+    // Load 'test2' library
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require 'test2)");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "([a=0] [LD_LIBRARY_PATH=/some_path/xyz] [b=1] "
-        "[LANGUAGE=en_US:en] [_=/usr/bin/env])",
+        "test2.dern",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+
+
+    // Test function from the 'test2' library
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(f2 {D+2} {D+10})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(20, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_require_a_source_library_from_file_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require-from-file-add {D+2} {D+10})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "require-from-file-text");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+    ASSERT_STR_EQ(
+        "text with ) in it",
         octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
     octaspire_dern_vm_release(vm);
@@ -16036,232 +19080,341 @@ TEST octaspire_dern_vm_host_environment_variables_test(void)
     PASS();
 }
 
-static char const * const octaspireDernVmTestCreateNewUserDataTestPluginName =
-    "octaspireDernUnitTestPluginName";
+TEST octaspire_dern_vm_require_a_source_library_through_fasl_cache_test(void)
+{
+    char const * const sourcePath =
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern";
+
+    char const * const faslPath =
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test.dern.fasl";
+
+    remove(faslPath);
+
+    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
+    config.faslCacheOn = true;
+
+    // First run saves the forms, second run loads them and the third run
+    // replaces the damaged file.
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (i == 2)
+        {
+            FILE *file = fopen(faslPath, "wb");
+            ASSERT(file);
+            ASSERT_EQ(8, fwrite("DERNFASL", 1, 8, file));
+            fclose(file);
+            file = 0;
+        }
+
+        octaspire_dern_vm_t *vm = octaspire_dern_vm_new_with_config(
+            octaspireDernVmTestAllocator,
+            octaspireDernVmTestStdio,
+            config);
+
+        octaspire_dern_value_t *evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                "(require '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test)");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
+
+        evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                "(require-from-file-add {D+2} {D+10})");
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+        ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
 
-static char const * const octaspireDernVmTestCreateNewUserDataTestPayloadTypeName =
-    "payloadTypeName";
+        evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                "require-from-file-text");
 
-static char const * const octaspireDernVmTestCreateNewUserDataTestPayload =
-    "This is the payload...";
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
-octaspire_dern_value_t *octaspire_dern_test_dern_vm_create_new_user_data(
-    octaspire_dern_vm_t * const vm,
-    octaspire_dern_value_t * const arguments,
-    octaspire_dern_value_t * const environment)
-{
-    OCTASPIRE_HELPERS_UNUSED_PARAMETER(arguments);
-    OCTASPIRE_HELPERS_UNUSED_PARAMETER(environment);
+        ASSERT_STR_EQ(
+            "text with ) in it",
+            octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    return octaspire_dern_vm_create_new_value_c_data(
-            vm,
-            octaspireDernVmTestCreateNewUserDataTestPluginName,
-            octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
-            "",
-            "",
-            "",
-            "",
-            "",
-            "",
-            true,
-            (void*)octaspireDernVmTestCreateNewUserDataTestPayload);
-}
+        octaspire_dern_vm_release(vm);
+        vm = 0;
+    }
 
-TEST octaspire_dern_vm_create_user_data_test(void)
-{
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    ASSERT(octaspire_dern_vm_create_and_register_new_builtin(
-            vm,
-            "octaspire-dern-test-dern-vm-create-new-user-data",
-            octaspire_dern_test_dern_vm_create_new_user_data,
-            0,
-            "...",
-            false,
-            octaspire_dern_value_as_environment_get_value(
-                octaspire_dern_vm_get_global_environment(vm))));
+    octaspire_dern_fasl_t *fasl = octaspire_dern_fasl_new(
+        sourcePath,
+        0,
+        octaspireDernVmTestStdio,
+        octaspireDernVmTestAllocator);
 
-    octaspire_dern_value_t *evaluatedValue =
-        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
-            vm,
-            "(octaspire-dern-test-dern-vm-create-new-user-data)");
+    ASSERT(fasl);
+    ASSERT_STR_EQ(faslPath, octaspire_dern_fasl_get_path(fasl));
+    ASSERT(octaspire_dern_fasl_load(fasl));
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_C_DATA, evaluatedValue->typeTag);
+    size_t lineNumber = 0;
 
-    octaspire_dern_c_data_t const * const cData =
-        octaspire_dern_value_as_c_data_get_value(evaluatedValue);
+    octaspire_dern_value_t *form =
+        octaspire_dern_fasl_read_next_form(fasl, vm, &lineNumber);
 
-    ASSERT_STR_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPluginName,
-        octaspire_dern_c_data_get_plugin_name(cData));
+    ASSERT(form);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, form->typeTag);
+    ASSERT_EQ(6, lineNumber);
+
+    octaspire_string_t *str =
+        octaspire_dern_value_to_string(form, octaspireDernVmTestAllocator);
 
     ASSERT_STR_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
-        octaspire_dern_c_data_get_payload_typename(cData));
+        "(define require-from-file-add as (fn (a b) (+ a b)) "
+        "[add a and b] (quote (a [first] b [second])) howto-no)",
+        octaspire_string_get_c_string(str));
 
-    ASSERT_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPayload,
-        octaspire_dern_c_data_get_payload(cData));
+    octaspire_string_release(str);
+    str = 0;
 
-    ASSERT_STR_EQ(
-        (char const * const)octaspireDernVmTestCreateNewUserDataTestPayload,
-        (char const * const)octaspire_dern_c_data_get_payload(cData));
+    form = octaspire_dern_fasl_read_next_form(fasl, vm, &lineNumber);
+
+    ASSERT(form);
+    ASSERT_EQ(9, lineNumber);
+
+    ASSERT_FALSE(octaspire_dern_fasl_read_next_form(fasl, vm, &lineNumber));
+
+    octaspire_dern_fasl_release(fasl);
+    fasl = 0;
 
     octaspire_dern_vm_release(vm);
     vm = 0;
 
+    ASSERT_EQ(0, remove(faslPath));
+
     PASS();
 }
 
-TEST octaspire_dern_vm_copy_user_data_test(void)
+TEST octaspire_dern_vm_save_and_load_image_test(void)
 {
+    char const * const imagePath =
+        OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_save_and_load_image_test.image";
+
     octaspire_dern_vm_t *vm =
         octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-    ASSERT(octaspire_dern_vm_create_and_register_new_builtin(
-            vm,
-            "octaspire-dern-test-dern-vm-create-new-user-data",
-            octaspire_dern_test_dern_vm_create_new_user_data,
-            0,
-            "...",
-            false,
-            octaspire_dern_value_as_environment_get_value(
-                octaspire_dern_vm_get_global_environment(vm))));
-
     octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define a as (octaspire-dern-test-dern-vm-create-new-user-data) [a])");
+            "(require '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test)");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true, octaspire_dern_value_as_boolean_get_value(evaluatedValue));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(define b as (copy a) [b])");
+            "(do "
+            "(define make-adder as (fn (n) (fn (x) (+ x n))) [make adder] '(n [amount]) howto-no) "
+            "(define add-five as (make-adder {D+5}) [add five] '(x [number]) howto-no) "
+            "(define shared as (vector {D+1} {D+2}) [shared]) "
+            "(define items as (vector shared shared [text] |a| {D+1.5} 'sym nil true) [items]) "
+            "(define table as (hash-map [one] {D+1} (vector {D+2}) [two]) [table]) "
+            "(define members as (set [a] [b]) [members]) "
+            "(define data as (bytes {D+1} {D+255}) [data]) "
+            "(define builder as (string-builder [ab] |c|) [builder]) "
+            "(define counts as (typed-array 'i64 {D+1} {D-2}) [counts]) "
+            "(define weights as (typed-array 'f32 {D+1.5} {D-2}) [weights]))");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
-    ASSERT_EQ(true, octaspire_dern_value_as_boolean_get_value(evaluatedValue));
 
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(= a {D+1})");
+            "(save-image [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+            "octaspire_save_and_load_image_test.image])");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(1, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_as_boolean_get_value(evaluatedValue));
 
+    // Ports are bound to the running process.
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "b");
-
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_C_DATA, evaluatedValue->typeTag);
-
-    octaspire_dern_c_data_t const * const cData =
-        octaspire_dern_value_as_c_data_get_value(evaluatedValue);
+            "(define f as (io-file-open [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+            "octaspire_io_file_open_test.txt]) [f])");
 
-    ASSERT_STR_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPluginName,
-        octaspire_dern_c_data_get_plugin_name(cData));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
 
-    ASSERT_STR_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPayloadTypeName,
-        octaspire_dern_c_data_get_payload_typename(cData));
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(save-image [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+            "octaspire_save_and_load_image_test.image])");
 
-    ASSERT_EQ(
-        octaspireDernVmTestCreateNewUserDataTestPayload,
-        octaspire_dern_c_data_get_payload(cData));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        (char const * const)octaspireDernVmTestCreateNewUserDataTestPayload,
-        (char const * const)octaspire_dern_c_data_get_payload(cData));
+        "Image '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_save_and_load_image_test.image' "
+        "cannot be saved: values of type 'port' cannot be saved.\n"
+        "\tAt form: >>>>>>>>>>(save-image [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+        "octaspire_save_and_load_image_test.image])<<<<<<<<<<\n",
+        octaspire_string_get_c_string(evaluatedValue->value.error->message));
 
     octaspire_dern_vm_release(vm);
     vm = 0;
 
-    PASS();
-}
+    vm = octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
 
-octaspire_input_t *octaspire_test_dern_vm_custom_require_file_loader(
-    char const * const name,
-    octaspire_allocator_t * const allocator)
-{
-    if (strcmp("test1.dern", name) == 0)
-    {
-        return octaspire_input_new_from_c_string(
-            "(define f1 as (fn (a b) (+ a b)) [f1] '(a [a] b [b]) howto-ok)",
-            allocator);
-    }
-    else if (strcmp("test2.dern", name) == 0)
-    {
-        return octaspire_input_new_from_c_string(
-            "(define f2 as (fn (a b) (* a b)) [f2] '(a [a] b [b]) howto-ok)",
-            allocator);
-    }
+    evaluatedValue = octaspire_dern_image_load(vm, imagePath);
 
-    return 0;
-}
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_as_boolean_get_value(evaluatedValue));
 
-TEST octaspire_dern_vm_require_a_source_library_test(void)
-{
-    octaspire_dern_vm_config_t config = octaspire_dern_vm_config_default();
-    config.preLoaderForRequireSrc = octaspire_test_dern_vm_custom_require_file_loader;
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require-from-file-add {D+2} {D+10})");
 
-    octaspire_dern_vm_t *vm =
-        octaspire_dern_vm_new_with_config(
-            octaspireDernVmTestAllocator,
-            octaspireDernVmTestStdio,
-            config);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
 
-    octaspire_dern_value_t *evaluatedValue =
+    evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(require 'test1)");
+            "(add-five {D+10})");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(15, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(doc add-five)");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "test1.dern",
+        "add five\nArguments are:\nx -> number",
         octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
+    // Values shared before saving are shared after loading.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(do (+= shared {D+3}) (to-string items))");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
+    ASSERT_STR_EQ(
+        "(({D+1} {D+2} {D+3}) ({D+1} {D+2} {D+3}) [text] |a| {D+1.5} sym nil true)",
+        octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
-    // Test function from the 'test1' library
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(f1 {D+2} {D+10})");
+            "(vector (cp@ table [one] 'hash) (cp@ table (vector {D+2}) 'hash) (set-contains? members [b]))");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(12, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
 
+    octaspire_string_t *str =
+        octaspire_dern_value_to_string(evaluatedValue, octaspireDernVmTestAllocator);
 
+    ASSERT_STR_EQ("({D+1} [two] true)", octaspire_string_get_c_string(str));
+
+    octaspire_string_release(str);
+    str = 0;
 
-    // Load 'test2' library
     evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(require 'test2)");
+            "(do (+= builder |d|) (to-string data builder counts weights))");
 
     ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_STRING, evaluatedValue->typeTag);
 
     ASSERT_STR_EQ(
-        "test2.dern",
+        "(bytes {D+1} {D+255})(string-builder [abcd])"
+        "(typed-array 'i64 {D+1} {D-2})(typed-array 'f32 {D+1.5} {D-2})",
         octaspire_dern_value_as_string_get_c_string(evaluatedValue));
 
+    // Source library is loaded already and is not read again.
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(require '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_require_from_file_test)");
+
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT(octaspire_dern_value_as_boolean_get_value(evaluatedValue));
 
+    octaspire_dern_vm_release(vm);
+    vm = 0;
 
-    // Test function from the 'test2' library
-    evaluatedValue =
+    ASSERT_EQ(0, remove(imagePath));
+
+    PASS();
+}
+
+TEST octaspire_dern_vm_save_image_with_value_that_cannot_be_saved_failure_test(void)
+{
+    static char const * const values[] =
+    {
+        "(persistent-vector {D+1})",
+        "(persistent-hash-map |a| {D+1})",
+        "(sorted-map [a] {D+1})",
+        "(string-slice [abc] {D+1})",
+        "(weak-reference v)"
+    };
+
+    static char const * const typeNames[] =
+    {
+        "persistent vector",
+        "persistent hash map",
+        "sorted map",
+        "string slice",
+        "weak reference"
+    };
+
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
         octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
             vm,
-            "(f2 {D+2} {D+10})");
+            "(define v as nil [v])");
 
-    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
-    ASSERT_EQ(20, octaspire_dern_value_as_integer_get_value(evaluatedValue));
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        octaspire_string_t *form = octaspire_string_new_format(
+            octaspireDernVmTestAllocator,
+            "(do (= v %s) (save-image [" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH
+            "octaspire_save_image_failure_test.image]))",
+            values[i]);
+
+        ASSERT(form);
+
+        evaluatedValue =
+            octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+                vm,
+                octaspire_string_get_c_string(form));
+
+        octaspire_string_release(form);
+        form = 0;
+
+        ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_ERROR, evaluatedValue->typeTag);
+
+        octaspire_string_t *expected = octaspire_string_new_format(
+            octaspireDernVmTestAllocator,
+            "Image '" OCTASPIRE_DERN_CONFIG_TEST_RES_PATH "octaspire_save_image_failure_test.image' "
+            "cannot be saved: values of type '%s' cannot be saved.",
+            typeNames[i]);
+
+        ASSERT(expected);
+
+        ASSERT(octaspire_string_starts_with(
+            evaluatedValue->value.error->message,
+            expected));
+
+        octaspire_string_release(expected);
+        expected = 0;
+    }
 
     octaspire_dern_vm_release(vm);
     vm = 0;
@@ -17675,6 +20828,53 @@ TEST octaspire_dern_vm_eval_unbalanced_parenthesis_2_test(void)
     PASS();
 }
 
+TEST octaspire_dern_vm_eval_lists_quotes_and_symbols_read_without_tokens_test(void)
+{
+    octaspire_dern_vm_t *vm =
+        octaspire_dern_vm_new(octaspireDernVmTestAllocator, octaspireDernVmTestStdio);
+
+    octaspire_dern_value_t *evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(len '(a #! c !# ; comment\n b #! d !#))");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_INTEGER, evaluatedValue->typeTag);
+    ASSERT_EQ(2, evaluatedValue->value.integer);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "(define ääääääääääääääääääääääääääääääääääääääääääääääääää as {D+3} [x])");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_BOOLEAN, evaluatedValue->typeTag);
+    ASSERT(evaluatedValue->value.boolean);
+
+    evaluatedValue =
+        octaspire_dern_vm_read_from_c_string_and_eval_in_global_environment(
+            vm,
+            "`(true false nil 'x ,ääääääääääääääääääääääääääääääääääääääääääääääääää)");
+
+    ASSERT(evaluatedValue);
+    ASSERT_EQ(OCTASPIRE_DERN_VALUE_TAG_VECTOR, evaluatedValue->typeTag);
+
+    octaspire_string_t *str =
+        octaspire_dern_value_to_string(evaluatedValue, octaspireDernVmTestAllocator);
+
+    ASSERT_STR_EQ(
+        "(true false nil (quote x) {D+3})",
+        octaspire_string_get_c_string(str));
+
+    octaspire_string_release(str);
+    str = 0;
+
+    octaspire_dern_vm_release(vm);
+    vm = 0;
+
+    PASS();
+}
+
 TEST octaspire_dern_vm_recursive_fibonacci_function_20_test(void)
 {
     octaspire_dern_vm_t *vm =
@@ -17877,6 +21077,8 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
     RUN_TEST(octaspire_dern_vm_special_select_one_false_and_one_true_selectors_to_string_a_test);
     RUN_TEST(octaspire_dern_vm_special_select_function_selectors_evaluating_into_false_and_true_to_string_a_test);
     RUN_TEST(octaspire_dern_vm_special_select_function_selectors_failure_on_unknown_symbol_test);
+    RUN_TEST(octaspire_dern_vm_unbound_symbol_suggestions_are_sorted_test);
+    RUN_TEST(octaspire_dern_vm_unbound_symbol_suggestions_break_ties_test);
     RUN_TEST(octaspire_dern_vm_special_select_called_with_zero_arguments_failure_test);
     RUN_TEST(octaspire_dern_vm_special_select_called_with_one_argument_failure_test);
     RUN_TEST(octaspire_dern_vm_special_select_called_with_three_arguments_failure_test);
@@ -17974,6 +21176,8 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
     RUN_TEST(octaspire_dern_vm_builtin_plus_plus_integer_value_test);
     RUN_TEST(octaspire_dern_vm_builtin_doc_for_integer_value_test);
     RUN_TEST(octaspire_dern_vm_builtin_read_and_eval_path_test);
+    RUN_TEST(octaspire_dern_vm_builtin_read_and_eval_path_with_many_paths_test);
+    RUN_TEST(octaspire_dern_vm_loader_waits_for_files_in_any_order_test);
     RUN_TEST(octaspire_dern_vm_builtin_read_and_eval_string_test);
     RUN_TEST(octaspire_dern_vm_builtin_slash_1_test);
     RUN_TEST(octaspire_dern_vm_builtin_slash_10_2_2_test);
@@ -18059,6 +21263,7 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
 
     RUN_TEST(octaspire_dern_vm_builtin_hash_map_empty_test);
     RUN_TEST(octaspire_dern_vm_builtin_hash_map_one_element_symbol_one_1_test);
+    RUN_TEST(octaspire_dern_vm_hash_map_key_and_value_accessors_test);
     RUN_TEST(octaspire_dern_vm_builtin_hash_map_one_element_1_symbol_one_test);
     RUN_TEST(octaspire_dern_vm_builtin_hash_map_two_elements_strings_dog_barks_and_sun_shines_test);
     RUN_TEST(octaspire_dern_vm_string_literal_with_embedded_characters_t_bar_newline_tab_test);
@@ -18128,6 +21333,7 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
 
     RUN_TEST(octaspire_dern_vm_builtin_plus_equals_with_bad_input_test);
     RUN_TEST(octaspire_dern_vm_run_user_factorial_function_test);
+    RUN_TEST(octaspire_dern_vm_read_from_reader_and_eval_in_global_environment_test);
 
     RUN_TEST(octaspire_dern_vm_special_for_from_0_to_10_test);
     RUN_TEST(octaspire_dern_vm_special_for_from_0_to_10_with_step_2_test);
@@ -18161,6 +21367,8 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_1_and_minus1_symbol_xabcy_test);
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_1_and_minus1_vector_with_chars_xabcy_test);
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_3_and_string_abc_failure_test);
+    RUN_TEST(octaspire_dern_vm_builtin_ln_at_sign_and_cp_at_sign_called_with_queue_test);
+    RUN_TEST(octaspire_dern_vm_builtin_ln_at_sign_and_cp_at_sign_called_with_invalid_index_failure_test);
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_3_and_nil_test);
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_minus1_and_integer_with_only_MSB_on_test);
     RUN_TEST(octaspire_dern_vm_builtin_cp_at_sign_called_with_minus2_and_integer_with_only_MSB_on_test);
@@ -18316,6 +21524,7 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
 
     RUN_TEST(octaspire_dern_vm_io_file_open_success_test);
     RUN_TEST(octaspire_dern_vm_input_file_open_success_test);
+    RUN_TEST(octaspire_dern_vm_port_read_with_count_test);
     RUN_TEST(octaspire_dern_vm_output_file_open_success_test);
 
     RUN_TEST(octaspire_dern_vm_port_supports_input_question_mark_called_with_output_file_test);
@@ -18352,10 +21561,39 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
     RUN_TEST(octaspire_dern_vm_queue_test);
     RUN_TEST(octaspire_dern_vm_queue_with_max_length_test);
     RUN_TEST(octaspire_dern_vm_list_test);
+    RUN_TEST(octaspire_dern_vm_deque_push_and_pop_at_both_ends_test);
+    RUN_TEST(octaspire_dern_vm_long_list_and_queue_test);
 
     RUN_TEST(octaspire_dern_vm_copy_test);
+    RUN_TEST(octaspire_dern_vm_copy_is_copy_on_write_test);
+    RUN_TEST(octaspire_dern_vm_copy_of_vector_with_repeated_element_test);
+    RUN_TEST(octaspire_dern_vm_copy_is_not_changed_by_increment_or_decrement_test);
+    RUN_TEST(octaspire_dern_vm_environment_copy_shares_bindings_until_set_test);
+    RUN_TEST(octaspire_dern_vm_weak_reference_is_cleared_by_gc_test);
+    RUN_TEST(octaspire_dern_vm_weak_hash_map_entries_are_removed_by_gc_test);
+    RUN_TEST(octaspire_dern_vm_builtin_weak_reference_and_weak_hash_map_test);
+    RUN_TEST(octaspire_dern_vm_plus_keeps_multi_octet_characters_test);
+    RUN_TEST(octaspire_dern_vm_cached_hash_is_invalidated_by_mutation_test);
+    RUN_TEST(octaspire_dern_vm_map_put_get_and_remove_many_elements_test);
+    RUN_TEST(octaspire_dern_vm_map_get_at_index_in_any_order_test);
+    RUN_TEST(octaspire_dern_vm_map_keeps_insertion_order_test);
+    RUN_TEST(octaspire_dern_vm_persistent_vector_shares_structure_test);
+    RUN_TEST(octaspire_dern_vm_persistent_hash_map_put_and_remove_test);
+    RUN_TEST(octaspire_dern_vm_builtin_persistent_vector_and_hash_map_test);
+    RUN_TEST(octaspire_dern_vm_typed_array_wraps_and_saturates_test);
+    RUN_TEST(octaspire_dern_vm_builtin_typed_array_test);
+    RUN_TEST(octaspire_dern_vm_bytes_pack_unpack_and_find_test);
+    RUN_TEST(octaspire_dern_vm_builtin_bytes_test);
+    RUN_TEST(octaspire_dern_vm_builtin_string_builder_test);
+    RUN_TEST(octaspire_dern_vm_builtin_sort_test);
+    RUN_TEST(octaspire_dern_vm_builtin_set_test);
+    RUN_TEST(octaspire_dern_vm_structural_hash_of_collections_test);
+    RUN_TEST(octaspire_dern_vm_builtin_sorted_map_test);
 
     RUN_TEST(octaspire_dern_vm_split_called_with_string_and_char_test);
+    RUN_TEST(octaspire_dern_vm_split_called_with_string_and_string_test);
+    RUN_TEST(octaspire_dern_vm_find_from_string_test);
+    RUN_TEST(octaspire_dern_vm_string_slice_test);
 
     RUN_TEST(octaspire_dern_vm_cp_at_sign_with_vector_test);
     RUN_TEST(octaspire_dern_vm_cp_at_sign_with_string_test);
@@ -18374,6 +21612,10 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
     RUN_TEST(octaspire_dern_vm_copy_user_data_test);
 
     RUN_TEST(octaspire_dern_vm_require_a_source_library_test);
+    RUN_TEST(octaspire_dern_vm_require_a_source_library_from_file_test);
+    RUN_TEST(octaspire_dern_vm_require_a_source_library_through_fasl_cache_test);
+    RUN_TEST(octaspire_dern_vm_save_and_load_image_test);
+    RUN_TEST(octaspire_dern_vm_save_image_with_value_that_cannot_be_saved_failure_test);
 
     RUN_TEST(octaspire_dern_vm_special_howto_1_2_3_test);
     RUN_TEST(octaspire_dern_vm_special_howto_strings_a_b_ab_test);
@@ -18401,6 +21643,7 @@ GREATEST_SUITE(octaspire_dern_vm_suite)
 
     RUN_TEST(octaspire_dern_vm_eval_unbalanced_parenthesis_1_test);
     RUN_TEST(octaspire_dern_vm_eval_unbalanced_parenthesis_2_test);
+    RUN_TEST(octaspire_dern_vm_eval_lists_quotes_and_symbols_read_without_tokens_test);
 
     RUN_TEST(octaspire_dern_vm_recursive_fibonacci_function_20_test);
 
@@ -37,7 +37,7 @@ if [ "$2" = "--coverage" ]; then COVERAGE=$2; fi
 EXAMPLE_NAME="stand alone unit test runner"
 EXAMPLE_ERROR_HINT="Install $CC compiler?"
 EXAMPLE_SUCCESS_RUN="./octaspire-dern-unit-test-runner"
-echoAndRun "$CC" -O2 -std=c99 -Wall -Wextra -DOCTASPIRE_DERN_AMALGAMATED_UNIT_TEST_IMPLEMENTATION -DOCTASPIRE_DERN_CONFIG_BINARY_PLUGINS -DGREATEST_ENABLE_ANSI_COLORS $COVERAGE -I . octaspire-dern-amalgamated.c -Wl,-export-dynamic -ldl -lm -o octaspire-dern-unit-test-runner
+echoAndRun "$CC" -O2 -std=c99 -Wall -Wextra -DOCTASPIRE_DERN_AMALGAMATED_UNIT_TEST_IMPLEMENTATION -DOCTASPIRE_DERN_CONFIG_BINARY_PLUGINS -DOCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES -DOCTASPIRE_DERN_CONFIG_THREADS -pthread -DGREATEST_ENABLE_ANSI_COLORS $COVERAGE -I . octaspire-dern-amalgamated.c -Wl,-export-dynamic -ldl -lm -o octaspire-dern-unit-test-runner
 
 
 
@@ -58,7 +58,7 @@ echoAndRun "$CC" -O2 -std=c99 -Wall -Wextra -fPIC -shared -I . -o libmylib.so ex
 EXAMPLE_NAME="interactive Dern REPL"
 EXAMPLE_ERROR_HINT="Install $CC compiler?"
 EXAMPLE_SUCCESS_RUN="./octaspire-dern-repl -c"
-echoAndRun "$CC" -O2 -std=c99 -Wall -Wextra -DOCTASPIRE_DERN_AMALGAMATED_REPL_IMPLEMENTATION -DOCTASPIRE_DERN_CONFIG_BINARY_PLUGINS -I . octaspire-dern-amalgamated.c -Wl,-export-dynamic -ldl -lm -o octaspire-dern-repl
+echoAndRun "$CC" -O2 -std=c99 -Wall -Wextra -DOCTASPIRE_DERN_AMALGAMATED_REPL_IMPLEMENTATION -DOCTASPIRE_DERN_CONFIG_BINARY_PLUGINS -DOCTASPIRE_DERN_CONFIG_MEMORY_MAPPED_FILES -DOCTASPIRE_DERN_CONFIG_THREADS -pthread -I . octaspire-dern-amalgamated.c -Wl,-export-dynamic -ldl -lm -o octaspire-dern-repl
 
 
 
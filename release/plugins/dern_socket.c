@@ -566,12 +566,12 @@ octaspire_dern_value_t *dern_socket_receive(
 
     size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs != 2)
+    if (numArgs != 2 && numArgs != 3)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'socket-receive' expects two arguments. "
+            "Builtin 'socket-receive' expects two or three arguments. "
             "%zu arguments were given.",
             numArgs);
     }
@@ -623,6 +623,24 @@ octaspire_dern_value_t *dern_socket_receive(
 
     bool const waitForData = octaspire_dern_value_as_boolean_get_value(secondArg);
 
+    // Optional bytes that the received octets are appended into.
+    octaspire_dern_value_t * bytesArg = 0;
+
+    if (numArgs == 3)
+    {
+        bytesArg = octaspire_dern_value_as_vector_get_element_at(arguments, 2);
+
+        if (!octaspire_dern_value_is_bytes(bytesArg))
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_error_format(
+                vm,
+                "Builtin 'socket-receive' expects bytes as third argument. "
+                "Type '%s' was given.",
+                octaspire_dern_value_helper_get_type_as_c_string(bytesArg->typeTag));
+        }
+    }
+
 #ifdef _WIN32
     SOCKET const s = (SOCKET const)octaspire_dern_c_data_get_payload(cData);
 
@@ -668,6 +686,16 @@ octaspire_dern_value_t *dern_socket_receive(
                 vm,
                 "Builtin 'socket-receive' failed to receive: server closed connection.");
         }
+        else if (bytesArg)
+        {
+            if (!octaspire_dern_bytes_push_back_buffer(
+                    bytesArg->value.bytes,
+                    buffer,
+                    (size_t)recvStatus))
+            {
+                abort();
+            }
+        }
         else
         {
             str = octaspire_string_new_from_buffer(
@@ -678,6 +706,12 @@ octaspire_dern_value_t *dern_socket_receive(
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (bytesArg)
+    {
+        return bytesArg;
+    }
+
     octaspire_helpers_verify_not_null(str);
     return octaspire_dern_vm_create_new_value_string(vm, str);
 #else
@@ -715,6 +749,16 @@ octaspire_dern_value_t *dern_socket_receive(
                 vm,
                 "Builtin 'socket-receive' failed to receive: server closed connection.");
         }
+        else if (bytesArg)
+        {
+            if (!octaspire_dern_bytes_push_back_buffer(
+                    bytesArg->value.bytes,
+                    buffer,
+                    (size_t)recvStatus))
+            {
+                abort();
+            }
+        }
         else
         {
             str = octaspire_string_new_from_buffer(
@@ -725,6 +769,12 @@ octaspire_dern_value_t *dern_socket_receive(
     }
 
     octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+    if (bytesArg)
+    {
+        return bytesArg;
+    }
+
     octaspire_helpers_verify_not_null(str);
     return octaspire_dern_vm_create_new_value_string(vm, str);
 #endif
@@ -792,18 +842,28 @@ octaspire_dern_value_t *dern_socket_send(
     octaspire_dern_value_t const * const secondArg =
         octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
 
-    if (!octaspire_dern_value_is_text(secondArg))
+    char const * ptr = 0;
+    size_t       len = 0;
+
+    if (octaspire_dern_value_is_bytes(secondArg))
+    {
+        ptr = (char const*)octaspire_dern_bytes_get_octets(secondArg->value.bytes);
+        len = octaspire_dern_bytes_get_length(secondArg->value.bytes);
+    }
+    else if (octaspire_dern_value_is_text(secondArg))
+    {
+        ptr = octaspire_dern_value_as_text_get_c_string(secondArg);
+        len = octaspire_dern_value_as_text_get_length_in_octets(secondArg);
+    }
+    else
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'socket-send' expects string or symbol as second argument. "
+            "Builtin 'socket-send' expects string, symbol or bytes as second argument. "
             "Type '%s' was given.",
             octaspire_dern_value_helper_get_type_as_c_string(secondArg->typeTag));
     }
-
-    char const * ptr = octaspire_dern_value_as_text_get_c_string(secondArg);
-    size_t       len = octaspire_dern_value_as_text_get_length_in_octets(secondArg);
     intptr_t     result = 0;
 
     while (true)
@@ -846,18 +906,28 @@ octaspire_dern_value_t *dern_socket_send(
     octaspire_dern_value_t const * const secondArg =
         octaspire_dern_value_as_vector_get_element_at_const(arguments, 1);
 
-    if (!octaspire_dern_value_is_text(secondArg))
+    char const * ptr = 0;
+    size_t       len = 0;
+
+    if (octaspire_dern_value_is_bytes(secondArg))
+    {
+        ptr = (char const*)octaspire_dern_bytes_get_octets(secondArg->value.bytes);
+        len = octaspire_dern_bytes_get_length(secondArg->value.bytes);
+    }
+    else if (octaspire_dern_value_is_text(secondArg))
+    {
+        ptr = octaspire_dern_value_as_text_get_c_string(secondArg);
+        len = octaspire_dern_value_as_text_get_length_in_octets(secondArg);
+    }
+    else
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_error_format(
             vm,
-            "Builtin 'socket-send' expects string or symbol as second argument. "
+            "Builtin 'socket-send' expects string, symbol or bytes as second argument. "
             "Type '%s' was given.",
             octaspire_dern_value_helper_get_type_as_c_string(secondArg->typeTag));
     }
-
-    char const * ptr = octaspire_dern_value_as_text_get_c_string(secondArg);
-    size_t       len = octaspire_dern_value_as_text_get_length_in_octets(secondArg);
     intptr_t     result = 0;
 
     while (true)
@@ -1018,6 +1088,7 @@ bool dern_socket_init(
             "\t(require 'dern_socket)\n"
             "\n"
             "\t(socket-receive socket wait) -> string or <error message>\n"
+            "\t(socket-receive socket wait bytes) -> bytes or <error message>\n"
             "\n"
             "DESCRIPTION\n"
             "\tReads a message from the given socket.\n"
@@ -1025,9 +1096,11 @@ bool dern_socket_init(
             "ARGUMENTS\n"
             "\tsocket              Socket created with 'socket-socket'\n"
             "\twait                Boolean telling whether to wait for data or not\n"
+            "\tbytes               Optional bytes that the message is appended into\n"
             "\n"
             "RETURN VALUE\n"
-            "\tOn success returns a string. On error, returns error message.\n"
+            "\tOn success returns a string, or the given bytes. On error, returns\n"
+            "\terror message.\n"
             "\n"
             "SEE ALSO\n"
             "socket-close, socket-send",
@@ -1055,7 +1128,7 @@ bool dern_socket_init(
             "\n"
             "ARGUMENTS\n"
             "\tsocket              Socket created with 'socket-socket'\n"
-            "\ttext                String or symbol text to be sent\n"
+            "\ttext                String or symbol text, or bytes to be sent\n"
             "\n"
             "RETURN VALUE\n"
             "\tOn success returns the number of octets send. On error, returns error message.\n"
@@ -87,6 +87,254 @@ static int dern_sqlite3_private_callback(
     return 0;
 }
 
+// Binds the parameters starting from index 'firstParameter' to the
+// placeholders of 'statement'. Returns the number of parameters bound, or
+// -1 if a parameter has a type that cannot be bound.
+static int dern_sqlite3_private_bind_parameters(
+    sqlite3_stmt * const statement,
+    octaspire_dern_value_t const * const parameters,
+    size_t const firstParameter)
+{
+    int const numPlaceholders = sqlite3_bind_parameter_count(statement);
+
+    for (int i = 0; i < numPlaceholders; ++i)
+    {
+        size_t const index = firstParameter + (size_t)i;
+
+        if (index >= octaspire_dern_value_as_vector_get_length(parameters))
+        {
+            // Placeholders without parameter are left as NULL.
+            return i;
+        }
+
+        octaspire_dern_value_t const * const parameter =
+            octaspire_dern_value_as_vector_get_element_at_const(
+                parameters,
+                (ptrdiff_t)index);
+
+        int bindResult = SQLITE_OK;
+
+        switch (parameter->typeTag)
+        {
+            case OCTASPIRE_DERN_VALUE_TAG_NIL:
+            {
+                bindResult = sqlite3_bind_null(statement, i + 1);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_BOOLEAN:
+            {
+                bindResult = sqlite3_bind_int(
+                    statement,
+                    i + 1,
+                    parameter->value.boolean ? 1 : 0);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_INTEGER:
+            {
+                bindResult = sqlite3_bind_int64(
+                    statement,
+                    i + 1,
+                    parameter->value.integer);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_REAL:
+            {
+                bindResult = sqlite3_bind_double(
+                    statement,
+                    i + 1,
+                    parameter->value.real);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_STRING:
+            case OCTASPIRE_DERN_VALUE_TAG_SYMBOL:
+            {
+                bindResult = sqlite3_bind_text(
+                    statement,
+                    i + 1,
+                    octaspire_dern_value_as_text_get_c_string(parameter),
+                    (int)octaspire_dern_value_as_text_get_length_in_octets(parameter),
+                    SQLITE_TRANSIENT);
+            }
+            break;
+
+            case OCTASPIRE_DERN_VALUE_TAG_BYTES:
+            {
+                // Octets are given to sqlite3 as they are, without copying
+                // them into a string or vector first.
+                bindResult = sqlite3_bind_blob(
+                    statement,
+                    i + 1,
+                    octaspire_dern_bytes_get_octets(parameter->value.bytes),
+                    (int)octaspire_dern_bytes_get_length(parameter->value.bytes),
+                    SQLITE_TRANSIENT);
+            }
+            break;
+
+            default:
+            {
+                return -1;
+            }
+        }
+
+        if (bindResult != SQLITE_OK)
+        {
+            return -1;
+        }
+    }
+
+    return numPlaceholders;
+}
+
+// Calls the callback of 'context' with the current row of 'statement'.
+// Blob columns are given as bytes and other columns as strings.
+static int dern_sqlite3_private_call_with_row(
+    dern_sqlite3_callback_context_t * const context,
+    sqlite3_stmt * const statement)
+{
+    context->error = 0;
+
+    octaspire_dern_value_t *arguments =
+        octaspire_dern_vm_create_new_value_vector(context->vm);
+
+    octaspire_helpers_verify_not_null(arguments);
+    octaspire_dern_vm_push_value(context->vm, arguments);
+
+    int const numColumns = sqlite3_column_count(statement);
+
+    for (int i = 0; i < numColumns; ++i)
+    {
+        octaspire_dern_value_t *pairVal =
+            octaspire_dern_vm_create_new_value_vector(context->vm);
+
+        octaspire_dern_value_as_vector_push_back_element(arguments, &pairVal);
+
+        octaspire_dern_value_t *value =
+            octaspire_dern_vm_create_new_value_string_from_c_string(
+                context->vm,
+                sqlite3_column_name(statement, i));
+
+        octaspire_dern_value_as_vector_push_back_element(pairVal, &value);
+
+        int const columnType = sqlite3_column_type(statement, i);
+
+        if (columnType == SQLITE_BLOB)
+        {
+            value = octaspire_dern_vm_create_new_value_bytes_from_buffer(
+                context->vm,
+                sqlite3_column_blob(statement, i),
+                (size_t)sqlite3_column_bytes(statement, i));
+        }
+        else if (columnType == SQLITE_NULL)
+        {
+            value = octaspire_dern_vm_create_new_value_string_from_c_string(
+                context->vm,
+                "NULL");
+        }
+        else
+        {
+            value = octaspire_dern_vm_create_new_value_string_from_c_string(
+                context->vm,
+                (char const*)sqlite3_column_text(statement, i));
+        }
+
+        octaspire_dern_value_as_vector_push_back_element(pairVal, &value);
+    }
+
+    octaspire_dern_value_t const * const result = octaspire_dern_vm_call_lambda(
+        context->vm,
+        context->callback,
+        arguments,
+        context->environment);
+
+    octaspire_dern_vm_pop_value(context->vm, arguments);
+
+    if (octaspire_dern_value_is_error(result))
+    {
+        context->error = octaspire_string_new(
+            octaspire_dern_value_as_error_get_c_string(result),
+            octaspire_dern_vm_get_allocator(context->vm));
+
+        return -1;
+    }
+
+    return 0;
+}
+
+// Executes the statements of 'sql' one by one binding 'parameters' to
+// their placeholders in order. Returns an error message, or null on
+// success.
+static octaspire_string_t *dern_sqlite3_private_exec_with_parameters(
+    dern_sqlite3_callback_context_t * const context,
+    char const * const sql,
+    octaspire_dern_value_t const * const parameters)
+{
+    octaspire_allocator_t * const allocator =
+        octaspire_dern_vm_get_allocator(context->vm);
+
+    char const * next = sql;
+    size_t firstParameter = 0;
+
+    while (next && *next)
+    {
+        sqlite3_stmt * statement = 0;
+
+        if (sqlite3_prepare_v2(context->db, next, -1, &statement, &next) != SQLITE_OK)
+        {
+            return octaspire_string_new(sqlite3_errmsg(context->db), allocator);
+        }
+
+        if (!statement)
+        {
+            // Whitespace or comment only.
+            continue;
+        }
+
+        int const numBound = dern_sqlite3_private_bind_parameters(
+            statement,
+            parameters,
+            firstParameter);
+
+        if (numBound < 0)
+        {
+            sqlite3_finalize(statement);
+            return octaspire_string_new(
+                "parameters must be nil, booleans, integers, reals, strings, "
+                "symbols or bytes",
+                allocator);
+        }
+
+        firstParameter += (size_t)numBound;
+
+        int stepResult = SQLITE_ROW;
+
+        while ((stepResult = sqlite3_step(statement)) == SQLITE_ROW)
+        {
+            if (dern_sqlite3_private_call_with_row(context, statement) != 0)
+            {
+                sqlite3_finalize(statement);
+                return context->error;
+            }
+        }
+
+        if (stepResult != SQLITE_DONE)
+        {
+            octaspire_string_t * const error =
+                octaspire_string_new(sqlite3_errmsg(context->db), allocator);
+
+            sqlite3_finalize(statement);
+            return error;
+        }
+
+        sqlite3_finalize(statement);
+    }
+
+    return 0;
+}
+
 void dern_sqlite3_db_clean_up_callback(void *payload)
 {
     octaspire_helpers_verify_not_null(payload);
@@ -256,12 +504,12 @@ octaspire_dern_value_t *dern_sqlite3_exec(
 
     size_t const numArgs = octaspire_dern_value_as_vector_get_length(arguments);
 
-    if (numArgs != 3)
+    if (numArgs != 3 && numArgs != 4)
     {
         octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
         return octaspire_dern_vm_create_new_value_string_format(
             vm,
-            "Builtin 'sqlite3-exec' expects three arguments. "
+            "Builtin 'sqlite3-exec' expects three or four arguments. "
             "%zu arguments were given.",
             numArgs);
     }
@@ -348,6 +596,43 @@ octaspire_dern_value_t *dern_sqlite3_exec(
     context.callback    = callback;
     context.error       = 0;
 
+    if (numArgs == 4)
+    {
+        // 4. argument; vector of parameters for the placeholders of sql.
+
+        octaspire_dern_value_t const * const fourthArg =
+            octaspire_dern_value_as_vector_get_element_at_const(arguments, 3);
+
+        if (!octaspire_dern_value_is_vector(fourthArg))
+        {
+            octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+            return octaspire_dern_vm_create_new_value_string_format(
+                vm,
+                "Builtin 'sqlite3-exec' expects vector as fourth argument. "
+                "Type '%s' was given.",
+                octaspire_dern_value_helper_get_type_as_c_string(fourthArg->typeTag));
+        }
+
+        octaspire_string_t * const error =
+            dern_sqlite3_private_exec_with_parameters(&context, sql, fourthArg);
+
+        octaspire_helpers_verify_true(stackLength == octaspire_dern_vm_get_stack_length(vm));
+
+        if (error)
+        {
+            octaspire_dern_value_t * const result =
+                octaspire_dern_vm_create_new_value_error_format(
+                    vm,
+                    "Builtin 'sqlite3-exec' failed: %s.",
+                    octaspire_string_get_c_string(error));
+
+            octaspire_string_release(error);
+            return result;
+        }
+
+        return octaspire_dern_vm_create_new_value_boolean(vm, true);
+    }
+
     int const execResult = sqlite3_exec(
         db,
         sql,
@@ -475,14 +760,20 @@ bool dern_sqlite3_init(
             "\t(require 'dern_sqlite3)\n"
             "\n"
             "\t(sqlite3-exec database sql callback) -> true or <error message>\n"
+            "\t(sqlite3-exec database sql callback parameters) -> true or <error message>\n"
             "\n"
             "DESCRIPTION\n"
             "\tExecute sql statement and call callback with the results.\n"
+            "\tWhen parameters are given, they are bound in order to the '?'\n"
+            "\tplaceholders of the statements and blob columns of the results\n"
+            "\tare given to the callback as bytes.\n"
             "\n"
             "ARGUMENTS\n"
             "\tdatabase              Database created with 'sqlite3-open'\n"
             "\tsql                   Sql statement to be executed'\n"
             "\tcallback              Dern callback function to be called with results'\n"
+            "\tparameters            Optional vector of nil, booleans, integers, reals,\n"
+            "\t                      strings, symbols or bytes\n"
             "\n"
             "RETURN VALUE\n"
             "\tReturns true on success. On error, returns error message.\n"
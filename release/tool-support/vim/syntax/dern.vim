@@ -26,7 +26,7 @@ syn match dernEscape "\v\|[0-9a-fA-F]+\|" contained
 syn match dernEscape "\v\{\}" contained
 hi link dernString String
 
-syn keyword dernKeyword != * + ++ += - -- -= -== / < <= = == === > >= abort and acos asin atan cos define distance do doc env-current env-global env-new eval exit find fn for hash-map if len mod not ln@ cp@ or pop-front pow print println quote read-and-eval-path read-and-eval-string return select sin sqrt starts-with? string-format tan to-integer to-string uid vector while io-file-open port-read port-write port-seek port-flush port-close port-dist port-length input-file-open output-file-open port-supports-output? port-supports-input? require queue queue-with-max-length list howto howto-ok howto-no as in pop-back
+syn keyword dernKeyword != * + ++ += - -- -= -== / < <= = == === > >= abort and acos asin atan cos define distance do doc env-current env-global env-new eval exit find fn for hash-map weak-hash-map weak-reference weak-reference-get persistent-vector persistent-hash-map conj assoc dissoc transient persistent! conj! assoc! dissoc! bytes bytes-slice bytes-pack bytes-unpack bytes-to-string string-builder string-builder-to-string sort sort! set set-contains? set-union set-intersection set-difference sorted-map sorted-map? sorted-map-floor sorted-map-ceiling sorted-map-range string-slice string-slice? string-slice-to-string split-slices typed-array sum mean dot if len mod not ln@ cp@ or pop-front pow print println quote read-and-eval-path read-and-eval-string return select sin sqrt starts-with? string-format tan to-integer to-string uid vector while io-file-open port-read port-read-bytes port-write port-seek port-flush port-close port-dist port-length input-file-open output-file-open port-supports-output? port-supports-input? require queue queue-with-max-length list howto howto-ok howto-no as in pop-back
 hi link dernKeyword Keyword
 
 syn keyword dernBoolean true false nil